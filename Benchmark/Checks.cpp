@@ -0,0 +1,435 @@
+/*
+ GRT Benchmark - consistency checks
+
+ Every check builds its own synthetic data from the random generator it is given, runs the same work through two paths that should
+ give the same answer and returns an empty string if they match, or a description of the first difference. The values are compared
+ exactly, as the fast paths are meant to do the same arithmetic in the same order as the paths they replace.
+*/
+
+#include "Checks.h"
+#include <sstream>
+#include <cstdio>
+
+using namespace GRT;
+
+typedef string (*CheckFunction)(Random &random);
+
+MatrixDouble getRandomStream(Random &random,const UINT numSamples,const UINT numDimensions){
+    MatrixDouble stream( numSamples, numDimensions );
+    for(UINT i=0; i<numSamples; i++){
+        for(UINT j=0; j<numDimensions; j++){
+            stream[i][j] = sin( i * 0.05 * (j+1) ) + random.getRandomNumberGauss(0,0.2);
+        }
+    }
+    return stream;
+}
+
+LabelledClassificationData getRandomClassificationData(Random &random,const UINT numSamples,const UINT numDimensions,const UINT numClasses){
+    LabelledClassificationData data( numDimensions );
+    VectorDouble sample( numDimensions );
+    for(UINT i=0; i<numSamples; i++){
+        const UINT classLabel = i % numClasses + 1;
+        for(UINT j=0; j<numDimensions; j++) sample[j] = classLabel + random.getRandomNumberGauss(0,0.8);
+        data.addSample( classLabel, sample );
+    }
+    return data;
+}
+
+string getDifference(const string &what,const UINT index,const double expected,const double actual){
+    std::ostringstream stream;
+    stream << what << " differs at sample " << index << ", expected " << expected << " got " << actual;
+    return stream.str();
+}
+
+string compareVectors(const string &what,const UINT index,const VectorDouble &expected,const VectorDouble &actual){
+    if( expected.size() != actual.size() ) return getDifference( what + " size", index, expected.size(), actual.size() );
+    for(UINT j=0; j<expected.size(); j++){
+        if( expected[j] != actual[j] ) return getDifference( what, index, expected[j], actual[j] );
+    }
+    return "";
+}
+
+/*
+ Runs a stream through three copies of a filter: one with process(), one with processInPlace() and one with filter(), all three
+ must give the same values. If the GRT counts allocations, processInPlace must not allocate once the filter has warmed up.
+*/
+template< class T >
+string checkFilter(const string &name,const T &filter,const MatrixDouble &stream){
+    T processFilter( filter );
+    T inPlaceFilter( filter );
+    T vectorFilter( filter );
+    const UINT numWarmUpSamples = 10;
+    unsigned long long numAllocations = 0;
+    VectorDouble sample;
+
+    for(UINT i=0; i<stream.getNumRows(); i++){
+        const VectorDouble input = stream.getRowVector( i );
+        if( !processFilter.process( input ) ) return name + " process failed";
+
+        sample = input;
+        const unsigned long long startAllocations = PipelineProfiler::getAllocationCount();
+        if( !inPlaceFilter.processInPlace( sample ) ) return name + " processInPlace failed";
+        if( i >= numWarmUpSamples ) numAllocations += PipelineProfiler::getAllocationCount() - startAllocations;
+
+        string difference = compareVectors( name + " processInPlace", i, processFilter.getProcessedData(), sample );
+        if( difference != "" ) return difference;
+        difference = compareVectors( name + " filter", i, processFilter.getProcessedData(), vectorFilter.filter( input ) );
+        if( difference != "" ) return difference;
+    }
+
+    if( numAllocations > 0 ){
+        std::ostringstream text;
+        text << name << " processInPlace made " << numAllocations << " allocations after warming up";
+        return text.str();
+    }
+    return "";
+}
+
+string checkInPlaceFilters(Random &random){
+    const UINT D = 3;
+    const MatrixDouble stream = getRandomStream( random, 500, D );
+    string difference = checkFilter( "MovingAverageFilter", MovingAverageFilter(5,D), stream );
+    if( difference == "" ) difference = checkFilter( "LowPassFilter", LowPassFilter(0.1,1,D), stream );
+    if( difference == "" ) difference = checkFilter( "HighPassFilter", HighPassFilter(0.1,1,D), stream );
+    return difference;
+}
+
+//Runs one session per item, each session predicts the whole stream and keeps its outputs
+class SessionTask{
+public:
+    SessionTask(vector< GestureRecognitionPipelineSession* > &sessions,const MatrixDouble &stream,const bool regressionMode,vector< MatrixDouble > &outputs):sessions(sessions),stream(stream),regressionMode(regressionMode),outputs(outputs){}
+
+    void operator()(UINT startIndex,UINT endIndex,UINT threadIndex){
+        for(UINT s=startIndex; s<endIndex; s++){
+            for(UINT i=0; i<stream.getNumRows(); i++){
+                if( !sessions[s]->predict( stream.getRowVector( i ) ) ) continue;
+                outputs[s].push_back( getOutput( *sessions[s], regressionMode ) );
+            }
+        }
+    }
+
+    template< class T >
+    static VectorDouble getOutput(T &pipeline,const bool regressionMode){
+        if( regressionMode ) return pipeline.getRegressionData();
+        VectorDouble output = pipeline.getClassLikelihoods();
+        output.push_back( pipeline.getPredictedClassLabel() );
+        output.push_back( pipeline.getMaximumLikelihood() );
+        return output;
+    }
+
+protected:
+    vector< GestureRecognitionPipelineSession* > &sessions;
+    const MatrixDouble &stream;
+    const bool regressionMode;
+    vector< MatrixDouble > &outputs;
+};
+
+/*
+ Runs a stream through a trained pipeline, then through several sessions of the same pipeline on parallel threads. Every session
+ must give exactly the outputs of the pipeline.
+*/
+string checkSessions(const string &name,GestureRecognitionPipeline &pipeline,const MatrixDouble &stream){
+    const UINT numSessions = 4;
+
+    const bool regressionMode = pipeline.getIsPipelineInRegressionMode();
+    MatrixDouble expected;
+    pipeline.reset();
+    for(UINT i=0; i<stream.getNumRows(); i++){
+        if( !pipeline.predict( stream.getRowVector( i ) ) ) continue;
+        expected.push_back( SessionTask::getOutput( pipeline, regressionMode ) );
+    }
+
+    vector< GestureRecognitionPipelineSession* > sessions( numSessions );
+    for(UINT s=0; s<numSessions; s++){
+        //A new session copies the current state of the pipeline's filters, so it is reset to start from the same state as the pipeline did
+        sessions[s] = new GestureRecognitionPipelineSession( pipeline );
+        sessions[s]->reset();
+    }
+    vector< MatrixDouble > outputs( numSessions );
+    SessionTask task( sessions, stream, regressionMode, outputs );
+    ParallelFor::run( numSessions, task );
+    for(UINT s=0; s<numSessions; s++) delete sessions[s];
+
+    for(UINT s=0; s<numSessions; s++){
+        if( outputs[s].getNumRows() != expected.getNumRows() ) return getDifference( name + " session prediction count", s, expected.getNumRows(), outputs[s].getNumRows() );
+        for(UINT i=0; i<expected.getNumRows(); i++){
+            const string difference = compareVectors( name + " session output", i, expected.getRowVector( i ), outputs[s].getRowVector( i ) );
+            if( difference != "" ) return difference;
+        }
+    }
+    return "";
+}
+
+string checkPipelineSessions(Random &random){
+    const UINT D = 3;
+    const MatrixDouble stream = getRandomStream( random, 500, D );
+    const LabelledClassificationData trainingData = getRandomClassificationData( random, 300, D, 3 );
+
+    //A classification pipeline that uses every stage, with an open gate so the context modules are run but do not stop the data
+    GestureRecognitionPipeline pipeline;
+    pipeline.addContextModule( Gate(true), GestureRecognitionPipeline::START_OF_PIPELINE );
+    pipeline.addPreProcessingModule( MovingAverageFilter(5,D) );
+    pipeline.addContextModule( Gate(true), GestureRecognitionPipeline::AFTER_CLASSIFIER );
+    pipeline.setClassifier( KNN(5) );
+    pipeline.addPostProcessingModule( ClassLabelFilter(2,5) );
+    if( !pipeline.train( trainingData ) ) return "the classification pipeline failed to train";
+    string difference = checkSessions( "KNN", pipeline, stream );
+    if( difference != "" ) return difference;
+
+    pipeline.setClassifier( ANBC() );
+    if( !pipeline.train( trainingData ) ) return "the ANBC pipeline failed to train";
+    difference = checkSessions( "ANBC", pipeline, stream );
+    if( difference != "" ) return difference;
+
+    LabelledRegressionData regressionData;
+    regressionData.setInputAndTargetDimensions( D, 2 );
+    VectorDouble input( D ), target( 2 );
+    for(UINT i=0; i<300; i++){
+        for(UINT j=0; j<D; j++) input[j] = random.getRandomNumberUniform(0,1);
+        target[0] = 2*input[0] + input[1] - input[2];
+        target[1] = input[2];
+        regressionData.addSample( input, target );
+    }
+    GestureRecognitionPipeline regressionPipeline;
+    regressionPipeline.addPreProcessingModule( MovingAverageFilter(2,D) );
+    regressionPipeline.setRegressifier( MultidimensionalRegression(LinearRegression(),true) );
+    regressionPipeline.addContextModule( Gate(true), GestureRecognitionPipeline::END_OF_PIPELINE );
+    if( !regressionPipeline.train( regressionData ) ) return "the regression pipeline failed to train";
+    return checkSessions( "MultidimensionalRegression", regressionPipeline, stream );
+}
+
+/*
+ Trains a classifier on a weighted view and on the dataset the view expands to, both copies must give the same outputs.
+*/
+string checkViewTraining(const string &name,const Classifier &classifier,const LabelledClassificationDataView &view,const MatrixDouble &testData){
+    Classifier *viewClassifier = classifier.createNewInstance();
+    Classifier *datasetClassifier = classifier.createNewInstance();
+    viewClassifier->deepCopyFrom( &classifier );
+    datasetClassifier->deepCopyFrom( &classifier );
+
+    //Both copies start from the same thread seed, so the classifiers that use random numbers while training see the same ones
+    const unsigned long long seed = Random::getThreadSeed();
+    const bool viewTrained = viewClassifier->train( view );
+    Random::setThreadSeed( seed );
+    const bool datasetTrained = datasetClassifier->train( view.getDataset() );
+
+    string difference;
+    if( !viewTrained || !datasetTrained ) difference = name + " failed to train";
+    for(UINT i=0; i<testData.getNumRows() && difference == ""; i++){
+        const VectorDouble sample = testData.getRowVector( i );
+        if( !viewClassifier->predict( sample ) || !datasetClassifier->predict( sample ) ){
+            difference = name + " failed to predict";
+            break;
+        }
+        VectorDouble expected = datasetClassifier->getClassLikelihoods();
+        VectorDouble actual = viewClassifier->getClassLikelihoods();
+        expected.push_back( datasetClassifier->getPredictedClassLabel() );
+        actual.push_back( viewClassifier->getPredictedClassLabel() );
+        difference = compareVectors( name + " view training", i, expected, actual );
+    }
+
+    delete viewClassifier;
+    delete datasetClassifier;
+    return difference;
+}
+
+string checkTrainingViews(Random &random){
+    const UINT D = 3;
+    const LabelledClassificationData data = getRandomClassificationData( random, 300, D, 3 );
+    const MatrixDouble testData = getRandomClassificationData( random, 60, D, 3 ).getDataAsMatrixDouble();
+
+    //A view that skips some samples, repeats others and weights the rest with 0, 1 or 3
+    vector< UINT > indexes;
+    VectorDouble weights;
+    for(UINT i=0; i<data.getNumSamples(); i++){
+        if( i % 7 == 0 ) continue;
+        indexes.push_back( i );
+        weights.push_back( i % 5 == 0 ? 0.0 : ( i % 4 == 0 ? 3.0 : 1.0 ) );
+    }
+    for(UINT i=0; i<data.getNumSamples(); i+=11){
+        indexes.push_back( i );
+        weights.push_back( 1.0 );
+    }
+    const LabelledClassificationDataView view( data, indexes, weights );
+
+    AdaBoost adaBoost(true,true,1.0,5);
+    adaBoost.setWeakClassifier( DecisionStump() );
+    string difference = checkViewTraining( "KNN", KNN(5,true,true,3.0), view, testData );
+    if( difference == "" ) difference = checkViewTraining( "GMM", GMM(2,true,true,1.0), view, testData );
+    if( difference == "" ) difference = checkViewTraining( "Softmax", Softmax(true), view, testData );
+    if( difference == "" ) difference = checkViewTraining( "ANBC", ANBC(true,true,3.0), view, testData );
+    if( difference == "" ) difference = checkViewTraining( "MinDist", MinDist(true,true,3.0,4), view, testData );
+    if( difference == "" ) difference = checkViewTraining( "AdaBoost", adaBoost, view, testData );
+    return difference;
+}
+
+//Reads every row from the reader and checks it against the datasets, which should hold the rows of each of its files in order
+string compareReader(ChunkedDatasetReader &reader,const vector< LabelledClassificationData > &datasets){
+    MatrixDouble chunk;
+    UINT datasetIndex = 0;
+    UINT sampleIndex = 0;
+    UINT rowIndex = 0;
+    UINT numRows = 0;
+    while( (numRows = reader.readChunk( chunk )) > 0 ){
+        for(UINT i=0; i<numRows; i++,rowIndex++){
+            while( datasetIndex < datasets.size() && sampleIndex == datasets[ datasetIndex ].getNumSamples() ){
+                datasetIndex++;
+                sampleIndex = 0;
+            }
+            if( datasetIndex == datasets.size() ) return getDifference( "ChunkedDatasetReader row count", rowIndex, rowIndex, rowIndex+1 );
+
+            const LabelledClassificationSample &sample = datasets[ datasetIndex ][ sampleIndex++ ];
+            if( reader.getChunkClassLabels()[i] != sample.getClassLabel() ) return getDifference( "ChunkedDatasetReader class label", rowIndex, sample.getClassLabel(), reader.getChunkClassLabels()[i] );
+            const string difference = compareVectors( "ChunkedDatasetReader row", rowIndex, sample.getSample(), chunk.getRowVector( i ) );
+            if( difference != "" ) return difference;
+        }
+    }
+
+    UINT expectedNumRows = 0;
+    for(UINT k=0; k<datasets.size(); k++) expectedNumRows += datasets[k].getNumSamples();
+    if( rowIndex != expectedNumRows ) return getDifference( "ChunkedDatasetReader row count", rowIndex, expectedNumRows, rowIndex );
+    return "";
+}
+
+/*
+ Saves a dataset as a text file and as a binary file, then reads both files back through one ChunkedDatasetReader with a chunk size
+ that does not divide the number of samples. The rows must match the datasets loaded by LabelledClassificationData, before and after
+ the reader is reset.
+*/
+string checkChunkedDatasetReader(Random &random){
+    const string textFilename = "GRTCheckDataset.txt";
+    const string binaryFilename = "GRTCheckDataset.bin";
+    const LabelledClassificationData data = getRandomClassificationData( random, 300, 3, 3 );
+
+    vector< LabelledClassificationData > datasets( 2 );
+    string difference;
+    if( !data.saveDatasetToFile( textFilename ) || !data.saveDatasetToBinaryFile( binaryFilename, 64 ) ) difference = "failed to save the datasets";
+    else if( !datasets[0].loadDatasetFromFile( textFilename ) || !datasets[1].loadDatasetFromBinaryFile( binaryFilename ) ) difference = "failed to load the datasets";
+
+    vector< string > filenames;
+    filenames.push_back( textFilename );
+    filenames.push_back( binaryFilename );
+    ChunkedDatasetReader reader( 7 );
+    if( difference == "" && !reader.open( filenames ) ) difference = "the ChunkedDatasetReader failed to open the datasets";
+    if( difference == "" ) difference = compareReader( reader, datasets );
+    if( difference == "" && !reader.reset() ) difference = "the ChunkedDatasetReader failed to reset";
+    if( difference == "" ) difference = compareReader( reader, datasets );
+
+    reader.close();
+    remove( textFilename.c_str() );
+    remove( binaryFilename.c_str() );
+    return difference;
+}
+
+//Gets a matrix of points on a small integer grid a long way from the origin, so there are many exact ties and the expanded form
+//distances used by the SquaredDistanceKernel lose most of their precision
+MatrixDouble getRandomGrid(Random &random,const UINT numRows,const UINT numDimensions,const double offset){
+    MatrixDouble grid( numRows, numDimensions );
+    for(UINT i=0; i<numRows; i++){
+        for(UINT j=0; j<numDimensions; j++) grid[i][j] = offset + random.getRandomNumberInt(0,4);
+    }
+    return grid;
+}
+
+//Gets the closest cluster with a direct search, a tie goes to the first cluster if lastWins is false and the last cluster if it is true
+UINT findNearestClusterDirect(const double *x,const MatrixDouble &clusters,const bool lastWins,double &minDistance){
+    UINT minIndex = 0;
+    minDistance = numeric_limits<double>::max();
+    for(UINT k=0; k<clusters.getNumRows(); k++){
+        double d = 0;
+        for(UINT n=0; n<clusters.getNumCols(); n++) d += SQR( x[n]-clusters[k][n] );
+        if( d < minDistance || (lastWins && d == minDistance) ){
+            minDistance = d;
+            minIndex = k;
+        }
+    }
+    return minIndex;
+}
+
+/*
+ Checks the SquaredDistanceKernel gives the same closest cluster and distance as a direct search (first cluster wins a tie), and that
+ KMeans training from a fixed set of clusters gives the same clusters as a direct Lloyd's loop (last cluster wins a tie, as the E step
+ always has). The data is small enough that KMeans sums the clusters on one thread, in the same order as the direct loop.
+*/
+string checkKMeansAssignment(Random &random){
+    for(UINT t=0; t<500; t++){
+        const double offset = (t % 3) * 1.0e8;
+        const MatrixDouble clusters = getRandomGrid( random, random.getRandomNumberInt(1,12), random.getRandomNumberInt(1,7), offset );
+        SquaredDistanceKernel kernel( clusters );
+        VectorDouble x = getRandomGrid( random, 1, clusters.getNumCols(), offset ).getRowVector( 0 );
+        if( t % 2 ) x[0] += 0.5;
+
+        double expectedDistance = 0;
+        double distance = 0;
+        const UINT expectedIndex = findNearestClusterDirect( &x[0], clusters, false, expectedDistance );
+        const UINT index = kernel.findNearestCluster( &x[0], distance );
+        if( index != expectedIndex ) return getDifference( "SquaredDistanceKernel closest cluster", t, expectedIndex, index );
+        if( distance != expectedDistance ) return getDifference( "SquaredDistanceKernel closest distance", t, expectedDistance, distance );
+    }
+
+    const UINT M = 600;
+    const UINT K = 6;
+    for(UINT t=0; t<10; t++){
+        const MatrixDouble data = getRandomGrid( random, M, 3, (t % 2) * 1.0e7 );
+        MatrixDouble initialClusters( K, 3 );
+        for(UINT k=0; k<K; k++){
+            for(UINT n=0; n<3; n++) initialClusters[k][n] = data[k*7][n] + (k % 2 ? 0.5 : 0);
+        }
+
+        //Run Lloyd's algorithm directly, an empty cluster keeps its old position
+        MatrixDouble clusters = initialClusters;
+        vector< UINT > assign( M, K );
+        for(UINT epoch=0; epoch<1000; epoch++){
+            UINT numChanged = 0;
+            double minDistance = 0;
+            for(UINT m=0; m<M; m++){
+                const UINT k = findNearestClusterDirect( data[m], clusters, true, minDistance );
+                if( k != assign[m] ) numChanged++;
+                assign[m] = k;
+            }
+            MatrixDouble sums( K, 3 );
+            sums.setAllValues( 0 );
+            vector< UINT > counts( K, 0 );
+            for(UINT m=0; m<M; m++){
+                counts[ assign[m] ]++;
+                for(UINT n=0; n<3; n++) sums[ assign[m] ][n] += data[m][n];
+            }
+            for(UINT k=0; k<K; k++){
+                if( counts[k] > 0 ) for(UINT n=0; n<3; n++) clusters[k][n] = sums[k][n] / double(counts[k]);
+            }
+            if( numChanged == 0 ) break;
+        }
+
+        KMeans kmeans;
+        kmeans.setComputeTheta( false );
+        kmeans.setMinNumEpochs( 0 );
+        kmeans.setMaxNumEpochs( 1000 );
+        MatrixDouble trainingData = data;
+        MatrixDouble trainingClusters = initialClusters;
+        if( !kmeans.train( trainingData, trainingClusters ) ) return "KMeans failed to train";
+        const MatrixDouble trainedClusters = kmeans.getClusters();
+        for(UINT k=0; k<K; k++){
+            const string difference = compareVectors( "KMeans cluster", k, clusters.getRowVector( k ), trainedClusters.getRowVector( k ) );
+            if( difference != "" ) return difference;
+        }
+    }
+    return "";
+}
+
+bool runConsistencyChecks(const unsigned long long seed,std::ostream &stream){
+
+    const char *checkNames[] = {"InPlaceFilters","PipelineSessions","TrainingViews","ChunkedDatasetReader","KMeansAssignment"};
+    const CheckFunction checks[] = {&checkInPlaceFilters,&checkPipelineSessions,&checkTrainingViews,&checkChunkedDatasetReader,&checkKMeansAssignment};
+    const UINT numChecks = sizeof(checks) / sizeof(checks[0]);
+
+    bool allPassed = true;
+    for(UINT i=0; i<numChecks; i++){
+        //Each check gets its own generator and thread seed, so adding a check does not change the data the others see
+        Random random( seed + i );
+        Random::setThreadSeed( seed + i );
+        const string difference = checks[i]( random );
+        stream << "check " << checkNames[i] << ": " << ( difference == "" ? "ok" : "FAILED - " + difference ) << endl;
+        if( difference != "" ) allPassed = false;
+    }
+    return allPassed;
+}
@@ -0,0 +1,19 @@
+/*
+ GRT Benchmark - consistency checks
+
+ These checks compare the fast paths of the GRT against the slower paths they replace, on synthetic data, and report any
+ difference. They are run with: Benchmark --check [--seed N]
+*/
+
+#ifndef GRT_BENCHMARK_CHECKS_HEADER
+#define GRT_BENCHMARK_CHECKS_HEADER
+
+#include "GRT/GRT.h"
+
+/*
+ Runs every consistency check, writing one line per check to the stream.
+ Returns true if all the checks passed.
+*/
+bool runConsistencyChecks(const unsigned long long seed,std::ostream &stream);
+
+#endif //GRT_BENCHMARK_CHECKS_HEADER
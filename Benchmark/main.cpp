@@ -0,0 +1,808 @@
+/*
+ GRT Benchmark
+
+ This program benchmarks every classifier, preprocessing module, feature extraction module and clustering algorithm in the GRT on
+ synthetic accelerometer-like data. For each module it records the training time, the latency of a single prediction (or a single
+ call to process/computeFeatures), the throughput when a batch of samples is processed and the peak memory used by the module.
+ On Linux and OS X each module runs in its own child process, so the peak memory of one module is not hidden by the modules that
+ ran before it. It is reported as the growth of the peak resident memory above what the process was using when the module started.
+ On other platforms, or if a child process can not be created, the peak memory column is 0.
+
+ The results are written one row per module as CSV (the default) or as JSON lines, so the output of two releases can be compared.
+
+ Usage: Benchmark [options]
+    --samples N             the number of training samples, and the length of the data stream (default 1000)
+    --timeseries N          the number of training timeseries for the timeseries classifiers (default 40)
+    --dimensions N          the number of dimensions of each sample (default 3)
+    --classes N             the number of classes (default 4)
+    --template-length N     the length of each timeseries (default 50)
+    --predictions N         the number of single predictions that are timed for each module (default 1000)
+    --seed N                the seed used to generate the data (default 1)
+    --format csv|json       the output format (default csv)
+    --output filename       write the results to a file instead of stdout
+    --module name           only run the modules whose name contains this string
+    --verbose               show the GRT training, warning and error messages
+    --check                 run the consistency checks in Checks.cpp instead of the benchmarks, the exit code is non zero if one fails
+*/
+
+#include "GRT/GRT.h"
+#include "Checks.h"
+#include <cstring>
+
+#if defined(__GRT_LINUX_BUILD__) || defined(__GRT_OSX_BUILD__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace GRT;
+
+struct BenchmarkSettings{
+    UINT numSamples;
+    UINT numTimeSeries;
+    UINT numDimensions;
+    UINT numClasses;
+    UINT templateLength;
+    UINT numPredictions;
+    unsigned long long seed;
+    string format;
+    string outputFilename;
+    string moduleFilter;
+    bool verbose;
+    bool runChecks;
+};
+
+struct BenchmarkResult{
+    BenchmarkResult(const string &category = "",const string &moduleName = "",const string &inputType = "vector"){
+        this->category = category;
+        this->moduleName = moduleName;
+        this->inputType = inputType;
+        numTrainingSamples = 0;
+        numInputDimensions = 0;
+        trainingTime = 0;
+        batchSize = 0;
+        batchThroughput = 0;
+        peakMemory = 0;
+        status = "ok";
+    }
+
+    string category;
+    string moduleName;
+    string inputType;                                       ///< What a single prediction consumes, either one vector or one timeseries
+    UINT numTrainingSamples;
+    UINT numInputDimensions;
+    double trainingTime;                                    ///< The training time in milliseconds, 0 if the module is not trained
+    LatencyHistogram latency;                               ///< The latency of each single prediction in nanoseconds
+    UINT batchSize;
+    double batchThroughput;                                 ///< The number of inputs processed per second when a batch is processed
+    unsigned long long peakMemory;                          ///< How far the module raised the peak resident memory, in kilobytes
+    string status;
+};
+
+/*
+ Generates synthetic accelerometer-like data. Each class has a gravity offset and a sinusoidal movement on each axis, each timeseries
+ is a noisy copy of its class template played back at a slightly different speed.
+*/
+class SyntheticGestureData{
+public:
+    SyntheticGestureData(const BenchmarkSettings &settings){
+        numDimensions = settings.numDimensions;
+        numClasses = settings.numClasses;
+        templateLength = settings.templateLength;
+        random.setSeed( settings.seed );
+
+        offsets.resize( numClasses, numDimensions );
+        amplitudes.resize( numClasses, numDimensions );
+        frequencies.resize( numClasses, numDimensions );
+        phases.resize( numClasses, numDimensions );
+        for(UINT k=0; k<numClasses; k++){
+            for(UINT j=0; j<numDimensions; j++){
+                offsets[k][j] = random.getRandomNumberUniform(-1.0,1.0);
+                amplitudes[k][j] = random.getRandomNumberUniform(0.5,1.5);
+                frequencies[k][j] = random.getRandomNumberUniform(0.5,3.0);
+                phases[k][j] = random.getRandomNumberUniform(0,TWO_PI);
+            }
+        }
+    }
+
+    VectorDouble getSample(const UINT classIndex,const double t){
+        VectorDouble sample( numDimensions );
+        for(UINT j=0; j<numDimensions; j++){
+            sample[j] = offsets[classIndex][j] + amplitudes[classIndex][j] * sin( TWO_PI * frequencies[classIndex][j] * t / templateLength + phases[classIndex][j] );
+            sample[j] += random.getRandomNumberGauss(0,0.1);
+        }
+        return sample;
+    }
+
+    MatrixDouble getTimeSeries(const UINT classIndex){
+        MatrixDouble timeSeries( templateLength, numDimensions );
+        const double speed = random.getRandomNumberUniform(0.8,1.2);
+        for(UINT i=0; i<templateLength; i++){
+            timeSeries.setRowVector( getSample( classIndex, i*speed ), i );
+        }
+        return timeSeries;
+    }
+
+    LabelledClassificationData getClassificationData(const UINT numSamples){
+        LabelledClassificationData data( numDimensions );
+        for(UINT i=0; i<numSamples; i++){
+            const UINT classIndex = i % numClasses;
+            data.addSample( classIndex+1, getSample( classIndex, random.getRandomNumberUniform(0,templateLength) ) );
+        }
+        return data;
+    }
+
+    LabelledTimeSeriesClassificationData getTimeSeriesData(const UINT numTimeSeries){
+        LabelledTimeSeriesClassificationData data( numDimensions );
+        for(UINT i=0; i<numTimeSeries; i++){
+            const UINT classIndex = i % numClasses;
+            data.addSample( classIndex+1, getTimeSeries( classIndex ) );
+        }
+        return data;
+    }
+
+    MatrixDouble getStream(const UINT numSamples){
+        MatrixDouble stream( numSamples, numDimensions );
+        UINT i = 0;
+        while( i < numSamples ){
+            const MatrixDouble timeSeries = getTimeSeries( random.getRandomNumberInt(0,numClasses) );
+            for(UINT r=0; r<timeSeries.getNumRows() && i<numSamples; r++,i++){
+                for(UINT j=0; j<numDimensions; j++) stream[i][j] = timeSeries[r][j];
+            }
+        }
+        return stream;
+    }
+
+protected:
+    UINT numDimensions;
+    UINT numClasses;
+    UINT templateLength;
+    Random random;
+    MatrixDouble offsets;
+    MatrixDouble amplitudes;
+    MatrixDouble frequencies;
+    MatrixDouble phases;
+};
+
+//Drops everything written to it, this hides the text some modules print to cout while they train
+class NullStreamBuffer : public streambuf{
+protected:
+    virtual int overflow(int c){ return c; }
+};
+
+void quietPrint(const char *text){}
+
+//Returns the peak resident memory of the process in kilobytes, in a freshly forked child this starts at the memory in use at the fork
+unsigned long long getPeakMemory(){
+#if defined(__GRT_LINUX_BUILD__)
+    ifstream file("/proc/self/status");
+    string line;
+    while( getline(file,line) ){
+        if( line.compare(0,6,"VmHWM:") == 0 ) return strtoull( line.c_str()+6, NULL, 10 );
+    }
+#endif
+#if defined(__GRT_LINUX_BUILD__) || defined(__GRT_OSX_BUILD__)
+    struct rusage usage;
+    if( getrusage( RUSAGE_SELF, &usage ) == 0 ){
+#if defined(__GRT_OSX_BUILD__)
+        return (unsigned long long)usage.ru_maxrss / 1024;
+#else
+        return (unsigned long long)usage.ru_maxrss;
+#endif
+    }
+#endif
+    return 0;
+}
+
+double getElapsedSeconds(const unsigned long long startTime){
+    return double( PipelineProfiler::getTimeStamp() - startTime ) * 1.0e-9;
+}
+
+//Converts a stream into symbols for the HMM, the first axis is split into numSymbols equal bins
+MatrixDouble quantizeStream(const MatrixDouble &stream,const UINT numSymbols){
+    MatrixDouble symbols( stream.getNumRows(), 1 );
+    for(UINT i=0; i<stream.getNumRows(); i++){
+        const double x = ( stream[i][0] + 3.0 ) / 6.0;
+        const int symbol = int( x * numSymbols );
+        symbols[i][0] = symbol < 0 ? 0 : ( symbol >= int(numSymbols) ? numSymbols-1 : symbol );
+    }
+    return symbols;
+}
+
+LabelledTimeSeriesClassificationData quantizeTimeSeriesData(LabelledTimeSeriesClassificationData &data,const UINT numSymbols){
+    LabelledTimeSeriesClassificationData symbolData( 1 );
+    for(UINT i=0; i<data.getNumSamples(); i++){
+        symbolData.addSample( data[i].getClassLabel(), quantizeStream( data[i].getData(), numSymbols ) );
+    }
+    return symbolData;
+}
+
+BenchmarkResult benchmarkClassifier(const Classifier &classifier,LabelledClassificationData &trainingData,const MatrixDouble &testData,const BenchmarkSettings &settings){
+
+    BenchmarkResult result("classifier",classifier.getClassifierType());
+    result.numTrainingSamples = trainingData.getNumSamples();
+    result.numInputDimensions = trainingData.getNumDimensions();
+
+    GestureRecognitionPipeline pipeline;
+    pipeline.setClassifier( classifier );
+
+    unsigned long long startTime = PipelineProfiler::getTimeStamp();
+    if( !pipeline.train( trainingData ) ){
+        result.status = "train_failed";
+        return result;
+    }
+    result.trainingTime = getElapsedSeconds( startTime ) * 1000.0;
+
+    VectorDouble sample;
+    for(UINT i=0; i<settings.numPredictions; i++){
+        sample = testData.getRowVector( i % testData.getNumRows() );
+        startTime = PipelineProfiler::getTimeStamp();
+        if( !pipeline.predict( sample ) ){
+            result.status = "predict_failed";
+            return result;
+        }
+        result.latency.record( PipelineProfiler::getTimeStamp() - startTime );
+    }
+
+    startTime = PipelineProfiler::getTimeStamp();
+    if( !pipeline.predictBatch( testData ) ){
+        result.status = "batch_failed";
+        return result;
+    }
+    result.batchSize = testData.getNumRows();
+    result.batchThroughput = result.batchSize / getElapsedSeconds( startTime );
+
+    return result;
+}
+
+BenchmarkResult benchmarkTimeSeriesClassifier(const Classifier &classifier,LabelledTimeSeriesClassificationData &trainingData,const vector< MatrixDouble > &testData,const BenchmarkSettings &settings){
+
+    BenchmarkResult result("classifier",classifier.getClassifierType(),"timeseries");
+    result.numTrainingSamples = trainingData.getNumSamples();
+    result.numInputDimensions = trainingData.getNumDimensions();
+
+    GestureRecognitionPipeline pipeline;
+    pipeline.setClassifier( classifier );
+
+    unsigned long long startTime = PipelineProfiler::getTimeStamp();
+    if( !pipeline.train( trainingData ) ){
+        result.status = "train_failed";
+        return result;
+    }
+    result.trainingTime = getElapsedSeconds( startTime ) * 1000.0;
+
+    for(UINT i=0; i<settings.numPredictions; i++){
+        startTime = PipelineProfiler::getTimeStamp();
+        if( !pipeline.predict( testData[ i % testData.size() ] ) ){
+            result.status = "predict_failed";
+            return result;
+        }
+        result.latency.record( PipelineProfiler::getTimeStamp() - startTime );
+    }
+
+    startTime = PipelineProfiler::getTimeStamp();
+    if( !pipeline.predictBatch( testData ) ){
+        result.status = "batch_failed";
+        return result;
+    }
+    result.batchSize = (UINT)testData.size();
+    result.batchThroughput = result.batchSize / getElapsedSeconds( startTime );
+
+    return result;
+}
+
+//The HMM is trained with symbol timeseries but predicts one symbol at a time
+BenchmarkResult benchmarkHMM(LabelledTimeSeriesClassificationData &trainingData,const MatrixDouble &testStream,const BenchmarkSettings &settings){
+
+    const UINT numSymbols = 10;
+    HMM hmm(5,numSymbols);
+    LabelledTimeSeriesClassificationData symbolData = quantizeTimeSeriesData( trainingData, numSymbols );
+    const MatrixDouble testSymbols = quantizeStream( testStream, numSymbols );
+
+    BenchmarkResult result("classifier",hmm.getClassifierType());
+    result.numTrainingSamples = symbolData.getNumSamples();
+    result.numInputDimensions = symbolData.getNumDimensions();
+
+    GestureRecognitionPipeline pipeline;
+    pipeline.setClassifier( hmm );
+
+    unsigned long long startTime = PipelineProfiler::getTimeStamp();
+    if( !pipeline.train( symbolData ) ){
+        result.status = "train_failed";
+        return result;
+    }
+    result.trainingTime = getElapsedSeconds( startTime ) * 1000.0;
+
+    VectorDouble sample(1);
+    for(UINT i=0; i<settings.numPredictions; i++){
+        sample[0] = testSymbols[ i % testSymbols.getNumRows() ][0];
+        startTime = PipelineProfiler::getTimeStamp();
+        if( !pipeline.predict( sample ) ){
+            result.status = "predict_failed";
+            return result;
+        }
+        result.latency.record( PipelineProfiler::getTimeStamp() - startTime );
+    }
+
+    startTime = PipelineProfiler::getTimeStamp();
+    if( !pipeline.predictBatch( testSymbols ) ){
+        result.status = "batch_failed";
+        return result;
+    }
+    result.batchSize = testSymbols.getNumRows();
+    result.batchThroughput = result.batchSize / getElapsedSeconds( startTime );
+
+    return result;
+}
+
+BenchmarkResult benchmarkPreProcessing(PreProcessing &module,const MatrixDouble &stream,const BenchmarkSettings &settings){
+
+    BenchmarkResult result("preprocessing",module.getPreProcessingType());
+    result.numInputDimensions = stream.getNumCols();
+
+    VectorDouble sample;
+    unsigned long long startTime = 0;
+    for(UINT i=0; i<settings.numPredictions; i++){
+        sample = stream.getRowVector( i % stream.getNumRows() );
+        startTime = PipelineProfiler::getTimeStamp();
+        if( !module.process( sample ) ){
+            result.status = "process_failed";
+            return result;
+        }
+        result.latency.record( PipelineProfiler::getTimeStamp() - startTime );
+    }
+
+    //The batch copies each row outside of the timed loop, so the throughput only includes the module
+    vector< VectorDouble > batch( stream.getNumRows() );
+    for(UINT i=0; i<stream.getNumRows(); i++) batch[i] = stream.getRowVector( i );
+
+    module.reset();
+    startTime = PipelineProfiler::getTimeStamp();
+    for(UINT i=0; i<batch.size(); i++){
+        if( !module.process( batch[i] ) ){
+            result.status = "batch_failed";
+            return result;
+        }
+    }
+    result.batchSize = (UINT)batch.size();
+    result.batchThroughput = result.batchSize / getElapsedSeconds( startTime );
+
+    return result;
+}
+
+BenchmarkResult benchmarkFeatureExtraction(FeatureExtraction &module,const MatrixDouble &stream,const BenchmarkSettings &settings,const double trainingTime = 0,const UINT numTrainingSamples = 0){
+
+    BenchmarkResult result("feature_extraction",module.getFeatureExtractionType());
+    result.numInputDimensions = stream.getNumCols();
+    result.trainingTime = trainingTime;
+    result.numTrainingSamples = numTrainingSamples;
+
+    VectorDouble sample;
+    unsigned long long startTime = 0;
+    for(UINT i=0; i<settings.numPredictions; i++){
+        sample = stream.getRowVector( i % stream.getNumRows() );
+        startTime = PipelineProfiler::getTimeStamp();
+        if( !module.computeFeatures( sample ) ){
+            result.status = "process_failed";
+            return result;
+        }
+        result.latency.record( PipelineProfiler::getTimeStamp() - startTime );
+    }
+
+    vector< VectorDouble > batch( stream.getNumRows() );
+    for(UINT i=0; i<stream.getNumRows(); i++) batch[i] = stream.getRowVector( i );
+
+    module.reset();
+    startTime = PipelineProfiler::getTimeStamp();
+    for(UINT i=0; i<batch.size(); i++){
+        if( !module.computeFeatures( batch[i] ) ){
+            result.status = "batch_failed";
+            return result;
+        }
+    }
+    result.batchSize = (UINT)batch.size();
+    result.batchThroughput = result.batchSize / getElapsedSeconds( startTime );
+
+    return result;
+}
+
+BenchmarkResult benchmarkPeakDetection(const MatrixDouble &stream,const BenchmarkSettings &settings){
+
+    PeakDetection peakDetection;
+    BenchmarkResult result("feature_extraction","PeakDetection");
+    result.numInputDimensions = 1;
+
+    unsigned long long startTime = 0;
+    for(UINT i=0; i<settings.numPredictions; i++){
+        const double x = stream[ i % stream.getNumRows() ][0];
+        startTime = PipelineProfiler::getTimeStamp();
+        peakDetection.update( x );
+        result.latency.record( PipelineProfiler::getTimeStamp() - startTime );
+    }
+
+    peakDetection.reset();
+    startTime = PipelineProfiler::getTimeStamp();
+    for(UINT i=0; i<stream.getNumRows(); i++){
+        peakDetection.update( stream[i][0] );
+    }
+    result.batchSize = stream.getNumRows();
+    result.batchThroughput = result.batchSize / getElapsedSeconds( startTime );
+
+    return result;
+}
+
+BenchmarkResult benchmarkPCA(MatrixDouble &trainingData,const MatrixDouble &stream,const BenchmarkSettings &settings){
+
+    PrincipalComponentAnalysis pca;
+    BenchmarkResult result("feature_extraction","PrincipalComponentAnalysis");
+    result.numTrainingSamples = trainingData.getNumRows();
+    result.numInputDimensions = trainingData.getNumCols();
+
+    unsigned long long startTime = PipelineProfiler::getTimeStamp();
+    if( !pca.computeFeatureVector( trainingData, (UINT)trainingData.getNumCols() ) ){
+        result.status = "train_failed";
+        return result;
+    }
+    result.trainingTime = getElapsedSeconds( startTime ) * 1000.0;
+
+    MatrixDouble sample( 1, stream.getNumCols() );
+    MatrixDouble projectedData;
+    for(UINT i=0; i<settings.numPredictions; i++){
+        sample.setRowVector( stream.getRowVector( i % stream.getNumRows() ), 0 );
+        startTime = PipelineProfiler::getTimeStamp();
+        if( !pca.project( sample, projectedData ) ){
+            result.status = "predict_failed";
+            return result;
+        }
+        result.latency.record( PipelineProfiler::getTimeStamp() - startTime );
+    }
+
+    startTime = PipelineProfiler::getTimeStamp();
+    if( !pca.project( stream, projectedData ) ){
+        result.status = "batch_failed";
+        return result;
+    }
+    result.batchSize = stream.getNumRows();
+    result.batchThroughput = result.batchSize / getElapsedSeconds( startTime );
+
+    return result;
+}
+
+BenchmarkResult benchmarkKMeansQuantizer(MatrixDouble &trainingData,const MatrixDouble &stream,const BenchmarkSettings &settings){
+
+    KMeansQuantizer quantizer( trainingData.getNumCols(), 10 );
+
+    const unsigned long long startTime = PipelineProfiler::getTimeStamp();
+    if( !quantizer.train( trainingData ) ){
+        BenchmarkResult result("feature_extraction",quantizer.getFeatureExtractionType());
+        result.status = "train_failed";
+        return result;
+    }
+    const double trainingTime = getElapsedSeconds( startTime ) * 1000.0;
+
+    return benchmarkFeatureExtraction( quantizer, stream, settings, trainingTime, trainingData.getNumRows() );
+}
+
+BenchmarkResult benchmarkKMeans(MatrixDouble &trainingData,const MatrixDouble &stream,const BenchmarkSettings &settings){
+
+    KMeans kmeans;
+    BenchmarkResult result("clustering","KMeans");
+    result.numTrainingSamples = trainingData.getNumRows();
+    result.numInputDimensions = trainingData.getNumCols();
+
+    unsigned long long startTime = PipelineProfiler::getTimeStamp();
+    if( !kmeans.train( settings.numClasses, trainingData ) ){
+        result.status = "train_failed";
+        return result;
+    }
+    result.trainingTime = getElapsedSeconds( startTime ) * 1000.0;
+
+    UINT predictedClusterLabel = 0;
+    double maxLikelihood = 0;
+    VectorDouble clusterLikelihoods;
+    for(UINT i=0; i<settings.numPredictions; i++){
+        const VectorDouble sample = stream.getRowVector( i % stream.getNumRows() );
+        startTime = PipelineProfiler::getTimeStamp();
+        if( !kmeans.predict( sample, predictedClusterLabel, maxLikelihood, clusterLikelihoods ) ){
+            result.status = "predict_failed";
+            return result;
+        }
+        result.latency.record( PipelineProfiler::getTimeStamp() - startTime );
+    }
+
+    vector< VectorDouble > batch( stream.getNumRows() );
+    for(UINT i=0; i<stream.getNumRows(); i++) batch[i] = stream.getRowVector( i );
+
+    startTime = PipelineProfiler::getTimeStamp();
+    for(UINT i=0; i<batch.size(); i++){
+        if( !kmeans.predict( batch[i], predictedClusterLabel, maxLikelihood, clusterLikelihoods ) ){
+            result.status = "batch_failed";
+            return result;
+        }
+    }
+    result.batchSize = (UINT)batch.size();
+    result.batchThroughput = result.batchSize / getElapsedSeconds( startTime );
+
+    return result;
+}
+
+//The GaussianMixtureModels and HierarchicalClustering classes can only be trained, so only the training time is recorded
+BenchmarkResult benchmarkGaussianMixtureModels(MatrixDouble &trainingData,const BenchmarkSettings &settings){
+
+    GaussianMixtureModels gmm;
+    BenchmarkResult result("clustering","GaussianMixtureModels");
+    result.numTrainingSamples = trainingData.getNumRows();
+    result.numInputDimensions = trainingData.getNumCols();
+
+    const unsigned long long startTime = PipelineProfiler::getTimeStamp();
+    if( !gmm.train( trainingData, settings.numClasses ) ){
+        result.status = "train_failed";
+        return result;
+    }
+    result.trainingTime = getElapsedSeconds( startTime ) * 1000.0;
+
+    return result;
+}
+
+BenchmarkResult benchmarkHierarchicalClustering(MatrixDouble &trainingData){
+
+    HierarchicalClustering clustering;
+    BenchmarkResult result("clustering","HierarchicalClustering");
+    result.numTrainingSamples = trainingData.getNumRows();
+    result.numInputDimensions = trainingData.getNumCols();
+
+    const unsigned long long startTime = PipelineProfiler::getTimeStamp();
+    if( !clustering.train( trainingData ) ){
+        result.status = "train_failed";
+        return result;
+    }
+    result.trainingTime = getElapsedSeconds( startTime ) * 1000.0;
+
+    return result;
+}
+
+void writeHeader(ostream &stream,const BenchmarkSettings &settings){
+    if( settings.format == "csv" ){
+        stream << "category,module,input_type,training_samples,input_dimensions,train_ms,predictions,latency_mean_us,latency_p50_us,";
+        stream << "latency_p90_us,latency_p99_us,latency_max_us,batch_size,batch_throughput_per_s,peak_memory_kb,status" << endl;
+    }
+}
+
+void writeResult(ostream &stream,const BenchmarkResult &result,const BenchmarkSettings &settings){
+
+    const LatencyHistogram &latency = result.latency;
+    if( settings.format == "json" ){
+        stream << "{\"category\":\"" << result.category << "\",\"module\":\"" << result.moduleName << "\",\"input_type\":\"" << result.inputType << "\"";
+        stream << ",\"training_samples\":" << result.numTrainingSamples << ",\"input_dimensions\":" << result.numInputDimensions;
+        stream << ",\"train_ms\":" << result.trainingTime << ",\"predictions\":" << latency.getCount();
+        stream << ",\"latency_mean_us\":" << latency.getMean()/1000.0 << ",\"latency_p50_us\":" << latency.getPercentile(50)/1000.0;
+        stream << ",\"latency_p90_us\":" << latency.getPercentile(90)/1000.0 << ",\"latency_p99_us\":" << latency.getPercentile(99)/1000.0;
+        stream << ",\"latency_max_us\":" << latency.getMax()/1000.0 << ",\"batch_size\":" << result.batchSize;
+        stream << ",\"batch_throughput_per_s\":" << result.batchThroughput << ",\"peak_memory_kb\":" << result.peakMemory;
+        stream << ",\"status\":\"" << result.status << "\"}" << endl;
+        return;
+    }
+
+    stream << result.category << "," << result.moduleName << "," << result.inputType << "," << result.numTrainingSamples << ",";
+    stream << result.numInputDimensions << "," << result.trainingTime << "," << latency.getCount() << "," << latency.getMean()/1000.0 << ",";
+    stream << latency.getPercentile(50)/1000.0 << "," << latency.getPercentile(90)/1000.0 << "," << latency.getPercentile(99)/1000.0 << ",";
+    stream << latency.getMax()/1000.0 << "," << result.batchSize << "," << result.batchThroughput << "," << result.peakMemory << ",";
+    stream << result.status << endl;
+}
+
+bool parseArguments(int argc,const char * argv[],BenchmarkSettings &settings){
+
+    for(int i=1; i<argc; i++){
+        const string arg = argv[i];
+        if( arg == "--verbose" ){
+            settings.verbose = true;
+            continue;
+        }
+        if( arg == "--check" ){
+            settings.runChecks = true;
+            continue;
+        }
+        if( i+1 >= argc ){
+            cerr << "Missing value for argument: " << arg << endl;
+            return false;
+        }
+        const string value = argv[++i];
+        if( arg == "--samples" ) settings.numSamples = (UINT)atoi( value.c_str() );
+        else if( arg == "--timeseries" ) settings.numTimeSeries = (UINT)atoi( value.c_str() );
+        else if( arg == "--dimensions" ) settings.numDimensions = (UINT)atoi( value.c_str() );
+        else if( arg == "--classes" ) settings.numClasses = (UINT)atoi( value.c_str() );
+        else if( arg == "--template-length" ) settings.templateLength = (UINT)atoi( value.c_str() );
+        else if( arg == "--predictions" ) settings.numPredictions = (UINT)atoi( value.c_str() );
+        else if( arg == "--seed" ) settings.seed = strtoull( value.c_str(), NULL, 10 );
+        else if( arg == "--format" ) settings.format = value;
+        else if( arg == "--output" ) settings.outputFilename = value;
+        else if( arg == "--module" ) settings.moduleFilter = value;
+        else{
+            cerr << "Unknown argument: " << arg << endl;
+            return false;
+        }
+    }
+
+    if( settings.numSamples == 0 || settings.numTimeSeries == 0 || settings.numDimensions == 0 || settings.numClasses < 2 || settings.templateLength < 2 || settings.numPredictions == 0 ){
+        cerr << "The samples, timeseries, dimensions and predictions must be greater than 0, the classes and template length must be at least 2" << endl;
+        return false;
+    }
+    if( settings.format != "csv" && settings.format != "json" ){
+        cerr << "Unknown format: " << settings.format << ", the format should be csv or json" << endl;
+        return false;
+    }
+    return true;
+}
+
+int main (int argc, const char * argv[])
+{
+    BenchmarkSettings settings;
+    settings.numSamples = 1000;
+    settings.numTimeSeries = 40;
+    settings.numDimensions = 3;
+    settings.numClasses = 4;
+    settings.templateLength = 50;
+    settings.numPredictions = 1000;
+    settings.seed = 1;
+    settings.format = "csv";
+    settings.verbose = false;
+    settings.runChecks = false;
+
+    if( !parseArguments( argc, argv, settings ) ){
+        return EXIT_FAILURE;
+    }
+
+    ofstream outputFile;
+    if( settings.outputFilename != "" ){
+        outputFile.open( settings.outputFilename.c_str() );
+        if( !outputFile.is_open() ){
+            cerr << "Failed to open the output file: " << settings.outputFilename << endl;
+            return EXIT_FAILURE;
+        }
+    }
+    ostream output( outputFile.is_open() ? outputFile.rdbuf() : cout.rdbuf() );
+
+    //Unless the messages are wanted, turn off the GRT logs and anything else the modules print so the output only contains the results
+    NullStreamBuffer nullBuffer;
+    streambuf *coutBuffer = cout.rdbuf();
+    if( !settings.verbose ){
+        TrainingLog::enableLogging( false );
+        WarningLog::enableLogging( false );
+        ErrorLog::enableLogging( false );
+        DebugLog::enableLogging( false );
+        LIBSVM::svm_set_print_string_function( &quietPrint );
+        cout.rdbuf( &nullBuffer );
+    }
+
+    if( settings.runChecks ){
+        const bool passed = runConsistencyChecks( settings.seed, output );
+        output.flush();
+        cout.rdbuf( coutBuffer );
+        return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    //Generate the data, the test data comes from the same generator so it does not repeat the training data
+    SyntheticGestureData generator( settings );
+    LabelledClassificationData trainingData = generator.getClassificationData( settings.numSamples );
+    LabelledTimeSeriesClassificationData timeSeriesTrainingData = generator.getTimeSeriesData( settings.numTimeSeries );
+    MatrixDouble trainingMatrix = trainingData.getDataAsMatrixDouble();
+    const MatrixDouble testData = generator.getClassificationData( settings.numSamples ).getDataAsMatrixDouble();
+    const MatrixDouble stream = generator.getStream( settings.numSamples );
+    vector< MatrixDouble > testTimeSeries( settings.numTimeSeries );
+    for(UINT i=0; i<settings.numTimeSeries; i++) testTimeSeries[i] = generator.getTimeSeries( i % settings.numClasses );
+
+    //The hierarchical clustering stores the distance between every pair of samples, so it is trained on at most 1000 samples
+    MatrixDouble hierarchicalTrainingMatrix( settings.numSamples < 1000 ? settings.numSamples : 1000, settings.numDimensions );
+    for(UINT i=0; i<hierarchicalTrainingMatrix.getNumRows(); i++){
+        hierarchicalTrainingMatrix.setRowVector( trainingMatrix.getRowVector( i ), i );
+    }
+
+    const UINT D = settings.numDimensions;
+    const UINT fftWindowSize = 64;
+
+    AdaBoost adaBoost;
+    adaBoost.setWeakClassifier( DecisionStump() );
+    BAG bag;
+    bag.addClassifierToEnsemble( ANBC() );
+    bag.addClassifierToEnsemble( KNN() );
+    bag.addClassifierToEnsemble( MinDist() );
+
+    writeHeader( output, settings );
+
+    //Each entry runs one benchmark, the modules are listed in the same order as their directories
+    const char *moduleNames[] = {
+        "ANBC","AdaBoost","BAG","DTW","GMM","HMM",
+        "KNN","LDA","MinDist","SVM","Softmax","DeadZone",
+        "Derivative","DoubleMovingAverageFilter","HighPassFilter","LowPassFilter","MovingAverageFilter","SavitzkyGolayFilter",
+        "FFT","FFTFeatures","KMeansQuantizer","MovementIndex","MovementTrajectoryFeatures","PrincipalComponentAnalysis",
+        "PeakDetection","TimeDomainFeatures","TimeseriesBuffer","ZeroCrossingCounter","GaussianMixtureModels","HierarchicalClustering",
+        "KMeans"
+    };
+    const UINT numBenchmarks = sizeof(moduleNames) / sizeof(moduleNames[0]);
+    for(UINT b=0; b<numBenchmarks; b++){
+        const string moduleName = moduleNames[b];
+        if( settings.moduleFilter != "" && moduleName.find( settings.moduleFilter ) == string::npos ) continue;
+
+        BenchmarkResult result;
+
+#if defined(__GRT_LINUX_BUILD__) || defined(__GRT_OSX_BUILD__)
+        //Run the module in a child process and wait for it, so every module starts from the same memory as the parent
+        output.flush();
+        const pid_t pid = fork();
+        if( pid > 0 ){
+            int status = 0;
+            if( waitpid( pid, &status, 0 ) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS ){
+                result.moduleName = moduleName;
+                result.status = "crashed";
+                writeResult( output, result, settings );
+            }
+            continue;
+        }
+        const bool isChildProcess = pid == 0;
+#else
+        const bool isChildProcess = false;
+#endif
+        const unsigned long long startMemory = isChildProcess ? getPeakMemory() : 0;
+
+        switch( b ){
+            case 0: result = benchmarkClassifier( ANBC(), trainingData, testData, settings ); break;
+            case 1: result = benchmarkClassifier( adaBoost, trainingData, testData, settings ); break;
+            case 2: result = benchmarkClassifier( bag, trainingData, testData, settings ); break;
+            case 3: result = benchmarkTimeSeriesClassifier( DTW(), timeSeriesTrainingData, testTimeSeries, settings ); break;
+            case 4: result = benchmarkClassifier( GMM(), trainingData, testData, settings ); break;
+            case 5: result = benchmarkHMM( timeSeriesTrainingData, stream, settings ); break;
+            case 6: result = benchmarkClassifier( KNN(), trainingData, testData, settings ); break;
+            case 7: result = benchmarkClassifier( LDA(), trainingData, testData, settings ); break;
+            case 8: result = benchmarkClassifier( MinDist(), trainingData, testData, settings ); break;
+            case 9: result = benchmarkClassifier( SVM(), trainingData, testData, settings ); break;
+            case 10: result = benchmarkClassifier( Softmax(), trainingData, testData, settings ); break;
+            case 11: { DeadZone module(-0.1,0.1,D); result = benchmarkPreProcessing( module, stream, settings ); } break;
+            case 12: { Derivative module(Derivative::FIRST_DERIVATIVE,1,D); result = benchmarkPreProcessing( module, stream, settings ); } break;
+            case 13: { DoubleMovingAverageFilter module(5,D); result = benchmarkPreProcessing( module, stream, settings ); } break;
+            case 14: { HighPassFilter module(0.1,1,D); result = benchmarkPreProcessing( module, stream, settings ); } break;
+            case 15: { LowPassFilter module(0.1,1,D); result = benchmarkPreProcessing( module, stream, settings ); } break;
+            case 16: { MovingAverageFilter module(5,D); result = benchmarkPreProcessing( module, stream, settings ); } break;
+            case 17: { SavitzkyGolayFilter module(10,10,0,2,D); result = benchmarkPreProcessing( module, stream, settings ); } break;
+            case 18: { FFT module(fftWindowSize,1,D); result = benchmarkFeatureExtraction( module, stream, settings ); } break;
+            case 19: {
+                //The FFTFeatures module is given the magnitude of an FFT, the spectrum of a random signal is close enough for timing
+                FFTFeatures module(fftWindowSize,D);
+                Random random( settings.seed );
+                MatrixDouble spectrum( stream.getNumRows(), fftWindowSize*D );
+                for(UINT i=0; i<spectrum.getNumRows(); i++){
+                    for(UINT j=0; j<spectrum.getNumCols(); j++) spectrum[i][j] = random.getRandomNumberUniform(0,1);
+                }
+                result = benchmarkFeatureExtraction( module, spectrum, settings );
+            }
+            break;
+            case 20: result = benchmarkKMeansQuantizer( trainingMatrix, stream, settings ); break;
+            case 21: { MovementIndex module(100,D); result = benchmarkFeatureExtraction( module, stream, settings ); } break;
+            case 22: { MovementTrajectoryFeatures module(100,10,MovementTrajectoryFeatures::CENTROID_VALUE,10,D); result = benchmarkFeatureExtraction( module, stream, settings ); } break;
+            case 23: result = benchmarkPCA( trainingMatrix, stream, settings ); break;
+            case 24: result = benchmarkPeakDetection( stream, settings ); break;
+            case 25: { TimeDomainFeatures module(100,10,D); result = benchmarkFeatureExtraction( module, stream, settings ); } break;
+            case 26: { TimeseriesBuffer module(settings.templateLength,D); result = benchmarkFeatureExtraction( module, stream, settings ); } break;
+            case 27: { ZeroCrossingCounter module(20,0.01,D); result = benchmarkFeatureExtraction( module, stream, settings ); } break;
+            case 28: result = benchmarkGaussianMixtureModels( trainingMatrix, settings ); break;
+            case 29: result = benchmarkHierarchicalClustering( hierarchicalTrainingMatrix ); break;
+            case 30: result = benchmarkKMeans( trainingMatrix, stream, settings ); break;
+        }
+
+        result.moduleName = moduleName;
+        if( isChildProcess ){
+            const unsigned long long peakMemory = getPeakMemory();
+            result.peakMemory = peakMemory > startMemory ? peakMemory - startMemory : 0;
+        }
+        writeResult( output, result, settings );
+
+        if( isChildProcess ){
+            output.flush();
+            _exit( EXIT_SUCCESS );
+        }
+    }
+
+    output.flush();
+    cout.rdbuf( coutBuffer );
+
+    return EXIT_SUCCESS;
+}
@@ -31,6 +31,7 @@ ANBC::ANBC(bool useScaling,bool useNullRejection,double nullRejectionCoeff)
     this->useNullRejection = useNullRejection;
     this->nullRejectionCoeff = nullRejectionCoeff;
     weightsDataSet = false;
+    statelessPrediction = true;
     classifierType = "ANBC";
     classifierMode = STANDARD_CLASSIFIER_MODE;
     debugLog.setProceedingText("[DEBUG ANBC]");
@@ -79,18 +80,39 @@ bool ANBC::train(LabelledClassificationData trainingData){
     return train(trainingData,nullRejectionCoeff);
 }
 
+bool ANBC::train(const LabelledClassificationDataView &trainingData){
+    
+    //The samples in the view are copied straight into the flat buffer
+    FlatClassificationData data( trainingData );
+    
+    return train_( data, trainingData.getRanges(), nullRejectionCoeff );
+}
+
 /* double predict(vVectorDouble x)
  This method returns the ID of the most likely class given the observation x and the trained models
  */
 bool ANBC::predict(VectorDouble inputVector){
+    return predict_( inputVector, predictedClassLabel, maxLikelihood, classLikelihoods, classDistances );
+}
+
+bool ANBC::predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const{
+    VectorDouble x = inputVector;
+    if( !predict_( x, result.predictedClassLabel, result.maximumLikelihood, result.classLikelihoods, result.classDistances ) ){
+        return false;
+    }
+    result.unprocessedPredictedClassLabel = result.predictedClassLabel;
+    return true;
+}
+
+bool ANBC::predict_(VectorDouble &inputVector,UINT &predictedLabel,double &maximumLikelihood,VectorDouble &likelihoods,VectorDouble &distances) const{
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - ANBC Model Not Trained!" << endl;
         return false;
     }
     
-    predictedClassLabel = 0;
-	maxLikelihood = -10000;
+    predictedLabel = 0;
+	maximumLikelihood = -10000;
     
     if( !trained ) return false;
     
@@ -105,49 +127,57 @@ bool ANBC::predict(VectorDouble inputVector){
         }
     }
     
-    if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
-    if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
+    if( likelihoods.size() != numClasses ) likelihoods.resize(numClasses,0);
+    if( distances.size() != numClasses ) distances.resize(numClasses,0);
     
     double classLikelihoodsSum = 0;
     double minDist = -99e+99;
 	for(UINT k=0; k<numClasses; k++){
-		classDistances[k] = models[k].predict( inputVector );
+		distances[k] = models[k].predict( inputVector );
         
         //At this point the class likelihoods and class distances are the same thing
-        classLikelihoods[k] = classDistances[k];
+        likelihoods[k] = distances[k];
         
         //If the distances are very far away then they could be -inf or nan so catch this so the sum still works
-        if( isinf(classLikelihoods[k]) || isnan(classLikelihoods[k]) ) classLikelihoods[k] = -10000;
+        if( isinf(likelihoods[k]) || isnan(likelihoods[k]) ) likelihoods[k] = -10000;
         
         //Make the 
-        classLikelihoods[k] = exp( classLikelihoods[k] );
-        classLikelihoodsSum += classLikelihoods[k];
+        likelihoods[k] = exp( likelihoods[k] );
+        classLikelihoodsSum += likelihoods[k];
 
         //The loglikelihood values are negative so we want the values closest to 0
-		if( classDistances[k] > minDist ){
-			minDist = classDistances[k];
-			predictedClassLabel = k;
+		if( distances[k] > minDist ){
+			minDist = distances[k];
+			predictedLabel = k;
 		}
     }
     
     //Normalize the classlikelihoods
     for(UINT k=0; k<numClasses; k++){
-        if( classLikelihoodsSum == 0 ) classLikelihoods[k] = 0;
-        else classLikelihoods[k] /= classLikelihoodsSum;
+        if( classLikelihoodsSum == 0 ) likelihoods[k] = 0;
+        else likelihoods[k] /= classLikelihoodsSum;
     }
-    maxLikelihood = classLikelihoods[predictedClassLabel];
+    maximumLikelihood = likelihoods[predictedLabel];
     
     if( useNullRejection ){
         //Check to see if the best result is greater than the models threshold
-        if( minDist >= models[predictedClassLabel].threshold ) predictedClassLabel = models[predictedClassLabel].classLabel;
-        else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
-    }else predictedClassLabel = models[predictedClassLabel].classLabel;
+        if( minDist >= models[predictedLabel].threshold ) predictedLabel = models[predictedLabel].classLabel;
+        else predictedLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
+    }else predictedLabel = models[predictedLabel].classLabel;
     
     return true;
 }
 
 bool ANBC::train(LabelledClassificationData &labelledTrainingData,double gamma){
     
+    //Copy the samples into one flat buffer, so the data for each class can be gathered with a single scan
+    FlatClassificationData data( labelledTrainingData );
+    
+    return train_( data, labelledTrainingData.getRanges(), gamma );
+}
+    
+bool ANBC::train_(const FlatClassificationData &labelledTrainingData,const vector< MinMax > &dataRanges,double gamma){
+    
     const unsigned int M = labelledTrainingData.getNumSamples();
     const unsigned int N = labelledTrainingData.getNumDimensions();
     const unsigned int K = labelledTrainingData.getNumClasses();
@@ -171,7 +201,7 @@ bool ANBC::train(LabelledClassificationData &labelledTrainingData,double gamma){
     numClasses = K;
     models.resize(K);
     classLabels.resize(K);
-    ranges = labelledTrainingData.getRanges();
+    ranges = dataRanges;
     
     //Train each of the models
 	for(UINT k=0; k<numClasses; k++){
@@ -203,16 +233,13 @@ bool ANBC::train(LabelledClassificationData &labelledTrainingData,double gamma){
             for(UINT j=0; j<numFeatures; j++) weights[j] = 1.0;
         }
         
-        //Get all the training data for this class
-        LabelledClassificationData classData = labelledTrainingData.getClassData(classLabel);
-        MatrixDouble data(classData.getNumSamples(),N);
-        
-        //Copy the training data into a matrix, scaling the training data if needed
-        for(UINT i=0; i<data.getNumRows(); i++){
-            for(UINT j=0; j<data.getNumCols(); j++){
-                if( useScaling ){
-                    data[i][j] = scale(classData[i][j],ranges[j].minValue,ranges[j].maxValue,MIN_SCALE_VALUE,MAX_SCALE_VALUE);
-                }else data[i][j] = classData[i][j];
+        //Get all the training data for this class, scaling the training data if needed
+        MatrixDouble data = labelledTrainingData.getClassDataAsMatrixDouble(classLabel);
+        if( useScaling ){
+            for(UINT i=0; i<data.getNumRows(); i++){
+                for(UINT j=0; j<data.getNumCols(); j++){
+                    data[i][j] = scale(data[i][j],ranges[j].minValue,ranges[j].maxValue,MIN_SCALE_VALUE,MAX_SCALE_VALUE);
+                }
             }
         }
         
@@ -385,57 +412,51 @@ bool ANBC::loadModelFromFile(fstream &file){
         errorLog << "loadANBCModelFromFile(string filename) - Could not open file to load model" << endl;
         return false;
     }
-    
-    std::string word;
+
+    FileTokenizer parser( file );
     
     //Find the file type header
-    file >> word;
-    if(word != "GRT_ANBC_MODEL_FILE_V1.0"){
+    if( !parser.matchWord("GRT_ANBC_MODEL_FILE_V1.0") ){
         errorLog << "loadANBCModelFromFile(string filename) - Could not find Model File Header" << endl;
         return false;
     }
     
-    file >> word;
-    if(word != "NumFeatures:"){
+    if( !parser.matchWord("NumFeatures:") ){
         errorLog << "loadANBCModelFromFile(string filename) - Could not find NumFeatures " << endl;
         return false;
     }
-    file >> numFeatures;
+    parser >> numFeatures;
     
-    file >> word;
-    if(word != "NumClasses:"){
+    if( !parser.matchWord("NumClasses:") ){
         errorLog << "loadANBCModelFromFile(string filename) - Could not find NumClasses" << endl;
         return false;
     }
-    file >> numClasses;
+    parser >> numClasses;
     
-    file >> word;
-    if(word != "UseScaling:"){
+    if( !parser.matchWord("UseScaling:") ){
         errorLog << "loadANBCModelFromFile(string filename) - Could not find UseScaling" << endl;
         return false;
     }
-    file >> useScaling;
+    parser >> useScaling;
     
-    file >> word;
-    if(word != "UseNullRejection:"){
+    if( !parser.matchWord("UseNullRejection:") ){
         errorLog << "loadANBCModelFromFile(string filename) - Could not find UseNullRejection" << endl;
         return false;
     }
-    file >> useNullRejection;
+    parser >> useNullRejection;
     
     ///Read the ranges if needed
     if( useScaling ){
         //Resize the ranges buffer
         ranges.resize(numFeatures);
         
-        file >> word;
-        if(word != "Ranges:"){
+        if( !parser.matchWord("Ranges:") ){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find the Ranges" << endl;
             return false;
         }
         for(UINT n=0; n<ranges.size(); n++){
-            file >> ranges[n].minValue;
-            file >> ranges[n].maxValue;
+            parser >> ranges[n].minValue;
+            parser >> ranges[n].maxValue;
         }
     }
     
@@ -446,66 +467,58 @@ bool ANBC::loadModelFromFile(fstream &file){
     //Load each of the K models
     for(UINT k=0; k<numClasses; k++){
         UINT modelID;
-        file >> word;
-        if(word != "*************_MODEL_*************"){
+        if( !parser.matchWord("*************_MODEL_*************") ){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find header for the "<<k+1<<"th model" << endl;
             return false;
         }
         
-        file >> word;
-        if(word != "Model_ID:"){
+        if( !parser.matchWord("Model_ID:") ){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find model ID for the "<<k+1<<"th model" << endl;
             return false;
         }
-        file >> modelID;
+        parser >> modelID;
         
         if(modelID-1!=k){
             cout<<"ANBC: Model ID does not match the current class ID for the "<<k+1<<"th model" << endl;
             return false;
         }
         
-        file >> word;
-        if(word != "N:"){
+        if( !parser.matchWord("N:") ){
             cout<<"ANBC: Could not find N for the "<<k+1<<"th model" << endl;
             return false;
         }
-        file >> models[k].N;
+        parser >> models[k].N;
         
-        file >> word;
-        if(word != "ClassLabel:"){
+        if( !parser.matchWord("ClassLabel:") ){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find ClassLabel for the "<<k+1<<"th model" << endl;
             return false;
         }
-        file >> models[k].classLabel;
+        parser >> models[k].classLabel;
         classLabels[k] = models[k].classLabel;
         
-        file >> word;
-        if(word != "Threshold:"){
+        if( !parser.matchWord("Threshold:") ){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find the threshold for the "<<k+1<<"th model" << endl;
             return false;
         }
-        file >> models[k].threshold;
+        parser >> models[k].threshold;
         
-        file >> word;
-        if(word != "Gamma:"){
+        if( !parser.matchWord("Gamma:") ){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find the gamma parameter for the "<<k+1<<"th model" << endl;
             return false;
         }
-        file >> models[k].gamma;
+        parser >> models[k].gamma;
         
-        file >> word;
-        if(word != "TrainingMu:"){
+        if( !parser.matchWord("TrainingMu:") ){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find the training mu parameter for the "<<k+1<<"th model" << endl;
             return false;
         }
-        file >> models[k].trainingMu;
+        parser >> models[k].trainingMu;
         
-        file >> word;
-        if(word != "TrainingSigma:"){
+        if( !parser.matchWord("TrainingSigma:") ){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find the training sigma parameter for the "<<k+1<<"th model" << endl;
             return false;
         }
-        file >> models[k].trainingSigma;
+        parser >> models[k].trainingSigma;
         
         //Resize the buffers
         models[k].mu.resize(numFeatures);
@@ -513,8 +526,7 @@ bool ANBC::loadModelFromFile(fstream &file){
         models[k].weights.resize(numFeatures);
         
         //Load Mu, Sigma and Weights
-        file >> word;
-        if(word != "Mu:"){
+        if( !parser.matchWord("Mu:") ){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find the Mu vector for the "<<k+1<<"th model" << endl;
             return false;
         }
@@ -522,12 +534,11 @@ bool ANBC::loadModelFromFile(fstream &file){
         //Load Mu
         for(UINT j=0; j<models[k].N; j++){
             double value;
-            file >> value;
+            parser >> value;
             models[k].mu[j] = value;
         }
         
-        file >> word;
-        if(word != "Sigma:"){
+        if( !parser.matchWord("Sigma:") ){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find the Sigma vector for the "<<k+1<<"th model" << endl;
             return false;
         }
@@ -535,12 +546,11 @@ bool ANBC::loadModelFromFile(fstream &file){
         //Load Sigma
         for(UINT j=0; j<models[k].N; j++){
             double value;
-            file >> value;
+            parser >> value;
             models[k].sigma[j] = value;
         }
         
-        file >> word;
-        if(word != "Weights:"){
+        if( !parser.matchWord("Weights:") ){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find the Weights vector for the "<<k+1<<"th model" << endl;
             return false;
         }
@@ -548,12 +558,11 @@ bool ANBC::loadModelFromFile(fstream &file){
         //Load Weights
         for(UINT j=0; j<models[k].N; j++){
             double value;
-            file >> value;
+            parser >> value;
             models[k].weights[j] = value;
         }
         
-        file >> word;
-        if(word != "*********************************"){
+        if( !parser.matchWord("*********************************") ){
             errorLog << "loadANBCModelFromFile(string filename) - Could not find the model footer for the "<<k+1<<"th model" << endl;
             return false;
         }
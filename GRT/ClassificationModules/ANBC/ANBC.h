@@ -40,6 +40,7 @@
 
 #include "ANBC_Model.h"
 #include "../../GestureRecognitionPipeline/Classifier.h"
+#include "../../DataStructures/FlatClassificationData.h"
 
 namespace GRT{
     
@@ -89,6 +90,15 @@ public:
     */
     virtual bool train(LabelledClassificationData trainingData);
     
+    /**
+     This trains the ANBC model directly from a view of the labelled classification data.
+     The samples in the view are copied straight into a flat buffer, so the view is never expanded into a full copy of the dataset.
+     
+     @param const LabelledClassificationDataView &trainingData: a view of the training data
+     @return returns true if the ANBC model was trained, false otherwise
+    */
+    virtual bool train(const LabelledClassificationDataView &trainingData);
+    
     /**
      This predicts the class of the inputVector.
      This overrides the predict function in the Classifier base class.
@@ -97,6 +107,16 @@ public:
      @return returns true if the prediction was performed, false otherwise
     */
     virtual bool predict(VectorDouble inputVector);
+
+    /**
+     This predicts the class of the inputVector without changing the state of the classifier, so a trained model can be shared by many threads.
+     This overrides the predictStateless function in the Classifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassificationResult &result: returns the results of the prediction
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const;
     
     /**
      This saves the trained ANBC model to a file.
@@ -200,6 +220,9 @@ public:
     bool clearWeights(){ weightsDataSet = false; weightsData.clear(); return true; }
 
 private:
+    bool train_(const FlatClassificationData &data,const vector< MinMax > &dataRanges,double gamma);
+    bool predict_(VectorDouble &inputVector,UINT &predictedLabel,double &maximumLikelihood,VectorDouble &likelihoods,VectorDouble &distances) const;
+
     bool weightsDataSet;                  //A flag to indicate if the user has manually set the weights buffer
     LabelledClassificationData weightsData; //The weights of each feature for each class for training the algorithm
 	vector< ANBC_Model > models;            //A buffer to hold all the models
@@ -104,7 +104,7 @@ bool ANBC_Model::train(UINT classLabel,MatrixDouble &trainingData,VectorDouble &
 	return true;
 }
 
-double ANBC_Model::predict(const VectorDouble &x){
+double ANBC_Model::predict(const VectorDouble &x) const{
 	double prediction = 0.0;
 	for(UINT j=0; j<N; j++){
 		if(weights[j]>0)
@@ -113,7 +113,7 @@ double ANBC_Model::predict(const VectorDouble &x){
 	return prediction;
 }
 
-double ANBC_Model::predictUnnormed(const VectorDouble &x){
+double ANBC_Model::predictUnnormed(const VectorDouble &x) const{
 	double prediction = 0.0;
 	for(UINT j=0; j<N; j++){
 		if(weights[j]>0)
@@ -122,11 +122,11 @@ double ANBC_Model::predictUnnormed(const VectorDouble &x){
 	return prediction;
 }
 
-inline double ANBC_Model::gauss(const double x,const double mu,const double sigma){
+inline double ANBC_Model::gauss(const double x,const double mu,const double sigma) const{
 	return ( 1.0/(sigma*sqrt(TWO_PI)) ) * exp( - ( ((x-mu)*(x-mu))/(2*(sigma*sigma)) ) );
 }
 
-inline double ANBC_Model::unnormedGauss(const double x,const double mu,const double sigma){
+inline double ANBC_Model::unnormedGauss(const double x,const double mu,const double sigma) const{
 	return exp( - ( ((x-mu)*(x-mu))/(2*(sigma*sigma)) ) );
 }
 
@@ -31,10 +31,10 @@ public:
 	~ANBC_Model(void){};
 
 	bool train(UINT classLabel,MatrixDouble &trainingData,VectorDouble &weightsVector);
-	double predict(const VectorDouble &observation);
-	double predictUnnormed(const VectorDouble &x);
-	inline double gauss(const double x,const double mu,const double sigma);
-	inline double unnormedGauss(const double x,const double mu,const double sigma);
+	double predict(const VectorDouble &observation) const;
+	double predictUnnormed(const VectorDouble &x) const;
+	inline double gauss(const double x,const double mu,const double sigma) const;
+	inline double unnormedGauss(const double x,const double mu,const double sigma) const;
 	void recomputeThresholdValue(const double gamma);
 
 public:
@@ -98,6 +98,22 @@ bool AdaBoost::deepCopyFrom(const Classifier *classifier){
     
 bool AdaBoost::train(LabelledClassificationData trainingData){
     
+    //Copy the samples into one flat buffer, so the samples can be read without copying them
+    FlatClassificationData data( trainingData );
+    
+    return train_( data, trainingData.getRanges() );
+}
+    
+bool AdaBoost::train(const LabelledClassificationDataView &trainingData){
+    
+    //The samples in the view are copied straight into the flat buffer
+    FlatClassificationData data( trainingData );
+    
+    return train_( data, trainingData.getRanges() );
+}
+    
+bool AdaBoost::train_(const FlatClassificationData &trainingData,const vector< MinMax > &dataRanges){
+    
     trained = false;
     numFeatures = trainingData.getNumDimensions();
     numClasses = trainingData.getNumClasses();
@@ -111,7 +127,7 @@ bool AdaBoost::train(LabelledClassificationData trainingData){
     classLabels.resize(numClasses);
     models.clear();
     models.resize(numClasses);
-    ranges = trainingData.getRanges();
+    ranges = dataRanges;
     
     const UINT K = (UINT)weakClassifiers.size();
     if( K == 0 ){
@@ -137,8 +153,8 @@ bool AdaBoost::train(LabelledClassificationData trainingData){
         LabelledClassificationData classData;
         classData.setNumDimensions(trainingData.getNumDimensions());
         for(UINT i=0; i<M; i++){
-            UINT label = trainingData[i].getClassLabel()==classLabels[classIter] ? POSITIVE_LABEL : NEGATIVE_LABEL;
-            VectorDouble trainingSample = trainingData[i].getSample();
+            UINT label = trainingData.getClassLabel(i)==classLabels[classIter] ? POSITIVE_LABEL : NEGATIVE_LABEL;
+            VectorDouble trainingSample = trainingData.getSampleVector(i);
             
             if( useScaling ){
                 for(UINT n=0; n<numFeatures; n++){
@@ -454,75 +470,65 @@ bool AdaBoost::loadModelFromFile(fstream &file){
         errorLog << "loadModelFromFile(string filename) - Could not open file to load model" << endl;
         return false;
     }
+
+    FileTokenizer parser( file );
     
-    std::string word;
-    
-    file >> word;
-    if( word != "GRT_ADABOOST_MODEL_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_ADABOOST_MODEL_FILE_V1.0") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read file header!" << endl;
-        errorLog << word << endl;
 		return false;
     }
     
-    file >> word;
-    if( word != "NumFeatures:" ){
+    if( !parser.matchWord("NumFeatures:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read NumFeatures header!" << endl;
 		return false;
     }
-    file >> numFeatures;
+    parser >> numFeatures;
     
-    file >> word;
-    if( word != "NumClasses:" ){
+    if( !parser.matchWord("NumClasses:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read NumClasses header!" << endl;
 		return false;
     }
-    file >> numClasses;
+    parser >> numClasses;
     
-    file >> word;
-    if( word != "UseScaling:" ){
+    if( !parser.matchWord("UseScaling:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read UseScaling header!" << endl;
 		return false;
     }
-    file >> useScaling;
+    parser >> useScaling;
     
-    file >> word;
-    if( word != "UseNullRejection:" ){
+    if( !parser.matchWord("UseNullRejection:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read UseNullRejection header!" << endl;
 		return false;
     }
-    file >> useNullRejection;
+    parser >> useNullRejection;
     
     if( useScaling ){
-        file >> word;
-        if( word != "Ranges:" ){
+        if( !parser.matchWord("Ranges:") ){
             errorLog <<"loadModelFromFile(fstream &file) - Failed to read Ranges header!" << endl;
             return false;
         }
         ranges.resize( numFeatures );
         
         for(UINT n=0; n<ranges.size(); n++){
-            file >> ranges[n].minValue;
-            file >> ranges[n].maxValue;
+            parser >> ranges[n].minValue;
+            parser >> ranges[n].maxValue;
         }
     }
     
-    file >> word;
-    if( word != "Trained:" ){
+    if( !parser.matchWord("Trained:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read Trained header!" << endl;
 		return false;
     }
-    file >> trained;
+    parser >> trained;
     
-    file >> word;
-    if( word != "PredictionMethod:" ){
+    if( !parser.matchWord("PredictionMethod:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read PredictionMethod header!" << endl;
 		return false;
     }
-    file >> predictionMethod;
+    parser >> predictionMethod;
     
     if( trained ){
-        file >> word;
-        if( word != "Models:" ){
+        if( !parser.matchWord("Models:") ){
             errorLog <<"loadModelFromFile(fstream &file) - Failed to read Models header!" << endl;
             return false;
         }
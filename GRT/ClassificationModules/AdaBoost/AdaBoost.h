@@ -45,6 +45,7 @@
 #define GRT_ADABOOST_HEADER
 
 #include "../../GestureRecognitionPipeline/Classifier.h"
+#include "../../DataStructures/FlatClassificationData.h"
 #include "AdaBoostClassModel.h"
 #include "WeakClassifiers/DecisionStump.h"
 #include "WeakClassifiers/RadialBasisFunction.h"
@@ -98,6 +99,16 @@ public:
      */
     virtual bool train(LabelledClassificationData trainingData);
     
+    /**
+     This trains the AdaBoost model directly from a view of the labelled classification data.
+     The samples in the view are copied straight into a flat buffer, so the view is never expanded into a full copy of the dataset.
+     The weak classifiers are still trained on the relabelled copy of the data that is built for each class.
+     
+     @param const LabelledClassificationDataView &trainingData: a view of the training data
+     @return returns true if the AdaBoost model was trained, false otherwise
+     */
+    virtual bool train(const LabelledClassificationDataView &trainingData);
+    
     /**
      This predicts the class of the inputVector.
      This overrides the predict function in the Classifier base class.
@@ -217,6 +228,8 @@ public:
     vector< AdaBoostClassModel > getModels(){ return models; }
     
 protected:
+    bool train_(const FlatClassificationData &trainingData,const vector< MinMax > &dataRanges);
+    
     UINT numBoostingIterations;
     UINT predictionMethod;
     vector< WeakClassifier* > weakClassifiers;
@@ -202,26 +202,25 @@ public:
             errorLog <<"loadModelFromFile(fstream &file) - The file is not open!" << endl;
             return false;
         }
+
+        FileTokenizer parser( file );
         
         string word;
         UINT numWeakClassifiers = 0;
         
-        file >> word;
-        if( word != "ClassLabel:" ){
+        if( !parser.matchWord("ClassLabel:") ){
             errorLog <<"loadModelFromFile(fstream &file) - Failed to read ClassLabel header!" << endl;
             return false;
         }
-        file >> classLabel;
+        parser >> classLabel;
 
-        file >> word;
-        if( word != "NumWeakClassifiers:" ){
+        if( !parser.matchWord("NumWeakClassifiers:") ){
             errorLog <<"loadModelFromFile(fstream &file) - Failed to read NumWeakClassifiers header!" << endl;
             return false;
         }
-        file >> numWeakClassifiers;
+        parser >> numWeakClassifiers;
         
-        file >> word;
-        if( word != "WeakClassifierTypes:" ){
+        if( !parser.matchWord("WeakClassifierTypes:") ){
             errorLog <<"loadModelFromFile(fstream &file) - Failed to read WeakClassifierTypes header!" << endl;
             return false;
         }
@@ -232,7 +231,7 @@ public:
             weakClassifiers.resize( numWeakClassifiers, NULL );
             
             for(UINT i=0; i<numWeakClassifiers; i++){
-                file >> word;
+                parser >> word;
                 weakClassifiers[i] = WeakClassifier::createInstanceFromString(word);
                 if( weakClassifiers[i] == NULL ){
                     errorLog <<"loadModelFromFile(fstream &file) - WeakClassifier " << i << " is NULL!" << endl;
@@ -242,20 +241,17 @@ public:
         }
         
         //Load the Weights
-        file >> word;
-        if( word != "Weights:" ){
+        if( !parser.matchWord("Weights:") ){
             errorLog <<"loadModelFromFile(fstream &file) - Failed to read Weights header!" << endl;
             return false;
         }
         for(UINT i=0; i<numWeakClassifiers; i++){
-            file >> weights[i];
+            parser >> weights[i];
         }
         
         //Load the WeakClassifiers
-        file >> word;
-        if( word != "WeakClassifiers:" ){
+        if( !parser.matchWord("WeakClassifiers:") ){
             errorLog <<"loadModelFromFile(fstream &file) - Failed to read WeakClassifiers header!" << endl;
-            errorLog << word << endl;
             return false;
         }
         for(UINT i=0; i<numWeakClassifiers; i++){
@@ -102,7 +102,19 @@ bool DecisionStump::train(LabelledClassificationData &trainingData, VectorDouble
     double threshold = 0;
     double bestThreshold = 0;
     
+    //The threshold search scans every sample once per threshold, so the labels and the values of the current feature
+    //are copied into flat buffers first rather than reading them from each sample on every scan
+    vector< char > positiveClass(M);
+    VectorDouble featureValues(M);
+    for(UINT i=0; i<M; i++){
+        positiveClass[i] = trainingData[ i ].getClassLabel() == WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL;
+    }
+    
     for(UINT n=0; n<numInputDimensions; n++){
+        for(UINT i=0; i<M; i++){
+            featureValues[i] = trainingData[ i ][ n ];
+        }
+        
         minRange = ranges[n].minValue;
         maxRange = ranges[n].maxValue;
         step = (maxRange-minRange)/double(numSteps);
@@ -114,11 +126,10 @@ bool DecisionStump::train(LabelledClassificationData &trainingData, VectorDouble
             double rhsError = 0;
             double lhsError = 0;
             for(UINT i=0; i<M; i++){
-                bool positiveClass = trainingData[ i ].getClassLabel() == WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL;
-                bool rhs = trainingData[ i ][ n ] >= threshold;
-                bool lhs = trainingData[ i ][ n ] <= threshold;
-                if( (rhs && !positiveClass) || (!rhs && positiveClass) ) rhsError += weights[ i ];
-                if( (lhs && !positiveClass) || (!lhs && positiveClass) ) lhsError += weights[ i ];
+                const bool rhs = featureValues[i] >= threshold;
+                const bool lhs = featureValues[i] <= threshold;
+                if( rhs != (bool)positiveClass[i] ) rhsError += weights[ i ];
+                if( lhs != (bool)positiveClass[i] ) lhsError += weights[ i ];
             }
             
             //Check to see if either the rhsError or lhsError beats the minError, if so then store the results
@@ -185,62 +196,57 @@ bool DecisionStump::loadModelFromFile(fstream &file){
 		errorLog <<"loadModelFromFile(fstream &file) - The file is not open!" << endl;
 		return false;
 	}
+
+    FileTokenizer parser( file );
     
     string word;
     
-    file >> word;
-    if( word != "WeakClassifierType:" ){
+    if( !parser.matchWord("WeakClassifierType:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read WeakClassifierType header!" << endl;
 		return false;
     }
-    file >> word;
+    parser >> word;
     
     if( word != weakClassifierType ){
         errorLog <<"loadModelFromFile(fstream &file) - The weakClassifierType:" << word << " does not match: " << weakClassifierType << endl;
 		return false;
     }
     
-    file >> word;
-    if( word != "Trained:" ){
+    if( !parser.matchWord("Trained:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read Trained header!" << endl;
 		return false;
     }
-    file >> trained;
+    parser >> trained;
     
-    file >> word;
-    if( word != "NumInputDimensions:" ){
+    if( !parser.matchWord("NumInputDimensions:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
 		return false;
     }
-    file >> numInputDimensions;
+    parser >> numInputDimensions;
     
-    file >> word;
-    if( word != "DecisionFeatureIndex:" ){
+    if( !parser.matchWord("DecisionFeatureIndex:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read DecisionFeatureIndex header!" << endl;
 		return false;
     }
-    file >> decisionFeatureIndex;
+    parser >> decisionFeatureIndex;
     
-    file >> word;
-    if( word != "Direction:" ){
+    if( !parser.matchWord("Direction:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read Direction header!" << endl;
 		return false;
     }
-    file >> direction;
+    parser >> direction;
     
-    file >> word;
-    if( word != "NumSteps:" ){
+    if( !parser.matchWord("NumSteps:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read NumSteps header!" << endl;
 		return false;
     }
-    file >> numSteps;
+    parser >> numSteps;
     
-    file >> word;
-    if( word != "DecisionValue:" ){
+    if( !parser.matchWord("DecisionValue:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read DecisionValue header!" << endl;
 		return false;
     }
-    file >> decisionValue;
+    parser >> decisionValue;
     
     //We don't need to close the file as the function that called this function should handle that
     return true;
@@ -234,80 +234,73 @@ bool RadialBasisFunction::loadModelFromFile(fstream &file){
 		errorLog <<"loadModelFromFile(fstream &file) - The file is not open!" << endl;
 		return false;
 	}
+
+    FileTokenizer parser( file );
     
     string word;
     
-    file >> word;
-    if( word != "WeakClassifierType:" ){
+    if( !parser.matchWord("WeakClassifierType:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read WeakClassifierType header!" << endl;
 		return false;
     }
-    file >> word;
+    parser >> word;
     
     if( word != weakClassifierType ){
         errorLog <<"loadModelFromFile(fstream &file) - The weakClassifierType:" << word << " does not match: " << weakClassifierType << endl;
 		return false;
     }
     
-    file >> word;
-    if( word != "Trained:" ){
+    if( !parser.matchWord("Trained:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read Trained header!" << endl;
 		return false;
     }
-    file >> trained;
+    parser >> trained;
     
-    file >> word;
-    if( word != "NumInputDimensions:" ){
+    if( !parser.matchWord("NumInputDimensions:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
 		return false;
     }
-    file >> numInputDimensions;
+    parser >> numInputDimensions;
     
     
-    file >> word;
-    if( word != "NumSteps:" ){
+    if( !parser.matchWord("NumSteps:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read NumSteps header!" << endl;
 		return false;
     }
-    file >> numSteps;
+    parser >> numSteps;
     
-    file >> word;
-    if( word != "PositiveClassificationThreshold:" ){
+    if( !parser.matchWord("PositiveClassificationThreshold:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read PositiveClassificationThreshold header!" << endl;
 		return false;
     }
-    file >> positiveClassificationThreshold;
+    parser >> positiveClassificationThreshold;
     
-    file >> word;
-    if( word != "Alpha:" ){
+    if( !parser.matchWord("Alpha:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read Alpha header!" << endl;
 		return false;
     }
-    file >> alpha;
+    parser >> alpha;
     
-    file >> word;
-    if( word != "MinAlphaSearchRange:" ){
+    if( !parser.matchWord("MinAlphaSearchRange:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read MinAlphaSearchRange header!" << endl;
 		return false;
     }
-    file >> minAlphaSearchRange;
+    parser >> minAlphaSearchRange;
     
-    file >> word;
-    if( word != "MaxAlphaSearchRange:" ){
+    if( !parser.matchWord("MaxAlphaSearchRange:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read MaxAlphaSearchRange header!" << endl;
 		return false;
     }
-    file >> maxAlphaSearchRange;
+    parser >> maxAlphaSearchRange;
     
-    file >> word;
-    if( word != "RBF:" ){
+    if( !parser.matchWord("RBF:") ){
         errorLog <<"loadModelFromFile(fstream &file) - Failed to read RBF header!" << endl;
 		return false;
     }
     rbfCentre.resize(numInputDimensions);
     
     for(UINT i=0; i<numInputDimensions; i++){
-        file >> rbfCentre[i];
+        parser >> rbfCentre[i];
     }
     
     //Compute gamma using alpha
@@ -30,7 +30,11 @@
 namespace GRT{
     
 WeakClassifier::StringWeakClassifierMap* WeakClassifier::stringWeakClassifierMap = NULL;
+#ifdef GRT_CXX11_ENABLED
+std::atomic< UINT > WeakClassifier::numWeakClassifierInstances(0);
+#else
 UINT WeakClassifier::numWeakClassifierInstances = 0;
+#endif
 
 WeakClassifier* WeakClassifier::createInstanceFromString(string const &weakClassifierType){
     
@@ -31,6 +31,10 @@
 #include "../../../Util/GRTCommon.h"
 #include "../../../DataStructures/LabelledClassificationData.h"
 
+#ifdef GRT_CXX11_ENABLED
+#include <atomic>
+#endif
+
 namespace GRT{
     
 #define WEAK_CLASSIFIER_POSITIVE_CLASS_LABEL 1
@@ -133,7 +137,11 @@ protected:
     
 private:
     static StringWeakClassifierMap *stringWeakClassifierMap;
+#ifdef GRT_CXX11_ENABLED
+    static std::atomic< UINT > numWeakClassifierInstances;    //Atomic, as AdaBoost creates and deletes weak classifiers in the cross validation threads
+#else
     static UINT numWeakClassifierInstances;
+#endif
 };
     
 //These two functions/classes are used to register any new WeakClassification Module with the WeakClassifier base class
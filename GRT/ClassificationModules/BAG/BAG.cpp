@@ -117,7 +117,8 @@ bool BAG::train(LabelledClassificationData trainingData){
 
     //Train the ensemble
     for(UINT i=0; i<ensembleSize; i++){
-        LabelledClassificationData boostedDataset = trainingData.getBootstrappedDataset();
+        //The bootstrapped dataset is a weighted view of the training data, so only the classifier that is being trained copies the samples
+        LabelledClassificationDataView boostedDataset = trainingData.getBootstrappedDatasetView();
         
         //Train the classifier with the bootstrapped dataset
         if( !ensemble[i]->train( boostedDataset ) ){
@@ -314,64 +315,57 @@ bool BAG::loadModelFromFile(fstream &file){
         errorLog << "loadModelFromFile(string filename) - Could not open file to load model" << endl;
         return false;
     }
-    
-    std::string word;
+
+    FileTokenizer parser( file );
     
     //Find the file type header
-    file >> word;
-    if(word != "GRT_BAG_MODEL_FILE_V1.0"){
+    if( !parser.matchWord("GRT_BAG_MODEL_FILE_V1.0") ){
         errorLog << "loadModelFromFile(string filename) - Could not find Model File Header" << endl;
         return false;
     }
     
-    file >> word;
-    if(word != "Trained:"){
+    if( !parser.matchWord("Trained:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find Trained Header" << endl;
         return false;
     }
-    file >> trained;
+    parser >> trained;
     
-    file >> word;
-    if(word != "NumFeatures:"){
+    if( !parser.matchWord("NumFeatures:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find NumFeatures!" << endl;
         return false;
     }
-    file >> numFeatures;
+    parser >> numFeatures;
     
-    file >> word;
-    if(word != "NumClasses:"){
+    if( !parser.matchWord("NumClasses:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find NumClasses!" << endl;
         return false;
     }
-    file >> numClasses;
+    parser >> numClasses;
     
-    file >> word;
-    if(word != "UseScaling:"){
+    if( !parser.matchWord("UseScaling:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find UseScaling!" << endl;
         return false;
     }
-    file >> useScaling;
+    parser >> useScaling;
     
-    file >> word;
-    if(word != "UseNullRejection:"){
+    if( !parser.matchWord("UseNullRejection:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find UseNullRejection!" << endl;
         return false;
     }
-    file >> useNullRejection;
+    parser >> useNullRejection;
     
     ///Read the ranges if needed
     if( useScaling ){
         //Resize the ranges buffer
         ranges.resize(numFeatures);
         
-        file >> word;
-        if(word != "Ranges:"){
+        if( !parser.matchWord("Ranges:") ){
             errorLog << "loadModelFromFile(string filename) - Could not find the Ranges!" << endl;
             return false;
         }
         for(UINT n=0; n<ranges.size(); n++){
-            file >> ranges[n].minValue;
-            file >> ranges[n].maxValue;
+            parser >> ranges[n].minValue;
+            parser >> ranges[n].maxValue;
         }
     }
     
@@ -379,52 +373,47 @@ bool BAG::loadModelFromFile(fstream &file){
     classLabels.resize(numClasses);
     
     //Load the class labels
-    file >> word;
-    if(word != "ClassLabels:"){
+    if( !parser.matchWord("ClassLabels:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find the ClassLabels!" << endl;
         return false;
     }
     for(UINT i=0; i<numClasses; i++){
-        file >> classLabels[i];
+        parser >> classLabels[i];
     }
     
     //Load the ensemble size
-    file >> word;
-    if(word != "EnsembleSize:"){
+    if( !parser.matchWord("EnsembleSize:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find the EnsembleSize!" << endl;
         return false;
     }
-    file >> ensembleSize;
+    parser >> ensembleSize;
     
     if( ensembleSize > 0 ){
         
         //Load the weights
         weights.resize( ensembleSize );
         
-        file >> word;
-        if(word != "Weights:"){
+        if( !parser.matchWord("Weights:") ){
             errorLog << "loadModelFromFile(string filename) - Could not find the Weights!" << endl;
             return false;
         }
         for(UINT i=0; i<ensembleSize; i++){
-            file >> weights[i];
+            parser >> weights[i];
         }
         
         //Load the classifier types
         vector< string > classifierTypes( ensembleSize );
         
-        file >> word;
-        if(word != "ClassifierTypes:"){
+        if( !parser.matchWord("ClassifierTypes:") ){
             errorLog << "loadModelFromFile(string filename) - Could not find the ClassifierTypes!" << endl;
             return false;
         }
         for(UINT i=0; i<ensembleSize; i++){
-            file >> classifierTypes[i];
+            parser >> classifierTypes[i];
         }
         
         //Load the ensemble
-        file >> word;
-        if(word != "Ensemble:"){
+        if( !parser.matchWord("Ensemble:") ){
             errorLog << "loadModelFromFile(string filename) - Could not find the Ensemble!" << endl;
             return false;
         }
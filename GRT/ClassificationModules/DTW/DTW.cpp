@@ -253,7 +253,7 @@ bool DTW::train(LabelledTimeSeriesClassificationData labelledTrainingData){
 
     //Resize the prediction results to make sure it is setup for realtime prediction
     continuousInputDataBuffer.clear();
-    continuousInputDataBuffer.resize(averageTemplateLength,vector<double>(numFeatures,0));
+    continuousInputDataBuffer.resize(averageTemplateLength,numFeatures,0);
     classLikelihoods.resize(numTemplates,DEFAULT_NULL_LIKELIHOOD_VALUE);
     classDistances.resize(numTemplates,0);
     predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
@@ -497,7 +497,7 @@ bool DTW::predict(VectorDouble inputVector){
 bool DTW::reset(){
     continuousInputDataBuffer.clear();
     if( trained ){
-        continuousInputDataBuffer.resize(averageTemplateLength,vector<double>(numFeatures,0));
+        continuousInputDataBuffer.resize(averageTemplateLength,numFeatures,0);
         recomputeNullRejectionThresholds();
     }
     return true;
@@ -531,61 +531,87 @@ bool DTW::setModels( vector< DTWTemplate > newTemplates ){
 	return false;
 }
 
-////////////////////////// computeDistance ///////////////////////////////////////////
+////////////////////////// computeDistanceMatrix ///////////////////////////////////////////
 
-double DTW::computeDistance(MatrixDouble &timeSeriesA,MatrixDouble &timeSeriesB,MatrixDouble &distanceMatrix,vector< IndexDist > &warpPath){
+template< UINT D >
+bool DTW::computeDistanceMatrix(MatrixDouble &timeSeriesA,MatrixDouble &timeSeriesB,MatrixDouble &distanceMatrix){
 
-	const int M = timeSeriesA.getNumRows();
-	const int N = timeSeriesB.getNumRows();
-	const int C = timeSeriesA.getNumCols();
-	int i,j,k,index = 0;
-	double totalDist,v,normFactor = 0.;
-    
-    warpPath.clear();
-    if( int(distanceMatrix.getNumRows()) != M || int(distanceMatrix.getNumCols()) != N ){
-        distanceMatrix.resize(M, N);
-    }
+	const UINT M = timeSeriesA.getNumRows();
+	const UINT N = timeSeriesB.getNumRows();
+	const UINT C = timeSeriesA.getNumCols();
+	UINT i,j;
 
 	switch (distanceMethod) {
 		case (ABSOLUTE_DIST):
 			for(i=0; i<M; i++){
+				const double *a = timeSeriesA[i];
+				double *dist = distanceMatrix[i];
 				for(j=0; j<N; j++){
-					distanceMatrix[i][j] = 0.0;
-					for(k=0; k< C; k++){
-					   distanceMatrix[i][j] += fabs(timeSeriesA[i][k]-timeSeriesB[j][k]);
-					}
+					dist[j] = Dims< D >::manhattan( a, timeSeriesB[j], C );
 				}
 			}
 			break;
 		case (EUCLIDEAN_DIST):
 			//Calculate Euclidean Distance for all possible values
 			for(i=0; i<M; i++){
+				const double *a = timeSeriesA[i];
+				double *dist = distanceMatrix[i];
 				for(j=0; j<N; j++){
-					distanceMatrix[i][j] = 0.0;
-					for(k=0; k< C; k++){
-						distanceMatrix[i][j] += SQR( timeSeriesA[i][k]-timeSeriesB[j][k] );
-					}
-					distanceMatrix[i][j] = sqrt( distanceMatrix[i][j] );
+					dist[j] = Dims< D >::euclidean( a, timeSeriesB[j], C );
 				}
 			}
 			break;
 		case (NORM_ABSOLUTE_DIST):
 			for(i=0; i<M; i++){
+				const double *a = timeSeriesA[i];
+				double *dist = distanceMatrix[i];
 				for(j=0; j<N; j++){
-					distanceMatrix[i][j] = 0.0;
-					for(k=0; k< C; k++){
-					   distanceMatrix[i][j] += fabs(timeSeriesA[i][k]-timeSeriesB[j][k]);
-					}
-					distanceMatrix[i][j]/=N;
+					dist[j] = Dims< D >::manhattan( a, timeSeriesB[j], C ) / N;
 				}
 			}
 			break;
 		default:
 			errorLog<<"ERROR: Unknown distance method: "<<distanceMethod<<endl;
-			return -1;
+			return false;
 			break;
 	}
 
+	return true;
+}
+
+////////////////////////// computeDistance ///////////////////////////////////////////
+
+double DTW::computeDistance(MatrixDouble &timeSeriesA,MatrixDouble &timeSeriesB,MatrixDouble &distanceMatrix,vector< IndexDist > &warpPath){
+
+	const int M = timeSeriesA.getNumRows();
+	const int N = timeSeriesB.getNumRows();
+	const int C = timeSeriesA.getNumCols();
+	int i,j,index = 0;
+	double totalDist,v,normFactor = 0.;
+    
+    warpPath.clear();
+    if( int(distanceMatrix.getNumRows()) != M || int(distanceMatrix.getNumCols()) != N ){
+        distanceMatrix.resize(M, N);
+    }
+
+    //Compute the distance between each pair of points, using the fixed dimension kernels when they match the data
+    bool distancesComputed = false;
+    switch( C ){
+        case 1:
+            distancesComputed = computeDistanceMatrix< 1 >(timeSeriesA,timeSeriesB,distanceMatrix);
+            break;
+        case 2:
+            distancesComputed = computeDistanceMatrix< 2 >(timeSeriesA,timeSeriesB,distanceMatrix);
+            break;
+        case 3:
+            distancesComputed = computeDistanceMatrix< 3 >(timeSeriesA,timeSeriesB,distanceMatrix);
+            break;
+        default:
+            distancesComputed = computeDistanceMatrix< 0 >(timeSeriesA,timeSeriesB,distanceMatrix);
+            break;
+    }
+    if( !distancesComputed ) return -1;
+
     //Run the recursive search function to build the cost matrix
     double distance = sqrt( d(M-1,N-1,distanceMatrix,M,N) );
 
@@ -1009,133 +1035,119 @@ bool DTW::loadModelFromFile( fstream &file ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to open file!" << endl;
         return false;
     }
+
+    FileTokenizer parser( file );
     
     //Check to make sure this is a file with the DTW File Format
-    file >> word;
-    if(word != "GRT_DTW_Model_File_V1.0"){
+    if( !parser.matchWord("GRT_DTW_Model_File_V1.0") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Unknown file header!" << endl;
         return false;
     }
     
     //Check and load the Number of Dimensions
-    file >> word;
-    if(word != "NumberOfDimensions:"){
+    if( !parser.matchWord("NumberOfDimensions:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find NumberOfDimensions!" << endl;
         return false;
     }
-    file >> numFeatures;
+    parser >> numFeatures;
     
     //Check and load the Number of Classes
-    file >> word;
-    if(word != "NumberOfClasses:"){
+    if( !parser.matchWord("NumberOfClasses:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find NumberOfClasses!" << endl;
         return false;
     }
-    file >> numClasses;
+    parser >> numClasses;
     
     //Check and load the Number of Templates
-    file >> word;
-    if(word != "NumberOfTemplates:"){
+    if( !parser.matchWord("NumberOfTemplates:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find NumberOfTemplates!" << endl;
         return false;
     }
-    file >> numTemplates;
+    parser >> numTemplates;
     
     //Check and load the Distance Method
-    file >> word;
-    if(word != "DistanceMethod:"){
+    if( !parser.matchWord("DistanceMethod:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find DistanceMethod!" << endl;
         return false;
     }
-    file >> distanceMethod;
+    parser >> distanceMethod;
     
     //Check and load if UseNullRejection is used
-    file >> word;
-    if(word != "UseNullRejection:"){
+    if( !parser.matchWord("UseNullRejection:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find UseNullRejection!" << endl;
         return false;
     }
-    file >> useNullRejection;
+    parser >> useNullRejection;
     
     //Check and load if Smoothing is used
-    file >> word;
-    if(word != "UseSmoothing:"){
+    if( !parser.matchWord("UseSmoothing:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find UseSmoothing!" << endl;
         return false;
     }
-    file >> useSmoothing;
+    parser >> useSmoothing;
     
     //Check and load what the smoothing factor is
-    file >> word;
-    if(word != "SmoothingFactor:"){
+    if( !parser.matchWord("SmoothingFactor:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find SmoothingFactor!" << endl;
         return false;
     }
-    file >> smoothingFactor;
+    parser >> smoothingFactor;
     
     //Check and load if Scaling is used
-    file >> word;
-    if(word != "UseScaling:"){
+    if( !parser.matchWord("UseScaling:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find UseScaling!" << endl;
         return false;
     }
-    file >> useScaling;
+    parser >> useScaling;
     
     //Check and load if ZNormalization is used
-    file >> word;
-    if(word != "UseZNormalisation:"){
+    if( !parser.matchWord("UseZNormalisation:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find UseZNormalisation!" << endl;
         return false;
     }
-    file >> useZNormalisation;
+    parser >> useZNormalisation;
     
     //Check and load if OffsetUsingFirstSample is used
-    file >> word;
-    if(word != "OffsetUsingFirstSample:"){
+    if( !parser.matchWord("OffsetUsingFirstSample:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find OffsetUsingFirstSample!" << endl;
         return false;
     }
-    file >> offsetUsingFirstSample;
+    parser >> offsetUsingFirstSample;
     
     //Check and load if ConstrainWarpingPath is used
-    file >> word;
-    if(word != "ConstrainWarpingPath:"){
+    if( !parser.matchWord("ConstrainWarpingPath:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find ConstrainWarpingPath!" << endl;
         return false;
     }
-    file >> constrainWarpingPath;
+    parser >> constrainWarpingPath;
     
     //Check and load if ZNormalization is used
-    file >> word;
-    if(word != "Radius:"){
+    if( !parser.matchWord("Radius:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find Radius!" << endl;
         return false;
     }
-    file >> radius;
+    parser >> radius;
     
     //Check and load if Scaling is used
-    file >> word;
-    if(word != "RejectionMode:"){
+    if( !parser.matchWord("RejectionMode:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find RejectionMode!" << endl;
         return false;
     }
-    file >> rejectionMode;
+    parser >> rejectionMode;
     
     //Check and load gamma
-    file >> word;
-    if(word != "NullRejectionCoeff:"){
+    if( !parser.matchWord("NullRejectionCoeff:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find NullRejectionCoeff!" << endl;
         return false;
     }
-    file >> nullRejectionCoeff;
+    parser >> nullRejectionCoeff;
     
     //Check and load the overall average template length
-    file >> word;
-    if(word != "OverallAverageTemplateLength:"){
+    if( !parser.matchWord("OverallAverageTemplateLength:") ){
         errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find OverallAverageTemplateLength!" << endl;
         return false;
     }
-    file >> averageTemplateLength;
+    parser >> averageTemplateLength;
     
     //Clean and reset the memory
     templatesBuffer.resize(numTemplates);
@@ -1145,11 +1157,11 @@ bool DTW::loadModelFromFile( fstream &file ){
     //Load each template
     for(UINT i=0; i<numTemplates; i++){
         //Check we have the correct template
-        file >> word;
+        parser >> word;
         while(word != "Template:"){
-            file >> word;
+            parser >> word;
         }
-        file >> ts;
+        parser >> ts;
         
         //Check the template number
         if(ts!=i+1){
@@ -1160,72 +1172,65 @@ bool DTW::loadModelFromFile( fstream &file ){
         }
         
         //Get the class label of this template
-        file >> word;
-        if(word != "ClassLabel:"){
+        if( !parser.matchWord("ClassLabel:") ){
             numTemplates=0;
             trained = false;
             errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find ClassLabel!" << endl;
             return false;
         }
-        file >> templatesBuffer[i].classLabel;
+        parser >> templatesBuffer[i].classLabel;
         classLabels[i] = templatesBuffer[i].classLabel;
         
         //Get the time series length
-        file >> word;
-        if(word != "TimeSeriesLength:"){
+        if( !parser.matchWord("TimeSeriesLength:") ){
             numTemplates=0;
             trained = false;
             errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find TimeSeriesLength!" << endl;
             return false;
         }
-        file >> timeSeriesLength;
+        parser >> timeSeriesLength;
         
         //Resize the buffers
         templatesBuffer[i].timeSeries.resize(timeSeriesLength,numFeatures);
         
         //Get the template threshold
-        file >> word;
-        if(word != "TemplateThreshold:"){
+        if( !parser.matchWord("TemplateThreshold:") ){
             numTemplates=0;
             trained = false;
             errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find TemplateThreshold!" << endl;
             return false;
         }
-        file >> nullRejectionThresholds[i];
+        parser >> nullRejectionThresholds[i];
         
         //Get the mu values
-        file >> word;
-        if(word != "TrainingMu:"){
+        if( !parser.matchWord("TrainingMu:") ){
             numTemplates=0;
             trained = false;
             errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find TrainingMu!" << endl;
             return false;
         }
-        file >> templatesBuffer[i].trainingMu;
+        parser >> templatesBuffer[i].trainingMu;
         
         //Get the sigma values
-        file >> word;
-        if(word != "TrainingSigma:"){
+        if( !parser.matchWord("TrainingSigma:") ){
             numTemplates=0;
             trained = false;
             errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find TrainingSigma!" << endl;
             return false;
         }
-        file >> templatesBuffer[i].trainingSigma;
+        parser >> templatesBuffer[i].trainingSigma;
         
         //Get the AverageTemplateLength value
-        file >> word;
-        if(word != "AverageTemplateLength:"){
+        if( !parser.matchWord("AverageTemplateLength:") ){
             numTemplates=0;
             trained = false;
             errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find AverageTemplateLength!" << endl;
             return false;
         }
-        file >> templatesBuffer[i].averageTemplateLength;
+        parser >> templatesBuffer[i].averageTemplateLength;
         
         //Get the data
-        file >> word;
-        if(word != "TimeSeries:"){
+        if( !parser.matchWord("TimeSeries:") ){
             numTemplates=0;
             trained = false;
             errorLog << "loadDTWModelFromFile( string fileName ) - Failed to find template timeseries!" << endl;
@@ -1233,11 +1238,10 @@ bool DTW::loadModelFromFile( fstream &file ){
         }
         for(UINT k=0; k<timeSeriesLength; k++)
             for(UINT j=0; j<numFeatures; j++)
-                file >> templatesBuffer[i].timeSeries[k][j];
+                parser >> templatesBuffer[i].timeSeries[k][j];
         
         //Check for the footer
-        file >> word;
-        if(word != "***************************"){
+        if( !parser.matchWord("***************************") ){
             numTemplates=0;
             numClasses = 0;
             numFeatures=0;
@@ -1249,7 +1253,7 @@ bool DTW::loadModelFromFile( fstream &file ){
     
     //Resize the prediction results to make sure it is setup for realtime prediction
     continuousInputDataBuffer.clear();
-    continuousInputDataBuffer.resize(averageTemplateLength,vector<double>(numFeatures,0));
+    continuousInputDataBuffer.resize(averageTemplateLength,numFeatures,0);
     maxLikelihood = DEFAULT_NULL_LIKELIHOOD_VALUE;
     bestDistance = DEFAULT_NULL_DISTANCE_VALUE;
     classLikelihoods.resize(numClasses,DEFAULT_NULL_LIKELIHOOD_VALUE);
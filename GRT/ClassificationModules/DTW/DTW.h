@@ -131,6 +131,9 @@ public:
      */
 	virtual bool deepCopyFrom(const Classifier *classifier);
     
+    //Keeps the train overloads this class does not override (such as training from a view) visible
+    using MLBase::train;
+    
     /**
      This trains the DTW model, using the labelled timeseries classification data.
      This overrides the train function in the Classifier base class.
@@ -327,6 +330,7 @@ private:
 
 	//The actual DTW function
 	double computeDistance(MatrixDouble &timeSeriesA,MatrixDouble &timeSeriesB,MatrixDouble &distanceMatrix,vector< IndexDist > &warpPath);
+	template< UINT D > bool computeDistanceMatrix(MatrixDouble &timeSeriesA,MatrixDouble &timeSeriesB,MatrixDouble &distanceMatrix);
     double d(int m,int n,MatrixDouble &distanceMatrix,const int M,const int N);
 	double inline MIN_(double a,double b, double c);
 
@@ -346,7 +350,7 @@ public:
     vector< MatrixDouble > distanceMatrices;
     vector< vector< IndexDist > > warpPaths;
 	vector< MinMax >	rangesBuffer;			//A buffer to store the min-max ranges for scaling each channel
-    CircularBuffer< VectorDouble > continuousInputDataBuffer;
+    FrameBuffer continuousInputDataBuffer;
 	UINT				numTemplates;			//The number of templates in our buffer
     UINT                rejectionMode;          //The rejection mode used to reject null gestures during the prediction phase
 
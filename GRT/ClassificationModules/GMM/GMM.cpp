@@ -26,6 +26,7 @@ namespace GRT {
 RegisterClassifierModule< GMM > GMM::registerModule("GMM");
     
 GMM::GMM(UINT numMixtureModels,bool useScaling,bool useNullRejection,double nullRejectionCoeff,UINT maxIter,double minChange){
+    statelessPrediction = true;
     classifierType = "GMM";
     classifierMode = STANDARD_CLASSIFIER_MODE;
     debugLog.setProceedingText("[DEBUG GMM]");
@@ -85,11 +86,35 @@ bool GMM::deepCopyFrom(const Classifier *classifier){
 
 bool GMM::predict(VectorDouble x){
 
-	predictedClassLabel = 0;
+    if( !predict_( x, predictedClassLabel, maxLikelihood, classLikelihoods, classDistances ) ){
+        return false;
+    }
+
+    //The best distance is the largest unnormalized mixture likelihood
+    bestDistance = 0;
+    for(UINT k=0; k<classDistances.size(); k++){
+        if( classDistances[k] > bestDistance ) bestDistance = classDistances[k];
+    }
+
+    return true;
+}
+
+bool GMM::predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const{
+    VectorDouble x = inputVector;
+    if( !predict_( x, result.predictedClassLabel, result.maximumLikelihood, result.classLikelihoods, result.classDistances ) ){
+        return false;
+    }
+    result.unprocessedPredictedClassLabel = result.predictedClassLabel;
+    return true;
+}
+
+bool GMM::predict_(VectorDouble &x,UINT &predictedLabel,double &maximumLikelihood,VectorDouble &likelihoods,VectorDouble &distances) const{
+
+	predictedLabel = 0;
 	
-    if( classDistances.size() != numClasses || classLikelihoods.size() != numClasses ){
-        classDistances.resize(numClasses);
-        classLikelihoods.resize(numClasses);
+    if( distances.size() != numClasses || likelihoods.size() != numClasses ){
+        distances.resize(numClasses);
+        likelihoods.resize(numClasses);
     }
     
     if( !trained ){
@@ -109,39 +134,39 @@ bool GMM::predict(VectorDouble x){
     }
 
 	UINT bestIndex = 0;
-	maxLikelihood = 0;
-    bestDistance = 0;
+	maximumLikelihood = 0;
+    double bestLikelihood = 0;
     double sum = 0;
 	for(UINT k=0; k<numClasses; k++){
-        classDistances[k] = computeMixtureLikelihood(x,k);
+        distances[k] = computeMixtureLikelihood(x,k);
         
-        //cout << "K: " << k << " Dist: " << classDistances[k] << endl;
-        classLikelihoods[k] = classDistances[k];
-        sum += classLikelihoods[k];
-		if( classLikelihoods[k] > bestDistance ){
-			bestDistance = classLikelihoods[k];
+        //cout << "K: " << k << " Dist: " << distances[k] << endl;
+        likelihoods[k] = distances[k];
+        sum += likelihoods[k];
+		if( likelihoods[k] > bestLikelihood ){
+			bestLikelihood = likelihoods[k];
 			bestIndex = k;
 		}
 	}
     
     //Normalize the likelihoods
     for(unsigned int k=0; k<numClasses; k++){
-        classLikelihoods[k] /= sum;
+        likelihoods[k] /= sum;
     }
-    maxLikelihood = classLikelihoods[bestIndex];
+    maximumLikelihood = likelihoods[bestIndex];
     
     if( useNullRejection ){
         
-        //cout << "Dist: " << classDistances[bestIndex] << " RejectionThreshold: " << models[bestIndex].getRejectionThreshold() << endl;
+        //cout << "Dist: " << distances[bestIndex] << " RejectionThreshold: " << models[bestIndex].getRejectionThreshold() << endl;
         
         //If the best distance is below the modles rejection threshold then set the predicted class label as the best class label
         //Otherwise set the predicted class label as the default null rejection class label of 0
-        if( classDistances[bestIndex] >= models[bestIndex].getNullRejectionThreshold() ){
-            predictedClassLabel = models[bestIndex].getClassLabel();
-        }else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
+        if( distances[bestIndex] >= models[bestIndex].getNullRejectionThreshold() ){
+            predictedLabel = models[bestIndex].getClassLabel();
+        }else predictedLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
    }else{
        //Get the predicted class label
-       predictedClassLabel = models[bestIndex].getClassLabel();
+       predictedLabel = models[bestIndex].getClassLabel();
    }
 	
 	return true;
@@ -149,53 +174,61 @@ bool GMM::predict(VectorDouble x){
 
 bool GMM::train(LabelledClassificationData trainingData){
     
+    //Copy the samples into one flat buffer, so the data for each class can be gathered with a single scan
+    FlatClassificationData data( trainingData );
+    
+    return train_( data, trainingData.getRanges() );
+}
+    
+bool GMM::train(const LabelledClassificationDataView &trainingData){
+    
+    //The samples in the view are copied straight into the flat buffer
+    FlatClassificationData data( trainingData );
+    
+    return train_( data, trainingData.getRanges() );
+}
+    
+bool GMM::train_(FlatClassificationData &data,const vector< MinMax > &dataRanges){
+    
     //Clear any old models
     models.clear();
     trained = false;
     numFeatures = 0;
     numClasses = 0;
     
-    if( trainingData.getNumSamples() == 0 ){
+    if( data.getNumSamples() == 0 ){
         errorLog << "train(LabelledClassificationData &trainingData) - Training data is empty!" << endl;
         return false;
     }
     
     //Set the number of features and number of classes and resize the models buffer
-    numFeatures = trainingData.getNumDimensions();
-    numClasses = trainingData.getNumClasses();
+    numFeatures = data.getNumDimensions();
+    numClasses = data.getNumClasses();
     models.resize(numClasses);
     
     if( numFeatures >= 6 ){
         warningLog << "train(LabelledClassificationData &trainingData) - The number of features in your training data is high (" << numFeatures << ").  The GMMClassifier does not work well with high dimensional data, you might get better results from one of the other classifiers." << endl;
     }
     
-    //Get the ranges of the training data if the training data is going to be scaled
+    //Get the ranges of the training data and scale the training data if needed
     if( useScaling ){
-        ranges = trainingData.getRanges();
+        ranges = dataRanges;
+        if( !data.scale(ranges,GMM_MIN_SCALE_VALUE, GMM_MAX_SCALE_VALUE) ){
+            errorLog << "train(LabelledClassificationData &trainingData) - Failed to scale training data!" << endl;
+            return false;
+        }
     }
 
     //Fit a Mixture Model to each class (independently)
     for(UINT k=0; k<numClasses; k++){
-        UINT classLabel = trainingData.getClassTracker()[k].classLabel;
-        LabelledClassificationData classData = trainingData.getClassData( classLabel );
-        
-        //Scale the training data if needed
-        if( useScaling ){
-            if( !classData.scale(ranges,GMM_MIN_SCALE_VALUE, GMM_MAX_SCALE_VALUE) ){
-                errorLog << "train(LabelledClassificationData &trainingData) - Failed to scale training data!" << endl;
-                return false;
-
-            }
-        }
-        
-        //Convert the labelled data to unlabelled data
-        UnlabelledClassificationData unlabelledData = classData.reformatAsUnlabelledClassificationData();
+        UINT classLabel = data.getClassTracker()[k].classLabel;
+        MatrixDouble classData = data.getClassDataAsMatrixDouble( classLabel );
         
         //Train the Mixture Model for this class
         GaussianMixtureModels gaussianMixtureModel;
         gaussianMixtureModel.setMinChange( minChange );
         gaussianMixtureModel.setMaxIter( maxIter );
-        if( !gaussianMixtureModel.train(unlabelledData, numMixtureModels) ){
+        if( !gaussianMixtureModel.train(classData, numMixtureModels) ){
             errorLog << "train(LabelledClassificationData &trainingData) - Failed to train Mixture Model for class " << classLabel << endl;
             return false;
         }
@@ -225,20 +258,22 @@ bool GMM::train(LabelledClassificationData trainingData){
         //Compute the rejection thresholds
         double mu = 0;
         double sigma = 0;
-        VectorDouble predictionResults(classData.getNumSamples(),0);
-        for(UINT i=0; i<classData.getNumSamples(); i++){
-            vector< double > sample = classData[i].getSample();
+        const UINT numClassSamples = classData.getNumRows();
+        VectorDouble predictionResults(numClassSamples,0);
+        VectorDouble sample(numFeatures);
+        for(UINT i=0; i<numClassSamples; i++){
+            std::copy( classData[i], classData[i]+numFeatures, sample.begin() );
             predictionResults[i] = models[k].computeMixtureLikelihood( sample );
             mu += predictionResults[i];
         }
         
         //Update mu
-        mu /= double( classData.getNumSamples() );
+        mu /= double( numClassSamples );
         
         //Calculate the standard deviation
-        for(UINT i=0; i<classData.getNumSamples(); i++) 
+        for(UINT i=0; i<numClassSamples; i++) 
             sigma += SQR( (predictionResults[i]-mu) );
-        sigma = sqrt( sigma / (double(classData.getNumSamples())-1.0) );
+        sigma = sqrt( sigma / (double(numClassSamples)-1.0) );
         sigma = 0.2;
         
         //Set the models training mu and sigma 
@@ -270,7 +305,7 @@ bool GMM::train(LabelledClassificationData trainingData){
     return true;
 }
     
-double GMM::computeMixtureLikelihood(const VectorDouble &x,UINT k){
+double GMM::computeMixtureLikelihood(const VectorDouble &x,UINT k) const{
     if( k >= numClasses ){
         errorLog << "computeMixtureLikelihood(vector<double> x,UINT k) - Invalid k value!" << endl;
         return 0;
@@ -394,91 +429,80 @@ bool GMM::loadModelFromFile(fstream &file){
         errorLog << "loadModelFromFile(fstream &file) - Could not open file to load model" << endl;
         return false;
     }
-    
-    std::string word;
+
+    FileTokenizer parser( file );
     
     //Find the file type header
-    file >> word;
-    if(word != "GRT_GMM_MODEL_FILE_V1.0"){
+    if( !parser.matchWord("GRT_GMM_MODEL_FILE_V1.0") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find Model File Header" << endl;
         return false;
     }
     
-    file >> word;
-    if(word != "NumFeatures:"){
+    if( !parser.matchWord("NumFeatures:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find NumFeatures " << endl;
         return false;
     }
-    file >> numFeatures;
+    parser >> numFeatures;
     
-    file >> word;
-    if(word != "NumClasses:"){
+    if( !parser.matchWord("NumClasses:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find NumClasses" << endl;
         return false;
     }
-    file >> numClasses;
+    parser >> numClasses;
     
-    file >> word;
-    if(word != "NumMixtureModels:"){
+    if( !parser.matchWord("NumMixtureModels:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find NumMixtureModels" << endl;
         return false;
     }
-    file >> numMixtureModels;
+    parser >> numMixtureModels;
     
-    file >> word;
-    if(word != "MaxIter:"){
+    if( !parser.matchWord("MaxIter:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find MaxIter" << endl;
         return false;
     }
-    file >> maxIter;
+    parser >> maxIter;
     
-    file >> word;
-    if(word != "MinChange:"){
+    if( !parser.matchWord("MinChange:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find MinChange" << endl;
         return false;
     }
-    file >> minChange;
+    parser >> minChange;
     
-    file >> word;
-    if(word != "UseScaling:"){
+    if( !parser.matchWord("UseScaling:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find UseScaling" << endl;
         return false;
     }
-    file >> useScaling;
+    parser >> useScaling;
     
-    file >> word;
-    if(word != "UseNullRejection:"){
+    if( !parser.matchWord("UseNullRejection:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find UseNullRejection" << endl;
         return false;
     }
-    file >> useNullRejection;
+    parser >> useNullRejection;
     
-    file >> word;
-    if(word != "NullRejectionCoeff:"){
+    if( !parser.matchWord("NullRejectionCoeff:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find NullRejectionCoeff" << endl;
         return false;
     }
-    file >> nullRejectionCoeff;
+    parser >> nullRejectionCoeff;
     
     ///Read the ranges if needed
     if( useScaling ){
         //Resize the ranges buffer
         ranges.resize(numFeatures);
         
-        file >> word;
-        if(word != "Ranges:"){
+        if( !parser.matchWord("Ranges:") ){
             errorLog << "loadModelFromFile(fstream &file) - Could not find the Ranges" << endl;
             return false;
         }
         for(UINT n=0; n<ranges.size(); n++){
-            file >> ranges[n].minValue;
-            file >> ranges[n].maxValue;
+            parser >> ranges[n].minValue;
+            parser >> ranges[n].maxValue;
         }
     }
     
     //Read the model header
-    file >> word;
-    if(word != "Models:"){
+    if( !parser.matchWord("Models:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find the Models Header" << endl;
         return false;
     }
@@ -496,53 +520,47 @@ bool GMM::loadModelFromFile(fstream &file){
         double trainingSigma;
         double rejectionThreshold;
         
-        file >> word;
-        if(word != "ClassLabel:"){
+        if( !parser.matchWord("ClassLabel:") ){
             errorLog << "loadModelFromFile(fstream &file) - Could not find the ClassLabel for model " << k+1 << endl;
             return false;
         }
-        file >> classLabel;
+        parser >> classLabel;
         models[k].setClassLabel( classLabel );
         classLabels[k] = classLabel;
         
-        file >> word;
-        if(word != "K:"){
+        if( !parser.matchWord("K:") ){
             errorLog << "loadModelFromFile(fstream &file) - Could not find K for model " << k+1 << endl;
             return false;
         }
-        file >> K;
+        parser >> K;
         
-        file >> word;
-        if(word != "NormalizationFactor:"){
+        if( !parser.matchWord("NormalizationFactor:") ){
             errorLog << "loadModelFromFile(fstream &file) - Could not find NormalizationFactor for model " << k+1 << endl;
             return false;
         }
-        file >> normalizationFactor;
+        parser >> normalizationFactor;
         models[k].setNormalizationFactor(normalizationFactor);
         
-        file >> word;
-        if(word != "TrainingMu:"){
+        if( !parser.matchWord("TrainingMu:") ){
             errorLog << "loadModelFromFile(fstream &file) - Could not find TrainingMu for model " << k+1 << endl;
             return false;
         }
-        file >> trainingMu;
+        parser >> trainingMu;
         
-        file >> word;
-        if(word != "TrainingSigma:"){
+        if( !parser.matchWord("TrainingSigma:") ){
             errorLog << "loadModelFromFile(fstream &file) - Could not find TrainingSigma for model " << k+1 << endl;
             return false;
         }
-        file >> trainingSigma;
+        parser >> trainingSigma;
         
         //Set the training mu and sigma
         models[k].setTrainingMuAndSigma(trainingMu, trainingSigma);
         
-        file >> word;
-        if(word != "NullRejectionThreshold:"){
+        if( !parser.matchWord("NullRejectionThreshold:") ){
             errorLog << "loadModelFromFile(fstream &file) - Could not find NullRejectionThreshold for model " << k+1 << endl;
             return false;
         }
-        file >>rejectionThreshold;
+        parser >> rejectionThreshold;
         
         //Set the rejection threshold
         models[k].setNullRejectionThreshold(rejectionThreshold);
@@ -558,43 +576,39 @@ bool GMM::loadModelFromFile(fstream &file){
             models[k][index].sigma.resize( numFeatures, numFeatures );
             models[k][index].invSigma.resize( numFeatures, numFeatures );
             
-            file >> word;
-            if(word != "Determinant:"){
+            if( !parser.matchWord("Determinant:") ){
                 errorLog << "loadModelFromFile(fstream &file) - Could not find the Determinant for model " << k+1 << endl;
                 return false;
             }
-            file >> models[k][index].det;
+            parser >> models[k][index].det;
             
             
-            file >> word;
-            if(word != "Mu:"){
+            if( !parser.matchWord("Mu:") ){
                 errorLog << "loadModelFromFile(fstream &file) - Could not find Mu for model " << k+1 << endl;
                 return false;
             }
             for(UINT j=0; j<models[k][index].mu.size(); j++){
-                file >> models[k][index].mu[j];
+                parser >> models[k][index].mu[j];
             }
             
             
-            file >> word;
-            if(word != "Sigma:"){
+            if( !parser.matchWord("Sigma:") ){
                 errorLog << "loadModelFromFile(fstream &file) - Could not find Sigma for model " << k+1 << endl;
                 return false;
             }
             for(UINT i=0; i<models[k][index].sigma.getNumRows(); i++){
                 for(UINT j=0; j<models[k][index].sigma.getNumCols(); j++){
-                    file >> models[k][index].sigma[i][j];
+                    parser >> models[k][index].sigma[i][j];
                 }
             }
             
-            file >> word;
-            if(word != "InvSigma:"){
+            if( !parser.matchWord("InvSigma:") ){
                 errorLog << "loadModelFromFile(fstream &file) - Could not find InvSigma for model " << k+1 << endl;
                 return false;
             }
             for(UINT i=0; i<models[k][index].invSigma.getNumRows(); i++){
                 for(UINT j=0; j<models[k][index].invSigma.getNumCols(); j++){
-                    file >> models[k][index].invSigma[i][j];
+                    parser >> models[k][index].invSigma[i][j];
                 }
             }
             
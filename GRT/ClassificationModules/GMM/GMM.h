@@ -36,6 +36,7 @@
 
 #include "../../GestureRecognitionPipeline/Classifier.h"
 #include "../../ClusteringModules/GaussianMixtureModels/GaussianMixtureModels.h"
+#include "../../DataStructures/FlatClassificationData.h"
 #include "MixtureModel.h"
 
 #define GMM_MIN_SCALE_VALUE 0.0001
@@ -83,6 +84,15 @@ public:
      */
     virtual bool train(LabelledClassificationData trainingData);
     
+    /**
+     This trains the GMM model directly from a view of the labelled classification data.
+     The samples in the view are copied straight into a flat buffer, so the view is never expanded into a full copy of the dataset.
+     
+     @param const LabelledClassificationDataView &trainingData: a view of the training data
+     @return returns true if the GMM model was trained, false otherwise
+     */
+    virtual bool train(const LabelledClassificationDataView &trainingData);
+    
     /**
      This predicts the class of the inputVector.
      This overrides the predict function in the GRT::Classifier base class.
@@ -91,6 +101,16 @@ public:
      @return returns true if the prediction was performed, false otherwise
      */
     virtual bool predict(VectorDouble inputVector);
+
+    /**
+     This predicts the class of the inputVector without changing the state of the classifier, so a trained model can be shared by many threads.
+     This overrides the predictStateless function in the Classifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassificationResult &result: returns the results of the prediction
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const;
     
     /**
      This saves the trained GMM model to a file.
@@ -178,7 +198,9 @@ public:
     bool setMaxIter(UINT maxIter);
     
 protected:
-    double computeMixtureLikelihood(const VectorDouble &x,UINT k);
+    bool train_(FlatClassificationData &data,const vector< MinMax > &dataRanges);
+    bool predict_(VectorDouble &x,UINT &predictedLabel,double &maximumLikelihood,VectorDouble &likelihoods,VectorDouble &distances) const;
+    double computeMixtureLikelihood(const VectorDouble &x,UINT k) const;
     
     UINT numMixtureModels;
     UINT maxIter;
@@ -97,7 +97,7 @@ public:
         return gaussModels[i];
 	}
     
-    double computeMixtureLikelihood(const vector<double> &x){
+    double computeMixtureLikelihood(const vector<double> &x) const{
         double sum = 0;
         for(UINT k=0; k<K; k++){
             sum += gauss(x,gaussModels[k].det,gaussModels[k].mu,gaussModels[k].invSigma);
@@ -148,23 +148,23 @@ public:
         return false;
     }
     
-    UINT getK(){ return K; }
+    UINT getK() const{ return K; }
     
-    UINT getClassLabel(){ return classLabel; }
+    UINT getClassLabel() const{ return classLabel; }
     
-    double getTrainingMu(){
+    double getTrainingMu() const{
         return trainingMu;
     }
     
-    double getTrainingSigma(){
+    double getTrainingSigma() const{
         return trainingSigma;
     }
     
-    double getNullRejectionThreshold(){
+    double getNullRejectionThreshold() const{
         return nullRejectionThreshold;
     }
     
-    double getNormalizationFactor(){
+    double getNormalizationFactor() const{
         return normFactor;
     }
     
@@ -190,7 +190,7 @@ public:
     }
     
 private:    
-    double gauss(const VectorDouble &x,double det,const VectorDouble &mu,Matrix<double> &invSigma){
+    double gauss(const VectorDouble &x,double det,const VectorDouble &mu,const Matrix<double> &invSigma) const{
         
         double y = 0;
         double sum = 0;
@@ -334,49 +334,43 @@ bool HMM::loadHMMModelsFromFile(const char* fileName){
 		return false;
 	}
 
-	std::string word;
+	FileTokenizer parser( file );
 
 	//Find the file type header
-	file >> word;
-	if(word != "HMM_MODEL_FILE_V1.0"){
+	if( !parser.matchWord("HMM_MODEL_FILE_V1.0") ){
 		cout<<"HMM_ERROR: Could not find Model File Header! \n";
 		return false;
 	}
 
-	file >> word;
-	if(word != "NumClasses:"){
+	if( !parser.matchWord("NumClasses:") ){
 		cout<<"HMM_ERROR: Could not find NumClasses \n";
 		return false;
 	}
-	file >> numClasses;
+	parser >> numClasses;
 
-	file >> word;
-	if(word != "NumStates:"){
+	if( !parser.matchWord("NumStates:") ){
 		cout<<"HMM_ERROR: Could not find NumStates \n";
 		return false;
 	}
-	file >> numStates;
+	parser >> numStates;
 
-	file >> word;
-	if(word != "NumSymbols:"){
+	if( !parser.matchWord("NumSymbols:") ){
 		cout<<"HMM_ERROR: Could not find NumSymbols \n";
 		return false;
 	}
-	file >> numSymbols;
+	parser >> numSymbols;
 
-	file >> word;
-	if(word != "ModelType:"){
+	if( !parser.matchWord("ModelType:") ){
 		cout<<"HMM_ERROR: Could not find ModelType \n";
 		return false;
 	}
-	file >> modelType;
+	parser >> modelType;
 
-	file >> word;
-	if(word != "Delta:"){
+	if( !parser.matchWord("Delta:") ){
 		cout<<"HMM_ERROR: Could not find Delta \n";
 		return false;
 	}
-	file >> delta;
+	parser >> delta;
 
 	//Resize the buffer
 	hmmClassBuffer.resize(numClasses);
@@ -384,87 +378,76 @@ bool HMM::loadHMMModelsFromFile(const char* fileName){
 	//Load each of the K classes
 	for(UINT k=0; k<numClasses; k++){
 		UINT modelID;
-		file >> word;
-		if(word != "*************_MODEL_*************"){
+		if( !parser.matchWord("*************_MODEL_*************") ){
 			cout<<"HMM_ERROR: Could not find header for the "<<k+1<<"th model\n";
 			return false;
 		}
 
-		file >> word;
-		if(word != "Model_ID:"){
+		if( !parser.matchWord("Model_ID:") ){
 			cout<<"HMM_ERROR: Could not find model ID for the "<<k+1<<"th model\n";
 			return false;
 		}
-		file >> modelID;
+		parser >> modelID;
 
 		if(modelID-1!=k){
 			cout<<"HMM_ERROR: Model ID does not match the current class ID for the "<<k+1<<"th model\n";
 			return false;
 		}
 
-		file >> word;
-		if(word != "NumStates:"){
+		if( !parser.matchWord("NumStates:") ){
 			cout<<"HMM_ERROR: Could not find the NumStates for the "<<k+1<<"th model\n";
 			return false;
 		}
-		file >> hmmClassBuffer[k].numStates;
+		parser >> hmmClassBuffer[k].numStates;
 
-		file >> word;
-		if(word != "NumSymbols:"){
+		if( !parser.matchWord("NumSymbols:") ){
 			cout<<"HMM_ERROR: Could not find the NumSymbols for the "<<k+1<<"th model\n";
 			return false;
 		}
-		file >> hmmClassBuffer[k].numSymbols;
+		parser >> hmmClassBuffer[k].numSymbols;
 
-		file >> word;
-		if(word != "ModelType:"){
+		if( !parser.matchWord("ModelType:") ){
 			cout<<"HMM_ERROR: Could not find the modelType for the "<<k+1<<"th model\n";
 			return false;
 		}
-		file >> hmmClassBuffer[k].modelType;
+		parser >> hmmClassBuffer[k].modelType;
 
-		file >> word;
-		if(word != "Delta:"){
+		if( !parser.matchWord("Delta:") ){
 			cout<<"HMM_ERROR: Could not find the Delta for the "<<k+1<<"th model\n";
 			return false;
 		}
-		file >> hmmClassBuffer[k].delta;
+		parser >> hmmClassBuffer[k].delta;
 
-		file >> word;
-		if(word != "Threshold:"){
+		if( !parser.matchWord("Threshold:") ){
 			cout<<"HMM_ERROR: Could not find the Threshold for the "<<k+1<<"th model\n";
 			return false;
 		}
-		file >> hmmClassBuffer[k].cThreshold;
+		parser >> hmmClassBuffer[k].cThreshold;
 
-		file >> word;
-		if(word != "NumTestSpawns:"){
+		if( !parser.matchWord("NumTestSpawns:") ){
 			cout<<"HMM_ERROR: Could not find the NumTestSpawns for the "<<k+1<<"th model\n";
 			return false;
 		}
-		file >> hmmClassBuffer[k].numTestSpawns;
+		parser >> hmmClassBuffer[k].numTestSpawns;
 
-		file >> word;
-		if(word != "MaxNumTestIter:"){
+		if( !parser.matchWord("MaxNumTestIter:") ){
 			cout<<"HMM_ERROR: Could not find the MaxNumTestIter for the "<<k+1<<"th model\n";
 			return false;
 		}
-		file >> hmmClassBuffer[k].maxNumTestIter;
+		parser >> hmmClassBuffer[k].maxNumTestIter;
 
-		file >> word;
-		if(word != "MaxNumIter:"){
+		if( !parser.matchWord("MaxNumIter:") ){
 			cout<<"HMM_ERROR: Could not find the MaxNumIter for the "<<k+1<<"th model\n";
 			return false;
 		}
-		file >> hmmClassBuffer[k].maxNumIter;
+		parser >> hmmClassBuffer[k].maxNumIter;
 
 		hmmClassBuffer[k].a.resize(hmmClassBuffer[k].numStates,hmmClassBuffer[k].numStates);
 		hmmClassBuffer[k].b.resize(hmmClassBuffer[k].numStates,hmmClassBuffer[k].numSymbols);
 		hmmClassBuffer[k].pi.resize(hmmClassBuffer[k].numStates);
 
 		//Load the A, B and Pi matrices
-		file >> word;
-		if(word != "A:"){
+		if( !parser.matchWord("A:") ){
 			cout<<"HMM_ERROR: Could not find the A matrix for the "<<k+1<<"th model\n";
 			return false;
 		}
@@ -473,13 +456,12 @@ bool HMM::loadHMMModelsFromFile(const char* fileName){
 		for(UINT i=0; i<hmmClassBuffer[k].numStates; i++){
 			for(UINT j=0; j<hmmClassBuffer[k].numStates; j++){
 				double value;
-				file >> value;
+				parser >> value;
 				hmmClassBuffer[k].a[i][j] = value;
 			}
 		}
 
-		file >> word;
-		if(word != "B:"){
+		if( !parser.matchWord("B:") ){
 			cout<<"HMM_ERROR: Could not find the B matrix for the "<<k+1<<"th model\n";
 			return false;
 		}
@@ -488,13 +470,12 @@ bool HMM::loadHMMModelsFromFile(const char* fileName){
 		for(UINT i=0; i<hmmClassBuffer[k].numStates; i++){
 			for(UINT j=0; j<hmmClassBuffer[k].numSymbols; j++){
 				double value;
-				file >> value;
+				parser >> value;
 				hmmClassBuffer[k].b[i][j] = value;
 			}
 		}
 
-		file >> word;
-		if(word != "Pi:"){
+		if( !parser.matchWord("Pi:") ){
 			cout<<"HMM_ERROR: Could not find the Pi matrix for the "<<k+1<<"th model\n";
 			return false;
 		}
@@ -502,12 +483,11 @@ bool HMM::loadHMMModelsFromFile(const char* fileName){
 		//Load Pi
 		for(UINT i=0; i<hmmClassBuffer[k].numStates; i++){
 			double value;
-			file >> value;
+			parser >> value;
 			hmmClassBuffer[k].pi[i] = value;
 		}
 
-		file >> word;
-		if(word != "*********************************"){
+		if( !parser.matchWord("*********************************") ){
 			cout<<"HMM_ERROR: Could not find the model footer for the "<<k+1<<"th model\n";
 			return false;
 		}
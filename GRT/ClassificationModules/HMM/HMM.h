@@ -48,6 +48,9 @@ public:
      */
     virtual bool deepCopyFrom(const Classifier *classifier);
     
+    //Keeps the train overloads this class does not override (such as training from a view) visible
+    using MLBase::train;
+    
     /**
      This trains the HMM model, using the labelled classification data.
      This overrides the train function in the Classifier base class.
@@ -34,6 +34,7 @@ KNN::KNN(unsigned int K,bool useScaling,bool useNullRejection,double nullRejecti
     this->searchForBestKValue = searchForBestKValue;
     this->minKSearchValue = minKSearchValue;
     this->maxKSearchValue = maxKSearchValue;
+    statelessPrediction = true;
     classifierType = "KNN";
     classifierMode = STANDARD_CLASSIFIER_MODE;
     distanceMethod = EUCLIDEAN_DISTANCE;
@@ -168,12 +169,26 @@ bool KNN::train(LabelledClassificationData trainingData){
     return false;
 }
 
-bool KNN::train_(LabelledClassificationData &trainingData,UINT K){
+bool KNN::train(const LabelledClassificationDataView &trainingData){
+
+    //The search for the best K value needs to partition the data, so this still needs a copy of the dataset
+    if( searchForBestKValue ){
+        return train( trainingData.getDataset() );
+    }
+
+    return train_(trainingData,K);
+}
+
+template< class T > bool KNN::train_(const T &trainingData,UINT K){
 
     //Clear any previous models
     clear();
 
-    if( trainingData.getNumSamples() == 0 ){
+    //TODO: In the future need to build a kdtree from the training data to allow better realtime prediction
+    //The training data is stored in one flat buffer so each prediction can scan it without copying the samples
+    this->trainingData.setData( trainingData );
+
+    if( this->trainingData.getNumSamples() == 0 ){
         errorLog << "train(LabelledClassificationData &trainingData) - Training data has zero samples!" << endl;
         return false;
     }
@@ -183,11 +198,8 @@ bool KNN::train_(LabelledClassificationData &trainingData,UINT K){
     this->numFeatures = trainingData.getNumDimensions();
     this->numClasses = trainingData.getNumClasses();
 
-    //TODO: In the future need to build a kdtree from the training data to allow better realtime prediction
-    this->trainingData = trainingData;
-
     if( useScaling ){
-        ranges = this->trainingData.getRanges();
+        ranges = trainingData.getRanges();
         this->trainingData.scale(ranges, 0, 1);
     }
 
@@ -208,6 +220,10 @@ bool KNN::train_(LabelledClassificationData &trainingData,UINT K){
         useNullRejection = false;
         rejectionThresholds.clear();
 
+        //The samples in the flat buffer have already been scaled, so the scaling is also switched off while they are predicted
+        bool tempUseScaling = useScaling;
+        useScaling = false;
+
         //Compute the rejection thresholds for each of the K classes
         VectorDouble counter(numClasses,0);
         trainingMu.resize( numClasses, 0 );
@@ -215,10 +231,10 @@ bool KNN::train_(LabelledClassificationData &trainingData,UINT K){
         rejectionThresholds.resize( numClasses, 0 );
 
         //Compute Mu for each of the classes
-        const unsigned int numTrainingExamples = trainingData.getNumSamples();
+        const unsigned int numTrainingExamples = this->trainingData.getNumSamples();
         vector< IndexedDouble > predictionResults( numTrainingExamples );
         for(UINT i=0; i<numTrainingExamples; i++){
-            predict( trainingData[i].getSample(), K);
+            predict( this->trainingData.getSampleVector(i), K);
 
             UINT classLabelIndex = 0;
             for(UINT k=0; k<numClasses; k++){
@@ -235,6 +251,9 @@ bool KNN::train_(LabelledClassificationData &trainingData,UINT K){
             counter[ classLabelIndex ]++;
         }
 
+        //Restore the actual state of the scaling
+        useScaling = tempUseScaling;
+
         for(UINT j=0; j<numClasses; j++){
             trainingMu[j] /= counter[j];
         }
@@ -308,6 +327,19 @@ bool KNN::predict(VectorDouble inputVector){
 }
 
 bool KNN::predict(VectorDouble inputVector,UINT K){
+    return predict_( inputVector, K, predictedClassLabel, maxLikelihood, classLikelihoods, classDistances );
+}
+
+bool KNN::predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const{
+    VectorDouble x = inputVector;
+    if( !predict_( x, K, result.predictedClassLabel, result.maximumLikelihood, result.classLikelihoods, result.classDistances ) ){
+        return false;
+    }
+    result.unprocessedPredictedClassLabel = result.predictedClassLabel;
+    return true;
+}
+
+bool KNN::predict_(VectorDouble &inputVector,const UINT K,UINT &predictedLabel,double &maximumLikelihood,VectorDouble &likelihoods,VectorDouble &distances) const{
 
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector,UINT K) - KNN model has not been trained" << endl;
@@ -336,8 +368,8 @@ bool KNN::predict(VectorDouble inputVector,UINT K){
 
     for(UINT i=0; i<M; i++){
         double dist = 0;
-        UINT classLabel = trainingData[i].getClassLabel();
-        VectorDouble trainingSample = trainingData[i].getSample();
+        UINT classLabel = trainingData.getClassLabel(i);
+        const double *trainingSample = trainingData[i];
 
         switch( distanceMethod ){
             case EUCLIDEAN_DISTANCE:
@@ -376,10 +408,10 @@ bool KNN::predict(VectorDouble inputVector,UINT K){
     }
 
     //Predict the class ID using the labels of the K nearest neighbours
-    if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
-    else for(UINT i=0; i<classLikelihoods.size(); i++){ classLikelihoods[i] = 0; }
-    if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
-    else for(UINT i=0; i<classDistances.size(); i++){ classDistances[i] = 0; }
+    if( likelihoods.size() != numClasses ) likelihoods.resize(numClasses,0);
+    else for(UINT i=0; i<likelihoods.size(); i++){ likelihoods[i] = 0; }
+    if( distances.size() != numClasses ) distances.resize(numClasses,0);
+    else for(UINT i=0; i<distances.size(); i++){ distances[i] = 0; }
 
     //Count the classes
     for(UINT k=0; k<neighbours.size(); k++){
@@ -397,42 +429,42 @@ bool KNN::predict(VectorDouble inputVector,UINT K){
 				break;
 			}
 		}
-        classLikelihoods[ classLabelIndex ] += 1;
-        classDistances[ classLabelIndex ] += neighbours[k].value;
+        likelihoods[ classLabelIndex ] += 1;
+        distances[ classLabelIndex ] += neighbours[k].value;
     }
 
     //Get the max count
-    double maxCount = classLikelihoods[0];
+    double maxCount = likelihoods[0];
     UINT maxIndex = 0;
-    for(UINT i=1; i<classLikelihoods.size(); i++){
-        if( classLikelihoods[i] > maxCount ){
-            maxCount = classLikelihoods[i];
+    for(UINT i=1; i<likelihoods.size(); i++){
+        if( likelihoods[i] > maxCount ){
+            maxCount = likelihoods[i];
             maxIndex = i;
         }
     }
 
     //Compute the average distances per class
-    for(UINT i=0; i<classDistances.size(); i++){
-        if( classLikelihoods[i] > 0 )   classDistances[i] /= classLikelihoods[i];
-        else classDistances[i] = BIG_DISTANCE;
+    for(UINT i=0; i<distances.size(); i++){
+        if( likelihoods[i] > 0 )   distances[i] /= likelihoods[i];
+        else distances[i] = BIG_DISTANCE;
     }
 
     //Normalize the likelihoods
-    for(UINT i=0; i<classLikelihoods.size(); i++){
-        classLikelihoods[i] /= double( neighbours.size() );
+    for(UINT i=0; i<likelihoods.size(); i++){
+        likelihoods[i] /= double( neighbours.size() );
     }
 
     //Set the maximum likelihood value
-    maxLikelihood = classLikelihoods[ maxIndex ];
+    maximumLikelihood = likelihoods[ maxIndex ];
 
     if( useNullRejection ){
-        if( classDistances[ maxIndex ] <= rejectionThresholds[ maxIndex ] ){
-            predictedClassLabel = classLabels[maxIndex];
+        if( distances[ maxIndex ] <= rejectionThresholds[ maxIndex ] ){
+            predictedLabel = classLabels[maxIndex];
         }else{
-            predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL; //Set the gesture label as the null label
+            predictedLabel = GRT_DEFAULT_NULL_CLASS_LABEL; //Set the gesture label as the null label
         }
     }else{
-        predictedClassLabel = classLabels[maxIndex];
+        predictedLabel = classLabels[maxIndex];
     }
 
     return true;
@@ -497,7 +529,7 @@ bool KNN::saveModelToFile(fstream &file){
     
     //Right each of the models
     for(UINT i=0; i<trainingData.getNumSamples(); i++){
-        file<< trainingData[i].getClassLabel() << "\t";
+        file<< trainingData.getClassLabel(i) << "\t";
         
         for(UINT j=0; j<numFeatures; j++){
             file << trainingData[i][j] << "\t";
@@ -532,101 +564,88 @@ bool KNN::loadModelFromFile(fstream &file){
         errorLog << "loadModelFromFile(fstream &file) - Could not open file to load model!" << endl;
         return false;
     }
-    
-    std::string word;
+
+    FileTokenizer parser( file );
     
     //Find the file type header
-    file >> word;
-    if(word != "GRT_KNN_MODEL_FILE_V1.0"){
+    if( !parser.matchWord("GRT_KNN_MODEL_FILE_V1.0") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find Model File Header!" << endl;
         return false;
     }
     
     //Find the file type header
-    file >> word;
-    if(word != "NumFeatures:"){
+    if( !parser.matchWord("NumFeatures:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find NumFeatures!" << endl;
         return false;
     }
-    file >> numFeatures;
+    parser >> numFeatures;
     
-    file >> word;
-    if(word != "NumClasses:"){
+    if( !parser.matchWord("NumClasses:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find NumClasses!" << endl;
         return false;
     }
-    file >> numClasses;
+    parser >> numClasses;
     
-    file >> word;
-    if(word != "K:"){
+    if( !parser.matchWord("K:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find K!" << endl;
         return false;
     }
-    file >> K;
+    parser >> K;
     
-    file >> word;
-    if(word != "DistanceMethod:"){
+    if( !parser.matchWord("DistanceMethod:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find DistanceMethod!" << endl;
         return false;
     }
-    file >> distanceMethod;
+    parser >> distanceMethod;
     
-    file >> word;
-    if(word != "SearchForBestKValue:"){
+    if( !parser.matchWord("SearchForBestKValue:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find SearchForBestKValue!" << endl;
         return false;
     }
-    file >> searchForBestKValue;
+    parser >> searchForBestKValue;
     
-    file >> word;
-    if(word != "MinKSearchValue:"){
+    if( !parser.matchWord("MinKSearchValue:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find MinKSearchValue!" << endl;
         return false;
     }
-    file >> minKSearchValue;
+    parser >> minKSearchValue;
     
-    file >> word;
-    if(word != "MaxKSearchValue:"){
+    if( !parser.matchWord("MaxKSearchValue:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find MaxKSearchValue!" << endl;
         return false;
     }
-    file >> maxKSearchValue;
+    parser >> maxKSearchValue;
     
-    file >> word;
-    if(word != "UseScaling:"){
+    if( !parser.matchWord("UseScaling:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find UseScaling!" << endl;
         return false;
     }
-    file >> useScaling;
+    parser >> useScaling;
     
-    file >> word;
-    if(word != "UseNullRejection:"){
+    if( !parser.matchWord("UseNullRejection:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find UseNullRejection!" << endl;
         return false;
     }
-    file >> useNullRejection;
+    parser >> useNullRejection;
     
-    file >> word;
-    if(word != "NullRejectionCoeff:"){
+    if( !parser.matchWord("NullRejectionCoeff:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find NullRejectionCoeff!" << endl;
         return false;
     }
-    file >> nullRejectionCoeff;
+    parser >> nullRejectionCoeff;
     
     ///Read the ranges if needed
     if( useScaling ){
         //Resize the ranges buffer
         ranges.resize( numFeatures );
         
-        file >> word;
-        if(word != "Ranges:"){
+        if( !parser.matchWord("Ranges:") ){
             errorLog << "loadModelFromFile(fstream &file) - Could not find Ranges!" << endl;
-            cout << "Word: " << word << endl;
             return false;
         }
         for(UINT n=0; n<ranges.size(); n++){
-            file >> ranges[n].minValue;
-            file >> ranges[n].maxValue;
+            parser >> ranges[n].minValue;
+            parser >> ranges[n].maxValue;
         }
     }
     
@@ -634,38 +653,34 @@ bool KNN::loadModelFromFile(fstream &file){
     trainingMu.resize(numClasses,0);
     trainingSigma.resize(numClasses,0);
     
-    file >> word;
-    if(word != "TrainingMu:"){
+    if( !parser.matchWord("TrainingMu:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find TrainingMu!" << endl;
         return false;
     }
     
     //Load the trainingMu data
     for(UINT j=0; j<numClasses; j++){
-        file >> trainingMu[j];
+        parser >> trainingMu[j];
     }
     
-    file >> word;
-    if(word != "TrainingSigma:"){
+    if( !parser.matchWord("TrainingSigma:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find TrainingSigma!" << endl;
         return false;
     }
     
     //Load the trainingSigma data
     for(UINT j=0; j<numClasses; j++){
-        file >> trainingSigma[j];
+        parser >> trainingSigma[j];
     }
     
-    file >> word;
-    if(word != "NumTrainingSamples:"){
+    if( !parser.matchWord("NumTrainingSamples:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find NumTrainingSamples!" << endl;
         return false;
     }
     unsigned int numTrainingSamples = 0;
-    file >> numTrainingSamples;
+    parser >> numTrainingSamples;
     
-    file >> word;
-    if(word != "TrainingData:"){
+    if( !parser.matchWord("TrainingData:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find TrainingData!" << endl;
         return false;
     }
@@ -676,11 +691,11 @@ bool KNN::loadModelFromFile(fstream &file){
     vector< double > sample(numFeatures,0);
     for(UINT i=0; i<numTrainingSamples; i++){
         //Read the class label
-        file >> classLabel;
+        parser >> classLabel;
         
         //Read the feature vector
         for(UINT j=0; j<numFeatures; j++){
-            file >> sample[j];
+            parser >> sample[j];
         }
         
         //Add it to the training data
@@ -761,40 +776,31 @@ bool KNN::setDistanceMethod(UINT distanceMethod){
     return false;
 }
 
-double KNN::computeEuclideanDistance(const VectorDouble &a,const VectorDouble &b){
-    double dist = 0;
-    for(UINT j=0; j<numFeatures; j++){
-        dist += SQR( a[j] - b[j] );
+double KNN::computeEuclideanDistance(const VectorDouble &a,const double *b) const{
+    switch( numFeatures ){
+        case 1: return Dims< 1 >::euclidean( &a[0], b, numFeatures );
+        case 2: return Dims< 2 >::euclidean( &a[0], b, numFeatures );
+        case 3: return Dims< 3 >::euclidean( &a[0], b, numFeatures );
+        default: return Dims< 0 >::euclidean( &a[0], b, numFeatures );
     }
-    return sqrt( dist );
 }
 
-double KNN::computeCosineDistance(const VectorDouble &a,const VectorDouble &b){
-    double dist = 0;
-
-    double dotAB = 0;
-    double magA = 0;
-    double magB = 0;
-
-    for(UINT j=0; j<numFeatures; j++){
-        dotAB += a[j] * b[j];
-        magA += SQR(a[j]);
-        magB += SQR(b[j]);
+double KNN::computeCosineDistance(const VectorDouble &a,const double *b) const{
+    switch( numFeatures ){
+        case 1: return Dims< 1 >::cosine( &a[0], b, numFeatures );
+        case 2: return Dims< 2 >::cosine( &a[0], b, numFeatures );
+        case 3: return Dims< 3 >::cosine( &a[0], b, numFeatures );
+        default: return Dims< 0 >::cosine( &a[0], b, numFeatures );
     }
-
-    dist = dotAB / (sqrt(magA) * sqrt(magB));
-
-    return dist;
 }
 
-double KNN::computeManhattanDistance(const VectorDouble &a,const VectorDouble &b){
-    double dist = 0;
-
-    for(UINT j=0; j<numFeatures; j++){
-        dist += fabs( a[j] - b[j] );
+double KNN::computeManhattanDistance(const VectorDouble &a,const double *b) const{
+    switch( numFeatures ){
+        case 1: return Dims< 1 >::manhattan( &a[0], b, numFeatures );
+        case 2: return Dims< 2 >::manhattan( &a[0], b, numFeatures );
+        case 3: return Dims< 3 >::manhattan( &a[0], b, numFeatures );
+        default: return Dims< 0 >::manhattan( &a[0], b, numFeatures );
     }
-
-    return dist;
 }
 
 } //End of namespace GRT
@@ -40,6 +40,7 @@
 #define GRT_KNN_HEADER
 
 #include "../../GestureRecognitionPipeline/Classifier.h"
+#include "../../DataStructures/FlatClassificationData.h"
 
 namespace GRT{
     
@@ -92,6 +93,16 @@ public:
     */
     virtual bool train(LabelledClassificationData trainingData);
     
+    /**
+     This trains the KNN model directly from a view of the labelled classification data, the samples in the view are copied
+     straight into the flat buffer used for the predictions so the dataset is not copied first.
+     If searchForBestKValue is true then the view is copied into a dataset so it can be partitioned.
+     
+     @param const LabelledClassificationDataView &trainingData: a view of the training data
+     @return returns true if the KNN model was trained, false otherwise
+    */
+    virtual bool train(const LabelledClassificationDataView &trainingData);
+    
     /**
      This predicts the class of the inputVector.
      This overrides the predict function in the Classifier base class.
@@ -100,6 +111,16 @@ public:
      @return returns true if the prediction was performed, false otherwise
     */
     virtual bool predict(VectorDouble inputVector);
+
+    /**
+     This predicts the class of the inputVector without changing the state of the classifier, so a trained model can be shared by many threads.
+     This overrides the predictStateless function in the Classifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassificationResult &result: returns the results of the prediction
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const;
     
     /**
      This saves the trained KNN model to a file.
@@ -218,18 +239,19 @@ public:
     bool setDistanceMethod(UINT distanceMethod);
 
 protected:
-    bool train_(LabelledClassificationData &trainingData,UINT K);
+    template< class T > bool train_(const T &trainingData,UINT K);
     bool predict(VectorDouble inputVector,UINT K);
-    double computeEuclideanDistance(const VectorDouble &a,const VectorDouble &b);
-    double computeCosineDistance(const VectorDouble &a,const VectorDouble &b);
-    double computeManhattanDistance(const VectorDouble &a,const VectorDouble &b);
+    bool predict_(VectorDouble &inputVector,const UINT K,UINT &predictedLabel,double &maximumLikelihood,VectorDouble &likelihoods,VectorDouble &distances) const;
+    double computeEuclideanDistance(const VectorDouble &a,const double *b) const;
+    double computeCosineDistance(const VectorDouble &a,const double *b) const;
+    double computeManhattanDistance(const VectorDouble &a,const double *b) const;
     
     UINT K;                                     ///> The number of neighbours to search for
     UINT distanceMethod;                        ///> The distance method used to compute the distance between each data point
     bool searchForBestKValue;                   ///> Sets if the best K value should be searched for or if the model should be trained with K
     UINT minKSearchValue;                       ///> The minimum K value to start the search from
     UINT maxKSearchValue;                       ///> The maximum K value to end the search at
-    LabelledClassificationData trainingData;    ///> Holds the trainingData to perform the predictions
+    FlatClassificationData trainingData;        ///> Holds the trainingData to perform the predictions
     VectorDouble trainingMu;                    ///> Holds the average max-class distance of the training data for each of classes
     VectorDouble trainingSigma;                 ///> Holds the stddev of the max-class distance of the training data for each of classes
     VectorDouble rejectionThresholds;           ///> Holds the rejection threshold for each of the classes
@@ -27,6 +27,7 @@ LDA::LDA(bool useScaling,bool useNullRejection,double nullRejectionCoeff)
     this->useScaling = useScaling;
     this->useNullRejection = useNullRejection;
     this->nullRejectionCoeff = nullRejectionCoeff;
+    statelessPrediction = true;
     classifierType = "LDA";
     classifierMode = STANDARD_CLASSIFIER_MODE;
     debugLog.setProceedingText("[DEBUG LDA]");
@@ -196,14 +197,28 @@ bool LDA::train(LabelledClassificationData trainingData){
 }
 
 bool LDA::predict(VectorDouble inputVector){
+    bestDistance = 0;
+    return predict_( inputVector, predictedClassLabel, maxLikelihood, classLikelihoods, classDistances );
+}
+
+bool LDA::predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const{
+    VectorDouble x = inputVector;
+    if( !predict_( x, result.predictedClassLabel, result.maximumLikelihood, result.classLikelihoods, result.classDistances ) ){
+        return false;
+    }
+    result.unprocessedPredictedClassLabel = result.predictedClassLabel;
+    return true;
+}
+
+bool LDA::predict_(VectorDouble &inputVector,UINT &predictedLabel,double &maximumLikelihood,VectorDouble &likelihoods,VectorDouble &distances) const{
     
     if( !trained ){
         errorLog << "predict(vector< double > inputVector) - LDA Model Not Trained!" << endl;
         return false;
     }
     
-    predictedClassLabel = 0;
-	maxLikelihood = -10000;
+    predictedLabel = 0;
+	maximumLikelihood = -10000;
     
     if( !trained ) return false;
     
@@ -213,39 +228,38 @@ bool LDA::predict(VectorDouble inputVector){
 	}
     
     //Make sure the likelihoods and distances vectors have been assigned
-    if( classLikelihoods.size() != numClasses || classDistances.size() != numClasses ){
-        classLikelihoods.resize(numClasses);
-        classDistances.resize(numClasses);
+    if( likelihoods.size() != numClasses || distances.size() != numClasses ){
+        likelihoods.resize(numClasses);
+        distances.resize(numClasses);
     }
     
     //Compute the linear scores for each class
-    bestDistance = 0;
-    maxLikelihood = 0;
+    maximumLikelihood = 0;
     UINT bestIndex = 0;
     double sum = 0;
     for(UINT k=0; k<numClasses; k++){
         
         for(UINT j=0; j<numFeatures+1; j++){
-            if( j==0 ) classDistances[k] = models[k].weights[j];
-            else classDistances[k] += inputVector[j-1] * models[k].weights[j];
+            if( j==0 ) distances[k] = models[k].weights[j];
+            else distances[k] += inputVector[j-1] * models[k].weights[j];
         }
-        classLikelihoods[k] = exp( classDistances[k] );
-        sum += classLikelihoods[k];
+        likelihoods[k] = exp( distances[k] );
+        sum += likelihoods[k];
         
-        if( classLikelihoods[k] > maxLikelihood ){
+        if( likelihoods[k] > maximumLikelihood ){
             bestIndex = k;
-            maxLikelihood = classLikelihoods[k];
+            maximumLikelihood = likelihoods[k];
         }
     }
     
     //Normalize the likelihoods
     for(UINT k=0; k<numClasses; k++){
-        classLikelihoods[k] /= sum;
+        likelihoods[k] /= sum;
     }
     
-    maxLikelihood = classLikelihoods[ bestIndex ];
+    maximumLikelihood = likelihoods[ bestIndex ];
     
-    predictedClassLabel = models[ bestIndex ].classLabel;
+    predictedLabel = models[ bestIndex ].classLabel;
     
     return true;
 }
@@ -333,57 +347,51 @@ bool LDA::loadModelFromFile(fstream &file){
         errorLog << "loadModelFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    std::string word;
+
+    FileTokenizer parser( file );
     
     //Find the file type header
-    file >> word;
-    if(word != "GRT_LDA_MODEL_FILE_V1.0"){
+    if( !parser.matchWord("GRT_LDA_MODEL_FILE_V1.0") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find Model File Header" << endl;
         return false;
     }
     
-    file >> word;
-    if(word != "NumFeatures:"){
+    if( !parser.matchWord("NumFeatures:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find NumFeatures " << endl;
         return false;
     }
-    file >> numFeatures;
+    parser >> numFeatures;
     
-    file >> word;
-    if(word != "NumClasses:"){
+    if( !parser.matchWord("NumClasses:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find NumClasses" << endl;
         return false;
     }
-    file >> numClasses;
+    parser >> numClasses;
     
-    file >> word;
-    if(word != "UseScaling:"){
+    if( !parser.matchWord("UseScaling:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find UseScaling" << endl;
         return false;
     }
-    file >> useScaling;
+    parser >> useScaling;
     
-    file >> word;
-    if(word != "UseNullRejection:"){
+    if( !parser.matchWord("UseNullRejection:") ){
         errorLog << "loadModelFromFile(fstream &file) - Could not find UseNullRejection" << endl;
         return false;
     }
-    file >> useNullRejection;
+    parser >> useNullRejection;
     
     ///Read the ranges if needed
     if( useScaling ){
         //Resize the ranges buffer
         ranges.resize(numFeatures);
         
-        file >> word;
-        if(word != "Ranges:"){
+        if( !parser.matchWord("Ranges:") ){
             errorLog << "loadModelFromFile(fstream &file) - Could not find the Ranges" << endl;
             return false;
         }
         for(UINT n=0; n<ranges.size(); n++){
-            file >> ranges[n].minValue;
-            file >> ranges[n].maxValue;
+            parser >> ranges[n].minValue;
+            parser >> ranges[n].maxValue;
         }
     }
     
@@ -393,26 +401,23 @@ bool LDA::loadModelFromFile(fstream &file){
     
     //Load each of the K models
     for(UINT k=0; k<numClasses; k++){
-        file >> word;
-        if(word != "ClassLabel:"){
+        if( !parser.matchWord("ClassLabel:") ){
             errorLog << "loadModelFromFile(fstream &file) - Could not find ClassLabel for the "<<k+1<<"th model" << endl;
             return false;
         }
-        file >> models[k].classLabel;
+        parser >> models[k].classLabel;
         classLabels[k] = models[k].classLabel;
         
-        file >> word;
-        if(word != "PriorProbability:"){
+        if( !parser.matchWord("PriorProbability:") ){
             errorLog << "loadModelFromFile(fstream &file) - Could not find the PriorProbability for the "<<k+1<<"th model" << endl;
             return false;
         }
-        file >> models[k].priorProb;
+        parser >> models[k].priorProb;
         
         models[k].weights.resize(numFeatures+1);
         
         //Load the weights
-        file >> word;
-        if(word != "Weights:"){
+        if( !parser.matchWord("Weights:") ){
             errorLog << "loadModelFromFile(fstream &file) - Could not find the Weights vector for the "<<k+1<<"th model" << endl;
             return false;
         }
@@ -420,7 +425,7 @@ bool LDA::loadModelFromFile(fstream &file){
         //Load Weights
         for(UINT j=0; j<numFeatures+1; j++){
             double value;
-            file >> value;
+            parser >> value;
             models[k].weights[j] = value;
         }
     }
@@ -107,6 +107,9 @@ public:
         return false;
     }
     
+    //Keeps the train overloads this class does not override (such as training from a view) visible
+    using MLBase::train;
+    
     /**
      This trains the LDA model, using the labelled classification data.
      This overrides the train function in the Classifier base class.
@@ -124,6 +127,16 @@ public:
      @return returns true if the prediction was performed, false otherwise
     */
     virtual bool predict(VectorDouble inputVector);
+
+    /**
+     This predicts the class of the inputVector without changing the state of the classifier, so a trained model can be shared by many threads.
+     This overrides the predictStateless function in the Classifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassificationResult &result: returns the results of the prediction
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const;
     
     /**
      This saves the trained LDA model to a file.
@@ -168,6 +181,8 @@ public:
 
 
 private:
+    bool predict_(VectorDouble &inputVector,UINT &predictedLabel,double &maximumLikelihood,VectorDouble &likelihoods,VectorDouble &distances) const;
+
 	MatrixDouble computeBetweenClassScatterMatrix( LabelledClassificationData &data );
 	MatrixDouble computeWithinClassScatterMatrix( LabelledClassificationData &data );
 	
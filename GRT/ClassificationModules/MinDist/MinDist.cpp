@@ -31,6 +31,7 @@ MinDist::MinDist(bool useScaling,bool useNullRejection,double nullRejectionCoeff
     this->useNullRejection = useNullRejection;
     this->nullRejectionCoeff = nullRejectionCoeff;
     this->numClusters = numClusters;
+    statelessPrediction = true;
     classifierType = "MinDist";
     classifierMode = STANDARD_CLASSIFIER_MODE;
     debugLog.setProceedingText("[DEBUG MinDist]");
@@ -77,15 +78,36 @@ bool MinDist::train(LabelledClassificationData trainingData){
     return train(trainingData,nullRejectionCoeff);
 }
 
+bool MinDist::train(const LabelledClassificationDataView &trainingData){
+    
+    //The samples in the view are copied straight into the flat buffer
+    FlatClassificationData data( trainingData );
+    
+    return train_( data, trainingData.getRanges(), nullRejectionCoeff );
+}
+
 bool MinDist::predict(VectorDouble inputVector){
+    return predict_( inputVector, predictedClassLabel, maxLikelihood, classLikelihoods, classDistances );
+}
+
+bool MinDist::predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const{
+    VectorDouble x = inputVector;
+    if( !predict_( x, result.predictedClassLabel, result.maximumLikelihood, result.classLikelihoods, result.classDistances ) ){
+        return false;
+    }
+    result.unprocessedPredictedClassLabel = result.predictedClassLabel;
+    return true;
+}
+
+bool MinDist::predict_(VectorDouble &inputVector,UINT &predictedLabel,double &maximumLikelihood,VectorDouble &likelihoods,VectorDouble &distances) const{
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - MinDist Model Not Trained!" << endl;
         return false;
     }
     
-    predictedClassLabel = 0;
-	maxLikelihood = 0;
+    predictedLabel = 0;
+	maximumLikelihood = 0;
     
     if( !trained ) return false;
     
@@ -100,44 +122,52 @@ bool MinDist::predict(VectorDouble inputVector){
         }
     }
     
-    if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
-    if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
+    if( likelihoods.size() != numClasses ) likelihoods.resize(numClasses,0);
+    if( distances.size() != numClasses ) distances.resize(numClasses,0);
     
     double classLikelihoodsSum = 0;
     double minDist = numeric_limits<double>::max();
 	for(UINT k=0; k<numClasses; k++){
-		classDistances[k] = models[k].predict( inputVector );
+		distances[k] = models[k].predict( inputVector );
         
         //At this point the class likelihoods and class distances are the same thing
-        classLikelihoods[k] = classDistances[k];
-        classLikelihoodsSum += classDistances[k];
+        likelihoods[k] = distances[k];
+        classLikelihoodsSum += distances[k];
 
         //Keep track of the best value
-		if( classDistances[k] < minDist ){
-			minDist = classDistances[k];
-			predictedClassLabel = k;
+		if( distances[k] < minDist ){
+			minDist = distances[k];
+			predictedLabel = k;
 		}
     }
     
     //Normalize the classlikelihoods
 	if( classLikelihoodsSum != 0 ){
     	for(UINT k=0; k<numClasses; k++){
-        	classLikelihoods[k] = (classLikelihoodsSum-classLikelihoods[k])/classLikelihoodsSum;
+        	likelihoods[k] = (classLikelihoodsSum-likelihoods[k])/classLikelihoodsSum;
     	}
-        maxLikelihood = classLikelihoods[predictedClassLabel];
-	}else maxLikelihood = classLikelihoods[predictedClassLabel];
+        maximumLikelihood = likelihoods[predictedLabel];
+	}else maximumLikelihood = likelihoods[predictedLabel];
     
     if( useNullRejection ){
         //Check to see if the best result is greater than the models threshold
-        if( minDist <= models[predictedClassLabel].getRejectionThreshold() ) predictedClassLabel = models[predictedClassLabel].getClassLabel();
-        else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
-    }else predictedClassLabel = models[predictedClassLabel].getClassLabel();
+        if( minDist <= models[predictedLabel].getRejectionThreshold() ) predictedLabel = models[predictedLabel].getClassLabel();
+        else predictedLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
+    }else predictedLabel = models[predictedLabel].getClassLabel();
     
     return true;
 }
 
 bool MinDist::train(LabelledClassificationData &labelledTrainingData,double gamma){
     
+    //Copy the samples into one flat buffer, so the data for each class can be gathered with a single scan
+    FlatClassificationData data( labelledTrainingData );
+    
+    return train_( data, labelledTrainingData.getRanges(), gamma );
+}
+    
+bool MinDist::train_(const FlatClassificationData &labelledTrainingData,const vector< MinMax > &dataRanges,double gamma){
+    
     const unsigned int M = labelledTrainingData.getNumSamples();
     const unsigned int N = labelledTrainingData.getNumDimensions();
     const unsigned int K = labelledTrainingData.getNumClasses();
@@ -159,7 +189,7 @@ bool MinDist::train(LabelledClassificationData &labelledTrainingData,double gamm
     numClasses = K;
     models.resize(K);
     classLabels.resize(K);
-    ranges = labelledTrainingData.getRanges();
+    ranges = dataRanges;
     
     //Train each of the models
 	for(UINT k=0; k<numClasses; k++){
@@ -170,16 +200,13 @@ bool MinDist::train(LabelledClassificationData &labelledTrainingData,double gamm
         //Set the kth class label
         classLabels[k] = classLabel;
         
-        //Get all the training data for this class
-        LabelledClassificationData classData = labelledTrainingData.getClassData(classLabel);
-        MatrixDouble data(classData.getNumSamples(),N);
-        
-        //Copy the training data into a matrix, scaling the training data if needed
-        for(UINT i=0; i<data.getNumRows(); i++){
-            for(UINT j=0; j<data.getNumCols(); j++){
-                if( useScaling ){
-                    data[i][j] = scale(classData[i][j],ranges[j].minValue,ranges[j].maxValue,0,1);
-                }else data[i][j] = classData[i][j];
+        //Get all the training data for this class, scaling the training data if needed
+        MatrixDouble data = labelledTrainingData.getClassDataAsMatrixDouble(classLabel);
+        if( useScaling ){
+            for(UINT i=0; i<data.getNumRows(); i++){
+                for(UINT j=0; j<data.getNumCols(); j++){
+                    data[i][j] = scale(data[i][j],ranges[j].minValue,ranges[j].maxValue,0,1);
+                }
             }
         }
         
@@ -308,57 +335,51 @@ bool MinDist::loadModelFromFile(fstream &file){
         errorLog << "loadModelFromFile(string filename) - Could not open file to load model" << endl;
         return false;
     }
-    
-    std::string word;
+
+    FileTokenizer parser( file );
     
     //Find the file type header
-    file >> word;
-    if(word != "GRT_MINDIST_MODEL_FILE_V1.0"){
+    if( !parser.matchWord("GRT_MINDIST_MODEL_FILE_V1.0") ){
         errorLog << "loadModelFromFile(string filename) - Could not find Model File Header" << endl;
         return false;
     }
     
-    file >> word;
-    if(word != "NumFeatures:"){
+    if( !parser.matchWord("NumFeatures:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find NumFeatures " << endl;
         return false;
     }
-    file >> numFeatures;
+    parser >> numFeatures;
     
-    file >> word;
-    if(word != "NumClasses:"){
+    if( !parser.matchWord("NumClasses:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find NumClasses" << endl;
         return false;
     }
-    file >> numClasses;
+    parser >> numClasses;
     
-    file >> word;
-    if(word != "UseScaling:"){
+    if( !parser.matchWord("UseScaling:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find UseScaling" << endl;
         return false;
     }
-    file >> useScaling;
+    parser >> useScaling;
     
-    file >> word;
-    if(word != "UseNullRejection:"){
+    if( !parser.matchWord("UseNullRejection:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find UseNullRejection" << endl;
         return false;
     }
-    file >> useNullRejection;
+    parser >> useNullRejection;
     
     ///Read the ranges if needed
     if( useScaling ){
         //Resize the ranges buffer
         ranges.resize(numFeatures);
         
-        file >> word;
-        if(word != "Ranges:"){
+        if( !parser.matchWord("Ranges:") ){
             errorLog << "loadModelFromFile(string filename) - Could not find the Ranges" << endl;
             return false;
         }
         for(UINT n=0; n<ranges.size(); n++){
-            file >> ranges[n].minValue;
-            file >> ranges[n].maxValue;
+            parser >> ranges[n].minValue;
+            parser >> ranges[n].maxValue;
         }
     }
     
@@ -373,50 +394,43 @@ bool MinDist::loadModelFromFile(fstream &file){
         double trainingSigma;
         double trainingMu;
         
-        file >> word;
-        if( word != "ClassLabel:" ){
+        if( !parser.matchWord("ClassLabel:") ){
             errorLog << "loadModelFromFile(string filename) - Could not load the class label for class " << k << endl;
             return false;
         }
-        file >> classLabels[k];
+        parser >> classLabels[k];
         
-        file >> word;
-        if( word != "NumClusters:" ){
+        if( !parser.matchWord("NumClusters:") ){
             errorLog << "loadModelFromFile(string filename) - Could not load the NumClusters for class " << k << endl;
             return false;
         }
-        file >> numClusters;
+        parser >> numClusters;
         
-        file >> word;
-        if( word != "RejectionThreshold:" ){
+        if( !parser.matchWord("RejectionThreshold:") ){
             errorLog << "loadModelFromFile(string filename) - Could not load the RejectionThreshold for class " << k << endl;
             return false;
         }
-        file >> rejectionThreshold;
+        parser >> rejectionThreshold;
         
-        file >> word;
-        if( word != "Gamma:" ){
+        if( !parser.matchWord("Gamma:") ){
             errorLog << "loadModelFromFile(string filename) - Could not load the Gamma for class " << k << endl;
             return false;
         }
-        file >> gamma;
+        parser >> gamma;
         
-        file >> word;
-        if( word != "TrainingMu:" ){
+        if( !parser.matchWord("TrainingMu:") ){
             errorLog << "loadModelFromFile(string filename) - Could not load the TrainingMu for class " << k << endl;
             return false;
         }
-        file >> trainingMu;
+        parser >> trainingMu;
         
-        file >> word;
-        if( word != "TrainingSigma:" ){
+        if( !parser.matchWord("TrainingSigma:") ){
             errorLog << "loadModelFromFile(string filename) - Could not load the TrainingSigma for class " << k << endl;
             return false;
         }
-        file >> trainingSigma;
+        parser >> trainingSigma;
 
-        file >> word;
-        if( word != "ClusterData:" ){
+        if( !parser.matchWord("ClusterData:") ){
             errorLog << "loadModelFromFile(string filename) - Could not load the ClusterData for class " << k << endl;
             return false;
         }
@@ -425,7 +439,7 @@ bool MinDist::loadModelFromFile(fstream &file){
         MatrixDouble clusters(numClusters,numFeatures);
         for(UINT i=0; i<numClusters; i++){
             for(UINT j=0; j<numFeatures; j++){
-                file >> clusters[i][j];
+                parser >> clusters[i][j];
             }
         }
 
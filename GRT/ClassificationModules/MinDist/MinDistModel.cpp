@@ -42,6 +42,7 @@ MinDistModel& MinDistModel:: operator=(const MinDistModel &rhs){
 		this->trainingMu = rhs.trainingMu;
 		this->trainingSigma = rhs.trainingSigma;
 		this->clusters = rhs.clusters;
+		this->distanceKernel = rhs.distanceKernel;
 	}
 	return *this;
 }
@@ -67,6 +68,7 @@ bool MinDistModel::train(UINT classLabel,MatrixDouble &trainingData,UINT numClus
 	}
 	
 	clusters = kmeans.getClusters();
+	distanceKernel.setClusters( clusters );
     
 	//Compute the rejection thresholds
 	rejectionThreshold = 0;
@@ -102,31 +104,20 @@ bool MinDistModel::train(UINT classLabel,MatrixDouble &trainingData,UINT numClus
 	
 }
 
-double MinDistModel::predict(const VectorDouble &inputVector){
+double MinDistModel::predict(const VectorDouble &inputVector) const{
 	
-	double minDist = numeric_limits<double>::max();
-	double dist = 0;
-	
-	for(UINT k=0; k<numClusters; k++){
-		dist = 0;
-        for(UINT n=0; n<numFeatures; n++){
-            dist += SQR( clusters[k][n]-inputVector[n] );
-        }
-		if( dist < minDist )
-			minDist = dist;
-	}
+	double minDist = 0;
+	distanceKernel.findNearestCluster( &inputVector[0], minDist );
     
     //Only compute the sqrt for the minimum distance
 	return sqrt( minDist );
-     
-    return minDist;
 }
 	
 void MinDistModel::recomputeThresholdValue(){
 	rejectionThreshold = trainingMu+(trainingSigma*gamma);
 }
 	
-UINT MinDistModel::getClassLabel(){
+UINT MinDistModel::getClassLabel() const{
 	return classLabel;
 }
 
@@ -138,7 +129,7 @@ UINT MinDistModel::getNumClusters(){
 	return numClusters;
 }
     
-double MinDistModel::getRejectionThreshold(){
+double MinDistModel::getRejectionThreshold() const{
     return rejectionThreshold;
 }
 
@@ -165,6 +156,7 @@ bool MinDistModel::setClassLabel(UINT classLabel){
 
 bool MinDistModel::setClusters(MatrixDouble &clusters){
     this->clusters = clusters;
+	this->distanceKernel.setClusters( clusters );
 	this->numClusters = clusters.getNumRows();
 	this->numFeatures = clusters.getNumCols();
     return true;
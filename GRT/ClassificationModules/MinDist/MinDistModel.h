@@ -31,6 +31,7 @@
 
 #include "../../Util/GRTCommon.h"
 #include "../../ClusteringModules/KMeans/KMeans.h"
+#include "../../Util/SquaredDistanceKernel.h"
 
 namespace GRT{
 
@@ -57,14 +58,14 @@ public:
 	MinDistModel &operator=(const MinDistModel &rhs);
 	
 	bool train(UINT classLabel,MatrixDouble &trainingData,UINT numClusters);
-	double predict(const VectorDouble &observation);
+	double predict(const VectorDouble &observation) const;
 	void recomputeThresholdValue();
 	
-	UINT getClassLabel();
+	UINT getClassLabel() const;
 	UINT getNumFeatures();
 	UINT getNumClusters();
 	UINT getDistanceMode();
-    double getRejectionThreshold();
+    double getRejectionThreshold() const;
     double getGamma();
     double getTrainingMu();
     double getTrainingSigma();
@@ -87,6 +88,7 @@ private:
 	double trainingMu;			//The average confidence value in the training data
 	double trainingSigma;		//The simga confidence value in the training data
 	MatrixDouble clusters;
+	SquaredDistanceKernel distanceKernel;	//Holds the clusters and their precomputed norms for fast prediction
 };
 
 } //End of namespace GRT
@@ -55,6 +55,7 @@ SVM::SVM(UINT kernelType,UINT svmType,bool useScaling,bool useNullRejection,bool
     classificationThreshold = 0.5;
 	crossValidationResult = 0;
     
+    statelessPrediction = true;
     classifierType = "SVM";
     classifierMode = STANDARD_CLASSIFIER_MODE;
     debugLog.setProceedingText("[DEBUG SVM]");
@@ -165,12 +166,12 @@ bool SVM::predict(VectorDouble inputVector){
     }
     
     if( param.probability == 1 ){
-        if( !predict_( inputVector, maxLikelihood, classLikelihoods ) ){
+        if( !predict_( inputVector, predictedClassLabel, maxLikelihood, classLikelihoods ) ){
             errorLog << "predict(VectorDouble inputVector) - Prediction Failed!" << endl;
             return false;
         }
     }else{
-        if( !predict_( inputVector ) ){
+        if( !predict_( inputVector, predictedClassLabel ) ){
             errorLog << "predict(VectorDouble inputVector) - Prediction Failed!" << endl;
             return false;
         }
@@ -178,6 +179,38 @@ bool SVM::predict(VectorDouble inputVector){
     
     return true;
 }
+
+bool SVM::predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const{
+    
+    if( !trained ){
+        errorLog << "predictStateless(const VectorDouble &inputVector,ClassificationResult &result) - The SVM model has not been trained!" << endl;
+        return false;
+    }
+    
+    if( inputVector.size() != numFeatures ){
+        errorLog << "predictStateless(const VectorDouble &inputVector,ClassificationResult &result) - The size of the input vector (" << inputVector.size() << ") does not match the number of features of the model (" << numFeatures << ")" << endl;
+        return false;
+    }
+    
+    VectorDouble x = inputVector;
+    if( param.probability == 1 ){
+        if( !predict_( x, result.predictedClassLabel, result.maximumLikelihood, result.classLikelihoods ) ){
+            errorLog << "predictStateless(const VectorDouble &inputVector,ClassificationResult &result) - Prediction Failed!" << endl;
+            return false;
+        }
+    }else{
+        if( !predict_( x, result.predictedClassLabel ) ){
+            errorLog << "predictStateless(const VectorDouble &inputVector,ClassificationResult &result) - Prediction Failed!" << endl;
+            return false;
+        }
+        result.maximumLikelihood = 0;
+        result.classLikelihoods.clear();
+    }
+    result.unprocessedPredictedClassLabel = result.predictedClassLabel;
+    result.classDistances.clear();
+    
+    return true;
+}
     
 bool SVM::init(UINT kernelType,UINT svmType,bool useScaling,bool useNullRejection,bool useAutoGamma,double gamma,UINT degree,double coef0,double nu,double C,bool useCrossValidation,UINT kFoldValue){
     
@@ -349,7 +382,7 @@ bool SVM::trainSVM(){
 		return trained;
 }
     
-bool SVM::predict_(VectorDouble &inputVector){
+bool SVM::predict_(VectorDouble &inputVector,UINT &predictedLabel) const{
 
 		if( !trained || inputVector.size() != numFeatures ) return false;
 
@@ -375,7 +408,7 @@ bool SVM::predict_(VectorDouble &inputVector){
 		double predict_label = svm_predict(model,x);
 
         //We can't do null rejection without the probabilities, so just set the predicted class
-        predictedClassLabel = (UINT)predict_label;
+        predictedLabel = (UINT)predict_label;
 
 		//Clean up the memory
 		delete[] x;
@@ -383,7 +416,7 @@ bool SVM::predict_(VectorDouble &inputVector){
 		return true;
 }
 
-bool SVM::predict_(VectorDouble &inputVector,double &maxProbability, vector<double> &probabilites){
+bool SVM::predict_(VectorDouble &inputVector,UINT &predictedLabel,double &maxProbability, vector<double> &probabilites) const{
 
 		if( !trained || param.probability == 0 || inputVector.size() != numFeatures ) return false;
 
@@ -412,23 +445,22 @@ bool SVM::predict_(VectorDouble &inputVector,double &maxProbability, vector<doub
 		//Perform the SVM prediction
 		double predict_label = svm_predict_probability(model,x,prob_estimates);
 
-		predictedClassLabel = 0;
+		predictedLabel = 0;
 		maxProbability = 0;
 		probabilites.resize(model->nr_class);
 		for(int k=0; k<model->nr_class; k++){
 			if( maxProbability < prob_estimates[k] ){
 				maxProbability = prob_estimates[k];
-                predictedClassLabel = k+1;
-                maxLikelihood = maxProbability;
+                predictedLabel = k+1;
             }
 			probabilites[k] = prob_estimates[k];
 		}
 
-        if( !useNullRejection ) predictedClassLabel = (UINT)predict_label;
+        if( !useNullRejection ) predictedLabel = (UINT)predict_label;
         else{
             if( maxProbability >= classificationThreshold ){
-                predictedClassLabel = (UINT)predict_label;
-            }else predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
+                predictedLabel = (UINT)predict_label;
+            }else predictedLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
         }
 
 		//Clean up the memory
@@ -648,6 +680,8 @@ bool SVM::loadModelFromFile(fstream &file){
             errorLog << "loadModelFromFile(fstream &file) - The file is not open!" << endl;
             return false;
         }
+
+        FileTokenizer parser( file );
         
         //Init the memory for the model
         model = new svm_model;
@@ -682,21 +716,19 @@ bool SVM::loadModelFromFile(fstream &file){
         model->param.probability = 1;
         
         //Check to make sure this is a file with the correct File Format
-        file >> word;
-        if(word != "SVM_MODEL_FILE_V1.0"){
+        if( !parser.matchWord("SVM_MODEL_FILE_V1.0") ){
             errorLog << "loadModelFromFile(fstream &file) - Invalid file format!" << endl;
             clear();
             return false;
         }
         
         //Load the model type
-        file >> word;
-        if(word != "ModelType:"){
+        if( !parser.matchWord("ModelType:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find ModelType header!" << endl;
             clear();
             return false;
         }
-        file >> word;
+        parser >> word;
         if( word == "C_SVC" ){
             model->param.svm_type = C_SVC;
         }else{
@@ -722,13 +754,12 @@ bool SVM::loadModelFromFile(fstream &file){
         }
         
         //Load the model type
-        file >> word;
-        if(word != "KernelType:"){
+        if( !parser.matchWord("KernelType:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find kernel type!" << endl;
             clear();
             return false;
         }
-        file >> word;
+        parser >> word;
         if( word == "LINEAR" ){
             model->param.kernel_type = LINEAR;
         }else{
@@ -754,89 +785,79 @@ bool SVM::loadModelFromFile(fstream &file){
         }
         
         //Load the degree
-        file >> word;
-        if(word != "Degree:"){
+        if( !parser.matchWord("Degree:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Degree header!" << endl;
             clear();
             return false;
         }
-        file >> model->param.degree;
+        parser >> model->param.degree;
         
         //Load the gamma
-        file >> word;
-        if(word != "Gamma:"){
+        if( !parser.matchWord("Gamma:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Gamma header!" << endl;
             clear();
             return false;
         }
-        file >> model->param.gamma;
+        parser >> model->param.gamma;
         
         //Load the Coef0
-        file >> word;
-        if(word != "Coef0:"){
+        if( !parser.matchWord("Coef0:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Coef0 header!" << endl;
             clear();
             return false;
         }
-        file >> model->param.coef0;
+        parser >> model->param.coef0;
         
         //Load the NumberOfClasses
-        file >> word;
-        if(word != "NumberOfClasses:"){
+        if( !parser.matchWord("NumberOfClasses:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find NumberOfClasses header!" << endl;
             clear();
             return false;
         }
-        file >> numClasses;
+        parser >> numClasses;
         
         //Load the NumberOfSupportVectors
-        file >> word;
-        if(word != "NumberOfSupportVectors:"){
+        if( !parser.matchWord("NumberOfSupportVectors:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find NumberOfSupportVectors header!" << endl;
             clear();
             return false;
         }
-        file >> numSV;
+        parser >> numSV;
         
         //Load the NumberOfFeatures
-        file >> word;
-        if(word != "NumberOfFeatures:"){
+        if( !parser.matchWord("NumberOfFeatures:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find NumberOfFeatures header!" << endl;
             clear();
             return false;
         }
-        file >> numFeatures;
+        parser >> numFeatures;
         
         //Load the UseShrinking
-        file >> word;
-        if(word != "UseShrinking:"){
+        if( !parser.matchWord("UseShrinking:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find UseShrinking header!" << endl;
             clear();
             return false;
         }
-        file >> model->param.shrinking;
+        parser >> model->param.shrinking;
         
         //Load the UseProbability
-        file >> word;
-        if(word != "UseProbability:"){
+        if( !parser.matchWord("UseProbability:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find UseProbability header!" << endl;
             clear();
             return false;
         }
-        file >> model->param.probability;
+        parser >> model->param.probability;
         
         //Load the UseScaling
-        file >> word;
-        if(word != "UseScaling:"){
+        if( !parser.matchWord("UseScaling:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find UseScaling header!" << endl;
             clear();
             return false;
         }
-        file >> useScaling;
+        parser >> useScaling;
         
         //Load the Ranges
-        file >> word;
-        if(word != "Ranges:"){
+        if( !parser.matchWord("Ranges:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Ranges header!" << endl;
             clear();
             return false;
@@ -847,8 +868,8 @@ bool SVM::loadModelFromFile(fstream &file){
         
         ///Load the ranges
         for(UINT i=0; i<ranges.size(); i++){
-            file >> ranges[i].minValue;
-            file >> ranges[i].maxValue;
+            parser >> ranges[i].minValue;
+            parser >> ranges[i].maxValue;
         }
         
         //Setup the values
@@ -857,24 +878,23 @@ bool SVM::loadModelFromFile(fstream &file){
         model->l = numSV;
         
         //Load the RHO
-        file >> word;
-        if(word != "RHO:"){
+        if( !parser.matchWord("RHO:") ){
             errorLog << "loadModelFromFile(fstream &file) - Failed to find RHO header!" << endl;
             clear();
             return false;
         }
         model->rho = new double[ halfNumClasses ];
-        for(UINT i=0;i<numClasses*(numClasses-1)/2;i++) file >> model->rho[i];
+        for(UINT i=0;i<numClasses*(numClasses-1)/2;i++) parser >> model->rho[i];
         
         //See if we can load the Labels
-        file >> word;
+        parser >> word;
         if(word != "Label:"){
             model->label = NULL;
         }else{
             model->label = new int[ numClasses ];
-            for(UINT i=0;i<numClasses;i++) file >> model->label[i];
+            for(UINT i=0;i<numClasses;i++) parser >> model->label[i];
             //We only need to read a new line if we found the label!
-            file >> word;
+            parser >> word;
         }
         
         //See if we can load the ProbA
@@ -883,9 +903,9 @@ bool SVM::loadModelFromFile(fstream &file){
             model->probA = NULL;
         }else{
             model->probA = new double[ halfNumClasses ];
-            for(UINT i=0;i<numClasses*(numClasses-1)/2;i++) file >> model->probA[i];
+            for(UINT i=0;i<numClasses*(numClasses-1)/2;i++) parser >> model->probA[i];
             //We only need to read a new line if we found the label!
-            file >> word;
+            parser >> word;
         }
         
         //See if we can load the ProbB
@@ -894,9 +914,9 @@ bool SVM::loadModelFromFile(fstream &file){
             model->probB = NULL;
         }else{
             model->probB = new double[ halfNumClasses ];
-            for(UINT i=0;i<numClasses*(numClasses-1)/2;i++) file >> model->probB[i];
+            for(UINT i=0;i<numClasses*(numClasses-1)/2;i++) parser >> model->probB[i];
             //We only need to read a new line if we found the label!
-            file >> word;
+            parser >> word;
         }
         
         //See if we can load the NumSupportVectorsPerClass
@@ -905,9 +925,9 @@ bool SVM::loadModelFromFile(fstream &file){
             model->nSV = NULL;
         }else{
             model->nSV = new int[ numClasses ];
-            for(UINT i=0;i<numClasses;i++) file >> model->nSV[i];
+            for(UINT i=0;i<numClasses;i++) parser >> model->nSV[i];
             //We only need to read a new line if we found the label!
-            file >> word;
+            parser >> word;
         }
         
         //Load the SupportVectors
@@ -925,16 +945,16 @@ bool SVM::loadModelFromFile(fstream &file){
         
         for(UINT i=0; i<numSV; i++){
             for(UINT j=0; j<numClasses-1; j++){
-                file >> model->sv_coef[j][i];
+                parser >> model->sv_coef[j][i];
             }
             
             model->SV[i] = new svm_node[numFeatures+1];
             
-            if(model->param.kernel_type == PRECOMPUTED) file >> model->SV[i][0].value;
+            if(model->param.kernel_type == PRECOMPUTED) parser >> model->SV[i][0].value;
             else{
                 for(UINT j=0; j<numFeatures; j++){
-                    file >> model->SV[i][j].index;
-                    file >> model->SV[i][j].value;
+                    parser >> model->SV[i][j].index;
+                    parser >> model->SV[i][j].value;
                 }
                 model->SV[i][numFeatures].index = -1; //Assign the final node value
                 model->SV[i][numFeatures].value = 0;
@@ -94,6 +94,9 @@ public:
      */
     virtual bool deepCopyFrom(const Classifier *classifier);
     
+    //Keeps the train overloads this class does not override (such as training from a view) visible
+    using MLBase::train;
+    
     /**
      This trains the SVM model, using the labelled classification data.
      This overrides the train function in the Classifier base class.
@@ -112,6 +115,16 @@ public:
      */
     virtual bool predict(VectorDouble inputVector);
     
+    /**
+     This predicts the class of the inputVector without changing the state of the classifier, so a trained model can be shared by many threads.
+     This overrides the predictStateless function in the Classifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassificationResult &result: returns the results of the prediction
+     @return returns true if the prediction was performed, false otherwise
+     */
+    virtual bool predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const;
+    
     /**
      This saves the trained SVM model to a file.
      This overrides the saveModelToFile function in the Classifier base class.
@@ -354,8 +367,8 @@ protected:
     bool convertLabelledClassificationDataToLIBSVMFormat(LabelledClassificationData &trainingData);
 	bool trainSVM();
     
-	bool predict_(VectorDouble &inputVector);
-	bool predict_(VectorDouble &inputVector,double &maxProbability, vector<double> &probabilites);
+	bool predict_(VectorDouble &inputVector,UINT &predictedLabel) const;
+	bool predict_(VectorDouble &inputVector,UINT &predictedLabel,double &maxProbability, vector<double> &probabilites) const;
     
 	bool problemSet;
 	struct svm_model *model;
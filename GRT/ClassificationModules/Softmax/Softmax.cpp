@@ -25,12 +25,41 @@ namespace GRT{
 //Register the Softmax module with the Classifier base class
 RegisterClassifierModule< Softmax >  Softmax::registerModule("Softmax");
 
+//Trains the softmax model for each class in the range [startIndex endIndex-1], the samples of the class are relabelled as
+//positive samples (with label 1.0) and all the other samples as negative samples (with label 0.0)
+class SoftmaxTrainingTask{
+public:
+    SoftmaxTrainingTask(const LinearModelTrainer &trainer,const vector< UINT > &sampleLabels,const vector< UINT > &classLabels,vector< SoftmaxModel > &models,vector< VectorDouble > &epochErrors,vector< UINT > &modelTrained):
+    trainer(trainer),sampleLabels(sampleLabels),classLabels(classLabels),models(models),epochErrors(epochErrors),modelTrained(modelTrained){}
+    
+    void operator()(const UINT startIndex,const UINT endIndex,const UINT threadIndex){
+        const UINT M = (UINT)sampleLabels.size();
+        VectorDouble y(M);
+        for(UINT k=startIndex; k<endIndex; k++){
+            for(UINT i=0; i<M; i++){
+                y[i] = sampleLabels[i]==classLabels[k] ? 1.0 : 0;
+            }
+            models[k].init( classLabels[k], trainer.getNumDimensions() );
+            modelTrained[k] = trainer.train( y, models[k].w, models[k].w0, epochErrors[k] ) ? 1 : 0;
+        }
+    }
+    
+    const LinearModelTrainer &trainer;
+    const vector< UINT > &sampleLabels;
+    const vector< UINT > &classLabels;
+    vector< SoftmaxModel > &models;
+    vector< VectorDouble > &epochErrors;
+    vector< UINT > &modelTrained;
+};
+
 Softmax::Softmax(bool useScaling)
 {
     this->useScaling = useScaling;
     minChange = 1.0e-10;
     maxNumIterations = 1000;
     learningRate = 0.01;
+    batchSize = 1;
+    statelessPrediction = true;
     classifierType = "Softmax";
     classifierMode = STANDARD_CLASSIFIER_MODE;
     debugLog.setProceedingText("[DEBUG Softmax]");
@@ -48,6 +77,7 @@ Softmax& Softmax::operator=(const Softmax &rhs){
         this->learningRate = rhs.learningRate;
         this->minChange = rhs.minChange;
         this->maxNumIterations = rhs.maxNumIterations;
+        this->batchSize = rhs.batchSize;
         this->models = rhs.models;
         
         //Copy the base classifier variables
@@ -66,6 +96,7 @@ bool Softmax::deepCopyFrom(const Classifier *classifier){
         this->learningRate = ptr->learningRate;
         this->minChange = ptr->minChange;
         this->maxNumIterations = ptr->maxNumIterations;
+        this->batchSize = ptr->batchSize;
         this->models = ptr->models;
         
         //Copy the base classifier variables
@@ -76,9 +107,25 @@ bool Softmax::deepCopyFrom(const Classifier *classifier){
 
 bool Softmax::train(LabelledClassificationData trainingData){
     
-    const unsigned int M = trainingData.getNumSamples();
-    const unsigned int N = trainingData.getNumDimensions();
-    const unsigned int K = trainingData.getNumClasses();
+    //Copy the samples into one flat buffer, this is scaled (if needed) and then packed straight into the trainer
+    FlatClassificationData data( trainingData );
+    
+    return train_( data, trainingData.getRanges() );
+}
+    
+bool Softmax::train(const LabelledClassificationDataView &trainingData){
+    
+    //The samples in the view are copied straight into the flat buffer
+    FlatClassificationData data( trainingData );
+    
+    return train_( data, trainingData.getRanges() );
+}
+    
+bool Softmax::train_(FlatClassificationData &data,const vector< MinMax > &dataRanges){
+    
+    const unsigned int M = data.getNumSamples();
+    const unsigned int N = data.getNumDimensions();
+    const unsigned int K = data.getNumClasses();
     trained = false;
     models.clear();
     classLabels.clear();
@@ -92,17 +139,46 @@ bool Softmax::train(LabelledClassificationData trainingData){
     numClasses = K;
     models.resize(K);
     classLabels.resize(K);
-    ranges = trainingData.getRanges();
+    ranges = dataRanges;
+    
+    //Scale the training data if needed, so it matches the scaling applied in predict
+    if( useScaling ){
+        data.scale(ranges,0,1);
+    }
+    
+    //Pack the training data into the trainer, this is shared by all the class models
+    LinearModelTrainer trainer;
+    trainer.setOutputFunction( LinearModelTrainer::SIGMOID_OUTPUT );
+    trainer.setErrorMeasure( LinearModelTrainer::SUM_OF_ERRORS );
+    trainer.setLearningRate( learningRate );
+    trainer.setMinChange( minChange );
+    trainer.setMaxNumIterations( maxNumIterations );
+    trainer.setBatchSize( batchSize );
+    if( !trainer.setTrainingData( data.getData(), M, N ) ){
+        errorLog << "train(LabelledClassificationData labelledTrainingData) - Failed to set the training data!" << endl;
+        return false;
+    }
     
-    //Train a regression model for each class in the training data
+    const vector< UINT > &sampleLabels = data.getSampleClassLabels();
     for(UINT k=0; k<numClasses; k++){
+        classLabels[k] = data.getClassTracker()[k].classLabel;
+    }
+    
+    //Train a regression model for each class in the training data, the models are independent so they are trained in parallel
+    vector< VectorDouble > epochErrors(K);
+    vector< UINT > modelTrained(K,0);
+    SoftmaxTrainingTask task( trainer, sampleLabels, classLabels, models, epochErrors, modelTrained );
+    ParallelFor::run( K, task );
+    
+    for(UINT k=0; k<numClasses; k++){
+        for(UINT iter=0; iter<epochErrors[k].size(); iter++){
+            const double delta = fabs( epochErrors[k][iter] - (iter > 0 ? epochErrors[k][iter-1] : 0) );
+            trainingLog << "Class: " << classLabels[k] << " Epoch: " << iter+1 << " TotalError: " << epochErrors[k][iter] << " Delta: " << delta << endl;
+        }
         
-        //Set the class label
-        classLabels[k] = trainingData.getClassTracker()[k].classLabel;
-        
-        //Train the model
-        if( !trainSoftmaxModel(classLabels[k],models[k],trainingData) ){
+        if( !modelTrained[k] ){
             errorLog << "train(LabelledClassificationData labelledTrainingData) - Failed to train model for class: " << classLabels[k] << endl;
+            models.clear();
             return false;
         }
     }
@@ -113,14 +189,27 @@ bool Softmax::train(LabelledClassificationData trainingData){
 }
 
 bool Softmax::predict(VectorDouble inputVector){
+    return predict_( inputVector, predictedClassLabel, maxLikelihood, classLikelihoods, classDistances );
+}
+
+bool Softmax::predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const{
+    VectorDouble x = inputVector;
+    if( !predict_( x, result.predictedClassLabel, result.maximumLikelihood, result.classLikelihoods, result.classDistances ) ){
+        return false;
+    }
+    result.unprocessedPredictedClassLabel = result.predictedClassLabel;
+    return true;
+}
+
+bool Softmax::predict_(VectorDouble &inputVector,UINT &predictedLabel,double &maximumLikelihood,VectorDouble &likelihoods,VectorDouble &distances) const{
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
         return false;
     }
     
-    predictedClassLabel = 0;
-	maxLikelihood = -10000;
+    predictedLabel = 0;
+	maximumLikelihood = -10000;
     
     if( !trained ) return false;
     
@@ -135,8 +224,8 @@ bool Softmax::predict(VectorDouble inputVector){
         }
     }
     
-    if( classLikelihoods.size() != numClasses ) classLikelihoods.resize(numClasses,0);
-    if( classDistances.size() != numClasses ) classDistances.resize(numClasses,0);
+    if( likelihoods.size() != numClasses ) likelihoods.resize(numClasses,0);
+    if( distances.size() != numClasses ) distances.resize(numClasses,0);
     
     //Loop over each class and compute the likelihood of the input data coming from class k. Pick the class with the highest likelihood
     double sum = 0;
@@ -150,93 +239,23 @@ bool Softmax::predict(VectorDouble inputVector){
             bestIndex = k;
         }
         
-        classDistances[k] = estimate;
-        classLikelihoods[k] = estimate;
+        distances[k] = estimate;
+        likelihoods[k] = estimate;
         sum += estimate;
     }
     
     if( sum > 1.0e-5 ){
         for(UINT k=0; k<numClasses; k++){
-            classLikelihoods[k] /= sum;
+            likelihoods[k] /= sum;
         }
     }else{
         //If the sum is less than the value above then none of the models found a positive class
-        maxLikelihood = bestEstimate;
-        predictedClassLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
+        maximumLikelihood = bestEstimate;
+        predictedLabel = GRT_DEFAULT_NULL_CLASS_LABEL;
         return true;
     }
-    maxLikelihood = classLikelihoods[bestIndex];
-    predictedClassLabel = classLabels[bestIndex];
-    
-    return true;
-}
-    
-bool Softmax::trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,LabelledClassificationData &data){
-    
-    double error = 0;
-    double errorSum = 0;
-    double lastErrorSum = 0;
-    double delta = 0;
-    UINT N = data.getNumDimensions();
-    UINT M = data.getNumSamples();
-    UINT iter = 0;
-    bool keepTraining = true;
-    Random random;
-    VectorDouble y(M);
-    vector< UINT > randomTrainingOrder(M);
-    
-    //Init the model
-    model.init( classLabel,  N );
-    
-    //Setup the target vector, the input data is relabelled as positive samples (with label 1.0) and negative samples (with label 0.0)
-    for(UINT i=0; i<M; i++){
-        y[i] = data[i].getClassLabel()==classLabel ? 1.0 : 0;
-    }
-    
-    //In most cases, the training data is grouped into classes (100 samples for class 1, followed by 100 samples for class 2, etc.)
-    //This can cause a problem for stochastic gradient descent algorithm. To avoid this issue, we randomly shuffle the order of the
-    //training samples. This random order is then used at each epoch.
-    for(UINT i=0; i<M; i++){
-        randomTrainingOrder[i] = i;
-    }
-    std::random_shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
-    
-    //Run the main stochastic gradient descent training algorithm
-    while( keepTraining ){
-        
-        //Run one epoch of training using stochastic gradient descent
-        errorSum = 0;
-        for(UINT m=0; m<M; m++){
-            
-            //Select the random sample
-            UINT i = randomTrainingOrder[m];
-            
-            //Compute the error, given the current weights
-            error = y[i] - model.compute( data[i].getSample() );
-            errorSum += error;
-            
-            //Update the weights
-            for(UINT j=0; j<N; j++){
-                model.w[j] += learningRate  * error * data[i][j];
-            }
-            model.w0 += learningRate  * error;
-        }
-        
-        //Compute the error
-        delta = fabs( errorSum-lastErrorSum );
-        lastErrorSum = errorSum;
-        
-        //Check to see if we should stop
-        if( delta <= minChange ){
-            keepTraining = false;
-        }
-        
-        if( ++iter >= maxNumIterations ){
-            keepTraining = false;
-        }
-        
-        trainingLog << "Epoch: " << iter << " TotalError: " << errorSum << " Delta: " << delta << endl;
-    }
+    maximumLikelihood = likelihoods[bestIndex];
+    predictedLabel = classLabels[bestIndex];
     
     return true;
 }
@@ -321,57 +340,51 @@ bool Softmax::loadModelFromFile(fstream &file){
         errorLog << "loadModelFromFile(string filename) - Could not open file to load model" << endl;
         return false;
     }
-    
-    std::string word;
+
+    FileTokenizer parser( file );
     
     //Find the file type header
-    file >> word;
-    if(word != "GRT_SOFTMAX_MODEL_FILE_V1.0"){
+    if( !parser.matchWord("GRT_SOFTMAX_MODEL_FILE_V1.0") ){
         errorLog << "loadModelFromFile(string filename) - Could not find Model File Header" << endl;
         return false;
     }
     
-    file >> word;
-    if(word != "NumFeatures:"){
+    if( !parser.matchWord("NumFeatures:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find NumFeatures!" << endl;
         return false;
     }
-    file >> numFeatures;
+    parser >> numFeatures;
     
-    file >> word;
-    if(word != "NumClasses:"){
+    if( !parser.matchWord("NumClasses:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find NumClasses!" << endl;
         return false;
     }
-    file >> numClasses;
+    parser >> numClasses;
     
-    file >> word;
-    if(word != "UseScaling:"){
+    if( !parser.matchWord("UseScaling:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find UseScaling!" << endl;
         return false;
     }
-    file >> useScaling;
+    parser >> useScaling;
     
-    file >> word;
-    if(word != "UseNullRejection:"){
+    if( !parser.matchWord("UseNullRejection:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find UseNullRejection!" << endl;
         return false;
     }
-    file >> useNullRejection;
+    parser >> useNullRejection;
     
     ///Read the ranges if needed
     if( useScaling ){
         //Resize the ranges buffer
         ranges.resize(numFeatures);
         
-        file >> word;
-        if(word != "Ranges:"){
+        if( !parser.matchWord("Ranges:") ){
             errorLog << "loadModelFromFile(string filename) - Could not find the Ranges!" << endl;
             return false;
         }
         for(UINT n=0; n<ranges.size(); n++){
-            file >> ranges[n].minValue;
-            file >> ranges[n].maxValue;
+            parser >> ranges[n].minValue;
+            parser >> ranges[n].maxValue;
         }
     }
     
@@ -380,32 +393,29 @@ bool Softmax::loadModelFromFile(fstream &file){
     classLabels.resize(numClasses);
     
     //Load the models
-    file >> word;
-    if(word != "Models:"){
+    if( !parser.matchWord("Models:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find the Models!" << endl;
         return false;
     }
     
     for(UINT k=0; k<numClasses; k++){
-        file >> word;
-        if(word != "ClassLabel:"){
+        if( !parser.matchWord("ClassLabel:") ){
             errorLog << "loadModelFromFile(string filename) - Could not find the ClassLabel for model: " << k << "!" << endl;
             return false;
         }
-        file >> models[k].classLabel;
+        parser >> models[k].classLabel;
         classLabels[k] = models[k].classLabel;
         
-        file >> word;
-        if(word != "Weights:"){
+        if( !parser.matchWord("Weights:") ){
             errorLog << "loadModelFromFile(string filename) - Could not find the Weights for model: " << k << "!" << endl;
             return false;
         }
-        file >>  models[k].w0;
+        parser >> models[k].w0;
         
 		models[k].N = numFeatures;
         models[k].w.resize( numFeatures );
         for(UINT n=0; n<numFeatures; n++){
-            file >> models[k].w[n];
+            parser >> models[k].w[n];
         }
     }
     
@@ -448,6 +458,14 @@ bool Softmax::setMaxNumIterations(UINT maxNumIterations){
     return false;
 }
 
+bool Softmax::setBatchSize(UINT batchSize){
+    if( batchSize > 0 ){
+        this->batchSize = batchSize;
+        return true;
+    }
+    return false;
+}
+
 double Softmax::getLearningRate(){
     return learningRate;
 }
@@ -460,6 +478,10 @@ UINT Softmax::getMaxNumIterations(){
     return maxNumIterations;
 }
     
+UINT Softmax::getBatchSize(){
+    return batchSize;
+}
+    
 vector< SoftmaxModel > Softmax::getModels(){
     return models;
 }
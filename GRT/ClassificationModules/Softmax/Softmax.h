@@ -31,6 +31,9 @@
 #define GRT_SOFTMAX_HEADER
 
 #include "../../GestureRecognitionPipeline/Classifier.h"
+#include "../../DataStructures/FlatClassificationData.h"
+#include "../../Util/LinearModelTrainer.h"
+#include "../../Util/ParallelFor.h"
 #include "SoftmaxModel.h"
 
 namespace GRT{
@@ -76,6 +79,15 @@ public:
     */
     virtual bool train(LabelledClassificationData trainingData);
     
+    /**
+     This trains the Softmax model directly from a view of the labelled classification data.
+     The samples in the view are copied straight into a flat buffer, so the view is never expanded into a full copy of the dataset.
+     
+     @param const LabelledClassificationDataView &trainingData: a view of the training data
+     @return returns true if the Softmax model was trained, false otherwise
+     */
+    virtual bool train(const LabelledClassificationDataView &trainingData);
+    
     /**
      This predicts the class of the inputVector.
      This overrides the predict function in the Classifier base class.
@@ -84,6 +96,16 @@ public:
      @return returns true if the prediction was performed, false otherwise
     */
     virtual bool predict(VectorDouble inputVector);
+
+    /**
+     This predicts the class of the inputVector without changing the state of the classifier, so a trained model can be shared by many threads.
+     This overrides the predictStateless function in the Classifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassificationResult &result: returns the results of the prediction
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const;
     
     /**
      This saves the trained Softmax model to a file.
@@ -148,6 +170,16 @@ public:
      */
     bool setMaxNumIterations(UINT maxNumIterations);
     
+    /**
+     Sets the number of samples used for each gradient step during the training phase. With a batch size of 1 (the default)
+     the weights are updated after every sample, with a larger batch size the weights are updated with the mean gradient of each batch.
+     The batchSize value must be greater than zero.
+     
+     @param UINT batchSize: the number of samples in each batch, must be greater than zero
+     @return returns true if the value was updated successfully, false otherwise
+     */
+    bool setBatchSize(UINT batchSize);
+    
     /**
      Gets the current learningRate value, this is value used to update the weights at each step of the stochastic gradient descent.
      
@@ -170,6 +202,13 @@ public:
      */
     UINT getMaxNumIterations();
     
+    /**
+     Gets the current batchSize value, this is the number of samples used for each gradient step during the training phase.
+     
+     @return returns the batchSize value
+     */
+    UINT getBatchSize();
+    
     /**
      Get the softmax models for each class. The Softmax class must be trained first.
      
@@ -178,11 +217,13 @@ public:
     vector< SoftmaxModel > getModels();
     
 private:
-    bool trainSoftmaxModel(UINT classLabel,SoftmaxModel &model,LabelledClassificationData &data);
-    
+    bool train_(FlatClassificationData &data,const vector< MinMax > &dataRanges);
+    bool predict_(VectorDouble &inputVector,UINT &predictedLabel,double &maximumLikelihood,VectorDouble &likelihoods,VectorDouble &distances) const;
+
     double learningRate;
     double minChange;
     UINT maxNumIterations;
+    UINT batchSize;
     
     vector< SoftmaxModel > models;
     static RegisterClassifierModule< Softmax > registerModule;
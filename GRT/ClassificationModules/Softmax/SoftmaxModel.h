@@ -61,7 +61,7 @@ public:
         return true;
     }
     
-    double compute(const VectorDouble &x){
+    double compute(const VectorDouble &x) const{
         double sum = w0;
         for(UINT i=0; i<N; i++){
             sum += x[i]*w[i];
@@ -17,6 +17,10 @@ GaussianMixtureModels::GaussianMixtureModels(){
 GaussianMixtureModels::~GaussianMixtureModels(){}
 
 bool GaussianMixtureModels::train(UnlabelledClassificationData &trainingData,UINT K){
+    return train( trainingData.getDataAsMatrixDouble(), K );
+}
+
+bool GaussianMixtureModels::train(const MatrixDouble &trainingData,UINT K){
 
 	modelTrained = false;
     failed = false;
@@ -25,13 +29,13 @@ bool GaussianMixtureModels::train(UnlabelledClassificationData &trainingData,UIN
 	det.clear();
 	invSigma.clear();
 
-    if( trainingData.getNumSamples() == 0 ){
-        errorLog << "train(UnlabelledClassificationData &trainingData,unsigned int K) - Training Failed! Training data is empty!" << endl;
+    if( trainingData.getNumRows() == 0 ){
+        errorLog << "train(const MatrixDouble &trainingData,unsigned int K) - Training Failed! Training data is empty!" << endl;
         return false;
     }
 
 	//Set the training data
-	data = trainingData.getDataAsMatrixDouble();
+	data = trainingData;
 
 	//Resize the variables
 	M = data.getNumRows();
@@ -91,7 +95,7 @@ bool GaussianMixtureModels::train(UnlabelledClassificationData &trainingData,UIN
 	}
 
 	if( failed ){
-		errorLog << "train(UnlabelledClassificationData &trainingData,unsigned int K) - Training failed!" << endl;
+		errorLog << "train(const MatrixDouble &trainingData,unsigned int K) - Training failed!" << endl;
 		return modelTrained;
 	}
 
@@ -99,7 +103,7 @@ bool GaussianMixtureModels::train(UnlabelledClassificationData &trainingData,UIN
 	if( !computeInvAndDet() ){
         det.clear();
         invSigma.clear();
-        errorLog << "train(UnlabelledClassificationData &trainingData,unsigned int K) - Failed to compute inverse and determinat!" << endl;
+        errorLog << "train(const MatrixDouble &trainingData,unsigned int K) - Failed to compute inverse and determinat!" << endl;
         return false;
     }
 
@@ -35,6 +35,7 @@ public:
 	~GaussianMixtureModels(void);
 
 	bool train(UnlabelledClassificationData &trainingData,UINT K);
+	bool train(const MatrixDouble &trainingData,UINT K);
     bool getModelTrained(){ return modelTrained; }
     
     UINT getK(){ return K; }
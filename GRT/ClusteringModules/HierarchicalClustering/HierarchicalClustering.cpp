@@ -22,8 +22,44 @@
 
 namespace GRT{
 
+//Computes the squared Euclidean distance between every pair of samples and stores them in the condensed distance matrix.
+//Row i has M-i-1 distances, so each work item computes row t and row M-1-t to keep the work for each thread balanced
+class HierarchicalClusteringDistanceTask{
+public:
+    HierarchicalClusteringDistanceTask(const MatrixDouble &data,vector< float > &distanceMatrix):data(data),distanceMatrix(distanceMatrix){
+        M = data.getNumRows();
+        N = data.getNumCols();
+    }
+    
+    void operator()(const UINT startIndex,const UINT endIndex,const UINT threadIndex){
+        for(UINT t=startIndex; t<endIndex; t++){
+            computeRow( t );
+            if( M-1-t != t ) computeRow( M-1-t );
+        }
+    }
+    
+    void computeRow(const UINT i){
+        const double *a = data[i];
+        float *row = &distanceMatrix[0] + HierarchicalClustering::getCondensedIndex( M, i, i+1 );
+        for(UINT j=i+1; j<M; j++){
+            const double *b = data[j];
+            double dist = 0;
+            for(UINT n=0; n<N; n++){
+                dist += (a[n]-b[n])*(a[n]-b[n]);
+            }
+            *row++ = float( dist );
+        }
+    }
+    
+    const MatrixDouble &data;
+    vector< float > &distanceMatrix;
+    UINT M;
+    UINT N;
+};
+    
 HierarchicalClustering::HierarchicalClustering(){
     M = N = 0;
+    linkageMethod = SINGLE_LINKAGE;
     trained = false;
 }
 
@@ -85,19 +121,17 @@ bool HierarchicalClustering::train(MatrixDouble &data){
     M = data.getNumRows();
 	N = data.getNumCols();
     
-    //Build the distance matrix
-    distanceMatrix.resize(M,M);
-
-    //Build the distance matrix
-    for(UINT i=0; i<M; i++){
-        for(UINT j=0; j<M; j++){
-            if( i== j ) distanceMatrix[i][j] = numeric_limits<double>::max();
-            else{
-                distanceMatrix[i][j] = squaredEuclideanDistance(data[i], data[j]);
-            }
-        }
+    //Find the M-1 merges that build the hierarchy
+    vector< HierarchicalClusteringMerge > merges;
+    if( linkageMethod == SINGLE_LINKAGE ){
+        computeSingleLinkageMerges( data, merges );
+    }else{
+        computeNearestNeighbourChainMerges( data, merges );
     }
-
+    
+    //The merges are not found in order, so sort them by distance to get the levels of the hierarchy
+    std::stable_sort( merges.begin(), merges.end(), HierarchicalClusteringMerge::sortByDistance );
+    
     //Build the initial clusters, at the start each sample gets its own cluster
     UINT uniqueClusterID = 0;
     vector< ClusterInfo > clusterData(M);
@@ -110,110 +144,211 @@ bool HierarchicalClustering::train(MatrixDouble &data){
     UINT level = 0;
     ClusterLevel newLevel;
     newLevel.level = level;
+    newLevel.clusters = clusterData;
+    clusters.reserve( M );
+    clusters.push_back( newLevel );
+    
+    //Keep the sum and sum of squares of each cluster (relative to the mean of the data) so the variance of a merged cluster
+    //can be computed without revisiting its samples
+    VectorDouble mean = data.getMean();
+    MatrixDouble sum(M,N);
+    MatrixDouble sumSquares(M,N);
     for(UINT i=0; i<M; i++){
-        newLevel.clusters.push_back( clusterData[i] );
+        for(UINT j=0; j<N; j++){
+            const double x = data[i][j] - mean[j];
+            sum[i][j] = x;
+            sumSquares[i][j] = x*x;
+        }
     }
-    clusters.push_back( newLevel );
     
-    //Move to level 1 and start the search
-    level++;
-    bool keepClustering = true;
+    //Replay the merges in order. Each slot in a merge is one of the samples in that cluster, so a union-find
+    //structure is used to map each slot to the cluster it currently belongs to
+    vector< UINT > parent(M);
+    for(UINT i=0; i<M; i++) parent[i] = i;
     
-    while( keepClustering ){
+    for(UINT m=0; m<merges.size(); m++){
+        const UINT rootA = findRoot( merges[m].clusterA, parent );
+        const UINT rootB = findRoot( merges[m].clusterB, parent );
         
-        //Find the closest two clusters within the cluster data
-        double minDist = numeric_limits<double>::max();
-        vector< vector< UINT > > clusterPairs;
-        UINT K = (UINT)clusterData.size();
-        for(UINT i=0; i<K; i++){
-            for(UINT j=0; j<K; j++){
-                if( i != j ){
-                    double dist = computeClusterDistance( clusterData[i], clusterData[j]  );
-             
-                    if( dist < minDist ){
-                        minDist = dist;
-                        vector< UINT > clusterPair(2);
-                        clusterPair[0] = i;
-                        clusterPair[1] = j;
-                        clusterPairs.clear();
-                        clusterPairs.push_back( clusterPair );
-                    }
-                    
-                }
-            }
+        //Create the new cluster
+        ClusterInfo newCluster;
+        newCluster.uniqueClusterID = uniqueClusterID++;
+        newCluster.indexs.reserve( clusterData[rootA].getNumSamplesInCluster() + clusterData[rootB].getNumSamplesInCluster() );
+        newCluster.indexs.insert( newCluster.indexs.end(), clusterData[rootA].indexs.begin(), clusterData[rootA].indexs.end() );
+        newCluster.indexs.insert( newCluster.indexs.end(), clusterData[rootB].indexs.begin(), clusterData[rootB].indexs.end() );
+        
+        //Compute the cluster variance
+        const double numSamples = double( newCluster.getNumSamplesInCluster() );
+        double variance = 0;
+        for(UINT j=0; j<N; j++){
+            sum[rootA][j] += sum[rootB][j];
+            sumSquares[rootA][j] += sumSquares[rootB][j];
+            const double ss = sumSquares[rootA][j] - (sum[rootA][j]*sum[rootA][j])/numSamples;
+            variance += sqrt( (ss > 0 ? ss : 0) / (numSamples-1.0) );
         }
+        newCluster.clusterVariance = variance/N;
         
-        if( minDist == numeric_limits<double>::max() ){
-            keepClustering = false;
-            cout << "WARNING: Failed to find any cluster at level: " << level << endl;
-        }else{
+        //The merged cluster replaces the first cluster, the second cluster is no longer used
+        parent[rootB] = rootA;
+        clusterData[rootA] = newCluster;
+        clusterData[rootB].indexs.clear();
         
-            //Merge the two closest clusters together and create a new level
-            ClusterLevel newLevel;
-            newLevel.level = level;
-            
-            //Create the new cluster
-            ClusterInfo newCluster;
-            newCluster.uniqueClusterID = uniqueClusterID++;
-            
-            const UINT numClusterPairs = (UINT)clusterPairs.size();
+        //Add the new level to the main cluster buffer
+        level++;
+        ClusterLevel mergeLevel;
+        mergeLevel.level = level;
+        mergeLevel.clusters.push_back( newCluster );
+        clusters.push_back( mergeLevel );
+    }
+    
+    trained = true;
+
+	return true;
+}
+    
+void HierarchicalClustering::computeNearestNeighbourChainMerges( const MatrixDouble &data, vector< HierarchicalClusteringMerge > &merges ){
+    
+    //A single sample has nothing to merge with, and its condensed distance matrix would be empty
+    if( M < 2 ){
+        merges.clear();
+        return;
+    }
+    
+    //Build the condensed distance matrix, this only stores the upper triangle, as floats
+    distanceMatrix.resize( (size_t(M)*size_t(M-1))/2 );
+    HierarchicalClusteringDistanceTask distanceTask( data, distanceMatrix );
+    ParallelFor::run( (M+1)/2, distanceTask, 128 );
+    
+    //Run the nearest-neighbour chain algorithm. Starting from any cluster, the chain follows each cluster's nearest
+    //neighbour until two clusters are each other's nearest neighbour, these are then merged and the chain continues.
+    //For reducible linkages (single, complete and average) this finds the same merges as the naive search in O(M^2)
+    vector< UINT > activeClusters(M);           //The slot index of each cluster that has not been merged yet, in ascending order
+    vector< UINT > clusterSize(M,1);
+    for(UINT i=0; i<M; i++){
+        activeClusters[i] = i;
+    }
+    
+    vector< UINT > chain;
+    chain.reserve(M);
+    merges.clear();
+    merges.reserve(M);
+    
+    while( activeClusters.size() > 1 ){
+        
+        if( chain.size() == 0 ) chain.push_back( activeClusters[0] );
+        
+        UINT a = 0;
+        UINT b = 0;
+        float minDist = 0;
+        while( true ){
+            a = chain.back();
             
-            for(UINT k=0; k<numClusterPairs; k++){
-                //Add all the samples in the first cluster to the new cluster
-                UINT numSamplesInClusterA = clusterData[ clusterPairs[k][0] ].getNumSamplesInCluster();
-                for(UINT i=0; i<numSamplesInClusterA; i++){
-                    UINT index = clusterData[ clusterPairs[k][0] ][ i ];
-                    newCluster.addSampleToCluster( index );
-                }
-                
-                //Add all the samples in the second cluster to the new cluster
-                UINT numSamplesInClusterB = clusterData[ clusterPairs[k][1] ].getNumSamplesInCluster();
-                for(UINT i=0; i<numSamplesInClusterB; i++){
-                    UINT index = clusterData[ clusterPairs[k][1] ][ i ];
-                    newCluster.addSampleToCluster( index );
-                }
-                
-                //Compute the cluster variance
-                newCluster.clusterVariance = computeClusterVariance( newCluster, data );
-                
-                //Remove the two cluster pairs (so they will not be used in the next search
-                UINT idA = clusterData[ clusterPairs[k][0] ].getUniqueClusterID();
-                UINT idB = clusterData[ clusterPairs[k][1] ].getUniqueClusterID();
-                UINT numRemoved = 0;
-                vector< ClusterInfo >::iterator iter = clusterData.begin();
-                while( iter != clusterData.end() ){
-                    if( iter->getUniqueClusterID() == idA || iter->getUniqueClusterID() == idB ){
-                        iter = clusterData.erase( iter );
-                        if( ++numRemoved >= 2 ) break;
-                    }else iter++;
+            //Find the nearest neighbour of a, preferring the previous cluster in the chain on ties so the chain can not loop
+            const bool hasPrevious = chain.size() >= 2;
+            b = hasPrevious ? chain[ chain.size()-2 ] : a;
+            minDist = hasPrevious ? distanceMatrix[ getCondensedIndex(M,a,b) ] : numeric_limits<float>::max();
+            const UINT numActive = (UINT)activeClusters.size();
+            for(UINT k=0; k<numActive; k++){
+                const UINT x = activeClusters[k];
+                if( x == a ) continue;
+                const float d = distanceMatrix[ getCondensedIndex(M,a,x) ];
+                if( d < minDist ){
+                    minDist = d;
+                    b = x;
                 }
             }
             
-            //Add the merged cluster to the clusterData
-            clusterData.push_back( newCluster );
-            
-            //Add the new level and cluster data to the main cluster buffer
-            newLevel.clusters.push_back( newCluster );
-            
-            clusters.push_back( newLevel );
-            
-            //Update the level
-            level++;
-            
+            if( hasPrevious && b == chain[ chain.size()-2 ] ) break;
+            chain.push_back( b );
         }
         
-        //Check to see if we should stop clustering
-        if( level >= M ){
-            keepClustering = false;
-        }
+        //a and b are reciprocal nearest neighbours, so merge them
+        chain.pop_back();
+        chain.pop_back();
         
-        if( clusterData.size() == 0 ){
-            keepClustering = false;
+        HierarchicalClusteringMerge merge;
+        merge.clusterA = a;
+        merge.clusterB = b;
+        merge.distance = minDist;
+        merges.push_back( merge );
+        
+        //Update the distance from every other cluster to the merged cluster using the Lance-Williams formula,
+        //the merged cluster keeps slot a while slot b is removed
+        const UINT sizeA = clusterSize[a];
+        const UINT sizeB = clusterSize[b];
+        activeClusters.erase( std::lower_bound( activeClusters.begin(), activeClusters.end(), b ) );
+        const UINT numActive = (UINT)activeClusters.size();
+        for(UINT k=0; k<numActive; k++){
+            const UINT x = activeClusters[k];
+            if( x == a ) continue;
+            float &dA = distanceMatrix[ getCondensedIndex(M,a,x) ];
+            const float dB = distanceMatrix[ getCondensedIndex(M,b,x) ];
+            switch( linkageMethod ){
+                case COMPLETE_LINKAGE:
+                    dA = MAX( dA, dB );
+                    break;
+                case AVERAGE_LINKAGE:
+                    dA = float( (sizeA*double(dA) + sizeB*double(dB)) / double(sizeA+sizeB) );
+                    break;
+                default:
+                    dA = MIN( dA, dB );
+                    break;
+            }
+        }
+        clusterSize[a] = sizeA + sizeB;
+    }
+    
+    //The distance matrix is no longer needed, so release its memory
+    vector< float >().swap( distanceMatrix );
+}
+    
+void HierarchicalClustering::computeSingleLinkageMerges( const MatrixDouble &data, vector< HierarchicalClusteringMerge > &merges ){
+    
+    //The single linkage merges are the edges of the minimum spanning tree of the samples, which Prim's algorithm finds
+    //in O(M^2) time without storing the distance matrix. Each step adds the sample closest to the tree, using the
+    //distance from every other sample to the tree (minDistance) and the tree sample it is closest to (nearestSample)
+    merges.clear();
+    merges.reserve(M);
+    
+    vector< UINT > remainingSamples(M-1);
+    VectorDouble minDistance(M,numeric_limits<double>::max());
+    vector< UINT > nearestSample(M,0);
+    for(UINT i=1; i<M; i++){
+        remainingSamples[i-1] = i;
+    }
+    
+    UINT newSample = 0;
+    while( remainingSamples.size() > 0 ){
+        const double *x = data[ newSample ];
+        double bestDistance = numeric_limits<double>::max();
+        UINT bestPosition = 0;
+        const UINT numRemaining = (UINT)remainingSamples.size();
+        for(UINT k=0; k<numRemaining; k++){
+            const UINT i = remainingSamples[k];
+            const double *y = data[i];
+            double dist = 0;
+            for(UINT n=0; n<N; n++){
+                dist += (x[n]-y[n])*(x[n]-y[n]);
+            }
+            if( dist < minDistance[i] ){
+                minDistance[i] = dist;
+                nearestSample[i] = newSample;
+            }
+            if( minDistance[i] < bestDistance ){
+                bestDistance = minDistance[i];
+                bestPosition = k;
+            }
         }
         
+        newSample = remainingSamples[ bestPosition ];
+        remainingSamples.erase( remainingSamples.begin() + bestPosition );
+        
+        HierarchicalClusteringMerge merge;
+        merge.clusterA = nearestSample[ newSample ];
+        merge.clusterB = newSample;
+        merge.distance = bestDistance;
+        merges.push_back( merge );
     }
-
-	return true;
 }
     
 bool HierarchicalClustering::printModel(){
@@ -244,60 +379,20 @@ bool HierarchicalClustering::printModel(){
     return true;
 }
     
-double HierarchicalClustering::squaredEuclideanDistance(const double *a,const double *b){
-    double dist = 0;
-    for(UINT i=0; i<N; i++){
-        dist += SQR( a[i] - b[i] );
+bool HierarchicalClustering::setLinkageMethod(const UINT linkageMethod){
+    if( linkageMethod == SINGLE_LINKAGE || linkageMethod == COMPLETE_LINKAGE || linkageMethod == AVERAGE_LINKAGE ){
+        this->linkageMethod = linkageMethod;
+        return true;
     }
-    return dist;
+    return false;
 }
     
-double HierarchicalClustering::computeClusterDistance( const ClusterInfo &clusterA, const ClusterInfo &clusterB ){
-    
-    double minDist = numeric_limits<double>::max();
-    const UINT numSamplesA = clusterA.getNumSamplesInCluster();
-    const UINT numSamplesB = clusterB.getNumSamplesInCluster();
-    
-    //Find the minimum distance between the two clusters
-    for(UINT i=0; i<numSamplesA; i++){
-        for(UINT j=0; j<numSamplesB; j++){
-            if( distanceMatrix[ clusterA[i] ][ clusterB[j] ] < minDist ){
-                minDist = distanceMatrix[ clusterA[i] ][ clusterB[j] ];
-            }
-        }
-    }
-    
-    return minDist;
-}
-    
-double HierarchicalClustering::computeClusterVariance( const ClusterInfo &cluster, const MatrixDouble &data ){
-    
-    VectorDouble mean(N,0);
-    VectorDouble std(N,0);
-    
-    //Compute the mean
-    UINT numSamples = cluster.getNumSamplesInCluster();
-    for(UINT j=0; j<N; j++){
-        for(UINT i=0; i<numSamples; i++){
-            UINT index = cluster[i];
-            mean[j] += data[ index ][j];
-        }
-        mean[j] /= double( numSamples );
-    }
-    
-    //Compute the std dev
-    for(UINT j=0; j<N; j++){
-        for(UINT i=0; i<numSamples; i++){
-            std[j] += SQR( data[ cluster[i] ][j] - mean[j] );
-        }
-        std[j] = sqrt( std[j] / double( numSamples-1 ) );
-    }
-    
-    double variance = 0;
-    for(UINT j=0; j<N; j++){
-        variance += std[j];
+UINT HierarchicalClustering::findRoot( UINT i, vector< UINT > &parent ){
+    while( parent[i] != i ){
+        parent[i] = parent[ parent[i] ];
+        i = parent[i];
     }
-    return variance/N;
+    return i;
 }
 
 }//End of namespace GRT
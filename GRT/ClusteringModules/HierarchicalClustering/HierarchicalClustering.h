@@ -23,7 +23,15 @@
  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  
  @section DESCRIPTION
+ The HierarchicalClustering class implements agglomerative hierarchical clustering. Starting with each sample in its own
+ cluster, the two closest clusters are merged at each level until only one cluster remains. Level 0 contains every
+ sample as its own cluster and each following level contains the cluster created by that merge.
 
+ Single linkage (the default) is computed from the minimum spanning tree of the samples, which needs O(M^2) time and
+ does not store the distance matrix. Complete and average linkage use the nearest-neighbour chain algorithm: the
+ squared Euclidean distance between every pair of samples is stored (as floats) in a condensed upper-triangle matrix,
+ and the distances to each merged cluster are updated with the Lance-Williams formula. This needs O(M^2) time and
+ M*(M-1)/2 floats of memory for M samples.
  */
 
 #ifndef GRT_HIERARCHICAL_CLUSTERING_HEADER
@@ -32,6 +40,7 @@
 #include "../../Util/GRTCommon.h"
 #include "../../DataStructures/LabelledClassificationData.h"
 #include "../../DataStructures/UnlabelledClassificationData.h"
+#include "../../Util/ParallelFor.h"
 
 namespace GRT{
     
@@ -132,6 +141,18 @@ public:
     vector< ClusterInfo > clusters;
 };
 
+//Records one merge of the hierarchy, clusterA and clusterB are any sample in each of the two clusters that were merged
+class HierarchicalClusteringMerge{
+public:
+    static bool sortByDistance(const HierarchicalClusteringMerge &a,const HierarchicalClusteringMerge &b){
+        return a.distance < b.distance;
+    }
+    
+    UINT clusterA;
+    UINT clusterB;
+    double distance;
+};
+
 class HierarchicalClustering{
 
 public:
@@ -145,19 +166,41 @@ public:
     
     bool printModel();
     
+    /**
+     Sets the linkage method used to compute the distance between two clusters. This should be one of the LinkageMethods
+     enums: SINGLE_LINKAGE (the minimum distance between the samples in each cluster, the default), COMPLETE_LINKAGE (the
+     maximum distance) or AVERAGE_LINKAGE (the mean distance). The new method will be used the next time the model is trained.
+     
+     @param const UINT linkageMethod: the new linkage method
+     @return returns true if the linkage method was updated, false otherwise
+     */
+    bool setLinkageMethod(const UINT linkageMethod);
+    
+    UINT getLinkageMethod() const{ return linkageMethod; }
+    
     vector< ClusterLevel > getClusters(){ return clusters; }
+    
+    /**
+     Gets the position of the distance between samples i and j (where i != j) in a condensed distance matrix of M samples.
+     */
+    static inline size_t getCondensedIndex(const UINT M,UINT i,UINT j){
+        if( i > j ) std::swap(i,j);
+        return size_t(i)*(2*size_t(M)-i-1)/2 + (j-i-1);
+    }
+    
+    enum LinkageMethods{SINGLE_LINKAGE=0,COMPLETE_LINKAGE,AVERAGE_LINKAGE};
 
 private:
-	inline double SQR(const double &a) {return a*a;};
-    double squaredEuclideanDistance(const double *a,const double *b);
-    double computeClusterDistance( const ClusterInfo &clusterA, const ClusterInfo &clusterB );
-    double computeClusterVariance( const ClusterInfo &cluster, const MatrixDouble &data );
+    void computeSingleLinkageMerges( const MatrixDouble &data, vector< HierarchicalClusteringMerge > &merges );
+    void computeNearestNeighbourChainMerges( const MatrixDouble &data, vector< HierarchicalClusteringMerge > &merges );
+    UINT findRoot( UINT i, vector< UINT > &parent );
 
 	UINT M;                             //Number of training examples
 	UINT N;                             //Number of dimensions
+    UINT linkageMethod;
     bool trained;
     vector< ClusterLevel > clusters;
-    MatrixDouble distanceMatrix;                     //The distance matrix
+    vector< float > distanceMatrix;                  //The condensed distance matrix, this is only used during training
 	
 		
 };
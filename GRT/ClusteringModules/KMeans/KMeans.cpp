@@ -22,6 +22,184 @@
 
 namespace GRT{
 
+//The smallest block of samples worth handing to a thread, smaller datasets are trained on the calling thread
+#define KMEANS_MIN_SAMPLES_PER_THREAD 1000
+
+//Updates the squared distance from each sample to its closest seed cluster during the k-means++ initialization
+class KMeansSeedingTask{
+public:
+    KMeansSeedingTask(const MatrixDouble &data,const MatrixDouble &clusters,UINT clusterIndex,VectorDouble &minDistances):
+        data(data),clusters(clusters),clusterIndex(clusterIndex),minDistances(minDistances){}
+    
+    void operator()(UINT startIndex,UINT endIndex,UINT threadIndex){
+        const UINT N = data.getNumCols();
+        const double *c = clusters[ clusterIndex ];
+        for(UINT i=startIndex; i<endIndex; i++){
+            const double *x = data[i];
+            double d = 0;
+            for(UINT n=0; n<N; n++) d += SQR( x[n]-c[n] );
+            if( d < minDistances[i] ) minDistances[i] = d;
+        }
+    }
+    
+    const MatrixDouble &data;
+    const MatrixDouble &clusters;
+    const UINT clusterIndex;
+    VectorDouble &minDistances;
+};
+
+//Assigns each sample to its closest cluster using Hamerly's bounds. The upper bound is the distance from the sample to its assigned
+//cluster and the lower bound is the distance to the second closest cluster, so only the samples whose bounds overlap need a full search
+class KMeansAssignmentTask{
+public:
+    KMeansAssignmentTask(const MatrixDouble &data,const MatrixDouble &clusters,const SquaredDistanceKernel &kernel,const VectorDouble &clusterHalfDistances,
+                         vector< UINT > &assign,VectorDouble &upperBounds,VectorDouble &lowerBounds):
+        data(data),clusters(clusters),kernel(kernel),clusterHalfDistances(clusterHalfDistances),assign(assign),upperBounds(upperBounds),lowerBounds(lowerBounds){
+        const UINT maxNumThreads = ParallelFor::getMaxNumThreads();
+        numChanged.resize(maxNumThreads,0);
+        distances.resize(maxNumThreads,VectorDouble(kernel.getNumClusters(),0));
+    }
+    
+    void operator()(UINT startIndex,UINT endIndex,UINT threadIndex){
+        const UINT K = clusters.getNumRows();
+        const UINT N = clusters.getNumCols();
+        double *dist = &distances[ threadIndex ][0];
+        UINT changed = 0;
+        
+        for(UINT i=startIndex; i<endIndex; i++){
+            const double *x = data[i];
+            const UINT a = assign[i];
+            
+            //The bounds are only trusted when they are strictly apart, so a sample that could be tied with another cluster
+            //always gets the full search and the same tie break as a direct search
+            if( a < K ){
+                const double bound = MAX( clusterHalfDistances[a], lowerBounds[i] );
+                if( upperBounds[i] < bound ) continue;
+                
+                //Tighten the upper bound and check again before running the full search
+                upperBounds[i] = euclideanDistance( x, clusters[a], N );
+                if( upperBounds[i] < bound ) continue;
+            }
+            
+            //Run the full search with the kernel, then recompute the exact distance of any cluster that could be the closest or
+            //second closest once the kernel's rounding error is allowed for, so the bounds are set from exact distances. As in a
+            //direct search, a tie for the closest cluster goes to the last of the tied clusters
+            double minDist = 0;
+            kernel.computeDistances( x, dist, minDist );
+            double inputNorm = 0;
+            for(UINT n=0; n<N; n++) inputNorm += x[n]*x[n];
+            
+            UINT closest = 0;
+            double closestDist = numeric_limits<double>::max();
+            double secondMinDist = numeric_limits<double>::max();
+            for(UINT k=0; k<K; k++){
+                if( dist[k] - kernel.getRoundingErrorBound( inputNorm, k ) > secondMinDist ) continue;
+                const double d = kernel.computeExactDistance( x, k );
+                if( d <= closestDist ){
+                    secondMinDist = closestDist;
+                    closestDist = d;
+                    closest = k;
+                }else if( d < secondMinDist ){
+                    secondMinDist = d;
+                }
+            }
+            
+            upperBounds[i] = sqrt( closestDist );
+            lowerBounds[i] = K > 1 ? sqrt( secondMinDist ) : numeric_limits<double>::max();
+            
+            if( closest != a ){
+                assign[i] = closest;
+                changed++;
+            }
+        }
+        numChanged[ threadIndex ] += changed;
+    }
+    
+    static double euclideanDistance(const double *a,const double *b,const UINT N){
+        double d = 0;
+        for(UINT n=0; n<N; n++) d += SQR( a[n]-b[n] );
+        return sqrt( d );
+    }
+    
+    const MatrixDouble &data;
+    const MatrixDouble &clusters;
+    const SquaredDistanceKernel &kernel;
+    const VectorDouble &clusterHalfDistances;
+    vector< UINT > &assign;
+    VectorDouble &upperBounds;
+    VectorDouble &lowerBounds;
+    vector< UINT > numChanged;
+    vector< VectorDouble > distances;
+};
+
+//Sums the samples assigned to each cluster, each thread writes to its own sum matrix which are merged by the M step
+class KMeansUpdateTask{
+public:
+    KMeansUpdateTask(const MatrixDouble &data,const vector< UINT > &assign,UINT K):data(data),assign(assign),K(K){
+        sums.resize( ParallelFor::getMaxNumThreads() );
+    }
+    
+    void operator()(UINT startIndex,UINT endIndex,UINT threadIndex){
+        const UINT N = data.getNumCols();
+        MatrixDouble &sum = sums[ threadIndex ];
+        sum.resize(K,N);
+        sum.setAllValues(0);
+        for(UINT i=startIndex; i<endIndex; i++){
+            const double *x = data[i];
+            double *s = sum[ assign[i] ];
+            for(UINT n=0; n<N; n++) s[n] += x[n];
+        }
+    }
+    
+    const MatrixDouble &data;
+    const vector< UINT > &assign;
+    const UINT K;
+    vector< MatrixDouble > sums;
+};
+
+//Computes the total squared distance between each sample and its assigned cluster
+class KMeansThetaTask{
+public:
+    KMeansThetaTask(const MatrixDouble &data,const MatrixDouble &clusters,const vector< UINT > &assign):data(data),clusters(clusters),assign(assign){
+        theta.resize( ParallelFor::getMaxNumThreads(), 0 );
+    }
+    
+    void operator()(UINT startIndex,UINT endIndex,UINT threadIndex){
+        const UINT N = data.getNumCols();
+        double sum = 0;
+        for(UINT i=startIndex; i<endIndex; i++){
+            const double *x = data[i];
+            const double *c = clusters[ assign[i] ];
+            for(UINT n=0; n<N; n++) sum += SQR( c[n]-x[n] );
+        }
+        theta[ threadIndex ] = sum;
+    }
+    
+    const MatrixDouble &data;
+    const MatrixDouble &clusters;
+    const vector< UINT > &assign;
+    VectorDouble theta;
+};
+
+//Finds the closest cluster for each sample in a mini batch, the batch is a list of row indexs into the current chunk
+class KMeansBatchAssignmentTask{
+public:
+    KMeansBatchAssignmentTask(const MatrixDouble &chunk,const SquaredDistanceKernel &kernel,const vector< UINT > &batchIndexs,vector< UINT > &batchAssign,VectorDouble &batchDistances):
+        chunk(chunk),kernel(kernel),batchIndexs(batchIndexs),batchAssign(batchAssign),batchDistances(batchDistances){}
+    
+    void operator()(UINT startIndex,UINT endIndex,UINT threadIndex){
+        for(UINT i=startIndex; i<endIndex; i++){
+            batchAssign[i] = kernel.findNearestCluster( chunk[ batchIndexs[i] ], batchDistances[i] );
+        }
+    }
+    
+    const MatrixDouble &chunk;
+    const SquaredDistanceKernel &kernel;
+    const vector< UINT > &batchIndexs;
+    vector< UINT > &batchAssign;
+    VectorDouble &batchDistances;
+};
+
 //Constructor,destructor
 KMeans::KMeans(){
     M = N = K = nchg = 0;
@@ -30,6 +208,7 @@ KMeans::KMeans(){
     minChange = 1.0e-10;
     finalTheta = 0;
     numTrainingIterations = 0;
+    miniBatchSize = 1000;
     computeTheta = true;
     trained = false;
 }
@@ -48,34 +227,23 @@ bool KMeans::predict(VectorDouble inputVector,UINT &predictedClassLabel,double &
 		return false;
 	}
 	
-	double minDist = numeric_limits<double>::max();
+	double minDist = 0;
 	double sum = 0;
 	UINT minIndex = 0;
 	predictedClassLabel = 0;
 	maxLikelihood = 0;
-	classLikelihoods.clear();
-	classLikelihoods.resize( clusters.getNumCols() );
 	
-	for(UINT i=0; i<clusters.getNumRows(); i++){
-		
-		double dist = 0;
-		for(UINT j=0; j<clusters.getNumCols(); j++){
-			dist += SQR( inputVector[j]-clusters[i][j] );
-		}
-        //We don't need to compute the sqrt as it works without it and is faster
-		
-		classLikelihoods[i] = dist;
-		sum += dist;
-				
-		if( dist < minDist ){
-			minDist = dist;
-			minIndex = i;
-		}
+	//Compute the squared distance to each cluster, we don't need to compute the sqrt as it works without it and is faster
+	minIndex = distanceKernel.computeDistances( inputVector, classLikelihoods, minDist );
+	for(UINT i=0; i<K; i++){
+		sum += classLikelihoods[i];
 	}
 	
 	//Normalize the likelihood
-	for(UINT i=0; i<clusters.getNumRows(); i++){
-		classLikelihoods[i] /= sum;
+	if( sum > 0 ){
+		for(UINT i=0; i<K; i++){
+			classLikelihoods[i] /= sum;
+		}
 	}
 	
 	predictedClassLabel = classLabels[ minIndex ];
@@ -215,27 +383,139 @@ bool KMeans::train(UINT K,MatrixDouble &data){
 	assign.resize(M);
 	count.resize(K);
 
-	//Randomly pick k data points as the starting clusters
-	Random random;
-	UINT indexA, indexB, tempIndex;
-	vector< UINT > randIndexs(M);
-	for(UINT i=0; i<M; i++) randIndexs[i] = i;
-	for(UINT i=0; i<M; i++){
-		indexA = random.getRandomNumberInt(0,M);
-		indexB = random.getRandomNumberInt(0,M);
-		tempIndex = randIndexs[ indexA ];
-		randIndexs[ indexA ] = randIndexs[ indexB ];
-		randIndexs[ indexB ] = tempIndex;
-	}
+	//Pick the starting clusters
+	seedClusters( data, M );
 
+	return train( data );
+}
+bool KMeans::train(UINT K,ChunkedDatasetReader &reader){
+	
+	trained = false;
+	classLabels.clear();
+	
+	if( K == 0 || miniBatchSize == 0 ){
+		return false;
+	}
+	
+	//Start from the first sample in the dataset files
+	if( !reader.reset() ){
+		return false;
+	}
+	
+	MatrixDouble chunk;
+	UINT numRows = reader.readChunk( chunk );
+	if( numRows < K ){
+		return false;
+	}
+	
+	this->K = K;
+	N = reader.getNumDimensions();
+	M = 0;
+	clusters.resize(K,N);
+	assign.clear();
+	count.resize(K);
+	for(UINT k=0; k<K; k++) count[k] = 0;
+	
+	classLabels.resize(K);
 	for(UINT k=0; k<K; k++){
-		for(UINT j=0; j<N; j++){
-            clusters[k][j] = data[ randIndexs[k] ][j];
+		classLabels[k] = k;
+	}
+	
+	//Seed the clusters from a uniform sample of the whole dataset, so the seeds are not biased towards the first chunk. The
+	//sample is the size of one chunk and is drawn with reservoir sampling, which costs one extra pass through the files
+	Random random;
+	MatrixDouble seedSamples( chunk );
+	const UINT numSeedSamples = numRows;
+	double numRowsSeen = numRows;
+	while( (numRows = reader.readChunk( chunk )) > 0 ){
+		for(UINT i=0; i<numRows; i++){
+			const double index = floor( random.getRandomNumberUniform(0,1) * ++numRowsSeen );
+			if( index < numSeedSamples ){
+				for(UINT n=0; n<N; n++){
+					seedSamples[ (UINT)index ][n] = chunk[i][n];
+				}
+			}
 		}
 	}
-
-	return train( data );
+	seedClusters( seedSamples, numSeedSamples );
+	
+	vector< UINT > batchIndexs( miniBatchSize );
+	vector< UINT > batchAssign( miniBatchSize );
+	VectorDouble batchDistances( miniBatchSize );
+	MatrixDouble previousClusters;
+	UINT currentIter = 0;
+	bool converged = false;
+	double theta = 0;
+	thetaTracker.clear();
+	finalTheta = 0;
+	numTrainingIterations = 0;
+	
+	while( currentIter < maxNumEpochs ){
+		
+		previousClusters = clusters;
+		theta = 0;
+		M = 0;
+		
+		//Rewind the reader for each new pass through the data
+		if( !reader.reset() ) return false;
+		numRows = reader.readChunk( chunk );
+		
+		while( numRows > 0 ){
+			
+			//Draw the mini batches from the current chunk
+			const UINT numBatches = (numRows + miniBatchSize - 1) / miniBatchSize;
+			const UINT batchSize = MIN( miniBatchSize, numRows );
+			for(UINT b=0; b<numBatches; b++){
+				
+				for(UINT i=0; i<batchSize; i++){
+					UINT index = (UINT)random.getRandomNumberInt(0,numRows);
+					batchIndexs[i] = index < numRows ? index : numRows-1;
+				}
+				
+				//Find the closest cluster for each sample in the batch
+				distanceKernel.setClusters( clusters );
+				KMeansBatchAssignmentTask assignmentTask( chunk, distanceKernel, batchIndexs, batchAssign, batchDistances );
+				ParallelFor::run( batchSize, assignmentTask, KMEANS_MIN_SAMPLES_PER_THREAD );
+				
+				//Move each cluster towards its samples, using a per-cluster learning rate that decays as the cluster sees more samples
+				for(UINT i=0; i<batchSize; i++){
+					const UINT k = batchAssign[i];
+					const double *x = chunk[ batchIndexs[i] ];
+					const double eta = 1.0 / double( ++count[k] );
+					for(UINT n=0; n<N; n++){
+						clusters[k][n] += eta * ( x[n] - clusters[k][n] );
+					}
+					theta += batchDistances[i];
+				}
+			}
+			
+			M += numRows;
+			numRows = reader.readChunk( chunk );
+		}
+		
+		currentIter++;
+		
+		//Check convergance, using the total squared distance the clusters moved during this pass
+		double change = 0;
+		for(UINT k=0; k<K; k++){
+			for(UINT n=0; n<N; n++){
+				change += SQR( clusters[k][n] - previousClusters[k][n] );
+			}
+		}
+		if( computeTheta ) thetaTracker.push_back( theta );
+		if( change < minChange && currentIter >= minNumEpochs ){ converged = true; break; }
+	}
+	
+	finalTheta = theta;
+	numTrainingIterations = currentIter;
+	trained = true;
+	
+	//Precompute the cluster norms used by predict
+	distanceKernel.setClusters( clusters );
+	
+	return converged;
 }
+
 bool KMeans::train(MatrixDouble &data,MatrixDouble &clusters){
 	this->clusters = clusters;
 	M = data.getNumRows();
@@ -247,6 +527,49 @@ bool KMeans::train(MatrixDouble &data,MatrixDouble &clusters){
 	return train( data );
 }
 
+void KMeans::seedClusters(const MatrixDouble &data,const UINT numSamples){
+	
+	//Pick the starting clusters using k-means++ seeding: the first cluster is a random data point, each following
+	//cluster is a data point picked with a probability proportional to its squared distance to the closest cluster so far
+	Random random;
+	UINT index = (UINT)random.getRandomNumberInt(0,numSamples);
+	if( index >= numSamples ) index = numSamples-1;
+	for(UINT j=0; j<N; j++){
+		clusters[0][j] = data[index][j];
+	}
+
+	VectorDouble minDistances(numSamples,numeric_limits<double>::max());
+	for(UINT k=1; k<=K; k++){
+		
+		//Update the squared distance from each point to its closest cluster
+		KMeansSeedingTask seedingTask( data, clusters, k-1, minDistances );
+		ParallelFor::run( numSamples, seedingTask, KMEANS_MIN_SAMPLES_PER_THREAD );
+		
+		if( k == K ) break;
+		
+		double sum = 0;
+		for(UINT i=0; i<numSamples; i++) sum += minDistances[i];
+		
+		if( sum > 0 ){
+			const double target = random.getRandomNumberUniform(0,sum);
+			double cumSum = 0;
+			index = numSamples-1;
+			for(UINT i=0; i<numSamples; i++){
+				cumSum += minDistances[i];
+				if( cumSum >= target && minDistances[i] > 0 ){ index = i; break; }
+			}
+		}else{
+			//All the points sit on top of the existing clusters, so just pick one at random
+			index = (UINT)random.getRandomNumberInt(0,numSamples);
+			if( index >= numSamples ) index = numSamples-1;
+		}
+		
+		for(UINT j=0; j<N; j++){
+            clusters[k][j] = data[ index ][j];
+		}
+	}
+}
+
 bool KMeans::train(MatrixDouble &data){
 
 	UINT currentIter = 0;
@@ -269,6 +592,12 @@ bool KMeans::train(MatrixDouble &data){
     //Assign is set to K+1 so that the nChanged values in the eStep at the first iteration will be updated correctly
     for(UINT m=0; m<M; m++) assign[m] = K+1;
 	for(UINT k=0; k<K; k++) count[k] = 0;
+	
+	//Init the distance bounds, these will be set by the first E step
+	upperBounds.resize(M);
+	lowerBounds.resize(M);
+	std::fill(upperBounds.begin(),upperBounds.end(),0);
+	std::fill(lowerBounds.begin(),lowerBounds.end(),0);
 
     //Run the training loop
 	while( keepTraining ){
@@ -294,69 +623,107 @@ bool KMeans::train(MatrixDouble &data){
     numTrainingIterations = currentIter;
 	trained = true;
 	
+	//Precompute the cluster norms used by predict
+	distanceKernel.setClusters( clusters );
+	
+	//The bounds are only needed during training
+	upperBounds.clear();
+	lowerBounds.clear();
+	clusterHalfDistances.clear();
+	
 	return converged;
 }
 
 UINT KMeans::estep(const MatrixDouble &data) {
-		UINT k,m,n,kmin;
-		double dmin,d;
-		nchg = 0;
-		kmin = 0;
-
-		//Reset Count
-		for (k=0;k<K;k++) count[k] = 0;
-
-		//Search for the closest center and reasign if needed
-		for (m=0; m<M; m++) {
-			dmin = 9.99e+99;
-			for (k=0; k<K; k++) {
-				d = 0.0;
-				for (n=0; n<N; n++)
-					d += SQR( data[m][n]-clusters[k][n] );
-				if (d <= dmin){ dmin = d; kmin = k; }
-			}
-			if ( kmin != assign[m] ){
-                nchg++;
-                assign[m] = kmin;
-            }
-			count[kmin]++;
+	
+	//Update the kernel with the current clusters
+	distanceKernel.setClusters( clusters );
+	
+	//Compute half the distance from each cluster to its closest neighbour, any point that is closer than this to
+	//its assigned cluster can not be closer to another cluster
+	clusterHalfDistances.resize(K);
+	for(UINT k=0; k<K; k++){
+		double minDist = numeric_limits<double>::max();
+		for(UINT j=0; j<K; j++){
+			if( j == k ) continue;
+			double d = 0;
+			for(UINT n=0; n<N; n++) d += SQR( clusters[k][n]-clusters[j][n] );
+			if( d < minDist ) minDist = d;
 		}
-		return nchg;
+		clusterHalfDistances[k] = K > 1 ? 0.5 * sqrt( minDist ) : numeric_limits<double>::max();
+	}
+	
+	//Search for the closest center and reassign if needed, this runs across all the available cores
+	KMeansAssignmentTask assignmentTask( data, clusters, distanceKernel, clusterHalfDistances, assign, upperBounds, lowerBounds );
+	ParallelFor::run( M, assignmentTask, KMEANS_MIN_SAMPLES_PER_THREAD );
+	
+	nchg = 0;
+	for(UINT t=0; t<assignmentTask.numChanged.size(); t++){
+		nchg += assignmentTask.numChanged[t];
+	}
+	
+	//Update the count
+	for(UINT k=0; k<K; k++) count[k] = 0;
+	for(UINT m=0; m<M; m++) count[ assign[m] ]++;
+	
+	return nchg;
 }
 
 void KMeans::mstep(const MatrixDouble &data) {
     UINT n,k,m;
 
-    //Reset means to zero
-    for (k=0;k<K;k++)
-        for (n=0;n<N;n++)
-            clusters[k][n] = 0.;
-
-    //Get new mean by adding assigned data points and dividing by the number of values in each cluster
-    for(m=0; m<M; m++)
-        for(n=0; n<N; n++)
-            clusters[ assign[m] ][n] += data[m][n];
-
+    //Sum the data points assigned to each cluster, each thread sums its own block of the data
+    KMeansUpdateTask updateTask( data, assign, K );
+    const UINT numThreads = ParallelFor::run( M, updateTask, KMEANS_MIN_SAMPLES_PER_THREAD );
+    
+    for(UINT t=1; t<numThreads; t++){
+        for(k=0; k<K; k++)
+            for(n=0; n<N; n++)
+                updateTask.sums[0][k][n] += updateTask.sums[t][k][n];
+    }
+    const MatrixDouble &sums = updateTask.sums[0];
+
+    //Get new mean by dividing the sums by the number of values in each cluster, an empty cluster keeps its old position
+    //Track how far each cluster moved so the distance bounds can be updated
+    VectorDouble movement(K,0);
+    UINT maxIndex = 0;
+    double maxMovement = 0;
+    double secondMaxMovement = 0;
     for (k=0; k<K; k++) {
         if (count[k] > 0){
+            double d = 0;
             for (n=0; n<N; n++){
-                clusters[k][n] /= double(count[k]);
+                const double value = sums[k][n] / double(count[k]);
+                d += SQR( value - clusters[k][n] );
+                clusters[k][n] = value;
             }
+            movement[k] = sqrt( d );
         }
+        if( movement[k] > maxMovement ){
+            secondMaxMovement = maxMovement;
+            maxMovement = movement[k];
+            maxIndex = k;
+        }else if( movement[k] > secondMaxMovement ){
+            secondMaxMovement = movement[k];
+        }
+    }
+
+    //The assigned cluster can only have moved away from the point by its own movement, and every other cluster can only have
+    //moved closer by at most the largest movement of the other clusters
+    for(m=0; m<M; m++){
+        upperBounds[m] += movement[ assign[m] ];
+        lowerBounds[m] -= assign[m] == maxIndex ? secondMaxMovement : maxMovement;
     }
 }
 
 double KMeans::calculateTheta(const MatrixDouble &data){
 
-	double theta = 0;
+	KMeansThetaTask thetaTask( data, clusters, assign );
+	const UINT numThreads = ParallelFor::run( M, thetaTask, KMEANS_MIN_SAMPLES_PER_THREAD );
 
-	for(UINT m=0; m<M; m++){
-		UINT k = assign[m];
-		double sum = 0;
-		for(UINT n=0;n<N;n++){
-				sum += SQR(clusters[k][n] - data[m][n]);
-		}
-		theta += sum;
+	double theta = 0;
+	for(UINT t=0; t<numThreads; t++){
+		theta += thetaTask.theta[t];
 	}
 
 	return theta;
@@ -404,40 +771,38 @@ bool KMeans::saveModelToFile(string fileName){
 bool KMeans::loadModelFromFile(string fileName){
 
 	clusters.clear();
+	distanceKernel.clear();
 	K = 0;
 	N = 0;
 	M = 0;
 
    std::fstream file;
-   string word;
    file.open(fileName.c_str(), std::ios::in);
 
    if(!file.is_open()){
 	   return false;
    }
 
-   file >> word;
-   if( word != "GRT_KMEANS_MODEL_FILE_V1.0" ){
+   FileTokenizer parser( file );
+
+   if( !parser.matchWord("GRT_KMEANS_MODEL_FILE_V1.0") ){
 	   file.close();
 	   return false;
    }
 
-   file >> word;
-   if( word != "K:" ){
+   if( !parser.matchWord("K:") ){
 	   file.close();
 	   return false;
    }
-   file >> K;
+   parser >> K;
 
-   file >> word;
-   if( word != "N:" ){
+   if( !parser.matchWord("N:") ){
 	   file.close();
 	   return false;
    }
-   file >> N;
+   parser >> N;
 
-   file >> word;
-   if( word != "Clusters:" ){
+   if( !parser.matchWord("Clusters:") ){
 	   file.close();
 	   return false;
    }
@@ -449,23 +814,26 @@ bool KMeans::loadModelFromFile(string fileName){
    //Load the data
    for(UINT k=0; k<K; k++){
 	   for(UINT n=0; n<N; n++){
-	      file >> clusters[k][n];
+	      parser >> clusters[k][n];
 	   }
    }
 
 	//Load the class labels
-	if( word != "Clusters:" ){
+	if( !parser.matchWord("ClassLabels:") ){
 		file.close();
 		return false;
 	}
 	
 	for(UINT k=0; k<K; k++){
-		file >> classLabels[k];
+		parser >> classLabels[k];
 	}
 	
 	//Close the file
    	file.close();
 
+	//Precompute the cluster norms used by predict
+	distanceKernel.setClusters( clusters );
+
 	//Flag that the model is trained
     trained = true;
 
@@ -493,6 +861,14 @@ bool KMeans::setMinNumEpochs(UINT minNumEpochs){
     return false;
 }
 
+bool KMeans::setMiniBatchSize(UINT miniBatchSize){
+    if( miniBatchSize > 0 ){
+        this->miniBatchSize = miniBatchSize;
+        return true;
+    }
+    return false;
+}
+
 bool KMeans::setMaxNumEpochs(UINT maxNumEpochs){
     if( maxNumEpochs > 0 ){
         this->maxNumEpochs = maxNumEpochs;
@@ -23,15 +23,21 @@
  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  
  @section DESCRIPTION
-
+ The KMeans class implements the K-Means clustering algorithm. The clusters are initialized using k-means++ seeding and
+ trained using Hamerly's accelerated version of Lloyd's algorithm, which uses the triangle inequality to skip most of the
+ distance computations once the clusters start to settle. The assignment and update steps are split across all the
+ available cores (see ParallelFor).
  */
 
 #ifndef GRT_KMEANS_HEADER
 #define GRT_KMEANS_HEADER
 
 #include "../../Util/GRTCommon.h"
+#include "../../Util/SquaredDistanceKernel.h"
+#include "../../Util/ParallelFor.h"
 #include "../../DataStructures/LabelledClassificationData.h"
 #include "../../DataStructures/UnlabelledClassificationData.h"
+#include "../../DataStructures/ChunkedDatasetReader.h"
 
 namespace GRT{
 
@@ -47,6 +53,22 @@ public:
 	bool train(UINT K,UnlabelledClassificationData &trainingData);
 	bool train(UINT K, MatrixDouble &data);
 	bool train(MatrixDouble &data,MatrixDouble &clusters);
+    
+    /**
+     Trains the clusters using mini-batch KMeans, reading the samples from the dataset files a chunk at a time so the
+     whole dataset never needs to be loaded into memory. Each pass through the files (an epoch) draws random mini-batches
+     from each chunk and moves the clusters towards the samples in the batch with a per-cluster learning rate. The clusters
+     are seeded from a uniform random sample of the whole dataset (one chunk in size), which takes one extra pass.
+     Training stops when the clusters move less than minChange in one epoch (after minNumEpochs), or after maxNumEpochs.
+     The reader is rewound at the start of each epoch. As the samples are not kept, getClassLabelsVector will be empty
+     after training with this function.
+     
+     @param UINT K: the number of clusters
+     @param ChunkedDatasetReader &reader: a reader that has been opened with the dataset files
+     @return returns true if the training converged, false otherwise
+     */
+    bool train(UINT K,ChunkedDatasetReader &reader);
+    
 	bool saveModelToFile(string fileName);
 	bool loadModelFromFile(string fileName);
 
@@ -54,6 +76,7 @@ public:
 	UINT getNumClusters(){ return K; }
 	UINT getNumDimensions(){ return N; }
     UINT getNumTrainingIterations(){ return numTrainingIterations; }
+    UINT getMiniBatchSize(){ return miniBatchSize; }
 	double getTheta(){ return finalTheta; }
 	bool getModelTrained(){ return trained; }
 
@@ -67,9 +90,11 @@ public:
     bool setMinChange(double minChange);
     bool setMinNumEpochs(UINT minNumEpochs);
     bool setMaxNumEpochs(UINT maxNumEpochs);
+    bool setMiniBatchSize(UINT miniBatchSize);
 
 private:
 	bool train(MatrixDouble &data);
+    void seedClusters(const MatrixDouble &data,const UINT numSamples);
     UINT estep(const MatrixDouble &data);
 	void mstep(const MatrixDouble &data);
 	double calculateTheta(const MatrixDouble &data);
@@ -82,11 +107,16 @@ private:
     UINT minNumEpochs;      
     UINT maxNumEpochs;
     UINT numTrainingIterations;
+    UINT miniBatchSize;
 	double finalTheta;
     double minChange;
 	vector<UINT> classLabels;
     MatrixDouble clusters;
+    SquaredDistanceKernel distanceKernel;
 	vector< UINT > assign, count;
+    VectorDouble upperBounds;           //The distance from each sample to its assigned cluster (or more), used to skip distance computations
+    VectorDouble lowerBounds;           //The distance from each sample to its second closest cluster (or less)
+    VectorDouble clusterHalfDistances;  //Half the distance from each cluster to its closest neighbouring cluster
     VectorDouble thetaTracker;
 	bool computeTheta;
     bool trained;
@@ -0,0 +1,532 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BinaryDatasetFile.h"
+#include <string.h>
+
+namespace GRT{
+
+const char BinaryDatasetFile::fileMagic[8] = { 'G', 'R', 'T', 'B', 'D', 'S', '1', '\0' };
+
+//Reads n bytes from the metadata, returns false if there are not enough bytes left
+static bool readMetadataBytes(const char *&p,const char *end,void *dest,size_t n){
+    if( size_t(end-p) < n ) return false;
+    memcpy( dest, p, n );
+    p += n;
+    return true;
+}
+
+static bool readMetadataString(const char *&p,const char *end,string &s){
+    unsigned int length = 0;
+    if( !readMetadataBytes( p, end, &length, sizeof(length) ) ) return false;
+    if( size_t(end-p) < length ) return false;
+    s.assign( p, length );
+    p += length;
+    return true;
+}
+
+static bool readMetadataRanges(const char *&p,const char *end,vector< MinMax > &ranges){
+    unsigned int numRanges = 0;
+    if( !readMetadataBytes( p, end, &numRanges, sizeof(numRanges) ) ) return false;
+    if( size_t(end-p) / (2*sizeof(double)) < numRanges ) return false;
+    ranges.resize( numRanges );
+    for(UINT i=0; i<numRanges; i++){
+        readMetadataBytes( p, end, &ranges[i].minValue, sizeof(double) );
+        readMetadataBytes( p, end, &ranges[i].maxValue, sizeof(double) );
+    }
+    return true;
+}
+
+////////////////////////////// BinaryDatasetFile //////////////////////////////
+
+BinaryDatasetFile::BinaryDatasetFile(){
+    clearHeader();
+}
+
+BinaryDatasetFile::~BinaryDatasetFile(){}
+
+void BinaryDatasetFile::clearHeader(){
+    datasetType = UNKNOWN_DATASET;
+    numDimensions = 0;
+    numTargetDimensions = 0;
+    chunkSize = 0;
+    numChunks = 0;
+    totalNumRows = 0;
+    numSamples = 0;
+    datasetName = "NOT_SET";
+    infoText = "";
+    useExternalRanges = false;
+    externalRanges.clear();
+    externalTargetRanges.clear();
+    classTracker.clear();
+}
+
+bool BinaryDatasetFile::isValidDatasetType(UINT datasetType){
+    return datasetType >= LABELLED_CLASSIFICATION_DATA && datasetType <= LABELLED_REGRESSION_DATA;
+}
+
+size_t BinaryDatasetFile::getChunkSizeInBytes(UINT numRows,UINT numColumns){
+    //The class labels and sample indexs are each padded to 8 bytes so the columns of doubles are aligned
+    return 2*getAlignedSize( size_t(numRows)*sizeof(UINT) ) + size_t(numRows)*numColumns*sizeof(double);
+}
+
+////////////////////////////// BinaryDatasetWriter //////////////////////////////
+
+BinaryDatasetWriter::BinaryDatasetWriter():errorLog("[ERROR BinaryDatasetWriter]"){
+    userClassTracker = false;
+    hasLastSampleIndex = false;
+    lastSampleIndex = 0;
+    numRowsInChunk = 0;
+}
+
+BinaryDatasetWriter::~BinaryDatasetWriter(){
+    if( file.is_open() ) close();
+}
+
+bool BinaryDatasetWriter::open(const string &filename,UINT datasetType,UINT numDimensions,UINT numTargetDimensions,UINT chunkSize){
+
+    if( file.is_open() ) file.close();
+    clearHeader();
+    chunkIndex.clear();
+    userClassTracker = false;
+    hasLastSampleIndex = false;
+    numRowsInChunk = 0;
+
+    if( !isValidDatasetType( datasetType ) ){
+        errorLog << "open(...) - Unknown dataset type: " << datasetType << endl;
+        return false;
+    }
+
+    if( numDimensions == 0 || chunkSize == 0 ){
+        errorLog << "open(...) - The number of dimensions and the chunk size must be greater than zero!" << endl;
+        return false;
+    }
+
+    if( (datasetType == LABELLED_REGRESSION_DATA) != (numTargetDimensions > 0) ){
+        errorLog << "open(...) - The number of target dimensions must be greater than zero for regression data, and zero for all other data!" << endl;
+        return false;
+    }
+
+    file.open( filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+
+    if( !file.is_open() ){
+        errorLog << "open(...) - Failed to create file: " << filename << endl;
+        return false;
+    }
+
+    this->datasetType = datasetType;
+    this->numDimensions = numDimensions;
+    this->numTargetDimensions = numTargetDimensions;
+    this->chunkSize = chunkSize;
+
+    const UINT numColumns = numDimensions + numTargetDimensions;
+    chunkClassLabels.resize( chunkSize );
+    chunkSampleIndexs.resize( chunkSize );
+    chunkValues.resize( size_t(chunkSize)*numColumns );
+
+    //Write an empty header, this is filled in when the file is closed so a file that was not closed will not be read
+    FileHeader header;
+    memset( &header, 0, sizeof(header) );
+    file.write( (const char*)&header, sizeof(header) );
+
+    return file.good();
+}
+
+bool BinaryDatasetWriter::close(){
+
+    if( !file.is_open() ) return false;
+
+    bool ok = true;
+    if( numRowsInChunk > 0 ) ok = writeChunk();
+
+    //Write the metadata and the chunk index after the last chunk
+    FileHeader header;
+    memset( &header, 0, sizeof(header) );
+    ok = ok && writePadding();
+    header.metadataOffset = (unsigned long long)file.tellp();
+    ok = ok && writeMetadata( header.metadataSize );
+    ok = ok && writePadding();
+    header.indexOffset = (unsigned long long)file.tellp();
+    if( ok && chunkIndex.size() > 0 ){
+        file.write( (const char*)&chunkIndex[0], chunkIndex.size()*sizeof(ChunkIndexEntry) );
+    }
+
+    //Fill in the header now the offsets are known
+    memcpy( header.magic, fileMagic, sizeof(fileMagic) );
+    header.byteOrderMarker = fileByteOrderMarker;
+    header.datasetType = datasetType;
+    header.numDimensions = numDimensions;
+    header.numTargetDimensions = numTargetDimensions;
+    header.chunkSize = chunkSize;
+    header.numChunks = numChunks;
+    header.totalNumRows = totalNumRows;
+    header.numSamples = numSamples;
+    if( ok ){
+        file.seekp( 0, std::ios::beg );
+        file.write( (const char*)&header, sizeof(header) );
+    }
+
+    ok = ok && file.good();
+    file.close();
+
+    if( !ok ){
+        errorLog << "close() - Failed to write the file!" << endl;
+    }
+
+    chunkClassLabels.clear();
+    chunkSampleIndexs.clear();
+    chunkValues.clear();
+    chunkIndex.clear();
+
+    return ok;
+}
+
+bool BinaryDatasetWriter::addRow(UINT classLabel,UINT sampleIndex,const double *values,const double *targets){
+
+    if( !file.is_open() ){
+        errorLog << "addRow(...) - The file is not open!" << endl;
+        return false;
+    }
+
+    if( numTargetDimensions > 0 && targets == NULL ){
+        errorLog << "addRow(...) - The targets can not be NULL for regression data!" << endl;
+        return false;
+    }
+
+    //Keep track of the number of samples, each time series is one sample
+    bool newSample = true;
+    if( datasetType == LABELLED_TIME_SERIES_CLASSIFICATION_DATA ){
+        newSample = !hasLastSampleIndex || sampleIndex != lastSampleIndex;
+        hasLastSampleIndex = true;
+        lastSampleIndex = sampleIndex;
+    }
+    if( newSample ){
+        numSamples++;
+        if( !userClassTracker && datasetType != UNLABELLED_CLASSIFICATION_DATA && datasetType != LABELLED_REGRESSION_DATA ){
+            bool classFound = false;
+            for(UINT k=0; k<classTracker.size(); k++){
+                if( classTracker[k].classLabel == classLabel ){
+                    classTracker[k].counter++;
+                    classFound = true;
+                    break;
+                }
+            }
+            if( !classFound ) classTracker.push_back( ClassTracker(classLabel,1) );
+        }
+    }
+
+    //Store the row in the chunk buffer, the values are stored one column per dimension
+    const UINT row = numRowsInChunk;
+    chunkClassLabels[row] = classLabel;
+    chunkSampleIndexs[row] = sampleIndex;
+    double *column = &chunkValues[0] + row;
+    for(UINT j=0; j<numDimensions; j++){
+        *column = values[j];
+        column += chunkSize;
+    }
+    for(UINT t=0; t<numTargetDimensions; t++){
+        *column = targets[t];
+        column += chunkSize;
+    }
+    numRowsInChunk++;
+    totalNumRows++;
+
+    if( numRowsInChunk == chunkSize ) return writeChunk();
+
+    return true;
+}
+
+bool BinaryDatasetWriter::writeChunk(){
+
+    ChunkIndexEntry entry;
+    memset( &entry, 0, sizeof(entry) );
+    entry.offset = (unsigned long long)file.tellp();
+    entry.firstRow = totalNumRows - numRowsInChunk;
+    entry.numRows = numRowsInChunk;
+
+    //Only the filled part of each column is written, so the last chunk can be smaller than the others
+    const UINT numColumns = numDimensions + numTargetDimensions;
+    file.write( (const char*)&chunkClassLabels[0], numRowsInChunk*sizeof(UINT) );
+    writePadding();
+    file.write( (const char*)&chunkSampleIndexs[0], numRowsInChunk*sizeof(UINT) );
+    writePadding();
+    for(UINT j=0; j<numColumns; j++){
+        file.write( (const char*)&chunkValues[ size_t(j)*chunkSize ], numRowsInChunk*sizeof(double) );
+    }
+
+    chunkIndex.push_back( entry );
+    numChunks++;
+    numRowsInChunk = 0;
+
+    if( !file.good() ){
+        errorLog << "writeChunk() - Failed to write chunk " << numChunks << endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool BinaryDatasetWriter::writePadding(){
+    const unsigned long long position = (unsigned long long)file.tellp();
+    const char zeros[8] = {0,0,0,0,0,0,0,0};
+    const size_t paddingSize = getAlignedSize( (size_t)position ) - (size_t)position;
+    if( paddingSize > 0 ) file.write( zeros, paddingSize );
+    return file.good();
+}
+
+void BinaryDatasetWriter::writeString(const string &s){
+    const unsigned int length = (unsigned int)s.size();
+    file.write( (const char*)&length, sizeof(length) );
+    file.write( s.c_str(), length );
+}
+
+bool BinaryDatasetWriter::writeMetadata(unsigned long long &metadataSize){
+
+    const unsigned long long startPosition = (unsigned long long)file.tellp();
+
+    writeString( datasetName );
+    writeString( infoText );
+
+    const unsigned int useRanges = useExternalRanges ? 1 : 0;
+    file.write( (const char*)&useRanges, sizeof(useRanges) );
+
+    const vector< MinMax > *ranges[2] = { &externalRanges, &externalTargetRanges };
+    for(UINT k=0; k<2; k++){
+        const unsigned int numRanges = (unsigned int)ranges[k]->size();
+        file.write( (const char*)&numRanges, sizeof(numRanges) );
+        for(UINT i=0; i<numRanges; i++){
+            file.write( (const char*)&(*ranges[k])[i].minValue, sizeof(double) );
+            file.write( (const char*)&(*ranges[k])[i].maxValue, sizeof(double) );
+        }
+    }
+
+    const unsigned int numClasses = (unsigned int)classTracker.size();
+    file.write( (const char*)&numClasses, sizeof(numClasses) );
+    for(UINT k=0; k<numClasses; k++){
+        const unsigned int classLabel = classTracker[k].classLabel;
+        const unsigned int counter = classTracker[k].counter;
+        file.write( (const char*)&classLabel, sizeof(classLabel) );
+        file.write( (const char*)&counter, sizeof(counter) );
+        writeString( classTracker[k].className );
+    }
+
+    metadataSize = (unsigned long long)file.tellp() - startPosition;
+
+    return file.good();
+}
+
+bool BinaryDatasetWriter::setDatasetName(const string &datasetName){
+    this->datasetName = datasetName;
+    return true;
+}
+
+bool BinaryDatasetWriter::setInfoText(const string &infoText){
+    this->infoText = infoText;
+    return true;
+}
+
+bool BinaryDatasetWriter::setClassTracker(const vector< ClassTracker > &classTracker){
+    this->classTracker = classTracker;
+    userClassTracker = true;
+    return true;
+}
+
+bool BinaryDatasetWriter::setExternalRanges(const vector< MinMax > &externalRanges,const vector< MinMax > &externalTargetRanges,bool useExternalRanges){
+    this->externalRanges = externalRanges;
+    this->externalTargetRanges = externalTargetRanges;
+    this->useExternalRanges = useExternalRanges;
+    return true;
+}
+
+////////////////////////////// BinaryDatasetReader //////////////////////////////
+
+BinaryDatasetReader::BinaryDatasetReader():errorLog("[ERROR BinaryDatasetReader]"){
+    chunkIndex = NULL;
+    currentChunk = 0;
+}
+
+BinaryDatasetReader::~BinaryDatasetReader(){
+    close();
+}
+
+bool BinaryDatasetReader::open(const string &filename){
+
+    close();
+
+    if( !mappedFile.open( filename ) ){
+        errorLog << "open(const string &filename) - Failed to open file: " << filename << endl;
+        return false;
+    }
+
+    const char *fileData = mappedFile.getData();
+    const size_t fileSize = mappedFile.getSize();
+
+    FileHeader header;
+    if( fileSize < sizeof(header) ){
+        errorLog << "open(const string &filename) - The file is too small to be a binary dataset file: " << filename << endl;
+        close();
+        return false;
+    }
+    memcpy( &header, fileData, sizeof(header) );
+
+    if( memcmp( header.magic, fileMagic, sizeof(fileMagic) ) != 0 ){
+        errorLog << "open(const string &filename) - The file is not a binary dataset file (or it was not closed after it was written): " << filename << endl;
+        close();
+        return false;
+    }
+
+    if( header.byteOrderMarker != fileByteOrderMarker ){
+        errorLog << "open(const string &filename) - The file was written on a machine with a different byte order: " << filename << endl;
+        close();
+        return false;
+    }
+
+    if( !isValidDatasetType( header.datasetType ) || header.numDimensions == 0 || header.chunkSize == 0 ){
+        errorLog << "open(const string &filename) - The header of the file is not valid: " << filename << endl;
+        close();
+        return false;
+    }
+
+    const unsigned long long indexSize = (unsigned long long)header.numChunks * sizeof(ChunkIndexEntry);
+    if( header.indexOffset % 8 != 0 || header.indexOffset > fileSize || indexSize > fileSize - header.indexOffset ||
+        header.metadataOffset > fileSize || header.metadataSize > fileSize - header.metadataOffset ){
+        errorLog << "open(const string &filename) - The file is truncated: " << filename << endl;
+        close();
+        return false;
+    }
+
+    datasetType = header.datasetType;
+    numDimensions = header.numDimensions;
+    numTargetDimensions = header.numTargetDimensions;
+    chunkSize = header.chunkSize;
+    numChunks = header.numChunks;
+    totalNumRows = header.totalNumRows;
+    numSamples = (UINT)header.numSamples;
+    chunkIndex = numChunks > 0 ? (const ChunkIndexEntry*)(fileData + header.indexOffset) : NULL;
+
+    //Check that every chunk is inside the file, so the chunks can be used later without any more checks
+    const UINT numColumns = numDimensions + numTargetDimensions;
+    unsigned long long numRows = 0;
+    for(UINT i=0; i<numChunks; i++){
+        const ChunkIndexEntry &entry = chunkIndex[i];
+        if( entry.offset % 8 != 0 || entry.numRows > chunkSize || entry.firstRow != numRows ||
+            entry.offset > fileSize || getChunkSizeInBytes( entry.numRows, numColumns ) > fileSize - entry.offset ){
+            errorLog << "open(const string &filename) - Chunk " << i << " is not valid in file: " << filename << endl;
+            close();
+            return false;
+        }
+        numRows += entry.numRows;
+    }
+    if( numRows != totalNumRows ){
+        errorLog << "open(const string &filename) - The number of rows in the chunks does not match the header of file: " << filename << endl;
+        close();
+        return false;
+    }
+
+    if( !readMetadata( fileData + header.metadataOffset, (size_t)header.metadataSize ) ){
+        errorLog << "open(const string &filename) - Failed to read the metadata of file: " << filename << endl;
+        close();
+        return false;
+    }
+
+    currentChunk = 0;
+
+    return true;
+}
+
+bool BinaryDatasetReader::close(){
+    mappedFile.close();
+    chunkIndex = NULL;
+    currentChunk = 0;
+    clearHeader();
+    return true;
+}
+
+bool BinaryDatasetReader::reset(){
+    if( !mappedFile.is_open() ) return false;
+    currentChunk = 0;
+    return true;
+}
+
+bool BinaryDatasetReader::readNextChunk(BinaryDatasetChunk &chunk){
+    if( !getChunk( currentChunk, chunk ) ) return false;
+    currentChunk++;
+    return true;
+}
+
+bool BinaryDatasetReader::getChunk(UINT chunkIndex,BinaryDatasetChunk &chunk) const{
+
+    chunk.clear();
+
+    if( !mappedFile.is_open() || chunkIndex >= numChunks ) return false;
+
+    const ChunkIndexEntry &entry = this->chunkIndex[ chunkIndex ];
+    const char *chunkData = mappedFile.getData() + entry.offset;
+    const size_t labelsSize = getAlignedSize( size_t(entry.numRows)*sizeof(UINT) );
+
+    chunk.numRows = entry.numRows;
+    chunk.numColumns = numDimensions + numTargetDimensions;
+    chunk.numDimensions = numDimensions;
+    chunk.firstRow = entry.firstRow;
+    chunk.classLabels = (const UINT*)chunkData;
+    chunk.sampleIndexs = (const UINT*)(chunkData + labelsSize);
+    chunk.values = (const double*)(chunkData + 2*labelsSize);
+
+    return true;
+}
+
+bool BinaryDatasetReader::readMetadata(const char *metadata,size_t metadataSize){
+
+    const char *p = metadata;
+    const char *end = metadata + metadataSize;
+
+    if( !readMetadataString( p, end, datasetName ) ) return false;
+    if( !readMetadataString( p, end, infoText ) ) return false;
+
+    unsigned int useRanges = 0;
+    if( !readMetadataBytes( p, end, &useRanges, sizeof(useRanges) ) ) return false;
+    useExternalRanges = useRanges == 1;
+
+    if( !readMetadataRanges( p, end, externalRanges ) ) return false;
+    if( !readMetadataRanges( p, end, externalTargetRanges ) ) return false;
+
+    unsigned int numClasses = 0;
+    if( !readMetadataBytes( p, end, &numClasses, sizeof(numClasses) ) ) return false;
+    classTracker.clear();
+    for(UINT k=0; k<numClasses; k++){
+        ClassTracker tracker;
+        if( !readMetadataBytes( p, end, &tracker.classLabel, sizeof(UINT) ) ) return false;
+        if( !readMetadataBytes( p, end, &tracker.counter, sizeof(UINT) ) ) return false;
+        if( !readMetadataString( p, end, tracker.className ) ) return false;
+        classTracker.push_back( tracker );
+    }
+
+    return true;
+}
+
+bool BinaryDatasetReader::isBinaryDatasetFile(const string &filename){
+    std::ifstream file( filename.c_str(), std::ios::in | std::ios::binary );
+    if( !file.is_open() ) return false;
+    char magic[8];
+    if( !file.read( magic, sizeof(magic) ) ) return false;
+    return memcmp( magic, fileMagic, sizeof(fileMagic) ) == 0;
+}
+
+}//End of namespace GRT
@@ -0,0 +1,461 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The BinaryDatasetWriter and BinaryDatasetReader write and read the GRT binary dataset format. This format stores any of
+ the GRT datasets (classification, time series, continuous time series, regression or unlabelled data) as a sequence of
+ fixed size chunks, so a dataset that is too large to fit in memory can be written and then read back one chunk at a time.
+
+ The file is laid out as:
+ - a fixed size header (the dataset type, the number of dimensions, the chunk size and the offsets of the other sections)
+ - the chunks, each chunk stores the class labels and sample indexs of its rows followed by one column of values per
+   dimension (so the values of each dimension are contiguous)
+ - the metadata (the dataset name, info text, class tracker and external ranges)
+ - the chunk index, which gives the offset and first row of every chunk
+
+ Each row is one N-dimensional sample (for regression data the N input values are followed by T target values). Time
+ series datasets store one row per time step, the sample index of a row is the index of the time series it belongs to.
+ Every section starts on an 8 byte boundary, so the reader memory maps the file and returns pointers straight into it,
+ no values are copied or parsed when a chunk is read.
+
+ The values are stored in the byte order of the machine that wrote the file, the reader will reject a file that was
+ written with a different byte order.
+ */
+
+#ifndef GRT_BINARY_DATASET_FILE_HEADER
+#define GRT_BINARY_DATASET_FILE_HEADER
+
+#include "../Util/GRTCommon.h"
+
+namespace GRT{
+
+class BinaryDatasetFile{
+public:
+    /**
+     Default Constructor
+     */
+    BinaryDatasetFile();
+
+    /**
+     Default Destructor
+     */
+    virtual ~BinaryDatasetFile();
+
+    /**
+     @return returns the type of dataset stored in the file (one of the DatasetTypes)
+     */
+    UINT getDatasetType() const { return datasetType; }
+
+    /**
+     @return returns the number of dimensions of each sample (the number of input dimensions for regression data)
+     */
+    UINT getNumDimensions() const { return numDimensions; }
+
+    /**
+     @return returns the number of target dimensions (this is only non-zero for regression data)
+     */
+    UINT getNumTargetDimensions() const { return numTargetDimensions; }
+
+    /**
+     @return returns the maximum number of rows in each chunk
+     */
+    UINT getChunkSize() const { return chunkSize; }
+
+    /**
+     @return returns the number of chunks in the file
+     */
+    UINT getNumChunks() const { return numChunks; }
+
+    /**
+     @return returns the total number of rows in the file
+     */
+    unsigned long long getTotalNumRows() const { return totalNumRows; }
+
+    /**
+     @return returns the number of samples in the file (for time series data this is the number of time series)
+     */
+    UINT getNumSamples() const { return numSamples; }
+
+    /**
+     @return returns the name of the dataset
+     */
+    string getDatasetName() const { return datasetName; }
+
+    /**
+     @return returns the info text of the dataset
+     */
+    string getInfoText() const { return infoText; }
+
+    /**
+     @return returns the class tracker of the dataset (this is empty for unlabelled and regression data)
+     */
+    const vector< ClassTracker >& getClassTracker() const { return classTracker; }
+
+    /**
+     @return returns true if the dataset should be scaled using its external ranges
+     */
+    bool getUseExternalRanges() const { return useExternalRanges; }
+
+    /**
+     @return returns the external ranges of the dataset (the input ranges for regression data)
+     */
+    const vector< MinMax >& getExternalRanges() const { return externalRanges; }
+
+    /**
+     @return returns the external target ranges of a regression dataset
+     */
+    const vector< MinMax >& getExternalTargetRanges() const { return externalTargetRanges; }
+
+    enum DatasetTypes{ UNKNOWN_DATASET=0, LABELLED_CLASSIFICATION_DATA, UNLABELLED_CLASSIFICATION_DATA, LABELLED_TIME_SERIES_CLASSIFICATION_DATA, LABELLED_CONTINUOUS_TIME_SERIES_CLASSIFICATION_DATA, LABELLED_REGRESSION_DATA };
+
+protected:
+    void clearHeader();
+    static bool isValidDatasetType(UINT datasetType);
+    static size_t getChunkSizeInBytes(UINT numRows,UINT numColumns);
+    static size_t getAlignedSize(size_t numBytes){ return (numBytes + 7) & ~size_t(7); }
+
+    //The fixed size header at the start of the file, all the offsets are from the start of the file
+    struct FileHeader{
+        char magic[8];
+        unsigned int byteOrderMarker;
+        unsigned int datasetType;
+        unsigned int numDimensions;
+        unsigned int numTargetDimensions;
+        unsigned int chunkSize;
+        unsigned int numChunks;
+        unsigned long long totalNumRows;
+        unsigned long long numSamples;
+        unsigned long long metadataOffset;
+        unsigned long long metadataSize;
+        unsigned long long indexOffset;
+    };
+
+    //One entry of the chunk index
+    struct ChunkIndexEntry{
+        unsigned long long offset;
+        unsigned long long firstRow;
+        unsigned int numRows;
+        unsigned int padding;
+    };
+
+    static const char fileMagic[8];
+    static const unsigned int fileByteOrderMarker = 0x01020304;
+
+    UINT datasetType;
+    UINT numDimensions;
+    UINT numTargetDimensions;
+    UINT chunkSize;
+    UINT numChunks;
+    unsigned long long totalNumRows;
+    UINT numSamples;
+    string datasetName;
+    string infoText;
+    bool useExternalRanges;
+    vector< MinMax > externalRanges;
+    vector< MinMax > externalTargetRanges;
+    vector< ClassTracker > classTracker;
+};
+
+/**
+ A view of one chunk of a BinaryDatasetReader. The pointers point into the mapped file, so they are only valid while
+ the reader that filled the chunk is open.
+ */
+class BinaryDatasetChunk{
+public:
+    BinaryDatasetChunk(){ clear(); }
+    ~BinaryDatasetChunk(){}
+
+    void clear(){
+        numRows = 0;
+        numColumns = 0;
+        numDimensions = 0;
+        firstRow = 0;
+        classLabels = NULL;
+        sampleIndexs = NULL;
+        values = NULL;
+    }
+
+    /**
+     @return returns the number of rows in the chunk
+     */
+    UINT getNumRows() const { return numRows; }
+
+    /**
+     @return returns the index (in the whole file) of the first row of the chunk
+     */
+    unsigned long long getFirstRow() const { return firstRow; }
+
+    /**
+     @return returns a pointer to the numRows class labels of the chunk
+     */
+    const UINT* getClassLabels() const { return classLabels; }
+
+    /**
+     @return returns a pointer to the numRows sample indexs of the chunk
+     */
+    const UINT* getSampleIndexs() const { return sampleIndexs; }
+
+    /**
+     @param UINT j: the dimension of the column
+     @return returns a pointer to the numRows values of dimension j
+     */
+    const double* getColumn(UINT j) const { return values + size_t(j)*numRows; }
+
+    /**
+     @param UINT t: the target dimension of the column
+     @return returns a pointer to the numRows target values of target dimension t (regression data only)
+     */
+    const double* getTargetColumn(UINT t) const { return values + size_t(numDimensions+t)*numRows; }
+
+    /**
+     @param UINT row: the row in the chunk
+     @param UINT j: the dimension
+     @return returns the value of dimension j of the row
+     */
+    double getValue(UINT row,UINT j) const { return values[ size_t(j)*numRows + row ]; }
+
+    /**
+     Gathers the input values of one row into the sample buffer, the sample should have the size of numDimensions.
+
+     @param UINT row: the row in the chunk
+     @param double *sample: the buffer the values are written to
+     */
+    void getSample(UINT row,double *sample) const {
+        const double *v = values + row;
+        for(UINT j=0; j<numDimensions; j++){
+            sample[j] = *v;
+            v += numRows;
+        }
+    }
+
+    /**
+     Gathers the target values of one row into the target buffer, the target should have the size of numTargetDimensions.
+
+     @param UINT row: the row in the chunk
+     @param double *target: the buffer the values are written to
+     */
+    void getTarget(UINT row,double *target) const {
+        const double *v = values + size_t(numDimensions)*numRows + row;
+        for(UINT t=numDimensions; t<numColumns; t++){
+            *target++ = *v;
+            v += numRows;
+        }
+    }
+
+    UINT numRows;
+    UINT numColumns;
+    UINT numDimensions;
+    unsigned long long firstRow;
+    const UINT *classLabels;
+    const UINT *sampleIndexs;
+    const double *values;
+};
+
+class BinaryDatasetWriter : public BinaryDatasetFile{
+public:
+    /**
+     Default Constructor
+     */
+    BinaryDatasetWriter();
+
+    /**
+     Default Destructor, closes the file if it is open
+     */
+    virtual ~BinaryDatasetWriter();
+
+    /**
+     Creates a new binary dataset file. Rows can then be added with addRow, and the file is finished by calling close.
+
+     @param const string &filename: the name of the file to create
+     @param UINT datasetType: the type of dataset (one of the DatasetTypes)
+     @param UINT numDimensions: the number of dimensions of each sample (the number of input dimensions for regression data)
+     @param UINT numTargetDimensions: the number of target dimensions, this should only be set for regression data
+     @param UINT chunkSize: the maximum number of rows in each chunk
+     @return returns true if the file was created, false otherwise
+     */
+    bool open(const string &filename,UINT datasetType,UINT numDimensions,UINT numTargetDimensions = 0,UINT chunkSize = 10000);
+
+    /**
+     Writes the last chunk, the metadata and the chunk index and then closes the file. A file that is not closed is not valid.
+
+     @return returns true if the file was written, false otherwise
+     */
+    bool close();
+
+    /**
+     @return returns true if the file is open, false otherwise
+     */
+    bool is_open() const { return file.is_open(); }
+
+    /**
+     Adds a row to the file, the row is buffered and written when its chunk is full.
+
+     @param UINT classLabel: the class label of the row (use 0 for unlabelled and regression data)
+     @param UINT sampleIndex: the index of the sample the row belongs to, for time series data all the rows of a time series must have the same index
+     @param const double *values: the numDimensions values of the row
+     @param const double *targets: the numTargetDimensions target values of the row (regression data only)
+     @return returns true if the row was added, false otherwise
+     */
+    bool addRow(UINT classLabel,UINT sampleIndex,const double *values,const double *targets = NULL);
+
+    /**
+     Sets the name of the dataset.
+
+     @param const string &datasetName: the name of the dataset
+     @return returns true if the name was set
+     */
+    bool setDatasetName(const string &datasetName);
+
+    /**
+     Sets the info text of the dataset.
+
+     @param const string &infoText: the info text
+     @return returns true if the info text was set
+     */
+    bool setInfoText(const string &infoText);
+
+    /**
+     Sets the class tracker that will be written to the file. If this is not set, the class tracker is built from the
+     class labels of the rows that are added (for labelled data).
+
+     @param const vector< ClassTracker > &classTracker: the class tracker of the dataset
+     @return returns true if the class tracker was set
+     */
+    bool setClassTracker(const vector< ClassTracker > &classTracker);
+
+    /**
+     Sets the external ranges that will be written to the file.
+
+     @param const vector< MinMax > &externalRanges: the ranges of the input dimensions
+     @param const vector< MinMax > &externalTargetRanges: the ranges of the target dimensions (regression data only)
+     @param bool useExternalRanges: if true the dataset should be scaled using the ranges when it is loaded
+     @return returns true if the ranges were set, false otherwise
+     */
+    bool setExternalRanges(const vector< MinMax > &externalRanges,const vector< MinMax > &externalTargetRanges,bool useExternalRanges);
+
+protected:
+    bool writeChunk();
+    bool writeMetadata(unsigned long long &metadataSize);
+    bool writePadding();
+    void writeString(const string &s);
+
+    std::fstream file;
+    bool userClassTracker;
+    bool hasLastSampleIndex;
+    UINT lastSampleIndex;
+    UINT numRowsInChunk;
+    vector< UINT > chunkClassLabels;
+    vector< UINT > chunkSampleIndexs;
+    vector< double > chunkValues;
+    vector< ChunkIndexEntry > chunkIndex;
+
+    ErrorLog errorLog;
+};
+
+class BinaryDatasetReader : public BinaryDatasetFile{
+public:
+    /**
+     Default Constructor
+     */
+    BinaryDatasetReader();
+
+    /**
+     Default Destructor, closes the file if it is open
+     */
+    virtual ~BinaryDatasetReader();
+
+    /**
+     Memory maps a binary dataset file and reads its header, metadata and chunk index.
+
+     @param const string &filename: the name of the file to open
+     @return returns true if the file was opened and is a valid binary dataset file, false otherwise
+     */
+    bool open(const string &filename);
+
+    /**
+     Unmaps the file, any chunks returned by the reader are no longer valid after this.
+
+     @return returns true if the file was closed
+     */
+    bool close();
+
+    /**
+     @return returns true if the file is open, false otherwise
+     */
+    bool is_open() const { return mappedFile.is_open(); }
+
+    /**
+     Moves the reader back to the first chunk.
+
+     @return returns true if the reader was reset, false if no file is open
+     */
+    bool reset();
+
+    /**
+     Gets the next chunk of the file.
+
+     @param BinaryDatasetChunk &chunk: the chunk that will point to the next chunk of the file
+     @return returns true if a chunk was read, false if there are no more chunks (or no file is open)
+     */
+    bool readNextChunk(BinaryDatasetChunk &chunk);
+
+    /**
+     Gets any chunk of the file, this does not change the position of readNextChunk.
+
+     @param UINT chunkIndex: the index of the chunk, must be less than the number of chunks
+     @param BinaryDatasetChunk &chunk: the chunk that will point to the chunk of the file
+     @return returns true if the chunk was read, false otherwise
+     */
+    bool getChunk(UINT chunkIndex,BinaryDatasetChunk &chunk) const;
+
+    /**
+     @return returns the index of the chunk that will be returned by the next call to readNextChunk
+     */
+    UINT getCurrentChunkIndex() const { return currentChunk; }
+
+    /**
+     Checks if a file starts with the header of a binary dataset file.
+
+     @param const string &filename: the name of the file to check
+     @return returns true if the file is a binary dataset file, false otherwise
+     */
+    static bool isBinaryDatasetFile(const string &filename);
+
+protected:
+    bool readMetadata(const char *metadata,size_t metadataSize);
+
+    MemoryMappedFile mappedFile;
+    const ChunkIndexEntry *chunkIndex;
+    UINT currentChunk;
+
+    ErrorLog errorLog;
+
+private:
+    BinaryDatasetReader(const BinaryDatasetReader &rhs);
+    BinaryDatasetReader& operator=(const BinaryDatasetReader &rhs);
+};
+
+}//End of namespace GRT
+
+#endif //GRT_BINARY_DATASET_FILE_HEADER
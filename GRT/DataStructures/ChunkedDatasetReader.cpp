@@ -0,0 +1,297 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ChunkedDatasetReader.h"
+
+namespace GRT{
+
+ChunkedDatasetReader::ChunkedDatasetReader(UINT chunkSize):errorLog("[ERROR ChunkedDatasetReader]"),warningLog("[WARNING ChunkedDatasetReader]"){
+    this->chunkSize = chunkSize > 0 ? chunkSize : 1;
+    numDimensions = 0;
+    fileIndex = 0;
+    fileType = UNKNOWN_FILE_TYPE;
+    numSamplesRemaining = 0;
+    numTimeStepsRemaining = 0;
+    currentClassLabel = 0;
+    binaryChunkRow = 0;
+    numRowsRead = 0;
+    fileOpen = false;
+    parser = NULL;
+}
+
+ChunkedDatasetReader::~ChunkedDatasetReader(){
+    close();
+}
+
+bool ChunkedDatasetReader::open(const string &filename){
+    return open( vector< string >(1,filename) );
+}
+
+bool ChunkedDatasetReader::open(const vector< string > &filenames){
+
+    close();
+
+    if( filenames.size() == 0 ){
+        errorLog << "open(const vector< string > &filenames) - The list of files is empty!" << endl;
+        return false;
+    }
+
+    this->filenames = filenames;
+
+    return openFile( 0 );
+}
+
+bool ChunkedDatasetReader::close(){
+    closeTextFile();
+    binaryFile.close();
+    binaryChunk.clear();
+    fileOpen = false;
+    fileIndex = 0;
+    fileType = UNKNOWN_FILE_TYPE;
+    numDimensions = 0;
+    numSamplesRemaining = 0;
+    numTimeStepsRemaining = 0;
+    numRowsRead = 0;
+    filenames.clear();
+    chunkClassLabels.clear();
+    return true;
+}
+
+bool ChunkedDatasetReader::reset(){
+    if( filenames.size() == 0 ){
+        errorLog << "reset() - No files have been opened!" << endl;
+        return false;
+    }
+    numRowsRead = 0;
+    return openFile( 0 );
+}
+
+bool ChunkedDatasetReader::setChunkSize(UINT chunkSize){
+    if( chunkSize > 0 ){
+        this->chunkSize = chunkSize;
+        return true;
+    }
+    return false;
+}
+
+UINT ChunkedDatasetReader::readChunk(MatrixDouble &chunk){
+
+    if( !fileOpen ) return 0;
+
+    if( chunk.getNumRows() != chunkSize || chunk.getNumCols() != numDimensions ){
+        chunk.resize(chunkSize,numDimensions);
+    }
+    if( chunkClassLabels.size() != chunkSize ){
+        chunkClassLabels.resize(chunkSize);
+    }
+
+    UINT numRows = 0;
+    while( numRows < chunkSize ){
+        if( !readRow( chunk[numRows], chunkClassLabels[numRows] ) ) break;
+        numRows++;
+    }
+
+    numRowsRead += numRows;
+
+    return numRows;
+}
+
+bool ChunkedDatasetReader::openFile(UINT fileIndex){
+
+    closeTextFile();
+    binaryFile.close();
+    binaryChunk.clear();
+    fileOpen = false;
+
+    if( fileIndex >= filenames.size() ) return false;
+
+    this->fileIndex = fileIndex;
+
+    //Binary files are memory mapped, and their rows are copied straight out of the chunks of the file
+    if( BinaryDatasetReader::isBinaryDatasetFile( filenames[fileIndex] ) ){
+        if( !binaryFile.open( filenames[fileIndex] ) ){
+            errorLog << "openFile(UINT fileIndex) - Failed to open binary file: " << filenames[fileIndex] << endl;
+            return false;
+        }
+        fileType = BINARY_DATASET_FILE;
+        binaryChunkRow = 0;
+        return checkNumDimensions( binaryFile.getNumDimensions() );
+    }
+
+    file.open(filenames[fileIndex].c_str(), std::ios::in);
+
+    if( !file.is_open() ){
+        errorLog << "openFile(UINT fileIndex) - Failed to open file: " << filenames[fileIndex] << endl;
+        return false;
+    }
+
+    parser = new FileTokenizer( file );
+
+    //Work out which type of dataset this is and which keyword marks the start of the data
+    string word;
+    string dataKeyword;
+    string numSamplesKeyword = "TotalNumTrainingExamples:";
+    parser->readValue( word );
+    if( word == "GRT_LABELLED_CLASSIFICATION_DATA_FILE_V1.0" ){
+        fileType = LABELLED_CLASSIFICATION_FILE;
+        dataKeyword = "LabelledTrainingData:";
+    }else if( word == "GRT_UNLABELLED_CLASSIFICATION_DATA_FILE_V1.0" ){
+        fileType = UNLABELLED_CLASSIFICATION_FILE;
+        dataKeyword = "UnlabelledTrainingData:";
+    }else if( word == "GRT_LABELLED_TIME_SERIES_CLASSIFICATION_DATA_FILE_V1.0" ){
+        fileType = LABELLED_TIME_SERIES_FILE;
+        dataKeyword = "LabelledTimeSeriesTrainingData:";
+    }else if( word == "GRT_LABELLED_CONTINUOUS_TIME_SERIES_CLASSIFICATION_FILE_V1.0" ){
+        fileType = LABELLED_CONTINUOUS_TIME_SERIES_FILE;
+        dataKeyword = "LabelledContinuousTimeSeriesClassificationData:";
+        numSamplesKeyword = "TotalNumSamples:";
+    }else{
+        errorLog << "openFile(UINT fileIndex) - Unknown file header: " << word << " in file: " << filenames[fileIndex] << endl;
+        closeTextFile();
+        return false;
+    }
+
+    //Skip over the rest of the header, keeping the number of dimensions and samples
+    UINT fileNumDimensions = 0;
+    bool foundNumDimensions = false;
+    bool foundNumSamples = false;
+    numSamplesRemaining = 0;
+    numTimeStepsRemaining = 0;
+    bool foundData = false;
+    while( parser->readValue( word ) ){
+        if( word == dataKeyword ){
+            foundData = true;
+            break;
+        }
+        if( !foundNumDimensions && word == "NumDimensions:" ){
+            foundNumDimensions = parser->readValue( fileNumDimensions );
+        }else if( !foundNumSamples && word == numSamplesKeyword ){
+            foundNumSamples = parser->readValue( numSamplesRemaining );
+        }
+    }
+
+    if( !foundData || !foundNumDimensions || !foundNumSamples || fileNumDimensions == 0 ){
+        errorLog << "openFile(UINT fileIndex) - Failed to parse the header of file: " << filenames[fileIndex] << endl;
+        closeTextFile();
+        return false;
+    }
+
+    return checkNumDimensions( fileNumDimensions );
+}
+
+bool ChunkedDatasetReader::checkNumDimensions(UINT fileNumDimensions){
+
+    if( fileIndex == 0 ){
+        numDimensions = fileNumDimensions;
+    }else if( fileNumDimensions != numDimensions ){
+        errorLog << "openFile(UINT fileIndex) - The number of dimensions in file: " << filenames[fileIndex] << " (" << fileNumDimensions << ") does not match the first file (" << numDimensions << ")!" << endl;
+        closeTextFile();
+        binaryFile.close();
+        return false;
+    }
+
+    fileOpen = true;
+    return true;
+}
+
+void ChunkedDatasetReader::closeTextFile(){
+    if( parser != NULL ){
+        delete parser;
+        parser = NULL;
+    }
+    if( file.is_open() ) file.close();
+    file.clear();
+}
+
+bool ChunkedDatasetReader::readRow(double *row,UINT &classLabel){
+
+    while( fileOpen ){
+
+        if( fileType == BINARY_DATASET_FILE ){
+            //Move to the next chunk if needed
+            if( binaryChunkRow >= binaryChunk.getNumRows() ){
+                binaryChunkRow = 0;
+                if( !binaryFile.readNextChunk( binaryChunk ) ) binaryChunk.clear();
+            }
+            if( binaryChunkRow < binaryChunk.getNumRows() ){
+                binaryChunk.getSample( binaryChunkRow, row );
+                classLabel = binaryChunk.getClassLabels()[ binaryChunkRow++ ];
+                return true;
+            }
+        }else if( fileType == LABELLED_TIME_SERIES_FILE ){
+            //Move to the next time series if needed
+            while( numTimeStepsRemaining == 0 && numSamplesRemaining > 0 ){
+                if( !parser->matchWord( "************TIME_SERIES************" ) ){
+                    errorLog << "readRow(double *row,UINT &classLabel) - Failed to find TimeSeries Header in file: " << filenames[fileIndex] << endl;
+                    fileOpen = false;
+                    return false;
+                }
+                if( !parser->matchWord( "ClassID:" ) || !parser->readValue( currentClassLabel ) ){
+                    errorLog << "readRow(double *row,UINT &classLabel) - Failed to find ClassID in file: " << filenames[fileIndex] << endl;
+                    fileOpen = false;
+                    return false;
+                }
+                if( !parser->matchWord( "TimeSeriesLength:" ) || !parser->readValue( numTimeStepsRemaining ) ){
+                    errorLog << "readRow(double *row,UINT &classLabel) - Failed to find TimeSeriesLength in file: " << filenames[fileIndex] << endl;
+                    fileOpen = false;
+                    return false;
+                }
+                if( !parser->matchWord( "TimeSeriesData:" ) ){
+                    errorLog << "readRow(double *row,UINT &classLabel) - Failed to find TimeSeriesData in file: " << filenames[fileIndex] << endl;
+                    fileOpen = false;
+                    return false;
+                }
+                numSamplesRemaining--;
+            }
+
+            if( numTimeStepsRemaining > 0 ){
+                for(UINT j=0; j<numDimensions; j++) *parser >> row[j];
+                classLabel = currentClassLabel;
+                numTimeStepsRemaining--;
+                if( !parser->fail() ) return true;
+                errorLog << "readRow(double *row,UINT &classLabel) - Failed to read sample from file: " << filenames[fileIndex] << endl;
+                fileOpen = false;
+                return false;
+            }
+        }else if( numSamplesRemaining > 0 ){
+            classLabel = 0;
+            if( fileType != UNLABELLED_CLASSIFICATION_FILE ) *parser >> classLabel;
+            for(UINT j=0; j<numDimensions; j++) *parser >> row[j];
+            numSamplesRemaining--;
+            if( !parser->fail() ) return true;
+            errorLog << "readRow(double *row,UINT &classLabel) - Failed to read sample from file: " << filenames[fileIndex] << endl;
+            fileOpen = false;
+            return false;
+        }
+
+        //This file is finished, so move on to the next one
+        if( fileIndex+1 >= filenames.size() ){
+            closeTextFile();
+            binaryFile.close();
+            fileOpen = false;
+            return false;
+        }
+        if( !openFile( fileIndex+1 ) ) return false;
+    }
+
+    return false;
+}
+
+}//End of namespace GRT
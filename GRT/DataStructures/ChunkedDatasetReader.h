@@ -0,0 +1,164 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The ChunkedDatasetReader reads the samples from one or more GRT dataset files a chunk at a time, so algorithms such as
+ mini-batch KMeans can be trained on datasets that are too large to load into memory.
+
+ The reader supports the files saved by the LabelledClassificationData, UnlabelledClassificationData,
+ LabelledTimeSeriesClassificationData and LabelledContinuousTimeSeriesClassificationData classes, and the GRT binary
+ dataset files (see BinaryDatasetFile.h, the input values are returned for binary regression files). Each row of a chunk
+ is one N-dimensional sample; for time series datasets each time step of each time series is returned as a row.
+ All the files added to the reader must have the same number of dimensions.
+ */
+
+#ifndef GRT_CHUNKED_DATASET_READER_HEADER
+#define GRT_CHUNKED_DATASET_READER_HEADER
+
+#include "../Util/GRTCommon.h"
+#include "../Util/FileTokenizer.h"
+#include "BinaryDatasetFile.h"
+
+namespace GRT{
+
+class ChunkedDatasetReader{
+public:
+    /**
+     Default Constructor
+
+     @param UINT chunkSize: the maximum number of rows that will be read by each call to readChunk
+     */
+    ChunkedDatasetReader(UINT chunkSize = 10000);
+
+    /**
+     Default Destructor, closes any open file
+     */
+    ~ChunkedDatasetReader();
+
+    /**
+     Opens a single dataset file, this replaces any files previously added to the reader.
+
+     @param const string &filename: the name of the dataset file
+     @return returns true if the file was opened and its header is valid, false otherwise
+     */
+    bool open(const string &filename);
+
+    /**
+     Opens a list of dataset files, which will be read one after the other as if they were one dataset.
+     This replaces any files previously added to the reader.
+
+     @param const vector< string > &filenames: the names of the dataset files
+     @return returns true if the first file was opened and its header is valid, false otherwise
+     */
+    bool open(const vector< string > &filenames);
+
+    /**
+     Closes the current file and removes all the files from the reader.
+
+     @return returns true if the reader was closed
+     */
+    bool close();
+
+    /**
+     Rewinds the reader to the first sample of the first file.
+
+     @return returns true if the reader was rewound, false otherwise
+     */
+    bool reset();
+
+    /**
+     Reads the next chunk of samples. The chunk matrix will be resized to [chunkSize N] if needed, and the next
+     (up to chunkSize) samples will be written to the first rows of the chunk. The chunk is only resized when its
+     size changes, so the same matrix can be reused for every call without any new allocations.
+
+     @param MatrixDouble &chunk: the matrix the samples will be written to
+     @return returns the number of rows read, this will be 0 once every file has been read (or if an error occurred)
+     */
+    UINT readChunk(MatrixDouble &chunk);
+
+    /**
+     Sets the maximum number of rows that will be read by each call to readChunk.
+
+     @param UINT chunkSize: the chunk size, must be greater than zero
+     @return returns true if the chunk size was updated, false otherwise
+     */
+    bool setChunkSize(UINT chunkSize);
+
+    /**
+     @return returns the maximum number of rows that will be read by each call to readChunk
+     */
+    UINT getChunkSize() const { return chunkSize; }
+
+    /**
+     @return returns the number of dimensions of the samples in the dataset files
+     */
+    UINT getNumDimensions() const { return numDimensions; }
+
+    /**
+     @return returns the class labels of the rows returned by the last call to readChunk (these will be 0 for unlabelled data)
+     */
+    const vector< UINT >& getChunkClassLabels() const { return chunkClassLabels; }
+
+    /**
+     @return returns true if the reader has an open file, false otherwise
+     */
+    bool getIsOpen() const { return fileOpen; }
+
+    /**
+     @return returns the total number of rows returned by readChunk since the reader was opened or reset
+     */
+    unsigned long getNumRowsRead() const { return numRowsRead; }
+
+    enum DatasetFileType{ UNKNOWN_FILE_TYPE=0, LABELLED_CLASSIFICATION_FILE, UNLABELLED_CLASSIFICATION_FILE, LABELLED_TIME_SERIES_FILE, LABELLED_CONTINUOUS_TIME_SERIES_FILE, BINARY_DATASET_FILE };
+
+protected:
+    bool openFile(UINT fileIndex);
+    bool readRow(double *row,UINT &classLabel);
+    bool checkNumDimensions(UINT fileNumDimensions);
+    void closeTextFile();
+
+    UINT chunkSize;
+    UINT numDimensions;
+    UINT fileIndex;
+    UINT fileType;
+    UINT numSamplesRemaining;           //The number of samples (or time series) left in the current file
+    UINT numTimeStepsRemaining;         //The number of rows left in the current time series
+    UINT currentClassLabel;
+    unsigned long numRowsRead;
+    bool fileOpen;
+    vector< string > filenames;
+    vector< UINT > chunkClassLabels;
+    UINT binaryChunkRow;                //The next row to read from the current binary chunk
+    std::fstream file;
+    FileTokenizer *parser;              //Reads the tokens from the current text file
+    BinaryDatasetReader binaryFile;
+    BinaryDatasetChunk binaryChunk;
+
+    ErrorLog errorLog;
+    WarningLog warningLog;
+};
+
+}//End of namespace GRT
+
+#endif //GRT_CHUNKED_DATASET_READER_HEADER
@@ -0,0 +1,236 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FlatClassificationData.h"
+
+namespace GRT{
+
+FlatClassificationData::FlatClassificationData(UINT numDimensions):errorLog("[ERROR FlatClassificationData]"){
+    this->numDimensions = numDimensions;
+    totalNumSamples = 0;
+}
+
+FlatClassificationData::FlatClassificationData(const LabelledClassificationData &data):errorLog("[ERROR FlatClassificationData]"){
+    numDimensions = 0;
+    totalNumSamples = 0;
+    setData( data );
+}
+
+FlatClassificationData::FlatClassificationData(const LabelledClassificationDataView &data):errorLog("[ERROR FlatClassificationData]"){
+    numDimensions = 0;
+    totalNumSamples = 0;
+    setData( data );
+}
+
+FlatClassificationData::~FlatClassificationData(){}
+
+bool FlatClassificationData::setData(const LabelledClassificationData &data){
+
+    const UINT M = data.getNumSamples();
+    numDimensions = data.getNumDimensions();
+    totalNumSamples = M;
+    this->data.resize( size_t(M)*numDimensions );
+    sampleClassLabels.resize( M );
+    classTracker = data.getClassTracker();
+
+    for(UINT i=0; i<M; i++){
+        const LabelledClassificationSample &sample = data[i];
+        double *row = (*this)[i];
+        for(UINT j=0; j<numDimensions; j++){
+            row[j] = sample[j];
+        }
+        sampleClassLabels[i] = sample.getClassLabel();
+    }
+
+    return true;
+}
+
+bool FlatClassificationData::setData(const LabelledClassificationDataView &data){
+
+    //Count the samples, weighted samples are added once for each repeat
+    UINT M = 0;
+    for(UINT k=0; k<data.getNumClasses(); k++){
+        M += data.getClassTracker()[k].counter;
+    }
+
+    numDimensions = data.getNumDimensions();
+    totalNumSamples = 0;
+    this->data.resize( size_t(M)*numDimensions );
+    sampleClassLabels.resize( M );
+    classTracker = data.getClassTracker();
+
+    for(UINT i=0; i<data.getNumSamples(); i++){
+        const LabelledClassificationSample &sample = data[i];
+        const UINT numRepeats = data.getNumRepeats(i);
+        for(UINT r=0; r<numRepeats; r++){
+            double *row = (*this)[totalNumSamples];
+            for(UINT j=0; j<numDimensions; j++){
+                row[j] = sample[j];
+            }
+            sampleClassLabels[totalNumSamples++] = sample.getClassLabel();
+        }
+    }
+
+    return true;
+}
+
+void FlatClassificationData::clear(){
+    totalNumSamples = 0;
+    data.clear();
+    sampleClassLabels.clear();
+    classTracker.clear();
+}
+
+bool FlatClassificationData::setNumDimensions(UINT numDimensions){
+    if( numDimensions == 0 ){
+        errorLog << "setNumDimensions(UINT numDimensions) - The number of dimensions must be greater than zero!" << endl;
+        return false;
+    }
+    clear();
+    this->numDimensions = numDimensions;
+    return true;
+}
+
+bool FlatClassificationData::reserve(UINT numSamples){
+    data.reserve( size_t(numSamples)*numDimensions );
+    sampleClassLabels.reserve( numSamples );
+    return true;
+}
+
+bool FlatClassificationData::addSample(UINT classLabel,const VectorDouble &sample){
+    if( sample.size() != numDimensions ){
+        errorLog << "addSample(UINT classLabel,const VectorDouble &sample) - The size of the sample (" << sample.size() << ") does not match the number of dimensions (" << numDimensions << ")!" << endl;
+        return false;
+    }
+    return addSample( classLabel, numDimensions > 0 ? &sample[0] : NULL );
+}
+
+bool FlatClassificationData::addSample(UINT classLabel,const double *sample){
+
+    if( numDimensions == 0 ){
+        errorLog << "addSample(UINT classLabel,const double *sample) - The number of dimensions has not been set!" << endl;
+        return false;
+    }
+
+    data.insert( data.end(), sample, sample+numDimensions );
+    sampleClassLabels.push_back( classLabel );
+    totalNumSamples++;
+
+    bool labelFound = false;
+    for(UINT k=0; k<classTracker.size(); k++){
+        if( classTracker[k].classLabel == classLabel ){
+            classTracker[k].counter++;
+            labelFound = true;
+            break;
+        }
+    }
+    if( !labelFound ){
+        classTracker.push_back( ClassTracker(classLabel,1) );
+    }
+
+    return true;
+}
+
+bool FlatClassificationData::scale(const vector< MinMax > &ranges,double minTarget,double maxTarget){
+
+    if( ranges.size() != numDimensions ) return false;
+
+    for(UINT i=0; i<totalNumSamples; i++){
+        double *row = (*this)[i];
+        for(UINT j=0; j<numDimensions; j++){
+            row[j] = Util::scale(row[j],ranges[j].minValue,ranges[j].maxValue,minTarget,maxTarget);
+        }
+    }
+
+    return true;
+}
+
+VectorDouble FlatClassificationData::getSampleVector(const UINT i) const{
+    const double *sample = getSample(i);
+    return VectorDouble( sample, sample+numDimensions );
+}
+
+vector< UINT > FlatClassificationData::getClassLabels() const{
+    vector< UINT > classLabels( classTracker.size() );
+    for(UINT k=0; k<classTracker.size(); k++){
+        classLabels[k] = classTracker[k].classLabel;
+    }
+    return classLabels;
+}
+
+UINT FlatClassificationData::getClassLabelIndexValue(UINT classLabel) const{
+    for(UINT k=0; k<classTracker.size(); k++){
+        if( classTracker[k].classLabel == classLabel ) return k;
+    }
+    return (UINT)classTracker.size();
+}
+
+vector< MinMax > FlatClassificationData::getRanges() const{
+
+    vector< MinMax > ranges( numDimensions );
+
+    if( totalNumSamples == 0 ) return ranges;
+
+    const double *row = getSample(0);
+    for(UINT j=0; j<numDimensions; j++){
+        ranges[j].minValue = ranges[j].maxValue = row[j];
+    }
+    for(UINT i=1; i<totalNumSamples; i++){
+        row = getSample(i);
+        for(UINT j=0; j<numDimensions; j++){
+            if( row[j] < ranges[j].minValue ) ranges[j].minValue = row[j];
+            else if( row[j] > ranges[j].maxValue ) ranges[j].maxValue = row[j];
+        }
+    }
+
+    return ranges;
+}
+
+MatrixDouble FlatClassificationData::getDataAsMatrixDouble() const{
+
+    MatrixDouble d( totalNumSamples, numDimensions );
+
+    for(UINT i=0; i<totalNumSamples; i++){
+        const double *row = getSample(i);
+        std::copy( row, row+numDimensions, d[i] );
+    }
+
+    return d;
+}
+
+MatrixDouble FlatClassificationData::getClassDataAsMatrixDouble(UINT classLabel) const{
+
+    const UINT classIndex = getClassLabelIndexValue( classLabel );
+    if( classIndex >= classTracker.size() ) return MatrixDouble();
+
+    MatrixDouble d( classTracker[ classIndex ].counter, numDimensions );
+
+    UINT index = 0;
+    for(UINT i=0; i<totalNumSamples; i++){
+        if( sampleClassLabels[i] == classLabel ){
+            const double *row = getSample(i);
+            std::copy( row, row+numDimensions, d[index++] );
+        }
+    }
+
+    return d;
+}
+
+} //End of namespace GRT
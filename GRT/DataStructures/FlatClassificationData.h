@@ -0,0 +1,229 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The FlatClassificationData stores labelled classification data as one contiguous [M N] buffer of features (row major,
+ so sample i starts at index i*N) and a separate array of the M class labels. It is an alternative storage mode to
+ the LabelledClassificationData, where every sample owns its own vector, and is used by batch algorithms (such as the
+ KNN, GMM and Softmax classifiers) that need to scan over all the training samples quickly.
+
+ The samples are accessed as pointers into the buffer (getSample(i) or data[i][j]), so reading a sample never copies it.
+ Pointers to the samples are only valid until the next sample is added to the dataset.
+ */
+
+#ifndef GRT_FLAT_CLASSIFICATION_DATA_HEADER
+#define GRT_FLAT_CLASSIFICATION_DATA_HEADER
+
+#include "LabelledClassificationDataView.h"
+
+namespace GRT{
+
+class FlatClassificationData{
+public:
+    /**
+     Constructor, sets the number of dimensions of the training data.
+
+     @param UINT numDimensions: the number of dimensions of the training data
+     */
+    FlatClassificationData(UINT numDimensions = 0);
+
+    /**
+     Constructor, copies the samples from the LabelledClassificationData into the flat buffer.
+
+     @param const LabelledClassificationData &data: the dataset that will be copied
+     */
+    FlatClassificationData(const LabelledClassificationData &data);
+
+    /**
+     Constructor, copies the samples in the view into the flat buffer (a weighted sample is added once for each repeat).
+
+     @param const LabelledClassificationDataView &data: the view that will be copied
+     */
+    FlatClassificationData(const LabelledClassificationDataView &data);
+
+    /**
+     Default Destructor
+     */
+    ~FlatClassificationData();
+
+    /**
+     Array Subscript Operator, returns a pointer to the i'th sample.
+     It is up to the user to ensure that i is within the range of [0 totalNumSamples-1]
+
+     @param const UINT i: the index of the sample
+     @return a pointer to the N values of the i'th sample
+     */
+    inline double* operator[] (const UINT i){
+        return &data[ size_t(i)*numDimensions ];
+    }
+
+    /**
+     Const Array Subscript Operator, returns a const pointer to the i'th sample.
+     It is up to the user to ensure that i is within the range of [0 totalNumSamples-1]
+
+     @param const UINT i: the index of the sample
+     @return a const pointer to the N values of the i'th sample
+     */
+    inline const double* operator[] (const UINT i) const{
+        return &data[ size_t(i)*numDimensions ];
+    }
+
+    /**
+     Replaces the data in this instance with the samples from the LabelledClassificationData.
+
+     @param const LabelledClassificationData &data: the dataset that will be copied
+     @return returns true if the data was set, false otherwise
+     */
+    bool setData(const LabelledClassificationData &data);
+
+    /**
+     Replaces the data in this instance with the samples in the view (a weighted sample is added once for each repeat).
+
+     @param const LabelledClassificationDataView &data: the view that will be copied
+     @return returns true if the data was set, false otherwise
+     */
+    bool setData(const LabelledClassificationDataView &data);
+
+    /**
+     Clears all the samples, the number of dimensions is kept.
+     */
+    void clear();
+
+    /**
+     Sets the number of dimensions of the training data, this will clear any previous samples.
+
+     @param UINT numDimensions: the number of dimensions of the training data, must be greater than zero
+     @return returns true if the number of dimensions was updated, false otherwise
+     */
+    bool setNumDimensions(UINT numDimensions);
+
+    /**
+     Reserves space in the buffer for numSamples samples, so they can be added without the buffer being reallocated.
+
+     @param UINT numSamples: the number of samples to reserve space for
+     @return returns true if the space was reserved
+     */
+    bool reserve(UINT numSamples);
+
+    /**
+     Adds a new sample to the end of the dataset.
+
+     @param UINT classLabel: the class label of the sample
+     @param const VectorDouble &sample: the sample, its size must match the number of dimensions
+     @return returns true if the sample was added, false otherwise
+     */
+    bool addSample(UINT classLabel,const VectorDouble &sample);
+
+    /**
+     Adds a new sample to the end of the dataset.
+
+     @param UINT classLabel: the class label of the sample
+     @param const double *sample: a pointer to the N values of the sample
+     @return returns true if the sample was added, false otherwise
+     */
+    bool addSample(UINT classLabel,const double *sample);
+
+    /**
+     Scales every sample from the ranges to the target range [minTarget maxTarget].
+
+     @param const vector< MinMax > &ranges: the range of each dimension, its size must match the number of dimensions
+     @param double minTarget: the minimum value of the target range
+     @param double maxTarget: the maximum value of the target range
+     @return returns true if the data was scaled, false otherwise
+     */
+    bool scale(const vector< MinMax > &ranges,double minTarget,double maxTarget);
+
+    /**
+     @param const UINT i: the index of the sample
+     @return returns a const pointer to the N values of the i'th sample
+     */
+    inline const double* getSample(const UINT i) const{ return &data[ size_t(i)*numDimensions ]; }
+
+    /**
+     @param const UINT i: the index of the sample
+     @return returns the class label of the i'th sample
+     */
+    inline UINT getClassLabel(const UINT i) const{ return sampleClassLabels[i]; }
+
+    /**
+     @param const UINT i: the index of the sample
+     @return returns a copy of the i'th sample
+     */
+    VectorDouble getSampleVector(const UINT i) const;
+
+    /**
+     @return returns a pointer to the start of the [M N] feature buffer
+     */
+    const double* getData() const{ return totalNumSamples > 0 ? &data[0] : NULL; }
+
+    /**
+     @return returns the class label of each sample
+     */
+    const vector< UINT >& getSampleClassLabels() const{ return sampleClassLabels; }
+
+    UINT getNumDimensions() const{ return numDimensions; }
+    UINT getNumSamples() const{ return totalNumSamples; }
+    UINT getNumClasses() const{ return (UINT)classTracker.size(); }
+    const vector< ClassTracker >& getClassTracker() const{ return classTracker; }
+
+    /**
+     @return returns the class labels of the classes in the dataset
+     */
+    vector< UINT > getClassLabels() const;
+
+    /**
+     @param UINT classLabel: the class label you want the index of
+     @return returns the index of the class in the class tracker, or the number of classes if the class label is not in the dataset
+     */
+    UINT getClassLabelIndexValue(UINT classLabel) const;
+
+    /**
+     @return returns the minimum and maximum values of each dimension
+     */
+    vector< MinMax > getRanges() const;
+
+    /**
+     @return returns an [M N] MatrixDouble containing all the samples
+     */
+    MatrixDouble getDataAsMatrixDouble() const;
+
+    /**
+     @param UINT classLabel: the class label of the class you want the data for
+     @return returns a MatrixDouble containing all the samples with the matching classLabel, one sample per row
+     */
+    MatrixDouble getClassDataAsMatrixDouble(UINT classLabel) const;
+
+protected:
+    UINT numDimensions;                                     ///< The number of dimensions in the dataset
+    UINT totalNumSamples;                                   ///< The number of samples in the dataset
+    VectorDouble data;                                      ///< The [M N] feature buffer, stored row by row
+    vector< UINT > sampleClassLabels;                       ///< The class label of each sample
+    vector< ClassTracker > classTracker;                    ///< Keeps track of the number of samples of each class
+
+    ErrorLog errorLog;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_FLAT_CLASSIFICATION_DATA_HEADER
@@ -19,6 +19,7 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 
 #include "LabelledClassificationData.h"
+#include "LabelledClassificationDataView.h"
 
 namespace GRT{
 
@@ -356,48 +357,41 @@ bool LabelledClassificationData::saveDatasetToFile(string filename) const{
 
 bool LabelledClassificationData::loadDatasetFromFile(string filename){
 
-	std::fstream file;
-	file.open(filename.c_str(), std::ios::in);
+	FileTokenizer file;
 	UINT numClasses = 0;
 	clear();
 
-	if( !file.is_open() ){
+	if( !file.open( filename ) ){
         errorLog << "loadDatasetFromFile(string filename) - could not open file!" << endl;
 		return false;
 	}
 
-	string word;
-
 	//Check to make sure this is a file with the Training File Format
-	file >> word;
-	if(word != "GRT_LABELLED_CLASSIFICATION_DATA_FILE_V1.0"){
+	if( !file.matchWord("GRT_LABELLED_CLASSIFICATION_DATA_FILE_V1.0") ){
         errorLog << "loadDatasetFromFile(string filename) - could not find file header!" << endl;
 		file.close();
 		return false;
 	}
 
     //Get the name of the dataset
-	file >> word;
-	if(word != "DatasetName:"){
+	if( !file.matchWord("DatasetName:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
 	}
 	file >> datasetName;
 
-    file >> word;
-	if(word != "InfoText:"){
+	if( !file.matchWord("InfoText:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find InfoText!" << endl;
 		file.close();
 		return false;
 	}
 
     //Load the info text
-    file >> word;
+    string word;
     infoText = "";
-    while( word != "NumDimensions:" ){
+    while( file.readValue( word ) && word != "NumDimensions:" ){
         infoText += word + " ";
-        file >> word;
     }
 
 	//Get the number of dimensions in the training data
@@ -409,8 +403,7 @@ bool LabelledClassificationData::loadDatasetFromFile(string filename){
 	file >> numDimensions;
 
 	//Get the total number of training examples in the training data
-	file >> word;
-	if(word != "TotalNumTrainingExamples:"){
+	if( !file.matchWord("TotalNumTrainingExamples:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
@@ -418,8 +411,7 @@ bool LabelledClassificationData::loadDatasetFromFile(string filename){
 	file >> totalNumSamples;
 
 	//Get the total number of classes in the training data
-	file >> word;
-	if(word != "NumberOfClasses:"){
+	if( !file.matchWord("NumberOfClasses:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
@@ -430,8 +422,7 @@ bool LabelledClassificationData::loadDatasetFromFile(string filename){
 	classTracker.resize(numClasses);
 
 	//Get the total number of classes in the training data
-	file >> word;
-	if(word != "ClassIDsAndCounters:"){
+	if( !file.matchWord("ClassIDsAndCounters:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
@@ -444,8 +435,7 @@ bool LabelledClassificationData::loadDatasetFromFile(string filename){
 	}
 
     //Check if the dataset should be scaled using external ranges
-	file >> word;
-	if(word != "UseExternalRanges:"){
+	if( !file.matchWord("UseExternalRanges:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
@@ -462,8 +452,7 @@ bool LabelledClassificationData::loadDatasetFromFile(string filename){
     }
 
 	//Get the main training data
-	file >> word;
-	if(word != "LabelledTrainingData:"){
+	if( !file.matchWord("LabelledTrainingData:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
@@ -472,14 +461,21 @@ bool LabelledClassificationData::loadDatasetFromFile(string filename){
 	LabelledClassificationSample tempSample( numDimensions );
 	data.resize( totalNumSamples, tempSample );
 
+	//The values are read straight into the samples, so no memory is allocated per sample
 	for(UINT i=0; i<totalNumSamples; i++){
         UINT classLabel = 0;
-        VectorDouble sample(numDimensions,0);
 		file >> classLabel;
 		for(UINT j=0; j<numDimensions; j++){
-			file >> sample[j];
+			file >> data[i][j];
 		}
-        data[i].set(classLabel, sample);
+        data[i].setClassLabel( classLabel );
+	}
+
+	if( file.fail() ){
+        errorLog << "loadDatasetFromFile(string filename) - failed to read the training data!" << endl;
+		file.close();
+		clear();
+		return false;
 	}
 
 	file.close();
@@ -489,6 +485,77 @@ bool LabelledClassificationData::loadDatasetFromFile(string filename){
 	return true;
 }
 
+
+bool LabelledClassificationData::saveDatasetToBinaryFile(const string &filename,UINT chunkSize) const{
+
+    BinaryDatasetWriter writer;
+
+    if( !writer.open( filename, BinaryDatasetFile::LABELLED_CLASSIFICATION_DATA, numDimensions, 0, chunkSize ) ){
+        errorLog << "saveDatasetToBinaryFile(const string &filename,UINT chunkSize) - Failed to open file!" << endl;
+        return false;
+    }
+
+    writer.setDatasetName( datasetName );
+    writer.setInfoText( infoText );
+    writer.setClassTracker( classTracker );
+    writer.setExternalRanges( externalRanges, vector< MinMax >(), useExternalRanges );
+
+    for(UINT i=0; i<totalNumSamples; i++){
+        if( !writer.addRow( data[i].getClassLabel(), i, &data[i][0] ) ){
+            errorLog << "saveDatasetToBinaryFile(const string &filename,UINT chunkSize) - Failed to write sample " << i << endl;
+            writer.close();
+            return false;
+        }
+    }
+
+    return writer.close();
+}
+
+bool LabelledClassificationData::loadDatasetFromBinaryFile(const string &filename){
+
+    BinaryDatasetReader reader;
+    clear();
+
+    if( !reader.open( filename ) ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - could not open file!" << endl;
+        return false;
+    }
+
+    if( reader.getDatasetType() != BinaryDatasetFile::LABELLED_CLASSIFICATION_DATA ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - The file does not contain labelled classification data!" << endl;
+        return false;
+    }
+
+    datasetName = reader.getDatasetName();
+    infoText = reader.getInfoText();
+    numDimensions = reader.getNumDimensions();
+    classTracker = reader.getClassTracker();
+    useExternalRanges = reader.getUseExternalRanges();
+    externalRanges = reader.getExternalRanges();
+
+    //The columns of each chunk are gathered straight into the samples
+    data.resize( (UINT)reader.getTotalNumRows(), LabelledClassificationSample( numDimensions ) );
+    BinaryDatasetChunk chunk;
+    UINT index = 0;
+    while( reader.readNextChunk( chunk ) ){
+        if( index + chunk.getNumRows() > data.size() ) break;
+        for(UINT i=0; i<chunk.getNumRows(); i++){
+            chunk.getSample( i, &data[index][0] );
+            data[index++].setClassLabel( chunk.getClassLabels()[i] );
+        }
+    }
+    if( index != data.size() ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - failed to read all the rows, only " << index << " of the " << data.size() << " rows given in the header were read!" << endl;
+        clear();
+        return false;
+    }
+    totalNumSamples = index;
+
+    sortClassLabels();
+
+    return true;
+}
+
 bool LabelledClassificationData::saveDatasetToCSVFile(string filename) const{
 
     std::fstream file;
@@ -591,15 +658,51 @@ LabelledClassificationData LabelledClassificationData::partition(UINT trainingSi
 	//therefore sets the size of the data which remains in this instance and the remaining percentage of data is then added to
 	//the testing/validation dataset
 
-    //The dataset has changed so flag that any previous cross validation setup will now not work
-    crossValidationSetup = false;
-    crossValidationIndexs.clear();
+    LabelledClassificationDataView trainingView;
+    LabelledClassificationDataView testView;
+    partition( trainingSizePercentage, useStratifiedSampling, trainingView, testView );
 
-    LabelledClassificationData trainingSet(numDimensions);
-    LabelledClassificationData testSet(numDimensions);
-    trainingSet.setAllowNullGestureClass( allowNullGestureClass );
-    testSet.setAllowNullGestureClass( allowNullGestureClass );
-    vector< UINT > indexs( totalNumSamples );
+    //Copy both partitions before this instance is overwritten, as the views point at the data in this instance
+    LabelledClassificationData trainingSet = trainingView.getDataset();
+    LabelledClassificationData testSet = testView.getDataset();
+
+    //Overwrite the training data in this instance with the training data of the trainingSet
+    *this = trainingSet;
+
+	sortClassLabels();
+    testSet.sortClassLabels();
+
+	return testSet;
+}
+
+bool LabelledClassificationData::partition(UINT trainingSizePercentage,bool useStratifiedSampling,LabelledClassificationDataView &trainingSet,LabelledClassificationDataView &testSet) const{
+
+    vector< UINT > trainingIndexs;
+    vector< UINT > testIndexs;
+
+    if( !getPartitionIndexs( trainingSizePercentage, useStratifiedSampling, trainingIndexs, testIndexs ) ){
+        trainingSet = LabelledClassificationDataView( *this, vector< UINT >() );
+        testSet = LabelledClassificationDataView( *this, vector< UINT >() );
+        return false;
+    }
+
+    trainingSet = LabelledClassificationDataView( *this, trainingIndexs );
+    testSet = LabelledClassificationDataView( *this, testIndexs );
+    trainingSet.sortClassLabels();
+    testSet.sortClassLabels();
+
+    return true;
+}
+
+bool LabelledClassificationData::getPartitionIndexs(UINT trainingSizePercentage,bool useStratifiedSampling,vector< UINT > &trainingIndexs,vector< UINT > &testIndexs) const{
+
+    trainingIndexs.clear();
+    testIndexs.clear();
+
+    if( trainingSizePercentage > 100 ){
+        errorLog << "partition(...) - The trainingSizePercentage (" << trainingSizePercentage << ") must be in the range [0 100]!" << endl;
+        return false;
+    }
 
 	//Create the random partion indexs
 	Random random;
@@ -626,24 +729,16 @@ LabelledClassificationData LabelledClassificationData::partition(UINT trainingSi
             }
         }
 
-        //Loop over each class and add the data to the trainingSet and testSet
+        //Loop over each class and add the indexs to the training and test sets
         for(UINT k=0; k<getNumClasses(); k++){
             UINT numTrainingExamples = (UINT) floor( double(classData[k].size()) / 100.0 * double(trainingSizePercentage) );
-
-            //Add the data to the training and test sets
-            for(UINT i=0; i<numTrainingExamples; i++){
-                trainingSet.addSample( data[ classData[k][i] ].getClassLabel(), data[ classData[k][i] ].getSample() );
-            }
-            for(UINT i=numTrainingExamples; i<classData[k].size(); i++){
-                testSet.addSample( data[ classData[k][i] ].getClassLabel(), data[ classData[k][i] ].getSample() );
-            }
+            trainingIndexs.insert( trainingIndexs.end(), classData[k].begin(), classData[k].begin()+numTrainingExamples );
+            testIndexs.insert( testIndexs.end(), classData[k].begin()+numTrainingExamples, classData[k].end() );
         }
     }else{
 
         const UINT numTrainingExamples = (UINT) floor( double(totalNumSamples) / 100.0 * double(trainingSizePercentage) );
-        //Create the random partion indexs
-        Random random;
-        UINT randomIndex = 0;
+        vector< UINT > indexs( totalNumSamples );
         for(UINT i=0; i<totalNumSamples; i++) indexs[i] = i;
         for(UINT x=0; x<totalNumSamples; x++){
             //Pick a random index
@@ -653,22 +748,12 @@ LabelledClassificationData LabelledClassificationData::partition(UINT trainingSi
             SWAP(indexs[ x ],indexs[ randomIndex ]);
         }
 
-        //Add the data to the training and test sets
-        for(UINT i=0; i<numTrainingExamples; i++){
-            trainingSet.addSample( data[ indexs[i] ].getClassLabel(), data[ indexs[i] ].getSample() );
-        }
-        for(UINT i=numTrainingExamples; i<totalNumSamples; i++){
-            testSet.addSample( data[ indexs[i] ].getClassLabel(), data[ indexs[i] ].getSample() );
-        }
+        //Add the indexs to the training and test sets
+        trainingIndexs.assign( indexs.begin(), indexs.begin()+numTrainingExamples );
+        testIndexs.assign( indexs.begin()+numTrainingExamples, indexs.end() );
     }
 
-    //Overwrite the training data in this instance with the training data of the trainingSet
-    *this = trainingSet;
-
-	sortClassLabels();
-    testSet.sortClassLabels();
-
-	return testSet;
+    return true;
 }
 
 bool LabelledClassificationData::merge(LabelledClassificationData &labelledData){
@@ -803,71 +888,53 @@ bool LabelledClassificationData::spiltDataIntoKFolds(UINT K,bool useStratifiedSa
 }
 
 LabelledClassificationData LabelledClassificationData::getTrainingFoldData(UINT foldIndex){
-   
-    LabelledClassificationData trainingData;
-    trainingData.setNumDimensions( numDimensions );
-    trainingData.setAllowNullGestureClass( allowNullGestureClass );
+    return getTrainingFoldView( foldIndex ).getDataset();
+}
+
+LabelledClassificationData LabelledClassificationData::getTestFoldData(UINT foldIndex){
+    return getTestFoldView( foldIndex ).getDataset();
+}
+
+LabelledClassificationDataView LabelledClassificationData::getTrainingFoldView(UINT foldIndex) const{
 
     if( !crossValidationSetup ){
-        errorLog << "getTrainingFoldData(UINT foldIndex) - Cross Validation has not been setup! You need to call the spiltDataIntoKFolds(UINT K,bool useStratifiedSampling) function first before calling this function!" << endl;
-       return trainingData;
+        errorLog << "getTrainingFoldView(UINT foldIndex) - Cross Validation has not been setup! You need to call the spiltDataIntoKFolds(UINT K,bool useStratifiedSampling) function first before calling this function!" << endl;
+        return LabelledClassificationDataView( *this, vector< UINT >() );
     }
 
-    if( foldIndex >= kFoldValue ) return trainingData;
+    if( foldIndex >= kFoldValue ) return LabelledClassificationDataView( *this, vector< UINT >() );
 
-    //Add the data to the training set, this will consist of all the data that is NOT in the foldIndex
-    UINT index = 0;
+    //The training set consists of all the data that is NOT in the foldIndex
+    vector< UINT > indexs;
+    indexs.reserve( totalNumSamples - crossValidationIndexs[ foldIndex ].size() );
     for(UINT k=0; k<kFoldValue; k++){
         if( k != foldIndex ){
-            for(UINT i=0; i<crossValidationIndexs[k].size(); i++){
-
-                index = crossValidationIndexs[k][i];
-                trainingData.addSample( data[ index ].getClassLabel(), data[ index ].getSample() );
-            }
+            indexs.insert( indexs.end(), crossValidationIndexs[k].begin(), crossValidationIndexs[k].end() );
         }
     }
 
+    LabelledClassificationDataView trainingData( *this, indexs );
 	trainingData.sortClassLabels();
 
     return trainingData;
 }
 
-LabelledClassificationData LabelledClassificationData::getTestFoldData(UINT foldIndex){
-    
-    LabelledClassificationData testData;
-    testData.setNumDimensions( numDimensions );
-    testData.setAllowNullGestureClass( allowNullGestureClass );
-
-    if( !crossValidationSetup ) return testData;
-
-    if( foldIndex >= kFoldValue ) return testData;
+LabelledClassificationDataView LabelledClassificationData::getTestFoldView(UINT foldIndex) const{
 
-    //Add the data to the training
-    UINT index = 0;
-	for(UINT i=0; i<crossValidationIndexs[ foldIndex ].size(); i++){
+    if( !crossValidationSetup || foldIndex >= kFoldValue ) return LabelledClassificationDataView( *this, vector< UINT >() );
 
-        index = crossValidationIndexs[ foldIndex ][i];
-		testData.addSample( data[ index ].getClassLabel(), data[ index ].getSample() );
-	}
-	
+    LabelledClassificationDataView testData( *this, crossValidationIndexs[ foldIndex ] );
 	testData.sortClassLabels();
 
     return testData;
 }
 
 LabelledClassificationData LabelledClassificationData::getClassData(UINT classLabel) const{
-    
-    LabelledClassificationData classData;
-    classData.setNumDimensions( this->numDimensions );
-    classData.setAllowNullGestureClass( allowNullGestureClass );
-
-    for(UINT i=0; i<totalNumSamples; i++){
-        if( data[i].getClassLabel() == classLabel ){
-            classData.addSample(classLabel, data[i].getSample());
-        }
-    }
+    return getClassDataView( classLabel ).getDataset();
+}
 
-    return classData;
+LabelledClassificationDataView LabelledClassificationData::getClassDataView(UINT classLabel) const{
+    return LabelledClassificationDataView( *this, getClassDataIndexes( classLabel ) );
 }
     
 LabelledClassificationData LabelledClassificationData::getBootstrappedDataset(UINT numSamples) const{
@@ -889,6 +956,35 @@ LabelledClassificationData LabelledClassificationData::getBootstrappedDataset(UI
     return newDataset;
 }
 
+LabelledClassificationDataView LabelledClassificationData::getBootstrappedDatasetView(UINT numSamples) const{
+
+    if( numSamples == 0 ) numSamples = totalNumSamples;
+
+    //Count how many times each sample is drawn
+    Random rand;
+    vector< UINT > counts( totalNumSamples, 0 );
+    if( totalNumSamples > 0 ){
+        for(UINT i=0; i<numSamples; i++){
+            counts[ rand.getRandomNumberInt(0, totalNumSamples) ]++;
+        }
+    }
+
+    //Keep each sample that was drawn, weighted by the number of times it was drawn
+    vector< UINT > indexs;
+    VectorDouble weights;
+    for(UINT i=0; i<totalNumSamples; i++){
+        if( counts[i] > 0 ){
+            indexs.push_back( i );
+            weights.push_back( counts[i] );
+        }
+    }
+
+    LabelledClassificationDataView bootstrappedData( *this, indexs, weights );
+    bootstrappedData.sortClassLabels();
+
+    return bootstrappedData;
+}
+
 LabelledRegressionData LabelledClassificationData::reformatAsLabelledRegressionData() const{
 
     //Turns the classification into a regression data to enable regression algorithms like the MLP to be used as a classifier
@@ -30,6 +30,7 @@
 #define GRT_LABELLED_CLASSIFICATION_DATA_HEADER
 
 #include "../Util/GRTCommon.h"
+#include "BinaryDatasetFile.h"
 #include "../GestureRecognitionPipeline/GRTBase.h"
 #include "LabelledClassificationSample.h"
 #include "LabelledRegressionData.h"
@@ -37,6 +38,8 @@
 
 namespace GRT{
 
+class LabelledClassificationDataView;
+
 class LabelledClassificationData : public GRTBase{
 public:
     
@@ -229,6 +232,24 @@ public:
      @return true if the data was loaded successfully, false otherwise
     */
 	bool loadDatasetFromFile(string filename);
+
+    /**
+     Saves the labelled classification data to a GRT binary dataset file. The binary file can be loaded much faster than the text file,
+     and it can be read a chunk at a time with the BinaryDatasetReader (see BinaryDatasetFile.h).
+
+     @param const string &filename: the name of the file the data will be saved to
+     @param UINT chunkSize: the maximum number of rows in each chunk of the file
+     @return true if the data was saved successfully, false otherwise
+     */
+    bool saveDatasetToBinaryFile(const string &filename,UINT chunkSize = 10000) const;
+
+    /**
+     Loads the labelled classification data from a GRT binary dataset file.
+
+     @param const string &filename: the name of the file the data will be loaded from
+     @return true if the data was loaded successfully, false otherwise
+     */
+    bool loadDatasetFromBinaryFile(const string &filename);
     
     /**
      Saves the labelled classification data to a CSV file.
@@ -285,6 +306,19 @@ public:
      @return a new LabelledClassificationData instance, containing the remaining data not kept but this instance
      */
 	LabelledClassificationData partition(UINT partitionPercentage,bool useStratifiedSampling = false);
+
+    /**
+     Partitions the dataset into a training view and a testing/validation view. Unlike the partition function above, this
+     does not modify or copy the dataset, the views just hold the indexs of the samples in each partition.
+     This instance must not be modified or destroyed while the views are in use.
+
+     @param UINT partitionPercentage: sets the percentage of data which is added to the training view, the remaining percentage of data is added to the test view
+     @param bool useStratifiedSampling: sets if the dataset should be broken into homogeneous groups first before randomly being spilt
+     @param LabelledClassificationDataView &trainingSet: the view the training partition will be written to
+     @param LabelledClassificationDataView &testSet: the view the testing/validation partition will be written to
+     @return returns true if the dataset was partitioned, false otherwise
+     */
+    bool partition(UINT partitionPercentage,bool useStratifiedSampling,LabelledClassificationDataView &trainingSet,LabelledClassificationDataView &testSet) const;
     
     /**
      This function prepares the dataset for k-fold cross validation and should be called prior to calling the getTrainingFold(UINT foldIndex) or getTestingFold(UINT foldIndex) functions.  It will spilt the dataset into K-folds, as long as K < M, where M is the number of samples in the dataset.
@@ -312,6 +346,24 @@ public:
      @return returns a test dataset
     */
     LabelledClassificationData getTestFoldData(UINT foldIndex);
+
+    /**
+     Returns a view of the training dataset for the k-th fold for cross validation. This is the same as getTrainingFoldData, except
+     that the samples are not copied, so this instance must not be modified or destroyed while the view is in use.
+
+     @param UINT foldIndex: the index of the fold you want the training data for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into
+     @return returns a view of the training dataset
+    */
+    LabelledClassificationDataView getTrainingFoldView(UINT foldIndex) const;
+
+    /**
+     Returns a view of the test dataset for the k-th fold for cross validation. This is the same as getTestFoldData, except
+     that the samples are not copied, so this instance must not be modified or destroyed while the view is in use.
+
+     @param UINT foldIndex: the index of the fold you want the test data for, this should be in the range [0 K-1], where K is the number of folds the data was spilt into
+     @return returns a view of the test dataset
+    */
+    LabelledClassificationDataView getTestFoldView(UINT foldIndex) const;
     
     /**
      Returns the all the data with the class label set by classLabel.
@@ -321,9 +373,33 @@ public:
      @return returns a dataset containing all the data with the matching classLabel
      */
     LabelledClassificationData getClassData(UINT classLabel) const;
-    
-    
+
+    /**
+     Returns a view of all the data with the class label set by classLabel.
+     This instance must not be modified or destroyed while the view is in use.
+
+     @param UINT classLabel: the class label of the class you want the data for
+     @return returns a view containing all the data with the matching classLabel
+     */
+    LabelledClassificationDataView getClassDataView(UINT classLabel) const;
+
+    /**
+     Returns a bootstrapped dataset, built by randomly drawing (with replacement) numSamples samples from this dataset.
+
+     @param UINT numSamples: the number of samples to draw, if this is zero then the number of samples in this dataset will be used
+     @return returns a new dataset containing the bootstrapped samples
+     */
     LabelledClassificationData getBootstrappedDataset(UINT numSamples=0) const;
+
+    /**
+     Returns a view of a bootstrapped dataset, built by randomly drawing (with replacement) numSamples samples from this dataset.
+     The view holds each sample that was drawn once, weighted by the number of times it was drawn.
+     This instance must not be modified or destroyed while the view is in use.
+
+     @param UINT numSamples: the number of samples to draw, if this is zero then the number of samples in this dataset will be used
+     @return returns a weighted view of the bootstrapped dataset
+     */
+    LabelledClassificationDataView getBootstrappedDatasetView(UINT numSamples=0) const;
     
 	/**
      Reformats the LabelledClassificationData as LabelledRegressionData to enable regression algorithms like the MLP to be used as a classifier.
@@ -515,7 +591,10 @@ public:
     MatrixDouble getDataAsMatrixDouble() const;
 
 private:
-    
+    friend class LabelledClassificationDataView;
+
+    bool getPartitionIndexs(UINT trainingSizePercentage,bool useStratifiedSampling,vector< UINT > &trainingIndexs,vector< UINT > &testIndexs) const;
+
     string datasetName;                                     ///< The name of the dataset
     string infoText;                                        ///< Some infoText about the dataset
 	UINT numDimensions;										///< The number of dimensions in the dataset
@@ -0,0 +1,184 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LabelledClassificationDataView.h"
+
+namespace GRT{
+
+LabelledClassificationDataView::LabelledClassificationDataView():errorLog("[ERROR LabelledClassificationDataView]"){
+    data = NULL;
+}
+
+LabelledClassificationDataView::LabelledClassificationDataView(const LabelledClassificationData &data):errorLog("[ERROR LabelledClassificationDataView]"){
+    this->data = &data;
+    const UINT M = data.getNumSamples();
+    indexs.resize(M);
+    for(UINT i=0; i<M; i++){
+        indexs[i] = i;
+    }
+    updateClassTracker();
+}
+
+LabelledClassificationDataView::LabelledClassificationDataView(const LabelledClassificationData &data,const vector< UINT > &indexs):errorLog("[ERROR LabelledClassificationDataView]"){
+    this->data = &data;
+    this->indexs = indexs;
+    updateClassTracker();
+}
+
+LabelledClassificationDataView::LabelledClassificationDataView(const LabelledClassificationData &data,const vector< UINT > &indexs,const VectorDouble &weights):errorLog("[ERROR LabelledClassificationDataView]"){
+    this->data = &data;
+    this->indexs = indexs;
+    if( weights.size() == indexs.size() ){
+        this->weights = weights;
+    }else{
+        errorLog << "LabelledClassificationDataView(...) - The number of weights (" << weights.size() << ") does not match the number of indexs (" << indexs.size() << "), the weights will be ignored!" << endl;
+    }
+    updateClassTracker();
+}
+
+LabelledClassificationDataView::~LabelledClassificationDataView(){}
+
+bool LabelledClassificationDataView::sortClassLabels(){
+    sort(classTracker.begin(),classTracker.end(),ClassTracker::sortByClassLabelAscending);
+    return true;
+}
+
+LabelledClassificationData LabelledClassificationDataView::getDataset() const{
+
+    LabelledClassificationData dataset;
+
+    if( data == NULL ) return dataset;
+
+    dataset.setNumDimensions( data->getNumDimensions() );
+    dataset.setAllowNullGestureClass( data->allowNullGestureClass );
+
+    //The view already knows the size of each class, so the samples and class tracker can be set directly rather than
+    //searching the class tracker for every sample that is added
+    UINT numSamples = 0;
+    for(UINT k=0; k<classTracker.size(); k++){
+        numSamples += classTracker[k].counter;
+    }
+
+    dataset.data.reserve( numSamples );
+    for(UINT i=0; i<indexs.size(); i++){
+        const UINT numRepeats = getNumRepeats(i);
+        for(UINT r=0; r<numRepeats; r++){
+            dataset.data.push_back( (*data)[ indexs[i] ] );
+        }
+    }
+    dataset.totalNumSamples = numSamples;
+    dataset.classTracker = classTracker;
+
+    return dataset;
+}
+
+vector< UINT > LabelledClassificationDataView::getClassLabels() const{
+    vector< UINT > classLabels( classTracker.size() );
+    for(UINT k=0; k<classTracker.size(); k++){
+        classLabels[k] = classTracker[k].classLabel;
+    }
+    return classLabels;
+}
+
+vector< MinMax > LabelledClassificationDataView::getRanges() const{
+
+    const UINT N = getNumDimensions();
+    vector< MinMax > ranges(N);
+
+    //Samples with a weight that rounds to zero are not part of the view's dataset, so they do not count towards the ranges
+    UINT firstIndex = 0;
+    while( firstIndex < indexs.size() && getNumRepeats(firstIndex) == 0 ) firstIndex++;
+    if( firstIndex == indexs.size() ) return ranges;
+
+    for(UINT j=0; j<N; j++){
+        ranges[j].minValue = ranges[j].maxValue = (*data)[ indexs[firstIndex] ][j];
+    }
+    for(UINT i=firstIndex+1; i<indexs.size(); i++){
+        if( getNumRepeats(i) == 0 ) continue;
+        const LabelledClassificationSample &sample = (*data)[ indexs[i] ];
+        for(UINT j=0; j<N; j++){
+            if( sample[j] < ranges[j].minValue ) ranges[j].minValue = sample[j];
+            else if( sample[j] > ranges[j].maxValue ) ranges[j].maxValue = sample[j];
+        }
+    }
+
+    return ranges;
+}
+
+MatrixDouble LabelledClassificationDataView::getDataAsMatrixDouble() const{
+
+    const UINT M = getNumSamples();
+    const UINT N = getNumDimensions();
+    MatrixDouble d(M,N);
+
+    for(UINT i=0; i<M; i++){
+        const LabelledClassificationSample &sample = (*data)[ indexs[i] ];
+        for(UINT j=0; j<N; j++){
+            d[i][j] = sample[j];
+        }
+    }
+
+    return d;
+}
+
+void LabelledClassificationDataView::updateClassTracker(){
+
+    classTracker.clear();
+
+    //Check the indexs are valid before anything reads the samples
+    const UINT M = data->getNumSamples();
+    for(UINT i=0; i<indexs.size(); i++){
+        if( indexs[i] >= M ){
+            errorLog << "updateClassTracker() - The index " << indexs[i] << " is out of range, the dataset only has " << M << " samples! The view will be empty." << endl;
+            indexs.clear();
+            weights.clear();
+            return;
+        }
+    }
+
+    //Count the samples of each class, the classes are added in the order they are found (as LabelledClassificationData::addSample does)
+    const vector< ClassTracker > sourceClassTracker = data->getClassTracker();
+    for(UINT i=0; i<indexs.size(); i++){
+        const UINT classLabel = (*data)[ indexs[i] ].getClassLabel();
+        const UINT numRepeats = getNumRepeats(i);
+        if( numRepeats == 0 ) continue;
+
+        bool labelFound = false;
+        for(UINT k=0; k<classTracker.size(); k++){
+            if( classTracker[k].classLabel == classLabel ){
+                classTracker[k].counter += numRepeats;
+                labelFound = true;
+                break;
+            }
+        }
+        if( !labelFound ){
+            string className = "NOT_SET";
+            for(UINT k=0; k<sourceClassTracker.size(); k++){
+                if( sourceClassTracker[k].classLabel == classLabel ){
+                    className = sourceClassTracker[k].className;
+                    break;
+                }
+            }
+            classTracker.push_back( ClassTracker(classLabel,numRepeats,className) );
+        }
+    }
+}
+
+} //End of namespace GRT
@@ -0,0 +1,200 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The LabelledClassificationDataView is a lightweight subset of a LabelledClassificationData dataset. Rather than copying
+ the samples, the view holds a list of indexs into the source dataset (and an optional weight for each index), so the
+ training and test folds for cross validation, the bootstrapped datasets used for bagging, or the data for one class,
+ only cost a few bytes per sample.
+
+ The view does not own the samples, so the source dataset must not be modified or destroyed while the view is in use.
+
+ Each weight sets how many times its sample is counted when the view is turned into a dataset (it is rounded to the
+ nearest integer, and samples with a weight of zero or less are not counted), so the bootstrapped dataset for bagging
+ can be stored as the unique indexs that were drawn together with the number of times each one was drawn. Views without
+ weights count each index once.
+
+ All the classifiers can be trained on a view (see MLBase::train(const LabelledClassificationDataView &trainingData)).
+ */
+
+#ifndef GRT_LABELLED_CLASSIFICATION_DATA_VIEW_HEADER
+#define GRT_LABELLED_CLASSIFICATION_DATA_VIEW_HEADER
+
+#include "LabelledClassificationData.h"
+
+namespace GRT{
+
+class LabelledClassificationDataView{
+public:
+    /**
+     Default Constructor, creates an empty view that is not attached to any dataset
+     */
+    LabelledClassificationDataView();
+
+    /**
+     Creates a view of every sample in the dataset.
+
+     @param const LabelledClassificationData &data: the source dataset, this must stay valid while the view is used
+     */
+    explicit LabelledClassificationDataView(const LabelledClassificationData &data);
+
+    /**
+     Creates a view of the samples in the dataset at the given indexs.
+
+     @param const LabelledClassificationData &data: the source dataset, this must stay valid while the view is used
+     @param const vector< UINT > &indexs: the indexs of the samples in the view, each index must be in the range [0 M-1], where M is the number of samples in the dataset
+     */
+    LabelledClassificationDataView(const LabelledClassificationData &data,const vector< UINT > &indexs);
+
+    /**
+     Creates a weighted view of the samples in the dataset at the given indexs.
+
+     @param const LabelledClassificationData &data: the source dataset, this must stay valid while the view is used
+     @param const vector< UINT > &indexs: the indexs of the samples in the view, each index must be in the range [0 M-1], where M is the number of samples in the dataset
+     @param const VectorDouble &weights: the weight of each index, this must be the same size as the indexs (otherwise the weights are ignored)
+     */
+    LabelledClassificationDataView(const LabelledClassificationData &data,const vector< UINT > &indexs,const VectorDouble &weights);
+
+    /**
+     Default Destructor
+     */
+    ~LabelledClassificationDataView();
+
+    /**
+     Const Array Subscript Operator, returns the i'th LabelledClassificationSample in the view.
+     It is up to the user to ensure that i is within the range of [0 getNumSamples()-1]
+
+     @param const UINT &i: the index of the sample in the view
+     @return a const reference to the sample in the source dataset
+     */
+    inline const LabelledClassificationSample& operator[] (const UINT &i) const{
+        return (*data)[ indexs[i] ];
+    }
+
+    /**
+     Sorts the class labels (in the class tracker) in ascending order.
+
+     @return returns true if the labels were sorted successfully, false otherwise
+     */
+    bool sortClassLabels();
+
+    /**
+     Copies the samples in the view into a new dataset. Each sample is added the number of times set by its weight.
+
+     @return a new LabelledClassificationData instance containing the samples in the view
+     */
+    LabelledClassificationData getDataset() const;
+
+    /**
+     @return returns a pointer to the source dataset, or NULL if the view has not been attached to a dataset
+     */
+    const LabelledClassificationData* getSourceDataset() const{ return data; }
+
+    /**
+     @return returns the number of dimensions in the dataset
+     */
+    UINT getNumDimensions() const{ return data != NULL ? data->getNumDimensions() : 0; }
+
+    /**
+     @return returns the number of indexs in the view (a weighted sample is only counted once)
+     */
+    UINT getNumSamples() const{ return (UINT)indexs.size(); }
+
+    /**
+     @return returns the number of classes in the view
+     */
+    UINT getNumClasses() const{ return (UINT)classTracker.size(); }
+
+    /**
+     @param const UINT i: the index of the sample in the view
+     @return returns the index in the source dataset of the i'th sample in the view
+     */
+    UINT getIndex(const UINT i) const{ return indexs[i]; }
+
+    /**
+     @param const UINT i: the index of the sample in the view
+     @return returns the weight of the i'th sample in the view, this will be 1 if the view has no weights
+     */
+    double getWeight(const UINT i) const{ return weights.size() > 0 ? weights[i] : 1.0; }
+
+    /**
+     @param const UINT i: the index of the sample in the view
+     @return returns the number of times the i'th sample is counted, this is its weight rounded to the nearest integer
+     */
+    UINT getNumRepeats(const UINT i) const{
+        if( weights.size() == 0 ) return 1;
+        return weights[i] > 0 ? (UINT)floor( weights[i] + 0.5 ) : 0;
+    }
+
+    /**
+     @return returns true if the view has a weight for each sample, false otherwise
+     */
+    bool getHasWeights() const{ return weights.size() > 0; }
+
+    /**
+     @return returns the indexs of the samples in the view
+     */
+    const vector< UINT >& getIndexs() const{ return indexs; }
+
+    /**
+     @return returns the weights of the samples in the view, this will be empty if the view has no weights
+     */
+    const VectorDouble& getWeights() const{ return weights; }
+
+    /**
+     @return returns the class tracker of the view, the counter of each class is the number of times its samples are counted
+     */
+    const vector< ClassTracker >& getClassTracker() const{ return classTracker; }
+
+    /**
+     @return returns the class labels of the classes in the view
+     */
+    vector< UINT > getClassLabels() const;
+
+    /**
+     @return returns the minimum and maximum values of each dimension, computed over the samples in the view, samples with a weight that rounds to zero are skipped as getDataset() leaves them out
+     */
+    vector< MinMax > getRanges() const;
+
+    /**
+     Gets the samples in the view as a MatrixDouble. This returns just the data, not the labels, and does not repeat weighted samples.
+
+     @return returns an [M N] MatrixDouble, where M is the number of samples in the view and N is the number of dimensions
+     */
+    MatrixDouble getDataAsMatrixDouble() const;
+
+protected:
+    void updateClassTracker();
+
+    const LabelledClassificationData *data;                 ///< The source dataset
+    vector< UINT > indexs;                                  ///< The indexs of the samples in the source dataset
+    VectorDouble weights;                                   ///< The (optional) weight of each index
+    vector< ClassTracker > classTracker;                    ///< Keeps track of the number of samples of each class in the view
+
+    ErrorLog errorLog;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_LABELLED_CLASSIFICATION_DATA_VIEW_HEADER
@@ -66,6 +66,7 @@ public:
     
     //Setters
 	void set(UINT classLabel,const VectorDouble &sample);
+    void setClassLabel(UINT classLabel){ this->classLabel = classLabel; }
 
 private:
 	UINT numDimensions;
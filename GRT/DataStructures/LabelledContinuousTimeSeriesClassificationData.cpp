@@ -485,49 +485,42 @@ bool LabelledContinuousTimeSeriesClassificationData::saveDatasetToFile(string fi
 
 bool LabelledContinuousTimeSeriesClassificationData::loadDatasetFromFile(string filename){
 
-	std::fstream file; 
-	file.open(filename.c_str(), std::ios::in);
+	FileTokenizer file;
 	UINT numClasses = 0;
 	UINT numTrackingPoints = 0;
 	clear();
 
-	if( !file.is_open() ){
+	if( !file.open( filename ) ){
 		errorLog<< "loadDatasetFromFile(string fileName) - Failed to open file!" << endl;
 		return false;
 	}
 
-	string word;
-
 	//Check to make sure this is a file with the Training File Format
-	file >> word;
-	if(word != "GRT_LABELLED_CONTINUOUS_TIME_SERIES_CLASSIFICATION_FILE_V1.0"){
+	if( !file.matchWord("GRT_LABELLED_CONTINUOUS_TIME_SERIES_CLASSIFICATION_FILE_V1.0") ){
 		file.close();
         errorLog<< "loadDatasetFromFile(string fileName) - Failed to find file header!" << endl;
 		return false;
 	}
     
     //Get the name of the dataset
-	file >> word;
-	if(word != "DatasetName:"){
+	if( !file.matchWord("DatasetName:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
 	}
 	file >> datasetName;
     
-    file >> word;
-	if(word != "InfoText:"){
+	if( !file.matchWord("InfoText:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find InfoText!" << endl;
 		file.close();
 		return false;
 	}
     
     //Load the info text
-    file >> word;
+    string word;
     infoText = "";
-    while( word != "NumDimensions:" ){
+    while( file.readValue( word ) && word != "NumDimensions:" ){
         infoText += word + " ";
-        file >> word;
     }
 
 	//Get the number of dimensions in the training data
@@ -539,8 +532,7 @@ bool LabelledContinuousTimeSeriesClassificationData::loadDatasetFromFile(string
 	file >> numDimensions;
 
 	//Get the total number of training examples in the training data
-	file >> word;
-	if(word != "TotalNumSamples:"){
+	if( !file.matchWord("TotalNumSamples:") ){
         errorLog<< "loadDatasetFromFile(string fileName) - Failed to find TotalNumSamples!" << endl;
 		file.close();
 		return false;
@@ -548,8 +540,7 @@ bool LabelledContinuousTimeSeriesClassificationData::loadDatasetFromFile(string
 	file >> totalNumSamples;
 
 	//Get the total number of classes in the training data
-	file >> word;
-	if(word != "NumberOfClasses:"){
+	if( !file.matchWord("NumberOfClasses:") ){
         errorLog<< "loadDatasetFromFile(string fileName) - Failed to find NumberOfClasses!" << endl;
 		file.close();
 		return false;
@@ -560,8 +551,7 @@ bool LabelledContinuousTimeSeriesClassificationData::loadDatasetFromFile(string
 	classTracker.resize(numClasses);
 
 	//Get the total number of classes in the training data
-	file >> word;
-	if(word != "ClassIDsAndCounters:"){
+	if( !file.matchWord("ClassIDsAndCounters:") ){
         errorLog<< "loadDatasetFromFile(string fileName) - Failed to find ClassIDsAndCounters!" << endl;
 		file.close();
 		return false;
@@ -573,8 +563,7 @@ bool LabelledContinuousTimeSeriesClassificationData::loadDatasetFromFile(string
 	}
 
 	//Get the NumberOfPositionTrackers
-	file >> word;
-	if(word != "NumberOfPositionTrackers:"){
+	if( !file.matchWord("NumberOfPositionTrackers:") ){
         errorLog<< "loadDatasetFromFile(string fileName) - Failed to find NumberOfPositionTrackers!" << endl;
 		file.close();
 		return false;
@@ -583,8 +572,7 @@ bool LabelledContinuousTimeSeriesClassificationData::loadDatasetFromFile(string
 	timeSeriesPositionTracker.resize( numTrackingPoints );
 
 	//Get the TimeSeriesPositionTrackers
-	file >> word;
-	if(word != "TimeSeriesPositionTrackers:"){
+	if( !file.matchWord("TimeSeriesPositionTrackers:") ){
         errorLog<< "loadDatasetFromFile(string fileName) - Failed to find TimeSeriesPositionTrackers!" << endl;
 		file.close();
 		return false;
@@ -601,8 +589,7 @@ bool LabelledContinuousTimeSeriesClassificationData::loadDatasetFromFile(string
 	}
     
     //Check if the dataset should be scaled using external ranges
-	file >> word;
-	if(word != "UseExternalRanges:"){
+	if( !file.matchWord("UseExternalRanges:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
@@ -619,32 +606,104 @@ bool LabelledContinuousTimeSeriesClassificationData::loadDatasetFromFile(string
     }
 	
 	//Get the main time series data
-	file >> word;
-	if(word != "LabelledContinuousTimeSeriesClassificationData:"){
+	if( !file.matchWord("LabelledContinuousTimeSeriesClassificationData:") ){
         errorLog<< "loadDatasetFromFile(string fileName) - Failed to find LabelledContinuousTimeSeriesClassificationData!" << endl;
 		file.close();
 		return false;
 	}
 
 	//Reset the memory
-	data.resize( totalNumSamples, LabelledClassificationSample() );
+	data.resize( totalNumSamples, LabelledClassificationSample(numDimensions) );
 
-	//Load each sample
+	//Load each sample, the values are read straight into the samples
 	for(UINT i=0; i<totalNumSamples; i++){
 		UINT classLabel = 0;
-		vector<double> sample(numDimensions);
 
 		file >> classLabel;
 		for(UINT j=0; j<numDimensions; j++){
-			file >> sample[j];
+			file >> data[i][j];
 		}
 
-		data[i].set(classLabel,sample);
+		data[i].setClassLabel(classLabel);
+	}
+
+	if( file.fail() ){
+        errorLog<< "loadDatasetFromFile(string fileName) - Failed to read the time series data!" << endl;
+		file.close();
+		clear();
+		return false;
 	}
 
 	file.close();
 	return true;
 }
+
+
+bool LabelledContinuousTimeSeriesClassificationData::saveDatasetToBinaryFile(const string &filename,UINT chunkSize){
+
+    BinaryDatasetWriter writer;
+
+    if( !writer.open( filename, BinaryDatasetFile::LABELLED_CONTINUOUS_TIME_SERIES_CLASSIFICATION_DATA, numDimensions, 0, chunkSize ) ){
+        errorLog << "saveDatasetToBinaryFile(const string &filename,UINT chunkSize) - Failed to open file!" << endl;
+        return false;
+    }
+
+    writer.setDatasetName( datasetName );
+    writer.setInfoText( infoText );
+    writer.setClassTracker( classTracker );
+    writer.setExternalRanges( externalRanges, vector< MinMax >(), useExternalRanges );
+
+    for(UINT i=0; i<totalNumSamples; i++){
+        if( !writer.addRow( data[i].getClassLabel(), i, &data[i][0] ) ){
+            errorLog << "saveDatasetToBinaryFile(const string &filename,UINT chunkSize) - Failed to write sample " << i << endl;
+            writer.close();
+            return false;
+        }
+    }
+
+    return writer.close();
+}
+
+bool LabelledContinuousTimeSeriesClassificationData::loadDatasetFromBinaryFile(const string &filename){
+
+    BinaryDatasetReader reader;
+    clear();
+
+    if( !reader.open( filename ) ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - could not open file!" << endl;
+        return false;
+    }
+
+    if( reader.getDatasetType() != BinaryDatasetFile::LABELLED_CONTINUOUS_TIME_SERIES_CLASSIFICATION_DATA ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - The file does not contain labelled continuous time series classification data!" << endl;
+        return false;
+    }
+
+    datasetName = reader.getDatasetName();
+    infoText = reader.getInfoText();
+    numDimensions = reader.getNumDimensions();
+    useExternalRanges = reader.getUseExternalRanges();
+    externalRanges = reader.getExternalRanges();
+
+    //The samples are added one at a time so the class counters and the time series position trackers are rebuilt
+    data.reserve( (UINT)reader.getTotalNumRows() );
+    VectorDouble sample( numDimensions );
+    BinaryDatasetChunk chunk;
+    while( reader.readNextChunk( chunk ) ){
+        for(UINT i=0; i<chunk.getNumRows(); i++){
+            chunk.getSample( i, &sample[0] );
+            addSample( chunk.getClassLabels()[i], sample );
+        }
+    }
+
+    //Restore the class names
+    const vector< ClassTracker > &savedClassTracker = reader.getClassTracker();
+    for(UINT k=0; k<savedClassTracker.size(); k++){
+        setClassNameForCorrespondingClassLabel( savedClassTracker[k].className, savedClassTracker[k].classLabel );
+    }
+
+    return true;
+}
     
 bool LabelledContinuousTimeSeriesClassificationData::saveDatasetToCSVFile(string filename){
     std::fstream file; 
@@ -30,6 +30,7 @@
 #define GRT_LABELLED_CONTINUOUS_TIME_SERIES_CLASSIFICATION_SAMPLE_HEADER
 
 #include "../Util/GRTCommon.h"
+#include "BinaryDatasetFile.h"
 #include "TimeSeriesPositionTracker.h"
 #include "LabelledClassificationData.h"
 #include "LabelledTimeSeriesClassificationData.h"
@@ -236,6 +237,24 @@ public:
 	 @return true if the data was loaded successfully, false otherwise
      */
 	bool loadDatasetFromFile(string filename);
+
+    /**
+     Saves the labelled continuous timeseries classification data to a GRT binary dataset file. The binary file can be loaded much faster than the text file,
+     and it can be read a chunk at a time with the BinaryDatasetReader (see BinaryDatasetFile.h).
+
+     @param const string &filename: the name of the file the data will be saved to
+     @param UINT chunkSize: the maximum number of rows in each chunk of the file
+     @return true if the data was saved successfully, false otherwise
+     */
+    bool saveDatasetToBinaryFile(const string &filename,UINT chunkSize = 10000);
+
+    /**
+     Loads the labelled continuous timeseries classification data from a GRT binary dataset file.
+
+     @param const string &filename: the name of the file the data will be loaded from
+     @return true if the data was loaded successfully, false otherwise
+     */
+    bool loadDatasetFromBinaryFile(const string &filename);
     
     /**
      Saves the labelled timeseries classification data to a CSV file.
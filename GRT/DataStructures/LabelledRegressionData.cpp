@@ -512,47 +512,40 @@ bool LabelledRegressionData::saveDatasetToFile(const string &filename) const{
 
 bool LabelledRegressionData::loadDatasetFromFile(const string &filename){
 
-	std::fstream file;
-	file.open(filename.c_str(), std::ios::in);
+	FileTokenizer file;
 	clear();
 
-	if( !file.is_open() ){
+	if( !file.open( filename ) ){
         errorLog << "loadDatasetFromFile(const string &filename) - Failed to open file!" << endl;
 		return false;
 	}
 
-	string word;
-
 	//Check to make sure this is a file with the Training File Format
-	file >> word;
-	if(word != "GRT_LABELLED_REGRESSION_DATA_FILE_V1.0"){
+	if( !file.matchWord("GRT_LABELLED_REGRESSION_DATA_FILE_V1.0") ){
         errorLog << "loadDatasetFromFile(const string &filename) - Unknown file header!" << endl;
 		file.close();
 		return false;
 	}
 
     //Get the name of the dataset
-	file >> word;
-	if(word != "DatasetName:"){
+	if( !file.matchWord("DatasetName:") ){
         errorLog << "loadDatasetFromFile(const string &filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
 	}
 	file >> datasetName;
 
-    file >> word;
-	if(word != "InfoText:"){
+	if( !file.matchWord("InfoText:") ){
         errorLog << "loadDatasetFromFile(const string &filename) - failed to find InfoText!" << endl;
 		file.close();
 		return false;
 	}
 
     //Load the info text
-    file >> word;
+    string word;
     infoText = "";
-    while( word != "NumInputDimensions:" ){
+    while( file.readValue( word ) && word != "NumInputDimensions:" ){
         infoText += word + " ";
-        file >> word;
     }
 
 	//Get the number of input dimensions in the training data
@@ -564,8 +557,7 @@ bool LabelledRegressionData::loadDatasetFromFile(const string &filename){
 	file >> numInputDimensions;
 
 	//Get the number of target dimensions in the training data
-	file >> word;
-	if(word != "NumTargetDimensions:"){
+	if( !file.matchWord("NumTargetDimensions:") ){
         errorLog << "loadDatasetFromFile(const string &filename) - Failed to find NumTargetDimensions!" << endl;
 		file.close();
 		return false;
@@ -573,8 +565,7 @@ bool LabelledRegressionData::loadDatasetFromFile(const string &filename){
 	file >> numTargetDimensions;
 
 	//Get the total number of training examples in the training data
-	file >> word;
-	if(word != "TotalNumTrainingExamples:"){
+	if( !file.matchWord("TotalNumTrainingExamples:") ){
         errorLog << "loadDatasetFromFile(const string &filename) - Failed to find TotalNumTrainingExamples!" << endl;
 		file.close();
 		return false;
@@ -582,8 +573,7 @@ bool LabelledRegressionData::loadDatasetFromFile(const string &filename){
 	file >> totalNumSamples;
 
     //Check if the dataset should be scaled using external ranges
-	file >> word;
-	if(word != "UseExternalRanges:"){
+	if( !file.matchWord("UseExternalRanges:") ){
         errorLog << "loadDatasetFromFile(const string &filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
@@ -605,8 +595,7 @@ bool LabelledRegressionData::loadDatasetFromFile(const string &filename){
     }
 
 	//Get the main training data
-	file >> word;
-	if(word != "LabelledRegressionData:"){
+	if( !file.matchWord("LabelledRegressionData:") ){
         errorLog << "loadDatasetFromFile(const string &filename) - Failed to find LabelledRegressionData!" << endl;
 		file.close();
 		return false;
@@ -627,10 +616,92 @@ bool LabelledRegressionData::loadDatasetFromFile(const string &filename){
         data[i].set(inputVector, targetVector);
 	}
 
+	if( file.fail() ){
+        errorLog << "loadDatasetFromFile(const string &filename) - Failed to read the training data!" << endl;
+		file.close();
+		clear();
+		return false;
+	}
+
 	file.close();
 	return true;
 }
 
+
+bool LabelledRegressionData::saveDatasetToBinaryFile(const string &filename,UINT chunkSize) const{
+
+    BinaryDatasetWriter writer;
+
+    if( !writer.open( filename, BinaryDatasetFile::LABELLED_REGRESSION_DATA, numInputDimensions, numTargetDimensions, chunkSize ) ){
+        errorLog << "saveDatasetToBinaryFile(const string &filename,UINT chunkSize) - Failed to open file!" << endl;
+        return false;
+    }
+
+    writer.setDatasetName( datasetName );
+    writer.setInfoText( infoText );
+    writer.setExternalRanges( externalInputRanges, externalTargetRanges, useExternalRanges );
+
+    VectorDouble inputVector( numInputDimensions );
+    VectorDouble targetVector( numTargetDimensions );
+    for(UINT i=0; i<totalNumSamples; i++){
+        for(UINT j=0; j<numInputDimensions; j++) inputVector[j] = data[i].getInputVectorValue(j);
+        for(UINT j=0; j<numTargetDimensions; j++) targetVector[j] = data[i].getTargetVectorValue(j);
+        if( !writer.addRow( 0, i, &inputVector[0], &targetVector[0] ) ){
+            errorLog << "saveDatasetToBinaryFile(const string &filename,UINT chunkSize) - Failed to write sample " << i << endl;
+            writer.close();
+            return false;
+        }
+    }
+
+    return writer.close();
+}
+
+bool LabelledRegressionData::loadDatasetFromBinaryFile(const string &filename){
+
+    BinaryDatasetReader reader;
+    clear();
+
+    if( !reader.open( filename ) ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - could not open file!" << endl;
+        return false;
+    }
+
+    if( reader.getDatasetType() != BinaryDatasetFile::LABELLED_REGRESSION_DATA ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - The file does not contain labelled regression data!" << endl;
+        return false;
+    }
+
+    datasetName = reader.getDatasetName();
+    infoText = reader.getInfoText();
+    numInputDimensions = reader.getNumDimensions();
+    numTargetDimensions = reader.getNumTargetDimensions();
+    useExternalRanges = reader.getUseExternalRanges();
+    externalInputRanges = reader.getExternalRanges();
+    externalTargetRanges = reader.getExternalTargetRanges();
+
+    VectorDouble inputVector( numInputDimensions );
+    VectorDouble targetVector( numTargetDimensions );
+    data.resize( (UINT)reader.getTotalNumRows(), LabelledRegressionSample(inputVector,targetVector) );
+    BinaryDatasetChunk chunk;
+    UINT index = 0;
+    while( reader.readNextChunk( chunk ) ){
+        if( index + chunk.getNumRows() > data.size() ) break;
+        for(UINT i=0; i<chunk.getNumRows(); i++){
+            chunk.getSample( i, &inputVector[0] );
+            chunk.getTarget( i, &targetVector[0] );
+            data[index++].set( inputVector, targetVector );
+        }
+    }
+    if( index != data.size() ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - failed to read all the rows, only " << index << " of the " << data.size() << " rows given in the header were read!" << endl;
+        clear();
+        return false;
+    }
+    totalNumSamples = index;
+
+    return true;
+}
+
 bool LabelledRegressionData::saveDatasetToCSVFile(const string &filename) const{
 
     std::fstream file;
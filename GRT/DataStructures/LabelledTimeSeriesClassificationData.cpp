@@ -349,21 +349,17 @@ bool LabelledTimeSeriesClassificationData::saveDatasetToFile(string fileName){
 
 bool LabelledTimeSeriesClassificationData::loadDatasetFromFile(string filename){
 
-	std::fstream file;
-	file.open(filename.c_str(), std::ios::in);
+	FileTokenizer file;
 	UINT numClasses = 0;
 	clear();
 
-	if( !file.is_open() ){
+	if( !file.open( filename ) ){
 		errorLog << "loadDatasetFromFile(string filename) - FILE NOT OPEN!" << endl;
 		return false;
 	}
 
-	string word;
-
 	//Check to make sure this is a file with the Training File Format
-	file >> word;
-	if(word != "GRT_LABELLED_TIME_SERIES_CLASSIFICATION_DATA_FILE_V1.0"){
+	if( !file.matchWord("GRT_LABELLED_TIME_SERIES_CLASSIFICATION_DATA_FILE_V1.0") ){
 		file.close();
         clear();
         errorLog << "loadDatasetFromFile(string filename) - Failed to find file header!" << endl;
@@ -371,27 +367,24 @@ bool LabelledTimeSeriesClassificationData::loadDatasetFromFile(string filename){
 	}
 
     //Get the name of the dataset
-	file >> word;
-	if(word != "DatasetName:"){
+	if( !file.matchWord("DatasetName:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
 	}
 	file >> datasetName;
 
-    file >> word;
-	if(word != "InfoText:"){
+	if( !file.matchWord("InfoText:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find InfoText!" << endl;
 		file.close();
 		return false;
 	}
 
     //Load the info text
-    file >> word;
+    string word;
     infoText = "";
-    while( word != "NumDimensions:" ){
+    while( file.readValue( word ) && word != "NumDimensions:" ){
         infoText += word + " ";
-        file >> word;
     }
 
 	//Get the number of dimensions in the training data
@@ -404,8 +397,7 @@ bool LabelledTimeSeriesClassificationData::loadDatasetFromFile(string filename){
 	file >> numDimensions;
 
 	//Get the total number of training examples in the training data
-	file >> word;
-	if(word != "TotalNumTrainingExamples:"){
+	if( !file.matchWord("TotalNumTrainingExamples:") ){
 		file.close();
         clear();
         errorLog << "loadDatasetFromFile(string filename) - Failed to find TotalNumTrainingExamples!" << endl;
@@ -414,8 +406,7 @@ bool LabelledTimeSeriesClassificationData::loadDatasetFromFile(string filename){
 	file >> totalNumSamples;
 
 	//Get the total number of classes in the training data
-	file >> word;
-	if(word != "NumberOfClasses:"){
+	if( !file.matchWord("NumberOfClasses:") ){
 		file.close();
         clear();
         errorLog << "loadDatasetFromFile(string filename) - Failed to find NumberOfClasses!" << endl;
@@ -427,8 +418,7 @@ bool LabelledTimeSeriesClassificationData::loadDatasetFromFile(string filename){
 	classTracker.resize(numClasses);
 
 	//Get the total number of classes in the training data
-	file >> word;
-	if(word != "ClassIDsAndCounters:"){
+	if( !file.matchWord("ClassIDsAndCounters:") ){
 		file.close();
         clear();
         errorLog << "loadDatasetFromFile(string filename) - Failed to find ClassIDsAndCounters!" << endl;
@@ -441,8 +431,7 @@ bool LabelledTimeSeriesClassificationData::loadDatasetFromFile(string filename){
 	}
 
     //Get the UseExternalRanges
-	file >> word;
-	if(word != "UseExternalRanges:"){
+	if( !file.matchWord("UseExternalRanges:") ){
 		file.close();
         clear();
         errorLog << "loadDatasetFromFile(string filename) - Failed to find UseExternalRanges!" << endl;
@@ -460,8 +449,7 @@ bool LabelledTimeSeriesClassificationData::loadDatasetFromFile(string filename){
     }
 
 	//Get the main training data
-	file >> word;
-	if(word != "LabelledTimeSeriesTrainingData:"){
+	if( !file.matchWord("LabelledTimeSeriesTrainingData:") ){
         file.close();
         clear();
         errorLog << "loadDatasetFromFile(string filename) - Failed to find LabelledTimeSeriesTrainingData!" << endl;
@@ -476,16 +464,14 @@ bool LabelledTimeSeriesClassificationData::loadDatasetFromFile(string filename){
 		UINT classLabel = 0;
 		UINT timeSeriesLength = 0;
 
-		file >> word;
-		if( word != "************TIME_SERIES************" ){
+		if( !file.matchWord("************TIME_SERIES************") ){
 			file.close();
             clear();
             errorLog << "loadDatasetFromFile(string filename) - Failed to find TimeSeries Header!" << endl;
             return false;
 		}
 
-		file >> word;
-		if( word != "ClassID:" ){
+		if( !file.matchWord("ClassID:") ){
 			file.close();
             clear();
             errorLog << "loadDatasetFromFile(string filename) - Failed to find ClassID!" << endl;
@@ -493,8 +479,7 @@ bool LabelledTimeSeriesClassificationData::loadDatasetFromFile(string filename){
 		}
 		file >> classLabel;
 
-		file >> word;
-		if( word != "TimeSeriesLength:" ){
+		if( !file.matchWord("TimeSeriesLength:") ){
 			file.close();
             clear();
             errorLog << "loadDatasetFromFile(string filename) - Failed to find TimeSeriesLength!" << endl;
@@ -502,8 +487,7 @@ bool LabelledTimeSeriesClassificationData::loadDatasetFromFile(string filename){
 		}
 		file >> timeSeriesLength;
 
-		file >> word;
-		if( word != "TimeSeriesData:" ){
+		if( !file.matchWord("TimeSeriesData:") ){
 			file.close();
             clear();
             errorLog << "loadDatasetFromFile(string filename) - Failed to find TimeSeriesData!" << endl;
@@ -521,9 +505,105 @@ bool LabelledTimeSeriesClassificationData::loadDatasetFromFile(string filename){
 		data[x].setTrainingSample(classLabel,trainingExample);
 	}
 
+	if( file.fail() ){
+        file.close();
+        clear();
+        errorLog << "loadDatasetFromFile(string filename) - Failed to read the time series data!" << endl;
+		return false;
+	}
+
 	file.close();
 	return true;
 }
+
+
+//Adds the rows in the buffer to the dataset as one time series, and then clears the buffer
+static void addBufferedTimeSeries(vector< LabelledTimeSeriesClassificationSample > &data,UINT classLabel,vector< double > &buffer,UINT numDimensions){
+    const UINT timeSeriesLength = (UINT)(buffer.size() / numDimensions);
+    MatrixDouble timeSeries( timeSeriesLength, numDimensions );
+    for(UINT i=0; i<timeSeriesLength; i++){
+        std::copy( buffer.begin() + size_t(i)*numDimensions, buffer.begin() + size_t(i+1)*numDimensions, timeSeries[i] );
+    }
+    data.push_back( LabelledTimeSeriesClassificationSample( classLabel, timeSeries ) );
+    buffer.clear();
+}
+
+bool LabelledTimeSeriesClassificationData::saveDatasetToBinaryFile(const string &filename,UINT chunkSize){
+
+    BinaryDatasetWriter writer;
+
+    if( !writer.open( filename, BinaryDatasetFile::LABELLED_TIME_SERIES_CLASSIFICATION_DATA, numDimensions, 0, chunkSize ) ){
+        errorLog << "saveDatasetToBinaryFile(const string &filename,UINT chunkSize) - Failed to open file!" << endl;
+        return false;
+    }
+
+    writer.setDatasetName( datasetName );
+    writer.setInfoText( infoText );
+    writer.setClassTracker( classTracker );
+    writer.setExternalRanges( externalRanges, vector< MinMax >(), useExternalRanges );
+
+    //Each time step is written as one row, the sample index of the row is the index of its time series
+    for(UINT x=0; x<totalNumSamples; x++){
+        const UINT classLabel = data[x].getClassLabel();
+        for(UINT i=0; i<data[x].getLength(); i++){
+            if( !writer.addRow( classLabel, x, data[x][i] ) ){
+                errorLog << "saveDatasetToBinaryFile(const string &filename,UINT chunkSize) - Failed to write time series " << x << endl;
+                writer.close();
+                return false;
+            }
+        }
+    }
+
+    return writer.close();
+}
+
+bool LabelledTimeSeriesClassificationData::loadDatasetFromBinaryFile(const string &filename){
+
+    BinaryDatasetReader reader;
+    clear();
+
+    if( !reader.open( filename ) ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - could not open file!" << endl;
+        return false;
+    }
+
+    if( reader.getDatasetType() != BinaryDatasetFile::LABELLED_TIME_SERIES_CLASSIFICATION_DATA ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - The file does not contain labelled time series classification data!" << endl;
+        return false;
+    }
+
+    datasetName = reader.getDatasetName();
+    infoText = reader.getInfoText();
+    numDimensions = reader.getNumDimensions();
+    classTracker = reader.getClassTracker();
+    useExternalRanges = reader.getUseExternalRanges();
+    externalRanges = reader.getExternalRanges();
+
+    //A time series can span several chunks, so the rows of the current time series are buffered until its sample index changes
+    data.reserve( reader.getNumSamples() );
+    vector< double > timeSeriesBuffer;
+    UINT timeSeriesClassLabel = 0;
+    UINT timeSeriesIndex = 0;
+    BinaryDatasetChunk chunk;
+    while( reader.readNextChunk( chunk ) ){
+        for(UINT i=0; i<chunk.getNumRows(); i++){
+            if( timeSeriesBuffer.size() > 0 && chunk.getSampleIndexs()[i] != timeSeriesIndex ){
+                addBufferedTimeSeries( data, timeSeriesClassLabel, timeSeriesBuffer, numDimensions );
+            }
+            timeSeriesIndex = chunk.getSampleIndexs()[i];
+            timeSeriesClassLabel = chunk.getClassLabels()[i];
+            const size_t offset = timeSeriesBuffer.size();
+            timeSeriesBuffer.resize( offset + numDimensions );
+            chunk.getSample( i, &timeSeriesBuffer[offset] );
+        }
+    }
+    if( timeSeriesBuffer.size() > 0 ){
+        addBufferedTimeSeries( data, timeSeriesClassLabel, timeSeriesBuffer, numDimensions );
+    }
+    totalNumSamples = (UINT)data.size();
+
+    return true;
+}
     
 bool LabelledTimeSeriesClassificationData::printStats(){
     
@@ -217,47 +217,40 @@ bool UnlabelledClassificationData::saveDatasetToFile(string filename){
 
 bool UnlabelledClassificationData::loadDatasetFromFile(string filename){
 
-	std::fstream file;
-	file.open(filename.c_str(), std::ios::in);
+	FileTokenizer file;
 	clear();
 
-	if( !file.is_open() ){
+	if( !file.open( filename ) ){
         errorLog << "loadDatasetFromFile(string filename) - could not open file!" << endl;
 		return false;
 	}
 
-	string word;
-
 	//Check to make sure this is a file with the Training File Format
-	file >> word;
-	if(word != "GRT_UNLABELLED_CLASSIFICATION_DATA_FILE_V1.0"){
+	if( !file.matchWord("GRT_UNLABELLED_CLASSIFICATION_DATA_FILE_V1.0") ){
         errorLog << "loadDatasetFromFile(string filename) - could not find file header!" << endl;
 		file.close();
 		return false;
 	}
 
     //Get the name of the dataset
-	file >> word;
-	if(word != "DatasetName:"){
+	if( !file.matchWord("DatasetName:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
 	}
 	file >> datasetName;
 
-    file >> word;
-	if(word != "InfoText:"){
+	if( !file.matchWord("InfoText:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find InfoText!" << endl;
 		file.close();
 		return false;
 	}
 
     //Load the info text
-    file >> word;
+    string word;
     infoText = "";
-    while( word != "NumDimensions:" ){
+    while( file.readValue( word ) && word != "NumDimensions:" ){
         infoText += word + " ";
-        file >> word;
     }
 
 	//Get the number of dimensions in the training data
@@ -269,8 +262,7 @@ bool UnlabelledClassificationData::loadDatasetFromFile(string filename){
 	file >> numDimensions;
 
 	//Get the total number of training examples in the training data
-	file >> word;
-	if(word != "TotalNumTrainingExamples:"){
+	if( !file.matchWord("TotalNumTrainingExamples:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
@@ -278,8 +270,7 @@ bool UnlabelledClassificationData::loadDatasetFromFile(string filename){
 	file >> totalNumSamples;
 
     //Check if the dataset should be scaled using external ranges
-	file >> word;
-	if(word != "UseExternalRanges:"){
+	if( !file.matchWord("UseExternalRanges:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
@@ -296,8 +287,7 @@ bool UnlabelledClassificationData::loadDatasetFromFile(string filename){
     }
 
 	//Get the main training data
-	file >> word;
-	if(word != "UnlabelledTrainingData:"){
+	if( !file.matchWord("UnlabelledTrainingData:") ){
         errorLog << "loadDatasetFromFile(string filename) - failed to find DatasetName!" << endl;
 		file.close();
 		return false;
@@ -310,11 +300,83 @@ bool UnlabelledClassificationData::loadDatasetFromFile(string filename){
 		}
 	}
 
+	if( file.fail() ){
+        errorLog << "loadDatasetFromFile(string filename) - failed to read the training data!" << endl;
+		file.close();
+		clear();
+		return false;
+	}
+
 	file.close();
 	return true;
 }
 
 
+bool UnlabelledClassificationData::saveDatasetToBinaryFile(const string &filename,UINT chunkSize){
+
+    BinaryDatasetWriter writer;
+
+    if( !writer.open( filename, BinaryDatasetFile::UNLABELLED_CLASSIFICATION_DATA, numDimensions, 0, chunkSize ) ){
+        errorLog << "saveDatasetToBinaryFile(const string &filename,UINT chunkSize) - Failed to open file!" << endl;
+        return false;
+    }
+
+    writer.setDatasetName( datasetName );
+    writer.setInfoText( infoText );
+    writer.setExternalRanges( externalRanges, vector< MinMax >(), useExternalRanges );
+
+    for(UINT i=0; i<totalNumSamples; i++){
+        if( !writer.addRow( 0, i, data[i] ) ){
+            errorLog << "saveDatasetToBinaryFile(const string &filename,UINT chunkSize) - Failed to write sample " << i << endl;
+            writer.close();
+            return false;
+        }
+    }
+
+    return writer.close();
+}
+
+bool UnlabelledClassificationData::loadDatasetFromBinaryFile(const string &filename){
+
+    BinaryDatasetReader reader;
+    clear();
+
+    if( !reader.open( filename ) ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - could not open file!" << endl;
+        return false;
+    }
+
+    if( reader.getDatasetType() != BinaryDatasetFile::UNLABELLED_CLASSIFICATION_DATA ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - The file does not contain unlabelled classification data!" << endl;
+        return false;
+    }
+
+    datasetName = reader.getDatasetName();
+    infoText = reader.getInfoText();
+    numDimensions = reader.getNumDimensions();
+    useExternalRanges = reader.getUseExternalRanges();
+    externalRanges = reader.getExternalRanges();
+
+    data.resize( (UINT)reader.getTotalNumRows(), numDimensions );
+    BinaryDatasetChunk chunk;
+    UINT index = 0;
+    while( reader.readNextChunk( chunk ) ){
+        if( index + chunk.getNumRows() > data.getNumRows() ) break;
+        for(UINT i=0; i<chunk.getNumRows(); i++){
+            chunk.getSample( i, data[index++] );
+        }
+    }
+    if( index != data.getNumRows() ){
+        errorLog << "loadDatasetFromBinaryFile(const string &filename) - failed to read all the rows, only " << index << " of the " << data.getNumRows() << " rows given in the header were read!" << endl;
+        clear();
+        return false;
+    }
+    totalNumSamples = index;
+
+    return true;
+}
+
+
 bool UnlabelledClassificationData::saveDatasetToCSVFile(string filename){
 
     std::fstream file;
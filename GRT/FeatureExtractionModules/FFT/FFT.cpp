@@ -25,12 +25,14 @@ namespace GRT{
 //Register the FFT module with the FeatureExtraction base class
 RegisterFeatureExtractionModule< FFT > FFT::registerModule("FFT");
 
-FFT::FFT(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindowFunction,bool computeMagnitude,bool computePhase):tempBuffer(NULL){ 
+FFT::FFT(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindowFunction,bool computeMagnitude,bool computePhase){ 
     featureExtractionType = "FFT"; 
     initialized = false; 
     featureDataReady = false;
     numInputDimensions = 0;
     numOutputDimensions = 0;
+    hopCounter = 0;
+    slidingDFTCounter = 0;
     
     if( isPowerOfTwo(fftWindowSize) && hopSize > 0 && numDimensions > 0 ){
         init(fftWindowSize,hopSize,numDimensions,fftWindowFunction,computeMagnitude,computePhase);
@@ -38,36 +40,27 @@ FFT::FFT(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindowFuncti
 }
     
 FFT::FFT(const FFT &rhs){
+    
     //Invoke the equals operator to copy the data from the rhs instance to this instance
     *this = rhs;
 }
     
 FFT::~FFT(void){
-    if( tempBuffer != NULL ){
-        delete[] tempBuffer;
-        tempBuffer = NULL;
-    }
 }
     
 FFT& FFT::operator=(const FFT &rhs){
     if( this != &rhs ){
-        if( tempBuffer != NULL ){
-            delete[] tempBuffer;
-            tempBuffer = NULL;
-        }
-        
         this->hopSize = rhs.hopSize;
         this->dataBufferSize = rhs.dataBufferSize;
         this->fftWindowSize = rhs.fftWindowSize;
         this->fftWindowFunction = rhs.fftWindowFunction;
         this->hopCounter = rhs.hopCounter;
+        this->slidingDFTCounter = rhs.slidingDFTCounter;
         this->computeMagnitude = rhs.computeMagnitude;
         this->computePhase = rhs.computePhase;
         this->dataBuffer = rhs.dataBuffer;
         this->fft = rhs.fft;
         this->windowSizeMap = rhs.windowSizeMap;
-		this->tempBuffer = NULL;
-		if( this->dataBufferSize > 0 ) this->tempBuffer = new double[ this->dataBufferSize ];
         
         copyBaseVariables( (FeatureExtraction*)&rhs );
     }
@@ -158,13 +151,11 @@ bool FFT::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_FFT_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_FFT_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
@@ -174,40 +165,35 @@ bool FFT::loadSettingsFromFile(fstream &file){
         return false;
     }
     
-    file >> word;
-    if( word != "HopSize:" ){
+    if( !parser.matchWord("HopSize:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read HopSize header!" << endl;
         return false;     
     }
-    file >> hopSize;
+    parser >> hopSize;
     
-    file >> word;
-    if( word != "FftWindowSize:" ){
+    if( !parser.matchWord("FftWindowSize:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read FftWindowSize header!" << endl;
         return false;     
     }
-    file >> fftWindowSize;
+    parser >> fftWindowSize;
     
-    file >> word;
-    if( word != "FftWindowFunction:" ){
+    if( !parser.matchWord("FftWindowFunction:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read FftWindowFunction header!" << endl;
         return false;     
     }
-    file >> fftWindowFunction;
+    parser >> fftWindowFunction;
     
-    file >> word;
-    if( word != "ComputeMagnitude:" ){
+    if( !parser.matchWord("ComputeMagnitude:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read ComputeMagnitude header!" << endl;
         return false;     
     }
-    file >> computeMagnitude;
+    parser >> computeMagnitude;
     
-    file >> word;
-    if( word != "ComputePhase:" ){
+    if( !parser.matchWord("ComputePhase:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read ComputePhase header!" << endl;
         return false;     
     }
-    file >> computePhase;
+    parser >> computePhase;
     
     //Init the FFT module to ensure everything is initialized correctly
     return init(fftWindowSize,hopSize,numInputDimensions,fftWindowFunction,computeMagnitude,computePhase);
@@ -227,11 +213,6 @@ bool FFT::init(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindow
         return false;
     }
     
-    if( tempBuffer != NULL ){
-        delete[] tempBuffer;
-        tempBuffer = NULL;
-    }
-       
     this->dataBufferSize = fftWindowSize;
     this->fftWindowSize = fftWindowSize;
     this->hopSize = hopSize;
@@ -239,8 +220,8 @@ bool FFT::init(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindow
     this->computeMagnitude = computeMagnitude;
     this->computePhase = computePhase;
     hopCounter = 0;
+    slidingDFTCounter = 0;
     featureDataReady = false;
-    tempBuffer = new double[ dataBufferSize ];
     numInputDimensions = numDimensions;
     
     //Set the output size, the fftWindowSize is divided by 2 because the FFT is symmetrical so only half the actual FFT is returned
@@ -253,7 +234,7 @@ bool FFT::init(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindow
     featureVector.resize( numOutputDimensions, 0);
     
     dataBuffer.clear();
-    dataBuffer.resize(dataBufferSize,VectorDouble(numDimensions,0));
+    dataBuffer.resize(dataBufferSize,numDimensions,0);
     fft.clear();
     fft.resize(numDimensions);
     
@@ -269,15 +250,15 @@ bool FFT::init(UINT fftWindowSize,UINT hopSize,UINT numDimensions,UINT fftWindow
     return true;
 }
     
-bool FFT::computeFeatures(VectorDouble inputVector){ 
+bool FFT::computeFeatures(const VectorDouble &inputVector){ 
 #ifdef GRT_SAFE_CHECKING
     if( !initialized ){
-        errorLog << "computeFeatures(VectorDouble inputVector) - Not initialized!" << endl;
+        errorLog << "computeFeatures(const VectorDouble &inputVector) - Not initialized!" << endl;
         return false;
     }
     
     if( inputVector.size() != numInputDimensions ){
-        errorLog << "computeFeatures(VectorDouble inputVector) - The size of the inputVector (" << inputVector.size() << ") does not match that of the FeatureExtraction (" << numInputDimensions << ")!" << endl;
+        errorLog << "computeFeatures(const VectorDouble &inputVector) - The size of the inputVector (" << inputVector.size() << ") does not match that of the FeatureExtraction (" << numInputDimensions << ")!" << endl;
         return false;
     }
 #endif
@@ -314,6 +295,18 @@ bool FFT::update(const VectorDouble &x){
     }
 #endif
 
+    //If the window moves by one sample and the last FFT is still accurate enough, update the FFT with a sliding DFT. This
+    //needs the oldest value in the buffer, so it must be done before the new input is added
+    bool useSlidingDFT = hopSize == 1 && slidingDFTCounter > 0;
+    if( useSlidingDFT ){
+        for(UINT j=0; j<numInputDimensions; j++){
+            if( !fft[j].slideFFT( dataBuffer[0][j], x[j] ) ){
+                useSlidingDFT = false;
+                break;
+            }
+        }
+    }
+
     //Add the current input to the data buffers
     dataBuffer.push_back(x);
     
@@ -321,19 +314,18 @@ bool FFT::update(const VectorDouble &x){
     
     if( ++hopCounter == hopSize ){
         hopCounter = 0;
-        //Compute the FFT for each dimension
-        for(UINT j=0; j<numInputDimensions; j++){
-            
-            //Copy the input data for this dimension into the temp buffer
-            for(UINT i=0; i<dataBufferSize; i++){
-                tempBuffer[i] = dataBuffer[i][j];
-            }
-            
-            //Compute the FFT
-            if( !fft[j].computeFFT( tempBuffer ) ){
+        
+        if( useSlidingDFT ){
+            slidingDFTCounter--;
+        }else{
+            //Compute the FFT of all the dimensions at once, the buffer window is already interleaved by dimension
+            if( !FastFourierTransform::computeFFT( dataBuffer.getWindow(), numInputDimensions, &fft[0] ) ){
                 errorLog << "update(const VectorDouble &x) - Failed to compute FFT!" << endl;
                 return false;
             }
+            
+            //The sliding DFT can only be used once the buffer is full, as until then the window does not move
+            slidingDFTCounter = dataBuffer.getBufferFilled() ? fftWindowSize : 0;
         }
         
         //Flag that the fft was computed during this update
@@ -395,6 +387,7 @@ bool FFT::setHopSize(UINT hopSize){
     if( hopSize > 0 ){
         this->hopSize = hopSize;
         hopCounter = 0;
+        slidingDFTCounter = 0;
         return true;
     }
     errorLog << "setHopSize(UINT hopSize) - The hopSize value must be greater than zero!" << endl;
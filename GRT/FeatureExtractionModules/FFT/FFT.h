@@ -40,6 +40,10 @@
  and 2 represents the magnitude and phase vectors. If you only really need the magnitude or phase of a signal, as opposed to both, then you can turn off the computation 
  and concatenation of the element you do not need to save unnecessary computations and memory copies, this can either be done in the FFT's constructor or by using the 
  setComputeMagnitude(bool computeMagnitude) and setComputePhase(bool computePhase) functions.
+ 
+ If the hopSize is 1 and the RECTANGULAR_WINDOW is used, then once the buffer is full the FFT is updated with a sliding DFT, which
+ costs O(M) per sample rather than O(M log M). The full FFT is recomputed every fftWindowSize samples to stop rounding errors from
+ building up.
  */
 
 #ifndef GRT_FFT_HEADER
@@ -106,7 +110,7 @@ public:
 	 @param VectorDouble inputVector: the inputVector that should be processed.  Must have the same dimensionality as the FeatureExtraction module
 	 @return true if the data was processed, false otherwise
      */
-    virtual bool computeFeatures(VectorDouble inputVector);
+    virtual bool computeFeatures(const VectorDouble &inputVector);
     
     /**
      Sets the FeatureExtraction reset function, overwriting the base FeatureExtraction function.
@@ -309,8 +313,8 @@ protected:
     UINT hopCounter;                                            ///< Keeps track of how many input samples the FFT has seen
     bool computeMagnitude;                                      ///< Tracks if the magnitude (and power) of the FFT need to be computed
     bool computePhase;                                          ///< Tracks if the phase of the FFT needs to be computed
-    double *tempBuffer;                                         ///< A temporary buffer used to store the input data for the FFT
-    CircularBuffer< VectorDouble > dataBuffer;                  ///< A circular buffer used to store the previous M inputs
+    UINT slidingDFTCounter;                                     ///< The number of samples that can still be added with the sliding DFT before the FFT is recomputed
+    FrameBuffer dataBuffer;                                     ///< A circular buffer used to store the previous M inputs
     vector< FastFourierTransform > fft;                         ///< A buffer used to store the FFT results
     std::map< unsigned int, unsigned int > windowSizeMap;            ///< A map to relate the FFTWindowSize enumerations to actual values
     
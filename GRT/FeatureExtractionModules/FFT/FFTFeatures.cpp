@@ -151,13 +151,11 @@ bool FFTFeatures::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_FFT_FEATURES_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_FFT_FEATURES_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
@@ -168,55 +166,48 @@ bool FFTFeatures::loadSettingsFromFile(fstream &file){
     }
     
     //Load the FFTWindowSize
-    file >> word;
-    if( word != "FFTWindowSize:" ){
+    if( !parser.matchWord("FFTWindowSize:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read FFTWindowSize header!" << endl;
         return false;     
     }
-    file >> fftWindowSize;
+    parser >> fftWindowSize;
     
     //Load the NumOutputDimensions
-    file >> word;
-    if( word != "NumChannelsInFFTSignal:" ){
+    if( !parser.matchWord("NumChannelsInFFTSignal:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumChannelsInFFTSignal header!" << endl;
         return false;     
     }
-    file >> numChannelsInFFTSignal;
+    parser >> numChannelsInFFTSignal;
     
-    file >> word;
-    if( word != "ComputeMaxFreqFeature:" ){
+    if( !parser.matchWord("ComputeMaxFreqFeature:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read ComputeMaxFreqFeature header!" << endl;
         return false;     
     }
-    file >> computeMaxFreqFeature;
+    parser >> computeMaxFreqFeature;
     
-    file >> word;
-    if( word != "ComputeMaxFreqSpectrumRatio:" ){
+    if( !parser.matchWord("ComputeMaxFreqSpectrumRatio:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read ComputeMaxFreqSpectrumRatio header!" << endl;
         return false;     
     }
-    file >> computeMaxFreqSpectrumRatio;
+    parser >> computeMaxFreqSpectrumRatio;
     
-    file >> word;
-    if( word != "ComputeCentroidFeature:" ){
+    if( !parser.matchWord("ComputeCentroidFeature:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read ComputeCentroidFeature header!" << endl;
         return false;     
     }
-    file >> computeCentroidFeature;
+    parser >> computeCentroidFeature;
     
-    file >> word;
-    if( word != "ComputeTopNFreqFeatures:" ){
+    if( !parser.matchWord("ComputeTopNFreqFeatures:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read ComputeTopNFreqFeatures header!" << endl;
         return false;     
     }
-    file >> computeTopNFreqFeatures;
+    parser >> computeTopNFreqFeatures;
     
-    file >> word;
-    if( word != "N:" ){
+    if( !parser.matchWord("N:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read N header!" << endl;
         return false;     
     }
-    file >> N;
+    parser >> N;
     
     //Init the FFTFeatures module to ensure everything is initialized correctly
     return init(fftWindowSize,numChannelsInFFTSignal,computeMaxFreqFeature,computeMaxFreqSpectrumRatio,computeCentroidFeature,computeTopNFreqFeatures,N);
@@ -260,16 +251,16 @@ bool FFTFeatures::init(UINT fftWindowSize,UINT numChannelsInFFTSignal,bool compu
     return true;
 }
     
-bool FFTFeatures::computeFeatures(VectorDouble inputVector){ 
+bool FFTFeatures::computeFeatures(const VectorDouble &inputVector){ 
 #ifdef GRT_SAFE_CHECKING
     if( !initialized ){
-        errorLog << "computeFeatures(VectorDouble inputVector) - Not initialized!" << endl;
+        errorLog << "computeFeatures(const VectorDouble &inputVector) - Not initialized!" << endl;
         return false;
     }
     
     //The input vector should be the magnitude data from an FFT
     if( inputVector.size() != fftWindowSize*numChannelsInFFTSignal ){
-        errorLog << "computeFeatures(VectorDouble inputVector) - The size of the inputVector (" << inputVector.size() << ") does not match the expected size! Verify that the FFT module that generated this inputVector has a window size of " << fftWindowSize << " and the number of input channels is: " << numChannelsInFFTSignal << ". Also verify that only the magnitude values are being computed (and not the phase)." << endl;
+        errorLog << "computeFeatures(const VectorDouble &inputVector) - The size of the inputVector (" << inputVector.size() << ") does not match the expected size! Verify that the FFT module that generated this inputVector has a window size of " << fftWindowSize << " and the number of input channels is: " << numChannelsInFFTSignal << ". Also verify that only the magnitude values are being computed (and not the phase)." << endl;
         return false;
     }
 #endif
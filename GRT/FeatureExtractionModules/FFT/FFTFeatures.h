@@ -87,7 +87,7 @@ public:
 	 @param VectorDouble inputVector: the inputVector that should be processed.  Must have the same dimensionality as the FeatureExtraction module
 	 @return true if the data was processed, false otherwise
      */
-    virtual bool computeFeatures(VectorDouble inputVector);
+    virtual bool computeFeatures(const VectorDouble &inputVector);
     
     /**
      Sets the FeatureExtraction reset function, overwriting the base FeatureExtraction function.
@@ -25,6 +25,10 @@
 
 #include "FastFourierTransform.h"	
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 
 namespace GRT{
 
@@ -35,8 +39,7 @@ FastFourierTransform::FastFourierTransform(){
     windowSize = 0;
     windowFunction = RECTANGULAR_WINDOW;
     averagePower = 0;
-    
-    initFFT();
+    planChannels = 0;
 }
     
 FastFourierTransform::FastFourierTransform(const FastFourierTransform &rhs){
@@ -46,7 +49,7 @@ FastFourierTransform::FastFourierTransform(const FastFourierTransform &rhs){
     this->windowSize = rhs.windowSize;
     this->windowFunction = rhs.windowFunction;
     this->averagePower = 0;
-    this->initFFT();
+    this->planChannels = 0;
     
     if( rhs.initialized ){
         this->init(rhs.windowSize,rhs.windowFunction,rhs.computeMagnitude,rhs.computePhase);
@@ -75,7 +78,6 @@ FastFourierTransform& FastFourierTransform::operator=(const FastFourierTransform
         this->windowSize = rhs.windowSize;
         this->windowFunction = rhs.windowFunction;
         this->averagePower = 0;
-        this->initFFT();
         
         if( rhs.initialized ){
             this->init(rhs.windowSize,rhs.windowFunction,rhs.computeMagnitude,rhs.computePhase);
@@ -108,28 +110,23 @@ bool FastFourierTransform::init(unsigned int windowSize,unsigned int windowFunct
         return false;
     }
     
-    initFFT();
-    
     this->windowSize = windowSize;
     this->windowFunction = windowFunction;
     this->computeMagnitude = computeMagnitude;
     this->computePhase = computePhase;
     
+    //Build the tables for this window size
+    initFFT();
+    
     //Init the memory
     fftReal.resize( windowSize );
     fftImag.resize( windowSize );
-    tmpReal.resize( windowSize/2 );
-    tmpImag.resize( windowSize/2 );
     magnitude.resize( windowSize );
     phase.resize( windowSize );
     power.resize( windowSize );
     averagePower = 0;
     
     //Zero the memory
-    for(UINT i=0; i<windowSize/2; i++){
-        tmpReal[i] = 0;
-        tmpImag[i] = 0;
-    }
     for(UINT i=0; i<windowSize; i++){
         fftReal[i] = 0;
         fftImag[i] = 0;
@@ -150,14 +147,80 @@ bool FastFourierTransform::computeFFT(double *data){
         return false;
     }
     
-    //Window the input data
-    if( !windowData(data) ){
+    //Perform the FFT, this also applies the window function
+    if( !realFFT(data, 1, &fftReal[0], &fftImag[0]) ){
         return false;
     }
-    
-    //Perform the FFT
-    realFFT(data, &fftReal[0], &fftImag[0]);
 	
+    return computeSpectrum();
+}
+    
+bool FastFourierTransform::computeFFT(const double *data,const unsigned int numChannels,FastFourierTransform *ffts){
+    
+    if( data == NULL || ffts == NULL || numChannels == 0 ){
+        return false;
+    }
+    
+    //The first instance holds the tables and the working memory used to transform all the channels
+    FastFourierTransform &plan = ffts[0];
+    for(unsigned int c=0; c<numChannels; c++){
+        if( !ffts[c].initialized || ffts[c].windowSize != plan.windowSize || ffts[c].windowFunction != plan.windowFunction ){
+            return false;
+        }
+    }
+    
+    if( numChannels == 1 ){
+        if( !plan.realFFT(data, 1, &plan.fftReal[0], &plan.fftImag[0]) ) return false;
+        return plan.computeSpectrum();
+    }
+    
+    const unsigned int half = plan.windowSize / 2;
+    plan.channelReal.resize( half * numChannels );
+    plan.channelImag.resize( half * numChannels );
+    
+    if( !plan.realFFT(data, numChannels, &plan.channelReal[0], &plan.channelImag[0]) ){
+        return false;
+    }
+    
+    //Copy the results of each channel to its instance
+    for(unsigned int c=0; c<numChannels; c++){
+        FastFourierTransform &fft = ffts[c];
+        for(unsigned int k=0; k<half; k++){
+            fft.fftReal[k] = plan.channelReal[ k*numChannels + c ];
+            fft.fftImag[k] = plan.channelImag[ k*numChannels + c ];
+        }
+        fft.computeSpectrum();
+    }
+    
+    return true;
+}
+    
+bool FastFourierTransform::slideFFT(const double oldestValue,const double newValue){
+    
+    if( !initialized || windowFunction != RECTANGULAR_WINDOW ){
+        return false;
+    }
+    
+    //Moving the window forward by one sample gives X'[k] = (X[k] - oldestValue + newValue) * exp(2*PI*i*k/windowSize). The realFFT
+    //stores the complex conjugate of X[k], and packs the real DC and Nyquist values into the real and imaginary parts of bin 0
+    const unsigned int half = windowSize/2;
+    const double delta = newValue - oldestValue;
+    
+    fftReal[0] += delta;
+    fftImag[0] = -(fftImag[0] + delta);
+    
+    for(unsigned int k=1; k<half; k++){
+        const double re = fftReal[k] + delta;
+        const double im = fftImag[k];
+        fftReal[k] = re * realTwiddleReal[k] + im * realTwiddleImag[k];
+        fftImag[k] = im * realTwiddleReal[k] - re * realTwiddleImag[k];
+    }
+    
+    return computeSpectrum();
+}
+    
+bool FastFourierTransform::computeSpectrum(){
+    
     averagePower = 0;
     
     for(unsigned int i = 0; i<windowSize/2; i++){
@@ -179,37 +242,6 @@ bool FastFourierTransform::computeFFT(double *data){
     return true;
 }
     
-bool FastFourierTransform::windowData(double *data){
-    
-    switch( windowFunction ){
-        case RECTANGULAR_WINDOW:
-            return true;
-            break;
-        case BARTLETT_WINDOW:
-            for(unsigned int i=0; i<windowSize/2; i++) {
-                data[i] *= (i / (double) (windowSize / 2));
-                data[i + (windowSize/2)] *= (1.0 - (i / (double) (windowSize/2)));
-            }
-            return true;
-            break;
-        case HAMMING_WINDOW:
-            for(unsigned int i=0; i<windowSize; i++)
-                data[i] *= 0.54 - 0.46 * cos(2 * PI * i / (windowSize - 1));
-            return true;
-            break;
-        case HANNING_WINDOW:
-            for(unsigned int i=0; i <windowSize; i++)
-                data[i] *= 0.50 - 0.50 * cos(2 * PI * i / (windowSize - 1));
-            return true;
-            break;
-        default:
-            return false;
-            break;
-    }
-    
-    return false;
-}
-    
 VectorDouble FastFourierTransform::getMagnitudeData(){
     
     if( !initialized ) return VectorDouble();
@@ -263,14 +295,106 @@ double* FastFourierTransform::getPowerDataPtr(){
     return &power[0];
 }
     
+/*
+ * The butterflies work on split real and imaginary arrays. Each array holds the values of several channels interleaved, so the
+ * len values processed by one call are contiguous and every value has its own twiddle factor (the twiddle factors are repeated
+ * for each channel when the tables are built). This lets the loops process two values at a time with SSE2.
+ */
+static inline void radix2Butterflies(double *ar,double *ai,double *br,double *bi,const double *wr,const double *wi,const unsigned int len){
+    unsigned int q = 0;
+#if defined(__SSE2__)
+    for(; q+2 <= len; q += 2){
+        const __m128d wR = _mm_loadu_pd( wr+q ), wI = _mm_loadu_pd( wi+q );
+        const __m128d aR = _mm_loadu_pd( ar+q ), aI = _mm_loadu_pd( ai+q );
+        const __m128d bR = _mm_loadu_pd( br+q ), bI = _mm_loadu_pd( bi+q );
+        const __m128d tR = _mm_sub_pd( _mm_mul_pd( wR, bR ), _mm_mul_pd( wI, bI ) );
+        const __m128d tI = _mm_add_pd( _mm_mul_pd( wR, bI ), _mm_mul_pd( wI, bR ) );
+        _mm_storeu_pd( br+q, _mm_sub_pd( aR, tR ) );
+        _mm_storeu_pd( bi+q, _mm_sub_pd( aI, tI ) );
+        _mm_storeu_pd( ar+q, _mm_add_pd( aR, tR ) );
+        _mm_storeu_pd( ai+q, _mm_add_pd( aI, tI ) );
+    }
+#endif
+    for(; q<len; q++){
+        const double tR = wr[q] * br[q] - wi[q] * bi[q];
+        const double tI = wr[q] * bi[q] + wi[q] * br[q];
+        br[q] = ar[q] - tR;
+        bi[q] = ai[q] - tI;
+        ar[q] += tR;
+        ai[q] += tI;
+    }
+}
+    
+/*
+ * Runs two radix-2 stages at once (a radix-2^2 butterfly). The first stage combines (a,b) and (c,d) with the twiddle factors w1, the
+ * second stage combines (a,c) with w2 and (b,d) with i*w2, so each value is only loaded and stored once for both stages.
+ */
+static inline void radix4Butterflies(double *ar,double *ai,double *br,double *bi,double *cr,double *ci,double *dr,double *di,
+                                     const double *w1r,const double *w1i,const double *w2r,const double *w2i,const unsigned int len){
+    unsigned int q = 0;
+#if defined(__SSE2__)
+    for(; q+2 <= len; q += 2){
+        const __m128d w1R = _mm_loadu_pd( w1r+q ), w1I = _mm_loadu_pd( w1i+q );
+        const __m128d w2R = _mm_loadu_pd( w2r+q ), w2I = _mm_loadu_pd( w2i+q );
+        __m128d aR = _mm_loadu_pd( ar+q ), aI = _mm_loadu_pd( ai+q );
+        __m128d bR = _mm_loadu_pd( br+q ), bI = _mm_loadu_pd( bi+q );
+        __m128d cR = _mm_loadu_pd( cr+q ), cI = _mm_loadu_pd( ci+q );
+        __m128d dR = _mm_loadu_pd( dr+q ), dI = _mm_loadu_pd( di+q );
+        
+        __m128d tR = _mm_sub_pd( _mm_mul_pd( w1R, bR ), _mm_mul_pd( w1I, bI ) );
+        __m128d tI = _mm_add_pd( _mm_mul_pd( w1R, bI ), _mm_mul_pd( w1I, bR ) );
+        bR = _mm_sub_pd( aR, tR ); bI = _mm_sub_pd( aI, tI );
+        aR = _mm_add_pd( aR, tR ); aI = _mm_add_pd( aI, tI );
+        
+        tR = _mm_sub_pd( _mm_mul_pd( w1R, dR ), _mm_mul_pd( w1I, dI ) );
+        tI = _mm_add_pd( _mm_mul_pd( w1R, dI ), _mm_mul_pd( w1I, dR ) );
+        dR = _mm_sub_pd( cR, tR ); dI = _mm_sub_pd( cI, tI );
+        cR = _mm_add_pd( cR, tR ); cI = _mm_add_pd( cI, tI );
+        
+        tR = _mm_sub_pd( _mm_mul_pd( w2R, cR ), _mm_mul_pd( w2I, cI ) );
+        tI = _mm_add_pd( _mm_mul_pd( w2R, cI ), _mm_mul_pd( w2I, cR ) );
+        _mm_storeu_pd( cr+q, _mm_sub_pd( aR, tR ) ); _mm_storeu_pd( ci+q, _mm_sub_pd( aI, tI ) );
+        _mm_storeu_pd( ar+q, _mm_add_pd( aR, tR ) ); _mm_storeu_pd( ai+q, _mm_add_pd( aI, tI ) );
+        
+        const __m128d uR = _mm_sub_pd( _mm_mul_pd( w2R, dR ), _mm_mul_pd( w2I, dI ) );
+        const __m128d uI = _mm_add_pd( _mm_mul_pd( w2R, dI ), _mm_mul_pd( w2I, dR ) );
+        _mm_storeu_pd( dr+q, _mm_add_pd( bR, uI ) ); _mm_storeu_pd( di+q, _mm_sub_pd( bI, uR ) );
+        _mm_storeu_pd( br+q, _mm_sub_pd( bR, uI ) ); _mm_storeu_pd( bi+q, _mm_add_pd( bI, uR ) );
+    }
+#endif
+    for(; q<len; q++){
+        double aR = ar[q], aI = ai[q], bR = br[q], bI = bi[q];
+        double cR = cr[q], cI = ci[q], dR = dr[q], dI = di[q];
+        
+        double tR = w1r[q] * bR - w1i[q] * bI;
+        double tI = w1r[q] * bI + w1i[q] * bR;
+        bR = aR - tR; bI = aI - tI;
+        aR += tR; aI += tI;
+        
+        tR = w1r[q] * dR - w1i[q] * dI;
+        tI = w1r[q] * dI + w1i[q] * dR;
+        dR = cR - tR; dI = cI - tI;
+        cR += tR; cI += tI;
+        
+        tR = w2r[q] * cR - w2i[q] * cI;
+        tI = w2r[q] * cI + w2i[q] * cR;
+        cr[q] = aR - tR; ci[q] = aI - tI;
+        ar[q] = aR + tR; ai[q] = aI + tI;
+        
+        //(b,d) use i*w2, so t = i*u = (-uI, uR)
+        const double uR = w2r[q] * dR - w2i[q] * dI;
+        const double uI = w2r[q] * dI + w2i[q] * dR;
+        dr[q] = bR + uI; di[q] = bI - uR;
+        br[q] = bR - uI; bi[q] = bI + uR;
+    }
+}
+
 /*
  * Real Fast Fourier Transform
  *
- * This function was based on the code in Numerical Recipes in C.
- * In Num. Rec., the inner loop is based on a single 1-based array
- * of interleaved real and imaginary numbers.  Because we have two
- * separate zero-based arrays, our indices are quite different.
- * Here is the correspondence between Num. Rec. indices and our indices:
+ * This function was based on the code in Numerical Recipes in C. The windowSize real values are treated as a windowSize/2 complex
+ * signal (even samples as the real part, odd samples as the imaginary part), which is transformed with a complex FFT and then split
+ * into the spectrum of the real signal. Here is the correspondence between Num. Rec. indices and our indices:
  *
  * i1  <->  real[i]
  * i2  <->  imag[i]
@@ -278,134 +402,105 @@ double* FastFourierTransform::getPowerDataPtr(){
  * i4  <->  imag[n/2-i]
  */
 
-bool FastFourierTransform::realFFT(double *RealIn, double *RealOut, double *ImagOut){
-    int NumSamples = (int)windowSize;
-    int Half = NumSamples / 2;
-    int i;
+bool FastFourierTransform::realFFT(const double *data,const unsigned int numChannels,double *RealOut,double *ImagOut){
+    const unsigned int Half = windowSize / 2;
+    const unsigned int C = numChannels;
+    unsigned int i, c;
     
-    double theta = PI / Half;
+    if( numChannels != planChannels ){
+        initChannelTwiddles( numChannels );
+    }
     
-    for (i = 0; i < Half; i++) {
-        tmpReal[i] = RealIn[2 * i];
-        tmpImag[i] = RealIn[2 * i + 1];
+    //Window the data, split it into the real and imaginary parts of the complex signal and store it in bit reversed order
+    const double *window = windowCoefficients.size() > 0 ? &windowCoefficients[0] : NULL;
+    for(i = 0; i < Half; i++) {
+        const double *even = data + (2*i)*C;
+        const double *odd = even + C;
+        double *re = RealOut + bitReverseTable[i]*C;
+        double *im = ImagOut + bitReverseTable[i]*C;
+        if( window != NULL ){
+            const double evenWeight = window[2*i];
+            const double oddWeight = window[2*i+1];
+            for(c = 0; c < C; c++){
+                re[c] = even[c] * evenWeight;
+                im[c] = odd[c] * oddWeight;
+            }
+        }else{
+            for(c = 0; c < C; c++){
+                re[c] = even[c];
+                im[c] = odd[c];
+            }
+        }
     }
     
-    if( !FFT(Half, 0, &tmpReal[0], &tmpImag[0], RealOut, ImagOut) ){
+    if( !FFT(RealOut, ImagOut, numChannels) ){
         return false;
     }
     
-    double wtemp = double(sin(0.5 * theta));
-    
-    double wpr = -2.0 * wtemp * wtemp;
-    double wpi = double (sin(theta));
-    double wr = 1.0 + wpr;
-    double wi = wpi;
-    
-    int i3;
-    
     double h1r, h1i, h2r, h2i;
     
     for (i = 1; i < Half / 2; i++) {
         
-        i3 = Half - i;
-        
-        h1r = 0.5 * (RealOut[i] + RealOut[i3]);
-        h1i = 0.5 * (ImagOut[i] - ImagOut[i3]);
-        h2r = 0.5 * (ImagOut[i] + ImagOut[i3]);
-        h2i = -0.5 * (RealOut[i] - RealOut[i3]);
-        
-        RealOut[i] = h1r + wr * h2r - wi * h2i;
-        ImagOut[i] = h1i + wr * h2i + wi * h2r;
-        RealOut[i3] = h1r - wr * h2r + wi * h2i;
-        ImagOut[i3] = -h1i + wr * h2i + wi * h2r;
+        const unsigned int i3 = Half - i;
+        const double wr = realTwiddleReal[i];
+        const double wi = realTwiddleImag[i];
         
-        wr = (wtemp = wr) * wpr - wi * wpi + wr;
-        wi = wi * wpr + wtemp * wpi + wi;
+        for(c = 0; c < C; c++){
+            double *r1 = RealOut + i*C + c;
+            double *m1 = ImagOut + i*C + c;
+            double *r3 = RealOut + i3*C + c;
+            double *m3 = ImagOut + i3*C + c;
+            
+            h1r = 0.5 * (*r1 + *r3);
+            h1i = 0.5 * (*m1 - *m3);
+            h2r = 0.5 * (*m1 + *m3);
+            h2i = -0.5 * (*r1 - *r3);
+            
+            *r1 = h1r + wr * h2r - wi * h2i;
+            *m1 = h1i + wr * h2i + wi * h2r;
+            *r3 = h1r - wr * h2r + wi * h2i;
+            *m3 = -h1i + wr * h2i + wi * h2r;
+        }
     }
     
-    RealOut[0] = (h1r = RealOut[0]) + ImagOut[0];
-    ImagOut[0] = h1r - ImagOut[0];
+    for(c = 0; c < C; c++){
+        RealOut[c] = (h1r = RealOut[c]) + ImagOut[c];
+        ImagOut[c] = h1r - ImagOut[c];
+    }
     
     return true;
 }
 
-bool FastFourierTransform::FFT(int numSamples,bool inverseTransform,double *RealIn, double *ImagIn, double *RealOut, double *ImagOut){
-    int NumBits;                 /* Number of bits needed to store indices */
-    int i, j, k, n;
-    int BlockSize, BlockEnd;
+bool FastFourierTransform::FFT(double *RealOut,double *ImagOut,const unsigned int numChannels){
     
-    double angle_numerator = 2.0 * PI;
-    double tr, ti;                /* temp real, temp imaginary */
+    //The data is already in bit reversed order, so the FFT is computed in place one stage at a time. Each stage doubles the size
+    //of the blocks, two stages are run at once where possible
+    const unsigned int numSamples = windowSize / 2;
+    const unsigned int C = numChannels;
+    const double *twReal = C == 1 ? &twiddleReal[0] : &channelTwiddleReal[0];
+    const double *twImag = C == 1 ? &twiddleImag[0] : &channelTwiddleImag[0];
     
-    if( !isPowerOfTwo(numSamples) ) {
-        fprintf(stderr, "%d is not a power of two\n", numSamples);
-        return false;
-    }
-    
-    if( bitTable.size() == 0 ) initFFT();
-    
-    if( inverseTransform ) angle_numerator = -angle_numerator;
+    unsigned int BlockEnd = 1;
     
-    NumBits = numberOfBitsNeeded(numSamples);
-    
-    //Simultaneously data copy and bit-reversal ordering into outputs...
-    for(i = 0; i < numSamples; i++) {
-        j = fastReverseBits(i, NumBits);
-        RealOut[j] = RealIn[i];
-        ImagOut[j] = (ImagIn == NULL) ? 0.0 : ImagIn[i];
-    }
-    
-    //Do the FFT
-    BlockEnd = 1;
-    for (BlockSize = 2; BlockSize <= numSamples; BlockSize <<= 1) {
-        
-        double delta_angle = angle_numerator / (double) BlockSize;
-        
-        double sm2 = sin(-2 * delta_angle);
-        double sm1 = sin(-delta_angle);
-        double cm2 = cos(-2 * delta_angle);
-        double cm1 = cos(-delta_angle);
-        double w = 2 * cm1;
-        double ar0, ar1, ar2, ai0, ai1, ai2;
-        
-        for (i = 0; i < numSamples; i += BlockSize) {
-            ar2 = cm2;
-            ar1 = cm1;
-            
-            ai2 = sm2;
-            ai1 = sm1;
-            
-            for (j = i, n = 0; n < BlockEnd; j++, n++) {
-                ar0 = w * ar1 - ar2;
-                ar2 = ar1;
-                ar1 = ar0;
-                
-                ai0 = w * ai1 - ai2;
-                ai2 = ai1;
-                ai1 = ai0;
-                
-                k = j + BlockEnd;
-                tr = ar0 * RealOut[k] - ai0 * ImagOut[k];
-                ti = ar0 * ImagOut[k] + ai0 * RealOut[k];
-                
-                RealOut[k] = RealOut[j] - tr;
-                ImagOut[k] = ImagOut[j] - ti;
-                
-                RealOut[j] += tr;
-                ImagOut[j] += ti;
-            }
+    if( numberOfBitsNeeded( numSamples ) % 2 == 1 ){
+        for(unsigned int i = 0; i < numSamples; i += 2){
+            radix2Butterflies(RealOut + i*C, ImagOut + i*C, RealOut + (i+1)*C, ImagOut + (i+1)*C, twReal, twImag, C);
         }
-        
-        BlockEnd = BlockSize;
+        BlockEnd = 2;
     }
     
-    //Need to normalize the results if we are computing the inverse transform
-    if( inverseTransform ){
-        double denom = (double) numSamples;
+    for(; BlockEnd < numSamples; BlockEnd *= 4) {
+        
+        //The twiddle factors of the stage with blocks of size 2*BlockEnd start at (BlockEnd-1)*C in the table
+        const unsigned int len = BlockEnd * C;
+        const double *w1r = twReal + (BlockEnd-1)*C;
+        const double *w1i = twImag + (BlockEnd-1)*C;
+        const double *w2r = twReal + (2*BlockEnd-1)*C;
+        const double *w2i = twImag + (2*BlockEnd-1)*C;
         
-        for(i = 0; i < numSamples; i++) {
-            RealOut[i] /= denom;
-            ImagOut[i] /= denom;
+        for(unsigned int i = 0; i < numSamples; i += 4*BlockEnd) {
+            double *ar = RealOut + i*C, *ai = ImagOut + i*C;
+            radix4Butterflies(ar, ai, ar+len, ai+len, ar+2*len, ai+2*len, ar+3*len, ai+3*len, w1r, w1i, w2r, w2i, len);
         }
     }
     
@@ -436,26 +531,78 @@ int FastFourierTransform::reverseBits(int index, int numBits)
 
 void FastFourierTransform::initFFT()
 {
-    bitTable.resize( MAX_FAST_BITS );
+    const unsigned int half = windowSize / 2;
     
-    int len = 2;
-    for (int b = 1; b <= MAX_FAST_BITS; b++) {
-        
-        bitTable[b - 1].resize(len);
-        
-        for (int i = 0; i < len; i++)
-            bitTable[b - 1][i] = reverseBits(i, b);
-        
-        len <<= 1;
+    //Build the bit reversal table of the complex FFT
+    const int numBits = numberOfBitsNeeded( half );
+    bitReverseTable.resize( half );
+    for(unsigned int i=0; i<half; i++){
+        bitReverseTable[i] = reverseBits( i, numBits );
+    }
+    
+    //Build the twiddle factors of the complex FFT, stage by stage. The stage with blocks of size 2*L uses exp(2*PI*i*n/(2*L)) for
+    //n in [0 L-1], which is stored at index L-1+n
+    twiddleReal.resize( half > 1 ? half-1 : 1 );
+    twiddleImag.resize( half > 1 ? half-1 : 1 );
+    for(unsigned int L=1; L<half; L*=2){
+        for(unsigned int n=0; n<L; n++){
+            twiddleReal[L-1+n] = cos( PI * n / L );
+            twiddleImag[L-1+n] = sin( PI * n / L );
+        }
+    }
+    
+    //The twiddle factors for several channels are built when they are first needed
+    planChannels = 1;
+    channelTwiddleReal.clear();
+    channelTwiddleImag.clear();
+    
+    //Build the twiddle factors used by realFFT and the sliding DFT
+    realTwiddleReal.resize( half );
+    realTwiddleImag.resize( half );
+    for(unsigned int i=0; i<half; i++){
+        realTwiddleReal[i] = cos( 2.0 * PI * i / windowSize );
+        realTwiddleImag[i] = sin( 2.0 * PI * i / windowSize );
+    }
+    
+    //Build the window function
+    windowCoefficients.clear();
+    switch( windowFunction ){
+        case BARTLETT_WINDOW:
+            windowCoefficients.resize( windowSize );
+            for(unsigned int i=0; i<half; i++) {
+                windowCoefficients[i] = i / (double) half;
+                windowCoefficients[i + half] = 1.0 - (i / (double) half);
+            }
+            break;
+        case HAMMING_WINDOW:
+            windowCoefficients.resize( windowSize );
+            for(unsigned int i=0; i<windowSize; i++)
+                windowCoefficients[i] = 0.54 - 0.46 * cos(2 * PI * i / (windowSize - 1));
+            break;
+        case HANNING_WINDOW:
+            windowCoefficients.resize( windowSize );
+            for(unsigned int i=0; i<windowSize; i++)
+                windowCoefficients[i] = 0.50 - 0.50 * cos(2 * PI * i / (windowSize - 1));
+            break;
+        default:
+            break;
     }
 }
 
-inline int FastFourierTransform::fastReverseBits(int i, int numBits)
-{
-    if (numBits <= MAX_FAST_BITS)
-        return bitTable[numBits - 1][i];
-    else
-        return reverseBits(i, numBits);
+void FastFourierTransform::initChannelTwiddles(const unsigned int numChannels){
+    
+    //Repeat each twiddle factor once for each channel, so the butterflies can run over all the channels with one loop
+    const unsigned int numTwiddles = (unsigned int)twiddleReal.size();
+    channelTwiddleReal.resize( numTwiddles * numChannels );
+    channelTwiddleImag.resize( numTwiddles * numChannels );
+    for(unsigned int i=0; i<numTwiddles; i++){
+        for(unsigned int c=0; c<numChannels; c++){
+            channelTwiddleReal[ i*numChannels + c ] = twiddleReal[i];
+            channelTwiddleImag[ i*numChannels + c ] = twiddleImag[i];
+        }
+    }
+    
+    planChannels = numChannels;
 }
     
 inline bool FastFourierTransform::isPowerOfTwo(unsigned int x){
@@ -46,6 +46,28 @@ public:
     
     bool computeFFT(double *data);
     
+    /**
+     Computes the FFT of several channels at once. The data is interleaved, so sample i of channel c is stored at
+     data[i*numChannels + c], which is the layout of a FrameBuffer window. The results of channel c are stored in ffts[c].
+     
+     @param const double *data: a pointer to the windowSize*numChannels values to transform
+     @param const unsigned int numChannels: the number of channels
+     @param FastFourierTransform *ffts: a pointer to numChannels instances, which must all be initialized with the same settings
+     @return returns true if the FFT of each channel was computed, false otherwise
+     */
+    static bool computeFFT(const double *data,const unsigned int numChannels,FastFourierTransform *ffts);
+    
+    /**
+     Updates the FFT results for a window that has moved forward by one sample, using a sliding DFT. The previous results must be
+     the FFT of the previous window and the window function must be RECTANGULAR_WINDOW. This costs O(windowSize) rather than
+     O(windowSize log windowSize), but rounding errors build up with each call so the FFT should be recomputed every so often.
+     
+     @param const double oldestValue: the first value of the previous window, which is leaving the window
+     @param const double newValue: the new value at the end of the window
+     @return returns true if the FFT results were updated, false otherwise
+     */
+    bool slideFFT(const double oldestValue,const double newValue);
+    
     VectorDouble getMagnitudeData();
     VectorDouble getPhaseData();
     VectorDouble getPowerData();
@@ -57,13 +79,13 @@ public:
     UINT getFFTSize(){ return windowSize; }
     
 protected:
-    bool windowData(double *data);
-    bool realFFT(double *RealIn, double *RealOut, double *ImagOut);
-    bool FFT(int NumSamples,bool InverseTransform,double *RealIn, double *ImagIn, double *RealOut, double *ImagOut);
+    bool computeSpectrum();
+    bool realFFT(const double *data,const unsigned int numChannels,double *RealOut,double *ImagOut);
+    bool FFT(double *RealOut,double *ImagOut,const unsigned int numChannels);
     int numberOfBitsNeeded(int PowerOfTwo);
     int reverseBits(int index, int NumBits);
     void initFFT();
-    inline int fastReverseBits(int i, int NumBits);
+    void initChannelTwiddles(const unsigned int numChannels);
     inline bool isPowerOfTwo(unsigned int x);
     
     unsigned int windowSize;
@@ -73,14 +95,21 @@ protected:
     bool computePhase;
     VectorDouble fftReal;
     VectorDouble fftImag;
-    VectorDouble tmpReal;
-    VectorDouble tmpImag;
     VectorDouble magnitude;
     VectorDouble phase;
     VectorDouble power;
     double averagePower;
-    const static int MAX_FAST_BITS = 16;
-    vector< vector< int > > bitTable;
+    vector< int > bitReverseTable;          ///< The bit reversed index of each sample of the windowSize/2 complex FFT
+    VectorDouble twiddleReal;               ///< The real part of the twiddle factors of each stage of the complex FFT
+    VectorDouble twiddleImag;               ///< The imaginary part of the twiddle factors of each stage of the complex FFT
+    unsigned int planChannels;              ///< The number of channels the channel twiddle factors were built for
+    VectorDouble channelTwiddleReal;        ///< The twiddle factors repeated for each channel
+    VectorDouble channelTwiddleImag;
+    VectorDouble channelReal;               ///< The interleaved results of a multi channel FFT
+    VectorDouble channelImag;
+    VectorDouble realTwiddleReal;           ///< cos(2*PI*i/windowSize), used to split the complex FFT into the real FFT and the sliding DFT
+    VectorDouble realTwiddleImag;           ///< sin(2*PI*i/windowSize)
+    VectorDouble windowCoefficients;        ///< The window function, this is empty for the RECTANGULAR_WINDOW
     
 public:
     enum WindowFunctionOptions{RECTANGULAR_WINDOW=0,BARTLETT_WINDOW,HAMMING_WINDOW,HANNING_WINDOW};
@@ -30,6 +30,7 @@ KMeansQuantizer::KMeansQuantizer(UINT numDimensions,UINT numClusters){
     debugLog.setProceedingText("[DEBUG KMeansQuantizer]");
     errorLog.setProceedingText("[ERROR KMeansQuantizer]");
     warningLog.setProceedingText("[WARNING KMeansQuantizer]");
+    maxNumEpochs = 10000;
     
     init(numDimensions,numClusters);
 }
@@ -48,7 +49,10 @@ KMeansQuantizer& KMeansQuantizer::operator=(const KMeansQuantizer &rhs){
         //Here you should copy any class variables from the rhs instance to this instance
         this->quantizerTrained = rhs.quantizerTrained;
         this->numClusters = rhs.numClusters;
+        this->maxNumEpochs = rhs.maxNumEpochs;
         this->clusters = rhs.clusters;
+        this->distanceKernel = rhs.distanceKernel;
+        this->quantizationDistances = rhs.quantizationDistances;
         
         //Copy the base variables
         copyBaseVariables( (FeatureExtraction*)&rhs );
@@ -160,18 +164,18 @@ bool KMeansQuantizer::loadSettingsFromFile(fstream &file){
     initialized = false;
     numClusters = 0;
     clusters.clear();
+    distanceKernel.clear();
     quantizationDistances.clear();
     
     if( !file.is_open() ){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //First, you should read and validate the header
-    file >> word;
-    if( word != "KMEANS_QUANTIZER_FILE_V1.0" ){
+    if( !parser.matchWord("KMEANS_QUANTIZER_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;
     }
@@ -182,33 +186,31 @@ bool KMeansQuantizer::loadSettingsFromFile(fstream &file){
         return false;
     }
     
-    file >> word;
-    if( word != "QuantizerTrained:" ){
+    if( !parser.matchWord("QuantizerTrained:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to load QuantizerTrained!" << endl;
         return false;
     }
-    file >> quantizerTrained;
+    parser >> quantizerTrained;
     
-    file >> word;
-    if( word != "NumClusters:" ){
+    if( !parser.matchWord("NumClusters:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to load NumClusters!" << endl;
         return false;
     }
-    file >> numClusters;
+    parser >> numClusters;
     
     if( quantizerTrained ){
         clusters.resize(numClusters, numInputDimensions);
-        file >> word;
-        if( word != "Clusters:" ){
+        if( !parser.matchWord("Clusters:") ){
             errorLog << "loadSettingsFromFile(fstream &file) - Failed to load Clusters!" << endl;
             return false;
         }
         
         for(UINT k=0; k<numClusters; k++){
             for(UINT j=0; j<numInputDimensions; j++){
-                file >> clusters[k][j];
+                parser >> clusters[k][j];
             }
         }
+        distanceKernel.setClusters( clusters );
     }
     
     initialized = true;
@@ -224,6 +226,7 @@ bool KMeansQuantizer::init(UINT numDimensions,UINT numClusters){
     featureDataReady = false;
     featureVector.clear();
     clusters.clear();
+    distanceKernel.clear();
     quantizationDistances.clear();
     
     this->numClusters = numClusters;
@@ -268,6 +271,7 @@ bool KMeansQuantizer::train(MatrixDouble &trainingData){
     quantizerTrained = false;
     featureDataReady = false;
     clusters.clear();
+    distanceKernel.clear();
     quantizationDistances.clear();
     
     //Train the KMeans model
@@ -275,7 +279,7 @@ bool KMeansQuantizer::train(MatrixDouble &trainingData){
     kmeans.setComputeTheta( true );
     kmeans.setMinChange( 1.0e-10 );
     kmeans.setMinNumEpochs( 10 );
-	kmeans.setMaxNumEpochs( 10000 );
+	kmeans.setMaxNumEpochs( maxNumEpochs );
     
     if( !kmeans.train(numClusters, trainingData) ){
         errorLog << "train(MatrixDouble &trainingData) - Failed to train quantizer!" << endl;
@@ -284,6 +288,49 @@ bool KMeansQuantizer::train(MatrixDouble &trainingData){
     
     //Save the clusters from the KMeans model
     clusters = kmeans.getClusters();
+    distanceKernel.setClusters( clusters );
+    quantizationDistances.resize(numClusters,0);
+    quantizerTrained = true;
+    
+    return true;
+}
+
+bool KMeansQuantizer::train(ChunkedDatasetReader &reader){
+    
+    if( !initialized ){
+        errorLog << "train(ChunkedDatasetReader &reader) - The quantizer has not been initialized!" << endl;
+        return false;
+    }
+    
+    if( reader.getNumDimensions() != numInputDimensions ){
+        errorLog << "train(ChunkedDatasetReader &reader) - The number of dimensions in the dataset (" << reader.getNumDimensions() << ") does not match that of the quantizer (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    //Reset any previous model
+    quantizerTrained = false;
+    featureDataReady = false;
+    clusters.clear();
+    distanceKernel.clear();
+    quantizationDistances.clear();
+    
+    //Train the KMeans model, each epoch is a full pass through the dataset files
+    KMeans kmeans;
+    kmeans.setComputeTheta( true );
+    kmeans.setMinChange( 1.0e-10 );
+    kmeans.setMinNumEpochs( 1 );
+    kmeans.setMaxNumEpochs( maxNumEpochs );
+    
+    kmeans.train(numClusters, reader);
+    
+    if( !kmeans.getModelTrained() ){
+        errorLog << "train(ChunkedDatasetReader &reader) - Failed to train quantizer!" << endl;
+        return false;
+    }
+    
+    //Save the clusters from the KMeans model
+    clusters = kmeans.getClusters();
+    distanceKernel.setClusters( clusters );
     quantizationDistances.resize(numClusters,0);
     quantizerTrained = true;
     
@@ -313,21 +360,9 @@ UINT KMeansQuantizer::quantize(const VectorDouble &inputVector){
 	    }
 	#endif
 	
-	//Find the minimum cluster
-    double minDist = numeric_limits<double>::max();
-    UINT quantizedValue = 0;
-    
-    for(UINT k=0; k<numClusters; k++){
-        //Compute the squared Euclidean distance
-        quantizationDistances[k] = 0;
-        for(UINT i=0; i<numInputDimensions; i++){
-            quantizationDistances[k] += SQR( inputVector[i]-clusters[k][i] );
-        }
-        if( quantizationDistances[k] < minDist ){
-            minDist = quantizationDistances[k];
-            quantizedValue = k;
-        }
-    }
+	//Find the minimum cluster, this also computes the squared Euclidean distance to every cluster
+    double minDist = 0;
+    UINT quantizedValue = distanceKernel.computeDistances( &inputVector[0], &quantizationDistances[0], minDist );
     
     featureVector[0] = quantizedValue;
     featureDataReady = true;
@@ -335,4 +370,13 @@ UINT KMeansQuantizer::quantize(const VectorDouble &inputVector){
 	return quantizedValue;
 }
     
+bool KMeansQuantizer::setMaxNumEpochs(UINT maxNumEpochs){
+    if( maxNumEpochs > 0 ){
+        this->maxNumEpochs = maxNumEpochs;
+        return true;
+    }
+    errorLog << "setMaxNumEpochs(UINT maxNumEpochs) - The maximum number of epochs must be greater than zero!" << endl;
+    return false;
+}
+
 }//End of namespace GRT
\ No newline at end of file
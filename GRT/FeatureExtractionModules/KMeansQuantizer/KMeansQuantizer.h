@@ -32,6 +32,7 @@
  - LabelledContinuousTimeSeriesClassificationData
  - UnlabelledClassificationData
  - MatrixDouble
+ - ChunkedDatasetReader (for datasets that are too large to load into memory)
  */
 
 #ifndef GRT_KMEANS_QUANTIZER_HEADER
@@ -40,6 +41,7 @@
 //Include the main GRT header to get access to the FeatureExtraction base class
 #include "../../GestureRecognitionPipeline/FeatureExtraction.h"
 #include "../../ClusteringModules/KMeans/KMeans.h"
+#include "../../Util/SquaredDistanceKernel.h"
 #include "../../DataStructures/LabelledTimeSeriesClassificationData.h"
 #include "../../DataStructures/LabelledContinuousTimeSeriesClassificationData.h"
 #include "../../DataStructures/UnlabelledClassificationData.h"
@@ -190,6 +192,17 @@ public:
      @return returns true if the quantizer was trained successfully, false otherwise
      */
     bool train(MatrixDouble &trainingData);
+    
+    /**
+     Trains the quantization model using mini-batch KMeans, streaming the training samples from the dataset files
+     a chunk at a time. Use this to train a quantizer on datasets that are too large to load into memory.
+     Each epoch is a full pass through the dataset files, and mini-batch training rarely meets the stopping criteria
+     of the in-memory version, so you will usually want to lower the maximum number of epochs with setMaxNumEpochs first.
+     
+     @param ChunkedDatasetReader &reader: a reader that has been opened with the training dataset files
+     @return returns true if the quantizer was trained successfully, false otherwise
+     */
+    bool train(ChunkedDatasetReader &reader);
 
     /**
      Quantizes the input value using the quantization model. The quantization model must be trained first before you call this function.
@@ -240,10 +253,28 @@ public:
 		return clusters;
 	}
     
+    /**
+     Gets the maximum number of epochs the KMeans model can run for when the quantizer is trained.
+     
+     @return returns the maximum number of epochs
+     */
+    UINT getMaxNumEpochs() const { return maxNumEpochs; }
+    
+    /**
+     Sets the maximum number of epochs the KMeans model can run for when the quantizer is trained. The default is 10000.
+     When the quantizer is trained from a ChunkedDatasetReader each epoch is a full pass through the dataset files.
+     
+     @param UINT maxNumEpochs: the maximum number of epochs, this must be greater than zero
+     @return returns true if the value was set, false otherwise
+     */
+    bool setMaxNumEpochs(UINT maxNumEpochs);
+    
 protected:
     bool quantizerTrained;
     UINT numClusters;
+    UINT maxNumEpochs;
     MatrixDouble clusters;
+    SquaredDistanceKernel distanceKernel;
     VectorDouble quantizationDistances;
     
     static RegisterFeatureExtractionModule< KMeansQuantizer > registerModule;
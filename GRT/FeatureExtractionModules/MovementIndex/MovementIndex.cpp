@@ -46,6 +46,9 @@ MovementIndex& MovementIndex::operator=(const MovementIndex &rhs){
     if(this!=&rhs){
         this->bufferLength = rhs.bufferLength;
         this->dataBuffer = rhs.dataBuffer;
+        this->bufferMean = rhs.bufferMean;
+        this->bufferM2 = rhs.bufferM2;
+        this->numUpdatesSinceRecompute = rhs.numUpdatesSinceRecompute;
         
         //Copy the base variables
         copyBaseVariables( (FeatureExtraction*)&rhs );
@@ -158,13 +161,11 @@ bool MovementIndex::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_MOVEMENT_INDEX_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_MOVEMENT_INDEX_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
@@ -175,12 +176,11 @@ bool MovementIndex::loadSettingsFromFile(fstream &file){
     }
     
     //Load the BufferLength
-    file >> word;
-    if( word != "BufferLength:" ){
+    if( !parser.matchWord("BufferLength:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read BufferLength header!" << endl;
         return false;     
     }
-    file >> bufferLength;
+    parser >> bufferLength;
     
     //Init the MovementIndex module to ensure everything is initialized correctly
     return init(bufferLength,numInputDimensions);
@@ -209,7 +209,12 @@ bool MovementIndex::init(UINT bufferLength,UINT numDimensions){
     featureVector.resize(numInputDimensions);
     
     //Resize the raw trajectory data buffer
-    dataBuffer.resize( bufferLength, vector< double >(numInputDimensions,0) );
+    dataBuffer.resize( bufferLength, numInputDimensions, 0 );
+    bufferMean.clear();
+    bufferMean.resize( numInputDimensions, 0 );
+    bufferM2.clear();
+    bufferM2.resize( numInputDimensions, 0 );
+    numUpdatesSinceRecompute = 0;
 
     //Flag that the zero crossing counter has been initialized
     initialized = true;
@@ -236,9 +241,34 @@ vector< double > MovementIndex::update(const vector< double > &x){
     }
 #endif
     
+    //Update the mean and the sum of squared differences from the mean with the new sample, once the buffer is full the new sample
+    //replaces the oldest sample in the buffer
+    if( dataBuffer.getBufferFilled() ){
+        const double *oldest = dataBuffer[0];
+        const double n = double(bufferLength);
+        for(UINT j=0; j<numInputDimensions; j++){
+            const double delta = x[j] - oldest[j];
+            const double newMean = bufferMean[j] + delta / n;
+            bufferM2[j] += delta * ((x[j] - newMean) + (oldest[j] - bufferMean[j]));
+            bufferMean[j] = newMean;
+        }
+    }else{
+        const double n = double(dataBuffer.getNumValuesInBuffer()+1);
+        for(UINT j=0; j<numInputDimensions; j++){
+            const double delta = x[j] - bufferMean[j];
+            bufferMean[j] += delta / n;
+            bufferM2[j] += delta * (x[j] - bufferMean[j]);
+        }
+    }
+    
     //Add the new data to the trajectory data buffer
     dataBuffer.push_back( x );
     
+    //Recompute the statistics from the buffer every so often to stop rounding errors from building up
+    if( ++numUpdatesSinceRecompute >= bufferLength ){
+        recomputeStatistics();
+    }
+    
     //Only flag that the feature data is ready if the trajectory data is full
     if( !dataBuffer.getBufferFilled() ){
         featureDataReady = false;
@@ -249,30 +279,36 @@ vector< double > MovementIndex::update(const vector< double > &x){
     }else featureDataReady = true;
     
     //Compute the movement index (which is the RMS error)
-    vector< double > mu(numInputDimensions,0);
-    
-    //Compute mu
     for(UINT j=0; j<numInputDimensions; j++){
-        for(UINT i=0; i<dataBuffer.getSize(); i++){
-            mu[j] += dataBuffer[i][j];
-        }
-        mu[j] /= double(dataBuffer.getSize());
+        featureVector[j] = bufferM2[j] > 0 ? sqrt( bufferM2[j]/double(bufferLength) ) : 0;
     }
     
+    return featureVector;
+}
+    
+void MovementIndex::recomputeStatistics(){
+    
+    const UINT numValues = dataBuffer.getNumValuesInBuffer();
     for(UINT j=0; j<numInputDimensions; j++){
-        featureVector[j] = 0;
-        for(UINT i=0; i<dataBuffer.getSize(); i++){
-            featureVector[j] += SQR( dataBuffer[i][j] - mu[j] );
+        double mean = 0;
+        for(UINT i=0; i<numValues; i++){
+            mean += dataBuffer[i][j];
         }
-        featureVector[j] = sqrt( featureVector[j]/double(dataBuffer.getSize()) );
+        mean /= double(numValues);
+        
+        double m2 = 0;
+        for(UINT i=0; i<numValues; i++){
+            m2 += SQR( dataBuffer[i][j] - mean );
+        }
+        bufferMean[j] = mean;
+        bufferM2[j] = m2;
     }
-    
-    return featureVector;
+    numUpdatesSinceRecompute = 0;
 }
     
 CircularBuffer< vector< double > > MovementIndex::getData(){
     if( initialized ){
-        return dataBuffer;
+        return dataBuffer.getDataAsCircularBuffer();
     }
     return CircularBuffer< vector<double > >();
 }
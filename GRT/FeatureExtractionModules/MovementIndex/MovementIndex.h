@@ -28,6 +28,10 @@
  is good for extracting features that describe how much change is occuring in an N-dimensional signal over
  time.  An example application might be to use the MovementIndex in combination with one of the GRT classification
  algorithms to determine if an object is being moved or held still.
+ 
+ The mean and the sum of squared differences from the mean of the buffer are updated as each sample enters and leaves the buffer,
+ so the cost of an update does not depend on the buffer length. They are recomputed from the buffer every bufferLength samples to
+ stop rounding errors from building up.
  */
 
 #ifndef GRT_MOVEMENT_INDEX_HEADER
@@ -167,8 +171,16 @@ public:
     CircularBuffer< VectorDouble > getData();
 
 protected:
+    /**
+     Recomputes the mean and the sum of squared differences from the mean from the values in the buffer.
+     */
+    void recomputeStatistics();
+    
     UINT bufferLength;
-    CircularBuffer< vector< double > > dataBuffer;
+    FrameBuffer dataBuffer;
+    VectorDouble bufferMean;                        ///< The mean of the values in the buffer, for each dimension
+    VectorDouble bufferM2;                          ///< The sum of squared differences from the mean, for each dimension
+    UINT numUpdatesSinceRecompute;                  ///< The number of samples since the statistics were last recomputed
     
     static RegisterFeatureExtractionModule< MovementIndex > registerModule;
 };
@@ -170,13 +170,11 @@ bool MovementTrajectoryFeatures::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_MOVEMENT_TRAJECTORY_FEATURES_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_MOVEMENT_TRAJECTORY_FEATURES_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
@@ -187,52 +185,46 @@ bool MovementTrajectoryFeatures::loadSettingsFromFile(fstream &file){
     }
     
     //Load the TrajectoryLength
-    file >> word;
-    if( word != "TrajectoryLength:" ){
+    if( !parser.matchWord("TrajectoryLength:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read TrajectoryLength header!" << endl;
         return false;     
     }
-    file >> trajectoryLength;
+    parser >> trajectoryLength;
     
     //Load the NumCentroids
-    file >> word;
-    if( word != "NumCentroids:" ){
+    if( !parser.matchWord("NumCentroids:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumCentroids header!" << endl;
         return false;     
     }
-    file >> numCentroids;
+    parser >> numCentroids;
     
     //Load the FeatureMode
-    file >> word;
-    if( word != "FeatureMode:" ){
+    if( !parser.matchWord("FeatureMode:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read FeatureMode header!" << endl;
         return false;     
     }
-    file >> featureMode;
+    parser >> featureMode;
     
     //Load the NumHistogramBins
-    file >> word;
-    if( word != "NumHistogramBins:" ){
+    if( !parser.matchWord("NumHistogramBins:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumHistogramBins header!" << endl;
         return false;     
     }
-    file >> numHistogramBins;
+    parser >> numHistogramBins;
     
     //Load the UseTrajStartAndEndValues
-    file >> word;
-    if( word != "UseTrajStartAndEndValues:" ){
+    if( !parser.matchWord("UseTrajStartAndEndValues:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read UseTrajStartAndEndValues header!" << endl;
         return false;     
     }
-    file >> useTrajStartAndEndValues;
+    parser >> useTrajStartAndEndValues;
     
     //Load the UseWeightedMagnitudeValues
-    file >> word;
-    if( word != "UseWeightedMagnitudeValues:" ){
+    if( !parser.matchWord("UseWeightedMagnitudeValues:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read UseWeightedMagnitudeValues header!" << endl;
         return false;     
     }
-    file >> useWeightedMagnitudeValues;
+    parser >> useWeightedMagnitudeValues;
     
     //Init the ZeroCrossingCounter module to ensure everything is initialized correctly
     return init(trajectoryLength,numCentroids,featureMode,numHistogramBins,numInputDimensions,useTrajStartAndEndValues,useWeightedMagnitudeValues);
@@ -308,7 +300,7 @@ bool MovementTrajectoryFeatures::init(UINT trajectoryLength,UINT numCentroids,UI
     featureVector.resize(numOutputDimensions);
     
     //Resize the raw trajectory data buffer
-    trajectoryDataBuffer.resize( trajectoryLength, VectorDouble(numInputDimensions,0) );
+    trajectoryDataBuffer.resize( trajectoryLength, numInputDimensions, 0 );
     
     //Resize the centroids buffer
     centroids.resize(numCentroids,numInputDimensions);
@@ -473,7 +465,7 @@ VectorDouble MovementTrajectoryFeatures::update(const VectorDouble &x){
     
 CircularBuffer< VectorDouble > MovementTrajectoryFeatures::getTrajectoryData(){
     if( initialized ){
-        return trajectoryDataBuffer;
+        return trajectoryDataBuffer.getDataAsCircularBuffer();
     }
     return CircularBuffer< VectorDouble >();
 }
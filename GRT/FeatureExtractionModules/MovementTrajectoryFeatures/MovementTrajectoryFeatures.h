@@ -186,7 +186,7 @@ protected:
     UINT numHistogramBins;
     bool useTrajStartAndEndValues;
     bool useWeightedMagnitudeValues;
-    CircularBuffer< VectorDouble > trajectoryDataBuffer;
+    FrameBuffer trajectoryDataBuffer;
     MatrixDouble centroids;
     
     static RegisterFeatureExtractionModule< MovementTrajectoryFeatures > registerModule;
@@ -120,7 +120,7 @@ bool PeakDetection::init(UINT thresholdCrossingMode,UINT lowPassFilterSize,UINT
     
     //Setup the data buffer, we want the data buffer to be bigger than the search window, so that the previous minima/maxima does not get lost
     dataBufferSize = searchWindowSize*4;
-    dataBuffer.resize(dataBufferSize, vector< double >(3,0)); 
+    dataBuffer.resize(dataBufferSize, 3, 0); 
     
     //Set the search state
     currentSearchState = SEARCHING_FOR_FIRST_THRESHOLD_CROSSING;
@@ -156,10 +156,7 @@ bool PeakDetection::update(double x){
     deriv2 = deadZone.filter( deriv2 );
     
     //Add the new filtered value to the data buffer
-    vector< double > newData(3);
-    newData[0] = value;
-    newData[1] = deriv;
-    newData[2] = deriv2;
+    const double newData[3] = {value,deriv,deriv2};
     dataBuffer.push_back( newData );
     
     //printf("PeakDetection - diriv: %f LowerThreshold: %f UpperThreshold: %f SearchState: %i gateCounter: %i\n",diriv,negativeThreshold,positiveThreshold,currentSearchState,gateCounter);
@@ -272,7 +269,7 @@ bool PeakDetection::reset(){
         lpf.init(lowPassFilterSize,1);
         
         //Clear the data buffer
-        dataBuffer.setAllValues( vector< double >(3,0) );
+        dataBuffer.setAllValues( 0 );
         
         //Set the search state
         currentSearchState = SEARCHING_FOR_FIRST_THRESHOLD_CROSSING;
@@ -92,7 +92,7 @@ protected:
     MovingAverageFilter lpf;
     HighPassFilter hpf;
     DeadZone deadZone;
-    CircularBuffer< vector< double > > dataBuffer;
+    FrameBuffer dataBuffer;
     
     enum SearchStates{SEARCHING_FOR_FIRST_THRESHOLD_CROSSING=0,SEARCHING_FOR_SECOND_THRESHOLD_CROSSING,FOUND_CROSSING_SEARCHING_FOR_MINIMA_AND_MAXIMA,NO_SEARCH_GATE_TIME_OUT};
 public:
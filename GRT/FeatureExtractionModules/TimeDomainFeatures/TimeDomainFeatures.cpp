@@ -53,6 +53,9 @@ TimeDomainFeatures& TimeDomainFeatures::operator=(const TimeDomainFeatures &rhs)
         this->useEuclideanNorm = rhs.useEuclideanNorm;
         this->useRMS = rhs.useRMS;
         this->dataBuffer = rhs.dataBuffer;
+        this->frameMean = rhs.frameMean;
+        this->frameM2 = rhs.frameM2;
+        this->numUpdatesSinceRecompute = rhs.numUpdatesSinceRecompute;
         
         //Copy the base variables
         copyBaseVariables( (FeatureExtraction*)&rhs );
@@ -89,7 +92,7 @@ bool TimeDomainFeatures::computeFeatures(const VectorDouble &inputVector){
     }
 #endif
     
-    featureVector = update( inputVector );
+    updateFeatures( &inputVector[0] );
     
     return true;
 }
@@ -171,13 +174,11 @@ bool TimeDomainFeatures::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_TIME_DOMAIN_FEATURES_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_TIME_DOMAIN_FEATURES_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
@@ -188,60 +189,53 @@ bool TimeDomainFeatures::loadSettingsFromFile(fstream &file){
     }
     
     //Load the BufferLength
-    file >> word;
-    if( word != "BufferLength:" ){
+    if( !parser.matchWord("BufferLength:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read BufferLength header!" << endl;
         return false;     
     }
-    file >> bufferLength;
+    parser >> bufferLength;
     
     //Load the NumFrames
-    file >> word;
-    if( word != "NumFrames:" ){
+    if( !parser.matchWord("NumFrames:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumFrames header!" << endl;
         return false;     
     }
-    file >> numFrames;
+    parser >> numFrames;
     
     //Load the OffsetInput
-    file >> word;
-    if( word != "OffsetInput:" ){
+    if( !parser.matchWord("OffsetInput:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read OffsetInput header!" << endl;
         return false;     
     }
-    file >> offsetInput;
+    parser >> offsetInput;
     
     //Load the UseMean
-    file >> word;
-    if( word != "UseMean:" ){
+    if( !parser.matchWord("UseMean:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read UseMean header!" << endl;
         return false;     
     }
-    file >> useMean;
+    parser >> useMean;
     
     //Load the UseStdDev
-    file >> word;
-    if( word != "UseStdDev:" ){
+    if( !parser.matchWord("UseStdDev:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read UseStdDev header!" << endl;
         return false;     
     }
-    file >> useStdDev;
+    parser >> useStdDev;
     
     //Load the UseEuclideanNorm
-    file >> word;
-    if( word != "UseEuclideanNorm:" ){
+    if( !parser.matchWord("UseEuclideanNorm:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read UseEuclideanNorm header!" << endl;
         return false;     
     }
-    file >> useEuclideanNorm;
+    parser >> useEuclideanNorm;
     
     //Load the UseRMS
-    file >> word;
-    if( word != "UseRMS:" ){
+    if( !parser.matchWord("UseRMS:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read UseRMS header!" << endl;
         return false;
     }
-    file >> useRMS;
+    parser >> useRMS;
     
     //Init the TimeDomainFeatures module to ensure everything is initialized correctly
     return init(bufferLength,numFrames,numInputDimensions,offsetInput,useMean,useStdDev,useEuclideanNorm,useRMS);
@@ -293,7 +287,14 @@ bool TimeDomainFeatures::init(UINT bufferLength,UINT numFrames,UINT numDimension
     featureVector.resize(numOutputDimensions);
     
     //Resize the raw data buffer
-    dataBuffer.resize( bufferLength, VectorDouble(numInputDimensions,0) );
+    dataBuffer.resize( bufferLength, numInputDimensions, 0 );
+    
+    //Reset the frame statistics, the buffer starts full of zeros so every frame has a mean and variance of zero
+    frameMean.clear();
+    frameMean.resize( numInputDimensions*numFrames, 0 );
+    frameM2.clear();
+    frameM2.resize( numInputDimensions*numFrames, 0 );
+    numUpdatesSinceRecompute = 0;
 
     //Flag that the time domain features has been initialized
     initialized = true;
@@ -320,126 +321,103 @@ VectorDouble TimeDomainFeatures::update(const VectorDouble &x){
     }
 #endif
     
-    //Add the new data to the data buffer
-    dataBuffer.push_back( x );
+    updateFeatures( &x[0] );
     
-    //Only flag that the feature data is ready if the data is full
-    if( dataBuffer.getBufferFilled() ){
-        featureDataReady = true;
-    }else featureDataReady = false;
+    return featureVector;
+}
+    
+void TimeDomainFeatures::updateFeatures(const double *x){
     
-    MatrixDouble meanFeatures(numInputDimensions,numFrames);
-    MatrixDouble stdDevFeatures(numInputDimensions,numFrames);
-    MatrixDouble normFeatures(numInputDimensions,numFrames);
-    MatrixDouble rmsFeatures(numInputDimensions,numFrames);
-    MatrixDouble data(bufferLength,numInputDimensions);
+    const UINT frameSize = bufferLength / numFrames;
     
-    if( offsetInput ){
+    if( dataBuffer.getBufferFilled() ){
+        //Every sample in the buffer moves back one position, so each frame loses its first sample and gains the first sample of the next frame
+        const double *window = dataBuffer.getWindow();
         for(UINT n=0; n<numInputDimensions; n++){
-            data[0][n] = dataBuffer[0][n];
-            for(UINT i=1; i<bufferLength; i++){
-                data[i][n] = dataBuffer[i][n]-dataBuffer[0][n];
+            for(UINT j=0; j<numFrames; j++){
+                const double oldValue = window[ (j*frameSize)*numInputDimensions + n ];
+                const double newValue = j+1 < numFrames ? window[ ((j+1)*frameSize)*numInputDimensions + n ] : x[n];
+                replaceFrameValue( n*numFrames + j, oldValue, newValue );
             }
         }
     }else{
+        //Until the buffer has been filled, the new sample replaces one of the zeros at the end of the buffer
+        const UINT frame = dataBuffer.getNumValuesInBuffer() / frameSize;
         for(UINT n=0; n<numInputDimensions; n++){
-            for(UINT i=0; i<bufferLength; i++){
-                data[i][n] = dataBuffer[i][n];
-            }
+            replaceFrameValue( n*numFrames + frame, 0, x[n] );
         }
     }
     
-    if( useMean || useStdDev ){ meanFeatures.setAllValues(0); stdDevFeatures.setAllValues(0); }
-    if( useEuclideanNorm ) normFeatures.setAllValues(0);
-    if( useRMS ) rmsFeatures.setAllValues(0);
+    //Add the new data to the data buffer
+    dataBuffer.push_back( x );
+    
+    //Only flag that the feature data is ready if the data is full
+    featureDataReady = dataBuffer.getBufferFilled();
     
-    UINT frameSize = bufferLength / numFrames;
-    UINT frame = 0;
+    if( ++numUpdatesSinceRecompute >= bufferLength ){
+        recomputeFrameStatistics();
+    }
+    
+    //Compute the features from the frame statistics. If offsetInput is true then the oldest sample is subtracted from every
+    //sample in the buffer except the oldest sample itself, so the first frame needs the oldest sample to be put back
+    const double n = double(frameSize);
+    const double stdDevNorm = frameSize > 1 ? n-1 : 1;
     UINT index = 0;
-    for(UINT n=0; n<numInputDimensions; n++){
-        frame = 0;
-        index = 0;
-        for(UINT i=0; i<bufferLength; i++){
-            //Update the mean
-            meanFeatures[n][frame] += data[i][n];
+    for(UINT i=0; i<numInputDimensions; i++){
+        const double offset = offsetInput ? dataBuffer[0][i] : 0;
+        for(UINT j=0; j<numFrames; j++){
+            double mean = frameMean[ i*numFrames + j ] - offset;
+            double m2 = frameM2[ i*numFrames + j ];
             
-            //Update the norm features
-            if( useEuclideanNorm )
-                normFeatures[n][frame] += data[i][n]*data[i][n];
+            if( offsetInput && j == 0 ){
+                const double shiftedMean = mean;
+                mean += offset / n;
+                m2 += offset * ((offset - mean) - shiftedMean);
+            }
+            if( m2 < 0 ) m2 = 0;
             
-            //Update the rms features
-            if( useRMS )
-                rmsFeatures[n][frame] += data[i][n]*data[i][n];
+            const double sumOfSquares = m2 + n * mean * mean;
             
-            if( ++index == frameSize ){
-                frame++;
-                index = 0;
-            }
-        }
-        
-        //Update the mean
-        for(UINT j=0; j<numFrames; j++){
-            meanFeatures[n][j] /= frameSize;
-        }
-        
-        //Update the std dev if needed
-        if( useStdDev ){
-            frame = 0;
-            index = 0;
-            for(UINT i=0; i<bufferLength; i++){
-                stdDevFeatures[n][frame] += (data[i][n]-meanFeatures[n][frame]) * (data[i][n]-meanFeatures[n][frame]);
-                if( ++index == frameSize ){
-                    frame++;
-                    index = 0;
-                }
-            }
-            double norm = frameSize>1 ? frameSize-1 : 1;
-            for(UINT j=0; j<numFrames; j++){
-                stdDevFeatures[n][j] = sqrt( stdDevFeatures[n][j]/norm );
-            }
-        }
-        
-        //Update the euclidean norm if needed
-        if( useEuclideanNorm ){
-            for(UINT j=0; j<numFrames; j++){
-                normFeatures[n][j] = sqrt( normFeatures[n][j] );
-            }
-        }
-        
-        //Update the rms if needed
-        if( useRMS ){
-            for(UINT j=0; j<numFrames; j++){
-                rmsFeatures[n][j] = sqrt( rmsFeatures[n][j] / frameSize );
-            }
-        }
-    }
-    
-    //Update the features
-    index = 0;
-    frame = 0;
-    for(UINT n=0; n<numInputDimensions; n++){
-        for(UINT j=0; j<numFrames; j++){
             if( useMean ){
-                featureVector[index++] = meanFeatures[n][j];
+                featureVector[index++] = mean;
             }
             if( useStdDev ){
-                featureVector[index++] = stdDevFeatures[n][j];
+                featureVector[index++] = sqrt( m2 / stdDevNorm );
             }
             if( useEuclideanNorm ){
-                featureVector[index++] = normFeatures[n][j];
+                featureVector[index++] = sqrt( sumOfSquares );
             }
             if( useRMS ){
-                featureVector[index++] = rmsFeatures[n][j];
+                featureVector[index++] = sqrt( sumOfSquares / n );
             }
         }
     }
+}
     
-    return featureVector;
+void TimeDomainFeatures::recomputeFrameStatistics(){
+    
+    const UINT frameSize = bufferLength / numFrames;
+    
+    for(UINT i=0; i<numInputDimensions; i++){
+        for(UINT j=0; j<numFrames; j++){
+            double mean = 0;
+            for(UINT k=0; k<frameSize; k++) mean += dataBuffer[ j*frameSize + k ][i];
+            mean /= double(frameSize);
+            
+            double m2 = 0;
+            for(UINT k=0; k<frameSize; k++) m2 += SQR( dataBuffer[ j*frameSize + k ][i] - mean );
+            
+            frameMean[ i*numFrames + j ] = mean;
+            frameM2[ i*numFrames + j ] = m2;
+        }
+    }
+    
+    numUpdatesSinceRecompute = 0;
 }
     
 CircularBuffer< VectorDouble > TimeDomainFeatures::getBufferData(){
     if( initialized ){
-        return dataBuffer;
+        return dataBuffer.getDataAsCircularBuffer();
     }
     return CircularBuffer< VectorDouble >();
 }
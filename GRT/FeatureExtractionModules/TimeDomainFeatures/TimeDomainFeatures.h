@@ -23,6 +23,13 @@
  SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  
  @section DESCRIPTION
+ The TimeDomainFeatures module buffers the last bufferLength samples, splits the buffer into numFrames equal frames and
+ computes the mean, standard deviation, euclidean norm and RMS of each frame for each input dimension.
+
+ The mean and the sum of squared differences from the mean of each frame are updated incrementally (using Welford's
+ update) as samples move from one frame to the next, so each new sample costs O(numDimensions*numFrames) rather than
+ O(numDimensions*bufferLength). The statistics are recomputed from the buffer every bufferLength samples to stop rounding
+ errors from building up.
  */
 
 #ifndef GRT_TIME_DOMAIN_FEATURES_HEADER
@@ -150,6 +157,33 @@ public:
     CircularBuffer< VectorDouble > getBufferData();
 
 protected:
+    /**
+     Adds a new sample to the buffer, updates the frame statistics and fills the featureVector.
+
+     @param const double *x: a pointer to the numInputDimensions values of the new sample
+     */
+    void updateFeatures(const double *x);
+
+    /**
+     Replaces one value in a frame, updating the mean and the sum of squared differences of that frame.
+
+     @param const UINT index: the index of the frame statistics, this is dimension*numFrames + frame
+     @param const double oldValue: the value that is leaving the frame
+     @param const double newValue: the value that is entering the frame
+     */
+    void replaceFrameValue(const UINT index,const double oldValue,const double newValue){
+        const double frameSize = double(bufferLength/numFrames);
+        const double delta = newValue - oldValue;
+        const double newMean = frameMean[index] + delta / frameSize;
+        frameM2[index] += delta * ((newValue - newMean) + (oldValue - frameMean[index]));
+        frameMean[index] = newMean;
+    }
+
+    /**
+     Recomputes the frame statistics from the values in the buffer.
+     */
+    void recomputeFrameStatistics();
+
     UINT bufferLength;
     UINT numFrames;
     bool offsetInput;
@@ -157,7 +191,10 @@ protected:
     bool useStdDev;
     bool useEuclideanNorm;
     bool useRMS;
-    CircularBuffer< VectorDouble > dataBuffer;
+    FrameBuffer dataBuffer;
+    VectorDouble frameMean;                         ///< The mean of each frame, stored at [dimension*numFrames + frame]
+    VectorDouble frameM2;                           ///< The sum of squared differences from the mean of each frame, stored as frameMean
+    UINT numUpdatesSinceRecompute;                  ///< The number of samples since the frame statistics were last recomputed
     
     static RegisterFeatureExtractionModule< TimeDomainFeatures > registerModule;
 };
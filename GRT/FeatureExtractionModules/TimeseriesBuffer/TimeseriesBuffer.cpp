@@ -158,13 +158,11 @@ bool TimeseriesBuffer::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_TIMESERIES_BUFFER_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_TIMESERIES_BUFFER_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
@@ -174,12 +172,11 @@ bool TimeseriesBuffer::loadSettingsFromFile(fstream &file){
         return false;
     }
     
-    file >> word;
-    if( word != "BufferSize:" ){
+    if( !parser.matchWord("BufferSize:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read BufferSize header!" << endl;
         return false;     
     }
-    file >> bufferSize;
+    parser >> bufferSize;
     
     //Init the TimeseriesBuffer module to ensure everything is initialized correctly
     return init(bufferSize,numInputDimensions);
@@ -204,7 +201,7 @@ bool TimeseriesBuffer::init(UINT bufferSize,UINT numDimensions){
     numInputDimensions = numDimensions;
     numOutputDimensions = bufferSize * numInputDimensions;
     this->bufferSize = bufferSize;
-    dataBuffer.resize( bufferSize, VectorDouble(numInputDimensions,0) );
+    dataBuffer.resize( bufferSize, numInputDimensions, 0 );
     featureVector.resize(numOutputDimensions,0);
     
     //Flag that the timeseries buffer has been initialized
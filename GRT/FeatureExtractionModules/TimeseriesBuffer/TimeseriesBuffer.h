@@ -181,7 +181,7 @@ public:
     
 protected:
     UINT bufferSize;
-    CircularBuffer< VectorDouble > dataBuffer;              ///< A buffer used to store the timeseries data
+    FrameBuffer dataBuffer;                                ///< A buffer used to store the timeseries data
     
     static RegisterFeatureExtractionModule< TimeseriesBuffer > registerModule;
 };
@@ -51,6 +51,9 @@ ZeroCrossingCounter& ZeroCrossingCounter::operator=(const ZeroCrossingCounter &r
         this->derivative = rhs.derivative;
         this->deadZone = rhs.deadZone;
         this->dataBuffer = rhs.dataBuffer;
+        this->crossingCount = rhs.crossingCount;
+        this->crossingMagnitude = rhs.crossingMagnitude;
+        this->numUpdatesSinceRecompute = rhs.numUpdatesSinceRecompute;
         
         copyBaseVariables( (FeatureExtraction*)&rhs );
     }
@@ -164,13 +167,11 @@ bool ZeroCrossingCounter::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_ZERO_CROSSING_COUNTER_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_ZERO_CROSSING_COUNTER_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
@@ -180,26 +181,23 @@ bool ZeroCrossingCounter::loadSettingsFromFile(fstream &file){
         return false;
     }
     
-    file >> word;
-    if( word != "SearchWindowSize:" ){
+    if( !parser.matchWord("SearchWindowSize:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read SearchWindowSize header!" << endl;
         return false;     
     }
-    file >> searchWindowSize;
+    parser >> searchWindowSize;
     
-    file >> word;
-    if( word != "FeatureMode:" ){
+    if( !parser.matchWord("FeatureMode:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read FeatureMode header!" << endl;
         return false;     
     }
-    file >> featureMode;
+    parser >> featureMode;
     
-    file >> word;
-    if( word != "DeadZoneThreshold:" ){
+    if( !parser.matchWord("DeadZoneThreshold:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read DeadZoneThreshold header!" << endl;
         return false;     
     }
-    file >> deadZoneThreshold;
+    parser >> deadZoneThreshold;
     
     //Init the ZeroCrossingCounter module to ensure everything is initialized correctly
     return init(searchWindowSize,deadZoneThreshold,numInputDimensions,featureMode);
@@ -238,8 +236,13 @@ bool ZeroCrossingCounter::init(UINT searchWindowSize,double deadZoneThreshold,UI
     numOutputDimensions = (featureMode == INDEPENDANT_FEATURE_MODE ? TOTAL_NUM_ZERO_CROSSING_FEATURES * numInputDimensions : TOTAL_NUM_ZERO_CROSSING_FEATURES);
     derivative.init(Derivative::FIRST_DERIVATIVE, 1.0, numInputDimensions, true, 5);
     deadZone.init(-deadZoneThreshold,deadZoneThreshold,numInputDimensions);
-    dataBuffer.resize( searchWindowSize, vector< double >(numInputDimensions,NAN) );
+    dataBuffer.resize( searchWindowSize, numInputDimensions, NAN );
     featureVector.resize(numOutputDimensions,0);
+    crossingCount.clear();
+    crossingCount.resize(numInputDimensions,0);
+    crossingMagnitude.clear();
+    crossingMagnitude.resize(numInputDimensions,0);
+    numUpdatesSinceRecompute = 0;
     
     //Flag that the zero crossing counter has been initialized
     initialized = true;
@@ -266,9 +269,6 @@ VectorDouble ZeroCrossingCounter::update(const VectorDouble &x){
     }
 #endif
     
-    //Clear the feature vector
-    std::fill(featureVector.begin(),featureVector.end(),0);
-    
     //Update the derivative data and 
     derivative.computeDerivative( x );
     
@@ -276,25 +276,40 @@ VectorDouble ZeroCrossingCounter::update(const VectorDouble &x){
     deadZone.filter( derivative.getProcessedData() );
     
     //Add the deadzone data to the buffer
+    const bool bufferWasFilled = dataBuffer.getBufferFilled();
     dataBuffer.push_back( deadZone.getProcessedData() );
     
-    //Search the buffer for the zero crossing features
+    //Update the crossings in the tracked part of the buffer. The buffer has moved by one sample, so the crossing that was at index
+    //MAGNITUDE_SEARCH_SIZE is now at MAGNITUDE_SEARCH_SIZE-1 and leaves it, while the crossing at the newest sample (if any) enters it
+    if( ++numUpdatesSinceRecompute >= searchWindowSize ){
+        recomputeCrossingStatistics();
+    }else{
+        const UINT newestIndex = dataBuffer.getNumValuesInBuffer()-1;
+        for(UINT j=0; j<numInputDimensions; j++){
+            if( bufferWasFilled && searchWindowSize > MAGNITUDE_SEARCH_SIZE && isZeroCrossing(MAGNITUDE_SEARCH_SIZE-1,j) ){
+                crossingCount[j]--;
+                crossingMagnitude[j] -= getCrossingMagnitude(MAGNITUDE_SEARCH_SIZE-1,j,MAGNITUDE_SEARCH_SIZE);
+            }
+            if( newestIndex >= MAGNITUDE_SEARCH_SIZE && isZeroCrossing(newestIndex,j) ){
+                crossingCount[j]++;
+                crossingMagnitude[j] += getCrossingMagnitude(newestIndex,j,MAGNITUDE_SEARCH_SIZE);
+            }
+        }
+    }
+    
+    //Clear the feature vector
+    std::fill(featureVector.begin(),featureVector.end(),0);
+    
+    //Add the tracked crossings and search the start of the buffer, where the magnitude search is cut short by the start of the buffer
+    const UINT searchEnd = dataBuffer.getSize() < MAGNITUDE_SEARCH_SIZE ? dataBuffer.getSize() : MAGNITUDE_SEARCH_SIZE;
     for(UINT j=0; j<numInputDimensions; j++){
         UINT colIndex = (featureMode == INDEPENDANT_FEATURE_MODE ? (TOTAL_NUM_ZERO_CROSSING_FEATURES*j) : 0);
-        for(UINT i=1; i<dataBuffer.getSize(); i++){
-            //Search for a zero crossing
-            if( (dataBuffer[i][j] > 0 && dataBuffer[i-1][j] <= 0) || (dataBuffer[i][j] < 0 && dataBuffer[i-1][j] >= 0) ){
-                //Update the zero crossing count
+        featureVector[ NUM_ZERO_CROSSINGS_COUNTED + colIndex ] += crossingCount[j];
+        featureVector[ ZERO_CROSSING_MAGNITUDE + colIndex ] += crossingMagnitude[j];
+        for(UINT i=1; i<searchEnd; i++){
+            if( isZeroCrossing(i,j) ){
                 featureVector[ NUM_ZERO_CROSSINGS_COUNTED + colIndex ]++;
-                
-                //Update the magnitude, search the last 5 values around the zero crossing to make sure we get the maxima of the peak
-                double maxValue = 0;
-                UINT searchSize = i > 5 ? 5 : i;
-                for(UINT n=0; n<searchSize; n++){
-                    double value = fabs( dataBuffer[ i-n ][j] );
-                    if( value > maxValue ) maxValue = value;
-                }
-                featureVector[ ZERO_CROSSING_MAGNITUDE + colIndex ] += maxValue;
+                featureVector[ ZERO_CROSSING_MAGNITUDE + colIndex ] += getCrossingMagnitude(i,j,i);
             }
         }
     }
@@ -305,6 +320,22 @@ VectorDouble ZeroCrossingCounter::update(const VectorDouble &x){
     return featureVector;
 }
     
+void ZeroCrossingCounter::recomputeCrossingStatistics(){
+    
+    const UINT numValues = dataBuffer.getNumValuesInBuffer();
+    for(UINT j=0; j<numInputDimensions; j++){
+        crossingCount[j] = 0;
+        crossingMagnitude[j] = 0;
+        for(UINT i=MAGNITUDE_SEARCH_SIZE; i<numValues; i++){
+            if( isZeroCrossing(i,j) ){
+                crossingCount[j]++;
+                crossingMagnitude[j] += getCrossingMagnitude(i,j,MAGNITUDE_SEARCH_SIZE);
+            }
+        }
+    }
+    numUpdatesSinceRecompute = 0;
+}
+    
 bool ZeroCrossingCounter::setSearchWindowSize(UINT searchWindowSize){
     if( searchWindowSize > 0 ){
         this->searchWindowSize = searchWindowSize;
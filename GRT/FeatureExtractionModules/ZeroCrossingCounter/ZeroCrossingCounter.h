@@ -35,6 +35,9 @@
  In COMBINED_FEATURE_MODE the zero-crossing count and zero-crossing magnitude features will be integrated across all of the N dimensions in the input signal.
  This means that if the ZeroCrossingCounter is set to INDEPENDANT_FEATURE_MODE, the size of the output feature vector will be 2 * N, where 2 is the two features (zero-crossing count and zero-crossing magnitude) and N is the number of dimensions in the input signal. Alternatively in COMBINED_FEATURE_MODE the size of the output vector will simply be 2, where 2 is the two features (zero-crossing count and zero-crossing magnitude). The feature modes can be set either in the ZeroCrossingCounter constructor or by using the setFeatureMode(UINT featureMode) function.
  
+ The crossings are tracked as the buffer moves, so each update only checks the crossings entering and leaving the buffer and the
+ cost of an update does not depend on the search window size.
+ 
  The ZeroCrossingCounter class is part of the Feature Extraction Modules.
  */
 
@@ -236,15 +239,56 @@ public:
      
      @return returns a curcular buffer containing the data buffer values, an empty circular buffer will be returned if the ZeroCrossingCounter has not been initialized
      */
-    CircularBuffer< VectorDouble > getDataBuffer(){ if( initialized ){ return dataBuffer; } return CircularBuffer< VectorDouble >(); }
+    CircularBuffer< VectorDouble > getDataBuffer(){ if( initialized ){ return dataBuffer.getDataAsCircularBuffer(); } return CircularBuffer< VectorDouble >(); }
     
 protected:
+    /**
+     Checks if the derivative crosses zero between index i-1 and index i of the buffer.
+     
+     @param const UINT i: the index in the buffer, must be larger than zero
+     @param const UINT j: the dimension
+     @return returns true if there is a zero crossing at index i, false otherwise
+     */
+    bool isZeroCrossing(const UINT i,const UINT j){
+        const double current = dataBuffer[i][j];
+        const double previous = dataBuffer[i-1][j];
+        return (current > 0 && previous <= 0) || (current < 0 && previous >= 0);
+    }
+    
+    /**
+     Gets the magnitude of the zero crossing at index i, which is the maximum absolute value of the searchSize values up to index i.
+     
+     @param const UINT i: the index in the buffer
+     @param const UINT j: the dimension
+     @param const UINT searchSize: the number of values to search, must not be larger than i+1
+     @return returns the magnitude of the zero crossing
+     */
+    double getCrossingMagnitude(const UINT i,const UINT j,const UINT searchSize){
+        double maxValue = 0;
+        for(UINT n=0; n<searchSize; n++){
+            double value = fabs( dataBuffer[ i-n ][j] );
+            if( value > maxValue ) maxValue = value;
+        }
+        return maxValue;
+    }
+    
+    /**
+     Recounts the crossings from MAGNITUDE_SEARCH_SIZE to the end of the buffer, which stops rounding errors from building up in the
+     running magnitude sums.
+     */
+    void recomputeCrossingStatistics();
+    
     UINT searchWindowSize;                                  ///< The size of the search window, i.e. the amount of previous data stored and searched
     UINT featureMode;                                       ///< The featureMode controls how the features are added to the feature vector
     double deadZoneThreshold;                               ///< The threshold value used for the dead zone filter
     Derivative derivative;                                  ///< Used to compute the derivative of the input signal
     DeadZone deadZone;                                      ///< Used to remove small amounts of noise from the data
-    CircularBuffer< VectorDouble > dataBuffer;              ///< A buffer used to store the previous derivative data
+    FrameBuffer dataBuffer;                                ///< A buffer used to store the previous derivative data
+    VectorDouble crossingCount;                             ///< The number of crossings from MAGNITUDE_SEARCH_SIZE to the end of the buffer, for each dimension
+    VectorDouble crossingMagnitude;                         ///< The sum of the magnitudes of these crossings, for each dimension
+    UINT numUpdatesSinceRecompute;                          ///< The number of updates since the crossings were last recounted
+    
+    enum{ MAGNITUDE_SEARCH_SIZE = 5 };                      ///< The number of values searched for the maxima of each crossing
     
     static RegisterFeatureExtractionModule< ZeroCrossingCounter > registerModule;
     
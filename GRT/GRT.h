@@ -53,13 +53,21 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Util/EigenvalueDecomposition.h"
 #include "Util/TestResult.h"
 #include "Util/ClassificationResult.h"
+#include "Util/SquaredDistanceKernel.h"
+#include "Util/IIRFilterBank.h"
+#include "Util/LinearModelTrainer.h"
+#include "Util/LatencyHistogram.h"
 
 //Include the data structures
 #include "DataStructures/LabelledClassificationData.h"
+#include "DataStructures/LabelledClassificationDataView.h"
+#include "DataStructures/FlatClassificationData.h"
 #include "DataStructures/LabelledTimeSeriesClassificationData.h"
 #include "DataStructures/LabelledContinuousTimeSeriesClassificationData.h"
 #include "DataStructures/LabelledRegressionData.h"
 #include "DataStructures/UnlabelledClassificationData.h"
+#include "DataStructures/BinaryDatasetFile.h"
+#include "DataStructures/ChunkedDatasetReader.h"
 
 //Include the Core Alogirthms
 #include "CoreAlgorithms/EvolutionaryAlgorithm/EvolutionaryAlgorithm.h"
@@ -121,5 +129,6 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 //Include the Recognition Pipeline
 #include "GestureRecognitionPipeline/GestureRecognitionPipeline.h"
+#include "GestureRecognitionPipeline/GestureRecognitionPipelineSession.h"
 
 #endif //GRT_MAIN_HEADER
@@ -22,7 +22,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace GRT{
     
 Classifier::StringClassifierMap* Classifier::stringClassifierMap = NULL;
+#ifdef GRT_CXX11_ENABLED
+std::atomic< UINT > Classifier::numClassifierInstances(0);
+#else
 UINT Classifier::numClassifierInstances = 0;
+#endif
     
 Classifier* Classifier::createInstanceFromString(string const &classifierType){
     
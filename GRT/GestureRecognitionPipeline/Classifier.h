@@ -34,6 +34,11 @@
 #include "MLBase.h"
 #include "../DataStructures/LabelledClassificationData.h"
 #include "../DataStructures/LabelledTimeSeriesClassificationData.h"
+#include "../Util/ClassificationResult.h"
+
+#ifdef GRT_CXX11_ENABLED
+#include <atomic>
+#endif
 
 namespace GRT{
     
@@ -60,6 +65,18 @@ public:
      @return returns true if the clone was successfull, false otherwise (the Classifier base class will always return flase)
      */
     virtual bool deepCopyFrom(const Classifier *classifier){ return false; }
+
+    /**
+     Predicts the class of the input vector without changing any of the variables of the classifier, the results are written to
+     the result instead. This lets one trained classifier be shared by many threads (see GestureRecognitionPipelineSession).
+     This should be overwritten by the derived classes whose predictions are stateless (see getIsPredictionStateless), and gives
+     the same results as the predict function.
+
+     @param const VectorDouble &inputVector: the input vector to classify
+     @param ClassificationResult &result: returns the predicted class label, maximum likelihood, class likelihoods and class distances
+     @return returns true if the prediction was successful, false otherwise (the Classifier base class will always return false)
+     */
+    virtual bool predictStateless(const VectorDouble &inputVector,ClassificationResult &result) const{ return false; }
     
     /**
      This copies the Classifier base class variables from the classifier pointer to this instance.
@@ -280,7 +297,11 @@ protected:
     
 private:
     static StringClassifierMap *stringClassifierMap;
+#ifdef GRT_CXX11_ENABLED
+    static std::atomic< UINT > numClassifierInstances;    //Atomic, as classifiers can be created and deleted by the cross validation threads
+#else
     static UINT numClassifierInstances;
+#endif
     
 };
     
@@ -22,7 +22,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace GRT{
     
 Context::StringContextMap* Context::stringContextMap = NULL;
+#ifdef GRT_CXX11_ENABLED
+std::atomic< UINT > Context::numContextInstances(0);
+#else
 UINT Context::numContextInstances = 0;
+#endif
     
 Context* Context::createInstanceFromString(string const &contextType){
     
@@ -23,6 +23,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "GRTBase.h"
 
+#ifdef GRT_CXX11_ENABLED
+#include <atomic>
+#endif
+
 namespace GRT{
 
 class Context : public GRTBase
@@ -82,7 +86,7 @@ public:
 	UINT getNumOutputDimensions() const { return numOutputDimensions; }
 	bool getInitialized() const { return initialized; }
 	bool getOK() const { return okToContinue; }
-	VectorDouble getProcessedData() const { return data; }
+	const VectorDouble& getProcessedData() const { return data; }
     
     /**
      Defines a map between a string (which will contain the name of the context module, such as Gate) and a function returns a new instance of that context
@@ -122,7 +126,11 @@ protected:
 
 private:
     static StringContextMap *stringContextMap;
+#ifdef GRT_CXX11_ENABLED
+    static std::atomic< UINT > numContextInstances;    //Atomic, as pipeline sessions can create and delete modules on different threads
+#else
     static UINT numContextInstances;
+#endif
 };
 
 //These two functions/classes are used to register any new Context Module with the Context base class
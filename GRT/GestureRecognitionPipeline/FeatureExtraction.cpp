@@ -23,7 +23,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace GRT{
     
 FeatureExtraction::StringFeatureExtractionMap* FeatureExtraction::stringFeatureExtractionMap = NULL;
+#ifdef GRT_CXX11_ENABLED
+std::atomic< UINT > FeatureExtraction::numFeatureExtractionInstances(0);
+#else
 UINT FeatureExtraction::numFeatureExtractionInstances = 0;
+#endif
     
 FeatureExtraction* FeatureExtraction::createInstanceFromString(string const &featureExtractionType){
     
@@ -99,24 +103,22 @@ bool FeatureExtraction::loadBaseSettingsFromFile(fstream &file){
         errorLog << "loadBaseSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the NumInputDimensions
-    file >> word;
-    if( word != "NumInputDimensions:" ){
+    if( !parser.matchWord("NumInputDimensions:") ){
         errorLog << "loadBaseSettingsFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
         return false;
     }
-    file >> numInputDimensions;
+    parser >> numInputDimensions;
     
     //Load the NumOutputDimensions
-    file >> word;
-    if( word != "NumOutputDimensions:" ){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadBaseSettingsFromFile(fstream &file) - Failed to read NumOutputDimensions header!" << endl;
         return false;
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
 
 	//Resize the feature vector
 	featureVector.resize(numOutputDimensions,0);
@@ -144,7 +146,68 @@ bool FeatureExtraction::getFeatureDataReady() const{
     return featureDataReady;
 }
 
-VectorDouble FeatureExtraction::getFeatureVector() const{ 
+bool FeatureExtraction::computeFeaturesInPlace(VectorDouble &data){
+    if( !computeFeatures( data ) ) return false;
+    data = featureVector;
+    return true;
+}
+
+bool FeatureExtraction::computeFeaturesBlock(const MatrixDouble &data,MatrixDouble &featureData){
+    
+    const UINT M = data.getNumRows();
+    const UINT N = data.getNumCols();
+    
+    if( &featureData == &data ){
+        errorLog << "computeFeaturesBlock(const MatrixDouble &data,MatrixDouble &featureData) - The featureData matrix can not be the same as the data matrix!" << endl;
+        return false;
+    }
+    
+    featureData.clear();
+    
+    if( M == 0 ) return true;
+    
+    if( N != numInputDimensions ){
+        errorLog << "computeFeaturesBlock(const MatrixDouble &data,MatrixDouble &featureData) - The number of columns in the data (" << N << ") does not match the number of input dimensions (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    //Compute the features one row at a time, the ready feature vectors are stored back to back so the output is only allocated once
+    VectorDouble sample(N);
+    VectorDouble features;
+    features.reserve( M*numOutputDimensions );
+    UINT numFeatureRows = 0;
+    for(UINT i=0; i<M; i++){
+        const double *x = data[i];
+        for(UINT j=0; j<N; j++) sample[j] = x[j];
+        
+        if( !computeFeatures( sample ) ) return false;
+        
+        if( featureDataReady ){
+            if( featureVector.size() != numOutputDimensions ){
+                errorLog << "computeFeaturesBlock(const MatrixDouble &data,MatrixDouble &featureData) - The size of the feature vector (" << featureVector.size() << ") does not match the number of output dimensions (" << numOutputDimensions << ")!" << endl;
+                return false;
+            }
+            features.insert( features.end(), featureVector.begin(), featureVector.end() );
+            numFeatureRows++;
+        }
+    }
+    
+    if( numFeatureRows == 0 ) return true;
+    
+    if( !featureData.resize(numFeatureRows,numOutputDimensions) ){
+        errorLog << "computeFeaturesBlock(const MatrixDouble &data,MatrixDouble &featureData) - Failed to resize the feature data matrix!" << endl;
+        return false;
+    }
+    for(UINT i=0; i<numFeatureRows; i++){
+        const double *f = &features[ i*numOutputDimensions ];
+        double *y = featureData[i];
+        for(UINT j=0; j<numOutputDimensions; j++) y[j] = f[j];
+    }
+    
+    return true;
+}
+
+const VectorDouble& FeatureExtraction::getFeatureVector() const{ 
     return featureVector; 
 }
     
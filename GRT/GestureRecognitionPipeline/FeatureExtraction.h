@@ -33,6 +33,10 @@
 
 #include "GRTBase.h"
 
+#ifdef GRT_CXX11_ENABLED
+#include <atomic>
+#endif
+
 namespace GRT{
 
     class FeatureExtraction :public GRTBase
@@ -73,6 +77,29 @@ public:
      */
     virtual bool computeFeatures(const VectorDouble &inputVector){ return false; }
     
+    /**
+     This function is called by the GestureRecognitionPipeline when it predicts a new input vector. It computes the features from the data
+     and writes the feature vector back into data, so the pipeline can pass one buffer through all of its modules without copying it at each
+     stage. The default implementation calls computeFeatures(...) and copies the feature vector into data, which reuses the memory already
+     held by data. A derived class can override this if it can compute its features without the copy.
+     
+     @param VectorDouble &data: the input vector that should be processed, this will be set to the feature vector if the features were computed
+     @return returns true if the features were computed, false otherwise
+     */
+    virtual bool computeFeaturesInPlace(VectorDouble &data);
+    
+    /**
+     This function computes the features for a whole recording, such as a training time series. Each row of data is processed in order,
+     as if computeFeatures(...) was called for each row, and a row is added to featureData for each input row that completed a feature vector
+     (i.e. each row after which getFeatureDataReady() returns true). The module is not reset before the first row, so call reset() first if
+     the recording should not follow on from the previous data. featureData will be empty if no features were ready.
+     
+     @param const MatrixDouble &data: the recording that should be processed, the number of columns must match the number of input dimensions
+     @param MatrixDouble &featureData: the matrix the feature vectors will be written to, this must be a different matrix from data
+     @return returns true if the features were computed, false otherwise
+     */
+    virtual bool computeFeaturesBlock(const MatrixDouble &data,MatrixDouble &featureData);
+    
     /**
      This function is called by the GestureRecognitionPipeline's reset function.
      This function should be overwritten by the derived class.
@@ -157,7 +184,7 @@ public:
      
      @return returns the current feature vector, this vector will be empty if the module has not been initialized
      */
-    VectorDouble getFeatureVector() const;
+    const VectorDouble& getFeatureVector() const;
     
     /**
      Creates a new feature extraction instance based on the current featureExtractionType string value.
@@ -203,7 +230,11 @@ protected:
     
 private:
     static StringFeatureExtractionMap *stringFeatureExtractionMap;
+#ifdef GRT_CXX11_ENABLED
+    static std::atomic< UINT > numFeatureExtractionInstances;    //Atomic, as pipeline sessions can create and delete modules on different threads
+#else
     static UINT numFeatureExtractionInstances;
+#endif
     
 };
     
@@ -22,6 +22,266 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace GRT{
 
+//Gets the training and test data for one cross validation fold. The LabelledClassificationData folds are views, so the
+//folds are not copied, the other datasets copy the samples in each fold
+static inline LabelledClassificationDataView getTrainingFold(LabelledClassificationData &data,const UINT foldIndex){ return data.getTrainingFoldView( foldIndex ); }
+static inline LabelledClassificationDataView getTestFold(LabelledClassificationData &data,const UINT foldIndex){ return data.getTestFoldView( foldIndex ); }
+template< class T > static inline T getTrainingFold(T &data,const UINT foldIndex){ return data.getTrainingFoldData( foldIndex ); }
+template< class T > static inline T getTestFold(T &data,const UINT foldIndex){ return data.getTestFoldData( foldIndex ); }
+
+//Gets the base seed for the cross validation folds. This must be called before the pipeline is copied for each thread, as copying
+//the modules can take seeds from the caller's seed sequence and the number of copies depends on the number of threads
+static unsigned long long getFoldBaseSeed(){
+    Random random;
+    return (unsigned long long)random.getRandomNumberInt(1,numeric_limits< int >::max());
+}
+
+//Runs the cross validation folds in the range [startIndex endIndex-1]. Each thread trains and tests its own copy of the
+//pipeline, and the results of each fold are stored at the fold index so they can be merged in order once all the folds are done.
+//The random numbers used while training fold k are seeded from baseSeed+k, so each fold gets the same random numbers whichever
+//thread (and however many threads) it runs on. The base seed is drawn from the caller's seed sequence, so the folds can be
+//reproduced by calling Random::setThreadSeed before the cross validation
+template< class T, class FoldT = T >
+class GestureRecognitionPipelineFoldTask{
+public:
+    GestureRecognitionPipelineFoldTask(T &data,const UINT K,vector< GestureRecognitionPipeline > &pipelines,const bool regressionMode,const unsigned long long baseSeed):
+    data(data),pipelines(pipelines),regressionMode(regressionMode),baseSeed(baseSeed){
+        foldTrained.resize(K,0);
+        foldTested.resize(K,0);
+        foldScores.resize(K,0);
+        foldResults.resize(K);
+    }
+
+    
+    void operator()(const UINT startIndex,const UINT endIndex,const UINT threadIndex){
+        GestureRecognitionPipeline &pipeline = pipelines[ threadIndex ];
+        const unsigned long long callerSeed = Random::getThreadSeed();
+        for(UINT k=startIndex; k<endIndex; k++){
+            Random::setThreadSeed( baseSeed + k );
+            if( !runFold( pipeline, k ) ) break;
+        }
+        Random::setThreadSeed( callerSeed );
+    }
+    
+    bool runFold(GestureRecognitionPipeline &pipeline,const UINT k){
+        //Train the pipeline
+        FoldT foldTrainingData = getTrainingFold(data,k);
+        if( !pipeline.train( foldTrainingData ) ) return false;
+        foldTrained[k] = 1;
+        
+        //Test the pipeline
+        FoldT foldTestData = getTestFold(data,k);
+        if( !pipeline.test( foldTestData ) ) return false;
+        foldTested[k] = 1;
+        
+        foldScores[k] = regressionMode ? pipeline.getTestRMSError() : pipeline.getTestAccuracy();
+        foldResults[k] = pipeline.getTestResults();
+        return true;
+    }
+    
+    T &data;
+    vector< GestureRecognitionPipeline > &pipelines;
+    const bool regressionMode;
+    vector< UINT > foldTrained;
+    vector< UINT > foldTested;
+    VectorDouble foldScores;
+    vector< TestResult > foldResults;
+    const unsigned long long baseSeed;
+};
+
+//The smallest number of samples in a batch that is worth handing to a thread in predictBatch
+static const UINT MIN_BATCH_SAMPLES_PER_THREAD = 64;
+
+//Resizes a batch buffer, the memory is only reallocated if the size of the buffer has changed
+static inline bool resizeBatchBuffer(MatrixDouble &buffer,const UINT rows,const UINT cols){
+    if( buffer.getNumRows() == rows && buffer.getNumCols() == cols ) return true;
+    return buffer.resize( rows, cols );
+}
+
+static inline void copyBatchRow(const MatrixDouble &data,const UINT rowIndex,VectorDouble &row){
+    const UINT N = data.getNumCols();
+    row.resize( N );
+    for(UINT j=0; j<N; j++) row[j] = data[rowIndex][j];
+}
+
+static inline void copyBatchResult(const VectorDouble &result,const UINT rowIndex,MatrixDouble &data){
+    const UINT N = result.size() < data.getNumCols() ? (UINT)result.size() : data.getNumCols();
+    for(UINT j=0; j<N; j++) data[rowIndex][j] = result[j];
+}
+
+static inline void storeBatchResult(const Classifier *classifier,const UINT index,MatrixDouble &classLikelihoods,vector< UINT > &predictedClassLabels){
+    predictedClassLabels[index] = classifier->getPredictedClassLabel();
+    copyBatchResult( classifier->getClassLikelihoods(), index, classLikelihoods );
+}
+
+static inline void storeBatchResult(const Regressifier *regressifier,const UINT index,MatrixDouble &regressionData,vector< UINT > &predictedClassLabels){
+    copyBatchResult( regressifier->getRegressionData(), index, regressionData );
+}
+
+//Holds the output of one stateless prediction, each thread in a batch has its own buffer
+struct BatchResultBuffer{
+    ClassificationResult classificationResult;
+    VectorDouble regressionData;
+};
+
+static inline bool predictBatchSampleStateless(const Classifier *classifier,const VectorDouble &sample,const UINT index,BatchResultBuffer &buffer,MatrixDouble &classLikelihoods,vector< UINT > &predictedClassLabels){
+    if( !classifier->predictStateless( sample, buffer.classificationResult ) ) return false;
+    predictedClassLabels[index] = buffer.classificationResult.predictedClassLabel;
+    copyBatchResult( buffer.classificationResult.classLikelihoods, index, classLikelihoods );
+    return true;
+}
+
+static inline bool predictBatchSampleStateless(const Regressifier *regressifier,const VectorDouble &sample,const UINT index,BatchResultBuffer &buffer,MatrixDouble &regressionData,vector< UINT > &predictedClassLabels){
+    if( !regressifier->predictStateless( sample, buffer.regressionData ) ) return false;
+    copyBatchResult( buffer.regressionData, index, regressionData );
+    return true;
+}
+
+//Runs the classifier or regressifier over the samples [startIndex endIndex-1] of a batch, where the samples are either the rows of a
+//matrix or a list of timeseries. If the task is stateless all the threads share the model and call its const predictStateless function,
+//otherwise the samples are passed to predict in order. The output of each sample is stored at the sample index so the results are in
+//the same order as the batch
+template< class T >
+class GestureRecognitionPipelineBatchTask{
+public:
+    GestureRecognitionPipelineBatchTask(T *model,const bool stateless,const MatrixDouble *inputData,const vector< MatrixDouble > *timeSeriesData,MatrixDouble &outputData,vector< UINT > &predictedClassLabels):
+    model(model),stateless(stateless),inputData(inputData),timeSeriesData(timeSeriesData),outputData(outputData),predictedClassLabels(predictedClassLabels){
+        failed.resize(ParallelFor::getMaxNumThreads(),0);
+    }
+
+    void operator()(const UINT startIndex,const UINT endIndex,const UINT threadIndex){
+        VectorDouble sample;
+        BatchResultBuffer buffer;
+        for(UINT i=startIndex; i<endIndex; i++){
+            bool predictionOK = false;
+            if( inputData != NULL ){
+                copyBatchRow( *inputData, i, sample );
+                if( stateless ) predictionOK = predictBatchSampleStateless( model, sample, i, buffer, outputData, predictedClassLabels );
+                else predictionOK = model->predict( sample );
+            }else predictionOK = model->predict( (*timeSeriesData)[i] );
+
+            if( !predictionOK ){
+                failed[ threadIndex ] = 1;
+                return;
+            }
+            if( !stateless ) storeBatchResult( model, i, outputData, predictedClassLabels );
+        }
+    }
+
+    bool getFailed() const{
+        for(UINT t=0; t<failed.size(); t++){
+            if( failed[t] ) return true;
+        }
+        return false;
+    }
+
+    T *model;
+    const bool stateless;
+    const MatrixDouble *inputData;
+    const vector< MatrixDouble > *timeSeriesData;
+    MatrixDouble &outputData;
+    vector< UINT > &predictedClassLabels;
+    vector< UINT > failed;
+};
+
+//Predicts all the samples in a batch with the model. The samples are only split across threads if the model supports stateless
+//predictions, in which case the threads share the model, otherwise they are predicted in order. Timeseries are always predicted in order
+template< class T >
+static bool predictBatchWithModel(T *model,const MatrixDouble *inputData,const vector< MatrixDouble > *timeSeriesData,const UINT numSamples,MatrixDouble &outputData,vector< UINT > &predictedClassLabels){
+
+    const bool stateless = inputData != NULL && model->getIsPredictionStateless();
+    const UINT numThreads = stateless ? ParallelFor::getNumThreads( numSamples, MIN_BATCH_SAMPLES_PER_THREAD ) : 1;
+
+    if( numThreads > 1 ){
+        GestureRecognitionPipelineBatchTask< T > batchTask( model, true, inputData, timeSeriesData, outputData, predictedClassLabels );
+        ParallelFor::run( numSamples, batchTask, MIN_BATCH_SAMPLES_PER_THREAD );
+        if( batchTask.getFailed() ) return false;
+
+        //Predict the last sample again with predict, so the model is left in the same state as a sequential run
+        GestureRecognitionPipelineBatchTask< T > lastSampleTask( model, false, inputData, timeSeriesData, outputData, predictedClassLabels );
+        lastSampleTask( numSamples-1, numSamples, 0 );
+        return !lastSampleTask.getFailed();
+    }
+
+    GestureRecognitionPipelineBatchTask< T > batchTask( model, false, inputData, timeSeriesData, outputData, predictedClassLabels );
+    batchTask( 0, numSamples, 0 );
+    return !batchTask.getFailed();
+}
+
+//The smallest number of training timeseries that is worth handing to a thread when the timeseries are pre-processed
+static const UINT MIN_TIMESERIES_PER_THREAD = 8;
+
+//Passes each row of data through a feature extraction module and stores the feature vector after every row, whether or not the
+//module flagged it as ready. This is used for the feature extraction modules that feed another feature extraction module
+static bool computeFeaturesForEachRow(FeatureExtraction *featureExtraction,const MatrixDouble &data,MatrixDouble &featureData){
+    const UINT M = data.getNumRows();
+    const UINT N = featureExtraction->getNumOutputDimensions();
+    if( !featureData.resize(M,N) ) return false;
+    VectorDouble sample;
+    for(UINT i=0; i<M; i++){
+        copyBatchRow( data, i, sample );
+        if( !featureExtraction->computeFeatures( sample ) ) return false;
+        const VectorDouble &featureVector = featureExtraction->getFeatureVector();
+        if( featureVector.size() != N ) return false;
+        for(UINT j=0; j<N; j++) featureData[i][j] = featureVector[j];
+    }
+    return true;
+}
+
+//Pre-processes and computes the features of the training timeseries [startIndex endIndex-1]. Each thread has its own copy of the
+//pre-processing and feature extraction modules, which are reset before each timeseries, and the features of each timeseries are
+//stored at the timeseries index so they can be added to the training data in order
+class GestureRecognitionPipelineTimeSeriesTask{
+public:
+    enum SampleStatus{ NOT_PROCESSED=0, PROCESSED, PRE_PROCESSING_FAILED, FEATURE_EXTRACTION_FAILED };
+    
+    GestureRecognitionPipelineTimeSeriesTask(LabelledTimeSeriesClassificationData &data,vector< vector< PreProcessing* > > &preProcessingModules,vector< vector< FeatureExtraction* > > &featureExtractionModules):
+    data(data),preProcessingModules(preProcessingModules),featureExtractionModules(featureExtractionModules){
+        featureData.resize( data.getNumSamples() );
+        status.resize( data.getNumSamples(), NOT_PROCESSED );
+    }
+    
+    void operator()(const UINT startIndex,const UINT endIndex,const UINT threadIndex){
+        vector< PreProcessing* > &preProcessing = preProcessingModules[ threadIndex ];
+        vector< FeatureExtraction* > &featureExtraction = featureExtractionModules[ threadIndex ];
+        MatrixDouble buffer;
+        for(UINT i=startIndex; i<endIndex; i++){
+            MatrixDouble &sample = featureData[i];
+            sample = data[i].getData();
+            
+            //The pre-processing modules do not change the number of dimensions, so the timeseries can be processed in place
+            for(UINT k=0; k<preProcessing.size(); k++){
+                preProcessing[k]->reset();
+                if( !preProcessing[k]->processBlock( sample, sample ) ){
+                    status[i] = PRE_PROCESSING_FAILED;
+                    return;
+                }
+            }
+            
+            //Only the features computed by the last module are kept, the other modules pass on their feature vector after every row
+            for(UINT k=0; k<featureExtraction.size(); k++){
+                featureExtraction[k]->reset();
+                bool featuresComputed = false;
+                if( k+1 == featureExtraction.size() ) featuresComputed = featureExtraction[k]->computeFeaturesBlock( sample, buffer );
+                else featuresComputed = sample.getNumRows() == 0 || computeFeaturesForEachRow( featureExtraction[k], sample, buffer );
+                if( !featuresComputed ){
+                    status[i] = FEATURE_EXTRACTION_FAILED;
+                    return;
+                }
+                sample = buffer;
+            }
+            
+            status[i] = PROCESSED;
+        }
+    }
+    
+    LabelledTimeSeriesClassificationData &data;
+    vector< vector< PreProcessing* > > &preProcessingModules;
+    vector< vector< FeatureExtraction* > > &featureExtractionModules;
+    vector< MatrixDouble > featureData;
+    vector< UINT > status;
+};
+
 GestureRecognitionPipeline::GestureRecognitionPipeline(void)
 {
     initialized = false;
@@ -110,6 +370,10 @@ GestureRecognitionPipeline& GestureRecognitionPipeline::operator=(const GestureR
 	    this->testConfusionMatrix = rhs.testConfusionMatrix;
         this->crossValidationResults = rhs.crossValidationResults;
         this->testResults = rhs.testResults;
+        this->batchPredictedClassLabels = rhs.batchPredictedClassLabels;
+        this->batchClassLikelihoods = rhs.batchClassLikelihoods;
+        this->batchRegressionData = rhs.batchRegressionData;
+        this->profiler = rhs.profiler;
 
         //Copy the GRT Base variables
         this->debugLog = rhs.debugLog;
@@ -163,18 +427,22 @@ GestureRecognitionPipeline::~GestureRecognitionPipeline(void)
 } 
     
 bool GestureRecognitionPipeline::train(const LabelledClassificationData &trainingData){
+    return train( LabelledClassificationDataView( trainingData ) );
+}
+
+bool GestureRecognitionPipeline::train(const LabelledClassificationDataView &trainingData){
     
     trained = false;
     trainingTime = 0;
     clearTestResults();
     
     if( !getIsClassifierSet() ){
-        errorLog << "train(LabelledClassificationData trainingData) - Failed To Train Classifier, the classifier has not been set!" << endl;
+        errorLog << "train(const LabelledClassificationDataView &trainingData) - Failed To Train Classifier, the classifier has not been set!" << endl;
         return false;
     }
     
     if( trainingData.getNumSamples() == 0 ){
-        errorLog << "train(LabelledClassificationData trainingData) - Failed To Train Classifier, there is no training data!" << endl;
+        errorLog << "train(const LabelledClassificationDataView &trainingData) - Failed To Train Classifier, there is no training data!" << endl;
         return false;
     }
     
@@ -200,6 +468,24 @@ bool GestureRecognitionPipeline::train(const LabelledClassificationData &trainin
     Timer timer;
     timer.start();
     
+    //Count the samples in the training data, weighted samples are counted once for each repeat
+    UINT numSamples = 0;
+    for(UINT k=0; k<trainingData.getNumClasses(); k++){
+        numSamples += trainingData.getClassTracker()[k].counter;
+    }
+    
+    //If there are no preprocessing or feature extraction modules then the classifier can be trained directly from the view
+    if( !getIsPreProcessingSet() && !getIsFeatureExtractionSet() ){
+        numTrainingSamples = numSamples;
+        trained = classifier->train( trainingData );
+        if( !trained ){
+            errorLog << "train(const LabelledClassificationDataView &trainingData) - Failed To Train Classifier: " << classifier->getLastErrorMessage() << endl;
+            return false;
+        }
+        trainingTime = timer.getMilliSeconds();
+        return true;
+    }
+    
     LabelledClassificationData processedTrainingData( numDimensions );
     
     for(UINT i=0; i<trainingData.getNumSamples(); i++){
@@ -211,7 +497,7 @@ bool GestureRecognitionPipeline::train(const LabelledClassificationData &trainin
         if( getIsPreProcessingSet() ){
             for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
                 if( !preProcessingModules[moduleIndex]->process( trainingSample ) ){
-                    errorLog << "train(LabelledClassificationData trainingData) - Failed to PreProcess Training Data. PreProcessingModuleIndex: ";
+                    errorLog << "train(const LabelledClassificationDataView &trainingData) - Failed to PreProcess Training Data. PreProcessingModuleIndex: ";
                     errorLog << moduleIndex;
                     errorLog << endl;
                     return false;
@@ -224,7 +510,7 @@ bool GestureRecognitionPipeline::train(const LabelledClassificationData &trainin
         if( getIsFeatureExtractionSet() ){
             for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
                 if( !featureExtractionModules[moduleIndex]->computeFeatures( trainingSample ) ){
-                    errorLog << "train(LabelledClassificationData trainingData) - Failed to Compute Features from Training Data. FeatureExtractionModuleIndex ";
+                    errorLog << "train(const LabelledClassificationDataView &trainingData) - Failed to Compute Features from Training Data. FeatureExtractionModuleIndex ";
                     errorLog << moduleIndex;
                     errorLog << endl;
                     return false;
@@ -240,14 +526,16 @@ bool GestureRecognitionPipeline::train(const LabelledClassificationData &trainin
 
         if( okToAddProcessedData ){
             //Add the training sample to the processed training data
-            processedTrainingData.addSample(classLabel, trainingSample);
+            for(UINT r=0; r<trainingData.getNumRepeats(i); r++){
+                processedTrainingData.addSample(classLabel, trainingSample);
+            }
         }
         
     }
     
-    if( processedTrainingData.getNumSamples() != trainingData.getNumSamples() ){
+    if( processedTrainingData.getNumSamples() != numSamples ){
         
-        warningLog << "train(LabelledClassificationData trainingData) - Lost " << trainingData.getNumSamples()-processedTrainingData.getNumSamples() << " of " << trainingData.getNumSamples() << " training samples due to the processing stage!" << endl;
+        warningLog << "train(const LabelledClassificationDataView &trainingData) - Lost " << numSamples-processedTrainingData.getNumSamples() << " of " << numSamples << " training samples due to the processing stage!" << endl;
     }
 
     //Store the number of training samples
@@ -256,7 +544,7 @@ bool GestureRecognitionPipeline::train(const LabelledClassificationData &trainin
     //Train the classifier
     trained = classifier->train( processedTrainingData );
     if( !trained ){
-        errorLog << "train(LabelledClassificationData trainingData) - Failed To Train Classifier: " << classifier->getLastErrorMessage() << endl;
+        errorLog << "train(const LabelledClassificationDataView &trainingData) - Failed To Train Classifier: " << classifier->getLastErrorMessage() << endl;
         return false;
     }
     
@@ -296,37 +584,31 @@ bool GestureRecognitionPipeline::train(LabelledClassificationData trainingData,c
         return false;
     }
     
-    //Run the k-fold training and testing
+    //Run the k-fold training and testing, each thread trains and tests a copy of this pipeline
+    const unsigned long long foldSeed = getFoldBaseSeed();
+    const UINT numThreads = ParallelFor::getNumThreads( kFoldValue );
+    vector< GestureRecognitionPipeline > pipelines( numThreads, *this );
+    GestureRecognitionPipelineFoldTask< LabelledClassificationData, LabelledClassificationDataView > foldTask( trainingData, kFoldValue, pipelines, false, foldSeed );
+    ParallelFor::run( kFoldValue, foldTask );
+    
+    //Merge the results of each fold, in order
     double crossValidationAccuracy = 0;
-    LabelledClassificationData foldTrainingData;
-    LabelledClassificationData foldTestData;
-    vector< TestResult > cvResults(kFoldValue);
-
     for(UINT k=0; k<kFoldValue; k++){
-        ///Train the classification system
-		foldTrainingData = trainingData.getTrainingFoldData(k);
-        
-        if( !train( foldTrainingData ) ){
-            return false;
-        }
-        
-        //Test the classification system
-        foldTestData = trainingData.getTestFoldData(k);
-        
-        if( !test( foldTestData ) ){
+        if( !foldTask.foldTrained[k] || !foldTask.foldTested[k] ){
             return false;
         }
-        
-        crossValidationAccuracy += getTestAccuracy();
-        cvResults[k] = getTestResults();
+        crossValidationAccuracy += foldTask.foldScores[k];
     }
+    
+    //Keep the pipeline that was trained on the last fold
+    *this = pipelines[ numThreads-1 ];
+    crossValidationResults = foldTask.foldResults;
 
     //Flag that the model has been trained
     trained = true;
     
     //Set the accuracy of the classification system averaged over the kfolds
     testAccuracy = crossValidationAccuracy / double(kFoldValue);
-    crossValidationResults = cvResults;
     
     //Store the training time
     trainingTime = timer.getMilliSeconds();
@@ -360,7 +642,6 @@ bool GestureRecognitionPipeline::train(LabelledTimeSeriesClassificationData trai
     //Set the input vector dimension size of the pipeline
     inputVectorDimensions = trainingData.getNumDimensions();
     
-    LabelledTimeSeriesClassificationData processedTrainingData( trainingData.getNumDimensions() );
     LabelledTimeSeriesClassificationData labelledTimeseriesClassificationData;
     LabelledClassificationData labelledClassificationData;
     
@@ -386,122 +667,79 @@ bool GestureRecognitionPipeline::train(LabelledTimeSeriesClassificationData trai
         labelledClassificationData.setNumDimensions( trainingDataInputDimensionSize );
     }
     
-    //Pass the timeseries data through any pre-processing modules and add it to the processedTrainingData structure
-    for(UINT i=0; i<trainingData.getNumSamples(); i++){
-        UINT classLabel = trainingData[i].getClassLabel();
-        MatrixDouble trainingSample = trainingData[i].getData();
-        
-        if( getIsPreProcessingSet() ){
-            
-            //Try to process the matrix data row-by-row
-            bool resetPreprocessingModule = true;
-            for(UINT r=0; r<trainingSample.getNumRows(); r++){
-                VectorDouble sample = trainingSample.getRowVector( r );
-                
-                for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
-                    
-                    if( resetPreprocessingModule ){
-                        preProcessingModules[moduleIndex]->reset();
-                    }
-                    
-                    //Validate the input and output dimensions match!
-                    if( preProcessingModules[moduleIndex]->getNumInputDimensions() != preProcessingModules[moduleIndex]->getNumOutputDimensions() ){
-                        errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To PreProcess Training Data. The number of inputDimensions (";
-                        errorLog << preProcessingModules[moduleIndex]->getNumInputDimensions();
-                        errorLog << ") in  PreProcessingModule ";
-                        errorLog << moduleIndex;
-                        errorLog << " do not match the number of outputDimensions (";
-                        errorLog << preProcessingModules[moduleIndex]->getNumOutputDimensions();
-                        errorLog <<  endl;
-                        return false;
-                    }
-                    
-                    if( !preProcessingModules[moduleIndex]->process( sample ) ){
-                        errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To PreProcess Training Data. PreProcessingModuleIndex: ";
-                        errorLog << moduleIndex;
-                        errorLog << endl;
-                        return false;
-                    }
-                    sample = preProcessingModules[moduleIndex]->getProcessedData();
-                }
-                
-                //The preprocessing modules should only be reset when r==0
-                resetPreprocessingModule = false;
-                
-                //Overwrite the original training sample with the preProcessed sample
-                for(UINT c=0; c<sample.size(); c++){
-                    trainingSample[r][c] = sample[c];
-                }
-            }
-            
+    //The pre-processing modules are applied to each timeseries in place, so they must not change the number of dimensions
+    for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
+        if( preProcessingModules[moduleIndex]->getNumInputDimensions() != preProcessingModules[moduleIndex]->getNumOutputDimensions() ){
+            errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To PreProcess Training Data. The number of inputDimensions (";
+            errorLog << preProcessingModules[moduleIndex]->getNumInputDimensions();
+            errorLog << ") in  PreProcessingModule ";
+            errorLog << moduleIndex;
+            errorLog << " do not match the number of outputDimensions (";
+            errorLog << preProcessingModules[moduleIndex]->getNumOutputDimensions();
+            errorLog <<  endl;
+            return false;
         }
-        
-        //Add the training sample to the processed training data
-        processedTrainingData.addSample(classLabel,trainingSample);
     }
     
-    //Loop over the processed training data, perfrom any feature extraction if needed
-    //Add the data to either the timeseries or classification data structures
-    for(UINT i=0; i<processedTrainingData.getNumSamples(); i++){
-        UINT classLabel = processedTrainingData[i].getClassLabel();
-        MatrixDouble trainingSample = processedTrainingData[i].getData();
-        bool featureDataReady = false;
-        bool resetFeatureExtractionModules = true;
-        
-        MatrixDouble featureData;
-        //Try to process the matrix data row-by-row
-        for(UINT r=0; r<trainingSample.getNumRows(); r++){
-            VectorDouble inputVector = trainingSample.getRowVector( r );
-            featureDataReady = true;
-            
-             //Pass the processed training data through the feature extraction
-            if( getIsFeatureExtractionSet() ){
-            
-                for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
-                    
-                    if( resetFeatureExtractionModules ){
-                        featureExtractionModules[moduleIndex]->reset();
-                    }
-                    
-                    if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
-                        errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To Compute Features For Training Data. FeatureExtractionModuleIndex: ";
-                        errorLog << moduleIndex;
-                        errorLog << endl;
-                        return false;
-                    }
-                    
-                    //Overwrite the input vector with the features so this can either be input to the next feature module 
-                    //or converted to the LabelledClassificationData format
-                    inputVector = featureExtractionModules[moduleIndex]->getFeatureVector();
-                    featureDataReady = featureExtractionModules[moduleIndex]->getFeatureDataReady();
-                }
-                
-                //The feature extraction modules should only be reset on r == 0
-                resetFeatureExtractionModules = false;
-                
-                if( featureDataReady ){
-                    
-                    if( classifier->getTimeseriesCompatible() ){
-                        if( !featureData.push_back( inputVector ) ){
-                            errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To add feature vector to feature data matrix! FeatureExtractionModuleIndex: " << endl;
-                            return false;
-                        }
-                    }else labelledClassificationData.addSample(classLabel, inputVector);
-                }
-                
-            }else{
-                if( classifier->getTimeseriesCompatible() ){
-                    if( !featureData.push_back( inputVector ) ){
-                        errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To add feature vector to feature data matrix! FeatureExtractionModuleIndex: " << endl;
-                        return false;
-                    }
-                }
-                else labelledClassificationData.addSample(classLabel, inputVector);
-            }
+    //Each thread needs its own copy of the pre-processing and feature extraction modules as they are updated by every sample. The
+    //last thread uses the pipeline's modules, so they are left in the same state as if the timeseries had been processed in order
+    const UINT numThreads = ParallelFor::getNumThreads( trainingData.getNumSamples(), MIN_TIMESERIES_PER_THREAD );
+    vector< vector< PreProcessing* > > threadPreProcessingModules( numThreads, preProcessingModules );
+    vector< vector< FeatureExtraction* > > threadFeatureExtractionModules( numThreads, featureExtractionModules );
+    bool modulesCopied = true;
+    for(UINT t=0; t+1<numThreads; t++){
+        for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
+            PreProcessing *newInstance = preProcessingModules[moduleIndex]->createNewInstance();
+            threadPreProcessingModules[t][moduleIndex] = newInstance;
+            if( newInstance == NULL || !newInstance->clone( preProcessingModules[moduleIndex] ) ) modulesCopied = false;
+        }
+        for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+            FeatureExtraction *newInstance = featureExtractionModules[moduleIndex]->createNewInstance();
+            threadFeatureExtractionModules[t][moduleIndex] = newInstance;
+            if( newInstance == NULL || !newInstance->clone( featureExtractionModules[moduleIndex] ) ) modulesCopied = false;
+        }
+    }
+    
+    //Pass each timeseries through the pre-processing and feature extraction modules
+    GestureRecognitionPipelineTimeSeriesTask timeSeriesTask( trainingData, threadPreProcessingModules, threadFeatureExtractionModules );
+    if( modulesCopied ) ParallelFor::run( trainingData.getNumSamples(), timeSeriesTask, MIN_TIMESERIES_PER_THREAD );
+    
+    for(UINT t=0; t+1<numThreads; t++){
+        for(UINT moduleIndex=0; moduleIndex<threadPreProcessingModules[t].size(); moduleIndex++){
+            delete threadPreProcessingModules[t][moduleIndex];
+        }
+        for(UINT moduleIndex=0; moduleIndex<threadFeatureExtractionModules[t].size(); moduleIndex++){
+            delete threadFeatureExtractionModules[t][moduleIndex];
+        }
+    }
+    
+    if( !modulesCopied ){
+        errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To copy the pre-processing and feature extraction modules!" << endl;
+        return false;
+    }
+    
+    //Add the features of each timeseries to either the timeseries or classification data structures, in order
+    for(UINT i=0; i<trainingData.getNumSamples(); i++){
+        const UINT status = timeSeriesTask.status[i];
+        if( status == GestureRecognitionPipelineTimeSeriesTask::PRE_PROCESSING_FAILED ){
+            errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To PreProcess Training Data. TrainingSampleIndex: " << i << endl;
+            return false;
+        }
+        if( status != GestureRecognitionPipelineTimeSeriesTask::PROCESSED ){
+            errorLog << "train(LabelledTimeSeriesClassificationData trainingData) - Failed To Compute Features For Training Data. TrainingSampleIndex: " << i << endl;
+            return false;
         }
         
-        if( classifier->getTimeseriesCompatible() ) labelledTimeseriesClassificationData.addSample(classLabel, featureData);
+        UINT classLabel = trainingData[i].getClassLabel();
+        const MatrixDouble &featureData = timeSeriesTask.featureData[i];
         
+        if( classifier->getTimeseriesCompatible() ){
+            labelledTimeseriesClassificationData.addSample(classLabel, featureData);
+        }else{
+            for(UINT r=0; r<featureData.getNumRows(); r++){
+                labelledClassificationData.addSample(classLabel, featureData.getRowVector(r));
+            }
+        }
     }
         
     //Train the classification system
@@ -553,30 +791,30 @@ bool GestureRecognitionPipeline::train(LabelledTimeSeriesClassificationData trai
         return false;
     }
     
-    //Run the k-fold training and testing
-    double crossValidationAccuracy = 0;
-    LabelledTimeSeriesClassificationData foldTrainingData;
-    LabelledTimeSeriesClassificationData foldTestData;
+    //Run the k-fold training and testing, each thread trains and tests a copy of this pipeline
+    const unsigned long long foldSeed = getFoldBaseSeed();
+    const UINT numThreads = ParallelFor::getNumThreads( kFoldValue );
+    vector< GestureRecognitionPipeline > pipelines( numThreads, *this );
+    GestureRecognitionPipelineFoldTask< LabelledTimeSeriesClassificationData > foldTask( trainingData, kFoldValue, pipelines, false, foldSeed );
+    ParallelFor::run( kFoldValue, foldTask );
     
+    //Merge the results of each fold, in order
+    double crossValidationAccuracy = 0;
     for(UINT k=0; k<kFoldValue; k++){
-        ///Train the classification system
-		foldTrainingData = trainingData.getTrainingFoldData(k);
-        
-        if( !train( foldTrainingData ) ){
+        if( !foldTask.foldTrained[k] ){
             errorLog << "train(LabelledTimeSeriesClassificationData trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed to train pipeline for fold " << k << "." << endl;
             return false;
         }
-        
-        //Test the classification system
-        foldTestData = trainingData.getTestFoldData(k);
-        
-        if( !test( foldTestData ) ){
+        if( !foldTask.foldTested[k] ){
             errorLog << "train(LabelledTimeSeriesClassificationData trainingData,const UINT kFoldValue,const bool useStratifiedSampling) - Failed to test pipeline for fold " << k << "." << endl;
             return false;
         }
-        
-        crossValidationAccuracy += getTestAccuracy();
+        crossValidationAccuracy += foldTask.foldScores[k];
     }
+    
+    //Keep the pipeline that was trained on the last fold
+    *this = pipelines[ numThreads-1 ];
+    crossValidationResults = foldTask.foldResults;
 
     //Flag that the model has been trained
     trained = true;
@@ -715,28 +953,24 @@ bool GestureRecognitionPipeline::train(LabelledRegressionData trainingData,const
         return false;
     }
     
-    //Run the k-fold training and testing
+    //Run the k-fold training and testing, each thread trains and tests a copy of this pipeline
+    const unsigned long long foldSeed = getFoldBaseSeed();
+    const UINT numThreads = ParallelFor::getNumThreads( kFoldValue );
+    vector< GestureRecognitionPipeline > pipelines( numThreads, *this );
+    GestureRecognitionPipelineFoldTask< LabelledRegressionData > foldTask( trainingData, kFoldValue, pipelines, true, foldSeed );
+    ParallelFor::run( kFoldValue, foldTask );
+    
+    //Merge the results of each fold, in order
     double crossValidationAccuracy = 0;
-    LabelledRegressionData foldTrainingData;
-    LabelledRegressionData foldTestData;
     for(UINT k=0; k<kFoldValue; k++){
-        ///Train the classification system
-        foldTrainingData = trainingData.getTrainingFoldData(k);
-        
-        if( !train( foldTrainingData ) ){
-            return false;
-        }
-        
-        //Test the classification system
-        foldTestData = trainingData.getTestFoldData(k);
-        
-        if( !test( foldTestData ) ){
+        if( !foldTask.foldTrained[k] || !foldTask.foldTested[k] ){
             return false;
         }
-
-        crossValidationAccuracy += getTestRMSError();
-        
+        crossValidationAccuracy += foldTask.foldScores[k];
     }
+    
+    //Keep the pipeline that was trained on the last fold
+    *this = pipelines[ numThreads-1 ];
 
     //Flag that the model has been trained
     trained = true;
@@ -750,24 +984,28 @@ bool GestureRecognitionPipeline::train(LabelledRegressionData trainingData,const
 }
     
 bool GestureRecognitionPipeline::test(const LabelledClassificationData &testData){
+    return test( LabelledClassificationDataView( testData ) );
+}
+
+bool GestureRecognitionPipeline::test(const LabelledClassificationDataView &testData){
     
     //Clear any previous test results
     clearTestResults();
     
     //Make sure the classification model has been trained
     if( !trained ){
-        errorLog << "test(LabelledClassificationData testData) - Classifier is not trained" << endl;
+        errorLog << "test(const LabelledClassificationDataView &testData) - Classifier is not trained" << endl;
         return false;
     }
     
     //Make sure the dimensionality of the test data matches the input vector's dimensions
     if( testData.getNumDimensions() != inputVectorDimensions ){
-        errorLog << "test(LabelledClassificationData testData) - The dimensionality of the test data (" + Util::toString(testData.getNumDimensions()) + ") does not match that of the input vector dimensions of the pipeline (" << inputVectorDimensions << ")" << endl;
+        errorLog << "test(const LabelledClassificationDataView &testData) - The dimensionality of the test data (" + Util::toString(testData.getNumDimensions()) + ") does not match that of the input vector dimensions of the pipeline (" << inputVectorDimensions << ")" << endl;
         return false;
     }
     
     if( !getIsClassifierSet() ){
-        errorLog << "test(LabelledClassificationData testData) - The classifier has not been set" << endl;
+        errorLog << "test(const LabelledClassificationDataView &testData) - The classifier has not been set" << endl;
         return false;
     }
     
@@ -787,12 +1025,12 @@ bool GestureRecognitionPipeline::test(const LabelledClassificationData &testData
 
 		if( !labelFound ){
 			classLabelValidationPassed = false;
-            errorLog << "test(LabelledClassificationData testData) - The test dataset contains a class label (" << testData.getClassTracker()[i].classLabel << ") that is not in the model!" << endl;
+            errorLog << "test(const LabelledClassificationDataView &testData) - The test dataset contains a class label (" << testData.getClassTracker()[i].classLabel << ") that is not in the model!" << endl;
 		}
 	}
 
 	if( !classLabelValidationPassed ){
-        errorLog << "test(LabelledClassificationData testData) -  Model Class Labels: ";
+        errorLog << "test(const LabelledClassificationDataView &testData) -  Model Class Labels: ";
         for(UINT k=0; k<classifier->getNumClasses(); k++){
             errorLog << classifier->getClassLabels()[k] << "\t";
 		}
@@ -832,7 +1070,7 @@ bool GestureRecognitionPipeline::test(const LabelledClassificationData &testData
         
         //Pass the test sample through the pipeline
         if( !predict( testSample ) ){
-            errorLog << "test(LabelledClassificationData testData) - Prediction failed for test sample at index: " << i << endl;
+            errorLog << "test(const LabelledClassificationDataView &testData) - Prediction failed for test sample at index: " << i << endl;
             return false;
         }
         
@@ -840,7 +1078,7 @@ bool GestureRecognitionPipeline::test(const LabelledClassificationData &testData
         UINT predictedClassLabel = getPredictedClassLabel();
         
         if( !updateTestMetrics(classLabel,predictedClassLabel,precisionCounter,recallCounter,rejectionPrecisionCounter,rejectionRecallCounter, confusionMatrixCounter) ){
-            errorLog << "test(LabelledClassificationData testData) - Failed to update test metrics at test sample index: " << i << endl;
+            errorLog << "test(const LabelledClassificationDataView &testData) - Failed to update test metrics at test sample index: " << i << endl;
             return false;
         }
         
@@ -852,7 +1090,7 @@ bool GestureRecognitionPipeline::test(const LabelledClassificationData &testData
     }
     
     if( !computeTestMetrics(precisionCounter,recallCounter,rejectionPrecisionCounter,rejectionRecallCounter, confusionMatrixCounter, numTestSamples) ){
-        errorLog <<"test(LabelledClassificationData testData) - Failed to compute test metrics!" << endl;
+        errorLog <<"test(const LabelledClassificationDataView &testData) - Failed to compute test metrics!" << endl;
         return false;
     }
     
@@ -1115,6 +1353,213 @@ bool GestureRecognitionPipeline::test(LabelledRegressionData testData){
     return true;
 }
 
+bool GestureRecognitionPipeline::test(BinaryDatasetReader &testData){
+
+    //Clear any previous test results
+    clearTestResults();
+
+    //Make sure the model has been trained
+    if( !trained ){
+        errorLog << "test(BinaryDatasetReader &testData) - The model has not been trained" << endl;
+        return false;
+    }
+
+    if( !testData.is_open() ){
+        errorLog << "test(BinaryDatasetReader &testData) - The binary dataset file is not open" << endl;
+        return false;
+    }
+
+    //Make sure the dimensionality of the test data matches the input vector's dimensions
+    if( testData.getNumDimensions() != inputVectorDimensions ){
+        errorLog << "test(BinaryDatasetReader &testData) - The dimensionality of the test data (" << testData.getNumDimensions() << ") does not match that of the input vector dimensions of the pipeline (" << inputVectorDimensions << ")" << endl;
+        return false;
+    }
+
+    const UINT datasetType = testData.getDatasetType();
+    const bool regressionTest = datasetType == BinaryDatasetFile::LABELLED_REGRESSION_DATA;
+
+    if( datasetType == BinaryDatasetFile::UNLABELLED_CLASSIFICATION_DATA ){
+        errorLog << "test(BinaryDatasetReader &testData) - The pipeline can not be tested with unlabelled data" << endl;
+        return false;
+    }
+
+    if( regressionTest && !getIsRegressifierSet() ){
+        errorLog << "test(BinaryDatasetReader &testData) - The regressifier has not been set" << endl;
+        return false;
+    }
+
+    if( !regressionTest && !getIsClassifierSet() ){
+        errorLog << "test(BinaryDatasetReader &testData) - The classifier has not been set" << endl;
+        return false;
+    }
+
+    if( regressionTest && regressifier->getNumOutputDimensions() != testData.getNumTargetDimensions() ){
+        errorLog << "test(BinaryDatasetReader &testData) - The size of the output of the regressifier (" << regressifier->getNumOutputDimensions() << ") does not match that of the size of the number of target dimensions (" << testData.getNumTargetDimensions() << ")" << endl;
+        return false;
+    }
+
+    //Validate that the class labels in the test data match the class labels in the model
+    if( datasetType == BinaryDatasetFile::LABELLED_CLASSIFICATION_DATA ){
+        const vector< ClassTracker > &classTracker = testData.getClassTracker();
+        for(UINT i=0; i<classTracker.size(); i++){
+            bool labelFound = false;
+            for(UINT k=0; k<classifier->getNumClasses(); k++){
+                if( classTracker[i].classLabel == classifier->getClassLabels()[k] ){
+                    labelFound = true;
+                    break;
+                }
+            }
+            if( !labelFound ){
+                errorLog << "test(BinaryDatasetReader &testData) - The test dataset contains a class label (" << classTracker[i].classLabel << ") that is not in the model!" << endl;
+                return false;
+            }
+        }
+    }
+
+    //Reset all the modules
+    reset();
+    testData.reset();
+
+    double rejectionPrecisionCounter = 0;
+    double rejectionRecallCounter = 0;
+    const UINT K = regressionTest ? 0 : classifier->getNumClasses();
+    const UINT confusionMatrixSize = !regressionTest && classifier->getNullRejectionEnabled() ? K+1 : K;
+    VectorDouble precisionCounter(K, 0);
+    VectorDouble recallCounter(K, 0);
+    VectorDouble confusionMatrixCounter(confusionMatrixSize,0);
+    if( !regressionTest ){
+        testConfusionMatrix.resize(confusionMatrixSize,confusionMatrixSize);
+        testConfusionMatrix.setAllValues(0);
+        testPrecision.resize(K, 0);
+        testRecall.resize(K, 0);
+        testFMeasure.resize(K, 0);
+    }
+
+    //Start the test timer
+    Timer timer;
+    timer.start();
+
+    //The rows of each chunk are gathered into these buffers, so no memory is allocated per test sample
+    VectorDouble inputVector( inputVectorDimensions );
+    VectorDouble targetVector( testData.getNumTargetDimensions() );
+    MatrixDouble timeSeries;
+    UINT timeSeriesLength = 0;
+    UINT timeSeriesClassLabel = 0;
+    UINT timeSeriesIndex = 0;
+    TestInstanceResult testResult;
+    BinaryDatasetChunk chunk;
+    bool endOfFile = false;
+
+    while( !endOfFile ){
+        endOfFile = !testData.readNextChunk( chunk );
+        const UINT numRows = chunk.getNumRows();
+
+        for(UINT i=0; i<=numRows; i++){
+            const bool lastRow = i == numRows;
+
+            if( datasetType == BinaryDatasetFile::LABELLED_TIME_SERIES_CLASSIFICATION_DATA ){
+                //A time series can span several chunks, so it is tested once the sample index changes (or the file ends)
+                if( timeSeriesLength > 0 && (lastRow ? endOfFile : chunk.getSampleIndexs()[i] != timeSeriesIndex) ){
+                    MatrixDouble testSeries( timeSeriesLength, inputVectorDimensions );
+                    for(UINT n=0; n<timeSeriesLength; n++){
+                        std::copy( timeSeries[n], timeSeries[n]+inputVectorDimensions, testSeries[n] );
+                    }
+                    if( !predict( testSeries ) ){
+                        errorLog << "test(BinaryDatasetReader &testData) - Failed to run prediction for test sample index: " << numTestSamples << endl;
+                        return false;
+                    }
+                    const UINT predictedClassLabel = getPredictedClassLabel();
+                    if( !updateTestMetrics(timeSeriesClassLabel,predictedClassLabel,precisionCounter,recallCounter,rejectionPrecisionCounter,rejectionRecallCounter, confusionMatrixCounter) ){
+                        errorLog << "test(BinaryDatasetReader &testData) - Failed to update test metrics at test sample index: " << numTestSamples << endl;
+                        return false;
+                    }
+                    numTestSamples++;
+                    timeSeriesLength = 0;
+                }
+                if( lastRow ) break;
+
+                //Add the row to the current time series, the buffer only grows when a longer time series is found
+                timeSeriesIndex = chunk.getSampleIndexs()[i];
+                timeSeriesClassLabel = chunk.getClassLabels()[i];
+                if( timeSeries.getNumRows() <= timeSeriesLength ){
+                    MatrixDouble largerBuffer( MAX(timeSeriesLength*2,(UINT)64), inputVectorDimensions );
+                    for(UINT n=0; n<timeSeriesLength; n++){
+                        std::copy( timeSeries[n], timeSeries[n]+inputVectorDimensions, largerBuffer[n] );
+                    }
+                    timeSeries = largerBuffer;
+                }
+                chunk.getSample( i, timeSeries[ timeSeriesLength++ ] );
+                continue;
+            }
+
+            if( lastRow ) break;
+
+            chunk.getSample( i, &inputVector[0] );
+
+            if( regressionTest ){
+                chunk.getTarget( i, &targetVector[0] );
+
+                //Pass the test sample through the pipeline
+                if( !map( inputVector ) ){
+                    errorLog << "test(BinaryDatasetReader &testData) - Failed to map input vector!" << endl;
+                    return false;
+                }
+
+                //Update the RMS error
+                const VectorDouble prediction = regressifier->getRegressionData();
+                double sum = 0;
+                for(UINT j=0; j<targetVector.size(); j++){
+                    sum += SQR( prediction[j]-targetVector[j] );
+                }
+                testSquaredError += sum;
+
+                testResult.setRegressionResult(numTestSamples,prediction,targetVector);
+                regressifier->notifyTestResultsObservers( testResult );
+            }else{
+                const UINT classLabel = chunk.getClassLabels()[i];
+
+                //Pass the test sample through the pipeline
+                if( !predict( inputVector ) ){
+                    errorLog << "test(BinaryDatasetReader &testData) - Prediction failed for test sample at index: " << numTestSamples << endl;
+                    return false;
+                }
+
+                const UINT predictedClassLabel = getPredictedClassLabel();
+
+                //As with the in-memory continuous data, only the accuracy is computed for continuous time series data
+                if( datasetType == BinaryDatasetFile::LABELLED_CONTINUOUS_TIME_SERIES_CLASSIFICATION_DATA ){
+                    if( classLabel == predictedClassLabel ) testAccuracy++;
+                }else if( !updateTestMetrics(classLabel,predictedClassLabel,precisionCounter,recallCounter,rejectionPrecisionCounter,rejectionRecallCounter, confusionMatrixCounter) ){
+                    errorLog << "test(BinaryDatasetReader &testData) - Failed to update test metrics at test sample index: " << numTestSamples << endl;
+                    return false;
+                }
+
+                testResult.setClassificationResult(numTestSamples, classLabel, predictedClassLabel, getUnProcessedPredictedClassLabel(), getClassLikelihoods(), getClassDistances());
+                classifier->notifyTestResultsObservers( testResult );
+            }
+            numTestSamples++;
+        }
+    }
+
+    if( numTestSamples == 0 ){
+        errorLog << "test(BinaryDatasetReader &testData) - The test dataset is empty!" << endl;
+        return false;
+    }
+
+    if( regressionTest ){
+        testRMSError = sqrt( testSquaredError / double( numTestSamples ) );
+    }else if( datasetType == BinaryDatasetFile::LABELLED_CONTINUOUS_TIME_SERIES_CLASSIFICATION_DATA ){
+        testAccuracy = testAccuracy / double( numTestSamples ) * 100.0;
+    }else if( !computeTestMetrics(precisionCounter,recallCounter,rejectionPrecisionCounter,rejectionRecallCounter, confusionMatrixCounter, numTestSamples) ){
+        errorLog << "test(BinaryDatasetReader &testData) - Failed to compute test metrics!" << endl;
+        return false;
+    }
+
+    testTime = timer.getMilliSeconds();
+
+    return true;
+}
+
 bool GestureRecognitionPipeline::predict(const VectorDouble &inputVector){
 	
 	//Make sure the classification model has been trained
@@ -1129,12 +1574,17 @@ bool GestureRecognitionPipeline::predict(const VectorDouble &inputVector){
         return false;
     }
 
-	if( getIsClassifierSet() ){
-        return predict_classifier( inputVector );
-    }
+	if( getIsClassifierSet() || getIsRegressifierSet() ){
+        if( profiler.getEnabled() ){
+            if( profiler.getNumStages() != getNumProfilerStages() ) setupProfiler();
+            profiler.startPrediction();
+        }
+
+        PredictionStages stages = getPredictionStages();
+        const bool predictionResult = predictStages( stages, inputVector );
 
-	if( getIsRegressifierSet() ){
-        return predict_regressifier( inputVector );
+        if( profiler.getEnabled() ) profiler.stopPrediction();
+        return predictionResult;
     }
 
     errorLog << "predict(const VectorDouble &inputVector) - Neither a classifier or regressifer is not set" << endl;
@@ -1224,54 +1674,10 @@ bool GestureRecognitionPipeline::predict(MatrixDouble inputMatrix){
     //Perform any post processing
     predictionModuleIndex = AFTER_CLASSIFIER;
     if( getIsPostProcessingSet() ){
-        
-        if( pipelineMode != CLASSIFICATION_MODE){
-            errorLog << "predict_classifier(VectorDouble inputVector) - Pipeline Mode Is Not in CLASSIFICATION_MODE!" << endl;
+        if( !postProcessPredictedClassLabel() ){
             return false;
         }
-        
-        VectorDouble data;
-        for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
-            
-            //Select which input we should give the postprocessing module
-            if( postProcessingModules[moduleIndex]->getIsPostProcessingInputModePredictedClassLabel() ){
-                //Set the input
-                data.resize(1);
-                data[0] = predictedClassLabel;
-                
-                //Verify that the input size is OK
-                if( data.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
-                    errorLog << "predict_classifier(VectorDouble inputVector) - The size of the data vector (" << int(data.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
-                    return false;
-                }
-                
-                //Postprocess the data
-                if( !postProcessingModules[moduleIndex]->process( data ) ){
-                    errorLog << "predict_classifier(VectorDouble inputVector) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << endl;
-                    return false;
-                }
-                
-                //Select which output we should update
-                data = postProcessingModules[moduleIndex]->getProcessedData();  
-            }
-            
-            //Select which output we should update
-            if( postProcessingModules[moduleIndex]->getIsPostProcessingOutputModePredictedClassLabel() ){
-                //Get the processed predicted class label
-                data = postProcessingModules[moduleIndex]->getProcessedData(); 
-                
-                //Verify that the output size is OK
-                if( data.size() != 1 ){
-                    errorLog << "predict_classifier(VectorDouble inputVector) - The size of the processed data vector (" << int(data.size()) << ") from postProcessingModule at the moduleIndex: " << moduleIndex << " is not equal to 1 even though it is in OutputModePredictedClassLabel!" << endl;
-                    return false;
-                }
-                
-                //Update the predicted class label
-                predictedClassLabel = (UINT)data[0];
-            }
-                  
-        }
-    } 
+    }
     
     //Update the context module
     //TODO
@@ -1280,311 +1686,307 @@ bool GestureRecognitionPipeline::predict(MatrixDouble inputMatrix){
 	return true;
 }
 
-bool GestureRecognitionPipeline::map(VectorDouble inputVector){
-	return predict_regressifier( inputVector );
-}
+bool GestureRecognitionPipeline::predictBatch(const MatrixDouble &inputData){
 
-bool GestureRecognitionPipeline::predict_classifier(VectorDouble inputVector){
-    
-    predictedClassLabel = 0;
-    
-    //Update the context module
-    predictionModuleIndex = START_OF_PIPELINE;
-    if( contextModules[ START_OF_PIPELINE ].size() > 0 ){
-        for(UINT moduleIndex=0; moduleIndex<contextModules[ START_OF_PIPELINE ].size(); moduleIndex++){
-            if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at START_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->getOK() ){
-                return true;
-            }
-            inputVector = contextModules[ START_OF_PIPELINE ][moduleIndex]->getProcessedData();
-        }
-    }
-    
-    //Perform any pre-processing
-    if( getIsPreProcessingSet() ){
-        for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
-            if( !preProcessingModules[moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            inputVector = preProcessingModules[moduleIndex]->getProcessedData();
-        }
-    }
-    
-    //Update the context module
-    predictionModuleIndex = AFTER_PREPROCESSING;
-    if( contextModules[ AFTER_PREPROCESSING ].size() ){
-        for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_PREPROCESSING ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getOK() ){
-                predictionModuleIndex = AFTER_PREPROCESSING;
-                return false;
-            }
-            inputVector = contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getProcessedData();
-        }
-    }
-    
-    //Perform any feature extraction
-    if( getIsFeatureExtractionSet() ){
-        for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
-            if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            inputVector = featureExtractionModules[moduleIndex]->getFeatureVector();
-        }
+    batchPredictedClassLabels.clear();
+    batchClassLikelihoods.clear();
+    batchRegressionData.clear();
+
+    //Make sure the model has been trained
+    if( !trained ){
+        errorLog << "predictBatch(const MatrixDouble &inputData) - The model has not been trained" << endl;
+        return false;
     }
-    
-    //Update the context module
-    predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
-    if( contextModules[ AFTER_FEATURE_EXTRACTION ].size() ){
-        for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_FEATURE_EXTRACTION ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getOK() ){
-                predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
-                return false;
-            }
-            inputVector = contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getProcessedData();
-        }
+
+    //Make sure the dimensionality of the input data matches the inputVectorDimensions
+    if( inputData.getNumCols() != inputVectorDimensions ){
+        errorLog << "predictBatch(const MatrixDouble &inputData) - The dimensionality of the input data (" << inputData.getNumCols() << ") does not match that of the input vector dimensions of the pipeline (" << inputVectorDimensions << ")" << endl;
+        return false;
     }
-    
-    //Perform the classification
-    if( !classifier->predict(inputVector) ){
-        errorLog << "predict_classifier(VectorDouble inputVector) - Prediction Failed! " << classifier->getLastErrorMessage() << endl;
+
+    if( !getIsClassifierSet() && !getIsRegressifierSet() ){
+        errorLog << "predictBatch(const MatrixDouble &inputData) - Neither a classifier or regressifer is not set" << endl;
         return false;
     }
-    predictedClassLabel = classifier->getPredictedClassLabel();
-    
-    //Update the context module
-    if( contextModules[ AFTER_CLASSIFIER ].size() ){
-        for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_CLASSIFIER ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->process( vector<double>(1,predictedClassLabel) ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at AFTER_CLASSIFIER. ModuleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->getOK() ){
-                predictionModuleIndex = AFTER_CLASSIFIER;
-                return false;
-            }
-            predictedClassLabel = (UINT)contextModules[ AFTER_CLASSIFIER ][moduleIndex]->getProcessedData()[0];
-        }
+
+    const UINT numSamples = inputData.getNumRows();
+    if( numSamples == 0 ){
+        errorLog << "predictBatch(const MatrixDouble &inputData) - The input data is empty" << endl;
+        return false;
     }
-    
-    //Perform any post processing
-    predictionModuleIndex = AFTER_CLASSIFIER;
-    if( getIsPostProcessingSet() ){
-        
-        if( pipelineMode != CLASSIFICATION_MODE){
-            errorLog << "predict_classifier(VectorDouble inputVector) - Pipeline Mode Is Not in CLASSIFICATION_MODE!" << endl;
-            return false;
-        }
-        
-        VectorDouble data;
-        for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
-            
-            //Select which input we should give the postprocessing module
-            if( postProcessingModules[moduleIndex]->getIsPostProcessingInputModePredictedClassLabel() ){
-                //Set the input
-                data.resize(1);
-                data[0] = predictedClassLabel;
-                
-                //Verify that the input size is OK
-                if( data.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
-                    errorLog << "predict_classifier(VectorDouble inputVector) - The size of the data vector (" << int(data.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
-                    return false;
-                }
-                
-                //Postprocess the data
-                if( !postProcessingModules[moduleIndex]->process( data ) ){
-                    errorLog << "predict_classifier(VectorDouble inputVector) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << endl;
-                    return false;
-                }
-                
-                //Select which output we should update
-                data = postProcessingModules[moduleIndex]->getProcessedData();  
-            }
-            
-            //Select which output we should update
-            if( postProcessingModules[moduleIndex]->getIsPostProcessingOutputModePredictedClassLabel() ){
-                //Get the processed predicted class label
-                data = postProcessingModules[moduleIndex]->getProcessedData(); 
-                
-                //Verify that the output size is OK
-                if( data.size() != 1 ){
-                    errorLog << "predict_classifier(VectorDouble inputVector) - The size of the processed data vector (" << int(data.size()) << ") from postProcessingModule at the moduleIndex: " << moduleIndex << " is not equal to 1 even though it is in OutputModePredictedClassLabel!" << endl;
-                    return false;
-                }
-                
-                //Update the predicted class label
-                predictedClassLabel = (UINT)data[0];
-            }
-                  
+
+    //The context modules can stop a sample part way through the pipeline, so in this case the samples are predicted one at a time
+    if( getIsContextSet() ){
+        if( getIsClassifierSet() ){
+            batchPredictedClassLabels.resize( numSamples, 0 );
+            batchClassLikelihoods.resize( numSamples, classifier->getNumClasses() );
         }
-    } 
-    
-    //Update the context module
-    predictionModuleIndex = END_OF_PIPELINE;
-    if( contextModules[ END_OF_PIPELINE ].size() ){
-        for(UINT moduleIndex=0; moduleIndex<contextModules[ END_OF_PIPELINE ].size(); moduleIndex++){
-            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( vector<double>(1,predictedClassLabel) ) ){
-                errorLog << "predict_classifier(VectorDouble inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
+
+        for(UINT i=0; i<numSamples; i++){
+            copyBatchRow( inputData, i, batchRowBuffer );
+            if( !predict( batchRowBuffer ) ){
+                errorLog << "predictBatch(const MatrixDouble &inputData) - Failed to predict sample " << i << endl;
                 return false;
             }
-            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->getOK() ){
-                predictionModuleIndex = END_OF_PIPELINE;
-                return false;
+            if( getIsClassifierSet() ){
+                batchPredictedClassLabels[i] = predictedClassLabel;
+                copyBatchResult( classifier->getClassLikelihoods(), i, batchClassLikelihoods );
+            }else{
+                if( i == 0 ) batchRegressionData.resize( numSamples, (UINT)regressionData.size() );
+                copyBatchResult( regressionData, i, batchRegressionData );
             }
-            predictedClassLabel = (UINT)contextModules[ END_OF_PIPELINE ][moduleIndex]->getProcessedData()[0];
         }
+        return true;
+    }
+
+    predictedClassLabel = 0;
+
+    //Perform any pre-processing and feature extraction
+    predictionModuleIndex = START_OF_PIPELINE;
+    const MatrixDouble *featureData = NULL;
+    if( !processBatchStages( inputData, featureData ) ){
+        return false;
     }
-    
+    predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
+
+    //Perform the classification or regression and any post processing
+    if( !predictBatchSamples( featureData, NULL, numSamples ) ){
+        return false;
+    }
+
+    predictionModuleIndex = END_OF_PIPELINE;
+
     return true;
 }
-    
-bool GestureRecognitionPipeline::predict_regressifier(VectorDouble inputVector){
-    
-    //Update the context module
+
+bool GestureRecognitionPipeline::predictBatch(const vector< MatrixDouble > &timeSeriesData){
+
+    batchPredictedClassLabels.clear();
+    batchClassLikelihoods.clear();
+    batchRegressionData.clear();
+
+    //Make sure the classification model has been trained
+    if( !trained ){
+        errorLog << "predictBatch(const vector< MatrixDouble > &timeSeriesData) - The classifier has not been trained" << endl;
+        return false;
+    }
+
+    if( !getIsClassifierSet() ){
+        errorLog << "predictBatch(const vector< MatrixDouble > &timeSeriesData) - A classifier has not been set" << endl;
+        return false;
+    }
+
+    const UINT numTimeSeries = (UINT)timeSeriesData.size();
+    if( numTimeSeries == 0 ){
+        errorLog << "predictBatch(const vector< MatrixDouble > &timeSeriesData) - The timeseries data is empty" << endl;
+        return false;
+    }
+
+    //Make sure the dimensionality of each timeseries matches the inputVectorDimensions
+    for(UINT i=0; i<numTimeSeries; i++){
+        if( timeSeriesData[i].getNumCols() != inputVectorDimensions ){
+            errorLog << "predictBatch(const vector< MatrixDouble > &timeSeriesData) - The dimensionality of timeseries " << i << " (" << timeSeriesData[i].getNumCols() << ") does not match that of the input vector dimensions of the pipeline (" << inputVectorDimensions << ")" << endl;
+            return false;
+        }
+    }
+
+    predictedClassLabel = 0;
+
+    //Perform any pre-processing and feature extraction, each timeseries is processed in order as the modules can have state
     predictionModuleIndex = START_OF_PIPELINE;
-    if( contextModules[ START_OF_PIPELINE ].size() ){
-        for(UINT moduleIndex=0; moduleIndex<contextModules[ START_OF_PIPELINE ].size(); moduleIndex++){
-            if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at START_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
+    const vector< MatrixDouble > *featureData = &timeSeriesData;
+    if( getIsPreProcessingSet() || getIsFeatureExtractionSet() ){
+        batchTimeSeriesData.resize( numTimeSeries );
+        for(UINT i=0; i<numTimeSeries; i++){
+            const MatrixDouble *processedData = NULL;
+            if( !processBatchStages( timeSeriesData[i], processedData ) ){
                 return false;
             }
-            if( !contextModules[ START_OF_PIPELINE ][moduleIndex]->getOK() ){
-                return true;
-            }
-            inputVector = contextModules[ START_OF_PIPELINE ][moduleIndex]->getProcessedData();
+            batchTimeSeriesData[i] = *processedData;
         }
+        featureData = &batchTimeSeriesData;
     }
-    
+    predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
+
+    //Perform the classification and any post processing
+    if( !predictBatchSamples( NULL, featureData, numTimeSeries ) ){
+        return false;
+    }
+
+    predictionModuleIndex = END_OF_PIPELINE;
+
+    return true;
+}
+
+bool GestureRecognitionPipeline::map(VectorDouble inputVector){
+    PredictionStages stages = getPredictionStages();
+    stages.classifier = NULL;
+	return predictStages( stages, inputVector );
+}
+
+bool GestureRecognitionPipeline::predictStages(PredictionStages &stages,const VectorDouble &inputVector){
+
+    ErrorLog &errorLog = stages.errorLog;
+    PipelineProfiler &profiler = stages.profiler;
+    const bool classificationMode = stages.classifier != NULL || stages.sharedClassifier != NULL;
+    if( classificationMode ) stages.predictedClassLabel = 0;
+
+    //The modules process the prediction buffer in place, so the buffer is not reallocated once the pipeline has warmed up
+    VectorDouble &data = stages.predictionBuffer;
+    data = inputVector;
+    bool okToContinue = true;
+
+    //Update the context module, if the context module stops the pipeline here the prediction is still OK
+    stages.predictionModuleIndex = START_OF_PIPELINE;
+    if( !processContextModules( stages, START_OF_PIPELINE, data, okToContinue ) ) return false;
+    if( !okToContinue ) return true;
+
     //Perform any pre-processing
-    if( getIsPreProcessingSet() ){
-        for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
-            if( !preProcessingModules[moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            inputVector = preProcessingModules[moduleIndex]->getProcessedData();
+    for(UINT moduleIndex=0; moduleIndex<stages.preProcessingModules.size(); moduleIndex++){
+        if( profiler.getEnabled() ) profiler.startStage();
+        if( !stages.preProcessingModules[moduleIndex]->processInPlace( data ) ){
+            errorLog << "predict(const VectorDouble &inputVector) - Failed to PreProcess Input Vector. PreProcessingModuleIndex: " << moduleIndex << endl;
+            return false;
         }
+        if( profiler.getEnabled() ) profiler.stopStage( PipelineProfiler::PREPROCESSING_STAGE, moduleIndex );
     }
-    
+
     //Update the context module
-    predictionModuleIndex = AFTER_PREPROCESSING;
-    if( contextModules[ AFTER_PREPROCESSING ].size() ){
-        for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_PREPROCESSING ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at AFTER_PREPROCESSING. ModuleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            if( !contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getOK() ){
-                predictionModuleIndex = AFTER_PREPROCESSING;
-                return false;
-            }
-            inputVector = contextModules[ AFTER_PREPROCESSING ][moduleIndex]->getProcessedData();
-        }
-    }
-    
+    stages.predictionModuleIndex = AFTER_PREPROCESSING;
+    if( !processContextModules( stages, AFTER_PREPROCESSING, data, okToContinue ) || !okToContinue ) return false;
+
     //Perform any feature extraction
-    if( getIsFeatureExtractionSet() ){
-        for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
-            if( !featureExtractionModules[moduleIndex]->computeFeatures( inputVector ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            inputVector = featureExtractionModules[moduleIndex]->getFeatureVector();
+    for(UINT moduleIndex=0; moduleIndex<stages.featureExtractionModules.size(); moduleIndex++){
+        if( profiler.getEnabled() ) profiler.startStage();
+        if( !stages.featureExtractionModules[moduleIndex]->computeFeaturesInPlace( data ) ){
+            errorLog << "predict(const VectorDouble &inputVector) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
+            return false;
         }
+        if( profiler.getEnabled() ) profiler.stopStage( PipelineProfiler::FEATURE_EXTRACTION_STAGE, moduleIndex );
     }
-    
+
     //Update the context module
-    predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
-    if( contextModules[ AFTER_FEATURE_EXTRACTION ].size() ){
-        for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_FEATURE_EXTRACTION ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at AFTER_FEATURE_EXTRACTION. ModuleIndex: " << moduleIndex << endl;
+    stages.predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
+    if( !processContextModules( stages, AFTER_FEATURE_EXTRACTION, data, okToContinue ) || !okToContinue ) return false;
+
+    if( classificationMode ){
+        //Perform the classification, a shared classifier is only read
+        if( profiler.getEnabled() ) profiler.startStage();
+        if( stages.classifier != NULL ){
+            if( !stages.classifier->predict( data ) ){
+                errorLog << "predict(const VectorDouble &inputVector) - Prediction Failed! " << stages.classifier->getLastErrorMessage() << endl;
                 return false;
             }
-            if( !contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getOK() ){
-                predictionModuleIndex = AFTER_FEATURE_EXTRACTION;
+            stages.predictedClassLabel = stages.classifier->getPredictedClassLabel();
+            if( stages.classificationResult != NULL ){
+                stages.classificationResult->predictedClassLabel = stages.predictedClassLabel;
+                stages.classificationResult->unprocessedPredictedClassLabel = stages.predictedClassLabel;
+                stages.classificationResult->maximumLikelihood = stages.classifier->getMaximumLikelihood();
+                stages.classificationResult->classLikelihoods = stages.classifier->getClassLikelihoods();
+                stages.classificationResult->classDistances = stages.classifier->getClassDistances();
+            }
+        }else{
+            if( !stages.sharedClassifier->predictStateless( data, *stages.classificationResult ) ){
+                errorLog << "predict(const VectorDouble &inputVector) - Prediction Failed! " << stages.sharedClassifier->getLastErrorMessage() << endl;
                 return false;
             }
-            inputVector = contextModules[ AFTER_FEATURE_EXTRACTION ][moduleIndex]->getProcessedData();
+            stages.predictedClassLabel = stages.classificationResult->predictedClassLabel;
+        }
+        if( profiler.getEnabled() ) profiler.stopStage( PipelineProfiler::CLASSIFIER_STAGE );
+
+        //Update the context module
+        VectorDouble &labelData = stages.postProcessingBuffer;
+        labelData.resize(1);
+        labelData[0] = stages.predictedClassLabel;
+        if( !processContextModules( stages, AFTER_CLASSIFIER, labelData, okToContinue ) ) return false;
+        if( !okToContinue ){
+            stages.predictionModuleIndex = AFTER_CLASSIFIER;
+            return false;
         }
+        stages.predictedClassLabel = (UINT)labelData[0];
+
+        //Perform any post processing
+        stages.predictionModuleIndex = AFTER_CLASSIFIER;
+        if( !postProcessPredictedClassLabel( stages ) ) return false;
+
+        //Update the context module
+        stages.predictionModuleIndex = END_OF_PIPELINE;
+        labelData.resize(1);
+        labelData[0] = stages.predictedClassLabel;
+        if( !processContextModules( stages, END_OF_PIPELINE, labelData, okToContinue ) || !okToContinue ) return false;
+        stages.predictedClassLabel = (UINT)labelData[0];
+
+        return true;
     }
-    
-    //Perform the regression
-    if( !regressifier->predict(inputVector) ){
-        errorLog << "predict_regressifier(VectorDouble inputVector) - Prediction Failed! " << regressifier->getLastErrorMessage() << endl;
-        return false;
+
+    //Perform the regression, a shared regressifier is only read
+    if( profiler.getEnabled() ) profiler.startStage();
+    if( stages.regressifier != NULL ){
+        if( !stages.regressifier->predict( data ) ){
+            errorLog << "predict(const VectorDouble &inputVector) - Prediction Failed! " << stages.regressifier->getLastErrorMessage() << endl;
+            return false;
+        }
+        stages.regressionData = stages.regressifier->getRegressionData();
+    }else{
+        if( !stages.sharedRegressifier->predictStateless( data, stages.regressionData ) ){
+            errorLog << "predict(const VectorDouble &inputVector) - Prediction Failed! " << stages.sharedRegressifier->getLastErrorMessage() << endl;
+            return false;
+        }
     }
-    regressionData = regressifier->getRegressionData();
-    
+    if( profiler.getEnabled() ) profiler.stopStage( PipelineProfiler::REGRESSIFIER_STAGE );
+    if( stages.unprocessedRegressionData != NULL ) *stages.unprocessedRegressionData = stages.regressionData;
+
     //Update the context module
-    if( contextModules[ AFTER_CLASSIFIER ].size() ){
-        for(UINT moduleIndex=0; moduleIndex<contextModules[ AFTER_CLASSIFIER ].size(); moduleIndex++){
-            if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->process( regressionData ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at AFTER_CLASSIFIER. ModuleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            if( !contextModules[ AFTER_CLASSIFIER ][moduleIndex]->getOK() ){
-                predictionModuleIndex = AFTER_CLASSIFIER;
-                return false;
-            }
-            regressionData = contextModules[ AFTER_CLASSIFIER ][moduleIndex]->getProcessedData();
-        }
+    if( !processContextModules( stages, AFTER_CLASSIFIER, stages.regressionData, okToContinue ) ) return false;
+    if( !okToContinue ){
+        stages.predictionModuleIndex = AFTER_CLASSIFIER;
+        return false;
     }
-    
+
     //Perform any post processing
-    predictionModuleIndex = AFTER_CLASSIFIER;
-    if( getIsPostProcessingSet() ){
-        
-        if( pipelineMode != REGRESSION_MODE ){
-            errorLog << "predict_regressifier(VectorDouble inputVector) - Pipeline Mode Is Not In RegressionMode!" << endl;
+    stages.predictionModuleIndex = AFTER_CLASSIFIER;
+    if( !postProcessRegressionData( stages ) ) return false;
+
+    //Update the context module, the END_OF_PIPELINE context modules are given the features (not the regression data)
+    stages.predictionModuleIndex = END_OF_PIPELINE;
+    if( stages.contextModules[ END_OF_PIPELINE ].size() > 0 ){
+        VectorDouble &contextData = stages.postProcessingBuffer;
+        contextData = data;
+        if( !processContextModules( stages, END_OF_PIPELINE, contextData, okToContinue ) || !okToContinue ) return false;
+        stages.regressionData = contextData;
+    }
+
+    return true;
+}
+
+bool GestureRecognitionPipeline::processContextModules(PredictionStages &stages,const UINT contextLevel,VectorDouble &data,bool &okToContinue){
+
+    PipelineProfiler &profiler = stages.profiler;
+    const vector< Context* > &modules = stages.contextModules[ contextLevel ];
+
+    okToContinue = true;
+    for(UINT moduleIndex=0; moduleIndex<modules.size(); moduleIndex++){
+        if( profiler.getEnabled() ) profiler.startStage();
+        if( !modules[moduleIndex]->process( data ) ){
+            stages.errorLog << "predict(const VectorDouble &inputVector) - Context Module Failed at context level " << contextLevel << ". ModuleIndex: " << moduleIndex << endl;
             return false;
         }
-          
-        for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
-            if( regressionData.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - The size of the regression vector (" << int(regressionData.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            
-            if( !postProcessingModules[moduleIndex]->process( regressionData ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            regressionData = postProcessingModules[moduleIndex]->getProcessedData();        
-        }
-        
-    } 
-    
-    //Update the context module
-    predictionModuleIndex = END_OF_PIPELINE;
-    if( contextModules[ END_OF_PIPELINE ].size() ){
-        for(UINT moduleIndex=0; moduleIndex<contextModules[ END_OF_PIPELINE ].size(); moduleIndex++){
-            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->process( inputVector ) ){
-                errorLog << "predict_regressifier(VectorDouble inputVector) - Context Module Failed at END_OF_PIPELINE. ModuleIndex: " << moduleIndex << endl;
-                return false;
-            }
-            if( !contextModules[ END_OF_PIPELINE ][moduleIndex]->getOK() ){
-                predictionModuleIndex = END_OF_PIPELINE;
-                return false;
-            }
-            regressionData = contextModules[ END_OF_PIPELINE ][moduleIndex]->getProcessedData();
+        if( profiler.getEnabled() ) profiler.stopStage( PipelineProfiler::CONTEXT_STAGE, moduleIndex, contextLevel );
+        if( !modules[moduleIndex]->getOK() ){
+            okToContinue = false;
+            return true;
         }
+        data = modules[moduleIndex]->getProcessedData();
     }
-    
     return true;
 }
+
+GestureRecognitionPipeline::PredictionStages GestureRecognitionPipeline::getPredictionStages(){
+    PredictionStages stages( preProcessingModules, featureExtractionModules, postProcessingModules, contextModules, predictionBuffer, postProcessingBuffer, predictionModuleIndex, predictedClassLabel, regressionData, profiler, errorLog );
+    stages.classifier = classifier;
+    stages.regressifier = regressifier;
+    return stages;
+}
     
 bool GestureRecognitionPipeline::reset(){
     
@@ -1770,64 +2172,60 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
         return false;
     }
 
+    FileTokenizer parser( file );
+
 	string word;
 	
 	//Load the file header
-	file >> word;
-	if( word != "GRT_PIPELINE_FILE_V1.0" ){
+	if( !parser.matchWord("GRT_PIPELINE_FILE_V1.0") ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read file header" << endl;
 		file.close();
         return false;
 	}
 	
 	//Load the pipeline mode
-	file >> word;
-	if( word != "PipelineMode:" ){
+	if( !parser.matchWord("PipelineMode:") ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read PipelineMode" << endl;
 		file.close();
         return false;
 	}
-	file >> word;
+	parser >> word;
 	pipelineMode = getPipelineModeFromString(word);
 	
 	//Load the NumPreprocessingModules
-	file >> word;
-	if( word != "NumPreprocessingModules:" ){
+	if( !parser.matchWord("NumPreprocessingModules:") ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read NumPreprocessingModules" << endl;
 		file.close();
         return false;
 	}
 	unsigned int numPreprocessingModules;
-	file >> numPreprocessingModules;
+	parser >> numPreprocessingModules;
 	
 	//Load the NumFeatureExtractionModules
-	file >> word;
-	if( word != "NumFeatureExtractionModules:" ){
+	if( !parser.matchWord("NumFeatureExtractionModules:") ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read NumFeatureExtractionModules" << endl;
 		file.close();
         return false;
 	}
 	unsigned int numFeatureExtractionModules;
-	file >> numFeatureExtractionModules;
+	parser >> numFeatureExtractionModules;
 	
 	//Load the NumPostprocessingModules
-	file >> word;
-	if( word != "NumPostprocessingModules:" ){
+	if( !parser.matchWord("NumPostprocessingModules:") ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read NumPostprocessingModules" << endl;
 		file.close();
         return false;
 	}
 	unsigned int numPostprocessingModules;
-	file >> numPostprocessingModules;
+	parser >> numPostprocessingModules;
 	
 	//Load if the pipeline has been trained
-	file >> word;
-	if( word != "Trained:" ){
+	if( !parser.matchWord("Trained:") ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read Trained" << endl;
 		file.close();
         return false;
 	}
-	file >> trained;
+	parser >> trained;
 	
 	//Resize the modules
 	if( numPreprocessingModules > 0 ) preProcessingModules.resize(numPreprocessingModules,NULL);
@@ -1835,14 +2233,13 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 	if( numPostprocessingModules > 0 ) postProcessingModules.resize(numPostprocessingModules,NULL);
 	
 	//Load the preprocessing module datatypes and initialize the modules
-	file >> word;
-	if( word != "PreProcessingModuleDatatypes:" ){
+	if( !parser.matchWord("PreProcessingModuleDatatypes:") ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read PreProcessingModuleDatatypes" << endl;
 		file.close();
         return false;
 	}
     for(UINT i=0; i<numPreprocessingModules; i++){
-		file >> word;
+		parser >> word;
 		preProcessingModules[i] = PreProcessing::createInstanceFromString( word );
 		if( preProcessingModules[i] == NULL ){
             errorLog << "loadPipelineFromFile(string filename) - Failed to create preprocessing instance from string: " << word << endl;
@@ -1852,14 +2249,13 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
     }
 
 	//Load the feature extraction module datatypes and initialize the modules
-	file >> word;
-	if( word != "FeatureExtractionModuleDatatypes:" ){
+	if( !parser.matchWord("FeatureExtractionModuleDatatypes:") ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read FeatureExtractionModuleDatatypes" << endl;
 		file.close();
         return false;
 	}
     for(UINT i=0; i<numFeatureExtractionModules; i++){
-		file >> word;
+		parser >> word;
 		featureExtractionModules[i] = FeatureExtraction::createInstanceFromString( word );
 		if( featureExtractionModules[i] == NULL ){
             errorLog << "loadPipelineFromFile(string filename) - Failed to create feature extraction instance from string: " << word << endl;
@@ -1872,14 +2268,13 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
         case PIPELINE_MODE_NOT_SET:
             break;
         case CLASSIFICATION_MODE:
-			file >> word;
-			if( word != "ClassificationModuleDatatype:" ){
+			if( !parser.matchWord("ClassificationModuleDatatype:") ){
                 errorLog << "loadPipelineFromFile(string filename) - Failed to read ClassificationModuleDatatype" << endl;
 				file.close();
 		        return false;
 			}
 			//Load the classifier type
-			file >> word;
+			parser >> word;
 			
 			//Initialize the classifier
 			classifier = Classifier::createInstanceFromString( word );
@@ -1890,14 +2285,13 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 			}
             break;
         case REGRESSION_MODE:
-			file >> word;
-			if( word != "RegressionnModuleDatatype:" ){
+			if( !parser.matchWord("RegressionnModuleDatatype:") ){
                 errorLog << "loadPipelineFromFile(string filename) - Failed to read RegressionnModuleDatatype" << endl;
 				file.close();
 		        return false;
 			}
 			//Load the regressifier type
-			file >> word;
+			parser >> word;
 			
 			//Initialize the regressifier
 			regressifier = Regressifier::createInstanceFromString( word );
@@ -1912,21 +2306,20 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
     }
 
 	//Load the post processing module datatypes and initialize the modules
-	file >> word;
-	if( word != "PostProcessingModuleDatatypes:" ){
+	if( !parser.matchWord("PostProcessingModuleDatatypes:") ){
         errorLog << "loadPipelineFromFile(string filename) - Failed to read PostProcessingModuleDatatypes" << endl;
 		file.close();
 	    return false;
 	}
 	for(UINT i=0; i<numPostprocessingModules; i++){
-		file >> word;
+		parser >> word;
 		postProcessingModules[i] = PostProcessing::createInstanceFromString( word );
 	}
 	
 	//Load the preprocessing module data from the file
     for(UINT i=0; i<numPreprocessingModules; i++){
 		//Load the preprocessing module header
-		file >> word;
+		parser >> word;
         if( !preProcessingModules[i]->loadSettingsFromFile( file ) ){
             errorLog << "Failed to load preprocessing module " << i << " settings from file!" << endl;
             file.close();
@@ -1937,7 +2330,7 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 	//Load the feature extraction module data from the file
 	for(UINT i=0; i<numFeatureExtractionModules; i++){
 		//Load the feature extraction module header
-		file >> word;
+		parser >> word;
 	    if( !featureExtractionModules[i]->loadSettingsFromFile( file ) ){
             errorLog << "Failed to load feature extraction module " << i << " settings from file!" << endl;
 	        file.close();
@@ -1970,7 +2363,7 @@ bool GestureRecognitionPipeline::loadPipelineFromFile(const string &filename){
 	//Load the post processing module data from the file
     for(UINT i=0; i<numPostprocessingModules; i++){
 		//Load the post processing module header
-		file >> word;
+		parser >> word;
         if( !postProcessingModules[i]->loadSettingsFromFile( file ) ){
             errorLog << "Failed to load post processing module " << i << " settings from file!" << endl;
             file.close();
@@ -2044,6 +2437,16 @@ bool GestureRecognitionPipeline::preProcessData(VectorDouble inputVector,bool co
     
     return true;
 }
+
+bool GestureRecognitionPipeline::enableProfiling(const bool useProfiling){
+    profiler.setEnabled( useProfiling );
+    if( useProfiling ) return setupProfiler();
+    return true;
+}
+
+bool GestureRecognitionPipeline::resetProfiling(){
+    return setupProfiler();
+}
  
 /////////////////////////////// GETTERS ///////////////////////////////
 bool GestureRecognitionPipeline::getIsInitialized() const{ 
@@ -2294,7 +2697,31 @@ VectorDouble GestureRecognitionPipeline::getUnProcessedRegressionData() const{
     }
     return VectorDouble();
 }
-    
+
+const vector< UINT >& GestureRecognitionPipeline::getBatchPredictedClassLabels() const{
+    return batchPredictedClassLabels;
+}
+
+const MatrixDouble& GestureRecognitionPipeline::getBatchClassLikelihoods() const{
+    return batchClassLikelihoods;
+}
+
+const MatrixDouble& GestureRecognitionPipeline::getBatchRegressionData() const{
+    return batchRegressionData;
+}
+
+bool GestureRecognitionPipeline::getIsProfilingEnabled() const{
+    return profiler.getEnabled();
+}
+
+const PipelineProfiler& GestureRecognitionPipeline::getProfiler() const{
+    return profiler;
+}
+
+PipelineProfiler& GestureRecognitionPipeline::getProfiler(){
+    return profiler;
+}
+
 VectorDouble GestureRecognitionPipeline::getPreProcessedData() const{
     if( getIsPreProcessingSet() ){ 
         return preProcessingModules[ preProcessingModules.size()-1 ]->getProcessedData(); 
@@ -2743,6 +3170,247 @@ bool GestureRecognitionPipeline::clearTestResults(){
 ///////////////////////////////////////////          PROTECTED FUNCTIONS              ///////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////// 
     
+bool GestureRecognitionPipeline::postProcessPredictedClassLabel(){
+
+    if( pipelineMode != CLASSIFICATION_MODE){
+        errorLog << "postProcessPredictedClassLabel() - Pipeline Mode Is Not in CLASSIFICATION_MODE!" << endl;
+        return false;
+    }
+
+    PredictionStages stages = getPredictionStages();
+    return postProcessPredictedClassLabel( stages );
+}
+
+bool GestureRecognitionPipeline::postProcessRegressionData(){
+
+    if( pipelineMode != REGRESSION_MODE ){
+        errorLog << "postProcessRegressionData() - Pipeline Mode Is Not In RegressionMode!" << endl;
+        return false;
+    }
+
+    PredictionStages stages = getPredictionStages();
+    return postProcessRegressionData( stages );
+}
+
+bool GestureRecognitionPipeline::postProcessPredictedClassLabel(PredictionStages &stages){
+
+    ErrorLog &errorLog = stages.errorLog;
+    PipelineProfiler &profiler = stages.profiler;
+    const vector< PostProcessing* > &postProcessingModules = stages.postProcessingModules;
+    VectorDouble &data = stages.postProcessingBuffer;
+    for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
+
+        //Select which input we should give the postprocessing module
+        if( postProcessingModules[moduleIndex]->getIsPostProcessingInputModePredictedClassLabel() ){
+            //Set the input
+            data.resize(1);
+            data[0] = stages.predictedClassLabel;
+
+            //Verify that the input size is OK
+            if( data.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
+                errorLog << "postProcessPredictedClassLabel() - The size of the data vector (" << int(data.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
+                return false;
+            }
+
+            //Postprocess the data
+            if( profiler.getEnabled() ) profiler.startStage();
+            if( !postProcessingModules[moduleIndex]->processInPlace( data ) ){
+                errorLog << "postProcessPredictedClassLabel() - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << endl;
+                return false;
+            }
+            if( profiler.getEnabled() ) profiler.stopStage( PipelineProfiler::POST_PROCESSING_STAGE, moduleIndex );
+        }
+
+        //Select which output we should update
+        if( postProcessingModules[moduleIndex]->getIsPostProcessingOutputModePredictedClassLabel() ){
+            //Get the processed predicted class label
+            data = postProcessingModules[moduleIndex]->getProcessedData();
+
+            //Verify that the output size is OK
+            if( data.size() != 1 ){
+                errorLog << "postProcessPredictedClassLabel() - The size of the processed data vector (" << int(data.size()) << ") from postProcessingModule at the moduleIndex: " << moduleIndex << " is not equal to 1 even though it is in OutputModePredictedClassLabel!" << endl;
+                return false;
+            }
+
+            //Update the predicted class label
+            stages.predictedClassLabel = (UINT)data[0];
+        }
+
+    }
+
+    return true;
+}
+
+bool GestureRecognitionPipeline::postProcessRegressionData(PredictionStages &stages){
+
+    ErrorLog &errorLog = stages.errorLog;
+    PipelineProfiler &profiler = stages.profiler;
+    const vector< PostProcessing* > &postProcessingModules = stages.postProcessingModules;
+    VectorDouble &regressionData = stages.regressionData;
+    for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
+        if( regressionData.size() != postProcessingModules[moduleIndex]->getNumInputDimensions() ){
+            errorLog << "postProcessRegressionData() - The size of the regression vector (" << int(regressionData.size()) << ") does not match that of the postProcessingModule (" << postProcessingModules[moduleIndex]->getNumInputDimensions() << ") at the moduleIndex: " << moduleIndex << endl;
+            return false;
+        }
+
+        if( profiler.getEnabled() ) profiler.startStage();
+        if( !postProcessingModules[moduleIndex]->processInPlace( regressionData ) ){
+            errorLog << "postProcessRegressionData() - Failed to post process data. PostProcessing moduleIndex: " << moduleIndex << endl;
+            return false;
+        }
+        if( profiler.getEnabled() ) profiler.stopStage( PipelineProfiler::POST_PROCESSING_STAGE, moduleIndex );
+    }
+
+    return true;
+}
+
+bool GestureRecognitionPipeline::processBatchStages(const MatrixDouble &inputData,const MatrixDouble *&featureData){
+
+    //Each stage reads the output of the previous stage and writes to the other stage buffer, so the same two buffers are used by every stage
+    const UINT numSamples = inputData.getNumRows();
+    const MatrixDouble *stageInput = &inputData;
+    UINT bufferIndex = 0;
+
+    for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
+        MatrixDouble &stageOutput = batchStageBuffers[ bufferIndex ];
+        if( !resizeBatchBuffer( stageOutput, numSamples, preProcessingModules[moduleIndex]->getNumOutputDimensions() ) ){
+            errorLog << "processBatchStages(const MatrixDouble &inputData,const MatrixDouble *&featureData) - Failed to resize the stage buffer. PreProcessingModuleIndex: " << moduleIndex << endl;
+            return false;
+        }
+        for(UINT i=0; i<numSamples; i++){
+            copyBatchRow( *stageInput, i, batchRowBuffer );
+            if( !preProcessingModules[moduleIndex]->process( batchRowBuffer ) ){
+                errorLog << "processBatchStages(const MatrixDouble &inputData,const MatrixDouble *&featureData) - Failed to PreProcess Input Data. PreProcessingModuleIndex: " << moduleIndex << endl;
+                return false;
+            }
+            if( !stageOutput.setRowVector( preProcessingModules[moduleIndex]->getProcessedData(), i ) ){
+                errorLog << "processBatchStages(const MatrixDouble &inputData,const MatrixDouble *&featureData) - The size of the processed data does not match the output dimensions of the PreProcessingModule. PreProcessingModuleIndex: " << moduleIndex << endl;
+                return false;
+            }
+        }
+        stageInput = &stageOutput;
+        bufferIndex = 1 - bufferIndex;
+    }
+
+    for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+        MatrixDouble &stageOutput = batchStageBuffers[ bufferIndex ];
+        if( !resizeBatchBuffer( stageOutput, numSamples, featureExtractionModules[moduleIndex]->getNumOutputDimensions() ) ){
+            errorLog << "processBatchStages(const MatrixDouble &inputData,const MatrixDouble *&featureData) - Failed to resize the stage buffer. FeatureExtractionModuleIndex: " << moduleIndex << endl;
+            return false;
+        }
+        for(UINT i=0; i<numSamples; i++){
+            copyBatchRow( *stageInput, i, batchRowBuffer );
+            if( !featureExtractionModules[moduleIndex]->computeFeatures( batchRowBuffer ) ){
+                errorLog << "processBatchStages(const MatrixDouble &inputData,const MatrixDouble *&featureData) - Failed to compute features from data. FeatureExtractionModuleIndex: " << moduleIndex << endl;
+                return false;
+            }
+            if( !stageOutput.setRowVector( featureExtractionModules[moduleIndex]->getFeatureVector(), i ) ){
+                errorLog << "processBatchStages(const MatrixDouble &inputData,const MatrixDouble *&featureData) - The size of the feature vector does not match the output dimensions of the FeatureExtractionModule. FeatureExtractionModuleIndex: " << moduleIndex << endl;
+                return false;
+            }
+        }
+        stageInput = &stageOutput;
+        bufferIndex = 1 - bufferIndex;
+    }
+
+    featureData = stageInput;
+
+    return true;
+}
+
+bool GestureRecognitionPipeline::predictBatchSamples(const MatrixDouble *inputData,const vector< MatrixDouble > *timeSeriesData,const UINT numSamples){
+
+    //Perform the classification or regression
+    if( getIsClassifierSet() ){
+        batchPredictedClassLabels.resize( numSamples, 0 );
+        resizeBatchBuffer( batchClassLikelihoods, numSamples, classifier->getNumClasses() );
+        if( !predictBatchWithModel( classifier, inputData, timeSeriesData, numSamples, batchClassLikelihoods, batchPredictedClassLabels ) ){
+            errorLog << "predictBatchSamples(...) - Prediction Failed! " << classifier->getLastErrorMessage() << endl;
+            return false;
+        }
+    }else{
+        resizeBatchBuffer( batchRegressionData, numSamples, regressifier->getNumOutputDimensions() );
+        if( !predictBatchWithModel( regressifier, inputData, timeSeriesData, numSamples, batchRegressionData, batchPredictedClassLabels ) ){
+            errorLog << "predictBatchSamples(...) - Prediction Failed! " << regressifier->getLastErrorMessage() << endl;
+            return false;
+        }
+    }
+
+    //Perform any post processing, each sample is processed in order as the post processing modules can have state
+    predictionModuleIndex = AFTER_CLASSIFIER;
+    if( getIsClassifierSet() ){
+        for(UINT i=0; i<numSamples; i++){
+            predictedClassLabel = batchPredictedClassLabels[i];
+            if( getIsPostProcessingSet() ){
+                if( !postProcessPredictedClassLabel() ){
+                    return false;
+                }
+                batchPredictedClassLabels[i] = predictedClassLabel;
+            }
+        }
+        return true;
+    }
+
+    if( !getIsPostProcessingSet() ){
+        regressionData = batchRegressionData.getRowVector( numSamples-1 );
+        return true;
+    }
+
+    MatrixDouble processedData;
+    for(UINT i=0; i<numSamples; i++){
+        copyBatchRow( batchRegressionData, i, regressionData );
+        if( !postProcessRegressionData() ){
+            return false;
+        }
+        if( i == 0 ) processedData.resize( numSamples, (UINT)regressionData.size() );
+        copyBatchResult( regressionData, i, processedData );
+    }
+    batchRegressionData = processedData;
+
+    return true;
+}
+
+bool GestureRecognitionPipeline::setupProfiler(){
+    return setupProfiler( profiler );
+}
+
+bool GestureRecognitionPipeline::setupProfiler(PipelineProfiler &profiler) const{
+
+    //The stages are stored in the order they are run, after the stage for the whole prediction
+    vector< PipelineStageProfile > stages;
+    stages.push_back( PipelineStageProfile( "Prediction", PipelineProfiler::PREDICTION_STAGE ) );
+
+    for(UINT i=0; i<contextModules[ START_OF_PIPELINE ].size(); i++)
+        stages.push_back( PipelineStageProfile( "Context:" + contextModules[ START_OF_PIPELINE ][i]->getContextType(), PipelineProfiler::CONTEXT_STAGE, i, START_OF_PIPELINE ) );
+    for(UINT i=0; i<preProcessingModules.size(); i++)
+        stages.push_back( PipelineStageProfile( "PreProcessing:" + preProcessingModules[i]->getPreProcessingType(), PipelineProfiler::PREPROCESSING_STAGE, i ) );
+    for(UINT i=0; i<contextModules[ AFTER_PREPROCESSING ].size(); i++)
+        stages.push_back( PipelineStageProfile( "Context:" + contextModules[ AFTER_PREPROCESSING ][i]->getContextType(), PipelineProfiler::CONTEXT_STAGE, i, AFTER_PREPROCESSING ) );
+    for(UINT i=0; i<featureExtractionModules.size(); i++)
+        stages.push_back( PipelineStageProfile( "FeatureExtraction:" + featureExtractionModules[i]->getFeatureExtractionType(), PipelineProfiler::FEATURE_EXTRACTION_STAGE, i ) );
+    for(UINT i=0; i<contextModules[ AFTER_FEATURE_EXTRACTION ].size(); i++)
+        stages.push_back( PipelineStageProfile( "Context:" + contextModules[ AFTER_FEATURE_EXTRACTION ][i]->getContextType(), PipelineProfiler::CONTEXT_STAGE, i, AFTER_FEATURE_EXTRACTION ) );
+    if( getIsClassifierSet() )
+        stages.push_back( PipelineStageProfile( "Classifier:" + classifier->getClassifierType(), PipelineProfiler::CLASSIFIER_STAGE ) );
+    if( getIsRegressifierSet() )
+        stages.push_back( PipelineStageProfile( "Regressifier:" + regressifier->getRegressifierType(), PipelineProfiler::REGRESSIFIER_STAGE ) );
+    for(UINT i=0; i<contextModules[ AFTER_CLASSIFIER ].size(); i++)
+        stages.push_back( PipelineStageProfile( "Context:" + contextModules[ AFTER_CLASSIFIER ][i]->getContextType(), PipelineProfiler::CONTEXT_STAGE, i, AFTER_CLASSIFIER ) );
+    for(UINT i=0; i<postProcessingModules.size(); i++)
+        stages.push_back( PipelineStageProfile( "PostProcessing:" + postProcessingModules[i]->getPostProcessingType(), PipelineProfiler::POST_PROCESSING_STAGE, i ) );
+    for(UINT i=0; i<contextModules[ END_OF_PIPELINE ].size(); i++)
+        stages.push_back( PipelineStageProfile( "Context:" + contextModules[ END_OF_PIPELINE ][i]->getContextType(), PipelineProfiler::CONTEXT_STAGE, i, END_OF_PIPELINE ) );
+
+    return profiler.setStages( stages );
+}
+
+UINT GestureRecognitionPipeline::getNumProfilerStages() const{
+    UINT numStages = 1 + (UINT)(preProcessingModules.size() + featureExtractionModules.size() + postProcessingModules.size());
+    if( getIsClassifierSet() || getIsRegressifierSet() ) numStages++;
+    for(UINT i=0; i<contextModules.size(); i++) numStages += (UINT)contextModules[i].size();
+    return numStages;
+}
+
 void GestureRecognitionPipeline::deleteAllPreProcessingModules(){
     if( preProcessingModules.size() != 0 ){
         for(UINT i=0; i<preProcessingModules.size(); i++){
@@ -37,9 +37,11 @@
 #include "Regressifier.h"
 #include "PostProcessing.h"
 #include "Context.h"
+#include "PipelineProfiler.h"
 #include "../DataStructures/LabelledContinuousTimeSeriesClassificationData.h"
 #include "../Util/ClassificationResult.h"
 #include "../Util/TestResult.h"
+#include "../Util/ParallelFor.h"
 
 namespace GRT{
     
@@ -79,11 +81,26 @@ public:
 	*/
     bool train(const LabelledClassificationData &trainingData);
 
+    /**
+     This is the training interface for training a Classifier with a LabelledClassificationDataView, such as the training fold of a dataset.
+     If the pipeline has no PreProcessing or FeatureExtraction modules then the view is passed straight to the Classification module,
+     otherwise the samples in the view are processed into a new dataset, in the same way as the train(const LabelledClassificationData &trainingData) function.
+
+     @param const LabelledClassificationDataView &trainingData: the view of the labelled classification training data that will be used to train the classifier at the core of the pipeline
+     @return bool returns true if the classifier was trained successfully, false otherwise
+     */
+    bool train(const LabelledClassificationDataView &trainingData);
+
 	/**
      This is the main training interface for training a Classifier with LabelledClassificationData using K-fold cross validation.  This function will pass 
      the trainingData through any PreProcessing or FeatureExtraction modules that have been added to the GestureRecognitionPipeline, and then calls the 
      training function of the Classification module that has been added to the GestureRecognitionPipeline.  
      The function will return true if the classifier was trained successfully, false otherwise.
+     
+     The folds are run in parallel (see ParallelFor), each thread training and testing its own copy of the pipeline. The training and
+     test data of each fold are views of the trainingData (see LabelledClassificationDataView), so the folds are not copied. Once all the
+     folds are complete the pipeline will contain the model trained on the last fold, and the results of each fold (in fold order)
+     can be accessed with getCrossValidationResults().
 
 	@param LabelledClassificationData trainingData: the labelled classification training data that will be used to train the classifier at the core of the pipeline
 	@param const UINT kFoldValue: the number of cross validation folds, this should be a value between in the range of [1 M-1], where M is the number of training samples int the LabelledClassificationData
@@ -108,6 +125,8 @@ public:
      This function will pass the trainingData through any PreProcessing or FeatureExtraction modules that have been added to the GestureRecognitionPipeline, and then calls the training function of the Classification module that has been added to the GestureRecognitionPipeline.
      The function will return true if the classifier was trained successfully, false otherwise.
      
+     The folds are run in parallel, in the same way as the LabelledClassificationData k-fold training function.
+     
      @param LabelledTimeSeriesClassificationData trainingData: the labelled time-series classification training data that will be used to train the classifier at the core of the pipeline
      @param const UINT kFoldValue: the number of cross validation folds, this should be a value between in the range of [1 M-1], where M is the number of training samples in the LabelledClassificationData
      @param const bool useStratifiedSampling: sets if stratified sampling should be used during the cross validation training
@@ -132,6 +151,8 @@ public:
      training function of the Regression module that has been added to the GestureRecognitionPipeline.
      The function will return true if the regressifier was trained successfully, false otherwise.
      
+     The folds are run in parallel, in the same way as the LabelledClassificationData k-fold training function.
+     
      @param LabelledRegressionData trainingData: the labelled regression training data that will be used to train the regressifier at the core of the pipeline
      @param const UINT kFoldValue: the number of cross validation folds, this should be a value between in the range of [1 M-1], where M is the number of training samples in the LabelledRegressionData
      @return bool returns true if the regressifier was trained and tested successfully, false otherwise
@@ -149,6 +170,15 @@ public:
 	*/
     bool test(const LabelledClassificationData &testData);
 
+    /**
+     This function is the interface for testing the accuracy of a pipeline with a LabelledClassificationDataView, such as the test fold of a dataset.
+     Each sample in the view is tested once, any weights in the view are ignored.
+
+     @param const LabelledClassificationDataView &testData: the view of the labelled classification data that will be used to test the accuracy of the pipeline
+     @return bool returns true if the pipeline was tested successfully, false otherwise
+     */
+    bool test(const LabelledClassificationDataView &testData);
+
     /**
      This function is the main interface for testing the accuracy of a pipeline with LabelledTimeSeriesClassificationData.  This function will pass
      the testData through any PreProcessing or FeatureExtraction modules that have been added to the GestureRecognitionPipeline, and then calls the 
@@ -181,6 +211,17 @@ public:
      @return bool returns true if the pipeline was tested successfully, false otherwise
 	*/
     bool test(LabelledRegressionData testData);
+
+    /**
+     This function tests the pipeline with a binary dataset file, which is read one chunk at a time so datasets that are larger than the
+     available memory can be tested. The file can contain labelled classification, time series, continuous time series or regression data.
+     To keep the memory used by the test bounded, the results of each test sample are passed to any test observers but are not stored,
+     so getTestInstanceResults() will be empty after this test. All the other test metrics are computed as they are for the in-memory datasets.
+
+     @param BinaryDatasetReader &testData: an open reader of the binary dataset file that will be used to test the pipeline, it will be reset before the test
+     @return bool returns true if the pipeline was tested successfully, false otherwise
+     */
+    bool test(BinaryDatasetReader &testData);
     
     /**
      This function is the main interface for all predictions using the gesture recognition pipeline.  You can use this function for both classification
@@ -200,6 +241,30 @@ public:
      */
     bool predict(MatrixDouble inputMatrix);
 
+    /**
+     This function predicts a batch of samples, where each row of the input matrix is one sample. The results are the same as calling
+     predict(const VectorDouble &inputVector) on each row in order, but each stage of the pipeline processes the whole batch at once
+     using buffers that are reused between calls. The pre-processing, feature-extraction and post-processing modules are run over the
+     samples in order (as they can have state), the classifier or regressifier is run in parallel (see ParallelFor) if its predictions
+     are stateless (see MLBase::getIsPredictionStateless), with all the threads sharing the one model. If the pipeline has any context modules then the samples are passed through predict one at a time.
+
+     After the batch has been predicted the pipeline is in the same state as it would be after predicting the last sample, and the
+     results for all the samples can be accessed with getBatchPredictedClassLabels, getBatchClassLikelihoods or getBatchRegressionData.
+
+     @param const MatrixDouble &inputData: the samples that will be passed through the pipeline, one sample per row
+     @return bool returns true if all the samples were predicted successfully, false otherwise
+     */
+    bool predictBatch(const MatrixDouble &inputData);
+
+    /**
+     This function predicts a batch of timeseries, the results are the same as calling predict(MatrixDouble inputMatrix) on each
+     timeseries in order. The timeseries are passed through the classifier in order, as the timeseries classifiers can have state.
+
+     @param const vector< MatrixDouble > &timeSeriesData: the timeseries that will be passed through the pipeline for classification
+     @return bool returns true if all the timeseries were predicted successfully, false otherwise
+     */
+    bool predictBatch(const vector< MatrixDouble > &timeSeriesData);
+
     /**
      This function is now depreciated, you should use the predict function instead.
 
@@ -250,6 +315,23 @@ public:
      @return bool returns true if the data was passed through the preprocessing modules successful, false otherwise
 	*/
     bool preProcessData(VectorDouble inputVector,bool computeFeatures = true);
+
+    /**
+     This function turns the profiling of the pipeline on or off. When profiling is on, the pipeline records the latency of each module
+     (and of the whole prediction) every time predict(const VectorDouble &inputVector) is called. The results can be accessed with getProfiler().
+     Turning profiling on removes any previous results.
+
+     @param const bool useProfiling: true if the pipeline should be profiled
+     @return bool returns true if the value was set, false otherwise
+	*/
+    bool enableProfiling(const bool useProfiling);
+
+    /**
+     This function removes all the profiling results, the profiler is rebuilt to match the current modules of the pipeline.
+
+     @return bool returns true if the profiling results were reset, false otherwise
+	*/
+    bool resetProfiling();
     
     /**
     This function returns true if the pipeline has been initialized.  The pipeline is initialized if either a classifier or regressifier module has been set at the core of the pipeline.
@@ -590,6 +672,50 @@ public:
      */
     VectorDouble getUnProcessedRegressionData() const;
 
+    /**
+     Gets the predicted class labels from the most recent predictBatch call, there will be one label for each sample in the batch.
+
+     @return returns a reference to the predicted class labels from the last batch, this will be empty if the last batch was not classified
+     */
+    const vector< UINT >& getBatchPredictedClassLabels() const;
+
+    /**
+     Gets the class likelihoods from the most recent predictBatch call, this will be an [M N] matrix, where M is the number of samples in
+     the batch and N is the number of classes in the model. These are the likelihoods output by the classifier, before any post processing.
+
+     @return returns a reference to the class likelihoods from the last batch, this will be empty if the last batch was not classified
+     */
+    const MatrixDouble& getBatchClassLikelihoods() const;
+
+    /**
+     Gets the regression data output by the pipeline for the most recent predictBatch call, this will be an [M N] matrix, where M is the
+     number of samples in the batch and N is the number of output dimensions of the pipeline.
+
+     @return returns a reference to the regression data from the last batch, this will be empty if the last batch was not a regression batch
+     */
+    const MatrixDouble& getBatchRegressionData() const;
+
+    /**
+     Gets if the pipeline is being profiled, see enableProfiling(...).
+
+     @return returns true if the pipeline is being profiled, false otherwise
+     */
+    bool getIsProfilingEnabled() const;
+
+    /**
+     Gets the profiler of the pipeline, this holds the latency of each module in the pipeline (see PipelineProfiler).
+
+     @return returns a reference to the profiler
+     */
+    const PipelineProfiler& getProfiler() const;
+
+    /**
+     Gets the profiler of the pipeline, this can be used to set the periodic dump of the profiling results (see PipelineProfiler::setDumpInterval).
+
+     @return returns a reference to the profiler
+     */
+    PipelineProfiler& getProfiler();
+
     /**
      Gets a vector containing the output of the last preprocessing module, this will be an M-dimensional vector, where M is the output size of the last preprocessing module.  
      
@@ -979,8 +1105,49 @@ public:
     bool clearTestResults();
 
 protected:
-    bool predict_classifier(VectorDouble inputVector);
-    bool predict_regressifier(VectorDouble inputVector);
+    /**
+     Holds the modules, buffers and outputs that one stream of real-time data is run through by predictStages(...). The pipeline
+     fills this with its own members, and each GestureRecognitionPipelineSession fills it with its copies of the modules.
+     */
+    class PredictionStages{
+    public:
+        PredictionStages(vector< PreProcessing* > &preProcessingModules,vector< FeatureExtraction* > &featureExtractionModules,vector< PostProcessing* > &postProcessingModules,vector< vector< Context* > > &contextModules,VectorDouble &predictionBuffer,VectorDouble &postProcessingBuffer,UINT &predictionModuleIndex,UINT &predictedClassLabel,VectorDouble &regressionData,PipelineProfiler &profiler,ErrorLog &errorLog):
+            preProcessingModules(preProcessingModules),featureExtractionModules(featureExtractionModules),postProcessingModules(postProcessingModules),contextModules(contextModules),
+            predictionBuffer(predictionBuffer),postProcessingBuffer(postProcessingBuffer),predictionModuleIndex(predictionModuleIndex),predictedClassLabel(predictedClassLabel),
+            regressionData(regressionData),profiler(profiler),errorLog(errorLog),classifier(NULL),sharedClassifier(NULL),regressifier(NULL),sharedRegressifier(NULL),
+            classificationResult(NULL),unprocessedRegressionData(NULL){}
+
+        vector< PreProcessing* > &preProcessingModules;
+        vector< FeatureExtraction* > &featureExtractionModules;
+        vector< PostProcessing* > &postProcessingModules;
+        vector< vector< Context* > > &contextModules;
+        VectorDouble &predictionBuffer;                     ///< The buffer the input is copied to and then processed in place
+        VectorDouble &postProcessingBuffer;                 ///< The buffer used to pass the predicted class label to the post processing and context modules
+        UINT &predictionModuleIndex;
+        UINT &predictedClassLabel;
+        VectorDouble &regressionData;
+        PipelineProfiler &profiler;
+        ErrorLog &errorLog;
+        Classifier *classifier;                             ///< A classifier that is run with predict(...), NULL if the sharedClassifier is used
+        const Classifier *sharedClassifier;                 ///< A classifier that is only read with predictStateless(...), this needs the classificationResult
+        Regressifier *regressifier;                         ///< A regressifier that is run with predict(...), NULL if the sharedRegressifier is used
+        const Regressifier *sharedRegressifier;             ///< A regressifier that is only read with predictStateless(...)
+        ClassificationResult *classificationResult;         ///< If not NULL, this is set to the output of the classifier
+        VectorDouble *unprocessedRegressionData;            ///< If not NULL, this is set to the output of the regressifier
+    };
+
+    static bool predictStages(PredictionStages &stages,const VectorDouble &inputVector);
+    static bool processContextModules(PredictionStages &stages,const UINT contextLevel,VectorDouble &data,bool &okToContinue);
+    static bool postProcessPredictedClassLabel(PredictionStages &stages);
+    static bool postProcessRegressionData(PredictionStages &stages);
+    PredictionStages getPredictionStages();
+    bool postProcessPredictedClassLabel();
+    bool postProcessRegressionData();
+    bool processBatchStages(const MatrixDouble &inputData,const MatrixDouble *&featureData);
+    bool predictBatchSamples(const MatrixDouble *inputData,const vector< MatrixDouble > *timeSeriesData,const UINT numSamples);
+    bool setupProfiler();
+    bool setupProfiler(PipelineProfiler &profiler) const;
+    UINT getNumProfilerStages() const;
     void deleteAllPreProcessingModules();
     void deleteAllFeatureExtractionModules();
     void deleteClassifier();
@@ -1013,7 +1180,16 @@ protected:
     MatrixDouble testConfusionMatrix;
     vector< TestResult > crossValidationResults;
     vector< TestInstanceResult > testResults;
-    
+    vector< UINT > batchPredictedClassLabels;
+    MatrixDouble batchClassLikelihoods;
+    MatrixDouble batchRegressionData;
+    MatrixDouble batchStageBuffers[2];
+    vector< MatrixDouble > batchTimeSeriesData;
+    VectorDouble batchRowBuffer;
+    VectorDouble predictionBuffer;
+    VectorDouble postProcessingBuffer;
+    PipelineProfiler profiler;
+
     vector< PreProcessing* > preProcessingModules;
     vector< FeatureExtraction* > featureExtractionModules;
     Classifier *classifier;
@@ -1022,6 +1198,8 @@ protected:
     vector< vector< Context* > > contextModules;
     
     enum PipelineModes{PIPELINE_MODE_NOT_SET=0,CLASSIFICATION_MODE,REGRESSION_MODE};
+
+    friend class GestureRecognitionPipelineSession;
     
 public:
     enum ContextLevels{START_OF_PIPELINE=0,AFTER_PREPROCESSING,AFTER_FEATURE_EXTRACTION,AFTER_CLASSIFIER,END_OF_PIPELINE,NUM_CONTEXT_LEVELS};
@@ -0,0 +1,341 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GestureRecognitionPipelineSession.h"
+
+namespace GRT{
+
+//Creates a copy of a preprocessing, feature extraction, post processing or context module (including its current state)
+template< class T >
+static T* cloneSessionModule(const T *module){
+    T *newInstance = module->createNewInstance();
+    if( newInstance == NULL ) return NULL;
+    if( !newInstance->clone( module ) ){
+        delete newInstance;
+        return NULL;
+    }
+    return newInstance;
+}
+
+//Creates a deep copy of a classifier or regressifier
+template< class T >
+static T* deepCopySessionModel(const T *model){
+    T *newInstance = model->createNewInstance();
+    if( newInstance == NULL ) return NULL;
+    if( !newInstance->deepCopyFrom( model ) ){
+        delete newInstance;
+        return NULL;
+    }
+    return newInstance;
+}
+
+template< class T >
+static void deleteSessionModules(vector< T* > &modules){
+    for(UINT i=0; i<modules.size(); i++){
+        delete modules[i];
+        modules[i] = NULL;
+    }
+    modules.clear();
+}
+
+GestureRecognitionPipelineSession::GestureRecognitionPipelineSession(const GestureRecognitionPipeline &pipeline){
+
+    this->pipeline = &pipeline;
+    predictionModuleIndex = 0;
+    predictedClassLabel = 0;
+    classifier = NULL;
+    regressifier = NULL;
+    contextModules.resize( GestureRecognitionPipeline::NUM_CONTEXT_LEVELS );
+
+    debugLog.setProceedingText("[DEBUG GRPSession]");
+    errorLog.setProceedingText("[ERROR GRPSession]");
+    warningLog.setProceedingText("[WARNING GRPSession]");
+
+    //The session only owns a copy of the model if the model can not be shared
+    const Classifier *sessionClassifier = NULL;
+    const Regressifier *sessionRegressifier = NULL;
+    if( pipeline.getIsClassifierSet() && !pipeline.classifier->getIsPredictionStateless() ) sessionClassifier = pipeline.classifier;
+    if( pipeline.getIsRegressifierSet() && !pipeline.regressifier->getIsPredictionStateless() ) sessionRegressifier = pipeline.regressifier;
+
+    if( !copyModules( pipeline.preProcessingModules, pipeline.featureExtractionModules, sessionClassifier, sessionRegressifier, pipeline.postProcessingModules, pipeline.contextModules ) ){
+        errorLog << "GestureRecognitionPipelineSession(const GestureRecognitionPipeline &pipeline) - Failed to copy the modules of the pipeline!" << endl;
+    }
+}
+
+GestureRecognitionPipelineSession::GestureRecognitionPipelineSession(const GestureRecognitionPipelineSession &rhs){
+
+    pipeline = NULL;
+    predictionModuleIndex = 0;
+    predictedClassLabel = 0;
+    classifier = NULL;
+    regressifier = NULL;
+    contextModules.resize( GestureRecognitionPipeline::NUM_CONTEXT_LEVELS );
+
+    debugLog.setProceedingText("[DEBUG GRPSession]");
+    errorLog.setProceedingText("[ERROR GRPSession]");
+    warningLog.setProceedingText("[WARNING GRPSession]");
+
+    *this = rhs;
+}
+
+GestureRecognitionPipelineSession::~GestureRecognitionPipelineSession(void){
+    clear();
+}
+
+GestureRecognitionPipelineSession& GestureRecognitionPipelineSession::operator=(const GestureRecognitionPipelineSession &rhs){
+
+    if( this != &rhs ){
+        clear();
+
+        this->pipeline = rhs.pipeline;
+        this->predictionModuleIndex = rhs.predictionModuleIndex;
+        this->predictedClassLabel = rhs.predictedClassLabel;
+        this->classificationResult = rhs.classificationResult;
+        this->regressionData = rhs.regressionData;
+        this->unprocessedRegressionData = rhs.unprocessedRegressionData;
+        this->profiler = rhs.profiler;
+
+        //Copy the GRT Base variables
+        this->debugLog = rhs.debugLog;
+        this->errorLog = rhs.errorLog;
+        this->warningLog = rhs.warningLog;
+
+        if( !copyModules( rhs.preProcessingModules, rhs.featureExtractionModules, rhs.classifier, rhs.regressifier, rhs.postProcessingModules, rhs.contextModules ) ){
+            errorLog << "operator=(const GestureRecognitionPipelineSession &rhs) - Failed to copy the modules of the session!" << endl;
+        }
+    }
+
+    return *this;
+}
+
+bool GestureRecognitionPipelineSession::predict(const VectorDouble &inputVector){
+
+    if( pipeline == NULL || !pipeline->getTrained() ){
+        errorLog << "predict(const VectorDouble &inputVector) - The pipeline has not been trained" << endl;
+        return false;
+    }
+
+    if( inputVector.size() != pipeline->getInputVectorDimensionsSize() ){
+        errorLog << "predict(const VectorDouble &inputVector) - The dimensionality of the input vector (" << int(inputVector.size()) << ") does not match that of the input vector dimensions of the pipeline (" << pipeline->getInputVectorDimensionsSize() << ")" << endl;
+        return false;
+    }
+
+    if( !pipeline->getIsClassifierSet() && !pipeline->getIsRegressifierSet() ){
+        errorLog << "predict(const VectorDouble &inputVector) - Neither a classifier or regressifer is not set" << endl;
+        return false;
+    }
+
+    //The session runs its own copies of the modules through the same stages as the pipeline, a shared model is only read
+    GestureRecognitionPipeline::PredictionStages stages( preProcessingModules, featureExtractionModules, postProcessingModules, contextModules, predictionBuffer, postProcessingBuffer, predictionModuleIndex, predictedClassLabel, regressionData, profiler, errorLog );
+    if( pipeline->getIsClassifierSet() ){
+        stages.classifier = classifier;
+        if( classifier == NULL ) stages.sharedClassifier = pipeline->classifier;
+        stages.classificationResult = &classificationResult;
+    }else{
+        stages.regressifier = regressifier;
+        if( regressifier == NULL ) stages.sharedRegressifier = pipeline->regressifier;
+        stages.unprocessedRegressionData = &unprocessedRegressionData;
+    }
+
+    if( profiler.getEnabled() ){
+        if( profiler.getNumStages() != pipeline->getNumProfilerStages() ) pipeline->setupProfiler( profiler );
+        profiler.startPrediction();
+    }
+
+    const bool predictionResult = GestureRecognitionPipeline::predictStages( stages, inputVector );
+
+    if( profiler.getEnabled() ) profiler.stopPrediction();
+    return predictionResult;
+}
+
+bool GestureRecognitionPipelineSession::reset(){
+
+    for(UINT moduleIndex=0; moduleIndex<preProcessingModules.size(); moduleIndex++){
+        if( !preProcessingModules[ moduleIndex ]->reset() ){
+            errorLog << "reset() - Failed To Reset PreProcessingModule " << moduleIndex << endl;
+            return false;
+        }
+    }
+
+    for(UINT moduleIndex=0; moduleIndex<featureExtractionModules.size(); moduleIndex++){
+        if( !featureExtractionModules[ moduleIndex ]->reset() ){
+            errorLog << "reset() - Failed To Reset FeatureExtractionModule " << moduleIndex << endl;
+            return false;
+        }
+    }
+
+    //A shared model is never changed by the session, so only a model owned by the session needs to be reset
+    if( classifier != NULL && !classifier->reset() ){
+        errorLog << "reset() - Failed To Reset Classifier! " << classifier->getLastErrorMessage() << endl;
+        return false;
+    }
+
+    if( regressifier != NULL && !regressifier->reset() ){
+        errorLog << "reset() - Failed To Reset Regressifier! " << regressifier->getLastErrorMessage() << endl;
+        return false;
+    }
+
+    for(UINT moduleIndex=0; moduleIndex<postProcessingModules.size(); moduleIndex++){
+        if( !postProcessingModules[ moduleIndex ]->reset() ){
+            errorLog << "reset() - Failed To Reset PostProcessingModule " << moduleIndex << endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const GestureRecognitionPipeline* GestureRecognitionPipelineSession::getPipeline() const{
+    return pipeline;
+}
+
+bool GestureRecognitionPipelineSession::enableProfiling(const bool useProfiling){
+    profiler.setEnabled( useProfiling );
+    if( useProfiling && pipeline != NULL ) return pipeline->setupProfiler( profiler );
+    return true;
+}
+
+bool GestureRecognitionPipelineSession::getIsModelShared() const{
+    return classifier == NULL && regressifier == NULL;
+}
+
+UINT GestureRecognitionPipelineSession::getPredictionModuleIndexPosition() const{
+    return predictionModuleIndex;
+}
+
+UINT GestureRecognitionPipelineSession::getPredictedClassLabel() const{
+    return predictedClassLabel;
+}
+
+UINT GestureRecognitionPipelineSession::getUnProcessedPredictedClassLabel() const{
+    return classificationResult.unprocessedPredictedClassLabel;
+}
+
+double GestureRecognitionPipelineSession::getMaximumLikelihood() const{
+    return classificationResult.maximumLikelihood;
+}
+
+VectorDouble GestureRecognitionPipelineSession::getClassLikelihoods() const{
+    return classificationResult.classLikelihoods;
+}
+
+VectorDouble GestureRecognitionPipelineSession::getClassDistances() const{
+    return classificationResult.classDistances;
+}
+
+VectorDouble GestureRecognitionPipelineSession::getRegressionData() const{
+    return regressionData;
+}
+
+VectorDouble GestureRecognitionPipelineSession::getUnProcessedRegressionData() const{
+    return unprocessedRegressionData;
+}
+
+const PipelineProfiler& GestureRecognitionPipelineSession::getProfiler() const{
+    return profiler;
+}
+
+PipelineProfiler& GestureRecognitionPipelineSession::getProfiler(){
+    return profiler;
+}
+
+bool GestureRecognitionPipelineSession::copyModules(const vector< PreProcessing* > &preProcessingModules,const vector< FeatureExtraction* > &featureExtractionModules,const Classifier *classifier,const Regressifier *regressifier,const vector< PostProcessing* > &postProcessingModules,const vector< vector< Context* > > &contextModules){
+
+    for(UINT i=0; i<preProcessingModules.size(); i++){
+        PreProcessing *module = cloneSessionModule( preProcessingModules[i] );
+        if( module == NULL ){
+            errorLog << "copyModules(...) - Failed to copy PreProcessingModule " << i << endl;
+            clear();
+            return false;
+        }
+        this->preProcessingModules.push_back( module );
+    }
+
+    for(UINT i=0; i<featureExtractionModules.size(); i++){
+        FeatureExtraction *module = cloneSessionModule( featureExtractionModules[i] );
+        if( module == NULL ){
+            errorLog << "copyModules(...) - Failed to copy FeatureExtractionModule " << i << endl;
+            clear();
+            return false;
+        }
+        this->featureExtractionModules.push_back( module );
+    }
+
+    if( classifier != NULL ){
+        this->classifier = deepCopySessionModel( classifier );
+        if( this->classifier == NULL ){
+            errorLog << "copyModules(...) - Failed to copy the classifier!" << endl;
+            clear();
+            return false;
+        }
+    }
+
+    if( regressifier != NULL ){
+        this->regressifier = deepCopySessionModel( regressifier );
+        if( this->regressifier == NULL ){
+            errorLog << "copyModules(...) - Failed to copy the regressifier!" << endl;
+            clear();
+            return false;
+        }
+    }
+
+    for(UINT i=0; i<postProcessingModules.size(); i++){
+        PostProcessing *module = cloneSessionModule( postProcessingModules[i] );
+        if( module == NULL ){
+            errorLog << "copyModules(...) - Failed to copy PostProcessingModule " << i << endl;
+            clear();
+            return false;
+        }
+        this->postProcessingModules.push_back( module );
+    }
+
+    for(UINT level=0; level<contextModules.size() && level<this->contextModules.size(); level++){
+        for(UINT i=0; i<contextModules[level].size(); i++){
+            Context *module = cloneSessionModule( contextModules[level][i] );
+            if( module == NULL ){
+                errorLog << "copyModules(...) - Failed to copy ContextModule " << i << " at context level " << level << endl;
+                clear();
+                return false;
+            }
+            this->contextModules[level].push_back( module );
+        }
+    }
+
+    return true;
+}
+
+void GestureRecognitionPipelineSession::clear(){
+    deleteSessionModules( preProcessingModules );
+    deleteSessionModules( featureExtractionModules );
+    deleteSessionModules( postProcessingModules );
+    for(UINT level=0; level<contextModules.size(); level++){
+        deleteSessionModules( contextModules[level] );
+    }
+    if( classifier != NULL ){
+        delete classifier;
+        classifier = NULL;
+    }
+    if( regressifier != NULL ){
+        delete regressifier;
+        regressifier = NULL;
+    }
+}
+
+} //End of namespace GRT
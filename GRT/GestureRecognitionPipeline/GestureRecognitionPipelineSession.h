@@ -0,0 +1,186 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The GestureRecognitionPipelineSession runs one stream of real-time data through a trained GestureRecognitionPipeline, without
+ changing the pipeline. This lets one trained pipeline serve many streams (for example one per user or per device) at the same
+ time, from many threads.
+
+ A session holds the state of one stream: its own copies of the pipeline's preprocessing, feature extraction, post processing and
+ context modules (so each stream has its own filter histories and buffers) and the outputs of its last prediction. If the pipeline's
+ classifier or regressifier supports stateless predictions (see MLBase::getIsPredictionStateless()), the model is shared by all the
+ sessions and is only read. Otherwise (for example DTW or HMM, which buffer the input data) each session gets its own copy of the model.
+
+ The pipeline must outlive its sessions and must not be modified (trained, loaded or have its modules changed) while it has sessions.
+ A session can only be used by one thread at a time, but different sessions of the same pipeline can be used by different threads.
+ */
+
+#ifndef GRT_GESTURE_RECOGNITION_PIPELINE_SESSION_HEADER
+#define GRT_GESTURE_RECOGNITION_PIPELINE_SESSION_HEADER
+
+#include "GestureRecognitionPipeline.h"
+
+namespace GRT{
+
+class GestureRecognitionPipelineSession : public GRTBase
+{
+public:
+    /**
+     Creates a new session for the pipeline. The pipeline should be trained before the session is created.
+
+     @param const GestureRecognitionPipeline &pipeline: the pipeline the session will use, this must outlive the session
+     */
+    GestureRecognitionPipelineSession(const GestureRecognitionPipeline &pipeline);
+
+    /**
+     Copy Constructor, the new session uses the same pipeline as the rhs session and starts with a copy of its state.
+
+     @param const GestureRecognitionPipelineSession &rhs: another instance of a GestureRecognitionPipelineSession
+     */
+    GestureRecognitionPipelineSession(const GestureRecognitionPipelineSession &rhs);
+
+    /**
+     Default Destructor
+     */
+    virtual ~GestureRecognitionPipelineSession(void);
+
+    /**
+     Defines how the data from the rhs GestureRecognitionPipelineSession should be copied to this GestureRecognitionPipelineSession
+
+     @param const GestureRecognitionPipelineSession &rhs: another instance of a GestureRecognitionPipelineSession
+     @return returns a reference to this instance of the GestureRecognitionPipelineSession
+     */
+    GestureRecognitionPipelineSession& operator=(const GestureRecognitionPipelineSession &rhs);
+
+    /**
+     Runs the input vector through the session's copy of the pipeline, this is the same as calling the predict function on the
+     pipeline but only the state of this session is updated.
+     After calling this function you can get the results using the getPredictedClassLabel() or getRegressionData() functions.
+
+     @param const VectorDouble &inputVector: the input data that will be passed through the pipeline
+     @return returns true if the prediction was successful, false otherwise
+     */
+    bool predict(const VectorDouble &inputVector);
+
+    /**
+     Resets the state of the session (the preprocessing, feature extraction, post processing modules and any model owned by the session).
+
+     @return returns true if the session was reset, false otherwise
+     */
+    bool reset();
+
+    /**
+     Turns the profiling of the session on or off. The session records the latency of each of its modules in its own profiler,
+     in the same way as GestureRecognitionPipeline::enableProfiling(...). Turning profiling on removes any previous results.
+
+     @param const bool useProfiling: true if the session should be profiled
+     @return returns true if the value was set, false otherwise
+     */
+    bool enableProfiling(const bool useProfiling);
+
+    /**
+     @return returns the pipeline used by this session
+     */
+    const GestureRecognitionPipeline* getPipeline() const;
+
+    /**
+     @return returns true if the session shares the pipeline's classifier or regressifier, false if the session has its own copy of the model
+     */
+    bool getIsModelShared() const;
+
+    /**
+     @return returns the position of the prediction module index after the last prediction (see GestureRecognitionPipeline::getPredictionModuleIndexPosition())
+     */
+    UINT getPredictionModuleIndexPosition() const;
+
+    /**
+     @return returns the predicted class label from the last prediction (after any post processing)
+     */
+    UINT getPredictedClassLabel() const;
+
+    /**
+     @return returns the predicted class label from the classifier, before any post processing
+     */
+    UINT getUnProcessedPredictedClassLabel() const;
+
+    /**
+     @return returns the maximum likelihood from the last prediction
+     */
+    double getMaximumLikelihood() const;
+
+    /**
+     @return returns the class likelihoods from the last prediction
+     */
+    VectorDouble getClassLikelihoods() const;
+
+    /**
+     @return returns the class distances from the last prediction
+     */
+    VectorDouble getClassDistances() const;
+
+    /**
+     @return returns the regression data from the last prediction (after any post processing)
+     */
+    VectorDouble getRegressionData() const;
+
+    /**
+     @return returns the regression data from the regressifier, before any post processing
+     */
+    VectorDouble getUnProcessedRegressionData() const;
+
+    /**
+     @return returns a reference to the profiler of the session, this holds the latency of each module run by the session
+     */
+    const PipelineProfiler& getProfiler() const;
+
+    /**
+     @return returns a reference to the profiler of the session, this can be used to set the periodic dump of the profiling results
+     */
+    PipelineProfiler& getProfiler();
+
+protected:
+    bool copyModules(const vector< PreProcessing* > &preProcessingModules,const vector< FeatureExtraction* > &featureExtractionModules,const Classifier *classifier,const Regressifier *regressifier,const vector< PostProcessing* > &postProcessingModules,const vector< vector< Context* > > &contextModules);
+    void clear();
+
+    const GestureRecognitionPipeline *pipeline;
+    UINT predictionModuleIndex;
+    UINT predictedClassLabel;
+    ClassificationResult classificationResult;
+    VectorDouble regressionData;
+    VectorDouble unprocessedRegressionData;
+    VectorDouble predictionBuffer;
+    VectorDouble postProcessingBuffer;
+    PipelineProfiler profiler;
+
+    vector< PreProcessing* > preProcessingModules;
+    vector< FeatureExtraction* > featureExtractionModules;
+    Classifier *classifier;                                 ///< The session's copy of a stateful classifier, NULL if the pipeline's classifier is shared
+    Regressifier *regressifier;                             ///< The session's copy of a stateful regressifier, NULL if the pipeline's regressifier is shared
+    vector< PostProcessing* > postProcessingModules;
+    vector< vector< Context* > > contextModules;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_GESTURE_RECOGNITION_PIPELINE_SESSION_HEADER
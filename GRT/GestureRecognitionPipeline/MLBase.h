@@ -33,6 +33,7 @@
 
 #include "GRTBase.h"
 #include "../DataStructures/LabelledClassificationData.h"
+#include "../DataStructures/LabelledClassificationDataView.h"
 #include "../DataStructures/LabelledTimeSeriesClassificationData.h"
 
 namespace GRT{
@@ -68,6 +69,7 @@ public:
 	MLBase(void){
         trained = false;
         useScaling = false;
+        statelessPrediction = false;
         baseType = BASE_TYPE_NOT_SET;
         numFeatures = 0;
         numOutputDimensions = 0;
@@ -100,6 +102,7 @@ public:
 
         this->trained = mlBase->trained;
         this->useScaling = mlBase->useScaling;
+        this->statelessPrediction = mlBase->statelessPrediction;
         this->baseType = mlBase->baseType;
         this->numFeatures = mlBase->numFeatures;
         this->numOutputDimensions = mlBase->numOutputDimensions;
@@ -117,6 +120,16 @@ public:
      @return returns true if the classifier was successfully trained, false otherwise
      */
     virtual bool train(LabelledClassificationData trainingData){ return false; }
+
+    /**
+     This is the training interface for a LabelledClassificationDataView. By default this copies the samples in the view into a
+     new dataset and trains the algorithm on that dataset, derived classes that can read the samples straight from the view
+     can override this to avoid the copy.
+
+     @param const LabelledClassificationDataView &trainingData: the view of the training data that will be used to train the classifier
+     @return returns true if the classifier was successfully trained, false otherwise
+     */
+    virtual bool train(const LabelledClassificationDataView &trainingData){ return train( trainingData.getDataset() ); }
     
     /**
      This is the main training interface for LabelledTimeSeriesClassificationData. This should be overwritten by the derived class.
@@ -225,7 +238,7 @@ public:
      @param const double &maxTarget: the maximum range that x should be scaled to
      @return returns a new value that has been scaled based on the input parameters
      */
-    double inline scale(const double &x,const double &minSource,const double &maxSource,const double &minTarget,const double &maxTarget){
+    double inline scale(const double &x,const double &minSource,const double &maxSource,const double &minTarget,const double &maxTarget) const{
         return (((x-minSource)*(maxTarget-minTarget))/(maxSource-minSource))+minTarget;
     }
 
@@ -275,6 +288,16 @@ public:
      @return returns true if scaling is enabled, false otherwise
      */
     bool getScalingEnabled() const{ return useScaling; }
+
+    /**
+     Gets if the predictions of the derived class only depend on the trained model and the current input, and not on any previous
+     calls to predict (such as a classifier that buffers the input data). A stateless model implements the const predictStateless
+     function, so one trained model can be shared by many threads. This is used by the GestureRecognitionPipeline::predictBatch
+     function and the GestureRecognitionPipelineSession class.
+
+     @return returns true if the predictions are stateless, false otherwise
+     */
+    bool getIsPredictionStateless() const{ return statelessPrediction; }
     
     /**
      Gets if the derived class type is CLASSIFIER.
@@ -379,6 +402,7 @@ public:
 protected:
     bool trained;
     bool useScaling;
+    bool statelessPrediction;
     UINT baseType;
     UINT numFeatures;
     UINT numOutputDimensions;
@@ -0,0 +1,214 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PipelineProfiler.h"
+#include <iomanip>
+#include <new>
+
+#if defined(GRT_CXX11_ENABLED)
+    #include <chrono>
+#elif defined(__GRT_WINDOWS_BUILD__)
+    #include <windows.h>
+#else
+    #include <sys/time.h>
+#endif
+
+//The allocation counter replaces the global operator new and delete, so it is only built if it is asked for
+#ifdef GRT_PROFILE_ALLOCATIONS
+#ifdef GRT_CXX11_ENABLED
+static thread_local unsigned long long grtAllocationCount = 0;
+#else
+static unsigned long long grtAllocationCount = 0;
+#endif
+
+void* operator new(size_t size){
+    grtAllocationCount++;
+    void *ptr = malloc( size > 0 ? size : 1 );
+    if( ptr == NULL ) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size){
+    grtAllocationCount++;
+    void *ptr = malloc( size > 0 ? size : 1 );
+    if( ptr == NULL ) throw std::bad_alloc();
+    return ptr;
+}
+
+void operator delete(void *ptr) throw(){ free( ptr ); }
+void operator delete[](void *ptr) throw(){ free( ptr ); }
+#endif
+
+namespace GRT{
+
+PipelineProfiler::PipelineProfiler(){
+    enabled = false;
+    dumpInterval = 0;
+    numPredictionsSinceDump = 0;
+    dumpStream = &cout;
+    predictionStartTime = 0;
+    predictionStartAllocations = 0;
+    stageStartTime = 0;
+    stageStartAllocations = 0;
+}
+
+PipelineProfiler::~PipelineProfiler(){
+}
+
+bool PipelineProfiler::setEnabled(const bool enabled){
+    this->enabled = enabled;
+    return true;
+}
+
+bool PipelineProfiler::setDumpInterval(const UINT numPredictions,ostream &stream){
+    dumpInterval = numPredictions;
+    dumpStream = &stream;
+    numPredictionsSinceDump = 0;
+    return true;
+}
+
+bool PipelineProfiler::reset(){
+    for(UINT i=0; i<stages.size(); i++){
+        stages[i].latency.reset();
+        stages[i].numAllocations = 0;
+    }
+    numPredictionsSinceDump = 0;
+    return true;
+}
+
+bool PipelineProfiler::setStages(const vector< PipelineStageProfile > &stages){
+
+    this->stages = stages;
+    numPredictionsSinceDump = 0;
+
+    //Store where the stages of each type start, the context modules have one entry per context level
+    stageOffsets.clear();
+    for(UINT i=0; i<this->stages.size(); i++){
+        this->stages[i].latency.reset();
+        this->stages[i].numAllocations = 0;
+
+        const PipelineStageProfile &stage = this->stages[i];
+        const UINT key = stage.stageType == CONTEXT_STAGE ? NUM_STAGE_TYPES + stage.contextLevel : stage.stageType;
+        if( key >= stageOffsets.size() ) stageOffsets.resize( key+1, (UINT)this->stages.size() );
+        if( stage.moduleIndex == 0 ) stageOffsets[ key ] = i;
+    }
+
+    return true;
+}
+
+UINT PipelineProfiler::getStageIndex(const UINT stageType,const UINT moduleIndex,const UINT contextLevel) const{
+    const UINT key = stageType == CONTEXT_STAGE ? NUM_STAGE_TYPES + contextLevel : stageType;
+    if( key >= stageOffsets.size() ) return (UINT)stages.size();
+    const UINT stageIndex = stageOffsets[ key ] + moduleIndex;
+    if( stageIndex >= stages.size() || stages[ stageIndex ].stageType != stageType || stages[ stageIndex ].moduleIndex != moduleIndex ){
+        return (UINT)stages.size();
+    }
+    return stageIndex;
+}
+
+void PipelineProfiler::stopPrediction(){
+
+    const unsigned long long stopTime = getTimeStamp();
+    if( stages.size() > 0 ){
+        stages[ 0 ].latency.record( stopTime - predictionStartTime );
+        stages[ 0 ].numAllocations += getAllocationCount() - predictionStartAllocations;
+    }
+
+    if( dumpInterval > 0 && ++numPredictionsSinceDump >= dumpInterval ){
+        dump( *dumpStream );
+        numPredictionsSinceDump = 0;
+    }
+}
+
+bool PipelineProfiler::dump(ostream &stream) const{
+
+    const bool countAllocations = getIsAllocationCountingEnabled();
+
+    stream << "Pipeline Profile - Predictions: " << getNumPredictions() << " PredictionsPerSecond: " << getPredictionsPerSecond() << endl;
+    stream << left << setw(40) << "Stage" << right << setw(12) << "Calls" << setw(12) << "Mean(us)" << setw(12) << "P50(us)";
+    stream << setw(12) << "P90(us)" << setw(12) << "P99(us)" << setw(12) << "Max(us)" << setw(14) << "Allocs/Call" << endl;
+
+    for(UINT i=0; i<stages.size(); i++){
+        const PipelineStageProfile &stage = stages[i];
+        const LatencyHistogram &latency = stage.latency;
+        const unsigned long long numCalls = latency.getCount();
+
+        stream << left << setw(40) << stage.stageName << right << setw(12) << numCalls << fixed << setprecision(3);
+        stream << setw(12) << latency.getMean()/1000.0;
+        stream << setw(12) << latency.getPercentile(50)/1000.0;
+        stream << setw(12) << latency.getPercentile(90)/1000.0;
+        stream << setw(12) << latency.getPercentile(99)/1000.0;
+        stream << setw(12) << latency.getMax()/1000.0;
+        if( countAllocations ) stream << setw(14) << (numCalls > 0 ? double(stage.numAllocations)/double(numCalls) : 0.0);
+        else stream << setw(14) << "n/a";
+        stream.unsetf( ios::floatfield );
+        stream << setprecision(6) << endl;
+    }
+
+    return true;
+}
+
+unsigned long long PipelineProfiler::getNumPredictions() const{
+    if( stages.size() == 0 ) return 0;
+    return stages[0].latency.getCount();
+}
+
+double PipelineProfiler::getPredictionsPerSecond() const{
+    if( stages.size() == 0 || stages[0].latency.getTotal() == 0 ) return 0;
+    return double( stages[0].latency.getCount() ) / ( double( stages[0].latency.getTotal() ) * 1.0e-9 );
+}
+
+PipelineStageProfile PipelineProfiler::getStageProfile(const UINT stageIndex) const{
+    if( stageIndex < stages.size() ) return stages[ stageIndex ];
+    return PipelineStageProfile();
+}
+
+unsigned long long PipelineProfiler::getTimeStamp(){
+#if defined(GRT_CXX11_ENABLED)
+    return (unsigned long long)std::chrono::duration_cast< std::chrono::nanoseconds >( std::chrono::steady_clock::now().time_since_epoch() ).count();
+#elif defined(__GRT_WINDOWS_BUILD__)
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency( &frequency );
+    QueryPerformanceCounter( &counter );
+    return (unsigned long long)( double(counter.QuadPart) * 1.0e9 / double(frequency.QuadPart) );
+#else
+    struct timeval now;
+    gettimeofday( &now, NULL );
+    return (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_usec * 1000ULL;
+#endif
+}
+
+unsigned long long PipelineProfiler::getAllocationCount(){
+#ifdef GRT_PROFILE_ALLOCATIONS
+    return grtAllocationCount;
+#else
+    return 0;
+#endif
+}
+
+bool PipelineProfiler::getIsAllocationCountingEnabled(){
+#ifdef GRT_PROFILE_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+} //End of namespace GRT
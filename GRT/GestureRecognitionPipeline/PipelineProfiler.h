@@ -0,0 +1,243 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The PipelineProfiler records how long each stage of a GestureRecognitionPipeline takes when the pipeline predicts a sample. Each
+ module in the pipeline (each preprocessing, feature extraction, post processing and context module, and the classifier or
+ regressifier) is one stage, and there is one more stage for the whole prediction. For each stage the profiler records the number
+ of calls and a LatencyHistogram of the latencies, from which the mean and any percentile can be read.
+
+ Profiling is off by default, and a pipeline that is not being profiled only pays for one check per module. Use
+ GestureRecognitionPipeline::enableProfiling(true) to turn it on, then read the results with getStageProfile(...) or print
+ them with dump(...). The profiler can also print the results every N predictions (see setDumpInterval).
+
+ If the GRT is built with GRT_PROFILE_ALLOCATIONS defined, the profiler replaces the global operator new and delete so it can
+ also count the memory allocations made by each stage. This is off by default as it changes every allocation in the program.
+ */
+
+#ifndef GRT_PIPELINE_PROFILER_HEADER
+#define GRT_PIPELINE_PROFILER_HEADER
+
+#include "../Util/GRTCommon.h"
+#include "../Util/LatencyHistogram.h"
+
+namespace GRT{
+
+class PipelineStageProfile{
+public:
+    /**
+     Default Constructor
+
+     @param const string &stageName: the name of the stage, such as the type of the module
+     @param const UINT stageType: the type of the stage, this should be one of the PipelineProfiler::StageTypes
+     @param const UINT moduleIndex: the index of the module within its part of the pipeline
+     @param const UINT contextLevel: the context level of the module (only used for context modules)
+     */
+    PipelineStageProfile(const string &stageName = "",const UINT stageType = 0,const UINT moduleIndex = 0,const UINT contextLevel = 0){
+        this->stageName = stageName;
+        this->stageType = stageType;
+        this->moduleIndex = moduleIndex;
+        this->contextLevel = contextLevel;
+        this->numAllocations = 0;
+    }
+
+    /**
+     @return returns the number of times the stage has been run
+     */
+    unsigned long long getNumCalls() const{ return latency.getCount(); }
+
+    string stageName;
+    UINT stageType;
+    UINT moduleIndex;
+    UINT contextLevel;
+    unsigned long long numAllocations;                      ///< The number of memory allocations made by the stage (only counted if GRT_PROFILE_ALLOCATIONS is defined)
+    LatencyHistogram latency;                               ///< The latency of each call, in nanoseconds
+};
+
+class PipelineProfiler{
+public:
+    /**
+     Default Constructor
+     */
+    PipelineProfiler();
+
+    /**
+     Default Destructor
+     */
+    ~PipelineProfiler();
+
+    /**
+     Sets if the profiler should record the stages of the pipeline.
+
+     @param const bool enabled: true if the stages should be recorded
+     @return returns true if the value was set
+     */
+    bool setEnabled(const bool enabled);
+
+    /**
+     Sets how often the profiler prints its results. The results are printed with dump(...) after every numPredictions predictions.
+
+     @param const UINT numPredictions: the number of predictions between each dump, 0 turns the periodic dump off
+     @param ostream &stream: the stream the results are printed to, this must exist while the periodic dump is on
+     @return returns true if the value was set
+     */
+    bool setDumpInterval(const UINT numPredictions,ostream &stream = cout);
+
+    /**
+     Removes all the recorded results, the stages are kept.
+
+     @return returns true if the profiler was reset
+     */
+    bool reset();
+
+    /**
+     Sets the stages that will be recorded, this removes any previous stages and results. This is called by the pipeline.
+
+     @param const vector< PipelineStageProfile > &stages: the stages of the pipeline, the first stage should be the whole prediction
+     @return returns true if the stages were set
+     */
+    bool setStages(const vector< PipelineStageProfile > &stages);
+
+    /**
+     Prints a table with the number of calls, the mean and percentile latencies and the allocations per call of each stage.
+
+     @param ostream &stream: the stream the table is printed to
+     @return returns true if the table was printed
+     */
+    bool dump(ostream &stream) const;
+
+    /**
+     @return returns true if the profiler is recording the stages of the pipeline, false otherwise
+     */
+    bool getEnabled() const{ return enabled; }
+
+    /**
+     @return returns the number of stages
+     */
+    UINT getNumStages() const{ return (UINT)stages.size(); }
+
+    /**
+     @return returns the number of predictions that have been recorded
+     */
+    unsigned long long getNumPredictions() const;
+
+    /**
+     Gets the average number of predictions per second, based on the time spent in the pipeline's predict function.
+
+     @return returns the average number of predictions per second, or 0 if no predictions have been recorded
+     */
+    double getPredictionsPerSecond() const;
+
+    /**
+     Gets the profile of one stage, stage 0 is the whole prediction.
+
+     @param const UINT stageIndex: the index of the stage
+     @return returns the profile of the stage, or an empty profile if the stageIndex is not valid
+     */
+    PipelineStageProfile getStageProfile(const UINT stageIndex) const;
+
+    /**
+     @return returns the profiles of all the stages
+     */
+    const vector< PipelineStageProfile >& getStageProfiles() const{ return stages; }
+
+    /**
+     Gets the index of the stage that records a module.
+
+     @param const UINT stageType: the type of the stage, this should be one of the StageTypes
+     @param const UINT moduleIndex: the index of the module within its part of the pipeline
+     @param const UINT contextLevel: the context level of the module (only used for context modules)
+     @return returns the index of the stage, or getNumStages() if there is no stage for the module
+     */
+    UINT getStageIndex(const UINT stageType,const UINT moduleIndex = 0,const UINT contextLevel = 0) const;
+
+    /**
+     Marks the start of a prediction, this is called by the pipeline.
+     */
+    void startPrediction(){
+        predictionStartAllocations = getAllocationCount();
+        predictionStartTime = getTimeStamp();
+    }
+
+    /**
+     Marks the end of a prediction, this is called by the pipeline.
+     */
+    void stopPrediction();
+
+    /**
+     Marks the start of a stage, this is called by the pipeline.
+     */
+    void startStage(){
+        stageStartAllocations = getAllocationCount();
+        stageStartTime = getTimeStamp();
+    }
+
+    /**
+     Marks the end of a stage, this is called by the pipeline.
+
+     @param const UINT stageType: the type of the stage, this should be one of the StageTypes
+     @param const UINT moduleIndex: the index of the module within its part of the pipeline
+     @param const UINT contextLevel: the context level of the module (only used for context modules)
+     */
+    void stopStage(const UINT stageType,const UINT moduleIndex = 0,const UINT contextLevel = 0){
+        const unsigned long long stopTime = getTimeStamp();
+        const UINT stageIndex = getStageIndex( stageType, moduleIndex, contextLevel );
+        if( stageIndex >= stages.size() ) return;
+        stages[ stageIndex ].latency.record( stopTime - stageStartTime );
+        stages[ stageIndex ].numAllocations += getAllocationCount() - stageStartAllocations;
+    }
+
+    /**
+     @return returns a monotonic time stamp in nanoseconds
+     */
+    static unsigned long long getTimeStamp();
+
+    /**
+     @return returns the number of memory allocations made so far by the calling thread, or 0 if GRT_PROFILE_ALLOCATIONS is not defined
+     */
+    static unsigned long long getAllocationCount();
+
+    /**
+     @return returns true if the GRT was built with GRT_PROFILE_ALLOCATIONS defined, false otherwise
+     */
+    static bool getIsAllocationCountingEnabled();
+
+    enum StageTypes{PREDICTION_STAGE=0,CONTEXT_STAGE,PREPROCESSING_STAGE,FEATURE_EXTRACTION_STAGE,CLASSIFIER_STAGE,REGRESSIFIER_STAGE,POST_PROCESSING_STAGE,NUM_STAGE_TYPES};
+
+protected:
+    bool enabled;
+    UINT dumpInterval;
+    UINT numPredictionsSinceDump;
+    ostream *dumpStream;
+    unsigned long long predictionStartTime;
+    unsigned long long predictionStartAllocations;
+    unsigned long long stageStartTime;
+    unsigned long long stageStartAllocations;
+    vector< PipelineStageProfile > stages;
+    vector< UINT > stageOffsets;                            ///< The index of the first stage of each stage type (and each context level)
+};
+
+} //End of namespace GRT
+
+#endif //GRT_PIPELINE_PROFILER_HEADER
@@ -22,7 +22,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace GRT{
     
 PostProcessing::StringPostProcessingMap* PostProcessing::stringPostProcessingMap = NULL;
+#ifdef GRT_CXX11_ENABLED
+std::atomic< UINT > PostProcessing::numPostProcessingInstances(0);
+#else
 UINT PostProcessing::numPostProcessingInstances = 0;
+#endif
     
 PostProcessing* PostProcessing::createInstanceFromString(string const &postProcessingType){
     
@@ -118,7 +122,14 @@ bool PostProcessing::getIsPostProcessingOutputModeClassLikelihoods() const{
     return postProcessingOutputMode==OUTPUT_MODE_CLASS_LIKELIHOODS; 
 }
     
-vector< double > PostProcessing::getProcessedData() const{ 
+bool PostProcessing::processInPlace(vector< double > &data){
+    //The default implementation processes the data and copies the result back, the copy reuses the memory of the data vector
+    if( !process( data ) ) return false;
+    data = processedData;
+    return true;
+}
+
+const vector< double >& PostProcessing::getProcessedData() const{ 
     return processedData; 
 }
 
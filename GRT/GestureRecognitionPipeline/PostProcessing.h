@@ -23,6 +23,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "GRTBase.h"
 
+#ifdef GRT_CXX11_ENABLED
+#include <atomic>
+#endif
+
 namespace GRT{
 
 class PostProcessing : public GRTBase
@@ -38,6 +42,7 @@ public:
 	bool copyBaseVariables(const PostProcessing *postProcessingModule);
 
     virtual bool process(const vector< double > &inputVector){ return false; }
+    virtual bool processInPlace(vector< double > &data);
     
     virtual bool reset(){ return true; }
     
@@ -57,7 +62,7 @@ public:
 	bool getIsPostProcessingInputModeClassLikelihoods() const;
 	bool getIsPostProcessingOutputModePredictedClassLabel() const;
 	bool getIsPostProcessingOutputModeClassLikelihoods() const;
-	vector< double > getProcessedData() const;
+	const vector< double >& getProcessedData() const;
     
     //Setters
     
@@ -84,7 +89,11 @@ protected:
 
 private:
     static StringPostProcessingMap *stringPostProcessingMap;
+#ifdef GRT_CXX11_ENABLED
+    static std::atomic< UINT > numPostProcessingInstances;    //Atomic, as pipeline sessions can create and delete modules on different threads
+#else
     static UINT numPostProcessingInstances;
+#endif
 
 };
 
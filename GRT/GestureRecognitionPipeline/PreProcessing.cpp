@@ -23,7 +23,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace GRT{
     
 PreProcessing::StringPreProcessingMap* PreProcessing::stringPreProcessingMap = NULL;
+#ifdef GRT_CXX11_ENABLED
+std::atomic< UINT > PreProcessing::numPreProcessingInstances(0);
+#else
 UINT PreProcessing::numPreProcessingInstances = 0;
+#endif
     
 PreProcessing* PreProcessing::createInstanceFromString(string const &preProcessingType){
     
@@ -92,7 +96,59 @@ bool PreProcessing::getInitialized() const{
     return initialized; 
 }
     
-VectorDouble PreProcessing::getProcessedData() const{ 
+bool PreProcessing::processInPlace(VectorDouble &data){
+    //The default implementation processes the data and copies the result back, the copy reuses the memory of the data vector
+    if( !process( data ) ) return false;
+    data = processedData;
+    return true;
+}
+
+bool PreProcessing::processBlock(const MatrixDouble &data,MatrixDouble &output){
+    
+    const UINT M = data.getNumRows();
+    const UINT N = data.getNumCols();
+    
+    if( M == 0 ){
+        output.clear();
+        return true;
+    }
+    
+    if( N != numInputDimensions ){
+        errorLog << "processBlock(const MatrixDouble &data,MatrixDouble &output) - The number of columns in the data (" << N << ") does not match the number of input dimensions (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+    
+    if( output.getNumRows() != M || output.getNumCols() != numOutputDimensions ){
+        if( &output == &data ){
+            errorLog << "processBlock(const MatrixDouble &data,MatrixDouble &output) - The data can only be processed in place if the number of input and output dimensions match!" << endl;
+            return false;
+        }
+        if( !output.resize(M,numOutputDimensions) ){
+            errorLog << "processBlock(const MatrixDouble &data,MatrixDouble &output) - Failed to resize the output matrix!" << endl;
+            return false;
+        }
+    }
+    
+    //The default implementation processes the data one row at a time, reusing the same input vector for each row
+    VectorDouble sample(N);
+    for(UINT i=0; i<M; i++){
+        const double *x = data[i];
+        for(UINT j=0; j<N; j++) sample[j] = x[j];
+        
+        if( !process( sample ) ) return false;
+        
+        if( processedData.size() != numOutputDimensions ){
+            errorLog << "processBlock(const MatrixDouble &data,MatrixDouble &output) - The size of the processed data (" << processedData.size() << ") does not match the number of output dimensions (" << numOutputDimensions << ")!" << endl;
+            return false;
+        }
+        double *y = output[i];
+        for(UINT j=0; j<numOutputDimensions; j++) y[j] = processedData[j];
+    }
+    
+    return true;
+}
+
+const VectorDouble& PreProcessing::getProcessedData() const{ 
     return processedData; 
 }
 
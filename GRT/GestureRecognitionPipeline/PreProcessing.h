@@ -23,6 +23,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "GRTBase.h"
 
+#ifdef GRT_CXX11_ENABLED
+#include <atomic>
+#endif
+
 namespace GRT{
 
 class PreProcessing : public GRTBase
@@ -39,6 +43,11 @@ public:
 
     //Training methods
     virtual bool process(const VectorDouble &inputVector){ return false; }
+    virtual bool processInPlace(VectorDouble &data);
+    
+    //Processes each row of data in order, as if process was called for each row, and writes the results to the rows of output.
+    //The module is not reset first. Output can be the same matrix as data if the module does not change the number of dimensions.
+    virtual bool processBlock(const MatrixDouble &data,MatrixDouble &output);
     virtual bool reset(){ return true; }
     
     virtual bool saveSettingsToFile(string filename){ return false; }
@@ -51,7 +60,7 @@ public:
 	UINT getNumInputDimensions() const;
 	UINT getNumOutputDimensions() const;
 	bool getInitialized() const;
-	VectorDouble getProcessedData() const;
+	const VectorDouble& getProcessedData() const;
     
     //Setters
 
@@ -73,7 +82,11 @@ protected:
 
 private:
     static StringPreProcessingMap *stringPreProcessingMap;
+#ifdef GRT_CXX11_ENABLED
+    static std::atomic< UINT > numPreProcessingInstances;    //Atomic, as pipeline sessions can create and delete modules on different threads
+#else
     static UINT numPreProcessingInstances;
+#endif
 };
 
 //These two functions/classes are used to register any new PreProcessing Module with the PreProcessing base class
@@ -22,7 +22,11 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace GRT{
     
 Regressifier::StringRegressifierMap* Regressifier::stringRegressifierMap = NULL;
+#ifdef GRT_CXX11_ENABLED
+std::atomic< UINT > Regressifier::numRegressifierInstances(0);
+#else
 UINT Regressifier::numRegressifierInstances = 0;
+#endif
     
 Regressifier* Regressifier::createInstanceFromString(string const &regressifierType){
     
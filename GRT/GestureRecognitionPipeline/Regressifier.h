@@ -25,6 +25,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "../DataStructures/LabelledClassificationData.h"
 #include "../DataStructures/LabelledTimeSeriesClassificationData.h"
 
+#ifdef GRT_CXX11_ENABLED
+#include <atomic>
+#endif
+
 namespace GRT{
     
 #define DEFAULT_NULL_LIKELIHOOD_VALUE 0
@@ -38,6 +42,18 @@ public:
 	virtual ~Regressifier(void);
     
     virtual bool deepCopyFrom(const Regressifier *regressifier){ return false; }
+
+    /**
+     Maps the input vector without changing any of the variables of the regressifier, the output is written to the regressionData
+     vector instead. This lets one trained regressifier be shared by many threads (see GestureRecognitionPipelineSession).
+     This should be overwritten by the derived classes whose predictions are stateless (see getIsPredictionStateless), and gives
+     the same results as the predict function.
+
+     @param const VectorDouble &inputVector: the input vector to map
+     @param VectorDouble &regressionData: returns the regression output
+     @return returns true if the prediction was successful, false otherwise (the Regressifier base class will always return false)
+     */
+    virtual bool predictStateless(const VectorDouble &inputVector,VectorDouble &regressionData) const{ return false; }
     
     Regressifier* deepCopy() const;
     
@@ -120,7 +136,11 @@ protected:
     
 private:
     static StringRegressifierMap *stringRegressifierMap;
+#ifdef GRT_CXX11_ENABLED
+    static std::atomic< UINT > numRegressifierInstances;    //Atomic, as regressifiers can be created and deleted by the cross validation threads
+#else
     static UINT numRegressifierInstances;
+#endif
 
 };
     
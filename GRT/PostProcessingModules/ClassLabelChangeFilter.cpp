@@ -187,31 +187,27 @@ bool ClassLabelChangeFilter::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_CLASS_LABEL_CHANGE_FILTER_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_CLASS_LABEL_CHANGE_FILTER_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
     
-    file >> word;
-    if( word != "NumInputDimensions:" ){
+    if( !parser.matchWord("NumInputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
         return false;     
     }
-    file >> numInputDimensions;
+    parser >> numInputDimensions;
     
     //Load the number of output dimensions
-    file >> word;
-    if( word != "NumOutputDimensions:" ){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumOutputDimensions header!" << endl;
         return false;     
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
     
     //Init the classLabelTimeoutFilter module to ensure everything is initialized correctly
     return init();
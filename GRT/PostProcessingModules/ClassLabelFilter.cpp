@@ -160,7 +160,8 @@ UINT ClassLabelFilter::filter(UINT predictedClassLabel){
     buffer.push_back( predictedClassLabel );
     
     //Count the class values in the buffer, automatically start with the first value in the buffer
-    vector< ClassTracker > classTracker( 1, ClassTracker( buffer[0], 1 ) );
+    classTracker.clear();
+    classTracker.push_back( ClassTracker( buffer[0], 1 ) );
     
     UINT maxCount = classTracker[0].counter;
     UINT maxClass = classTracker[0].classLabel;
@@ -259,46 +260,40 @@ bool ClassLabelFilter::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_CLASS_LABEL_FILTER_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_CLASS_LABEL_FILTER_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
     
-    file >> word;
-    if( word != "NumInputDimensions:" ){
+    if( !parser.matchWord("NumInputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
         return false;     
     }
-    file >> numInputDimensions;
+    parser >> numInputDimensions;
     
     //Load the number of output dimensions
-    file >> word;
-    if( word != "NumOutputDimensions:" ){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumOutputDimensions header!" << endl;
         return false;     
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
     
     //Load the minimumCount
-    file >> word;
-    if( word != "MinimumCount:" ){
+    if( !parser.matchWord("MinimumCount:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read MinimumCount header!" << endl;
         return false;     
     }
-    file >> minimumCount;
+    parser >> minimumCount;
     
-    file >> word;
-    if( word != "BufferSize:" ){
+    if( !parser.matchWord("BufferSize:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read BufferSize header!" << endl;
         return false;     
     }
-    file >> bufferSize;
+    parser >> bufferSize;
     
     //Init the classLabelFilter module to ensure everything is initialized correctly
     return init(minimumCount,bufferSize);
@@ -284,46 +284,40 @@ bool ClassLabelTimeoutFilter::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_CLASS_LABEL_TIMEOUT_FILTER_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_CLASS_LABEL_TIMEOUT_FILTER_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
     
-    file >> word;
-    if( word != "NumInputDimensions:" ){
+    if( !parser.matchWord("NumInputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
         return false;     
     }
-    file >> numInputDimensions;
+    parser >> numInputDimensions;
     
     //Load the number of output dimensions
-    file >> word;
-    if( word != "NumOutputDimensions:" ){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumOutputDimensions header!" << endl;
         return false;     
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
     
     //Load the filterMode
-    file >> word;
-    if( word != "FilterMode:" ){
+    if( !parser.matchWord("FilterMode:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read FilterMode header!" << endl;
         return false;     
     }
-    file >> filterMode;
+    parser >> filterMode;
     
-    file >> word;
-    if( word != "TimeoutDuration:" ){
+    if( !parser.matchWord("TimeoutDuration:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read TimeoutDuration header!" << endl;
         return false;     
     }
-    file >> timeoutDuration;
+    parser >> timeoutDuration;
     
     //Init the classLabelTimeoutFilter module to ensure everything is initialized correctly
     return init(timeoutDuration,filterMode);
@@ -86,7 +86,7 @@ bool DeadZone::process(const vector< double > &inputVector){
     }
 #endif
     
-    filter( inputVector );
+    filterSample( &inputVector[0] );
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -155,47 +155,41 @@ bool DeadZone::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_DEAD_ZONE_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_DEAD_ZONE_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
     
     //Load the number of input dimensions
-    file >> word;
-    if( word != "NumInputDimensions:" ){
+    if( !parser.matchWord("NumInputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
         return false;     
     }
-    file >> numInputDimensions;
+    parser >> numInputDimensions;
     
     //Load the number of output dimensions
-    file >> word;
-    if( word != "NumOutputDimensions:" ){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumOutputDimensions header!" << endl;
         return false;     
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
     
     //Load the lower limit
-    file >> word;
-    if( word != "LowerLimit:" ){
+    if( !parser.matchWord("LowerLimit:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read LowerLimit header!" << endl;
         return false;     
     }
-    file >> lowerLimit;
+    parser >> lowerLimit;
     
-    file >> word;
-    if( word != "UpperLimit:" ){
+    if( !parser.matchWord("UpperLimit:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read UpperLimit header!" << endl;
         return false;     
     }
-    file >> upperLimit;
+    parser >> upperLimit;
     
     //Init the deadzone module to ensure everything is initialized correctly
     return init(lowerLimit,upperLimit,numInputDimensions);
@@ -229,9 +223,23 @@ bool DeadZone::init(double lowerLimit,double upperLimit,UINT numDimensions){
 }
 
 double DeadZone::filter(double x){
-    vector< double > y = filter(vector<double>(1,x));
-    if( y.size() == 0 ) return 0;
-	return y[0];
+    
+#ifdef GRT_SAFE_CHECKING
+    //If the filter has not been initialised then return 0, otherwise filter x and return y
+    if( !initialized ){
+        errorLog << "filter(double x) - The filter has not been initialized!" << endl;
+        return 0;
+    }
+    
+    if( numInputDimensions != 1 ){
+        errorLog << "filter(double x) - The dimensionality of the filter (" << numInputDimensions << ") is not 1!" << endl;
+        return 0;
+    }
+#endif
+    
+    filterSample( &x );
+    
+    return processedData[0];
 }
     
 vector< double > DeadZone::filter(const vector< double > &x){
@@ -248,6 +256,12 @@ vector< double > DeadZone::filter(const vector< double > &x){
     }
 #endif
     
+    filterSample( &x[0] );
+    
+    return processedData;
+}
+    
+void DeadZone::filterSample(const double *x){
     for(UINT n=0; n<numInputDimensions; n++){
         if( x[n] > lowerLimit && x[n] < upperLimit ){
             processedData[n] = 0;
@@ -256,7 +270,6 @@ vector< double > DeadZone::filter(const vector< double > &x){
             else processedData[n] = x[n] - lowerLimit;
         }
     }
-    return processedData;
 }
 
 bool DeadZone::setLowerLimit(double lowerLimit){ 
@@ -187,6 +187,13 @@ public:
     double getUpperLimit(){ if( initialized ){ return upperLimit; } return 0; }
 
 protected:
+    /**
+     Filters one sample, updating processedData.
+     
+     @param const double *x: a pointer to the numInputDimensions values to filter
+     */
+    void filterSample(const double *x);
+    
     double lowerLimit;				///< The lower limit of the dead-zone region
     double upperLimit;				///< The upper limit of the dead-zone region
     
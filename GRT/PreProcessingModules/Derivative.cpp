@@ -103,7 +103,10 @@ bool Derivative::process(const vector< double > &inputVector){
     }
 #endif
     
-    computeDerivative( inputVector );
+    if( filterData ){
+        filter.process( inputVector );
+        computeDerivativeSample( &filter.getProcessedData()[0] );
+    }else computeDerivativeSample( &inputVector[0] );
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -175,64 +178,56 @@ bool Derivative::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_DERIVATIVE_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_DERIVATIVE_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
     
     //Load the number of input dimensions
-    file >> word;
-    if( word != "NumInputDimensions:" ){
+    if( !parser.matchWord("NumInputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
         return false;     
     }
-    file >> numInputDimensions;
+    parser >> numInputDimensions;
     
     //Load the number of output dimensions
-    file >> word;
-    if( word != "NumOutputDimensions:" ){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumOutputDimensions header!" << endl;
         return false;     
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
     
     //Load the DerivativeOrder
-    file >> word;
-    if( word != "DerivativeOrder:" ){
+    if( !parser.matchWord("DerivativeOrder:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read DerivativeOrder header!" << endl;
         return false;     
     }
-    file >> derivativeOrder;
+    parser >> derivativeOrder;
     
     //Load the FilterSize
-    file >> word;
-    if( word != "FilterSize:" ){
+    if( !parser.matchWord("FilterSize:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read FilterSize header!" << endl;
         return false;     
     }
-    file >> filterSize;
+    parser >> filterSize;
     
     //Load the Delta
-    file >> word;
-    if( word != "Delta:" ){
+    if( !parser.matchWord("Delta:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read Delta header!" << endl;
         return false;     
     }
-    file >> delta;
+    parser >> delta;
     
     //Load if the data should be filtered 
-    file >> word;
-    if( word != "FilterData:" ){
+    if( !parser.matchWord("FilterData:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read FilterData header!" << endl;
         return false;     
     }
-    file >> filterData;
+    parser >> filterData;
 
     //Init the derivative module to ensure everything is initialized correctly
     return init(derivativeOrder,delta,numInputDimensions,filterData,filterSize);    
@@ -284,20 +279,27 @@ bool Derivative::init(UINT derivativeOrder,double delta,UINT numDimensions,bool
 double Derivative::computeDerivative(double x){
     
 #ifdef GRT_SAFE_CHECKING
+    if( !initialized ){
+        errorLog << "computeDerivative(double x) - Not Initialized!" << endl;
+        return 0;
+    }
+    
     if( numInputDimensions != 1 ){
         errorLog << "computeDerivative(double x) - The Number Of Input Dimensions is not 1! NumInputDimensions: " << numInputDimensions << endl;
         return 0;
     }
 #endif
     
-    vector< double > y = computeDerivative( vector< double >(1,x) );
+    if( filterData ){
+        x = filter.filter( x );
+    }
     
-    if( y.size() == 0 ) return 0 ;
+    computeDerivativeSample( &x );
     
-	return y[0];
+	return processedData[0];
 }
     
-vector< double > Derivative::computeDerivative(vector< double > x){
+vector< double > Derivative::computeDerivative(const vector< double > &x){
     
 #ifdef GRT_SAFE_CHECKING
     if( !initialized ){
@@ -312,8 +314,14 @@ vector< double > Derivative::computeDerivative(vector< double > x){
 #endif
     
     if( filterData ){
-        x = filter.filter( x );
-    }
+        filter.process( x );
+        computeDerivativeSample( &filter.getProcessedData()[0] );
+    }else computeDerivativeSample( &x[0] );
+    
+    return processedData;
+}
+    
+void Derivative::computeDerivativeSample(const double *x){
     
     for(UINT n=0; n<numInputDimensions; n++){
         processedData[n] = (x[n]-yy[n])/delta;
@@ -328,8 +336,6 @@ vector< double > Derivative::computeDerivative(vector< double > x){
             yyy[n] = tmp;
         }
     }
-    
-    return processedData;
 }
     
 bool Derivative::setDerivativeOrder(UINT derivativeOrder){
@@ -157,10 +157,10 @@ public:
     /**
      Computes the derivative of the input, the dimensionality of the input should match the number of inputs for the derivative
      
-     @param vector< double > x: the values to compute the derivative of, the dimensionality of the input should match the number of inputs for the derivative
+     @param const vector< double > &x: the values to compute the derivative of, the dimensionality of the input should match the number of inputs for the derivative
 	 @return the derivatives of the input.  An empty vector will be returned if the values were not filtered
      */
-    vector< double > computeDerivative(vector< double > x);
+    vector< double > computeDerivative(const vector< double > &x);
     
     /**
      Sets the derivative order.  This should either be FIRST_DERIVATIVE (1) or SECOND_DERIVATIVE (2).
@@ -227,6 +227,13 @@ public:
     vector< double > getDerivatives(UINT derivativeOrder = 0);
 
 protected:
+    /**
+     Computes the derivative of one (already filtered) sample, updating processedData and the previous values.
+     
+     @param const double *x: a pointer to the numInputDimensions values to compute the derivative of
+     */
+    void computeDerivativeSample(const double *x);
+    
     UINT derivativeOrder;                   ///< The order of the derivative that will be computed (either FIRST_DERIVATIVE or SECOND_DERIVATIVE)
     UINT filterSize;                        ///< The size of the filter used to filter the input data before the derivative is computed
     double delta;                           ///< The estimated time between sensor samples
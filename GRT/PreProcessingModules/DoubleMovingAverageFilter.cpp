@@ -103,10 +103,7 @@ bool DoubleMovingAverageFilter::process(const vector< double > &inputVector){
     }
 #endif
     
-    processedData = filter( inputVector );
-    
-    if( processedData.size() == numOutputDimensions ) return true;
-    return false;
+    return filterSample( inputVector );
 }
 
 bool DoubleMovingAverageFilter::reset(){
@@ -172,40 +169,35 @@ bool DoubleMovingAverageFilter::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_DOUBLE_MOVING_AVERAGE_FILTER_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_DOUBLE_MOVING_AVERAGE_FILTER_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
     
     //Load the number of input dimensions
-    file >> word;
-    if( word != "NumInputDimensions:" ){
+    if( !parser.matchWord("NumInputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
         return false;     
     }
-    file >> numInputDimensions;
+    parser >> numInputDimensions;
     
     //Load the number of output dimensions
-    file >> word;
-    if( word != "NumOutputDimensions:" ){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumOutputDimensions header!" << endl;
         return false;     
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
     
     //Load the filter size
-    file >> word;
-    if( word != "FilterSize:" ){
+    if( !parser.matchWord("FilterSize:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read FilterSize header!" << endl;
         return false;     
     }
-    file >> filterSize;
+    parser >> filterSize;
     
     //Init the filter module to ensure everything is initialized correctly
     return init(filterSize,numInputDimensions);  
@@ -257,12 +249,19 @@ double DoubleMovingAverageFilter::filter(double x){
         errorLog << "filter(double x) - The filter has not been initialized!" << endl;
         return 0;
     }
+    
+    if( numInputDimensions != 1 ){
+        errorLog << "filter(double x) - The dimensionality of the filter (" << numInputDimensions << ") is not 1!" << endl;
+        return 0;
+    }
 #endif
     
-    vector< double > y = filter(vector< double >(1,x));
+    //Perform both filters and account for the filter lag
+    const double y = filter1.filter( x );
+    const double yy = filter2.filter( y );
+    processedData[0] = y + (y - yy);
     
-    if( y.size() == 0 ) return 0;
-    return y[0];
+    return processedData[0];
 }
     
 vector< double > DoubleMovingAverageFilter::filter(const vector< double > &x){
@@ -280,23 +279,27 @@ vector< double > DoubleMovingAverageFilter::filter(const vector< double > &x){
     }
 #endif
     
-    //Perform the first filter
-    vector< double > y = filter1.filter( x );
+    if( !filterSample( x ) ) return vector<double>();
     
-    if( y.size() == 0 ) return y;
+    return processedData;
+}
     
-    //Perform the second filter
-    vector< double > yy = filter2.filter( y );
+bool DoubleMovingAverageFilter::filterSample(const vector< double > &x){
     
-    if( yy.size() == 0 ) return y;
+    //Perform the first filter
+    if( !filter1.process( x ) ) return false;
+    const vector< double > &y = filter1.getProcessedData();
+    
+    //Perform the second filter
+    if( !filter2.process( y ) ) return false;
+    const vector< double > &yy = filter2.getProcessedData();
     
     //Account for the filter lag
-    for(UINT i=0; i<y.size(); i++){
-        yy[i] = y[i] + (y[i] - yy[i]); 
-        processedData[i] = yy[i];
+    for(UINT i=0; i<numInputDimensions; i++){
+        processedData[i] = y[i] + (y[i] - yy[i]);
     }
     
-    return yy;
+    return true;
 }
 
 }//End of namespace GRT
\ No newline at end of file
@@ -164,6 +164,14 @@ public:
     vector< double > getFilteredData(){ return processedData; }    
     
 protected:
+    /**
+     Runs the input through both moving average filters and updates processedData with the filtered values.
+
+     @param const vector< double > &x: the values to filter, the dimensionality of the input vector should match that of the filter
+     @return returns true if the values were filtered, false otherwise
+     */
+    bool filterSample(const vector< double > &x);
+
     UINT filterSize;                    ///< The size of the filter
     MovingAverageFilter filter1;        ///< The first moving average filter
     MovingAverageFilter filter2;        ///< The second moving average filter
@@ -40,8 +40,7 @@ HighPassFilter::HighPassFilter(double filterFactor,double gain,UINT numDimension
 HighPassFilter::HighPassFilter(const HighPassFilter &rhs){
     this->filterFactor = rhs.filterFactor;
     this->gain = rhs.gain;
-	this->xx = rhs.xx;
-    this->yy = rhs.yy;
+    this->filterBank = rhs.filterBank;
     copyBaseVariables( (PreProcessing*)&rhs );
 }
 
@@ -53,8 +52,7 @@ HighPassFilter& HighPassFilter::operator=(const HighPassFilter &rhs){
     if(this!=&rhs){
         this->filterFactor = rhs.filterFactor;
         this->gain = rhs.gain;
-        this->xx = rhs.xx;
-        this->yy = rhs.yy;
+        this->filterBank = rhs.filterBank;
         copyBaseVariables( (PreProcessing*)&rhs );
     }
     return *this;
@@ -70,8 +68,7 @@ bool HighPassFilter::clone(const PreProcessing *preProcessing){
         //Clone the HighPassFilter values 
         this->filterFactor = ptr->filterFactor;
         this->gain = ptr->gain;
-        this->xx = ptr->xx;
-        this->yy = ptr->yy;
+        this->filterBank = ptr->filterBank;
         
         //Clone the base class variables
         return copyBaseVariables( preProcessing );
@@ -96,13 +93,66 @@ bool HighPassFilter::process(const vector< double > &inputVector){
     }
 #endif
     
-    processedData = filter( inputVector );
+    filterSample( &inputVector[0] );
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
 
 }
 
+bool HighPassFilter::processInPlace(vector< double > &data){
+    
+#ifdef GRT_SAFE_CHECKING
+    if( !initialized ){
+        errorLog << "processInPlace(vector< double > &data) - Not initialized!" << endl;
+        return false;
+    }
+    
+    if( data.size() != numInputDimensions ){
+        errorLog << "processInPlace(vector< double > &data) - The size of the data (" << data.size() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+#endif
+    
+    filterSample( &data[0] );
+    
+    //Copy the filtered values back over the input, data already has the right size so this does not allocate
+    std::copy( processedData.begin(), processedData.end(), data.begin() );
+    
+    return true;
+}
+
+bool HighPassFilter::processBlock(const MatrixDouble &data,MatrixDouble &output){
+    
+#ifdef GRT_SAFE_CHECKING
+    if( !initialized ){
+        errorLog << "processBlock(const MatrixDouble &data,MatrixDouble &output) - Not initialized!" << endl;
+        return false;
+    }
+    
+    if( data.getNumCols() != numInputDimensions ){
+        errorLog << "processBlock(const MatrixDouble &data,MatrixDouble &output) - The number of columns in the data (" << data.getNumCols() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+#endif
+    
+    const UINT M = data.getNumRows();
+    if( M == 0 ){
+        output.clear();
+        return true;
+    }
+    
+    if( !filterBank.filter(data,output) ){
+        errorLog << "processBlock(const MatrixDouble &data,MatrixDouble &output) - Failed to filter the data!" << endl;
+        return false;
+    }
+    
+    //Keep the last filtered sample as the processed data, as if the samples had been filtered one at a time
+    for(UINT n=0; n<numInputDimensions; n++) processedData[n] = output[M-1][n];
+    
+    return true;
+}
+
 bool HighPassFilter::reset(){
     if( initialized ) return init(filterFactor,gain,numInputDimensions);
     return false;
@@ -167,48 +217,42 @@ bool HighPassFilter::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_HIGH_PASS_FILTER_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_HIGH_PASS_FILTER_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
     
     //Load the number of input dimensions
-    file >> word;
-    if( word != "NumInputDimensions:" ){
+    if( !parser.matchWord("NumInputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
         return false;     
     }
-    file >> numInputDimensions;
+    parser >> numInputDimensions;
     
     //Load the number of output dimensions
-    file >> word;
-    if( word != "NumOutputDimensions:" ){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumOutputDimensions header!" << endl;
         return false;     
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
     
     //Load the filter factor
-    file >> word;
-    if( word != "FilterFactor:" ){
+    if( !parser.matchWord("FilterFactor:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read FilterFactor header!" << endl;
         return false;     
     }
-    file >> filterFactor;
+    parser >> filterFactor;
     
     //Load the number of output dimensions
-    file >> word;
-    if( word != "Gain:" ){
+    if( !parser.matchWord("Gain:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read Gain header!" << endl;
         return false;     
     }
-    file >> gain;
+    parser >> gain;
     
     //Init the filter module to ensure everything is initialized correctly
     return init(filterFactor,gain,numInputDimensions);  
@@ -239,10 +283,10 @@ bool HighPassFilter::init(double filterFactor,double gain,UINT numDimensions){
     this->gain = gain;
     this->numInputDimensions = numDimensions;
     this->numOutputDimensions = numDimensions;
-    xx.clear();
-    xx.resize(numDimensions,0);
-    yy.clear();
-    yy.resize(numDimensions,0);
+    
+    //y[n] = filterFactor * (y[n-1] + x[n] - x[n-1]) * gain
+    filterBank.init( numDimensions );
+    filterBank.addSection( filterFactor*gain, -filterFactor*gain, 0, -filterFactor*gain, 0 );
     processedData.clear();
     processedData.resize(numDimensions,0);
     initialized = true;
@@ -258,42 +302,54 @@ double HighPassFilter::filter(double x){
         errorLog << "filter(double x) - The filter has not been initialized!" << endl;
         return 0;
     }
+    
+    if( numInputDimensions != 1 ){
+        errorLog << "filter(double x) - The dimensionality of the filter (" << numInputDimensions << ") is not 1!" << endl;
+        return 0;
+    }
 #endif
     
-    vector< double > y = filter(vector< double >(1,x));
+    filterSample( &x );
     
-    if( y.size() == 0 ) return 0;
-    return y[0];
-
+    return processedData[0];
 }
     
-vector< double > HighPassFilter::filter(const vector< double > &x){
+const vector< double >& HighPassFilter::filter(const vector< double > &x){
     
 #ifdef GRT_SAFE_CHECKING
+    static const VectorDouble emptyVector;
+    
     if( !initialized ){
         errorLog << "filter(const vector< double > &x) - Not Initialized!" << endl;
-        return vector<double>();
+        return emptyVector;
     }
     
     if( x.size() != numInputDimensions ){
         errorLog << "filter(const vector< double > &x) - The Number Of Input Dimensions (" << numInputDimensions << ") does not match the size of the input vector (" << x.size() << ")!" << endl;
-        return vector<double>();
+        return emptyVector;
     }
 #endif
     
-    for(UINT n=0; n<numInputDimensions; n++){
-        //Compute the new output
-        processedData[n] = filterFactor * (yy[n] + x[n] - xx[n]) * gain;
-        
-        //Store the current input
-        xx[n] = x[n];
-        
-        //Store the current output
-        yy[n] = processedData[n];
-    }
+    filterSample( &x[0] );
+    
     return processedData;
 }
     
+void HighPassFilter::filterSample(const double *x){
+    filterBank.filter( x, &processedData[0] );
+}
+
+MatrixDouble HighPassFilter::filter(const MatrixDouble &x){
+    
+    MatrixDouble y;
+    if( !processBlock(x,y) ){
+        return MatrixDouble();
+    }
+    
+    return y;
+}
+
+    
 bool HighPassFilter::setGain(double gain){
     if( gain > 0 ){
         this->gain = gain;
@@ -22,6 +22,7 @@
 #define GRT_HIGH_PASS_FILTER_HEADER
 
 #include "../GestureRecognitionPipeline/PreProcessing.h"
+#include "../Util/IIRFilterBank.h"
 
 namespace GRT{
     
@@ -81,6 +82,25 @@ public:
      */
     virtual bool process(const vector< double > &inputVector);
     
+    /**
+     Sets the PreProcessing processInPlace function, overwriting the base PreProcessing function.
+     This filters the data and writes the result straight back into the data vector, so no temporary vector is needed.
+     
+	 @param vector< double > &data: the data to filter, this will be overwritten with the filtered values.  Must have the same dimensionality as the PreProcessing module
+	 @return true if the data was processed, false otherwise
+     */
+    virtual bool processInPlace(vector< double > &data);
+    
+    /**
+     Sets the PreProcessing processBlock function, overwriting the base PreProcessing function.
+     This filters all the rows of data in one call to the filter bank, continuing from the current state of the filter.
+     
+     @param const MatrixDouble &data: a [M N] matrix containing M samples, N must match the dimensionality of the filter
+     @param MatrixDouble &output: the matrix the filtered samples will be written to, this can be the same matrix as data
+     @return true if the data was processed, false otherwise
+     */
+    virtual bool processBlock(const MatrixDouble &data,MatrixDouble &output);
+    
     /**
      Sets the PreProcessing reset function, overwriting the base PreProcessing function.
      This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
@@ -149,9 +169,18 @@ public:
      Filters the input, the dimensionality of the input vector should match that of the filter.
      
      @param const vector< double > &x: the values to filter, the dimensionality of the input vector should match that of the filter
-	 @return the filtered values.  An empty vector will be returned if the values were not filtered
+	 @return a reference to the filtered values, this is valid until the next call to the filter.  An empty vector will be returned if the values were not filtered
+     */
+    const vector< double >& filter(const vector< double > &x);
+    
+    /**
+     Filters a recording, one row (sample) at a time, continuing from the current state of the filter.
+     This is useful for filtering whole recordings at once, for example when preparing training data.
+     
+     @param const MatrixDouble &x: a [M N] matrix containing M samples, N must match the dimensionality of the filter
+	 @return the filtered samples.  An empty matrix will be returned if the values were not filtered
      */
-    vector< double > filter(const vector< double > &x);
+    MatrixDouble filter(const MatrixDouble &x);
     
     /**
      Sets the gain of the high pass filter.
@@ -201,13 +230,19 @@ public:
      
 	 @return the filtered values.  An empty vector will be returned if the values were not filtered
      */
-    vector< double > getFilteredValues(){ if( initialized ){ return yy; } return vector< double >(); }
+    vector< double > getFilteredValues(){ if( initialized ){ return processedData; } return vector< double >(); }
 
 protected:
+    /**
+     Filters one sample, updating processedData and the previous input and output values.
+     
+     @param const double *x: a pointer to the numInputDimensions values to filter
+     */
+    void filterSample(const double *x);
+    
     double filterFactor;        ///< The filter factor (alpha) of the filter
     double gain;                ///< The gain factor of the filter
-    vector< double > xx;        ///< The previous input value(s)
-	vector< double > yy;        ///< The previous output value(s)
+    IIRFilterBank filterBank;   ///< Runs the filter over all the dimensions, holding the previous input and output values
     
     static RegisterPreProcessingModule< HighPassFilter > registerModule;
 	
@@ -42,6 +42,7 @@ MovingAverageFilter::MovingAverageFilter(const MovingAverageFilter &rhs){
     //Zero this instance
     this->filterSize = 0;
     this->inputSampleCounter = 0;
+    this->writeIndex = 0;
     
 	//Copy the settings from the rhs instance
 	*this = rhs;
@@ -56,12 +57,18 @@ MovingAverageFilter& MovingAverageFilter::operator=(const MovingAverageFilter &r
         //Clear this instance
         this->filterSize = 0;
         this->inputSampleCounter = 0;
+        this->writeIndex = 0;
         this->dataBuffer.clear();
+        this->runningSum.clear();
         
         //Copy from the rhs instance
         if( rhs.initialized ){
             this->init( rhs.filterSize, rhs.numInputDimensions );
+            this->inputSampleCounter = rhs.inputSampleCounter;
+            this->writeIndex = rhs.writeIndex;
             this->dataBuffer = rhs.dataBuffer;
+            this->runningSum = rhs.runningSum;
+            this->processedData = rhs.processedData;
         }
         
         //Copy the preprocessing base variables
@@ -100,11 +107,31 @@ bool MovingAverageFilter::process(const VectorDouble &inputVector){
     }
 #endif
     
-    filter( inputVector );
+    filterSample( &inputVector[0] );
     
-    if( processedData.size() == numOutputDimensions ) return true;
+    return true;
+}
 
-    return false;
+bool MovingAverageFilter::processInPlace(VectorDouble &data){
+    
+#ifdef GRT_SAFE_CHECKING
+    if( !initialized ){
+        errorLog << "processInPlace(VectorDouble &data) - The filter has not been initialized!" << endl;
+        return false;
+    }
+
+    if( data.size() != numInputDimensions ){
+        errorLog << "processInPlace(VectorDouble &data) - The size of the data (" << data.size() << ") does not match that of the filter (" << numInputDimensions << ")!" << endl;
+        return false;
+    }
+#endif
+    
+    filterSample( &data[0] );
+    
+    //Copy the filtered values back over the input, data already has the right size so this does not allocate
+    std::copy( processedData.begin(), processedData.end(), data.begin() );
+    
+    return true;
 }
 
 bool MovingAverageFilter::reset(){
@@ -170,40 +197,35 @@ bool MovingAverageFilter::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_MOVING_AVERAGE_FILTER_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_MOVING_AVERAGE_FILTER_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
     
     //Load the number of input dimensions
-    file >> word;
-    if( word != "NumInputDimensions:" ){
+    if( !parser.matchWord("NumInputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
         return false;     
     }
-    file >> numInputDimensions;
+    parser >> numInputDimensions;
     
     //Load the number of output dimensions
-    file >> word;
-    if( word != "NumOutputDimensions:" ){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumOutputDimensions header!" << endl;
         return false;     
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
     
     //Load the filter factor
-    file >> word;
-    if( word != "FilterSize:" ){
+    if( !parser.matchWord("FilterSize:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read FilterSize header!" << endl;
         return false;     
     }
-    file >> filterSize;
+    parser >> filterSize;
     
     //Init the filter module to ensure everything is initialized correctly
     return init(filterSize,numInputDimensions);  
@@ -214,6 +236,7 @@ bool MovingAverageFilter::init(UINT filterSize,UINT numDimensions){
     //Cleanup the old memory
     initialized = false;
     inputSampleCounter = 0;
+    writeIndex = 0;
     
     if( filterSize == 0 ){
         errorLog << "init(UINT filterSize,UINT numDimensions) - Filter size can not be zero!" << endl;
@@ -231,11 +254,11 @@ bool MovingAverageFilter::init(UINT filterSize,UINT numDimensions){
     this->numOutputDimensions = numDimensions;
     processedData.clear();
     processedData.resize(numDimensions,0);
-    initialized = dataBuffer.resize( filterSize, VectorDouble(numInputDimensions,0) );
-    
-    if( !initialized ){
-        errorLog << "init(UINT filterSize,UINT numDimensions) - Failed to resize dataBuffer!" << endl;
-    }
+    dataBuffer.clear();
+    dataBuffer.resize(filterSize*numDimensions,0);
+    runningSum.clear();
+    runningSum.resize(numDimensions,0);
+    initialized = true;
     
     return initialized;
 }
@@ -248,43 +271,68 @@ double MovingAverageFilter::filter(double x){
         errorLog << "filter(double x) - The filter has not been initialized!" << endl;
         return 0;
     }
+    
+    if( numInputDimensions != 1 ){
+        errorLog << "filter(double x) - The dimensionality of the filter (" << numInputDimensions << ") is not 1!" << endl;
+        return 0;
+    }
 #endif
     
-    vector< double > y = filter(VectorDouble(1,x));
+    filterSample( &x );
     
-    if( y.size() == 0 ) return 0;
-    return y[0];
+    return processedData[0];
 }
     
-VectorDouble MovingAverageFilter::filter(const VectorDouble &x){
+const VectorDouble& MovingAverageFilter::filter(const VectorDouble &x){
     
 #ifdef GRT_SAFE_CHECKING
+    static const VectorDouble emptyVector;
+    
     //If the filter has not been initialised then return 0, otherwise filter x and return y
     if( !initialized ){
         errorLog << "filter(const VectorDouble &x) - The filter has not been initialized!" << endl;
-        return vector<double>();
+        return emptyVector;
     }
     
     if( x.size() != numInputDimensions ){
         errorLog << "filter(const VectorDouble &x) - The size of the input vector (" << x.size() << ") does not match that of the number of dimensions of the filter (" << numInputDimensions << ")!" << endl;
-        return vector<double>();
+        return emptyVector;
     }
 #endif
     
+    filterSample( &x[0] );
+    
+    return processedData;
+}
+    
+void MovingAverageFilter::filterSample(const double *x){
+    
     if( ++inputSampleCounter > filterSize ) inputSampleCounter = filterSize;
     
-    //Add the new value to the buffer
-    dataBuffer.push_back( x );
+    //Replace the oldest value in the window with the new value, the window starts as zeros so this also works before it is full
+    double *window = &dataBuffer[0];
+    for(UINT j=0; j<numInputDimensions; j++){
+        runningSum[j] += x[j] - window[ writeIndex ];
+        window[ writeIndex ] = x[j];
+        window += filterSize;
+    }
     
-    for(unsigned int j=0; j<numInputDimensions; j++){
-        processedData[j] = 0;
-        for(unsigned int i=0; i<inputSampleCounter; i++) {
-            processedData[j] += dataBuffer[i][j];
+    //Each time the window wraps around, recompute the sums so rounding errors can not build up
+    if( ++writeIndex == filterSize ){
+        writeIndex = 0;
+        window = &dataBuffer[0];
+        for(UINT j=0; j<numInputDimensions; j++){
+            double sum = 0;
+            for(UINT i=0; i<filterSize; i++) sum += window[i];
+            runningSum[j] = sum;
+            window += filterSize;
         }
-        processedData[j] /= double(inputSampleCounter);
     }
     
-    return processedData;
+    const double norm = 1.0 / double(inputSampleCounter);
+    for(UINT j=0; j<numInputDimensions; j++){
+        processedData[j] = runningSum[j] * norm;
+    }
 }
 
 }//End of namespace GRT
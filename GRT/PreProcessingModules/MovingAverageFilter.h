@@ -24,6 +24,10 @@
  
  @section DESCRIPTION
  The MovingAverageFilter implements a low pass moving average filter.
+
+ The filter keeps a running sum of the samples in its window, so each new sample only adds the new value and removes the oldest
+ one, and the cost of filtering a sample does not depend on the filter size. The running sum is recomputed from the window each
+ time the window wraps around, which stops rounding errors from building up over long streams.
  
  */
 #ifndef GRT_MOVING_AVERAGE_FILTER_HEADER
@@ -83,6 +87,15 @@ public:
      */
     virtual bool process(const VectorDouble &inputVector);
     
+    /**
+     Sets the PreProcessing processInPlace function, overwriting the base PreProcessing function.
+     This filters the data and writes the result straight back into the data vector, so no temporary vector is needed.
+     
+	 @param VectorDouble &data: the data to filter, this will be overwritten with the filtered values.  Must have the same dimensionality as the PreProcessing module
+	 @return true if the data was processed, false otherwise
+     */
+    virtual bool processInPlace(VectorDouble &data);
+    
     /**
      Sets the PreProcessing reset function, overwriting the base PreProcessing function.
      This function is called by the GestureRecognitionPipeline when the pipelines main reset() function is called.
@@ -149,9 +162,9 @@ public:
      Filters the input, the dimensionality of the input vector should match that of the filter.
      
      @param const VectorDouble  &x: the values to filter, the dimensionality of the input vector should match that of the filter
-	 @return the filtered values.  An empty vector will be returned if the values were not filtered
+	 @return a reference to the filtered values, this is valid until the next call to the filter.  An empty vector will be returned if the values were not filtered
      */
-    VectorDouble filter(const VectorDouble &x);
+    const VectorDouble& filter(const VectorDouble &x);
 
 	/**
      Gets the current filter size.
@@ -168,9 +181,18 @@ public:
     VectorDouble getFilteredData() const { return processedData; }
     
 protected:
+    /**
+     Adds one sample to the window and updates processedData with the new average.
+
+     @param const double *x: a pointer to the numInputDimensions values to filter
+     */
+    void filterSample(const double *x);
+
     UINT filterSize;                                        ///< The size of the filter
     UINT inputSampleCounter;                                ///< A counter to keep track of the number of input samples
-    CircularBuffer< VectorDouble > dataBuffer;          	///< A buffer to store the previous N values, N = filterSize
+    UINT writeIndex;                                        ///< The position in the window that the next sample will be written to
+    VectorDouble dataBuffer;                                ///< The previous N values of each dimension, N = filterSize, dimension j is stored at [j*filterSize (j+1)*filterSize)
+    VectorDouble runningSum;                                ///< The sum of the values in the window for each dimension
     
     static RegisterPreProcessingModule< MovingAverageFilter > registerModule;
 };
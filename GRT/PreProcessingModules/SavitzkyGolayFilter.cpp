@@ -20,6 +20,10 @@
 
 #include "SavitzkyGolayFilter.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace GRT{
     
 //Register the SavitzkyGolayFilter module with the PreProcessing base class
@@ -104,7 +108,7 @@ bool SavitzkyGolayFilter::process(const vector< double > &inputVector){
     }
 #endif
     
-    processedData = filter( inputVector );
+    filterSample( &inputVector[0] );
     
     if( processedData.size() == numOutputDimensions ) return true;
     return false;
@@ -113,7 +117,7 @@ bool SavitzkyGolayFilter::process(const vector< double > &inputVector){
 
 bool SavitzkyGolayFilter::reset(){
     if( initialized ){
-        data.setAllValues(vector<double>(numInputDimensions,0));
+        data.setAllValues(0);
         yy.clear();
         yy.resize(numInputDimensions,0);
         processedData.clear();
@@ -185,72 +189,63 @@ bool SavitzkyGolayFilter::loadSettingsFromFile(fstream &file){
         errorLog << "loadSettingsFromFile(fstream &file) - The file is not open!" << endl;
         return false;
     }
-    
-    string word;
+
+    FileTokenizer parser( file );
     
     //Load the header
-    file >> word;
-    
-    if( word != "GRT_SAVITZKY_GOLAY_FILTER_FILE_V1.0" ){
+    if( !parser.matchWord("GRT_SAVITZKY_GOLAY_FILTER_FILE_V1.0") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Invalid file format!" << endl;
         return false;     
     }
     
     //Load the number of input dimensions
-    file >> word;
-    if( word != "NumInputDimensions:" ){
+    if( !parser.matchWord("NumInputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumInputDimensions header!" << endl;
         return false;     
     }
-    file >> numInputDimensions;
+    parser >> numInputDimensions;
     
     //Load the number of output dimensions
-    file >> word;
-    if( word != "NumOutputDimensions:" ){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumOutputDimensions header!" << endl;
         return false;     
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
     
     //Load the numPoints
-    file >> word;
-    if( word != "NumPoints:" ){
+    if( !parser.matchWord("NumPoints:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumPoints header!" << endl;
         return false;     
     }
-    file >> numPoints;
+    parser >> numPoints;
     
     //Load the NumLeftHandPoints
-    file >> word;
-    if( word != "NumLeftHandPoints:" ){
+    if( !parser.matchWord("NumLeftHandPoints:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read NumLeftHandPoints header!" << endl;
         return false;     
     }
-    file >> numLeftHandPoints;
+    parser >> numLeftHandPoints;
     
     //Load the NumRightHandPoints
-    file >> word;
-    if( word != "NumRightHandPoints:" ){
+    if( !parser.matchWord("NumRightHandPoints:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read numRightHandPoints header!" << endl;
         return false;     
     }
-    file >> numRightHandPoints;
+    parser >> numRightHandPoints;
     
     //Load the DerivativeOrder
-    file >> word;
-    if( word != "DerivativeOrder:" ){
+    if( !parser.matchWord("DerivativeOrder:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read DerivativeOrder header!" << endl;
         return false;     
     }
-    file >> derivativeOrder;
+    parser >> derivativeOrder;
     
     //Load the SmoothingPolynomialOrder
-    file >> word;
-    if( word != "SmoothingPolynomialOrder:" ){
+    if( !parser.matchWord("SmoothingPolynomialOrder:") ){
         errorLog << "loadSettingsFromFile(fstream &file) - Failed to read SmoothingPolynomialOrder header!" << endl;
         return false;     
     }
-    file >> smoothingPolynomialOrder;
+    parser >> smoothingPolynomialOrder;
         
     //Init the filter module to ensure everything is initialized correctly
     return init(numLeftHandPoints,numRightHandPoints,derivativeOrder,smoothingPolynomialOrder,numInputDimensions);  
@@ -280,7 +275,7 @@ bool SavitzkyGolayFilter::init(UINT numLeftHandPoints,UINT numRightHandPoints,UI
     yy.resize(numDimensions,0);
     processedData.clear();
     processedData.resize(numDimensions,0);
-    data.resize(numPoints,vector<double>(numDimensions,0));
+    data.resize(numPoints,numDimensions,0);
     
     if( !calCoeff() ){
         errorLog << "init(UINT NL,UINT NR,UINT LD,UINT M,UINT numDimensions) - Failed to compute filter coefficents!" << endl;
@@ -293,10 +288,22 @@ bool SavitzkyGolayFilter::init(UINT numLeftHandPoints,UINT numRightHandPoints,UI
 }
 
 double SavitzkyGolayFilter::filter(double x){
-    vector< double > y = filter(vector<double>(1,x));
     
-    if( y.size() > 0 ) return y[0];
-	return 0;
+#ifdef GRT_SAFE_CHECKING
+    if( !initialized ){
+        errorLog << "filter(double x) - Not Initialized!" << endl;
+        return 0;
+    }
+    
+    if( numInputDimensions != 1 ){
+        errorLog << "filter(double x) - The dimensionality of the filter (" << numInputDimensions << ") is not 1!" << endl;
+        return 0;
+    }
+#endif
+    
+    filterSample( &x );
+    
+    return processedData[0];
 }
     
 vector< double > SavitzkyGolayFilter::filter(const vector< double > &x){
@@ -313,17 +320,58 @@ vector< double > SavitzkyGolayFilter::filter(const vector< double > &x){
     }
 #endif
     
+    filterSample( &x[0] );
+    
+    return processedData;
+}
+    
+void SavitzkyGolayFilter::filterSample(const double *x){
+    
     //Add the new input data to the data buffer
     data.push_back( x );
     
-    //Filter the data
-    for(UINT j=0; j<x.size(); j++){
-        processedData[j] = 0;
-        for(UINT i=0; i<numPoints; i++) 
-            processedData[j] += data[i][j] * coeff[i];
+    //The buffer window is contiguous, with the numInputDimensions values of each point stored together
+    const double *window = data.getWindow();
+    const double *c = &coeff[0];
+    double *y = &processedData[0];
+    const UINT D = numInputDimensions;
+    UINT i = 0;
+    
+    if( D == 1 ){
+        //Compute the dot product of the window and the coefficients, two points at a time
+        double sum = 0;
+#if defined(__SSE2__)
+        __m128d acc = _mm_setzero_pd();
+        for(; i+2 <= numPoints; i += 2){
+            acc = _mm_add_pd( acc, _mm_mul_pd( _mm_loadu_pd( window+i ), _mm_loadu_pd( c+i ) ) );
+        }
+        double partial[2];
+        _mm_storeu_pd( partial, acc );
+        sum = partial[0] + partial[1];
+#endif
+        for(; i<numPoints; i++){
+            sum += window[i] * c[i];
+        }
+        y[0] = sum;
+        return;
     }
     
-    return processedData;
+    //Filter all the dimensions at once, one point at a time
+    for(UINT j=0; j<D; j++) y[j] = 0;
+    for(i=0; i<numPoints; i++){
+        const double *point = window + i*D;
+        const double weight = c[i];
+        UINT j = 0;
+#if defined(__SSE2__)
+        const __m128d w = _mm_set1_pd( weight );
+        for(; j+2 <= D; j += 2){
+            _mm_storeu_pd( y+j, _mm_add_pd( _mm_loadu_pd( y+j ), _mm_mul_pd( w, _mm_loadu_pd( point+j ) ) ) );
+        }
+#endif
+        for(; j<D; j++){
+            y[j] += point[j] * weight;
+        }
+    }
 }
     
 bool SavitzkyGolayFilter::calCoeff(){
@@ -158,6 +158,13 @@ public:
     vector< double > getFilteredData(){ return processedData; }
 
 protected:
+    /**
+     Adds one sample to the buffer and updates processedData with the filtered values.
+     
+     @param const double *x: a pointer to the numInputDimensions values to filter
+     */
+    void filterSample(const double *x);
+    
     inline int min_(int a,int b) {return b < a ? (b) : (a);}
     inline double min_(double a,double b) {return b < a ? (b) : (a);}
     bool calCoeff();
@@ -167,7 +174,7 @@ protected:
 	UINT numRightHandPoints;                     //Num of rightward (future) points to use
 	UINT derivativeOrder;                        //Order of the derivative desired
 	UINT smoothingPolynomialOrder;               //Order of smoothing polynomial
-    CircularBuffer< vector< double > > data;    //A buffer to hold the input data
+    FrameBuffer data;    //A buffer to hold the input data
     vector < double > yy;                       //The filtered values
     vector < double > coeff;                    //Buffer for the filter coefficients
     
@@ -194,7 +194,7 @@ bool MLP::init(UINT numInputNeurons,UINT numHiddenNeurons,UINT numOutputNeurons,
     clear();
 
 	//Initialize the random seed
-	random.setSeed( (UINT)time(NULL) );
+	random.setSeed();
     
     if( numInputNeurons == 0 || numHiddenNeurons == 0 || numOutputNeurons == 0 ){
         if( numInputNeurons == 0 ){  errorLog << "init(...) - The number of input neurons is zero!" << endl; }
@@ -956,178 +956,157 @@ bool MLP::loadModelFromFile(fstream &file){
 		return false;
 	}
 
-	string word;
+	FileTokenizer parser( file );
 
 	//Check to make sure this is a file with the MLP File Format
-	file >> word;
-	if(word != "GRT_MLP_FILE_V1.0"){
+	if( !parser.matchWord("GRT_MLP_FILE_V1.0") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find file header!" << endl;
 		return false;
 	}
 
-	file >> word;
-	if(word != "NumInputNeurons:"){
+	if( !parser.matchWord("NumInputNeurons:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find NumInputNeurons!" << endl;
 		return false;
 	}
-	file >> numInputNeurons;
+	parser >> numInputNeurons;
 
-	file >> word;
-	if(word != "NumHiddenNeurons:"){
+	if( !parser.matchWord("NumHiddenNeurons:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find NumHiddenNeurons!" << endl;
 		return false;
 	}
-	file >> numHiddenNeurons;
+	parser >> numHiddenNeurons;
 
-	file >> word;
-	if(word != "NumOutputNeurons:"){
+	if( !parser.matchWord("NumOutputNeurons:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find NumOutputNeurons!" << endl;
 		return false;
 	}
-	file >> numOutputNeurons;
+	parser >> numOutputNeurons;
 
-	file >> word;
-	if(word != "InputLayerActivationFunction:"){
+	if( !parser.matchWord("InputLayerActivationFunction:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find InputLayerActivationFunction!" << endl;
 		return false;
 	}
-	file >> activationFunction;
+	parser >> activationFunction;
 	inputLayerActivationFunction = activationFunctionFromString(activationFunction);
 
-	file >> word;
-	if(word != "HiddenLayerActivationFunction:"){
+	if( !parser.matchWord("HiddenLayerActivationFunction:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find HiddenLayerActivationFunction!" << endl;
 		return false;
 	}
-	file >> activationFunction;
+	parser >> activationFunction;
 	hiddenLayerActivationFunction = activationFunctionFromString(activationFunction);
 
-	file >> word;
-	if(word != "OutputLayerActivationFunction:"){
+	if( !parser.matchWord("OutputLayerActivationFunction:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find OutputLayerActivationFunction!" << endl;
 		return false;
 	}
-	file >> activationFunction;
+	parser >> activationFunction;
 	outputLayerActivationFunction = activationFunctionFromString(activationFunction);
 
-	file >> word;
-	if(word != "MinNumEpochs:"){
+	if( !parser.matchWord("MinNumEpochs:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find MinNumEpochs!" << endl;
 		return false;
 	}
-	file >> minNumEpochs;
+	parser >> minNumEpochs;
 
-	file >> word;
-	if(word != "MaxNumEpochs:"){
+	if( !parser.matchWord("MaxNumEpochs:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find MaxNumEpochs!" << endl;
 		return false;
 	}
-	file >> maxNumEpochs;
+	parser >> maxNumEpochs;
 
-	file >> word;
-	if(word != "NumRandomTrainingIterations:"){
+	if( !parser.matchWord("NumRandomTrainingIterations:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find NumRandomTrainingIterations!" << endl;
 		return false;
 	}
-	file >> numRandomTrainingIterations;
+	parser >> numRandomTrainingIterations;
 
-	file >> word;
-	if(word != "ValidationSetSize:"){
+	if( !parser.matchWord("ValidationSetSize:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find ValidationSetSize!" << endl;
 		return false;
 	}
-	file >> validationSetSize;
+	parser >> validationSetSize;
 
-	file >> word;
-	if(word != "MinChange:"){
+	if( !parser.matchWord("MinChange:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find MinChange!" << endl;
 		return false;
 	}
-	file >> minChange;
+	parser >> minChange;
 
-	file >> word;
-	if(word != "TrainingRate:"){
+	if( !parser.matchWord("TrainingRate:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find TrainingRate!" << endl;
 		return false;
 	}
-	file >> trainingRate;
+	parser >> trainingRate;
 
-	file >> word;
-	if(word != "Momentum:"){
+	if( !parser.matchWord("Momentum:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find Momentum!" << endl;
 		return false;
 	}
-	file >> momentum;
+	parser >> momentum;
 
-	file >> word;
-	if(word != "Gamma:"){
+	if( !parser.matchWord("Gamma:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find Gamma!" << endl;
 		return false;
 	}
-	file >> gamma;
+	parser >> gamma;
 
-	file >> word;
-	if(word != "UseValidationSet:"){
+	if( !parser.matchWord("UseValidationSet:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find UseValidationSet!" << endl;
 		return false;
 	}
-	file >> useValidationSet;
+	parser >> useValidationSet;
 
-	file >> word;
-	if(word != "RandomiseTrainingOrder:"){
+	if( !parser.matchWord("RandomiseTrainingOrder:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find RandomiseTrainingOrder!" << endl;
 		return false;
 	}
-	file >> randomiseTrainingOrder;
+	parser >> randomiseTrainingOrder;
 
-	file >> word;
-	if(word != "UseScaling:"){
+	if( !parser.matchWord("UseScaling:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find UseScaling!" << endl;
 		return false;
 	}
-	file >> useScaling;
+	parser >> useScaling;
     
-    file >> word;
-	if(word != "ClassificationMode:"){
+    if( !parser.matchWord("ClassificationMode:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find ClassificationMode!" << endl;
 		return false;
 	}
-	file >> classificationModeActive;
+	parser >> classificationModeActive;
     
-    file >> word;
-	if(word != "UseNullRejection:"){
+    if( !parser.matchWord("UseNullRejection:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find UseNullRejection!" << endl;
 		return false;
 	}
-	file >> useNullRejection;
+	parser >> useNullRejection;
     
-    file >> word;
-	if(word != "RejectionThreshold:"){
+    if( !parser.matchWord("RejectionThreshold:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find RejectionThreshold!" << endl;
 		return false;
 	}
-	file >> nullRejectionThreshold;
+	parser >> nullRejectionThreshold;
 
 	//Resize the layers
 	inputLayer.resize( numInputNeurons );
@@ -1135,8 +1114,7 @@ bool MLP::loadModelFromFile(fstream &file){
 	outputLayer.resize( numOutputNeurons );
 
 	//Load the neuron data
-	file >> word;
-	if(word != "InputLayer:"){
+	if( !parser.matchWord("InputLayer:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find InputLayer!" << endl;
 		return false;
@@ -1145,13 +1123,12 @@ bool MLP::loadModelFromFile(fstream &file){
 	for(UINT i=0; i<numInputNeurons; i++){
 		UINT tempNeuronID = 0;
 
-		file >> word;
-		if(word != "InputNeuron:"){
+		if( !parser.matchWord("InputNeuron:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find InputNeuron!" << endl;
 			return false;
 		}
-		file >> tempNeuronID;
+		parser >> tempNeuronID;
 
 		if( tempNeuronID != i+1 ){
             file.close();
@@ -1159,48 +1136,43 @@ bool MLP::loadModelFromFile(fstream &file){
 			return false;
 		}
 
-		file >> word;
-		if(word != "NumInputs:"){
+		if( !parser.matchWord("NumInputs:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find NumInputs!" << endl;
 			return false;
 		}
-		file >> inputLayer[i].numInputs;
+		parser >> inputLayer[i].numInputs;
 
 		//Resize the buffers
 		inputLayer[i].weights.resize( inputLayer[i].numInputs );
 
-		file >> word;
-		if(word != "Bias:"){
+		if( !parser.matchWord("Bias:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Bias!" << endl;
 			return false;
 		}
-		file >> inputLayer[i].bias;
+		parser >> inputLayer[i].bias;
 
-		file >> word;
-		if(word != "Gamma:"){
+		if( !parser.matchWord("Gamma:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Gamma!" << endl;
 			return false;
 		}
-		file >> inputLayer[i].gamma;
+		parser >> inputLayer[i].gamma;
 
-		file >> word;
-		if(word != "Weights:"){
+		if( !parser.matchWord("Weights:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Weights!" << endl;
 			return false;
 		}
 
 		for(UINT j=0; j<inputLayer[i].numInputs; j++){
-			file >> inputLayer[i].weights[j];
+			parser >> inputLayer[i].weights[j];
 		}
 	}
 
 	//Load the Hidden Layer
-	file >> word;
-	if(word != "HiddenLayer:"){
+	if( !parser.matchWord("HiddenLayer:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find HiddenLayer!" << endl;
 		return false;
@@ -1209,13 +1181,12 @@ bool MLP::loadModelFromFile(fstream &file){
 	for(UINT i=0; i<numHiddenNeurons; i++){
 		UINT tempNeuronID = 0;
 
-		file >> word;
-		if(word != "HiddenNeuron:"){
+		if( !parser.matchWord("HiddenNeuron:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find HiddenNeuron!" << endl;
 			return false;
 		}
-		file >> tempNeuronID;
+		parser >> tempNeuronID;
 
 		if( tempNeuronID != i+1 ){
             file.close();
@@ -1223,48 +1194,43 @@ bool MLP::loadModelFromFile(fstream &file){
 			return false;
 		}
 
-		file >> word;
-		if(word != "NumInputs:"){
+		if( !parser.matchWord("NumInputs:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find NumInputs!" << endl;
 			return false;
 		}
-		file >> hiddenLayer[i].numInputs;
+		parser >> hiddenLayer[i].numInputs;
 
 		//Resize the buffers
 		hiddenLayer[i].weights.resize( hiddenLayer[i].numInputs );
 
-		file >> word;
-		if(word != "Bias:"){
+		if( !parser.matchWord("Bias:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Bias!" << endl;
 			return false;
 		}
-		file >> hiddenLayer[i].bias;
+		parser >> hiddenLayer[i].bias;
 
-		file >> word;
-		if(word != "Gamma:"){
+		if( !parser.matchWord("Gamma:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Gamma!" << endl;
 			return false;
 		}
-		file >> hiddenLayer[i].gamma;
+		parser >> hiddenLayer[i].gamma;
 
-		file >> word;
-		if(word != "Weights:"){
+		if( !parser.matchWord("Weights:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Weights!" << endl;
 			return false;
 		}
 
 		for(unsigned int j=0; j<hiddenLayer[i].numInputs; j++){
-			file >> hiddenLayer[i].weights[j];
+			parser >> hiddenLayer[i].weights[j];
 		}
 	}
 
 	//Load the Output Layer
-	file >> word;
-	if(word != "OutputLayer:"){
+	if( !parser.matchWord("OutputLayer:") ){
         file.close();
         errorLog << "loadModelFromFile(fstream &file) - Failed to find OutputLayer!" << endl;
 		return false;
@@ -1273,13 +1239,12 @@ bool MLP::loadModelFromFile(fstream &file){
 	for(UINT i=0; i<numOutputNeurons; i++){
 		UINT tempNeuronID = 0;
 
-		file >> word;
-		if(word != "OutputNeuron:"){
+		if( !parser.matchWord("OutputNeuron:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find OutputNeuron!" << endl;
 			return false;
 		}
-		file >> tempNeuronID;
+		parser >> tempNeuronID;
 
 		if( tempNeuronID != i+1 ){
             file.close();
@@ -1287,42 +1252,38 @@ bool MLP::loadModelFromFile(fstream &file){
 			return false;
 		}
 
-		file >> word;
-		if(word != "NumInputs:"){
+		if( !parser.matchWord("NumInputs:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find NumInputs!" << endl;
 			return false;
 		}
-		file >> outputLayer[i].numInputs;
+		parser >> outputLayer[i].numInputs;
 
 		//Resize the buffers
 		outputLayer[i].weights.resize( outputLayer[i].numInputs );
 
-		file >> word;
-		if(word != "Bias:"){
+		if( !parser.matchWord("Bias:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Bias!" << endl;
 			return false;
 		}
-		file >> outputLayer[i].bias;
+		parser >> outputLayer[i].bias;
 
-		file >> word;
-		if(word != "Gamma:"){
+		if( !parser.matchWord("Gamma:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Gamma!" << endl;
 			return false;
 		}
-		file >> outputLayer[i].gamma;
+		parser >> outputLayer[i].gamma;
 
-		file >> word;
-		if(word != "Weights:"){
+		if( !parser.matchWord("Weights:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find Weights!" << endl;
 			return false;
 		}
 
 		for(UINT j=0; j<outputLayer[i].numInputs; j++){
-			file >> outputLayer[i].weights[j];
+			parser >> outputLayer[i].weights[j];
 		}
 	}
 
@@ -1332,26 +1293,24 @@ bool MLP::loadModelFromFile(fstream &file){
 		targetVectorRanges.resize( numOutputNeurons );
 
 		//Load the ranges
-		file >> word;
-		if(word != "InputVectorRanges:"){
+		if( !parser.matchWord("InputVectorRanges:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find InputVectorRanges!" << endl;
 			return false;
 		}
 		for(UINT j=0; j<inputVectorRanges.size(); j++){
-			file >> inputVectorRanges[j].minValue;
-			file >> inputVectorRanges[j].maxValue;
+			parser >> inputVectorRanges[j].minValue;
+			parser >> inputVectorRanges[j].maxValue;
 		}
 
-		file >> word;
-		if(word != "OutputVectorRanges:"){
+		if( !parser.matchWord("OutputVectorRanges:") ){
             file.close();
             errorLog << "loadModelFromFile(fstream &file) - Failed to find OutputVectorRanges!" << endl;
 			return false;
 		}
 		for(UINT j=0; j<targetVectorRanges.size(); j++){
-			file >> targetVectorRanges[j].minValue;
-			file >> targetVectorRanges[j].maxValue;
+			parser >> targetVectorRanges[j].minValue;
+			parser >> targetVectorRanges[j].maxValue;
 		}
 	}
 
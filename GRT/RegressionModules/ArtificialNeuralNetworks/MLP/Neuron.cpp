@@ -41,7 +41,7 @@ void Neuron::init(unsigned int numInputs,unsigned int activationFunction){
 	previousUpdate.resize(numInputs);
     
     //Set the random seed
-    random.setSeed( (unsigned long long)time(NULL) );
+    random.setSeed();
     
     //Randomise the weights between [-0.1 0.1]
     //Note, it's better to set the random values using small weights rather than [-1.0 1.0]
@@ -22,6 +22,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace GRT{
 
+//The normal equations need O(M N^2) time, so above this many dimensions gradient descent is used instead
+#define LINEAR_REGRESSION_MAX_NORMAL_EQUATION_DIMENSIONS 100
+
 //Register the LinearRegression module with the Classifier base class
 RegisterRegressifierModule< LinearRegression >  LinearRegression::registerModule("LinearRegression");
 
@@ -31,6 +34,9 @@ LinearRegression::LinearRegression(bool useScaling)
     minChange = 1.0e-5;
     maxNumIterations = 500;
     learningRate = 0.01;
+    batchSize = 1;
+    useNormalEquations = true;
+    statelessPrediction = true;
     regressifierType = "LinearRegression";
     debugLog.setProceedingText("[DEBUG LinearRegression]");
     errorLog.setProceedingText("[ERROR LinearRegression]");
@@ -47,6 +53,8 @@ LinearRegression& LinearRegression::operator=(const LinearRegression &rhs){
         this->learningRate = rhs.learningRate;
         this->minChange = rhs.minChange;
         this->maxNumIterations = rhs.maxNumIterations;
+        this->batchSize = rhs.batchSize;
+        this->useNormalEquations = rhs.useNormalEquations;
         this->w0 = rhs.w0;
         this->w = rhs.w;
         
@@ -67,6 +75,8 @@ bool LinearRegression::deepCopyFrom(const Regressifier *regressifier){
 		this->learningRate = ptr->learningRate;
         this->minChange = ptr->minChange;
         this->maxNumIterations = ptr->maxNumIterations;
+        this->batchSize = ptr->batchSize;
+        this->useNormalEquations = ptr->useNormalEquations;
         this->w0 = ptr->w0;
         this->w = ptr->w;
         
@@ -119,77 +129,67 @@ bool LinearRegression::train(LabelledRegressionData trainingData){
         w[j] = rand.getRandomNumberUniform(-0.1,0.1);
     }
 
-    double error = 0;
-    double lastError = 0;
-    double delta = 0;
-    UINT iter = 0;
-    bool keepTraining = true;
-    vector< UINT > randomTrainingOrder(M);
-    TrainingResult result;
-    trainingResults.reserve(M);
-    
-    //In most cases, the training data is grouped into classes (100 samples for class 1, followed by 100 samples for class 2, etc.)
-    //This can cause a problem for stochastic gradient descent algorithm. To avoid this issue, we randomly shuffle the order of the
-    //training samples. This random order is then used at each epoch.
+    //Pack the training data into the trainer, so each epoch runs over one contiguous buffer
+    MatrixDouble data(M,N);
+    VectorDouble targets(M);
     for(UINT i=0; i<M; i++){
-        randomTrainingOrder[i] = i;
+        for(UINT j=0; j<N; j++){
+            data[i][j] = trainingData[i].getInputVectorValue(j);
+        }
+        targets[i] = trainingData[i].getTargetVectorValue(0);
     }
-    std::random_shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
     
-    //Run the main stochastic gradient descent training algorithm
-    while( keepTraining ){
-        
-        //Run one epoch of training using stochastic gradient descent
-        totalSquaredTrainingError = 0;
-        for(UINT m=0; m<M; m++){
-            
-            //Select the random sample
-            UINT i = randomTrainingOrder[m];
-            
-            //Compute the error, given the current weights
-            VectorDouble x = trainingData[i].getInputVector();
-            VectorDouble y = trainingData[i].getTargetVector();
-            double h = w0;
-            for(UINT j=0; j<N; j++){
-                h += x[j] * w[j];
-            }
-            error = y[0] - h;
-            totalSquaredTrainingError += SQR( error );
-            
-            //Update the weights
-            for(UINT j=0; j<N; j++){
-                w[j] += learningRate * error * x[j];
-            }
-            w0 += learningRate * error;
-        }
-        
-        //Compute the error
-        delta = fabs( totalSquaredTrainingError-lastError );
-        lastError = totalSquaredTrainingError;
-        
-        //Check to see if we should stop
-        if( delta <= minChange ){
-            keepTraining = false;
-        }
-        
-        if( isinf( totalSquaredTrainingError ) || isnan( totalSquaredTrainingError ) ){
-            errorLog << "train(LabelledRegressionData &trainingData) - Training failed! Total squared training error is NAN. If scaling is not enabled then you should try to scale your data and see if this solves the issue." << endl;
-            return false;
-        }
-        
-        if( ++iter >= maxNumIterations ){
-            keepTraining = false;
+    LinearModelTrainer trainer;
+    trainer.setOutputFunction( LinearModelTrainer::LINEAR_OUTPUT );
+    trainer.setErrorMeasure( LinearModelTrainer::SUM_OF_SQUARED_ERRORS );
+    trainer.setLearningRate( learningRate );
+    trainer.setMinChange( minChange );
+    trainer.setMaxNumIterations( maxNumIterations );
+    trainer.setBatchSize( batchSize );
+    if( !trainer.setTrainingData( data ) ){
+        errorLog << "train(LabelledRegressionData trainingData) - Failed to set the training data!" << endl;
+        return false;
+    }
+    
+    //If the number of dimensions is small then solve the weights directly with the normal equations,
+    //otherwise (or if the equations can not be solved) run the mini-batch gradient descent training algorithm
+    VectorDouble epochErrors;
+    bool trainingSucceeded = false;
+    if( useNormalEquations && N <= LINEAR_REGRESSION_MAX_NORMAL_EQUATION_DIMENSIONS ){
+        double squaredError = 0;
+        if( trainer.solveNormalEquations( targets, w, w0, squaredError ) ){
+            epochErrors.push_back( squaredError );
+            trainingSucceeded = true;
+        }else{
+            warningLog << "train(LabelledRegressionData trainingData) - Failed to solve the normal equations, using gradient descent instead." << endl;
         }
+    }
+    if( !trainingSucceeded ){
+        trainingSucceeded = trainer.train( targets, w, w0, epochErrors );
+    }
+    
+    //Store the training results
+    TrainingResult result;
+    trainingResults.reserve( epochErrors.size() );
+    double lastSquaredError = 0;
+    for(UINT iter=0; iter<epochErrors.size(); iter++){
+        totalSquaredTrainingError = epochErrors[iter];
+        const double delta = fabs( totalSquaredTrainingError-lastSquaredError );
+        lastSquaredError = totalSquaredTrainingError;
         
-        //Store the training results
         rootMeanSquaredTrainingError = sqrt( totalSquaredTrainingError / double(M) );
-        result.setRegressionResult(iter,totalSquaredTrainingError,rootMeanSquaredTrainingError);
+        result.setRegressionResult(iter+1,totalSquaredTrainingError,rootMeanSquaredTrainingError);
         trainingResults.push_back( result );
         
         //Notify any observers of the new training data
         trainingResultsObserverManager.notifyObservers( result );
         
-        trainingLog << "Epoch: " << iter << " SSE: " << totalSquaredTrainingError << " Delta: " << delta << endl;
+        trainingLog << "Epoch: " << iter+1 << " SSE: " << totalSquaredTrainingError << " Delta: " << delta << endl;
+    }
+    
+    if( !trainingSucceeded ){
+        errorLog << "train(LabelledRegressionData &trainingData) - Training failed! Total squared training error is NAN. If scaling is not enabled then you should try to scale your data and see if this solves the issue." << endl;
+        return false;
     }
     
     //Flag that the algorithm has been trained
@@ -199,6 +199,15 @@ bool LinearRegression::train(LabelledRegressionData trainingData){
 }
 
 bool LinearRegression::predict(VectorDouble inputVector){
+    return predict_( inputVector, regressionData );
+}
+
+bool LinearRegression::predictStateless(const VectorDouble &inputVector,VectorDouble &regressionData) const{
+    VectorDouble x = inputVector;
+    return predict_( x, regressionData );
+}
+
+bool LinearRegression::predict_(VectorDouble &inputVector,VectorDouble &outputData) const{
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
@@ -218,14 +227,16 @@ bool LinearRegression::predict(VectorDouble inputVector){
         }
     }
     
-    regressionData[0] =  w0;
+    if( outputData.size() != numOutputDimensions ) outputData.resize( numOutputDimensions );
+
+    outputData[0] =  w0;
     for(UINT j=0; j<numFeatures; j++){
-        regressionData[0] += inputVector[j] * w[j];
+        outputData[0] += inputVector[j] * w[j];
     }
     
     if( useScaling ){
         for(UINT n=0; n<numOutputDimensions; n++){
-            regressionData[n] = scale(regressionData[n], 0, 1, targetVectorRanges[n].minValue, targetVectorRanges[n].maxValue);
+            outputData[n] = scale(outputData[n], 0, 1, targetVectorRanges[n].minValue, targetVectorRanges[n].maxValue);
         }
     }
     
@@ -314,36 +325,32 @@ bool LinearRegression::loadModelFromFile(fstream &file){
         errorLog << "loadModelFromFile(string filename) - Could not open file to load model" << endl;
         return false;
     }
-    
-    std::string word;
+
+    FileTokenizer parser( file );
     
     //Find the file type header
-    file >> word;
-    if(word != "GRT_LINEAR_REGRESSION_MODEL_FILE_V1.0"){
+    if( !parser.matchWord("GRT_LINEAR_REGRESSION_MODEL_FILE_V1.0") ){
         errorLog << "loadModelFromFile(string filename) - Could not find Model File Header" << endl;
         return false;
     }
     
-    file >> word;
-    if(word != "NumFeatures:"){
+    if( !parser.matchWord("NumFeatures:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find NumFeatures!" << endl;
         return false;
     }
-    file >> numFeatures;
+    parser >> numFeatures;
     
-    file >> word;
-    if(word != "NumOutputDimensions:"){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find NumOutputDimensions!" << endl;
         return false;
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
     
-    file >> word;
-    if(word != "UseScaling:"){
+    if( !parser.matchWord("UseScaling:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find UseScaling!" << endl;
         return false;
     }
-    file >> useScaling;
+    parser >> useScaling;
     
     ///Read the ranges if needed
     if( useScaling ){
@@ -352,26 +359,24 @@ bool LinearRegression::loadModelFromFile(fstream &file){
         targetVectorRanges.resize(numOutputDimensions);
         
         //Load the ranges
-		file >> word;
-		if(word != "InputVectorRanges:"){
+		if( !parser.matchWord("InputVectorRanges:") ){
             file.close();
             errorLog << "loadModelFromFile(string filename) - Failed to find InputVectorRanges!" << endl;
 			return false;
 		}
 		for(UINT j=0; j<inputVectorRanges.size(); j++){
-			file >> inputVectorRanges[j].minValue;
-			file >> inputVectorRanges[j].maxValue;
+			parser >> inputVectorRanges[j].minValue;
+			parser >> inputVectorRanges[j].maxValue;
 		}
         
-		file >> word;
-		if(word != "OutputVectorRanges:"){
+		if( !parser.matchWord("OutputVectorRanges:") ){
 			file.close();
             errorLog << "loadModelFromFile(string filename) - Failed to find OutputVectorRanges!" << endl;
 			return false;
 		}
 		for(UINT j=0; j<targetVectorRanges.size(); j++){
-			file >> targetVectorRanges[j].minValue;
-			file >> targetVectorRanges[j].maxValue;
+			parser >> targetVectorRanges[j].minValue;
+			parser >> targetVectorRanges[j].maxValue;
 		}
     }
     
@@ -379,15 +384,14 @@ bool LinearRegression::loadModelFromFile(fstream &file){
     w.resize(numFeatures);
     
     //Load the weights
-    file >> word;
-    if(word != "Weights:"){
+    if( !parser.matchWord("Weights:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find the Weights!" << endl;
         return false;
     }
     
-    file >> w0;
+    parser >> w0;
     for(UINT j=0; j<numFeatures; j++){
-        file >> w[j];
+        parser >> w[j];
     
     }
     
@@ -424,6 +428,19 @@ bool LinearRegression::setMaxNumIterations(UINT maxNumIterations){
     return false;
 }
     
+bool LinearRegression::setBatchSize(UINT batchSize){
+    if( batchSize > 0 ){
+        this->batchSize = batchSize;
+        return true;
+    }
+    return false;
+}
+
+bool LinearRegression::setUseNormalEquations(bool useNormalEquations){
+    this->useNormalEquations = useNormalEquations;
+    return true;
+}
+
 double LinearRegression::getLearningRate(){
     return learningRate;
 }
@@ -435,6 +452,14 @@ double LinearRegression::getMinChange(){
 UINT LinearRegression::getMaxNumIterations(){
     return maxNumIterations;
 }
+    
+UINT LinearRegression::getBatchSize(){
+    return batchSize;
+}
+    
+bool LinearRegression::getUseNormalEquations(){
+    return useNormalEquations;
+}
 
 } //End of namespace GRT
 
@@ -25,12 +25,16 @@
  @section DESCRIPTION
  Linear Regression is a simple but effective regression algorithm that can map an N-dimensional signal 
  to a 1-dimensional signal.
+ 
+ If the number of input dimensions is small (100 or less) the weights are solved directly with the normal equations,
+ otherwise they are trained with mini-batch gradient descent. Call setUseNormalEquations(false) to always use gradient descent.
  */
 
 #ifndef GRT_LINEAR_REGRESSION_HEADER
 #define GRT_LINEAR_REGRESSION_HEADER
 
 #include "../../GestureRecognitionPipeline/Regressifier.h"
+#include "../../Util/LinearModelTrainer.h"
 
 namespace GRT{
 
@@ -83,6 +87,16 @@ public:
      @return returns true if the prediction was performed, false otherwise
     */
     virtual bool predict(VectorDouble inputVector);
+
+    /**
+     This performs the regression without changing the state of the model, so a trained model can be shared by many threads.
+     This overrides the predictStateless function in the Regressifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to map
+     @param VectorDouble &regressionData: returns the regression output
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictStateless(const VectorDouble &inputVector,VectorDouble &regressionData) const;
     
     /**
      This saves the trained Logistic Regression model to a file.
@@ -147,6 +161,25 @@ public:
      */
     bool setMaxNumIterations(UINT maxNumIterations);
     
+    /**
+     Sets the number of samples used for each gradient step during the training phase. With a batch size of 1 (the default)
+     the weights are updated after every sample, with a larger batch size the weights are updated with the mean gradient of each batch.
+     The batchSize value must be greater than zero.
+     
+     @param UINT batchSize: the number of samples in each batch, must be greater than zero
+     @return returns true if the value was updated successfully, false otherwise
+     */
+    bool setBatchSize(UINT batchSize);
+    
+    /**
+     Sets if the weights should be solved directly with the normal equations when the number of input dimensions is small
+     (100 or less). If this is false, or there are more dimensions, the weights are trained with gradient descent.
+     
+     @param bool useNormalEquations: sets if the normal equations should be used
+     @return returns true if the value was updated successfully, false otherwise
+     */
+    bool setUseNormalEquations(bool useNormalEquations);
+    
     /**
      Gets the current learningRate value, this is value used to update the weights at each step of the stochastic gradient descent.
      
@@ -168,12 +201,29 @@ public:
      @return returns the maxNumIterations value
      */
     UINT getMaxNumIterations();
+    
+    /**
+     Gets the current batchSize value, this is the number of samples used for each gradient step during the training phase.
+     
+     @return returns the batchSize value
+     */
+    UINT getBatchSize();
+    
+    /**
+     Gets if the weights will be solved directly with the normal equations when the number of input dimensions is small.
+     
+     @return returns true if the normal equations will be used, false otherwise
+     */
+    bool getUseNormalEquations();
 
 private:
+    bool predict_(VectorDouble &inputVector,VectorDouble &outputData) const;
 	
     double learningRate;
     double minChange;
     UINT maxNumIterations;
+    UINT batchSize;
+    bool useNormalEquations;
     double w0;
     VectorDouble w;
     static RegisterRegressifierModule< LinearRegression > registerModule;
@@ -31,6 +31,8 @@ LogisticRegression::LogisticRegression(bool useScaling)
     minChange = 1.0e-5;
     maxNumIterations = 500;
     learningRate = 0.01;
+    batchSize = 1;
+    statelessPrediction = true;
     regressifierType = "LogisticRegression";
     debugLog.setProceedingText("[DEBUG LogisticRegression]");
     errorLog.setProceedingText("[ERROR LogisticRegression]");
@@ -47,6 +49,7 @@ LogisticRegression& LogisticRegression::operator=(const LogisticRegression &rhs)
         this->learningRate = rhs.learningRate;
         this->minChange = rhs.minChange;
         this->maxNumIterations = rhs.maxNumIterations;
+        this->batchSize = rhs.batchSize;
         this->w0 = rhs.w0;
         this->w = rhs.w;
         
@@ -66,6 +69,7 @@ bool LogisticRegression::deepCopyFrom(const Regressifier *regressifier){
         this->learningRate = ptr->learningRate;
         this->minChange = ptr->minChange;
         this->maxNumIterations = ptr->maxNumIterations;
+        this->batchSize = ptr->batchSize;
         this->w0 = ptr->w0;
         this->w = ptr->w;
         
@@ -118,78 +122,54 @@ bool LogisticRegression::train(LabelledRegressionData trainingData){
         w[j] = rand.getRandomNumberUniform(-0.1,0.1);
     }
 
-    double error = 0;
-    double lastSquaredError = 0;
-    double delta = 0;
-    UINT iter = 0;
-    bool keepTraining = true;
-    Random random;
-    vector< UINT > randomTrainingOrder(M);
-    TrainingResult result;
-    trainingResults.reserve(M);
-    
-    //In most cases, the training data is grouped into classes (100 samples for class 1, followed by 100 samples for class 2, etc.)
-    //This can cause a problem for stochastic gradient descent algorithm. To avoid this issue, we randomly shuffle the order of the
-    //training samples. This random order is then used at each epoch.
+    //Pack the training data into the trainer, so each epoch runs over one contiguous buffer
+    MatrixDouble data(M,N);
+    VectorDouble targets(M);
     for(UINT i=0; i<M; i++){
-        randomTrainingOrder[i] = i;
+        for(UINT j=0; j<N; j++){
+            data[i][j] = trainingData[i].getInputVectorValue(j);
+        }
+        targets[i] = trainingData[i].getTargetVectorValue(0);
     }
-    std::random_shuffle(randomTrainingOrder.begin(), randomTrainingOrder.end());
     
-    //Run the main stochastic gradient descent training algorithm
-    while( keepTraining ){
-        
-        //Run one epoch of training using stochastic gradient descent
-        totalSquaredTrainingError = 0;
-        for(UINT m=0; m<M; m++){
-            
-            //Select the random sample
-            UINT i = randomTrainingOrder[m];
-            
-            //Compute the error, given the current weights
-            VectorDouble x = trainingData[i].getInputVector();
-            VectorDouble y = trainingData[i].getTargetVector();
-            double h = w0;
-            for(UINT j=0; j<N; j++){
-                h += x[j] * w[j];
-            }
-            error = y[0] - sigmoid( h );
-            totalSquaredTrainingError += SQR(error);
-            
-            //Update the weights
-            for(UINT j=0; j<N; j++){
-                w[j] += learningRate * error * x[j];
-            }
-            w0 += learningRate * error;
-        }
-        
-        //Compute the error
-        delta = fabs( totalSquaredTrainingError-lastSquaredError );
+    LinearModelTrainer trainer;
+    trainer.setOutputFunction( LinearModelTrainer::SIGMOID_OUTPUT );
+    trainer.setErrorMeasure( LinearModelTrainer::SUM_OF_SQUARED_ERRORS );
+    trainer.setLearningRate( learningRate );
+    trainer.setMinChange( minChange );
+    trainer.setMaxNumIterations( maxNumIterations );
+    trainer.setBatchSize( batchSize );
+    if( !trainer.setTrainingData( data ) ){
+        errorLog << "train(LabelledRegressionData trainingData) - Failed to set the training data!" << endl;
+        return false;
+    }
+    
+    //Run the mini-batch gradient descent training algorithm
+    VectorDouble epochErrors;
+    const bool trainingSucceeded = trainer.train( targets, w, w0, epochErrors );
+    
+    //Store the training results
+    TrainingResult result;
+    trainingResults.reserve( epochErrors.size() );
+    double lastSquaredError = 0;
+    for(UINT iter=0; iter<epochErrors.size(); iter++){
+        totalSquaredTrainingError = epochErrors[iter];
+        const double delta = fabs( totalSquaredTrainingError-lastSquaredError );
         lastSquaredError = totalSquaredTrainingError;
         
-        //Check to see if we should stop
-        if( delta <= minChange ){
-            keepTraining = false;
-        }
-        
-        if( ++iter >= maxNumIterations ){
-            keepTraining = false;
-        }
-        
-        if( isinf( totalSquaredTrainingError ) || isnan( totalSquaredTrainingError ) ){
-            errorLog << "train(LabelledRegressionData &trainingData) - Training failed! Total squared error is NAN. If scaling is not enabled then you should try to scale your data and see if this solves the issue." << endl;
-            return false;
-        }
-        
-        //Store the training results
         rootMeanSquaredTrainingError = sqrt( totalSquaredTrainingError / double(M) );
-        result.setRegressionResult(iter,totalSquaredTrainingError,rootMeanSquaredTrainingError);
+        result.setRegressionResult(iter+1,totalSquaredTrainingError,rootMeanSquaredTrainingError);
         trainingResults.push_back( result );
         
         //Notify any observers of the new training data
         trainingResultsObserverManager.notifyObservers( result );
         
-        trainingLog << "Epoch: " << iter << " SSE: " << totalSquaredTrainingError << " Delta: " << delta << endl;
+        trainingLog << "Epoch: " << iter+1 << " SSE: " << totalSquaredTrainingError << " Delta: " << delta << endl;
+    }
+    
+    if( !trainingSucceeded ){
+        errorLog << "train(LabelledRegressionData &trainingData) - Training failed! Total squared error is NAN. If scaling is not enabled then you should try to scale your data and see if this solves the issue." << endl;
+        return false;
     }
     
     //Flag that the algorithm has been trained
@@ -199,6 +179,15 @@ bool LogisticRegression::train(LabelledRegressionData trainingData){
 }
 
 bool LogisticRegression::predict(VectorDouble inputVector){
+    return predict_( inputVector, regressionData );
+}
+
+bool LogisticRegression::predictStateless(const VectorDouble &inputVector,VectorDouble &regressionData) const{
+    VectorDouble x = inputVector;
+    return predict_( x, regressionData );
+}
+
+bool LogisticRegression::predict_(VectorDouble &inputVector,VectorDouble &outputData) const{
     
     if( !trained ){
         errorLog << "predict(VectorDouble inputVector) - Model Not Trained!" << endl;
@@ -218,15 +207,17 @@ bool LogisticRegression::predict(VectorDouble inputVector){
         }
     }
     
-    regressionData[0] =  w0;
+    if( outputData.size() != numOutputDimensions ) outputData.resize( numOutputDimensions );
+
+    outputData[0] =  w0;
     for(UINT j=0; j<numFeatures; j++){
-        regressionData[0] += inputVector[j] * w[j];
+        outputData[0] += inputVector[j] * w[j];
     }
-	regressionData[0] = sigmoid( regressionData[0] );
+	outputData[0] = sigmoid( outputData[0] );
     
     if( useScaling ){
         for(UINT n=0; n<numOutputDimensions; n++){
-            regressionData[n] = scale(regressionData[n], 0, 1, targetVectorRanges[n].minValue, targetVectorRanges[n].maxValue);
+            outputData[n] = scale(outputData[n], 0, 1, targetVectorRanges[n].minValue, targetVectorRanges[n].maxValue);
         }
     }
     
@@ -315,36 +306,32 @@ bool LogisticRegression::loadModelFromFile(fstream &file){
         errorLog << "loadModelFromFile(string filename) - Could not open file to load model" << endl;
         return false;
     }
-    
-    std::string word;
+
+    FileTokenizer parser( file );
     
     //Find the file type header
-    file >> word;
-    if(word != "GRT_LOGISTIC_REGRESSION_MODEL_FILE_V1.0"){
+    if( !parser.matchWord("GRT_LOGISTIC_REGRESSION_MODEL_FILE_V1.0") ){
         errorLog << "loadModelFromFile(string filename) - Could not find Model File Header" << endl;
         return false;
     }
     
-    file >> word;
-    if(word != "NumFeatures:"){
+    if( !parser.matchWord("NumFeatures:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find NumFeatures!" << endl;
         return false;
     }
-    file >> numFeatures;
+    parser >> numFeatures;
     
-    file >> word;
-    if(word != "NumOutputDimensions:"){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find NumOutputDimensions!" << endl;
         return false;
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
     
-    file >> word;
-    if(word != "UseScaling:"){
+    if( !parser.matchWord("UseScaling:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find UseScaling!" << endl;
         return false;
     }
-    file >> useScaling;
+    parser >> useScaling;
     
     ///Read the ranges if needed
     if( useScaling ){
@@ -353,26 +340,24 @@ bool LogisticRegression::loadModelFromFile(fstream &file){
         targetVectorRanges.resize(numOutputDimensions);
         
         //Load the ranges
-		file >> word;
-		if(word != "InputVectorRanges:"){
+		if( !parser.matchWord("InputVectorRanges:") ){
 			file.close();
             errorLog << "loadModelFromFile(string filename) - Failed to find InputVectorRanges!" << endl;
 			return false;
 		}
 		for(UINT j=0; j<inputVectorRanges.size(); j++){
-			file >> inputVectorRanges[j].minValue;
-			file >> inputVectorRanges[j].maxValue;
+			parser >> inputVectorRanges[j].minValue;
+			parser >> inputVectorRanges[j].maxValue;
 		}
         
-		file >> word;
-		if(word != "OutputVectorRanges:"){
+		if( !parser.matchWord("OutputVectorRanges:") ){
 			file.close();
             errorLog << "loadModelFromFile(string filename) - Failed to find OutputVectorRanges!" << endl;
 			return false;
 		}
 		for(UINT j=0; j<targetVectorRanges.size(); j++){
-			file >> targetVectorRanges[j].minValue;
-			file >> targetVectorRanges[j].maxValue;
+			parser >> targetVectorRanges[j].minValue;
+			parser >> targetVectorRanges[j].maxValue;
 		}
     }
     
@@ -380,15 +365,14 @@ bool LogisticRegression::loadModelFromFile(fstream &file){
     w.resize(numFeatures);
     
     //Load the weights
-    file >> word;
-    if(word != "Weights:"){
+    if( !parser.matchWord("Weights:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find the Weights!" << endl;
         return false;
     }
     
-    file >> w0;
+    parser >> w0;
     for(UINT j=0; j<numFeatures; j++){
-        file >> w[j];
+        parser >> w[j];
     }
     
     //Resize the regression data vector
@@ -424,6 +408,14 @@ bool LogisticRegression::setMaxNumIterations(UINT maxNumIterations){
     return false;
 }
     
+bool LogisticRegression::setBatchSize(UINT batchSize){
+    if( batchSize > 0 ){
+        this->batchSize = batchSize;
+        return true;
+    }
+    return false;
+}
+
 double LogisticRegression::getLearningRate(){
     return learningRate;
 }
@@ -435,8 +427,12 @@ double LogisticRegression::getMinChange(){
 UINT LogisticRegression::getMaxNumIterations(){
     return maxNumIterations;
 }
+    
+UINT LogisticRegression::getBatchSize(){
+    return batchSize;
+}
 
-double LogisticRegression::sigmoid(double x){
+double LogisticRegression::sigmoid(double x) const{
 	return 1.0 / (1 + exp(-x));
 }
 
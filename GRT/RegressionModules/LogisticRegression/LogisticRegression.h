@@ -31,6 +31,7 @@
 #define GRT_LOGISTIC_REGRESSION_HEADER
 
 #include "../../GestureRecognitionPipeline/Regressifier.h"
+#include "../../Util/LinearModelTrainer.h"
 
 namespace GRT{
 
@@ -83,6 +84,16 @@ public:
      @return returns true if the prediction was performed, false otherwise
     */
     virtual bool predict(VectorDouble inputVector);
+
+    /**
+     This performs the regression without changing the state of the model, so a trained model can be shared by many threads.
+     This overrides the predictStateless function in the Regressifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to map
+     @param VectorDouble &regressionData: returns the regression output
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictStateless(const VectorDouble &inputVector,VectorDouble &regressionData) const;
     
     /**
      This saves the trained Logistic Regression model to a file.
@@ -147,6 +158,16 @@ public:
      */
     bool setMaxNumIterations(UINT maxNumIterations);
     
+    /**
+     Sets the number of samples used for each gradient step during the training phase. With a batch size of 1 (the default)
+     the weights are updated after every sample, with a larger batch size the weights are updated with the mean gradient of each batch.
+     The batchSize value must be greater than zero.
+     
+     @param UINT batchSize: the number of samples in each batch, must be greater than zero
+     @return returns true if the value was updated successfully, false otherwise
+     */
+    bool setBatchSize(UINT batchSize);
+    
     /**
      Gets the current learningRate value, this is value used to update the weights at each step of the stochastic gradient descent.
      
@@ -168,13 +189,22 @@ public:
      @return returns the maxNumIterations value
      */
     UINT getMaxNumIterations();
+    
+    /**
+     Gets the current batchSize value, this is the number of samples used for each gradient step during the training phase.
+     
+     @return returns the batchSize value
+     */
+    UINT getBatchSize();
 
 private:
-	inline double sigmoid(double x);
+    bool predict_(VectorDouble &inputVector,VectorDouble &outputData) const;
+	inline double sigmoid(double x) const;
 	
     double learningRate;
     double minChange;
     UINT maxNumIterations;
+    UINT batchSize;
     double w0;
     VectorDouble w;
     static RegisterRegressifierModule< LogisticRegression > registerModule;
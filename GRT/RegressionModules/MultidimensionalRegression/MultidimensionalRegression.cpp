@@ -200,6 +200,44 @@ bool MultidimensionalRegression::predict(VectorDouble inputVector){
     
     return true;
 }
+
+bool MultidimensionalRegression::predictStateless(const VectorDouble &inputVector,VectorDouble &regressionData) const{
+    
+    if( !trained ){
+        errorLog << "predictStateless(const VectorDouble &inputVector,VectorDouble &regressionData) - Model Not Trained!" << endl;
+        return false;
+    }
+    
+	if( inputVector.size() != numFeatures ){
+        errorLog << "predictStateless(const VectorDouble &inputVector,VectorDouble &regressionData) - The size of the input vector (" << int( inputVector.size() ) << ") does not match the num features in the model (" << numFeatures << endl;
+		return false;
+	}
+    
+    VectorDouble x = inputVector;
+    if( useScaling ){
+        for(UINT n=0; n<numFeatures; n++){
+            x[n] = scale(x[n], inputVectorRanges[n].minValue, inputVectorRanges[n].maxValue, 0, 1);
+        }
+    }
+    
+    regressionData.resize( numOutputDimensions );
+    VectorDouble moduleOutput;
+    for(UINT n=0; n<numOutputDimensions; n++){
+        if( !regressionModules[ n ]->predictStateless( x, moduleOutput ) ){
+            errorLog << "predictStateless(const VectorDouble &inputVector,VectorDouble &regressionData) - Failed to predict for regression module " << n << endl;
+            return false;
+        }
+        regressionData[ n ] = moduleOutput[0];
+    }
+    
+    if( useScaling ){
+        for(UINT n=0; n<numOutputDimensions; n++){
+            regressionData[n] = scale(regressionData[n], 0, 1, targetVectorRanges[n].minValue, targetVectorRanges[n].maxValue);
+        }
+    }
+    
+    return true;
+}
     
 bool MultidimensionalRegression::saveModelToFile(string filename){
 
@@ -295,36 +333,32 @@ bool MultidimensionalRegression::loadModelFromFile(fstream &file){
         errorLog << "loadModelFromFile(string filename) - Could not open file to load model" << endl;
         return false;
     }
-    
-    std::string word;
+
+    FileTokenizer parser( file );
     
     //Find the file type header
-    file >> word;
-    if(word != "GRT_MULTIDIMENSIONAL_REGRESSION_MODEL_FILE_V1.0"){
+    if( !parser.matchWord("GRT_MULTIDIMENSIONAL_REGRESSION_MODEL_FILE_V1.0") ){
         errorLog << "loadModelFromFile(string filename) - Could not find Model File Header" << endl;
         return false;
     }
     
-    file >> word;
-    if(word != "NumFeatures:"){
+    if( !parser.matchWord("NumFeatures:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find NumFeatures!" << endl;
         return false;
     }
-    file >> numFeatures;
+    parser >> numFeatures;
     
-    file >> word;
-    if(word != "NumOutputDimensions:"){
+    if( !parser.matchWord("NumOutputDimensions:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find NumOutputDimensions!" << endl;
         return false;
     }
-    file >> numOutputDimensions;
+    parser >> numOutputDimensions;
     
-    file >> word;
-    if(word != "UseScaling:"){
+    if( !parser.matchWord("UseScaling:") ){
         errorLog << "loadModelFromFile(string filename) - Could not find UseScaling!" << endl;
         return false;
     }
-    file >> useScaling;
+    parser >> useScaling;
     
     ///Read the ranges if needed
     if( useScaling ){
@@ -333,38 +367,35 @@ bool MultidimensionalRegression::loadModelFromFile(fstream &file){
         targetVectorRanges.resize(numOutputDimensions);
         
         //Load the ranges
-		file >> word;
-		if(word != "InputVectorRanges:"){
+		if( !parser.matchWord("InputVectorRanges:") ){
             file.close();
             errorLog << "loadModelFromFile(string filename) - Failed to find InputVectorRanges!" << endl;
 			return false;
 		}
 		for(UINT j=0; j<inputVectorRanges.size(); j++){
-			file >> inputVectorRanges[j].minValue;
-			file >> inputVectorRanges[j].maxValue;
+			parser >> inputVectorRanges[j].minValue;
+			parser >> inputVectorRanges[j].maxValue;
 		}
         
-		file >> word;
-		if(word != "OutputVectorRanges:"){
+		if( !parser.matchWord("OutputVectorRanges:") ){
 			file.close();
             errorLog << "loadModelFromFile(string filename) - Failed to find OutputVectorRanges!" << endl;
 			return false;
 		}
 		for(UINT j=0; j<targetVectorRanges.size(); j++){
-			file >> targetVectorRanges[j].minValue;
-			file >> targetVectorRanges[j].maxValue;
+			parser >> targetVectorRanges[j].minValue;
+			parser >> targetVectorRanges[j].maxValue;
 		}
     }
     
-    file >> word;
-    if( word != "Regressifier:" ){
+    if( !parser.matchWord("Regressifier:") ){
         errorLog << "loadModelFromFile(string filename) - Failed to find Regressifier!" << endl;
         return false;
     }
     
     //Load the regressifier type
     string regressifierType;
-    file >> regressifierType;
+    parser >> regressifierType;
     if( regressifierType == "NOT_SET" ){
         return true;
     }
@@ -426,6 +457,9 @@ bool MultidimensionalRegression::setRegressionModule( const Regressifier &regres
     
     if( this->regressifier == NULL ) return false;
     
+    //The predictions are only stateless if the predictions of the regression module are stateless
+    statelessPrediction = this->regressifier->getIsPredictionStateless();
+    
     return true;
 }
 
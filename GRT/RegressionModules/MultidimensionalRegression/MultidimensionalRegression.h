@@ -92,6 +92,17 @@ public:
      @return returns true if the prediction was performed, false otherwise
     */
     virtual bool predict(VectorDouble inputVector);
+
+    /**
+     This performs the regression without changing the state of the model, so a trained model can be shared by many threads. This is only
+     supported if the regression module used for each dimension supports stateless predictions.
+     This overrides the predictStateless function in the Regressifier base class.
+     
+     @param const VectorDouble &inputVector: the input vector to map
+     @param VectorDouble &regressionData: returns the regression output
+     @return returns true if the prediction was performed, false otherwise
+    */
+    virtual bool predictStateless(const VectorDouble &inputVector,VectorDouble &regressionData) const;
     
     /**
      This saves the trained Multidimensional Regression model to a file.
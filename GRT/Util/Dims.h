@@ -0,0 +1,132 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+ 
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ 
+ 
+ @section DESCRIPTION
+ The Dims class holds the distance functions used by the DTW and KNN classifiers, with the number of dimensions fixed at compile
+ time. Dims<3>::squaredEuclidean, for example, only handles 3 dimensional points, so the compiler can fully unroll (and vectorise)
+ the loop over the dimensions. Dims<0> handles any number of dimensions, which is passed in at run time.
+
+ Only DTW and KNN use these functions at the moment. Each of them picks the kernel inside its own distance code, calling Dims<1>,
+ Dims<2> or Dims<3> when the number of dimensions of its data matches (3 is the dimensionality of most accelerometer data) and
+ falling back to Dims<0> otherwise. All the specialisations compute the same values, summed in the same order as the generic version.
+
+ The fixed dimension variants have not been extended to the pre-processing filters or the feature extraction modules, and nothing is
+ selected when a pipeline is set up. The low and high pass filters (IIRFilterBank) and the SavitzkyGolayFilter already filter the
+ dimensions together with SSE2, and on 3 dimensional data a Dims<3> version of the MovingAverageFilter loop made no consistent
+ difference (between 1ns slower and 3ns faster, against the 16-20ns a processInPlace call takes). Extending Dims to those modules,
+ and picking the variant when a pipeline is initialized, is left as a follow-up should profiling show the per dimension loops matter.
+ */
+
+#ifndef GRT_DIMS_HEADER
+#define GRT_DIMS_HEADER
+
+#include <math.h>
+#include "GRTTypedefs.h"
+
+namespace GRT{
+
+template< UINT D >
+class Dims{
+public:
+    /**
+     Gets the number of dimensions handled by this class.
+
+     @param const UINT numDimensions: the number of dimensions of the data, this is only used if D is 0
+     @return returns D, or numDimensions if D is 0
+     */
+    static inline UINT size(const UINT numDimensions){ return D > 0 ? D : numDimensions; }
+
+    /**
+     Computes the squared Euclidean distance between a and b.
+
+     @param const double *a: a pointer to the first point
+     @param const double *b: a pointer to the second point
+     @param const UINT numDimensions: the number of dimensions of the points, this is only used if D is 0
+     @return returns the squared Euclidean distance between a and b
+     */
+    static inline double squaredEuclidean(const double *a,const double *b,const UINT numDimensions){
+        const UINT N = size( numDimensions );
+        double dist = 0;
+        for(UINT j=0; j<N; j++){
+            const double diff = a[j] - b[j];
+            dist += diff * diff;
+        }
+        return dist;
+    }
+
+    /**
+     Computes the Euclidean distance between a and b.
+
+     @param const double *a: a pointer to the first point
+     @param const double *b: a pointer to the second point
+     @param const UINT numDimensions: the number of dimensions of the points, this is only used if D is 0
+     @return returns the Euclidean distance between a and b
+     */
+    static inline double euclidean(const double *a,const double *b,const UINT numDimensions){
+        return sqrt( squaredEuclidean(a,b,numDimensions) );
+    }
+
+    /**
+     Computes the Manhattan (absolute) distance between a and b.
+
+     @param const double *a: a pointer to the first point
+     @param const double *b: a pointer to the second point
+     @param const UINT numDimensions: the number of dimensions of the points, this is only used if D is 0
+     @return returns the sum of the absolute differences between a and b
+     */
+    static inline double manhattan(const double *a,const double *b,const UINT numDimensions){
+        const UINT N = size( numDimensions );
+        double dist = 0;
+        for(UINT j=0; j<N; j++){
+            dist += fabs( a[j] - b[j] );
+        }
+        return dist;
+    }
+
+    /**
+     Computes the cosine similarity between a and b.
+
+     @param const double *a: a pointer to the first point
+     @param const double *b: a pointer to the second point
+     @param const UINT numDimensions: the number of dimensions of the points, this is only used if D is 0
+     @return returns the dot product of a and b divided by the product of their magnitudes
+     */
+    static inline double cosine(const double *a,const double *b,const UINT numDimensions){
+        const UINT N = size( numDimensions );
+        double dotAB = 0;
+        double magA = 0;
+        double magB = 0;
+        for(UINT j=0; j<N; j++){
+            dotAB += a[j] * b[j];
+            magA += a[j] * a[j];
+            magB += b[j] * b[j];
+        }
+        return dotAB / (sqrt(magA) * sqrt(magB));
+    }
+};
+
+}//End of namespace GRT
+
+#endif //GRT_DIMS_HEADER
@@ -0,0 +1,350 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FileTokenizer.h"
+#include <string.h>
+#include <locale.h>
+
+namespace GRT{
+
+//The powers of ten that can be represented exactly by a double
+static const double exactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+FileTokenizer::FileTokenizer(){
+    position = NULL;
+    endPosition = NULL;
+    streamBuffer = NULL;
+    failed = false;
+}
+
+FileTokenizer::FileTokenizer(istream &stream){
+    position = NULL;
+    endPosition = NULL;
+    streamBuffer = stream.good() ? stream.rdbuf() : NULL;
+    failed = streamBuffer == NULL;
+}
+
+FileTokenizer::~FileTokenizer(){
+    close();
+}
+
+bool FileTokenizer::open(const string &filename){
+
+    close();
+
+    if( !mappedFile.open( filename ) ){
+        failed = true;
+        return false;
+    }
+
+    position = mappedFile.getSize() > 0 ? mappedFile.getData() : "";
+    endPosition = position + mappedFile.getSize();
+
+    return true;
+}
+
+bool FileTokenizer::close(){
+    mappedFile.close();
+    position = NULL;
+    endPosition = NULL;
+    streamBuffer = NULL;
+    failed = false;
+    return true;
+}
+
+bool FileTokenizer::eof(){
+
+    if( streamBuffer != NULL ){
+        int c = streamBuffer->sgetc();
+        while( c != EOF && isWhiteSpace( c ) ){
+            c = streamBuffer->snextc();
+        }
+        return c == EOF;
+    }
+
+    if( position == NULL ) return true;
+
+    while( position != endPosition && isWhiteSpace( *position ) ){
+        ++position;
+    }
+    return position == endPosition;
+}
+
+bool FileTokenizer::readToken(const char *&token,size_t &length){
+
+    if( streamBuffer != NULL ){
+        //Skip any leading whitespace, then copy the token into the token buffer. The whitespace after the token is
+        //left in the stream, as the >> operator does
+        int c = streamBuffer->sgetc();
+        while( c != EOF && isWhiteSpace( c ) ){
+            c = streamBuffer->snextc();
+        }
+        if( c == EOF ) return false;
+
+        tokenBuffer.clear();
+        while( c != EOF && !isWhiteSpace( c ) ){
+            tokenBuffer.push_back( (char)c );
+            c = streamBuffer->snextc();
+        }
+        token = &tokenBuffer[0];
+        length = tokenBuffer.size();
+        return true;
+    }
+
+    if( position == NULL ) return false;
+
+    const char *p = position;
+    while( p != endPosition && isWhiteSpace( *p ) ){
+        ++p;
+    }
+    if( p == endPosition ){
+        position = p;
+        return false;
+    }
+
+    token = p;
+    while( p != endPosition && !isWhiteSpace( *p ) ){
+        ++p;
+    }
+    length = (size_t)(p - token);
+    position = p;
+    return true;
+}
+
+bool FileTokenizer::matchWord(const char *word){
+    const char *token = NULL;
+    size_t length = 0;
+    if( !readToken( token, length ) ) return false;
+    return strlen( word ) == length && memcmp( word, token, length ) == 0;
+}
+
+bool FileTokenizer::readValue(string &word){
+    const char *token = NULL;
+    size_t length = 0;
+    if( !readToken( token, length ) ) return false;
+    word.assign( token, length );
+    return true;
+}
+
+bool FileTokenizer::readValue(double &value){
+    const char *token = NULL;
+    size_t length = 0;
+    if( !readToken( token, length ) ) return false;
+    return parseDouble( token, token+length, value );
+}
+
+bool FileTokenizer::readValue(float &value){
+    double d = 0;
+    if( !readValue( d ) ) return false;
+    value = (float)d;
+    return true;
+}
+
+bool FileTokenizer::readValue(int &value){
+    bool negative = false;
+    unsigned long long magnitude = 0;
+    if( !readInteger( negative, magnitude ) ) return false;
+    if( magnitude > (unsigned long long)numeric_limits< int >::max() + (negative ? 1 : 0) ) return false;
+    value = negative ? (int)(0 - magnitude) : (int)magnitude;
+    return true;
+}
+
+bool FileTokenizer::readValue(unsigned int &value){
+    bool negative = false;
+    unsigned long long magnitude = 0;
+    if( !readInteger( negative, magnitude ) ) return false;
+    if( magnitude > numeric_limits< unsigned int >::max() ) return false;
+    //A negative value wraps around, as it does when it is read with the >> operator
+    value = negative ? (unsigned int)(0 - magnitude) : (unsigned int)magnitude;
+    return true;
+}
+
+bool FileTokenizer::readValue(long &value){
+    bool negative = false;
+    unsigned long long magnitude = 0;
+    if( !readInteger( negative, magnitude ) ) return false;
+    if( magnitude > (unsigned long long)numeric_limits< long >::max() + (negative ? 1 : 0) ) return false;
+    value = negative ? (long)(0 - magnitude) : (long)magnitude;
+    return true;
+}
+
+bool FileTokenizer::readValue(unsigned long &value){
+    bool negative = false;
+    unsigned long long magnitude = 0;
+    if( !readInteger( negative, magnitude ) ) return false;
+    if( magnitude > numeric_limits< unsigned long >::max() ) return false;
+    value = negative ? (unsigned long)(0 - magnitude) : (unsigned long)magnitude;
+    return true;
+}
+
+bool FileTokenizer::readValue(bool &value){
+    bool negative = false;
+    unsigned long long magnitude = 0;
+    if( !readInteger( negative, magnitude ) ) return false;
+    if( magnitude > 1 ) return false;
+    value = magnitude == 1;
+    return true;
+}
+
+bool FileTokenizer::readInteger(bool &negative,unsigned long long &magnitude){
+    const char *token = NULL;
+    size_t length = 0;
+    if( !readToken( token, length ) ) return false;
+    return parseInteger( token, token+length, negative, magnitude );
+}
+
+bool FileTokenizer::parseInteger(const char *begin,const char *end,bool &negative,unsigned long long &magnitude){
+
+    const char *p = begin;
+    negative = false;
+    magnitude = 0;
+
+    if( p != end && (*p == '-' || *p == '+') ){
+        negative = *p == '-';
+        ++p;
+    }
+    if( p == end ) return false;
+
+    const unsigned long long maxValue = numeric_limits< unsigned long long >::max();
+    while( p != end ){
+        const unsigned int digit = (unsigned int)(*p - '0');
+        if( digit > 9 ) return false;
+        if( magnitude > (maxValue - digit) / 10 ) return false;
+        magnitude = magnitude*10 + digit;
+        ++p;
+    }
+
+    return true;
+}
+
+bool FileTokenizer::parseDouble(const char *begin,const char *end,double &value){
+
+    const char *p = begin;
+    bool negative = false;
+    if( p != end && (*p == '-' || *p == '+') ){
+        negative = *p == '-';
+        ++p;
+    }
+
+    //Read up to 19 significant digits into the mantissa, the position of the decimal point is tracked by the exponent
+    unsigned long long mantissa = 0;
+    int numSignificantDigits = 0;
+    int exponent = 0;
+    bool foundDigits = false;
+    bool truncated = false;
+
+    while( p != end && (unsigned int)(*p - '0') <= 9 ){
+        if( numSignificantDigits < 19 ){
+            mantissa = mantissa*10 + (unsigned int)(*p - '0');
+            if( mantissa > 0 ) numSignificantDigits++;
+        }else{
+            exponent++;
+            if( *p != '0' ) truncated = true;
+        }
+        foundDigits = true;
+        ++p;
+    }
+
+    if( p != end && *p == '.' ){
+        ++p;
+        while( p != end && (unsigned int)(*p - '0') <= 9 ){
+            if( numSignificantDigits < 19 ){
+                mantissa = mantissa*10 + (unsigned int)(*p - '0');
+                if( mantissa > 0 ) numSignificantDigits++;
+                exponent--;
+            }else if( *p != '0' ) truncated = true;
+            foundDigits = true;
+            ++p;
+        }
+    }
+
+    //Anything else (such as inf or nan) is left to strtod
+    if( !foundDigits ) return parseDoubleSlow( begin, end, value );
+
+    if( p != end && (*p == 'e' || *p == 'E') ){
+        ++p;
+        bool negativeExponent = false;
+        if( p != end && (*p == '-' || *p == '+') ){
+            negativeExponent = *p == '-';
+            ++p;
+        }
+        if( p == end ) return false;
+        int e = 0;
+        while( p != end && (unsigned int)(*p - '0') <= 9 ){
+            if( e < 100000 ) e = e*10 + (*p - '0');
+            ++p;
+        }
+        exponent += negativeExponent ? -e : e;
+    }
+
+    if( p != end ) return false;
+
+    if( mantissa == 0 && !truncated ){
+        value = negative ? -0.0 : 0.0;
+        return true;
+    }
+
+    //If the mantissa and the power of ten are both exact doubles, a single multiply or divide gives the correctly rounded result
+    if( !truncated && mantissa <= (1ULL << 53) && exponent >= -22 && exponent <= 22 ){
+        double d = (double)mantissa;
+        if( exponent < 0 ) d /= exactPowersOfTen[ -exponent ];
+        else d *= exactPowersOfTen[ exponent ];
+        value = negative ? -d : d;
+        return true;
+    }
+
+    return parseDoubleSlow( begin, end, value );
+}
+
+bool FileTokenizer::parseDoubleSlow(const char *begin,const char *end,double &value){
+
+    const size_t length = (size_t)(end - begin);
+    if( length == 0 ) return false;
+
+    //strtod needs a null terminated string, and uses the decimal point of the current locale
+    char localBuffer[64];
+    vector< char > largeBuffer;
+    char *buffer = localBuffer;
+    if( length >= sizeof(localBuffer) ){
+        largeBuffer.resize( length+1 );
+        buffer = &largeBuffer[0];
+    }
+    memcpy( buffer, begin, length );
+    buffer[ length ] = '\0';
+
+    const char decimalPoint = localeconv()->decimal_point[0];
+    if( decimalPoint != '.' ){
+        for(size_t i=0; i<length; i++){
+            if( buffer[i] == '.' ) buffer[i] = decimalPoint;
+        }
+    }
+
+    char *parseEnd = NULL;
+    const double d = strtod( buffer, &parseEnd );
+    if( parseEnd != buffer+length ) return false;
+
+    value = d;
+    return true;
+}
+
+} //End of namespace GRT
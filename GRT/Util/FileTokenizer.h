@@ -0,0 +1,201 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The FileTokenizer reads the whitespace separated words and numbers in the GRT text file formats (the dataset files
+ and the model and settings files). It is used in place of the fstream >> operators, which are slow because every value
+ goes through the locale and every header keyword is copied into a temporary string.
+
+ The tokenizer works in one of two modes:
+ - open(filename) memory maps the whole file (or reads it into one buffer on platforms without mmap), and the tokens are
+   read directly from the mapped memory. This is used by the loadDatasetFromFile functions.
+ - FileTokenizer(stream) reads the tokens from the stream buffer of an open stream. The tokenizer only consumes the
+   characters of the tokens it reads, so it can be mixed with other functions that read from the same stream (this is
+   used by the loadModelFromFile and loadSettingsFromFile functions, which share one stream when a pipeline is loaded).
+
+ Numbers are parsed with a fast decimal parser that gives the same (correctly rounded) values as strtod. Numbers that
+ can not be parsed exactly by the fast path (more than 19 significant digits, very large or small exponents, inf or nan)
+ fall back to strtod. Numbers are always read with '.' as the decimal point, whatever the current locale is.
+
+ As with a stream, a read that fails sets the fail flag and leaves the value unchanged.
+ */
+
+#ifndef GRT_FILE_TOKENIZER_HEADER
+#define GRT_FILE_TOKENIZER_HEADER
+
+#include "GRTCommon.h"
+#include "MemoryMappedFile.h"
+
+namespace GRT{
+
+class FileTokenizer{
+public:
+    /**
+     Default Constructor, use open(filename) to map a file
+     */
+    FileTokenizer();
+
+    /**
+     Creates a tokenizer that reads from the stream buffer of the stream. The stream must stay open while the tokenizer is used.
+
+     @param istream &stream: the stream to read from
+     */
+    explicit FileTokenizer(istream &stream);
+
+    /**
+     Default Destructor, closes the file if it is open
+     */
+    ~FileTokenizer();
+
+    /**
+     Memory maps the file so its tokens can be read.
+
+     @param const string &filename: the name of the file to open
+     @return returns true if the file was opened, false otherwise
+     */
+    bool open(const string &filename);
+
+    /**
+     Unmaps the file (or detaches the tokenizer from the stream).
+
+     @return returns true if the tokenizer was closed
+     */
+    bool close();
+
+    /**
+     @return returns true if the tokenizer has a file or stream to read from, false otherwise
+     */
+    bool is_open() const{ return streamBuffer != NULL || position != NULL; }
+
+    /**
+     @return returns true if one of the reads has failed, false otherwise
+     */
+    bool fail() const{ return failed; }
+
+    /**
+     @return returns true if none of the reads have failed, false otherwise
+     */
+    bool good() const{ return !failed; }
+
+    /**
+     @return returns true if there are no more tokens to read, false otherwise
+     */
+    bool eof();
+
+    /**
+     Reads the next token. In the memory mapped mode the token points into the file, in the stream mode it points to an
+     internal buffer. Either way it is only valid until the next token is read, and it is not null terminated.
+
+     @param const char *&token: returns a pointer to the first character of the token
+     @param size_t &length: returns the number of characters in the token
+     @return returns true if a token was read, false if there are no more tokens
+     */
+    bool readToken(const char *&token,size_t &length);
+
+    /**
+     Reads the next token and checks if it matches the word, without copying the token into a string.
+
+     @param const char *word: the word the token should match
+     @return returns true if the next token matches the word, false otherwise (the token is still consumed)
+     */
+    bool matchWord(const char *word);
+
+    /**
+     Reads the next token into a string.
+
+     @param string &word: the string the token is written to
+     @return returns true if a token was read, false otherwise
+     */
+    bool readValue(string &word);
+
+    /**
+     Reads the next token as a number. The whole token must be a valid number.
+
+     @param value: the variable the number is written to
+     @return returns true if a number was read, false otherwise
+     */
+    bool readValue(double &value);
+    bool readValue(float &value);
+    bool readValue(int &value);
+    bool readValue(unsigned int &value);
+    bool readValue(long &value);
+    bool readValue(unsigned long &value);
+
+    /**
+     Reads a bool stored as 0 or 1 (as written by the fstream << operator).
+
+     @param bool &value: the variable the value is written to
+     @return returns true if a 0 or 1 was read, false otherwise
+     */
+    bool readValue(bool &value);
+
+    /**
+     Stream style read, sets the fail flag if the value can not be read.
+     */
+    template< class T > FileTokenizer& operator>>(T &value){
+        if( !failed && !readValue( value ) ) failed = true;
+        return *this;
+    }
+
+    /**
+     Parses a double from the characters in [begin end), all the characters must be part of the number.
+
+     @param const char *begin: a pointer to the first character
+     @param const char *end: a pointer to one past the last character
+     @param double &value: returns the parsed value
+     @return returns true if the characters were a valid number, false otherwise
+     */
+    static bool parseDouble(const char *begin,const char *end,double &value);
+
+    /**
+     Parses a signed integer from the characters in [begin end), all the characters must be part of the number.
+
+     @param const char *begin: a pointer to the first character
+     @param const char *end: a pointer to one past the last character
+     @param bool &negative: returns true if the number had a minus sign
+     @param unsigned long long &magnitude: returns the absolute value of the number
+     @return returns true if the characters were a valid integer that fits in 64 bits, false otherwise
+     */
+    static bool parseInteger(const char *begin,const char *end,bool &negative,unsigned long long &magnitude);
+
+protected:
+    static inline bool isWhiteSpace(const int c){ return c == ' ' || (c >= '\t' && c <= '\r'); }
+    static bool parseDoubleSlow(const char *begin,const char *end,double &value);
+    bool readInteger(bool &negative,unsigned long long &magnitude);
+
+    const char *position;                                   ///< The current position in the mapped file
+    const char *endPosition;                                ///< The end of the mapped file
+    MemoryMappedFile mappedFile;                            ///< The mapped file (file mode only)
+    streambuf *streamBuffer;                                ///< The stream buffer of the stream (stream mode only)
+    vector< char > tokenBuffer;                             ///< Holds the current token in the stream mode
+    bool failed;                                            ///< True if one of the reads has failed
+
+private:
+    FileTokenizer(const FileTokenizer &rhs);
+    FileTokenizer& operator=(const FileTokenizer &rhs);
+};
+
+} //End of namespace GRT
+
+#endif //GRT_FILE_TOKENIZER_HEADER
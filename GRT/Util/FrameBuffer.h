@@ -0,0 +1,294 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+ 
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ 
+ @section DESCRIPTION
+ The FrameBuffer class is a circular buffer for frames of numeric data, such as the last N samples of a multi dimensional
+ signal. It works in the same way as a CircularBuffer< vector< double > >, but all the frames are stored in one contiguous
+ block of memory, so pushing a frame only copies its values into the buffer and never allocates memory.
+
+ The buffer has a power of two capacity, so the read and write positions wrap around with a mask rather than a modulo. Each
+ frame is also written to a mirrored copy of the buffer, which means the frames in the buffer can always be read as one
+ contiguous block (see getWindow()), with frame i starting at getWindow() + i*getNumDimensions(). This doubles the memory
+ used by the buffer and the cost of a write, but lets a module read its whole window without having to handle the wrap around.
+ */
+
+#ifndef GRT_FRAME_BUFFER_HEADER
+#define GRT_FRAME_BUFFER_HEADER
+#include <iostream>
+#include <vector>
+#include "ErrorLog.h"
+#include "CircularBuffer.h"
+using namespace std;
+
+namespace GRT{
+
+class FrameBuffer{
+public:
+
+    /**
+     Default Constructor
+     */
+    FrameBuffer(){
+        errorLog.setProceedingText("[ERROR: FrameBuffer]");
+        clear();
+    }
+
+    /**
+     Init Constructor. Resizes the buffer to hold bufferSize frames, each with numDimensions values.
+
+     @param const unsigned int bufferSize: sets the number of frames in the buffer
+     @param const unsigned int numDimensions: sets the number of values in each frame
+     @param const double defaultValue: the value every element in the buffer will be set to. Default defaultValue = 0
+     */
+    FrameBuffer(const unsigned int bufferSize,const unsigned int numDimensions,const double defaultValue = 0){
+        errorLog.setProceedingText("[ERROR: FrameBuffer]");
+        clear();
+        resize(bufferSize,numDimensions,defaultValue);
+    }
+
+    /**
+     Default Destructor.
+     */
+    ~FrameBuffer(){
+    }
+
+    /**
+     Returns the frame at the index, relative to the current read pointer. Before the buffer has been filled, index 0 is the
+     first frame that was pushed and the frames after the last pushed frame hold the default value, as with the CircularBuffer.
+
+     @param const unsigned int index: the index of the frame you want access to, should be in the range [0 bufferSize-1]
+     @return returns a pointer to the numDimensions values of the frame
+     */
+    inline const double* operator[](const unsigned int index) const{
+        return &buffer[ (readPtr + index) * numDimensions ];
+    }
+
+    /**
+     Resizes the buffer so it can hold bufferSize frames, each with numDimensions values, and sets all the values to the defaultValue.
+
+     @param const unsigned int bufferSize: the number of frames in the buffer, must be greater than zero
+     @param const unsigned int numDimensions: the number of values in each frame, must be greater than zero
+     @param const double defaultValue: the value every element in the buffer will be set to. Default defaultValue = 0
+     @return returns true if the buffer was resized, false otherwise
+     */
+    bool resize(const unsigned int bufferSize,const unsigned int numDimensions,const double defaultValue = 0){
+
+        //Cleanup the old memory
+        clear();
+
+        if( bufferSize == 0 || numDimensions == 0 ) return false;
+
+        //Round the capacity up to the next power of two, the buffer stores two copies of each frame
+        capacity = 1;
+        while( capacity < bufferSize ) capacity <<= 1;
+
+        this->bufferSize = bufferSize;
+        this->numDimensions = numDimensions;
+        this->defaultValue = defaultValue;
+        buffer.resize( 2 * capacity * numDimensions, defaultValue );
+        bufferInit = true;
+
+        return true;
+    }
+
+    /**
+     Pushes a new frame into the end of the buffer, this will move both the read and write pointers.
+
+     @param const double *frame: a pointer to the numDimensions values of the new frame
+     @return returns true if the frame was pushed, false otherwise
+     */
+    bool push_back(const double *frame){
+
+        if( !bufferInit ){
+            errorLog << "push_back(const double *frame) - Can't push_back frame to the buffer as the buffer has not been initialized!" << endl;
+            return false;
+        }
+
+        //Write the frame to both copies of the buffer
+        double *slot = &buffer[ writePtr * numDimensions ];
+        double *mirror = slot + capacity * numDimensions;
+        for(unsigned int j=0; j<numDimensions; j++){
+            slot[j] = frame[j];
+            mirror[j] = frame[j];
+        }
+
+        writePtr = (writePtr + 1) & (capacity - 1);
+
+        //Only update the read pointer once the buffer has been filled
+        if( numValuesInBuffer < bufferSize ) numValuesInBuffer++;
+        else readPtr = (readPtr + 1) & (capacity - 1);
+
+        return true;
+    }
+
+    /**
+     Pushes a new frame into the end of the buffer, this will move both the read and write pointers.
+
+     @param const vector< double > &frame: the new frame, the size of the frame must match the number of dimensions of the buffer
+     @return returns true if the frame was pushed, false otherwise
+     */
+    bool push_back(const vector< double > &frame){
+
+        if( !bufferInit ){
+            errorLog << "push_back(const vector< double > &frame) - Can't push_back frame to the buffer as the buffer has not been initialized!" << endl;
+            return false;
+        }
+
+        if( frame.size() != numDimensions ){
+            errorLog << "push_back(const vector< double > &frame) - The size of the frame (" << frame.size() << ") does not match the number of dimensions of the buffer (" << numDimensions << ")!" << endl;
+            return false;
+        }
+
+        return push_back( &frame[0] );
+    }
+
+    /**
+     Sets all the values in the buffer to the value.
+
+     @param const double value: the value that will be copied to all the elements in the buffer
+     @return returns true if the buffer was updated, false otherwise
+     */
+    bool setAllValues(const double value){
+        if( !bufferInit ){
+            return false;
+        }
+
+        std::fill( buffer.begin(), buffer.end(), value );
+
+        return true;
+    }
+
+    /**
+     Clears the buffer, setting the size to 0.
+     */
+    void clear(){
+        bufferSize = 0;
+        numDimensions = 0;
+        capacity = 0;
+        numValuesInBuffer = 0;
+        readPtr = 0;
+        writePtr = 0;
+        defaultValue = 0;
+        buffer.clear();
+        bufferInit = false;
+    }
+
+    /**
+     Gets the frames in the buffer as one contiguous block of memory. The block holds getSize() frames, frame i starts at
+     getWindow() + i*getNumDimensions(). The pointer is only valid until the next time the buffer is modified.
+
+     @return returns a pointer to the first value of frame 0, or NULL if the buffer has not been initialized
+     */
+    const double* getWindow() const{
+        if( !bufferInit ) return NULL;
+        return &buffer[ readPtr * numDimensions ];
+    }
+
+    /**
+     Gets all the frames in the buffer as a std::vector.
+
+     @return returns a vector with all the frames in the buffer
+     */
+    vector< vector< double > > getDataAsVector() const{
+        if( bufferInit ){
+            vector< vector< double > > data( bufferSize );
+            for(unsigned int i=0; i<bufferSize; i++){
+                const double *frame = (*this)[i];
+                data[i].assign( frame, frame + numDimensions );
+            }
+            return data;
+        }
+        return vector< vector< double > >();
+    }
+
+    /**
+     Copies the frames in the buffer into a CircularBuffer, with the same frames at the same indices.
+
+     @return returns a CircularBuffer with all the frames in the buffer
+     */
+    CircularBuffer< vector< double > > getDataAsCircularBuffer() const{
+        CircularBuffer< vector< double > > data;
+        if( !bufferInit ) return data;
+
+        data.resize( bufferSize, vector< double >(numDimensions,defaultValue) );
+        for(unsigned int i=0; i<bufferSize; i++){
+            const double *frame = (*this)[i];
+            if( i < numValuesInBuffer ) data.push_back( vector< double >(frame,frame+numDimensions) );
+            else data(i).assign( frame, frame + numDimensions );
+        }
+        return data;
+    }
+
+    /**
+     Returns true if the buffer has been initialized.
+
+     @return returns true if the buffer has been initialized, false otherwise
+     */
+    bool getInit() const { return bufferInit; }
+
+    /**
+     Returns true if the buffer has been filled. If the buffer has not been initialized then this function will always return false.
+
+     @return returns true if the buffer has been filled, false otherwise
+     */
+    bool getBufferFilled() const { return bufferInit ? numValuesInBuffer==bufferSize : false; }
+
+    /**
+     Returns the number of frames in the buffer.
+
+     @return returns the number of frames in the buffer
+     */
+    unsigned int getSize() const { return bufferInit ? bufferSize : 0; }
+
+    /**
+     Returns the number of values in each frame.
+
+     @return returns the number of values in each frame
+     */
+    unsigned int getNumDimensions() const { return bufferInit ? numDimensions : 0; }
+
+    /**
+     Returns the number of frames that have been pushed into the buffer, up to the size of the buffer.
+
+     @return returns the number of frames that have been pushed into the buffer
+     */
+    unsigned int getNumValuesInBuffer() const { return bufferInit ? numValuesInBuffer : 0; }
+
+protected:
+    unsigned int bufferSize;                    ///< The number of frames in the buffer
+    unsigned int numDimensions;                 ///< The number of values in each frame
+    unsigned int capacity;                      ///< The number of frames that can be stored, this is a power of two >= bufferSize
+    unsigned int numValuesInBuffer;             ///< The number of frames that have been pushed, up to bufferSize
+    unsigned int readPtr;                       ///< The position of frame 0
+    unsigned int writePtr;                      ///< The position the next frame will be written to
+    double defaultValue;                        ///< The value the buffer was filled with when it was resized
+    vector< double > buffer;                    ///< The frames, the first capacity frames are mirrored by the second capacity frames
+    bool bufferInit;
+
+    ErrorLog errorLog;
+};
+
+}//End of namespace GRT
+
+#endif //GRT_FRAME_BUFFER_HEADER
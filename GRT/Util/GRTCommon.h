@@ -116,6 +116,8 @@ inline double SIGN(const double &a, const double &b) {return (b >= 0 ? (a >= 0 ?
 #include "TestInstanceResult.h"
 #include "TestResult.h"
 #include "CircularBuffer.h"
+#include "FrameBuffer.h"
+#include "Dims.h"
 #include "Timer.h"
 #include "Random.h"
 #include "Util.h"
@@ -124,6 +126,8 @@ inline double SIGN(const double &a, const double &b) {return (b >= 0 ? (a >= 0 ?
 #include "LUDecomposition.h"
 #include "SVD.h"
 #include "FileParser.h"
+#include "MemoryMappedFile.h"
+#include "FileTokenizer.h"
 #include "ObserverManager.h"
 
 #endif //GRT_COMMON_HEADER
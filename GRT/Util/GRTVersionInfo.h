@@ -37,4 +37,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define __GRT_LINUX_BUILD__
 #endif
 
+//Check if the compiler supports C++11, this is used to enable multithreaded training
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1700)
+    #define GRT_CXX11_ENABLED
+#endif
+
 #endif //GRT_VERSION_INFO_HEADER
\ No newline at end of file
@@ -0,0 +1,184 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "IIRFilterBank.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace GRT{
+
+IIRFilterBank::IIRFilterBank(UINT numChannels){
+    this->numChannels = 0;
+    numSections = 0;
+    if( numChannels > 0 ) init( numChannels );
+}
+
+IIRFilterBank::~IIRFilterBank(){}
+
+bool IIRFilterBank::init(UINT numChannels){
+    if( numChannels == 0 ){
+        return false;
+    }
+    this->numChannels = numChannels;
+    clearSections();
+    return true;
+}
+
+bool IIRFilterBank::addSection(double b0,double b1,double b2,double a1,double a2){
+    if( numChannels == 0 ){
+        return false;
+    }
+    coefficients.push_back( b0 );
+    coefficients.push_back( b1 );
+    coefficients.push_back( b2 );
+    coefficients.push_back( a1 );
+    coefficients.push_back( a2 );
+    state.resize( state.size() + 4*numChannels, 0 );
+    numSections++;
+    return true;
+}
+
+bool IIRFilterBank::addLowPassSection(double cutoffFrequency,double sampleRate,double Q){
+    if( cutoffFrequency <= 0 || sampleRate <= 0 || cutoffFrequency >= sampleRate/2.0 || Q <= 0 ){
+        return false;
+    }
+    const double w0 = TWO_PI * cutoffFrequency / sampleRate;
+    const double cosW0 = cos( w0 );
+    const double alpha = sin( w0 ) / (2.0 * Q);
+    const double a0 = 1.0 + alpha;
+    return addSection( (1.0-cosW0)/2.0/a0, (1.0-cosW0)/a0, (1.0-cosW0)/2.0/a0, -2.0*cosW0/a0, (1.0-alpha)/a0 );
+}
+
+bool IIRFilterBank::addHighPassSection(double cutoffFrequency,double sampleRate,double Q){
+    if( cutoffFrequency <= 0 || sampleRate <= 0 || cutoffFrequency >= sampleRate/2.0 || Q <= 0 ){
+        return false;
+    }
+    const double w0 = TWO_PI * cutoffFrequency / sampleRate;
+    const double cosW0 = cos( w0 );
+    const double alpha = sin( w0 ) / (2.0 * Q);
+    const double a0 = 1.0 + alpha;
+    return addSection( (1.0+cosW0)/2.0/a0, -(1.0+cosW0)/a0, (1.0+cosW0)/2.0/a0, -2.0*cosW0/a0, (1.0-alpha)/a0 );
+}
+
+void IIRFilterBank::clearSections(){
+    numSections = 0;
+    coefficients.clear();
+    state.clear();
+}
+
+void IIRFilterBank::reset(){
+    std::fill(state.begin(),state.end(),0);
+}
+
+void IIRFilterBank::filter(const double *x,double *y){
+
+    const UINT C = numChannels;
+    const double *in = x;
+
+    if( numSections == 0 ){
+        if( y != x ) std::copy(x, x+C, y);
+        return;
+    }
+
+    for(UINT s=0; s<numSections; s++){
+        const double *c = &coefficients[ s*5 ];
+        double *x1 = &state[ s*4*C ];
+        double *x2 = x1 + C;
+        double *y1 = x2 + C;
+        double *y2 = y1 + C;
+        UINT j = 0;
+
+        if( c[2] == 0 && c[4] == 0 ){
+            //First order section, only x[n-1] and y[n-1] are needed
+#if defined(__SSE2__)
+            const __m128d b0 = _mm_set1_pd( c[0] ), b1 = _mm_set1_pd( c[1] ), a1 = _mm_set1_pd( c[3] );
+            for(; j+2 <= C; j += 2){
+                const __m128d xn = _mm_loadu_pd( in+j );
+                __m128d yn = _mm_add_pd( _mm_mul_pd( b0, xn ), _mm_mul_pd( b1, _mm_loadu_pd( x1+j ) ) );
+                yn = _mm_sub_pd( yn, _mm_mul_pd( a1, _mm_loadu_pd( y1+j ) ) );
+                _mm_storeu_pd( x1+j, xn );
+                _mm_storeu_pd( y1+j, yn );
+                _mm_storeu_pd( y+j, yn );
+            }
+#endif
+            for(; j<C; j++){
+                const double xn = in[j];
+                const double yn = c[0]*xn + c[1]*x1[j] - c[3]*y1[j];
+                x1[j] = xn;
+                y1[j] = yn;
+                y[j] = yn;
+            }
+        }else{
+#if defined(__SSE2__)
+            const __m128d b0 = _mm_set1_pd( c[0] ), b1 = _mm_set1_pd( c[1] ), b2 = _mm_set1_pd( c[2] );
+            const __m128d a1 = _mm_set1_pd( c[3] ), a2 = _mm_set1_pd( c[4] );
+            for(; j+2 <= C; j += 2){
+                const __m128d xn = _mm_loadu_pd( in+j );
+                const __m128d xn1 = _mm_loadu_pd( x1+j );
+                const __m128d yn1 = _mm_loadu_pd( y1+j );
+                __m128d yn = _mm_mul_pd( b0, xn );
+                yn = _mm_add_pd( yn, _mm_mul_pd( b1, xn1 ) );
+                yn = _mm_add_pd( yn, _mm_mul_pd( b2, _mm_loadu_pd( x2+j ) ) );
+                yn = _mm_sub_pd( yn, _mm_mul_pd( a1, yn1 ) );
+                yn = _mm_sub_pd( yn, _mm_mul_pd( a2, _mm_loadu_pd( y2+j ) ) );
+                _mm_storeu_pd( x2+j, xn1 );
+                _mm_storeu_pd( x1+j, xn );
+                _mm_storeu_pd( y2+j, yn1 );
+                _mm_storeu_pd( y1+j, yn );
+                _mm_storeu_pd( y+j, yn );
+            }
+#endif
+            for(; j<C; j++){
+                const double xn = in[j];
+                const double yn = c[0]*xn + c[1]*x1[j] + c[2]*x2[j] - c[3]*y1[j] - c[4]*y2[j];
+                x2[j] = x1[j];
+                x1[j] = xn;
+                y2[j] = y1[j];
+                y1[j] = yn;
+                y[j] = yn;
+            }
+        }
+
+        //The output of this section is the input of the next one
+        in = y;
+    }
+}
+
+bool IIRFilterBank::filter(const MatrixDouble &x,MatrixDouble &y){
+
+    if( numChannels == 0 || x.getNumCols() != numChannels ){
+        return false;
+    }
+
+    const UINT M = x.getNumRows();
+    if( &x != &y && (y.getNumRows() != M || y.getNumCols() != numChannels) ){
+        if( !y.resize(M, numChannels) ) return false;
+    }
+
+    for(UINT i=0; i<M; i++){
+        filter( x[i], y[i] );
+    }
+
+    return true;
+}
+
+} //End of namespace GRT
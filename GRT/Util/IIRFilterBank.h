@@ -0,0 +1,144 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+ 
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ 
+ 
+ @section DESCRIPTION
+ The IIRFilterBank class runs the same cascade of IIR filter sections over N channels of data in lockstep. Each section is a
+ biquad, y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] - a2*y[n-2], so a first order filter is a section with b2 and a2
+ set to zero. Sections can be added from their coefficients, or designed as low pass or high pass biquads from a cutoff
+ frequency and a Q factor.
+
+ The state of each section (the previous inputs and outputs) is stored channel by channel in one contiguous block, so the
+ channels are filtered together, two at a time with SSE2 when it is available. The filter bank can process one sample at a time
+ or a whole recording at once (for example when preparing training data), in both cases continuing from its current state.
+ */
+
+#ifndef GRT_IIR_FILTER_BANK_HEADER
+#define GRT_IIR_FILTER_BANK_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT{
+
+class IIRFilterBank{
+public:
+    /**
+     Default Constructor
+     
+     @param UINT numChannels: the number of channels to filter. Default numChannels = 0
+     */
+    IIRFilterBank(UINT numChannels = 0);
+
+    /**
+     Default Destructor
+     */
+    ~IIRFilterBank();
+
+    /**
+     Sets the number of channels, removing all the sections from the filter bank.
+
+     @param UINT numChannels: the number of channels to filter, must be greater than zero
+     @return returns true if the filter bank was initialized, false otherwise
+     */
+    bool init(UINT numChannels);
+
+    /**
+     Adds a section to the end of the cascade. The coefficients are normalized so that a0 is 1.
+
+     @param double b0: the coefficient of x[n]
+     @param double b1: the coefficient of x[n-1]
+     @param double b2: the coefficient of x[n-2]
+     @param double a1: the coefficient of y[n-1]
+     @param double a2: the coefficient of y[n-2]
+     @return returns true if the section was added, false otherwise
+     */
+    bool addSection(double b0,double b1,double b2,double a1,double a2);
+
+    /**
+     Adds a second order low pass section to the end of the cascade.
+
+     @param double cutoffFrequency: the cutoff frequency of the section (in Hz), must be below half the sample rate
+     @param double sampleRate: the sample rate of the data (in Hz)
+     @param double Q: the Q factor of the section, 1/sqrt(2) gives a Butterworth response. Default Q = 0.7071
+     @return returns true if the section was added, false otherwise
+     */
+    bool addLowPassSection(double cutoffFrequency,double sampleRate,double Q = 0.70710678118654752);
+
+    /**
+     Adds a second order high pass section to the end of the cascade.
+
+     @param double cutoffFrequency: the cutoff frequency of the section (in Hz), must be below half the sample rate
+     @param double sampleRate: the sample rate of the data (in Hz)
+     @param double Q: the Q factor of the section, 1/sqrt(2) gives a Butterworth response. Default Q = 0.7071
+     @return returns true if the section was added, false otherwise
+     */
+    bool addHighPassSection(double cutoffFrequency,double sampleRate,double Q = 0.70710678118654752);
+
+    /**
+     Removes all the sections from the filter bank, keeping the number of channels.
+     */
+    void clearSections();
+
+    /**
+     Sets the state of every section back to zero.
+     */
+    void reset();
+
+    /**
+     Filters one sample of all the channels.
+
+     @param const double *x: a pointer to the numChannels input values
+     @param double *y: a pointer to where the numChannels filtered values will be written, this can be the same as x
+     */
+    void filter(const double *x,double *y);
+
+    /**
+     Filters a recording, one row (sample) at a time, continuing from the current state of the filter bank.
+
+     @param const MatrixDouble &x: a [M numChannels] matrix containing the M samples to filter
+     @param MatrixDouble &y: the filtered samples will be written here, this will be resized if needed and can be the same as x
+     @return returns true if the data was filtered, false otherwise
+     */
+    bool filter(const MatrixDouble &x,MatrixDouble &y);
+
+    /**
+     @return returns the number of channels
+     */
+    UINT getNumChannels() const { return numChannels; }
+
+    /**
+     @return returns the number of sections in the cascade
+     */
+    UINT getNumSections() const { return numSections; }
+
+protected:
+    UINT numChannels;                   ///< The number of channels
+    UINT numSections;                   ///< The number of sections in the cascade
+    VectorDouble coefficients;          ///< The coefficients of each section, stored as [b0 b1 b2 a1 a2] per section
+    VectorDouble state;                 ///< The state of each section, stored as [x1 x2 y1 y2] per section, each holding numChannels values
+};
+
+} //End of namespace GRT
+
+#endif //GRT_IIR_FILTER_BANK_HEADER
@@ -0,0 +1,91 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LatencyHistogram.h"
+
+namespace GRT{
+
+LatencyHistogram::LatencyHistogram(){
+    counts.resize( NUM_BUCKETS, 0 );
+    numValues = 0;
+    totalValue = 0;
+    minValue = 0;
+    maxValue = 0;
+}
+
+LatencyHistogram::~LatencyHistogram(){
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &rhs){
+    if( rhs.numValues == 0 ) return;
+    for(UINT i=0; i<NUM_BUCKETS; i++){
+        counts[i] += rhs.counts[i];
+    }
+    if( numValues == 0 || rhs.minValue < minValue ) minValue = rhs.minValue;
+    if( rhs.maxValue > maxValue ) maxValue = rhs.maxValue;
+    totalValue += rhs.totalValue;
+    numValues += rhs.numValues;
+}
+
+void LatencyHistogram::reset(){
+    std::fill( counts.begin(), counts.end(), 0 );
+    numValues = 0;
+    totalValue = 0;
+    minValue = 0;
+    maxValue = 0;
+}
+
+double LatencyHistogram::getMean() const{
+    if( numValues == 0 ) return 0;
+    return double(totalValue) / double(numValues);
+}
+
+unsigned long long LatencyHistogram::getPercentile(const double percentile) const{
+
+    if( numValues == 0 ) return 0;
+
+    //Find the bucket that holds the value ranked at the percentile
+    const double p = percentile < 0 ? 0 : (percentile > 100 ? 100 : percentile);
+    unsigned long long rank = (unsigned long long)ceil( p / 100.0 * double(numValues) );
+    if( rank < 1 ) rank = 1;
+
+    unsigned long long total = 0;
+    for(UINT i=0; i<NUM_BUCKETS; i++){
+        total += counts[i];
+        if( total >= rank ){
+            const unsigned long long value = getBucketUpperValue( i );
+            if( value > maxValue ) return maxValue;
+            if( value < minValue ) return minValue;
+            return value;
+        }
+    }
+
+    return maxValue;
+}
+
+unsigned long long LatencyHistogram::getBucketUpperValue(const UINT bucketIndex){
+    if( bucketIndex < LINEAR_BUCKETS ) return bucketIndex;
+    const UINT exponent = SUB_BUCKET_BITS + (bucketIndex-LINEAR_BUCKETS) / HALF_BUCKETS;
+    const unsigned long long subBucket = HALF_BUCKETS + (bucketIndex-LINEAR_BUCKETS) % HALF_BUCKETS;
+    const UINT shift = exponent - SUB_BUCKET_BITS + 1;
+    return ((subBucket+1) << shift) - 1;
+}
+
+} //End of namespace GRT
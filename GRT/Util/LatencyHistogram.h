@@ -0,0 +1,137 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The LatencyHistogram records latencies (in nanoseconds) in a fixed number of log-linear buckets, in the same way as an HDR
+ histogram. Values below 64 are stored exactly, larger values are stored in 32 buckets per power of two, so any percentile is
+ reported to within about 3% of the true value. Recording a value does not allocate memory and takes a few instructions, so the
+ histogram can be used on the prediction path. Values larger than 2^41 nanoseconds (about 36 minutes) are stored in the top bucket.
+ */
+
+#ifndef GRT_LATENCY_HISTOGRAM_HEADER
+#define GRT_LATENCY_HISTOGRAM_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT{
+
+class LatencyHistogram{
+public:
+    /**
+     Default Constructor
+     */
+    LatencyHistogram();
+
+    /**
+     Default Destructor
+     */
+    ~LatencyHistogram();
+
+    /**
+     Records one latency.
+
+     @param const unsigned long long value: the latency in nanoseconds
+     */
+    void record(const unsigned long long value){
+        counts[ getBucketIndex( value ) ]++;
+        if( numValues == 0 || value < minValue ) minValue = value;
+        if( value > maxValue ) maxValue = value;
+        totalValue += value;
+        numValues++;
+    }
+
+    /**
+     Adds all the values recorded by the rhs histogram to this histogram.
+
+     @param const LatencyHistogram &rhs: another LatencyHistogram
+     */
+    void merge(const LatencyHistogram &rhs);
+
+    /**
+     Removes all the recorded values.
+     */
+    void reset();
+
+    /**
+     @return returns the number of values that have been recorded
+     */
+    unsigned long long getCount() const{ return numValues; }
+
+    /**
+     @return returns the sum of all the values that have been recorded, in nanoseconds
+     */
+    unsigned long long getTotal() const{ return totalValue; }
+
+    /**
+     @return returns the smallest value that has been recorded, or 0 if no values have been recorded
+     */
+    unsigned long long getMin() const{ return minValue; }
+
+    /**
+     @return returns the largest value that has been recorded, or 0 if no values have been recorded
+     */
+    unsigned long long getMax() const{ return maxValue; }
+
+    /**
+     @return returns the mean of the values that have been recorded, or 0 if no values have been recorded
+     */
+    double getMean() const;
+
+    /**
+     Gets the value at the percentile, this is the highest value that is in the same bucket as the value at the percentile.
+
+     @param const double percentile: the percentile, in the range [0 100]
+     @return returns the value at the percentile in nanoseconds, or 0 if no values have been recorded
+     */
+    unsigned long long getPercentile(const double percentile) const;
+
+protected:
+    enum{ SUB_BUCKET_BITS=6, LINEAR_BUCKETS=(1<<SUB_BUCKET_BITS), HALF_BUCKETS=(LINEAR_BUCKETS/2), MAX_EXPONENT=40,
+          NUM_BUCKETS=LINEAR_BUCKETS + (MAX_EXPONENT-SUB_BUCKET_BITS+1)*HALF_BUCKETS };
+
+    static UINT getBucketIndex(unsigned long long value){
+        if( value < LINEAR_BUCKETS ) return (UINT)value;
+        const unsigned long long maxStoredValue = (2ULL << MAX_EXPONENT) - 1;
+        if( value > maxStoredValue ) value = maxStoredValue;
+
+        //Find the position of the highest set bit
+        UINT exponent = SUB_BUCKET_BITS;
+        while( (value >> (exponent+1)) != 0 ) exponent++;
+
+        const UINT shift = exponent - SUB_BUCKET_BITS + 1;
+        return LINEAR_BUCKETS + (exponent-SUB_BUCKET_BITS)*HALF_BUCKETS + (UINT)(value >> shift) - HALF_BUCKETS;
+    }
+
+    static unsigned long long getBucketUpperValue(const UINT bucketIndex);
+
+    vector< unsigned long long > counts;
+    unsigned long long numValues;
+    unsigned long long totalValue;
+    unsigned long long minValue;
+    unsigned long long maxValue;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_LATENCY_HISTOGRAM_HEADER
@@ -0,0 +1,292 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LinearModelTrainer.h"
+
+namespace GRT{
+
+LinearModelTrainer::LinearModelTrainer():errorLog("[ERROR LinearModelTrainer]"){
+    M = 0;
+    N = 0;
+    outputFunction = LINEAR_OUTPUT;
+    errorMeasure = SUM_OF_SQUARED_ERRORS;
+    maxNumIterations = 1000;
+    batchSize = 1;
+    learningRate = 0.01;
+    minChange = 1.0e-5;
+}
+
+LinearModelTrainer::~LinearModelTrainer(){}
+
+bool LinearModelTrainer::setTrainingData(const MatrixDouble &trainingData){
+
+    clear();
+
+    if( trainingData.getNumRows() == 0 || trainingData.getNumCols() == 0 ){
+        errorLog << "setTrainingData(const MatrixDouble &trainingData) - The training data is empty!" << endl;
+        return false;
+    }
+
+    M = trainingData.getNumRows();
+    N = trainingData.getNumCols();
+    shuffleOrder();
+
+    data.resize( size_t(M)*N );
+    for(UINT i=0; i<M; i++){
+        const double *row = trainingData[ order[i] ];
+        std::copy( row, row+N, &data[ size_t(i)*N ] );
+    }
+
+    return true;
+}
+
+bool LinearModelTrainer::setTrainingData(const double *trainingData,const UINT numSamples,const UINT numDimensions){
+
+    clear();
+
+    if( trainingData == NULL || numSamples == 0 || numDimensions == 0 ){
+        errorLog << "setTrainingData(const double *trainingData,const UINT numSamples,const UINT numDimensions) - The training data is empty!" << endl;
+        return false;
+    }
+
+    M = numSamples;
+    N = numDimensions;
+    shuffleOrder();
+
+    data.resize( size_t(M)*N );
+    for(UINT i=0; i<M; i++){
+        const double *row = &trainingData[ size_t(order[i])*N ];
+        std::copy( row, row+N, &data[ size_t(i)*N ] );
+    }
+
+    return true;
+}
+
+void LinearModelTrainer::shuffleOrder(){
+
+    //In most cases, the training data is grouped into classes (100 samples for class 1, followed by 100 samples for class 2, etc.)
+    //This can cause a problem for stochastic gradient descent algorithm. To avoid this issue, we randomly shuffle the order of the
+    //training samples. The samples are packed in this order so each epoch reads the data from start to end.
+    order.resize(M);
+    for(UINT i=0; i<M; i++){
+        order[i] = i;
+    }
+    for(UINT i=M-1; i>0; i--){
+        std::swap( order[i], order[ random.getRandomNumberInt(0,i+1) ] );
+    }
+}
+
+void LinearModelTrainer::clear(){
+    M = 0;
+    N = 0;
+    data.clear();
+    order.clear();
+}
+
+bool LinearModelTrainer::train(const VectorDouble &targets,VectorDouble &w,double &w0,VectorDouble &epochErrors) const{
+
+    epochErrors.clear();
+
+    if( M == 0 || targets.size() != M || w.size() != N ){
+        return false;
+    }
+
+    //Put the targets in the same order as the packed data
+    VectorDouble y(M);
+    for(UINT i=0; i<M; i++){
+        y[i] = targets[ order[i] ];
+    }
+
+    VectorDouble gradient(N);
+    double *wPtr = &w[0];
+    double *gradientPtr = &gradient[0];
+    double lastError = 0;
+    UINT iter = 0;
+    bool keepTraining = true;
+
+    while( keepTraining ){
+
+        //Run one epoch of mini-batch gradient descent
+        double errorSum = 0;
+        double squaredErrorSum = 0;
+        for(UINT batchStart=0; batchStart<M; batchStart+=batchSize){
+            const UINT batchEnd = MIN( M, batchStart+batchSize );
+
+            //Accumulate the gradient of the batch, given the current weights
+            std::fill( gradient.begin(), gradient.end(), 0 );
+            double gradient0 = 0;
+            for(UINT i=batchStart; i<batchEnd; i++){
+                const double *x = &data[ size_t(i)*N ];
+                double h = w0 + dotProduct( x, wPtr, N );
+                if( outputFunction == SIGMOID_OUTPUT ) h = 1.0 / (1.0 + exp(-h));
+                const double error = y[i] - h;
+                errorSum += error;
+                squaredErrorSum += error*error;
+                for(UINT j=0; j<N; j++){
+                    gradientPtr[j] += error * x[j];
+                }
+                gradient0 += error;
+            }
+
+            //Update the weights using the mean gradient of the batch
+            const double stepSize = learningRate / double( batchEnd-batchStart );
+            for(UINT j=0; j<N; j++){
+                wPtr[j] += stepSize * gradientPtr[j];
+            }
+            w0 += stepSize * gradient0;
+        }
+
+        const double epochError = errorMeasure == SUM_OF_ERRORS ? errorSum : squaredErrorSum;
+        epochErrors.push_back( epochError );
+
+        if( isinf( squaredErrorSum ) || isnan( squaredErrorSum ) ){
+            return false;
+        }
+
+        //Check to see if we should stop
+        const double delta = fabs( epochError-lastError );
+        lastError = epochError;
+        if( delta <= minChange ){
+            keepTraining = false;
+        }
+
+        if( ++iter >= maxNumIterations ){
+            keepTraining = false;
+        }
+    }
+
+    return true;
+}
+
+bool LinearModelTrainer::solveNormalEquations(const VectorDouble &targets,VectorDouble &w,double &w0,double &totalSquaredError) const{
+
+    if( M == 0 || targets.size() != M ){
+        return false;
+    }
+
+    //Build X'X and X'y, where X is the training data with an extra column of ones for the bias (stored at index N)
+    const UINT D = N+1;
+    MatrixDouble xtx(D,D);
+    VectorDouble xty(D,0);
+    xtx.setAllValues(0);
+    for(UINT i=0; i<M; i++){
+        const double *x = &data[ size_t(i)*N ];
+        const double y = targets[ order[i] ];
+        for(UINT j=0; j<N; j++){
+            double *row = xtx[j];
+            const double xj = x[j];
+            for(UINT k=j; k<N; k++){
+                row[k] += xj * x[k];
+            }
+            row[N] += xj;
+            xty[j] += xj * y;
+        }
+        xty[N] += y;
+    }
+    xtx[N][N] = M;
+
+    //Fill the lower triangle and add a tiny ridge term so collinear or constant features can still be solved
+    double trace = 0;
+    for(UINT j=0; j<D; j++){
+        for(UINT k=0; k<j; k++){
+            xtx[j][k] = xtx[k][j];
+        }
+        trace += xtx[j][j];
+    }
+    const double ridge = 1.0e-10 * trace / D;
+    for(UINT j=0; j<D; j++){
+        xtx[j][j] += ridge;
+    }
+
+    Cholesky cholesky( xtx );
+    if( !cholesky.getSuccess() ){
+        errorLog << "solveNormalEquations(...) - Failed to decompose the normal equations!" << endl;
+        return false;
+    }
+
+    VectorDouble beta(D);
+    if( !cholesky.solve( xty, beta ) ){
+        errorLog << "solveNormalEquations(...) - Failed to solve the normal equations!" << endl;
+        return false;
+    }
+
+    w.resize(N);
+    std::copy( beta.begin(), beta.begin()+N, w.begin() );
+    w0 = beta[N];
+
+    //Compute the training error of the solution
+    totalSquaredError = 0;
+    for(UINT i=0; i<M; i++){
+        const double error = targets[ order[i] ] - (w0 + dotProduct( &data[ size_t(i)*N ], &w[0], N ));
+        totalSquaredError += error*error;
+    }
+
+    return !( isinf( totalSquaredError ) || isnan( totalSquaredError ) );
+}
+
+bool LinearModelTrainer::setOutputFunction(const UINT outputFunction){
+    if( outputFunction == LINEAR_OUTPUT || outputFunction == SIGMOID_OUTPUT ){
+        this->outputFunction = outputFunction;
+        return true;
+    }
+    return false;
+}
+
+bool LinearModelTrainer::setErrorMeasure(const UINT errorMeasure){
+    if( errorMeasure == SUM_OF_ERRORS || errorMeasure == SUM_OF_SQUARED_ERRORS ){
+        this->errorMeasure = errorMeasure;
+        return true;
+    }
+    return false;
+}
+
+bool LinearModelTrainer::setLearningRate(const double learningRate){
+    if( learningRate > 0 ){
+        this->learningRate = learningRate;
+        return true;
+    }
+    return false;
+}
+
+bool LinearModelTrainer::setMinChange(const double minChange){
+    if( minChange >= 0 ){
+        this->minChange = minChange;
+        return true;
+    }
+    return false;
+}
+
+bool LinearModelTrainer::setMaxNumIterations(const UINT maxNumIterations){
+    if( maxNumIterations > 0 ){
+        this->maxNumIterations = maxNumIterations;
+        return true;
+    }
+    return false;
+}
+
+bool LinearModelTrainer::setBatchSize(const UINT batchSize){
+    if( batchSize > 0 ){
+        this->batchSize = batchSize;
+        return true;
+    }
+    return false;
+}
+
+} //End of namespace GRT
@@ -0,0 +1,157 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The LinearModelTrainer trains the weights of a linear model, y = f(w0 + w.x), where f is either the identity
+ (linear regression) or the sigmoid function (logistic regression). It is used by the Softmax, LogisticRegression
+ and LinearRegression modules.
+
+ The training data is set once and packed into one contiguous buffer (in a random order, to stop the gradient descent
+ seeing the samples grouped by class), so several models can be trained on the same data with different targets.
+ The weights are trained with mini-batch gradient descent; with a batch size of 1 this is standard stochastic
+ gradient descent, with larger batches the weights are updated with the mean gradient of each batch. A linear
+ model can also be solved in closed form with the normal equations.
+
+ The train and solveNormalEquations functions do not modify the trainer, so several models can be trained from
+ different threads at the same time.
+ */
+
+#ifndef GRT_LINEAR_MODEL_TRAINER_HEADER
+#define GRT_LINEAR_MODEL_TRAINER_HEADER
+
+#include "GRTCommon.h"
+#include "Cholesky.h"
+
+namespace GRT{
+
+class LinearModelTrainer{
+public:
+    /**
+     Default Constructor
+     */
+    LinearModelTrainer();
+
+    /**
+     Default Destructor
+     */
+    ~LinearModelTrainer();
+
+    /**
+     Sets the training data, this packs the samples into the trainer in a random order.
+
+     @param const MatrixDouble &data: a [M N] matrix containing the M training samples
+     @return returns true if the data was set, false otherwise
+     */
+    bool setTrainingData(const MatrixDouble &data);
+
+    /**
+     Sets the training data from a contiguous buffer, this packs the samples into the trainer in a random order.
+
+     @param const double *data: a pointer to the M*N training values, stored one sample after another
+     @param const UINT numSamples: the number of training samples (M)
+     @param const UINT numDimensions: the number of dimensions of each sample (N)
+     @return returns true if the data was set, false otherwise
+     */
+    bool setTrainingData(const double *data,const UINT numSamples,const UINT numDimensions);
+
+    /**
+     Clears the training data from the trainer.
+     */
+    void clear();
+
+    /**
+     Trains the weights of a linear model using mini-batch gradient descent. The weights should be initialized before
+     this is called. Training stops when the change in the error between two epochs is less than minChange, or after
+     maxNumIterations epochs.
+
+     @param const VectorDouble &targets: the M target values, in the same order as the rows of the training data
+     @param VectorDouble &w: the N weights of the model, these will be updated
+     @param double &w0: the bias of the model, this will be updated
+     @param VectorDouble &epochErrors: the error of each epoch will be written here (using the current ErrorMeasure)
+     @return returns true if the model was trained, false if the data is not set or the training error became NAN or INF
+     */
+    bool train(const VectorDouble &targets,VectorDouble &w,double &w0,VectorDouble &epochErrors) const;
+
+    /**
+     Solves the weights of a linear model (using the identity output function) with the normal equations. This needs
+     O(M N^2) time, so it should only be used when the number of dimensions is small.
+
+     @param const VectorDouble &targets: the M target values, in the same order as the rows of the training data
+     @param VectorDouble &w: the N weights of the model will be written here
+     @param double &w0: the bias of the model will be written here
+     @param double &totalSquaredError: the total squared error of the solved model over the training data
+     @return returns true if the model was solved, false if the data is not set or the system could not be solved
+     */
+    bool solveNormalEquations(const VectorDouble &targets,VectorDouble &w,double &w0,double &totalSquaredError) const;
+
+    bool setOutputFunction(const UINT outputFunction);
+    bool setErrorMeasure(const UINT errorMeasure);
+    bool setLearningRate(const double learningRate);
+    bool setMinChange(const double minChange);
+    bool setMaxNumIterations(const UINT maxNumIterations);
+    bool setBatchSize(const UINT batchSize);
+
+    UINT getNumSamples() const { return M; }
+    UINT getNumDimensions() const { return N; }
+    UINT getBatchSize() const { return batchSize; }
+
+    enum OutputFunctions{LINEAR_OUTPUT=0,SIGMOID_OUTPUT};
+    enum ErrorMeasures{SUM_OF_ERRORS=0,SUM_OF_SQUARED_ERRORS};
+
+protected:
+    void shuffleOrder();
+
+    static inline double dotProduct(const double *a,const double *b,const UINT N){
+        double sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+        UINT j = 0;
+        for(; j+4<=N; j+=4){
+            sum0 += a[j]*b[j];
+            sum1 += a[j+1]*b[j+1];
+            sum2 += a[j+2]*b[j+2];
+            sum3 += a[j+3]*b[j+3];
+        }
+        for(; j<N; j++){
+            sum0 += a[j]*b[j];
+        }
+        return (sum0+sum1) + (sum2+sum3);
+    }
+
+    UINT M;                             ///< The number of training samples
+    UINT N;                             ///< The number of dimensions
+    UINT outputFunction;
+    UINT errorMeasure;
+    UINT maxNumIterations;
+    UINT batchSize;
+    double learningRate;
+    double minChange;
+    VectorDouble data;                  ///< The packed training data, laid out as [M][N] in the training order
+    vector< UINT > order;               ///< The row of the original data that each packed sample came from
+    Random random;
+
+    ErrorLog errorLog;
+};
+
+} //End of namespace GRT
+
+#endif //GRT_LINEAR_MODEL_TRAINER_HEADER
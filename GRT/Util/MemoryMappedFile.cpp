@@ -0,0 +1,109 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MemoryMappedFile.h"
+#include "GRTVersionInfo.h"
+#include <fstream>
+
+#ifndef __GRT_WINDOWS_BUILD__
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace GRT{
+
+MemoryMappedFile::MemoryMappedFile(){
+    data = NULL;
+    size = 0;
+    mappedAddress = NULL;
+    fileOpen = false;
+}
+
+MemoryMappedFile::~MemoryMappedFile(){
+    close();
+}
+
+bool MemoryMappedFile::open(const string &filename,bool sequentialAccess){
+
+    close();
+
+#ifndef __GRT_WINDOWS_BUILD__
+    int fd = ::open( filename.c_str(), O_RDONLY );
+    if( fd < 0 ) return false;
+
+    struct stat fileInfo;
+    if( fstat( fd, &fileInfo ) != 0 ){
+        ::close( fd );
+        return false;
+    }
+
+    //An empty file can not be mapped, but it is still a valid (empty) file
+    const size_t fileSize = (size_t)fileInfo.st_size;
+    if( fileSize > 0 ){
+        void *address = mmap( NULL, fileSize, PROT_READ, MAP_PRIVATE, fd, 0 );
+        if( address == MAP_FAILED ){
+            ::close( fd );
+            return false;
+        }
+        madvise( address, fileSize, sequentialAccess ? MADV_SEQUENTIAL : MADV_NORMAL );
+        mappedAddress = address;
+        data = (const char*)address;
+    }
+    ::close( fd );
+    size = fileSize;
+#else
+    ifstream file( filename.c_str(), ios::in | ios::binary );
+    if( !file.is_open() ) return false;
+
+    file.seekg( 0, ios::end );
+    const streamoff fileSize = file.tellg();
+    file.seekg( 0, ios::beg );
+    if( fileSize < 0 ) return false;
+
+    fileBuffer.resize( (size_t)fileSize );
+    if( fileSize > 0 && !file.read( &fileBuffer[0], fileSize ) ){
+        fileBuffer.clear();
+        return false;
+    }
+    data = fileSize > 0 ? &fileBuffer[0] : NULL;
+    size = (size_t)fileSize;
+#endif
+
+    fileOpen = true;
+    return true;
+}
+
+bool MemoryMappedFile::close(){
+#ifndef __GRT_WINDOWS_BUILD__
+    if( mappedAddress != NULL ){
+        munmap( mappedAddress, size );
+    }
+#endif
+    mappedAddress = NULL;
+    data = NULL;
+    size = 0;
+    fileBuffer.clear();
+    fileOpen = false;
+    return true;
+}
+
+} //End of namespace GRT
@@ -0,0 +1,98 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The MemoryMappedFile maps a whole file into memory (read only), so it can be read without copying it into a buffer.
+ The pages of the file are loaded by the OS as they are used, so files that are larger than the available RAM can be
+ mapped. On platforms without mmap the file is read into a single buffer instead.
+ */
+
+#ifndef GRT_MEMORY_MAPPED_FILE_HEADER
+#define GRT_MEMORY_MAPPED_FILE_HEADER
+
+#include <vector>
+#include <string>
+
+namespace GRT{
+
+using namespace std;
+
+class MemoryMappedFile{
+public:
+    /**
+     Default Constructor
+     */
+    MemoryMappedFile();
+
+    /**
+     Default Destructor, unmaps the file if it is open
+     */
+    ~MemoryMappedFile();
+
+    /**
+     Maps the file into memory, this will close any file that is already open.
+
+     @param const string &filename: the name of the file to map
+     @param bool sequentialAccess: if true, the OS is told that the file will be read from start to end
+     @return returns true if the file was mapped, false otherwise
+     */
+    bool open(const string &filename,bool sequentialAccess = true);
+
+    /**
+     Unmaps the file.
+
+     @return returns true if the file was closed
+     */
+    bool close();
+
+    /**
+     @return returns true if a file is open, false otherwise
+     */
+    bool is_open() const{ return fileOpen; }
+
+    /**
+     @return returns a pointer to the start of the file, this is only valid while the file is open (and may be NULL if the file is empty)
+     */
+    const char* getData() const{ return data; }
+
+    /**
+     @return returns the size of the file in bytes
+     */
+    size_t getSize() const{ return size; }
+
+protected:
+    const char *data;                                       ///< The start of the mapped file
+    size_t size;                                            ///< The size of the file in bytes
+    void *mappedAddress;                                    ///< The address of the memory map (NULL if the file was read into the fileBuffer)
+    vector< char > fileBuffer;                              ///< Holds the file contents on platforms without mmap
+    bool fileOpen;
+
+private:
+    MemoryMappedFile(const MemoryMappedFile &rhs);
+    MemoryMappedFile& operator=(const MemoryMappedFile &rhs);
+};
+
+} //End of namespace GRT
+
+#endif //GRT_MEMORY_MAPPED_FILE_HEADER
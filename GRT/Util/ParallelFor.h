@@ -0,0 +1,191 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The ParallelFor class splits a range of work items [0 numItems-1] into contiguous blocks and runs each block on
+ its own thread. The task can be any function object with the signature:
+
+    void operator()(UINT startIndex,UINT endIndex,UINT threadIndex);
+
+ which should process the items in the range [startIndex endIndex-1]. The threadIndex will be in the range
+ [0 numThreads-1], so a task can keep one scratch buffer per thread and merge them once run returns.
+
+ Threads are only used if the GRT is built with C++11 support (GRT_CXX11_ENABLED), otherwise the task is run on
+ the calling thread as a single block. A ParallelFor that is started from inside another ParallelFor task (for example
+ a classifier being trained inside a cross validation fold) also runs on the calling thread, so nested loops do not
+ start more threads than the machine has. If you use threads on Linux or OSX then you need to link with -pthread.
+
+ If the task throws an exception, run waits for every block to finish and then rethrows the exception from the first block
+ (in item order) that threw, so an exception never leaves worker threads running.
+ */
+
+#ifndef GRT_PARALLEL_FOR_HEADER
+#define GRT_PARALLEL_FOR_HEADER
+
+#include "GRTCommon.h"
+
+#ifdef GRT_CXX11_ENABLED
+#include <thread>
+#include <functional>
+#include <exception>
+#endif
+
+namespace GRT{
+
+class ParallelFor{
+public:
+
+    /**
+     Gets the number of threads that will be used to process numItems work items.
+
+     @param const UINT numItems: the number of work items
+     @param const UINT minItemsPerThread: the smallest block of work worth handing to a thread
+     @return returns the number of threads that will be used, this will always be at least 1
+     */
+    static UINT getNumThreads(const UINT numItems,const UINT minItemsPerThread=1){
+        if( getIsRunningTask() ) return 1;
+        UINT numThreads = getMaxNumThreads();
+        const UINT maxUsefulThreads = minItemsPerThread > 0 ? numItems / minItemsPerThread : numItems;
+        if( numThreads > maxUsefulThreads ) numThreads = maxUsefulThreads;
+        return numThreads > 0 ? numThreads : 1;
+    }
+
+    /**
+     Gets the maximum number of threads that can be used by the ParallelFor class. This is the number of hardware
+     threads (or the limit set by setMaxNumThreads), or 1 if C++11 support is not enabled.
+
+     @return returns the maximum number of threads
+     */
+    static UINT getMaxNumThreads(){
+#ifdef GRT_CXX11_ENABLED
+        UINT numThreads = getMaxNumThreadsLimit();
+        if( numThreads == 0 ) numThreads = (UINT)std::thread::hardware_concurrency();
+        return numThreads > 0 ? numThreads : 1;
+#else
+        return 1;
+#endif
+    }
+
+    /**
+     Sets the maximum number of threads that can be used by the ParallelFor class. Set this to 0 to use all the
+     hardware threads (the default), or 1 to run everything on the calling thread.
+
+     @param const UINT maxNumThreads: the maximum number of threads
+     @return returns true if the value was set
+     */
+    static bool setMaxNumThreads(const UINT maxNumThreads){
+        getMaxNumThreadsLimit() = maxNumThreads;
+        return true;
+    }
+
+    /**
+     Runs the task over the range [0 numItems-1].
+
+     @param const UINT numItems: the number of work items
+     @param Task &task: the function object that will process each block of work items
+     @param const UINT minItemsPerThread: the smallest block of work worth handing to a thread, this stops small jobs paying for the thread start up
+     @return returns the number of threads that were used
+     */
+    template< class Task >
+    static UINT run(const UINT numItems,Task &task,const UINT minItemsPerThread=1){
+
+        if( numItems == 0 ) return 0;
+
+        const UINT numThreads = getNumThreads(numItems,minItemsPerThread);
+
+        if( numThreads == 1 ){
+            task(0,numItems,0);
+            return 1;
+        }
+
+#ifdef GRT_CXX11_ENABLED
+        //Run the first block on the calling thread and the remaining blocks on worker threads. Each block keeps its own
+        //exception, and the joiner waits for the workers even if starting a thread or the first block throws
+        std::vector< std::exception_ptr > exceptions( numThreads );
+        {
+            ThreadJoiner joiner;
+            joiner.threads.reserve( numThreads-1 );
+            for(UINT t=1; t<numThreads; t++){
+                joiner.threads.push_back( std::thread( &runTask<Task>, std::ref(task), getBlockStart(numItems,numThreads,t), getBlockStart(numItems,numThreads,t+1), t, std::ref(exceptions[t]) ) );
+            }
+            runTask(task,0,getBlockStart(numItems,numThreads,1),0,exceptions[0]);
+        }
+        for(UINT t=0; t<numThreads; t++){
+            if( exceptions[t] ) std::rethrow_exception( exceptions[t] );
+        }
+#endif
+        return numThreads;
+    }
+
+protected:
+    static UINT getBlockStart(const UINT numItems,const UINT numThreads,const UINT threadIndex){
+        return (UINT)( ((unsigned long long)numItems * threadIndex) / numThreads );
+    }
+
+#ifdef GRT_CXX11_ENABLED
+    //Joins every thread it holds when it goes out of scope, so no thread is destroyed while it is still joinable
+    class ThreadJoiner{
+    public:
+        ~ThreadJoiner(){
+            for(UINT t=0; t<threads.size(); t++){
+                if( threads[t].joinable() ) threads[t].join();
+            }
+        }
+        std::vector< std::thread > threads;
+    };
+
+    //Runs one block of the task, flagging the thread so any ParallelFor started by the task runs on this thread.
+    //An exception thrown by the task is stored rather than thrown, as it can not leave a worker thread
+    template< class Task >
+    static void runTask(Task &task,const UINT startIndex,const UINT endIndex,const UINT threadIndex,std::exception_ptr &exception){
+        bool &runningTask = getIsRunningTask();
+        const bool wasRunningTask = runningTask;
+        runningTask = true;
+        try{
+            task(startIndex,endIndex,threadIndex);
+        }catch(...){
+            exception = std::current_exception();
+        }
+        runningTask = wasRunningTask;
+    }
+#endif
+
+    static bool& getIsRunningTask(){
+#ifdef GRT_CXX11_ENABLED
+        static thread_local bool runningTask = false;
+#else
+        static bool runningTask = false;
+#endif
+        return runningTask;
+    }
+
+    static UINT& getMaxNumThreadsLimit(){
+        static UINT maxNumThreads = 0;
+        return maxNumThreads;
+    }
+};
+
+} //End of namespace GRT
+
+#endif //GRT_PARALLEL_FOR_HEADER
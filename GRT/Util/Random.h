@@ -25,6 +25,10 @@
  @section DESCRIPTION
  This file contains the Random class, a useful wrapper for generating cross platform random functions. 
  This includes functions for uniform distributions (both integer and double) and Gaussian distributions.
+
+ Instances that are not given a seed are seeded from the system time, unless a thread seed has been set with setThreadSeed.
+ In that case each unseeded instance created on that thread takes the next seed from a sequence started by the thread seed,
+ so code that creates its random number generators in the same order will get the same random numbers on every run.
  */
 
 #ifndef GRT_RANDOM_HEADER
@@ -44,10 +48,6 @@ public:
 	@param unsigned long long seed: sets the current seed, If no seed is supplied then the seed will be set using the current system time
 	*/
     Random(unsigned long long seed = 0):v(4101842887655102017LL), w(1), storedval(0.0){
-        if( seed == 0 ){
-            Timer t;
-            seed = (unsigned long long)t.getSystemTime();
-        }
         setSeed( seed );
     }
 
@@ -65,8 +65,7 @@ public:
 	*/
     void setSeed(unsigned long long seed = 0){
         if( seed == 0 ){
-            Timer t;
-            seed = (unsigned long long)t.getSystemTime();
+            seed = getNextDefaultSeed();
         }
         v = 4101842887655102017LL;
         w = 1;
@@ -255,7 +254,62 @@ public:
         return randomValues;
     }
     
+    /**
+     Sets the thread seed. Every Random instance that is created (or reseeded) on the calling thread without a seed will take
+     the next seed from a sequence started by this seed, rather than using the system time. Set the thread seed to 0 to go
+     back to seeding from the system time.
+     
+     @param unsigned long long seed: the start of the seed sequence for this thread, or 0 to use the system time
+     @return returns void
+     */
+    static void setThreadSeed(unsigned long long seed){
+        ThreadSeed &threadSeed = getThreadSeedState();
+        threadSeed.enabled = seed != 0;
+        threadSeed.state = seed;
+    }
+    
+    /**
+     Gets the current state of the seed sequence on the calling thread. Passing this value back to setThreadSeed restores
+     the sequence, so a function can use its own thread seed and then put back the caller's one.
+     
+     @return returns the current state of the seed sequence for this thread, or 0 if the instances are seeded from the system time
+     */
+    static unsigned long long getThreadSeed(){
+        const ThreadSeed &threadSeed = getThreadSeedState();
+        return threadSeed.enabled ? threadSeed.state : 0;
+    }
+    
 private:
+    struct ThreadSeed{
+        bool enabled;
+        unsigned long long state;
+    };
+    
+    static ThreadSeed& getThreadSeedState(){
+#ifdef GRT_CXX11_ENABLED
+        static thread_local ThreadSeed threadSeed = { false, 0 };
+#else
+        static ThreadSeed threadSeed = { false, 0 };
+#endif
+        return threadSeed;
+    }
+    
+    //Gets the seed for an instance that was not given one, this is either the next value in the thread seed sequence (a
+    //splitmix64 sequence) or the system time
+    static unsigned long long getNextDefaultSeed(){
+        ThreadSeed &threadSeed = getThreadSeedState();
+        if( !threadSeed.enabled ){
+            Timer t;
+            return (unsigned long long)t.getSystemTime();
+        }
+        threadSeed.state += 0x9E3779B97F4A7C15ULL;
+        unsigned long long z = threadSeed.state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        return z != 0 ? z : 1;
+    }
+    
     inline unsigned long long int64() {
         u = u * 2862933555777941757LL + 7046029254386353087LL;
         v ^= v >> 17; v ^= v << 31; v ^= v >> 8;
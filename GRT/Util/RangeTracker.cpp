@@ -110,43 +110,39 @@ bool RangeTracker::loadRangeDataFromFile(string filename){
 		return false;
 	}
 
-	string word;
+	FileTokenizer parser( file );
 
 	//Check to make sure this is a file with the correct file format
-	file >> word;
-	if(word != "GRT_RANGE_TRACKER_DATA_FILE_V1.0"){
+	if( !parser.matchWord("GRT_RANGE_TRACKER_DATA_FILE_V1.0") ){
 		file.close();
 		return false;
 	}
     
    	//Get the number of dimensions in the data
-	file >> word;
-	if(word != "NumDimensions:"){
+	if( !parser.matchWord("NumDimensions:") ){
 		file.close();
 		return false;
 	}
-	file >> numDimensions;
+	parser >> numDimensions;
 
 	//Get the total number of training examples in the training data
-	file >> word;
-	if(word != "TotalNumSamplesViewed:"){
+	if( !parser.matchWord("TotalNumSamplesViewed:") ){
 		file.close();
 		return false;
 	}
-	file >> totalNumSamplesViewed;
+	parser >> totalNumSamplesViewed;
 
 
     //Load the ranges
-	file >> word;
-	if(word != "Ranges:"){
+	if( !parser.matchWord("Ranges:") ){
 		file.close();
 		return false;
 	}
 
     ranges.resize(numDimensions);
     for(UINT i=0; i<ranges.size(); i++){
-        file >> ranges[i].minValue;
-        file >> ranges[i].maxValue;
+        parser >> ranges[i].minValue;
+        parser >> ranges[i].maxValue;
     }
     
 	file.close();
@@ -0,0 +1,211 @@
+/*
+GRT MIT License
+Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial
+portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SquaredDistanceKernel.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace GRT{
+
+SquaredDistanceKernel::SquaredDistanceKernel(){
+    K = 0;
+    N = 0;
+    numBlocks = 0;
+}
+
+SquaredDistanceKernel::SquaredDistanceKernel(const MatrixDouble &clusters){
+    K = 0;
+    N = 0;
+    numBlocks = 0;
+    setClusters( clusters );
+}
+
+SquaredDistanceKernel::~SquaredDistanceKernel(){}
+
+bool SquaredDistanceKernel::setClusters(const MatrixDouble &clusters){
+
+    clear();
+
+    if( clusters.getNumRows() == 0 || clusters.getNumCols() == 0 ){
+        return false;
+    }
+
+    K = clusters.getNumRows();
+    N = clusters.getNumCols();
+    numBlocks = (K + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    //Pack the clusters so the n'th value of the 4 clusters in a block sit next to each other
+    blocks.resize(numBlocks*N*BLOCK_SIZE,0);
+    norms.resize(numBlocks*BLOCK_SIZE,0);
+
+    for(UINT k=0; k<K; k++){
+        const UINT b = k / BLOCK_SIZE;
+        const UINT w = k % BLOCK_SIZE;
+        double norm = 0;
+        for(UINT n=0; n<N; n++){
+            blocks[ (b*N + n)*BLOCK_SIZE + w ] = clusters[k][n];
+            norm += clusters[k][n]*clusters[k][n];
+        }
+        norms[k] = norm;
+    }
+
+    return true;
+}
+
+void SquaredDistanceKernel::clear(){
+    K = 0;
+    N = 0;
+    numBlocks = 0;
+    blocks.clear();
+    norms.clear();
+}
+
+UINT SquaredDistanceKernel::computeDistances(const double *x,double *distances,double &minDistance) const{
+
+    UINT minIndex = 0;
+    minDistance = numeric_limits<double>::max();
+
+    if( K == 0 ) return 0;
+
+    //Compute the squared norm of the input, this is shared by all the clusters
+    double xx = 0;
+    for(UINT n=0; n<N; n++){
+        xx += x[n]*x[n];
+    }
+
+    double d[ BLOCK_SIZE ];
+    const double *blockPtr = &blocks[0];
+    const double *normPtr = &norms[0];
+
+    for(UINT b=0; b<numBlocks; b++){
+
+        //Compute the dot product between the input and the 4 clusters in this block
+#if defined(__SSE2__)
+        __m128d acc0 = _mm_setzero_pd();
+        __m128d acc1 = _mm_setzero_pd();
+        for(UINT n=0; n<N; n++){
+            const __m128d xn = _mm_set1_pd( x[n] );
+            acc0 = _mm_add_pd( acc0, _mm_mul_pd( xn, _mm_loadu_pd( blockPtr ) ) );
+            acc1 = _mm_add_pd( acc1, _mm_mul_pd( xn, _mm_loadu_pd( blockPtr+2 ) ) );
+            blockPtr += BLOCK_SIZE;
+        }
+        //d = ||x||^2 - 2x.c + ||c||^2
+        const __m128d xx2 = _mm_set1_pd( xx );
+        const __m128d two = _mm_set1_pd( 2.0 );
+        _mm_storeu_pd( d,   _mm_add_pd( _mm_sub_pd( xx2, _mm_mul_pd( two, acc0 ) ), _mm_loadu_pd( normPtr ) ) );
+        _mm_storeu_pd( d+2, _mm_add_pd( _mm_sub_pd( xx2, _mm_mul_pd( two, acc1 ) ), _mm_loadu_pd( normPtr+2 ) ) );
+#else
+        double acc[ BLOCK_SIZE ] = {0,0,0,0};
+        for(UINT n=0; n<N; n++){
+            const double xn = x[n];
+            acc[0] += xn*blockPtr[0];
+            acc[1] += xn*blockPtr[1];
+            acc[2] += xn*blockPtr[2];
+            acc[3] += xn*blockPtr[3];
+            blockPtr += BLOCK_SIZE;
+        }
+        for(UINT w=0; w<BLOCK_SIZE; w++){
+            d[w] = xx - 2.0*acc[w] + normPtr[w];
+        }
+#endif
+        normPtr += BLOCK_SIZE;
+
+        //Store the distances and track the minimum, skipping any padding at the end of the last block
+        const UINT numValid = MIN( (UINT)BLOCK_SIZE, K - b*BLOCK_SIZE );
+        for(UINT w=0; w<numValid; w++){
+            const UINT k = b*BLOCK_SIZE + w;
+            
+            //The expanded form can go slightly negative due to rounding when x is on top of a cluster
+            double dist = d[w] > 0 ? d[w] : 0;
+            
+            //Any cluster that could be the closest once the rounding error is allowed for gets its exact distance, so the
+            //closest cluster and its distance match a direct search (including which cluster wins a tie)
+            if( dist - getRoundingErrorBound( xx, k ) <= minDistance ){
+                dist = computeExactDistance( x, k );
+                if( dist < minDistance ){
+                    minDistance = dist;
+                    minIndex = k;
+                }
+            }
+            if( distances != NULL ) distances[ k ] = dist;
+        }
+    }
+
+    return minIndex;
+}
+
+UINT SquaredDistanceKernel::computeDistances(const VectorDouble &x,VectorDouble &distances,double &minDistance) const{
+
+    if( K == 0 || x.size() != N ){
+        minDistance = numeric_limits<double>::max();
+        return 0;
+    }
+
+    if( distances.size() != K ) distances.resize( K );
+
+    return computeDistances( &x[0], &distances[0], minDistance );
+}
+
+double SquaredDistanceKernel::computeExactDistance(const double *x,const UINT k) const{
+    
+    if( k >= K ) return numeric_limits<double>::max();
+    
+    //The n'th value of cluster k is BLOCK_SIZE values after its (n-1)'th value in the packed buffer
+    const double *c = &blocks[ (k / BLOCK_SIZE)*N*BLOCK_SIZE + (k % BLOCK_SIZE) ];
+    double dist = 0;
+    for(UINT n=0; n<N; n++){
+        dist += SQR( x[n]-c[ n*BLOCK_SIZE ] );
+    }
+    return dist;
+}
+
+double SquaredDistanceKernel::getRoundingErrorBound(const double inputNorm,const UINT k) const{
+    
+    if( k >= K ) return 0;
+    
+    //Each of the N term sums (||x||^2, ||c||^2, x.c and the exact distance) is out by at most about N*eps times the sum of
+    //the magnitudes of its terms, and each of those is at most ||x||^2 + ||c||^2. This doubles that for a safe margin
+    return 4.0 * (N+4) * numeric_limits<double>::epsilon() * (inputNorm + norms[k]);
+}
+
+UINT SquaredDistanceKernel::findNearestCluster(const double *x,double &minDistance) const{
+    return computeDistances( x, NULL, minDistance );
+}
+
+bool SquaredDistanceKernel::findNearestClusters(const MatrixDouble &data,vector< UINT > &nearestCluster,VectorDouble &minDistances) const{
+
+    if( K == 0 || data.getNumCols() != N ){
+        return false;
+    }
+
+    const UINT M = data.getNumRows();
+    if( nearestCluster.size() != M ) nearestCluster.resize( M );
+    if( minDistances.size() != M ) minDistances.resize( M );
+
+    for(UINT i=0; i<M; i++){
+        nearestCluster[i] = computeDistances( data[i], NULL, minDistances[i] );
+    }
+
+    return true;
+}
+
+} //End of namespace GRT
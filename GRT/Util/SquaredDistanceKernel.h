@@ -0,0 +1,176 @@
+/**
+ @file
+ @author  Nicholas Gillian <ngillian@media.mit.edu>
+ @version 1.0
+
+ @section LICENSE
+ GRT MIT License
+ Copyright (c) <2012> <Nicholas Gillian, Media Lab, MIT>
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial
+ portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT
+ LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+ @section DESCRIPTION
+ The SquaredDistanceKernel computes the squared Euclidean distance between an input vector and a fixed set of
+ cluster centres (for example the clusters of a KMeans, MinDist or KMeansQuantizer model).
+
+ When the clusters are set, the kernel packs them into one contiguous buffer (in blocks of 4 clusters, stored
+ dimension by dimension) and precomputes the squared norm of each cluster. The distance to each cluster is then
+ computed as ||x||^2 - 2x.c + ||c||^2, which lets 4 clusters be scored at once with SIMD instructions (SSE2 when
+ available, a scalar loop otherwise).
+
+ The expanded form loses precision when the input and clusters are far from the origin, so any cluster whose expanded
+ distance is within the rounding error of the closest distance found so far has its exact distance (the direct sum of
+ the squared differences) computed. The closest cluster and its distance therefore always match a direct search, with
+ ties going to the first cluster. The other distances are clamped to be at least 0, but can differ from the exact
+ distances by up to getRoundingErrorBound.
+ */
+
+#ifndef GRT_SQUARED_DISTANCE_KERNEL_HEADER
+#define GRT_SQUARED_DISTANCE_KERNEL_HEADER
+
+#include "GRTCommon.h"
+
+namespace GRT{
+
+class SquaredDistanceKernel{
+public:
+    /**
+     Default Constructor
+     */
+    SquaredDistanceKernel();
+
+    /**
+     Init Constructor, sets the clusters used by the kernel.
+
+     @param const MatrixDouble &clusters: a [K N] matrix containing the K clusters
+     */
+    SquaredDistanceKernel(const MatrixDouble &clusters);
+
+    /**
+     Default Destructor
+     */
+    ~SquaredDistanceKernel();
+
+    /**
+     Sets the clusters used by the kernel. This packs the clusters into the kernel buffer and precomputes the
+     squared norm of each cluster, so it should be called once after training (or loading) a model, not per prediction.
+
+     @param const MatrixDouble &clusters: a [K N] matrix containing the K clusters
+     @return returns true if the clusters were set, false otherwise
+     */
+    bool setClusters(const MatrixDouble &clusters);
+
+    /**
+     Clears the clusters from the kernel.
+     */
+    void clear();
+
+    /**
+     Computes the squared distance between the input vector x and every cluster, writing the K distances to the
+     distances buffer.
+
+     @param const double *x: a pointer to the N input values
+     @param double *distances: a pointer to a buffer of at least K values, the distances will be written here (this can be NULL if you only need the closest cluster)
+     @param double &minDistance: the exact squared distance to the closest cluster
+     @return returns the index of the closest cluster
+     */
+    UINT computeDistances(const double *x,double *distances,double &minDistance) const;
+
+    /**
+     Computes the exact squared distance between the input vector x and cluster k, by summing the squared differences
+     directly rather than using the expanded form.
+
+     @param const double *x: a pointer to the N input values
+     @param const UINT k: the index of the cluster
+     @return returns the squared distance between x and cluster k
+     */
+    double computeExactDistance(const double *x,const UINT k) const;
+
+    /**
+     Gets an upper bound on the difference between the expanded form distance from an input to cluster k (as written by
+     computeDistances) and its exact distance.
+
+     @param const double inputNorm: the squared norm of the input vector, ||x||^2
+     @param const UINT k: the index of the cluster
+     @return returns the largest rounding error of the expanded form distance
+     */
+    double getRoundingErrorBound(const double inputNorm,const UINT k) const;
+
+    /**
+     Computes the squared distance between the input vector and every cluster.
+
+     @param const VectorDouble &x: the input vector, its size must match the number of dimensions of the clusters
+     @param VectorDouble &distances: the K distances will be written here, this will be resized if needed
+     @param double &minDistance: the squared distance to the closest cluster
+     @return returns the index of the closest cluster
+     */
+    UINT computeDistances(const VectorDouble &x,VectorDouble &distances,double &minDistance) const;
+
+    /**
+     Finds the cluster closest to the input vector x.
+
+     @param const double *x: a pointer to the N input values
+     @param double &minDistance: the squared distance to the closest cluster
+     @return returns the index of the closest cluster
+     */
+    UINT findNearestCluster(const double *x,double &minDistance) const;
+
+    /**
+     Finds the closest cluster for every row in the data matrix.
+
+     @param const MatrixDouble &data: a [M N] matrix, N must match the number of dimensions of the clusters
+     @param vector< UINT > &nearestCluster: the index of the closest cluster for each row will be written here
+     @param VectorDouble &minDistances: the squared distance to the closest cluster for each row will be written here
+     @return returns true if the search was run, false otherwise
+     */
+    bool findNearestClusters(const MatrixDouble &data,vector< UINT > &nearestCluster,VectorDouble &minDistances) const;
+
+    /**
+     @return returns true if the clusters have been set, false otherwise
+     */
+    bool getInit() const { return K > 0; }
+
+    /**
+     @return returns the number of clusters
+     */
+    UINT getNumClusters() const { return K; }
+
+    /**
+     @return returns the number of dimensions of each cluster
+     */
+    UINT getNumDimensions() const { return N; }
+
+    /**
+     @return returns the precomputed squared norm of each cluster
+     */
+    const VectorDouble& getClusterNorms() const { return norms; }
+
+    /**
+     The number of clusters that are scored together in one block
+     */
+    enum { BLOCK_SIZE = 4 };
+
+protected:
+    UINT K;                             ///< The number of clusters
+    UINT N;                             ///< The number of dimensions
+    UINT numBlocks;                     ///< The number of BLOCK_SIZE blocks needed to hold K clusters
+    VectorDouble blocks;                ///< The packed clusters, laid out as [numBlocks][N][BLOCK_SIZE]
+    VectorDouble norms;                 ///< The squared norm of each cluster, padded to numBlocks*BLOCK_SIZE
+};
+
+} //End of namespace GRT
+
+#endif //GRT_SQUARED_DISTANCE_KERNEL_HEADER